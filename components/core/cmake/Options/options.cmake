@@ -156,6 +156,7 @@ function(validate_clp_binaries_dependencies)
         CLP_BUILD_CLP_S_ARCHIVEREADER
         CLP_BUILD_CLP_S_ARCHIVEWRITER
         CLP_BUILD_CLP_S_CLP_DEPENDENCIES
+        CLP_BUILD_CLP_S_FILTER
         CLP_BUILD_CLP_S_IO
         CLP_BUILD_CLP_S_JSONCONSTRUCTOR
         CLP_BUILD_CLP_S_REDUCER_DEPENDENCIES
@@ -182,6 +183,7 @@ function(set_clp_binaries_dependencies)
         CLP_NEED_SIMDJSON
         CLP_NEED_SPDLOG
         CLP_NEED_SQLITE
+        CLP_NEED_XXHASH
         CLP_NEED_YAMLCPP
         CLP_NEED_YSTDLIB
         CLP_NEED_ZSTD
@@ -332,6 +334,9 @@ endfunction()
 function(validate_clp_s_ffi_sfa_dependencies)
     validate_clp_dependencies_for_target(CLP_BUILD_CLP_S_FFI_SFA
         CLP_BUILD_CLP_S_ARCHIVEREADER
+        CLP_BUILD_CLP_S_SEARCH
+        CLP_BUILD_CLP_S_SEARCH_AST
+        CLP_BUILD_CLP_S_SEARCH_KQL
     )
 endfunction()
 
@@ -396,7 +401,9 @@ endfunction()
 
 function(set_clp_s_reducer_dependencies_dependencies)
     set_clp_need_flags(
+        CLP_NEED_ABSL
         CLP_NEED_NLOHMANN_JSON
+        CLP_NEED_XXHASH
     )
 endfunction()
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <charconv>
 #include <chrono>
 #include <cstddef>
 #include <cstdlib>
@@ -11,6 +12,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -32,7 +34,8 @@ CurlDownloadHandler::CurlDownloadHandler(
         bool disable_caching,
         std::chrono::seconds connection_timeout,
         std::chrono::seconds overall_timeout,
-        std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs
+        std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs,
+        std::optional<size_t> end_offset
 )
         : m_error_msg_buf{std::move(error_msg_buf)} {
     if (nullptr != m_error_msg_buf) {
@@ -76,7 +79,26 @@ CurlDownloadHandler::CurlDownloadHandler(
             cCacheControlHeaderName,
             cPragmaHeaderName
     };
-    if (0 != offset) {
+    if (end_offset.has_value()) {
+        if (end_offset.value() <= offset) {
+            throw CurlOperationFailed(
+                    ErrorCode_BadParam,
+                    __FILE__,
+                    __LINE__,
+                    CURLE_BAD_FUNCTION_ARGUMENT,
+                    fmt::format(
+                            "`CurlDownloadHandler` failed to construct with an empty range: [{}, "
+                            "{})",
+                            offset,
+                            end_offset.value()
+                    )
+            );
+        }
+        // HTTP byte ranges are inclusive
+        m_http_headers.append(
+                fmt::format("{}: bytes={}-{}", cRangeHeaderName, offset, end_offset.value() - 1)
+        );
+    } else if (0 != offset) {
         m_http_headers.append(fmt::format("{}: bytes={}-", cRangeHeaderName, offset));
     }
     if (disable_caching) {
@@ -126,6 +148,60 @@ CurlDownloadHandler::CurlDownloadHandler(
     m_easy_handle.set_option(CURLOPT_FAILONERROR, static_cast<long>(true));
 }
 
+auto CurlDownloadHandler::parse_content_range_header(std::string_view header)
+        -> std::optional<ContentRange> {
+    // HTTP header field-names are case-insensitive
+    constexpr std::string_view cHeaderName{"content-range:"};
+    if (header.size() < cHeaderName.size()
+        || false
+                   == std::equal(
+                           cHeaderName.begin(),
+                           cHeaderName.end(),
+                           header.begin(),
+                           [](char expected, char c) -> bool {
+                               return expected
+                                      == static_cast<char>(
+                                              std::tolower(static_cast<unsigned char>(c))
+                                      );
+                           }
+                   ))
+    {
+        return std::nullopt;
+    }
+
+    constexpr std::string_view cWhitespace{" \t\r\n"};
+    auto value{header.substr(cHeaderName.size())};
+    value.remove_prefix(std::min(value.find_first_not_of(cWhitespace), value.size()));
+    value.remove_suffix(value.size() - (value.find_last_not_of(cWhitespace) + 1));
+
+    constexpr std::string_view cUnitPrefix{"bytes "};
+    auto const dash_pos{value.find('-')};
+    auto const slash_pos{value.find('/')};
+    if (false == value.starts_with(cUnitPrefix) || std::string_view::npos == dash_pos
+        || std::string_view::npos == slash_pos || dash_pos > slash_pos)
+    {
+        return std::nullopt;
+    }
+
+    auto const parse_size = [](std::string_view str) -> std::optional<size_t> {
+        size_t result{};
+        auto const* end{str.data() + str.size()};
+        auto const [ptr, ec]{std::from_chars(str.data(), end, result)};
+        if (std::errc{} != ec || end != ptr) {
+            return std::nullopt;
+        }
+        return result;
+    };
+    auto const begin_offset{
+            parse_size(value.substr(cUnitPrefix.size(), dash_pos - cUnitPrefix.size()))
+    };
+    auto const total_size{parse_size(value.substr(slash_pos + 1))};
+    if (false == begin_offset.has_value() || false == total_size.has_value()) {
+        return std::nullopt;
+    }
+    return ContentRange{.begin_offset = begin_offset.value(), .total_size = total_size.value()};
+}
+
 auto CurlDownloadHandler::get_host_ca_bundle_path() -> std::optional<std::string> {
     if constexpr (Platform::MacOs == cCurrentPlatform) {
         return std::nullopt;
@@ -35,6 +35,21 @@ public:
      * https://curl.se/libcurl/c/CURLOPT_WRITEFUNCTION.html
      */
     using WriteCallback = size_t (*)(char*, size_t, size_t, void*);
+    /**
+     * libcurl header callback. This method must have C linkage. Doc:
+     * https://curl.se/libcurl/c/CURLOPT_HEADERFUNCTION.html
+     */
+    using HeaderCallback = size_t (*)(char*, size_t, size_t, void*);
+
+    /**
+     * The range of a partial response, as described by its `Content-Range` header.
+     */
+    struct ContentRange {
+        // Index of the first byte in the response
+        size_t begin_offset;
+        // The total size of the data
+        size_t total_size;
+    };
 
     // Constants
     // See https://curl.se/libcurl/c/CURLOPT_CONNECTTIMEOUT.html
@@ -59,6 +74,8 @@ public:
      * `connection_timeout`. Doc: https://curl.se/libcurl/c/CURLOPT_TIMEOUT.html
      * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the server
      * in the download request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+     * @param end_offset Index of the byte after the last byte to download, or `std::nullopt` to
+     * download until the end of the data.
      * @throw CurlOperationFailed if an error occurs.
      */
     explicit CurlDownloadHandler(
@@ -72,7 +89,8 @@ public:
             std::chrono::seconds connection_timeout = cDefaultConnectionTimeout,
             std::chrono::seconds overall_timeout = cDefaultOverallTimeout,
             std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs
-            = std::nullopt
+            = std::nullopt,
+            std::optional<size_t> end_offset = std::nullopt
     );
 
     // Disable copy/move constructors/assignment operators
@@ -91,6 +109,27 @@ public:
      */
     [[nodiscard]] auto perform() -> CURLcode { return m_easy_handle.perform(); }
 
+    /**
+     * Sets a callback to receive each header of the response.
+     * @param header_callback
+     * @param arg Argument to pass to `header_callback`
+     * @throw CurlOperationFailed if an error occurs.
+     */
+    auto set_header_callback(HeaderCallback header_callback, void* arg) -> void {
+        m_easy_handle.set_option(CURLOPT_HEADERFUNCTION, header_callback);
+        m_easy_handle.set_option(CURLOPT_HEADERDATA, arg);
+    }
+
+    /**
+     * Parses a `Content-Range` header of the form `Content-Range: bytes <begin>-<end>/<total>`.
+     * Doc: https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/Content-Range
+     * @param header A response header, as passed to a `HeaderCallback`.
+     * @return The parsed range on success, or std::nullopt if the header isn't a `Content-Range`
+     * header or the total size is unknown.
+     */
+    [[nodiscard]] static auto parse_content_range_header(std::string_view header)
+            -> std::optional<ContentRange>;
+
 private:
     /**
      * Locates the certificate authority (CA) bundle file available on the current host.
@@ -2,6 +2,7 @@
 #define CLP_ENCODEDVARIABLEINTERPRETER_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -15,6 +16,7 @@
 #include <clp/ffi/EncodedTextAst.hpp>
 #include <clp/ffi/encoding_methods.hpp>
 #include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <clp/ffi/ir_stream/encoding_methods.hpp>
 #include <clp/ir/EncodedTextAst.hpp>
 #include <clp/ir/types.hpp>
 #include <clp/LogTypeDictionaryEntryReq.hpp>
@@ -248,6 +250,36 @@ public:
             std::string& decompressed_msg
     ) -> bool;
 
+    /**
+     * Transcodes a message's logtype and encoded variables into a message in the four-byte
+     * encoding IR stream, without decoding the message into text and re-parsing it.
+     *
+     * Since archives and IR streams escape logtypes in the same way, the IR logtype is the given
+     * logtype, except that integer and float variables that aren't representable using the
+     * four-byte encoding are converted into dictionary variables.
+     * @tparam LogTypeDictionaryEntryType
+     * @tparam VariableDictionaryReaderType
+     * @tparam EncodedVariableContainerType A random access list of `clp::encoded_variable_t`.
+     * @param logtype_dict_entry
+     * @param var_dict
+     * @param encoded_vars
+     * @param logtype Returns the IR logtype
+     * @param ir_buf Returns the serialized variables followed by the serialized logtype
+     * @return true if successful, false otherwise
+     */
+    template <
+            LogTypeDictionaryEntryReq LogTypeDictionaryEntryType,
+            VariableDictionaryReaderReq VariableDictionaryReaderType,
+            typename EncodedVariableContainerType
+    >
+    static auto transcode_message_to_four_byte_ir(
+            LogTypeDictionaryEntryType const& logtype_dict_entry,
+            VariableDictionaryReaderType const& var_dict,
+            EncodedVariableContainerType const& encoded_vars,
+            std::string& logtype,
+            std::vector<int8_t>& ir_buf
+    ) -> bool;
+
     /**
      * Encodes a string-form variable, and if it is dictionary variable, searches for its ID in the
      * given variable dictionary.
@@ -578,6 +610,119 @@ auto EncodedVariableInterpreter::decode_variables_into_message(
     return true;
 }
 
+template <
+        LogTypeDictionaryEntryReq LogTypeDictionaryEntryType,
+        VariableDictionaryReaderReq VariableDictionaryReaderType,
+        typename EncodedVariableContainerType
+>
+auto EncodedVariableInterpreter::transcode_message_to_four_byte_ir(
+        LogTypeDictionaryEntryType const& logtype_dict_entry,
+        VariableDictionaryReaderType const& var_dict,
+        EncodedVariableContainerType const& encoded_vars,
+        std::string& logtype,
+        std::vector<int8_t>& ir_buf
+) -> bool {
+    auto const& logtype_value = logtype_dict_entry.get_value();
+    size_t const num_vars = logtype_dict_entry.get_num_variables();
+    if (num_vars != encoded_vars.size()) {
+        SPDLOG_ERROR(
+                "EncodedVariableInterpreter: Logtype '{}' contains {} variables, but {} were given "
+                "for transcoding.",
+                logtype_value.c_str(),
+                num_vars,
+                encoded_vars.size()
+        );
+        return false;
+    }
+
+    logtype = logtype_value;
+    ir::VariablePlaceholder var_placeholder{};
+    std::string float_str;
+    size_t const num_placeholders_in_logtype = logtype_dict_entry.get_num_placeholders();
+    for (size_t placeholder_ix = 0, var_ix = 0; placeholder_ix < num_placeholders_in_logtype;
+         ++placeholder_ix)
+    {
+        size_t const placeholder_position
+                = logtype_dict_entry.get_placeholder_info(placeholder_ix, var_placeholder);
+        switch (var_placeholder) {
+            case ir::VariablePlaceholder::Integer: {
+                auto const encoded_var = encoded_vars[var_ix++];
+                if (INT32_MIN <= encoded_var && encoded_var <= INT32_MAX) {
+                    ffi::ir_stream::four_byte_encoding::serialize_encoded_var(
+                            static_cast<ir::four_byte_encoded_variable_t>(encoded_var),
+                            ir_buf
+                    );
+                } else {
+                    logtype[placeholder_position]
+                            = enum_to_underlying_type(ir::VariablePlaceholder::Dictionary);
+                    if (false
+                        == ffi::ir_stream::serialize_dict_var(std::to_string(encoded_var), ir_buf))
+                    {
+                        return false;
+                    }
+                }
+                break;
+            }
+            case ir::VariablePlaceholder::Float: {
+                auto const encoded_var = encoded_vars[var_ix++];
+                bool is_negative{};
+                uint64_t digits{};
+                uint8_t num_digits{};
+                uint8_t decimal_point_pos{};
+                ffi::decode_float_properties<ir::eight_byte_encoded_variable_t>(
+                        encoded_var,
+                        is_negative,
+                        digits,
+                        num_digits,
+                        decimal_point_pos
+                );
+                if (num_digits <= ffi::cMaxDigitsInRepresentableFourByteFloatVar
+                    && digits <= ffi::cFourByteEncodedFloatDigitsBitMask)
+                {
+                    ffi::ir_stream::four_byte_encoding::serialize_encoded_var(
+                            ffi::encode_float_properties<ir::four_byte_encoded_variable_t>(
+                                    is_negative,
+                                    static_cast<uint32_t>(digits),
+                                    num_digits,
+                                    decimal_point_pos
+                            ),
+                            ir_buf
+                    );
+                } else {
+                    logtype[placeholder_position]
+                            = enum_to_underlying_type(ir::VariablePlaceholder::Dictionary);
+                    convert_encoded_float_to_string(encoded_var, float_str);
+                    if (false == ffi::ir_stream::serialize_dict_var(float_str, ir_buf)) {
+                        return false;
+                    }
+                }
+                break;
+            }
+            case ir::VariablePlaceholder::Dictionary: {
+                auto const var_dict_id = decode_var_dict_id(encoded_vars[var_ix++]);
+                if (false
+                    == ffi::ir_stream::serialize_dict_var(var_dict.get_value(var_dict_id), ir_buf))
+                {
+                    return false;
+                }
+                break;
+            }
+            case ir::VariablePlaceholder::Escape:
+                break;
+            default:
+                SPDLOG_ERROR(
+                        "EncodedVariableInterpreter: Logtype '{}' contains unexpected variable "
+                        "placeholder 0x{:x}",
+                        logtype_value,
+                        enum_to_underlying_type(var_placeholder)
+                );
+                return false;
+        }
+    }
+
+    return ffi::ir_stream::serialize_logtype(logtype, ir_buf);
+}
+
 template <VariableDictionaryReaderReq VariableDictionaryReaderType>
 auto EncodedVariableInterpreter::encode_and_search_dictionary(
         std::string_view var_str,
@@ -1,5 +1,12 @@
 #include "GlobalMySQLMetadataDB.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <fmt/base.h>
 #include <fmt/format.h>
 
@@ -45,6 +52,47 @@ enum class FilesTableFieldIndexes : uint16_t {
     ArchiveId,
     Length,
 };
+
+/**
+ * @return The names of the files table's fields, ordered by `FilesTableFieldIndexes`
+ */
+auto get_file_field_names() -> vector<string>;
+
+/**
+ * Values of a file's fields that must outlive the file's bindings until the statement executes
+ */
+struct FileFieldValues {
+    string id_as_string;
+    string orig_file_id_as_string;
+    int64_t begin_ts{};
+    int64_t end_ts{};
+    uint64_t num_uncompressed_bytes{};
+    uint64_t begin_message_ix{};
+    uint64_t num_messages{};
+};
+
+auto get_file_field_names() -> vector<string> {
+    vector<string> file_field_names(enum_to_underlying_type(FilesTableFieldIndexes::Length));
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::Id)]
+            = streaming_archive::cMetadataDB::File::Id;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::OrigFileId)]
+            = streaming_archive::cMetadataDB::File::OrigFileId;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::Path)]
+            = streaming_archive::cMetadataDB::File::Path;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::BeginTimestamp)]
+            = streaming_archive::cMetadataDB::File::BeginTimestamp;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::EndTimestamp)]
+            = streaming_archive::cMetadataDB::File::EndTimestamp;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::NumUncompressedBytes)]
+            = streaming_archive::cMetadataDB::File::NumUncompressedBytes;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::BeginMessageIx)]
+            = streaming_archive::cMetadataDB::File::BeginMessageIx;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::NumMessages)]
+            = streaming_archive::cMetadataDB::File::NumMessages;
+    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::ArchiveId)]
+            = streaming_archive::cMetadataDB::File::ArchiveId;
+    return file_field_names;
+}
 }  // namespace
 
 void GlobalMySQLMetadataDB::ArchiveIterator::get_id(string& id) const {
@@ -127,44 +175,7 @@ void GlobalMySQLMetadataDB::open() {
     );
     statement_buffer.clear();
 
-    vector<string> file_field_names(enum_to_underlying_type(FilesTableFieldIndexes::Length));
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::Id)]
-            = streaming_archive::cMetadataDB::File::Id;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::OrigFileId)]
-            = streaming_archive::cMetadataDB::File::OrigFileId;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::Path)]
-            = streaming_archive::cMetadataDB::File::Path;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::BeginTimestamp)]
-            = streaming_archive::cMetadataDB::File::BeginTimestamp;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::EndTimestamp)]
-            = streaming_archive::cMetadataDB::File::EndTimestamp;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::NumUncompressedBytes)]
-            = streaming_archive::cMetadataDB::File::NumUncompressedBytes;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::BeginMessageIx)]
-            = streaming_archive::cMetadataDB::File::BeginMessageIx;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::NumMessages)]
-            = streaming_archive::cMetadataDB::File::NumMessages;
-    file_field_names[enum_to_underlying_type(FilesTableFieldIndexes::ArchiveId)]
-            = streaming_archive::cMetadataDB::File::ArchiveId;
-
-    // Insert or on conflict, set all fields except the ID
-    fmt::format_to(
-            statement_buffer_ix,
-            "INSERT INTO {}{} ({}) VALUES ({}) ON DUPLICATE KEY UPDATE {}",
-            m_table_prefix,
-            streaming_archive::cMetadataDB::FilesTableName,
-            get_field_names_sql(file_field_names),
-            get_placeholders_sql(file_field_names.size()),
-            get_set_field_sql(
-                    file_field_names,
-                    enum_to_underlying_type(FilesTableFieldIndexes::Id) + 1,
-                    enum_to_underlying_type(FilesTableFieldIndexes::Length)
-            )
-    );
-    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
-    m_upsert_file_statement = std::make_unique<MySQLPreparedStatement>(
-            m_db.prepare_statement(statement_buffer.data(), statement_buffer.size())
-    );
+    m_upsert_file_statement = prepare_upsert_files_statement(cMaxFilesPerUpsert);
 }
 
 void GlobalMySQLMetadataDB::close() {
@@ -276,106 +287,91 @@ void GlobalMySQLMetadataDB::update_metadata_for_files(
     if (false == m_db.execute_query("BEGIN")) {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
     }
-    auto& statement_bindings = m_upsert_file_statement->get_statement_bindings();
-    for (auto file : files) {
-        auto const id_as_string = file->get_id_as_string();
-        statement_bindings.bind_varchar(
-                enum_to_underlying_type(FilesTableFieldIndexes::Id),
-                id_as_string.c_str(),
-                id_as_string.length()
-        );
-
-        auto const orig_file_id_as_string = file->get_orig_file_id_as_string();
-        statement_bindings.bind_varchar(
-                enum_to_underlying_type(FilesTableFieldIndexes::OrigFileId),
-                orig_file_id_as_string.c_str(),
-                orig_file_id_as_string.length()
-        );
-
-        auto const& orig_path = file->get_orig_path();
-        statement_bindings.bind_varchar(
-                enum_to_underlying_type(FilesTableFieldIndexes::Path),
-                orig_path.c_str(),
-                orig_path.length()
-        );
-
-        auto begin_ts = file->get_begin_ts();
-        statement_bindings.bind_int64(
-                enum_to_underlying_type(FilesTableFieldIndexes::BeginTimestamp),
-                begin_ts
-        );
-
-        auto end_ts = file->get_end_ts();
-        statement_bindings.bind_int64(
-                enum_to_underlying_type(FilesTableFieldIndexes::EndTimestamp),
-                end_ts
-        );
-
-        auto num_uncompressed_bytes = file->get_num_uncompressed_bytes();
-        statement_bindings.bind_uint64(
-                enum_to_underlying_type(FilesTableFieldIndexes::NumUncompressedBytes),
-                num_uncompressed_bytes
-        );
-
-        auto begin_message_ix = file->get_begin_message_ix();
-        statement_bindings.bind_uint64(
-                enum_to_underlying_type(FilesTableFieldIndexes::BeginMessageIx),
-                begin_message_ix
-        );
-
-        auto num_messages = file->get_num_messages();
-        statement_bindings.bind_uint64(
-                enum_to_underlying_type(FilesTableFieldIndexes::NumMessages),
-                num_messages
-        );
-
-        statement_bindings.bind_varchar(
-                enum_to_underlying_type(FilesTableFieldIndexes::ArchiveId),
-                archive_id.c_str(),
-                archive_id.length()
-        );
-
-        // NOTE: We subtract 1 since the ID is not repeated in the query
-        size_t offset = enum_to_underlying_type(FilesTableFieldIndexes::Length) - 1;
-        statement_bindings.bind_varchar(
-                enum_to_underlying_type(FilesTableFieldIndexes::OrigFileId) + offset,
-                orig_file_id_as_string.c_str(),
-                orig_file_id_as_string.length()
-        );
-        statement_bindings.bind_varchar(
-                enum_to_underlying_type(FilesTableFieldIndexes::Path) + offset,
-                orig_path.c_str(),
-                orig_path.length()
-        );
-        statement_bindings.bind_int64(
-                enum_to_underlying_type(FilesTableFieldIndexes::BeginTimestamp) + offset,
-                begin_ts
-        );
-        statement_bindings.bind_int64(
-                enum_to_underlying_type(FilesTableFieldIndexes::EndTimestamp) + offset,
-                end_ts
-        );
-        statement_bindings.bind_uint64(
-                enum_to_underlying_type(FilesTableFieldIndexes::NumUncompressedBytes) + offset,
-                num_uncompressed_bytes
-        );
-        statement_bindings.bind_uint64(
-                enum_to_underlying_type(FilesTableFieldIndexes::BeginMessageIx) + offset,
-                begin_message_ix
-        );
-        statement_bindings.bind_uint64(
-                enum_to_underlying_type(FilesTableFieldIndexes::NumMessages) + offset,
-                num_messages
-        );
-        statement_bindings.bind_varchar(
-                enum_to_underlying_type(FilesTableFieldIndexes::ArchiveId) + offset,
-                archive_id.c_str(),
-                archive_id.length()
-        );
-
-        if (false == m_upsert_file_statement->execute()) {
+    // Upsert the files in batches so that each batch costs a single round trip to the database
+    vector<FileFieldValues> batch_values(std::min(files.size(), cMaxFilesPerUpsert));
+    size_t batch_begin_ix = 0;
+    for (auto const batch_size : get_multi_row_batch_sizes(files.size(), cMaxFilesPerUpsert)) {
+        std::unique_ptr<MySQLPreparedStatement> partial_batch_statement;
+        auto* statement = m_upsert_file_statement.get();
+        if (cMaxFilesPerUpsert != batch_size) {
+            partial_batch_statement = prepare_upsert_files_statement(batch_size);
+            statement = partial_batch_statement.get();
+        }
+
+        auto& statement_bindings = statement->get_statement_bindings();
+        for (size_t i = 0; i < batch_size; ++i) {
+            auto const* file = files[batch_begin_ix + i];
+            auto& values = batch_values[i];
+            auto const get_placeholder_ix = [&](FilesTableFieldIndexes field) -> size_t {
+                return get_multi_row_placeholder_ix(
+                        enum_to_underlying_type(field),
+                        i,
+                        enum_to_underlying_type(FilesTableFieldIndexes::Length)
+                );
+            };
+
+            values.id_as_string = file->get_id_as_string();
+            statement_bindings.bind_varchar(
+                    get_placeholder_ix(FilesTableFieldIndexes::Id),
+                    values.id_as_string.c_str(),
+                    values.id_as_string.length()
+            );
+
+            values.orig_file_id_as_string = file->get_orig_file_id_as_string();
+            statement_bindings.bind_varchar(
+                    get_placeholder_ix(FilesTableFieldIndexes::OrigFileId),
+                    values.orig_file_id_as_string.c_str(),
+                    values.orig_file_id_as_string.length()
+            );
+
+            auto const& orig_path = file->get_orig_path();
+            statement_bindings.bind_varchar(
+                    get_placeholder_ix(FilesTableFieldIndexes::Path),
+                    orig_path.c_str(),
+                    orig_path.length()
+            );
+
+            values.begin_ts = file->get_begin_ts();
+            statement_bindings.bind_int64(
+                    get_placeholder_ix(FilesTableFieldIndexes::BeginTimestamp),
+                    values.begin_ts
+            );
+
+            values.end_ts = file->get_end_ts();
+            statement_bindings.bind_int64(
+                    get_placeholder_ix(FilesTableFieldIndexes::EndTimestamp),
+                    values.end_ts
+            );
+
+            values.num_uncompressed_bytes = file->get_num_uncompressed_bytes();
+            statement_bindings.bind_uint64(
+                    get_placeholder_ix(FilesTableFieldIndexes::NumUncompressedBytes),
+                    values.num_uncompressed_bytes
+            );
+
+            values.begin_message_ix = file->get_begin_message_ix();
+            statement_bindings.bind_uint64(
+                    get_placeholder_ix(FilesTableFieldIndexes::BeginMessageIx),
+                    values.begin_message_ix
+            );
+
+            values.num_messages = file->get_num_messages();
+            statement_bindings.bind_uint64(
+                    get_placeholder_ix(FilesTableFieldIndexes::NumMessages),
+                    values.num_messages
+            );
+
+            statement_bindings.bind_varchar(
+                    get_placeholder_ix(FilesTableFieldIndexes::ArchiveId),
+                    archive_id.c_str(),
+                    archive_id.length()
+            );
+        }
+
+        if (false == statement->execute()) {
             throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
         }
+        batch_begin_ix += batch_size;
     }
     if (false == m_db.execute_query("COMMIT")) {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
@@ -523,4 +519,29 @@ bool GlobalMySQLMetadataDB::get_file_split(
 
     return true;
 }
+
+auto GlobalMySQLMetadataDB::prepare_upsert_files_statement(size_t num_files)
+        -> std::unique_ptr<MySQLPreparedStatement> {
+    auto const file_field_names = get_file_field_names();
+
+    // Insert or on conflict, set all fields except the ID
+    fmt::memory_buffer statement_buffer;
+    fmt::format_to(
+            std::back_inserter(statement_buffer),
+            "INSERT INTO {}{} ({}) VALUES {} ON DUPLICATE KEY UPDATE {}",
+            m_table_prefix,
+            streaming_archive::cMetadataDB::FilesTableName,
+            get_field_names_sql(file_field_names),
+            get_multi_row_placeholders_sql(file_field_names.size(), num_files),
+            get_set_field_to_inserted_values_sql(
+                    file_field_names,
+                    enum_to_underlying_type(FilesTableFieldIndexes::Id) + 1,
+                    enum_to_underlying_type(FilesTableFieldIndexes::Length)
+            )
+    );
+    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
+    return std::make_unique<MySQLPreparedStatement>(
+            m_db.prepare_statement(statement_buffer.data(), statement_buffer.size())
+    );
+}
 }  // namespace clp
@@ -1,6 +1,10 @@
 #ifndef CLP_GLOBALMYSQLMETADATADB_HPP
 #define CLP_GLOBALMYSQLMETADATADB_HPP
 
+#include <cstddef>
+#include <memory>
+#include <string>
+
 #include "ErrorCode.hpp"
 #include "GlobalMetadataDB.hpp"
 #include "MySQLDB.hpp"
@@ -101,6 +105,21 @@ public:
     ) override;
 
 private:
+    // Constants
+    // Maximum number of files to upsert with a single statement. Each call to
+    // `update_metadata_for_files` writes all of its batches before returning, so no background or
+    // time-based flush is needed.
+    static constexpr size_t cMaxFilesPerUpsert{512};
+
+    // Methods
+    /**
+     * Prepares a statement that upserts the given number of files at once
+     * @param num_files
+     * @return The prepared statement
+     */
+    [[nodiscard]] auto prepare_upsert_files_statement(size_t num_files)
+            -> std::unique_ptr<MySQLPreparedStatement>;
+
     // Variables
     std::string m_host;
     int m_port;
@@ -86,7 +86,14 @@ auto LogTypeDictionaryEntry::parse_next_var(
     auto escape_handler = [&]([[maybe_unused]] string_view constant,
                               [[maybe_unused]] size_t char_to_escape_pos,
                               [[maybe_unused]] string& logtype) -> void { add_escape(); };
-    if (ir::get_bounds_of_next_var(msg, var_begin_pos, var_end_pos)) {
+    // A message is parsed starting from position 0, so rebind the finder whenever a new parse
+    // starts (or the message changes) to avoid reusing state cached for a different message.
+    if (0 == var_end_pos || m_var_bounds_finder.get_str().data() != msg.data()
+        || m_var_bounds_finder.get_str().length() != msg.length())
+    {
+        m_var_bounds_finder.reset(msg);
+    }
+    if (m_var_bounds_finder.get_bounds_of_next_var(var_begin_pos, var_end_pos)) {
         // Append to log type: from end of last variable to start of current variable
         auto const constant{msg.substr(last_var_end_pos, var_begin_pos - last_var_end_pos)};
         ir::append_constant_to_logtype(constant, escape_handler, m_value);
@@ -8,6 +8,7 @@
 #include "DictionaryEntry.hpp"
 #include "ErrorCode.hpp"
 #include "FileReader.hpp"
+#include "ir/parsing.hpp"
 #include "ir/types.hpp"
 #include "streaming_compression/zstd/Compressor.hpp"
 #include "streaming_compression/zstd/Decompressor.hpp"
@@ -147,6 +148,8 @@ private:
     // Variables
     std::vector<size_t> m_placeholder_positions;
     size_t m_num_escaped_placeholders{0};
+    // Reused across `parse_next_var` calls for the same message
+    ir::VariableBoundsFinder m_var_bounds_finder;
 };
 }  // namespace clp
 
@@ -0,0 +1,454 @@
+#include "NetworkRangeReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "CurlDownloadHandler.hpp"
+#include "CurlOperationFailed.hpp"
+#include "ErrorCode.hpp"
+#include "Thread.hpp"
+
+namespace clp {
+namespace {
+/**
+ * The parameters shared by every range request a reader issues.
+ */
+struct RangeRequestConfig {
+    std::string_view src_url;
+    std::chrono::seconds overall_timeout;
+    std::chrono::seconds connection_timeout;
+    std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs;
+};
+
+/**
+ * A request for the blocks `[begin_block_id, end_block_id)`, which span the bytes
+ * `[begin_offset, end_offset)`, and the request's result.
+ */
+struct RangeRequest {
+    RangeRequest(size_t begin_block_id, size_t end_block_id, size_t begin_offset, size_t end_offset)
+            : begin_block_id{begin_block_id},
+              end_block_id{end_block_id},
+              begin_offset{begin_offset},
+              end_offset{end_offset} {}
+
+    size_t begin_block_id;
+    size_t end_block_id;
+    size_t begin_offset;
+    size_t end_offset;
+
+    // The total size of the data, set once a `Content-Range` header matching the request is
+    // received.
+    std::optional<size_t> total_size;
+    std::vector<char> buf;
+    CURLcode ret_code{CURLE_OK};
+    std::string error_msg;
+};
+
+/**
+ * A thread that performs range requests until there are none left. Requests are claimed through a
+ * shared index so that several threads can work through the same list.
+ */
+class RangeDownloaderThread : public Thread {
+public:
+    // Constructor
+    RangeDownloaderThread(
+            RangeRequestConfig const& config,
+            std::vector<RangeRequest>& requests,
+            std::atomic_size_t& next_request_idx
+    )
+            : m_config{config},
+              m_requests{requests},
+              m_next_request_idx{next_request_idx} {}
+
+private:
+    // Methods implementing `clp::Thread`
+    auto thread_method() -> void final;
+
+    RangeRequestConfig const& m_config;
+    std::vector<RangeRequest>& m_requests;
+    std::atomic_size_t& m_next_request_idx;
+};
+
+/**
+ * Performs the given range request.
+ * @param config
+ * @param request Returns the request's result.
+ */
+auto perform_range_request(RangeRequestConfig const& config, RangeRequest& request) -> void;
+
+/**
+ * libcurl progress callback. Range requests are never aborted, so this always lets the download
+ * continue.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @return 0
+ */
+extern "C" auto curl_range_progress_callback(
+        [[maybe_unused]] void* request_ptr,
+        [[maybe_unused]] curl_off_t dltotal,
+        [[maybe_unused]] curl_off_t dlnow,
+        [[maybe_unused]] curl_off_t ultotal,
+        [[maybe_unused]] curl_off_t ulnow
+) -> int {
+    return 0;
+}
+
+/**
+ * libcurl header callback that records the total size from the `Content-Range` header.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param buffer A pointer to the header
+ * @param size Always 1.
+ * @param nitems The length of the header.
+ * @param request_ptr A pointer to a `RangeRequest`.
+ * @return The number of bytes processed.
+ */
+extern "C" auto
+curl_range_header_callback(char* buffer, size_t size, size_t nitems, void* request_ptr) -> size_t {
+    auto& request{*static_cast<RangeRequest*>(request_ptr)};
+    std::string_view const header{buffer, size * nitems};
+    if (header.starts_with("HTTP/")) {
+        // A new response has started (e.g., after a redirect), so any previous header is stale.
+        request.total_size.reset();
+        return header.size();
+    }
+    if (auto const content_range{CurlDownloadHandler::parse_content_range_header(header)};
+        content_range.has_value() && content_range->begin_offset == request.begin_offset)
+    {
+        request.total_size = content_range->total_size;
+    }
+    return header.size();
+}
+
+/**
+ * libcurl write callback that appends downloaded data to the request's buffer.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param ptr A pointer to the downloaded data
+ * @param size Always 1.
+ * @param nmemb The number of bytes downloaded.
+ * @param request_ptr A pointer to a `RangeRequest`.
+ * @return On success, the number of bytes processed. If the response isn't a partial response for
+ * the requested range (i.e., the server ignored the range), 0 is returned to abort the download.
+ */
+extern "C" auto curl_range_write_callback(char* ptr, size_t size, size_t nmemb, void* request_ptr)
+        -> size_t {
+    auto& request{*static_cast<RangeRequest*>(request_ptr)};
+    auto const num_bytes{size * nmemb};
+    if (false == request.total_size.has_value()
+        || request.buf.size() + num_bytes > request.end_offset - request.begin_offset)
+    {
+        return 0;
+    }
+    request.buf.insert(request.buf.end(), ptr, ptr + num_bytes);
+    return num_bytes;
+}
+
+auto RangeDownloaderThread::thread_method() -> void {
+    while (true) {
+        auto const request_idx{m_next_request_idx.fetch_add(1)};
+        if (request_idx >= m_requests.size()) {
+            break;
+        }
+        perform_range_request(m_config, m_requests[request_idx]);
+    }
+}
+
+auto perform_range_request(RangeRequestConfig const& config, RangeRequest& request) -> void {
+    auto const error_msg_buf{std::make_shared<CurlDownloadHandler::ErrorMsgBuf>()};
+    try {
+        request.buf.reserve(request.end_offset - request.begin_offset);
+        CurlDownloadHandler curl_handler{
+                error_msg_buf,
+                curl_range_progress_callback,
+                curl_range_write_callback,
+                static_cast<void*>(&request),
+                config.src_url,
+                request.begin_offset,
+                false,
+                config.connection_timeout,
+                config.overall_timeout,
+                config.http_header_kv_pairs,
+                request.end_offset
+        };
+        curl_handler.set_header_callback(curl_range_header_callback, static_cast<void*>(&request));
+        request.ret_code = curl_handler.perform();
+        request.error_msg = error_msg_buf->data();
+    } catch (CurlOperationFailed const& ex) {
+        request.ret_code = ex.get_curl_err();
+        request.error_msg = ex.what();
+    }
+}
+}  // namespace
+
+NetworkRangeReader::NetworkRangeReader(
+        std::string_view src_url,
+        std::chrono::seconds overall_timeout,
+        std::chrono::seconds connection_timeout,
+        size_t block_size,
+        size_t max_num_cached_blocks,
+        size_t max_num_parallel_requests,
+        std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
+)
+        : m_src_url{src_url},
+          m_overall_timeout{overall_timeout},
+          m_connection_timeout{connection_timeout},
+          m_http_header_kv_pairs{std::move(http_header_kv_pairs)},
+          m_block_size{std::max(cMinBlockSize, block_size)},
+          m_max_num_cached_blocks{std::max(cMinNumCachedBlocks, max_num_cached_blocks)},
+          m_max_num_parallel_requests{std::max(size_t{1}, max_num_parallel_requests)} {
+    // Fetch the first block, which also tells us the size of the data and whether the server
+    // supports range requests.
+    RangeRequestConfig const config{
+            m_src_url,
+            m_overall_timeout,
+            m_connection_timeout,
+            m_http_header_kv_pairs
+    };
+    RangeRequest request{0, 1, 0, m_block_size};
+    perform_range_request(config, request);
+    ++m_num_requests;
+    m_num_bytes_downloaded += request.buf.size();
+
+    if (CURLE_OK != request.ret_code) {
+        m_curl_ret_code = request.ret_code;
+        m_curl_error_msg = std::move(request.error_msg);
+    }
+    if (false == request.total_size.has_value()) {
+        // Either the request failed before any header was received, or the server responded
+        // without a `Content-Range` header, meaning it ignored the range.
+        throw OperationFailed(
+                CURLE_OK == request.ret_code || CURLE_WRITE_ERROR == request.ret_code
+                        ? ErrorCode_Unsupported
+                        : ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__
+        );
+    }
+    m_size = request.total_size.value();
+    if (CURLE_OK != request.ret_code || std::min(m_size, m_block_size) != request.buf.size()) {
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+    cache_block(0, std::move(request.buf));
+    m_next_sequential_block_id = 1;
+}
+
+auto NetworkRangeReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> ErrorCode {
+    num_bytes_read = 0;
+    if (m_pos >= m_size) {
+        return ErrorCode_EndOfFile;
+    }
+
+    auto const end_pos{std::min(m_size, m_pos + num_bytes_to_read)};
+    auto const last_block_id{(end_pos - 1) / m_block_size};
+    while (m_pos < end_pos) {
+        auto const block_id{m_pos / m_block_size};
+        auto const* block{find_block(block_id)};
+        if (nullptr == block) {
+            // Grow the readahead window while misses are sequential, and reset it after a seek.
+            if (block_id == m_next_sequential_block_id) {
+                m_readahead_num_blocks
+                        = std::min(m_readahead_num_blocks * 2, cMaxReadaheadNumBlocks);
+            } else {
+                m_readahead_num_blocks = 1;
+            }
+            auto const fetch_end_block_id{std::min(
+                    {get_num_blocks(),
+                     block_id + m_max_num_cached_blocks,
+                     std::max(last_block_id + 1, block_id + m_readahead_num_blocks)}
+            )};
+
+            std::vector<size_t> block_ids;
+            for (auto id{block_id}; id < fetch_end_block_id; ++id) {
+                if (false == m_blocks.contains(id)) {
+                    block_ids.emplace_back(id);
+                }
+            }
+            if (auto const err{download_blocks(block_ids)}; ErrorCode_Success != err) {
+                return err;
+            }
+            m_next_sequential_block_id = fetch_end_block_id;
+
+            block = find_block(block_id);
+            if (nullptr == block) {
+                return ErrorCode_Failure;
+            }
+        }
+
+        auto const offset_in_block{m_pos - block_id * m_block_size};
+        auto const num_bytes_to_copy{
+                std::min(end_pos - m_pos, block->data.size() - offset_in_block)
+        };
+        std::memcpy(buf + num_bytes_read, block->data.data() + offset_in_block, num_bytes_to_copy);
+        m_pos += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+    }
+    return ErrorCode_Success;
+}
+
+auto NetworkRangeReader::try_seek_from_begin(size_t pos) -> ErrorCode {
+    if (pos > m_size) {
+        return ErrorCode_OutOfBounds;
+    }
+    m_pos = pos;
+    return ErrorCode_Success;
+}
+
+auto NetworkRangeReader::prefetch(std::vector<std::pair<size_t, size_t>> const& byte_ranges)
+        -> ErrorCode {
+    std::vector<size_t> block_ids;
+    for (auto const& [begin, end] : byte_ranges) {
+        auto const clamped_end{std::min(end, m_size)};
+        if (begin >= clamped_end) {
+            continue;
+        }
+        for (auto id{begin / m_block_size}; id <= (clamped_end - 1) / m_block_size; ++id) {
+            if (false == m_blocks.contains(id)) {
+                block_ids.emplace_back(id);
+            }
+        }
+    }
+    std::sort(block_ids.begin(), block_ids.end());
+    block_ids.erase(std::unique(block_ids.begin(), block_ids.end()), block_ids.end());
+    if (block_ids.size() > m_max_num_cached_blocks) {
+        block_ids.resize(m_max_num_cached_blocks);
+    }
+    return download_blocks(block_ids);
+}
+
+auto NetworkRangeReader::find_block(size_t block_id) -> Block const* {
+    auto const it{m_blocks.find(block_id)};
+    if (m_blocks.end() == it) {
+        return nullptr;
+    }
+    m_lru_block_ids.splice(m_lru_block_ids.begin(), m_lru_block_ids, it->second.lru_it);
+    return &it->second;
+}
+
+auto NetworkRangeReader::cache_block(size_t block_id, std::vector<char> data) -> void {
+    if (m_blocks.contains(block_id)) {
+        return;
+    }
+    m_lru_block_ids.push_front(block_id);
+    m_blocks.emplace(block_id, Block{std::move(data), m_lru_block_ids.begin()});
+    while (m_blocks.size() > m_max_num_cached_blocks) {
+        m_blocks.erase(m_lru_block_ids.back());
+        m_lru_block_ids.pop_back();
+    }
+}
+
+auto NetworkRangeReader::download_blocks(std::vector<size_t> const& block_ids) -> ErrorCode {
+    if (block_ids.empty()) {
+        return ErrorCode_Success;
+    }
+
+    // Coalesce the blocks into runs, filling small gaps since an extra block costs less than an
+    // extra round trip.
+    std::vector<std::pair<size_t, size_t>> runs;
+    size_t num_blocks_in_runs{0};
+    for (auto const block_id : block_ids) {
+        if (false == runs.empty() && block_id <= runs.back().second + cMaxCoalesceGapNumBlocks) {
+            num_blocks_in_runs += block_id + 1 - runs.back().second;
+            runs.back().second = block_id + 1;
+        } else {
+            runs.emplace_back(block_id, block_id + 1);
+            ++num_blocks_in_runs;
+        }
+    }
+
+    // Split long runs so that the blocks are spread across the parallel requests.
+    auto const max_num_blocks_per_request{
+            (num_blocks_in_runs + m_max_num_parallel_requests - 1) / m_max_num_parallel_requests
+    };
+    std::vector<RangeRequest> requests;
+    for (auto const& [run_begin, run_end] : runs) {
+        for (auto begin{run_begin}; begin < run_end; begin += max_num_blocks_per_request) {
+            auto const end{std::min(begin + max_num_blocks_per_request, run_end)};
+            requests.emplace_back(
+                    begin,
+                    end,
+                    begin * m_block_size,
+                    std::min(end * m_block_size, m_size)
+            );
+        }
+    }
+
+    RangeRequestConfig const config{
+            m_src_url,
+            m_overall_timeout,
+            m_connection_timeout,
+            m_http_header_kv_pairs
+    };
+    std::atomic_size_t next_request_idx{0};
+    auto const num_threads{std::min(requests.size(), m_max_num_parallel_requests)};
+    if (num_threads <= 1) {
+        for (auto& request : requests) {
+            perform_range_request(config, request);
+        }
+    } else {
+        std::vector<std::unique_ptr<RangeDownloaderThread>> threads;
+        threads.reserve(num_threads);
+        for (size_t i{0}; i < num_threads; ++i) {
+            threads.emplace_back(
+                    std::make_unique<RangeDownloaderThread>(config, requests, next_request_idx)
+            );
+            threads.back()->start();
+        }
+        for (auto& thread : threads) {
+            thread->join();
+        }
+    }
+    m_num_requests += requests.size();
+
+    auto error_code{ErrorCode_Success};
+    auto block_id_it{block_ids.cbegin()};
+    for (auto& request : requests) {
+        m_num_bytes_downloaded += request.buf.size();
+        if (CURLE_OK != request.ret_code) {
+            if (false == m_curl_ret_code.has_value()) {
+                m_curl_ret_code = request.ret_code;
+                m_curl_error_msg = std::move(request.error_msg);
+            }
+            error_code = ErrorCode_Failure;
+            continue;
+        }
+        if (request.end_offset - request.begin_offset != request.buf.size()) {
+            error_code = ErrorCode_Failure;
+            continue;
+        }
+
+        // Only cache the requested blocks, not the gaps filled in by coalescing, so that a batch
+        // never evicts its own blocks.
+        for (; block_ids.cend() != block_id_it && *block_id_it < request.end_block_id;
+             ++block_id_it)
+        {
+            auto const block_id{*block_id_it};
+            if (block_id < request.begin_block_id) {
+                continue;
+            }
+            auto const begin{request.buf.cbegin()
+                             + static_cast<std::ptrdiff_t>(
+                                     (block_id - request.begin_block_id) * m_block_size
+                             )};
+            auto const end{
+                    begin
+                    + static_cast<std::ptrdiff_t>(
+                            std::min(m_block_size, m_size - block_id * m_block_size)
+                    )
+            };
+            cache_block(block_id, std::vector<char>(begin, end));
+        }
+    }
+    return error_code;
+}
+}  // namespace clp
@@ -0,0 +1,242 @@
+#ifndef CLP_NETWORKRANGEREADER_HPP
+#define CLP_NETWORKRANGEREADER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "CurlDownloadHandler.hpp"
+#include "CurlGlobalInstance.hpp"
+#include "ErrorCode.hpp"
+#include "NetworkReader.hpp"
+#include "ReaderInterface.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * This class implements the ReaderInterface to randomly access data at a given URL using HTTP range
+ * requests, so that callers can read only the parts of a large remote object they need (e.g., a
+ * few sections of a single-file archive on S3) rather than streaming it from the start like
+ * `NetworkReader`.
+ *
+ * The data is fetched and cached in fixed-size blocks, with the least-recently used blocks evicted
+ * once the cache is full. When a read misses the cache, the missing blocks it needs are downloaded
+ * along with a readahead window that grows while reads are sequential and resets after a seek.
+ * Callers that know which byte ranges they'll read can also `prefetch` them. In both cases, missing
+ * blocks that are close to each other are coalesced into a single range request, and independent
+ * range requests are issued in parallel.
+ *
+ * The server must support range requests (i.e., respond with `206 Partial Content` and a
+ * `Content-Range` header), which is the case for S3 and most static file servers.
+ */
+class NetworkRangeReader : public ReaderInterface {
+public:
+    // Types
+    using CurlErrorInfo = NetworkReader::CurlErrorInfo;
+
+    /**
+     * The exception thrown by this class.
+     */
+    class OperationFailed : public TraceableException {
+    public:
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clp::NetworkRangeReader operation failed.";
+        }
+    };
+
+    // Constants
+    static constexpr size_t cDefaultBlockSize{64UL * 1024};
+    static constexpr size_t cDefaultMaxNumCachedBlocks{256};
+    static constexpr size_t cDefaultMaxNumParallelRequests{8};
+
+    static constexpr size_t cMinBlockSize{512};
+    // The readahead window must fit in the cache alongside the block being read.
+    static constexpr size_t cMinNumCachedBlocks{2};
+
+    // Two runs of missing blocks separated by at most this many blocks are fetched by one request.
+    static constexpr size_t cMaxCoalesceGapNumBlocks{1};
+    static constexpr size_t cMaxReadaheadNumBlocks{64};
+
+    // Constructors
+    /**
+     * Constructs a reader for the data at the given URL and fetches its first block to determine
+     * the data's size.
+     * NOTE: This class depends on `libcurl`, so an instance of `clp::CurlGlobalInstance` must
+     * remain alive for the entire lifespan of any instance of this class. See `NetworkReader` for
+     * details.
+     * @param src_url
+     * @param overall_timeout Maximum time that each range request may take. Note that this
+     * includes `connection_timeout`. Doc: https://curl.se/libcurl/c/CURLOPT_TIMEOUT.html
+     * @param connection_timeout Maximum time that the connection phase of each range request may
+     * take. Doc: https://curl.se/libcurl/c/CURLOPT_CONNECTTIMEOUT.html
+     * @param block_size The size of each cached block.
+     * @param max_num_cached_blocks The maximum number of blocks to cache.
+     * @param max_num_parallel_requests The maximum number of range requests to issue concurrently.
+     * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the server
+     * in each range request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+     * @throw NetworkRangeReader::OperationFailed with ErrorCode_Unsupported if the server doesn't
+     * support range requests.
+     * @throw NetworkRangeReader::OperationFailed with ErrorCode_Failure if the first block couldn't
+     * be downloaded.
+     */
+    explicit NetworkRangeReader(
+            std::string_view src_url,
+            std::chrono::seconds overall_timeout = CurlDownloadHandler::cDefaultOverallTimeout,
+            std::chrono::seconds connection_timeout
+            = CurlDownloadHandler::cDefaultConnectionTimeout,
+            size_t block_size = cDefaultBlockSize,
+            size_t max_num_cached_blocks = cDefaultMaxNumCachedBlocks,
+            size_t max_num_parallel_requests = cDefaultMaxNumParallelRequests,
+            std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
+            = std::nullopt
+    );
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of bytes, downloading any blocks that aren't cached.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_EndOfFile if the read head is at the end of the data.
+     * @return ErrorCode_Failure if a range request failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the data. No data is
+     * downloaded until the next read.
+     * @param pos
+     * @return ErrorCode_OutOfBounds if the given pos is past the end of the data.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the read head.
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> ErrorCode override {
+        pos = m_pos;
+        return ErrorCode_Success;
+    }
+
+    // Methods
+    [[nodiscard]] auto get_size() const -> size_t { return m_size; }
+
+    /**
+     * Downloads and caches the blocks covering the given byte ranges, so that subsequent reads of
+     * them don't need to wait on the network. Ranges past the end of the data are clamped, and if
+     * the ranges span more blocks than fit in the cache, only the leading blocks are fetched.
+     * @param byte_ranges A list of `[begin, end)` byte ranges.
+     * @return ErrorCode_Failure if a range request failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto prefetch(std::vector<std::pair<size_t, size_t>> const& byte_ranges)
+            -> ErrorCode;
+
+    /**
+     * @return The number of range requests issued so far.
+     */
+    [[nodiscard]] auto get_num_requests() const -> size_t { return m_num_requests; }
+
+    /**
+     * @return The number of bytes downloaded so far.
+     */
+    [[nodiscard]] auto get_num_bytes_downloaded() const -> size_t {
+        return m_num_bytes_downloaded;
+    }
+
+    /**
+     * @return CURL error info if a range request has failed with a CURL error.
+     * @return std::nullopt if no error has occurred.
+     */
+    [[nodiscard]] auto get_curl_error_info() const -> std::optional<CurlErrorInfo> {
+        if (false == m_curl_ret_code.has_value()) {
+            return std::nullopt;
+        }
+        return CurlErrorInfo{m_curl_ret_code.value(), m_curl_error_msg};
+    }
+
+private:
+    // Types
+    struct Block {
+        std::vector<char> data;
+        std::list<size_t>::iterator lru_it;
+    };
+
+    // Methods
+    [[nodiscard]] auto get_num_blocks() const -> size_t {
+        return (m_size + m_block_size - 1) / m_block_size;
+    }
+
+    /**
+     * @param block_id
+     * @return A pointer to the cached block with the given ID, which is marked as the most recently
+     * used, or nullptr if the block isn't cached.
+     */
+    [[nodiscard]] auto find_block(size_t block_id) -> Block const*;
+
+    /**
+     * Caches the given block, evicting the least recently used blocks if the cache is full. If the
+     * block is already cached, it's left unchanged.
+     * @param block_id
+     * @param data
+     */
+    auto cache_block(size_t block_id, std::vector<char> data) -> void;
+
+    /**
+     * Downloads and caches the given blocks, coalescing nearby blocks into the same range request
+     * and issuing up to `m_max_num_parallel_requests` requests concurrently.
+     * @param block_ids The IDs of the blocks to download, in ascending order and without
+     * duplicates.
+     * @return ErrorCode_Failure if any range request failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto download_blocks(std::vector<size_t> const& block_ids) -> ErrorCode;
+
+    // Variables
+    CurlGlobalInstance m_curl_global_instance;
+
+    std::string m_src_url;
+    std::chrono::seconds m_overall_timeout;
+    std::chrono::seconds m_connection_timeout;
+    std::optional<std::unordered_map<std::string, std::string>> m_http_header_kv_pairs;
+
+    size_t m_block_size{cDefaultBlockSize};
+    size_t m_max_num_cached_blocks{cDefaultMaxNumCachedBlocks};
+    size_t m_max_num_parallel_requests{cDefaultMaxNumParallelRequests};
+
+    size_t m_size{0};
+    size_t m_pos{0};
+
+    std::unordered_map<size_t, Block> m_blocks;
+    // Block IDs ordered from the most to the least recently used
+    std::list<size_t> m_lru_block_ids;
+
+    size_t m_readahead_num_blocks{1};
+    // The ID of the block after the last one fetched due to a cache miss, used to detect sequential
+    // reads.
+    size_t m_next_sequential_block_id{0};
+
+    size_t m_num_requests{0};
+    size_t m_num_bytes_downloaded{0};
+
+    std::optional<CURLcode> m_curl_ret_code;
+    std::string m_curl_error_msg;
+};
+}  // namespace clp
+
+#endif  // CLP_NETWORKRANGEREADER_HPP
@@ -112,6 +112,72 @@ extern "C" auto curl_write_callback(char* ptr, size_t size, size_t nmemb, void*
         -> size_t {
     return static_cast<NetworkReader*>(reader_ptr)->buffer_downloaded_data({ptr, size * nmemb});
 }
+
+/**
+ * libcurl progress callback used to cause libcurl to abort a chunk download if requested by the
+ * caller, or if the overall download has stopped (e.g., because another chunk download failed).
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param request_ptr A pointer to a `NetworkReader::ChunkRequest`.
+ * @param dltotal Unused
+ * @param dlnow Unused
+ * @param ultotal Unused
+ * @param ulnow Unused
+ * @return 1 if the download should be aborted, 0 otherwise.
+ */
+extern "C" auto curl_chunk_progress_callback(
+        void* request_ptr,
+        [[maybe_unused]] curl_off_t dltotal,
+        [[maybe_unused]] curl_off_t dlnow,
+        [[maybe_unused]] curl_off_t ultotal,
+        [[maybe_unused]] curl_off_t ulnow
+) -> int {
+    auto const& reader{*static_cast<NetworkReader::ChunkRequest*>(request_ptr)->reader};
+    return (reader.is_abort_download_requested() || false == reader.is_download_in_progress()) ? 1
+                                                                                              : 0;
+}
+
+/**
+ * libcurl header callback that records the total size from the `Content-Range` header of a chunk
+ * request's response.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param buffer A pointer to the header
+ * @param size Always 1.
+ * @param nitems The length of the header.
+ * @param request_ptr A pointer to a `NetworkReader::ChunkRequest`.
+ * @return The number of bytes processed.
+ */
+extern "C" auto
+curl_chunk_header_callback(char* buffer, size_t size, size_t nitems, void* request_ptr) -> size_t {
+    auto& request{*static_cast<NetworkReader::ChunkRequest*>(request_ptr)};
+    std::string_view const header{buffer, size * nitems};
+    if (header.starts_with("HTTP/")) {
+        // A new response has started (e.g., after a redirect), so any previous header is stale.
+        request.total_size.reset();
+        return header.size();
+    }
+    if (auto const content_range{CurlDownloadHandler::parse_content_range_header(header)};
+        content_range.has_value() && content_range->begin_offset == request.begin_offset)
+    {
+        request.total_size = content_range->total_size;
+    }
+    return header.size();
+}
+
+/**
+ * libcurl write callback that writes the data downloaded for a chunk into its chunk slot.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param ptr A pointer to the downloaded data
+ * @param size Always 1.
+ * @param nmemb The number of bytes downloaded.
+ * @param request_ptr A pointer to a `NetworkReader::ChunkRequest`.
+ * @return On success, the number of bytes processed. If this is less than `nmemb`, the download
+ * will be aborted.
+ */
+extern "C" auto
+curl_chunk_write_callback(char* ptr, size_t size, size_t nmemb, void* request_ptr) -> size_t {
+    auto& request{*static_cast<NetworkReader::ChunkRequest*>(request_ptr)};
+    return request.reader->buffer_downloaded_chunk_data(request, {ptr, size * nmemb});
+}
 }  // namespace
 
 NetworkReader::NetworkReader(
@@ -122,7 +188,9 @@ NetworkReader::NetworkReader(
         std::chrono::seconds connection_timeout,
         size_t buffer_pool_size,
         size_t buffer_size,
-        std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
+        std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs,
+        size_t num_connections,
+        size_t chunk_size
 )
         : m_src_url{src_url},
           m_offset{offset},
@@ -130,7 +198,31 @@ NetworkReader::NetworkReader(
           m_overall_timeout{overall_timeout},
           m_connection_timeout{connection_timeout},
           m_buffer_pool_size{std::max(cMinBufferPoolSize, buffer_pool_size)},
-          m_buffer_size{std::max(cMinBufferSize, buffer_size)} {
+          m_buffer_size{std::max(cMinBufferSize, buffer_size)},
+          m_num_connections{std::max(size_t{1}, num_connections)},
+          m_chunk_size{std::max(cMinChunkSize, chunk_size)} {
+    if (is_chunked_download()) {
+        // Two slots per connection let every connection keep downloading while the reader consumes
+        // the oldest chunk.
+        auto const num_chunk_slots{2 * m_num_connections};
+        m_chunk_slots.reserve(num_chunk_slots);
+        for (size_t i{0}; i < num_chunk_slots; ++i) {
+            m_chunk_slots.emplace_back(m_chunk_size);
+        }
+        m_chunk_downloader_threads.reserve(m_num_connections);
+        for (size_t i{0}; i < m_num_connections; ++i) {
+            m_chunk_downloader_threads.emplace_back(std::make_unique<ChunkDownloaderThread>(
+                    *this,
+                    disable_caching,
+                    http_header_kv_pairs
+            ));
+        }
+        for (auto& thread : m_chunk_downloader_threads) {
+            thread->start();
+        }
+        return;
+    }
+
     for (size_t i = 0; i < m_buffer_pool_size; ++i) {
         m_buffer_pool.emplace_back(m_buffer_size);
     }
@@ -213,6 +305,113 @@ auto NetworkReader::buffer_downloaded_data(NetworkReader::BufferView data) -> si
     return num_bytes_to_write;
 }
 
+auto NetworkReader::buffer_downloaded_chunk_data(ChunkRequest& request, BufferView data)
+        -> size_t {
+    if (data.empty()) {
+        return 0;
+    }
+    auto const num_bytes_to_write{data.size()};
+    std::unique_lock<std::mutex> buffer_resource_lock{m_buffer_resource_mutex};
+    if (false == request.is_response_validated) {
+        if (request.total_size.has_value()) {
+            if (false == m_total_size.has_value()) {
+                m_total_size = request.total_size;
+                m_downloader_cv.notify_all();
+            }
+        } else if (0 == request.chunk_idx && 0 == m_offset) {
+            // The server ignored the range, so the entire data is streamed over this connection.
+            m_is_range_unsupported = true;
+            m_downloader_cv.notify_all();
+        } else {
+            return 0;
+        }
+        request.is_response_validated = true;
+    }
+    if (false == at_least_one_byte_downloaded()) {
+        m_at_least_one_byte_downloaded.store(true);
+    }
+
+    while (false == data.empty()) {
+        auto* slot{&get_chunk_slot(request.chunk_idx)};
+        if (m_is_range_unsupported && m_chunk_size == slot->num_bytes_filled) {
+            // Move on to the next chunk's slot once it's free
+            slot->is_complete = true;
+            ++m_num_completed_chunks;
+            m_reader_cv.notify_all();
+            auto const next_chunk_idx{request.chunk_idx + 1};
+            m_downloader_cv.wait(buffer_resource_lock, [&] {
+                return is_abort_download_requested()
+                       || next_chunk_idx < m_next_chunk_idx_to_read + m_chunk_slots.size();
+            });
+            if (is_abort_download_requested()) {
+                return 0;
+            }
+            assign_chunk_slot(next_chunk_idx);
+            m_next_chunk_idx_to_download = next_chunk_idx + 1;
+            request.chunk_idx = next_chunk_idx;
+            slot = &get_chunk_slot(next_chunk_idx);
+        }
+
+        auto const num_bytes_to_copy{
+                std::min(data.size(), m_chunk_size - slot->num_bytes_filled)
+        };
+        if (false == m_is_range_unsupported && num_bytes_to_copy < data.size()) {
+            // The response is longer than the requested range
+            return 0;
+        }
+        // The reader only accesses the filled part of the slot, so the copy doesn't need the lock.
+        buffer_resource_lock.unlock();
+        std::copy_n(data.begin(), num_bytes_to_copy, slot->buf.data() + slot->num_bytes_filled);
+        buffer_resource_lock.lock();
+        slot->num_bytes_filled += num_bytes_to_copy;
+        data = data.subspan(num_bytes_to_copy);
+        m_reader_cv.notify_all();
+    }
+    return num_bytes_to_write;
+}
+
+auto NetworkReader::ChunkDownloaderThread::thread_method() -> void {
+    while (true) {
+        auto const chunk_idx{m_reader.claim_next_chunk()};
+        if (false == chunk_idx.has_value()) {
+            break;
+        }
+        auto const begin_offset{m_reader.get_chunk_begin_offset(chunk_idx.value())};
+        ChunkRequest request{
+                .reader = &m_reader,
+                .chunk_idx = chunk_idx.value(),
+                .begin_offset = begin_offset,
+                .total_size = std::nullopt,
+                .is_response_validated = false
+        };
+        auto const error_msg_buf{std::make_shared<CurlDownloadHandler::ErrorMsgBuf>()};
+        CURLcode ret_code{CURLE_OK};
+        try {
+            CurlDownloadHandler curl_handler{
+                    error_msg_buf,
+                    curl_chunk_progress_callback,
+                    curl_chunk_write_callback,
+                    static_cast<void*>(&request),
+                    m_reader.m_src_url,
+                    begin_offset,
+                    m_disable_caching,
+                    m_reader.m_connection_timeout,
+                    m_reader.m_overall_timeout,
+                    m_http_header_kv_pairs,
+                    begin_offset + m_reader.m_chunk_size
+            };
+            curl_handler.set_header_callback(
+                    curl_chunk_header_callback,
+                    static_cast<void*>(&request)
+            );
+            ret_code = curl_handler.perform();
+        } catch (CurlOperationFailed const& ex) {
+            ret_code = ex.get_curl_err();
+        }
+        m_reader.complete_chunk(request, ret_code, error_msg_buf->data());
+    }
+}
+
 auto NetworkReader::DownloaderThread::thread_method() -> void {
     try {
         CurlDownloadHandler curl_handler{
@@ -336,4 +535,130 @@ NetworkReader::read_from_filled_buffers(size_t num_bytes_to_read, size_t& num_by
     }
     return ErrorCode_Success;
 }
+
+auto NetworkReader::read_from_chunks(size_t num_bytes_to_read, size_t& num_bytes_read, char* dst)
+        -> ErrorCode {
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read) {
+        std::unique_lock<std::mutex> buffer_resource_lock{m_buffer_resource_mutex};
+        auto& slot{get_chunk_slot(m_next_chunk_idx_to_read)};
+        auto const is_slot_ready = [&]() -> bool {
+            return slot.chunk_idx == m_next_chunk_idx_to_read
+                   && (slot.num_bytes_filled > m_chunk_read_pos || slot.is_complete);
+        };
+        m_reader_cv.wait(buffer_resource_lock, [&] {
+            return is_slot_ready() || false == is_download_in_progress();
+        });
+        if (false == is_slot_ready()) {
+            break;
+        }
+        if (slot.num_bytes_filled == m_chunk_read_pos) {
+            // The chunk has been fully read, so free its slot for a later chunk.
+            slot.chunk_idx.reset();
+            ++m_next_chunk_idx_to_read;
+            m_chunk_read_pos = 0;
+            m_downloader_cv.notify_all();
+            continue;
+        }
+
+        auto const num_bytes_to_copy{std::min(
+                num_bytes_to_read - num_bytes_read,
+                slot.num_bytes_filled - m_chunk_read_pos
+        )};
+        // Downloaders never modify the filled part of the slot, so the copy doesn't need the lock.
+        buffer_resource_lock.unlock();
+        if (nullptr != dst) {
+            std::copy_n(
+                    slot.buf.data() + m_chunk_read_pos,
+                    num_bytes_to_copy,
+                    dst + num_bytes_read
+            );
+        }
+        m_chunk_read_pos += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+        m_file_pos += num_bytes_to_copy;
+    }
+    return (num_bytes_read > 0 || 0 == num_bytes_to_read) ? ErrorCode_Success
+                                                          : ErrorCode_EndOfFile;
+}
+
+auto NetworkReader::assign_chunk_slot(size_t chunk_idx) -> void {
+    auto& slot{get_chunk_slot(chunk_idx)};
+    slot.chunk_idx = chunk_idx;
+    slot.num_bytes_filled = 0;
+    slot.is_complete = false;
+}
+
+auto NetworkReader::claim_next_chunk() -> std::optional<size_t> {
+    std::unique_lock<std::mutex> buffer_resource_lock{m_buffer_resource_mutex};
+    auto const has_no_chunks_left = [&]() -> bool {
+        if (is_abort_download_requested() || false == is_download_in_progress()) {
+            return true;
+        }
+        if (0 == m_next_chunk_idx_to_download) {
+            return false;
+        }
+        // Once the server is known to ignore ranges, the first connection downloads everything.
+        return m_is_range_unsupported
+               || (m_total_size.has_value()
+                   && get_chunk_begin_offset(m_next_chunk_idx_to_download) >= m_total_size.value());
+    };
+    m_downloader_cv.wait(buffer_resource_lock, [&] {
+        if (has_no_chunks_left()) {
+            return true;
+        }
+        // Only the first chunk can be downloaded before the size of the data is known.
+        if (0 != m_next_chunk_idx_to_download && false == m_total_size.has_value()) {
+            return false;
+        }
+        return m_next_chunk_idx_to_download < m_next_chunk_idx_to_read + m_chunk_slots.size();
+    });
+    if (has_no_chunks_left()) {
+        return std::nullopt;
+    }
+    auto const chunk_idx{m_next_chunk_idx_to_download++};
+    assign_chunk_slot(chunk_idx);
+    return chunk_idx;
+}
+
+auto NetworkReader::complete_chunk(
+        ChunkRequest const& request,
+        CURLcode curl_code,
+        std::string_view curl_error_msg
+) -> void {
+    std::unique_lock<std::mutex> const buffer_resource_lock{m_buffer_resource_mutex};
+    if (false == is_download_in_progress()) {
+        return;
+    }
+
+    if (CURLE_OK != curl_code) {
+        auto& error_msg_buf{*m_curl_error_msg_buf};
+        auto const error_msg_length{std::min(curl_error_msg.size(), error_msg_buf.size() - 1)};
+        std::copy_n(curl_error_msg.begin(), error_msg_length, error_msg_buf.begin());
+        error_msg_buf.at(error_msg_length) = '\0';
+        set_download_completion_status(curl_code);
+    } else if (false == request.is_response_validated) {
+        // No data was received, which is only valid if the server ignored the range and the data
+        // is empty.
+        set_download_completion_status(0 == request.chunk_idx ? CURLE_OK : CURLE_PARTIAL_FILE);
+    } else {
+        auto& slot{get_chunk_slot(request.chunk_idx)};
+        slot.is_complete = true;
+        ++m_num_completed_chunks;
+        if (m_is_range_unsupported) {
+            set_download_completion_status(CURLE_OK);
+        } else {
+            auto const total_size{m_total_size.value()};
+            auto const chunk_begin_offset{get_chunk_begin_offset(request.chunk_idx)};
+            auto const num_chunks{(total_size - m_offset + m_chunk_size - 1) / m_chunk_size};
+            if (std::min(m_chunk_size, total_size - chunk_begin_offset) != slot.num_bytes_filled) {
+                set_download_completion_status(CURLE_PARTIAL_FILE);
+            } else if (num_chunks == m_num_completed_chunks) {
+                set_download_completion_status(CURLE_OK);
+            }
+        }
+    }
+    m_downloader_cv.notify_all();
+    m_reader_cv.notify_all();
+}
 }  // namespace clp
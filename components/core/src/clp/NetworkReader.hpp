@@ -1,6 +1,7 @@
 #ifndef CLP_NETWORKREADER_HPP
 #define CLP_NETWORKREADER_HPP
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -35,6 +36,14 @@ namespace clp {
  * downloading thread will block until there is, or until the download times out. Any read
  * operations will read from the next filled buffer from a queue. If no filled buffer is available,
  * the thread calling read will block until there is a filled buffer, or the download times out.
+ *
+ * Alternatively, the data can be downloaded over multiple connections in parallel, which helps when
+ * a single connection's throughput is the bottleneck (e.g., when ingesting a large object from S3).
+ * In this mode, the data is split into fixed-size chunks that are fetched with HTTP range requests
+ * by a pool of downloader threads, each into a slot from a ring of chunk buffers. Reads consume the
+ * chunks in order, and a chunk's slot is only reused once it has been fully read, which bounds both
+ * memory usage and how far the downloads can run ahead of the reader. If the server doesn't support
+ * range requests, the data is streamed over the first connection instead.
  */
 class NetworkReader : public ReaderInterface {
 public:
@@ -85,12 +94,30 @@ public:
         std::string_view m_message;
     };
 
+    /**
+     * The state of a range request for a chunk, when downloading over multiple connections.
+     * NOTE: This is only public so that the libcurl callbacks can access it.
+     */
+    struct ChunkRequest {
+        NetworkReader* reader;
+        size_t chunk_idx;
+        size_t begin_offset;
+        // The total size of the data, set once a `Content-Range` header matching the request is
+        // received.
+        std::optional<size_t> total_size;
+        // Whether the response has been checked to be for the requested chunk
+        bool is_response_validated{false};
+    };
+
     // Constants
     static constexpr size_t cDefaultBufferPoolSize{8};
     static constexpr size_t cDefaultBufferSize{4096};
+    static constexpr size_t cDefaultNumConnections{1};
+    static constexpr size_t cDefaultChunkSize{4UL * 1024 * 1024};
 
     static constexpr size_t cMinBufferPoolSize{2};
     static constexpr size_t cMinBufferSize{512};
+    static constexpr size_t cMinChunkSize{cMinBufferSize};
 
     /**
      * Constructs a reader to stream data from the given URL, starting at the given offset.
@@ -117,6 +144,10 @@ public:
      * @param buffer_size The size of each buffer in the buffer pool.
      * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the server
      * in the download request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+     * @param num_connections The number of connections to download the data over in parallel. If
+     * greater than 1, the data is downloaded in chunks of `chunk_size` bytes using range requests,
+     * `buffer_pool_size` and `buffer_size` are unused, and `overall_timeout` applies to each chunk.
+     * @param chunk_size The size of each chunk when downloading over multiple connections.
      */
     explicit NetworkReader(
             std::string_view src_url,
@@ -128,7 +159,9 @@ public:
             size_t buffer_pool_size = cDefaultBufferPoolSize,
             size_t buffer_size = cDefaultBufferSize,
             std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
-            = std::nullopt
+            = std::nullopt,
+            size_t num_connections = cDefaultNumConnections,
+            size_t chunk_size = cDefaultChunkSize
     );
 
     // Destructor
@@ -153,7 +186,7 @@ public:
      */
     [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
             -> ErrorCode override {
-        return read_from_filled_buffers(num_bytes_to_read, num_bytes_read, buf);
+        return read_downloaded_data(num_bytes_to_read, num_bytes_read, buf);
     }
 
     /**
@@ -173,7 +206,7 @@ public:
         }
         size_t num_bytes_read{};
         auto const num_bytes_to_read{pos - m_file_pos};
-        auto const err{read_from_filled_buffers(num_bytes_to_read, num_bytes_read, nullptr)};
+        auto const err{read_downloaded_data(num_bytes_to_read, num_bytes_read, nullptr)};
         if (ErrorCode_EndOfFile == err
             || (ErrorCode_Success == err && num_bytes_read < num_bytes_to_read))
         {
@@ -204,10 +237,14 @@ public:
      * @return Whether the downloader thread is running.
      */
     [[nodiscard]] auto is_downloader_thread_running() const -> bool {
-        if (nullptr == m_downloader_thread) {
-            return false;
+        if (nullptr != m_downloader_thread) {
+            return m_downloader_thread->is_running();
         }
-        return m_downloader_thread->is_running();
+        return std::any_of(
+                m_chunk_downloader_threads.cbegin(),
+                m_chunk_downloader_threads.cend(),
+                [](auto const& thread) { return thread->is_running(); }
+        );
     }
 
     /**
@@ -219,6 +256,19 @@ public:
      */
     [[nodiscard]] auto buffer_downloaded_data(BufferView data) -> size_t;
 
+    /**
+     * Buffers the data downloaded for the given chunk request in the request's chunk slot. If the
+     * server ignored the range of the first chunk request, the data is spread over consecutive
+     * chunk slots instead, waiting for slots to be freed by the reader as necessary.
+     * NOTE: This function should be called by the libcurl write callback of a chunk request only.
+     * @param request
+     * @param data
+     * @return Number of bytes buffered, or 0 if the response isn't for the requested chunk or the
+     * download was aborted.
+     */
+    [[nodiscard]] auto buffer_downloaded_chunk_data(ChunkRequest& request, BufferView data)
+            -> size_t;
+
     /**
      * @return Whether the downloader thread is still downloading data.
      */
@@ -290,6 +340,50 @@ private:
         std::optional<std::unordered_map<std::string, std::string>> m_http_header_kv_pairs;
     };
 
+    /**
+     * This class implements clp::Thread to download chunks of data using CURL, until there are no
+     * chunks left.
+     */
+    class ChunkDownloaderThread : public Thread {
+    public:
+        // Constructor
+        /**
+         * @param reader
+         * @param disable_caching Whether to disable caching.
+         * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the
+         * server in each range request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+         */
+        ChunkDownloaderThread(
+                NetworkReader& reader,
+                bool disable_caching,
+                std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
+        )
+                : m_reader{reader},
+                  m_disable_caching{disable_caching},
+                  m_http_header_kv_pairs{std::move(http_header_kv_pairs)} {}
+
+    private:
+        // Methods implementing `clp::Thread`
+        auto thread_method() -> void final;
+
+        NetworkReader& m_reader;
+        bool m_disable_caching{false};
+        std::optional<std::unordered_map<std::string, std::string>> m_http_header_kv_pairs;
+    };
+
+    /**
+     * A buffer for one chunk of the data, when downloading over multiple connections.
+     */
+    struct ChunkSlot {
+        explicit ChunkSlot(size_t size) : buf(size) {}
+
+        ystdlib::containers::Array<char> buf;
+        // The chunk currently assigned to the slot, if any
+        std::optional<size_t> chunk_idx;
+        size_t num_bytes_filled{0};
+        bool is_complete{false};
+    };
+
     /**
      * Submits a request to abort the ongoing curl download session.
      */
@@ -328,6 +422,77 @@ private:
     read_from_filled_buffers(size_t num_bytes_to_read, size_t& num_bytes_read, char* dst)
             -> ErrorCode;
 
+    /**
+     * Reads data from the chunk slots in chunk order, freeing each slot once its chunk has been
+     * fully read.
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @param dst A pointer to a destination buffer. If the pointer is not null, data will be
+     * copied to the destination.
+     * @return ErrorCode_EndOfFile if there's no more data to read.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto read_from_chunks(size_t num_bytes_to_read, size_t& num_bytes_read, char* dst)
+            -> ErrorCode;
+
+    /**
+     * Reads data using the method matching the download mode.
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @param dst
+     * @return Same as `read_from_chunks` or `read_from_filled_buffers`.
+     */
+    [[nodiscard]] auto
+    read_downloaded_data(size_t num_bytes_to_read, size_t& num_bytes_read, char* dst)
+            -> ErrorCode {
+        if (is_chunked_download()) {
+            return read_from_chunks(num_bytes_to_read, num_bytes_read, dst);
+        }
+        return read_from_filled_buffers(num_bytes_to_read, num_bytes_read, dst);
+    }
+
+    [[nodiscard]] auto is_chunked_download() const -> bool { return m_num_connections > 1; }
+
+    [[nodiscard]] auto get_chunk_begin_offset(size_t chunk_idx) const -> size_t {
+        return m_offset + chunk_idx * m_chunk_size;
+    }
+
+    /**
+     * NOTE: This method must be called with `m_buffer_resource_mutex` held.
+     * @param chunk_idx
+     * @return The slot for the given chunk.
+     */
+    [[nodiscard]] auto get_chunk_slot(size_t chunk_idx) -> ChunkSlot& {
+        return m_chunk_slots[chunk_idx % m_chunk_slots.size()];
+    }
+
+    /**
+     * Assigns the given chunk to its slot.
+     * NOTE: This method must be called with `m_buffer_resource_mutex` held, and only once the
+     * slot's previous chunk has been fully read.
+     * @param chunk_idx
+     */
+    auto assign_chunk_slot(size_t chunk_idx) -> void;
+
+    /**
+     * Claims the next chunk to download, waiting until the chunk's slot is free. Apart from the
+     * first chunk, this also waits until the first response has revealed the size of the data.
+     * @return The index of the claimed chunk, or std::nullopt if there are no chunks left to
+     * download or the download has stopped.
+     */
+    [[nodiscard]] auto claim_next_chunk() -> std::optional<size_t>;
+
+    /**
+     * Records the completion of the given chunk request, and updates the download completion status
+     * if the request failed or was the last one.
+     * @param request
+     * @param curl_code
+     * @param curl_error_msg
+     */
+    auto
+    complete_chunk(ChunkRequest const& request, CURLcode curl_code, std::string_view curl_error_msg)
+            -> void;
+
     /**
      * Sets the download completion status with the return code from curl.
      * @param curl_code
@@ -372,6 +537,19 @@ private:
     std::condition_variable m_reader_cv;
 
     std::unique_ptr<DownloaderThread> m_downloader_thread{nullptr};
+
+    size_t m_num_connections{cDefaultNumConnections};
+    size_t m_chunk_size{cDefaultChunkSize};
+    std::vector<ChunkSlot> m_chunk_slots;
+    std::vector<std::unique_ptr<ChunkDownloaderThread>> m_chunk_downloader_threads;
+    // These members are protected by `m_buffer_resource_mutex`
+    size_t m_next_chunk_idx_to_download{0};
+    size_t m_next_chunk_idx_to_read{0};
+    size_t m_num_completed_chunks{0};
+    std::optional<size_t> m_total_size;
+    bool m_is_range_unsupported{false};
+    // Only accessed by the reader thread
+    size_t m_chunk_read_pos{0};
     std::atomic<bool> m_at_least_one_byte_downloaded{false};
     std::atomic<bool> m_abort_download_requested{false};
 
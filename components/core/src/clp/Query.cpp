@@ -1,5 +1,7 @@
 #include "Query.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <set>
 #include <string>
@@ -113,6 +115,15 @@ void SubQuery::add_imprecise_dict_var(
 
 void SubQuery::set_possible_logtypes(unordered_set<logtype_dictionary_id_t> const& logtype_ids) {
     m_possible_logtypes = logtype_ids;
+
+    m_possible_logtypes_bitmap.clear();
+    for (auto const logtype_id : m_possible_logtypes) {
+        auto const word_ix{static_cast<size_t>(logtype_id) / cNumBitsPerBitmapWord};
+        if (word_ix >= m_possible_logtypes_bitmap.size()) {
+            m_possible_logtypes_bitmap.resize(word_ix + 1, 0);
+        }
+        m_possible_logtypes_bitmap[word_ix] |= uint64_t{1} << (logtype_id % cNumBitsPerBitmapWord);
+    }
 }
 
 void SubQuery::mark_wildcard_match_required() {
@@ -148,13 +159,10 @@ void SubQuery::calculate_ids_of_matching_segments(
 void SubQuery::clear() {
     m_vars.clear();
     m_possible_logtypes.clear();
+    m_possible_logtypes_bitmap.clear();
     m_wildcard_match_required = false;
 }
 
-bool SubQuery::matches_logtype(logtype_dictionary_id_t const logtype) const {
-    return m_possible_logtypes.count(logtype) > 0;
-}
-
 Query::Query(
         epochtime_t search_begin_timestamp,
         epochtime_t search_end_timestamp,
@@ -178,9 +186,22 @@ void Query::make_sub_queries_relevant_to_segment(segment_id_t segment_id) {
 
     // Make sub-queries relevant to segment
     m_relevant_sub_queries.clear();
+    m_relevant_logtypes_bitmap.clear();
     for (auto& sub_query : m_sub_queries) {
         if (sub_query.get_ids_of_matching_segments().count(segment_id)) {
             m_relevant_sub_queries.push_back(&sub_query);
+
+            auto const& bitmap = sub_query.get_possible_logtypes_bitmap();
+            if (bitmap.size() > m_relevant_logtypes_bitmap.size()) {
+                m_relevant_logtypes_bitmap.resize(bitmap.size(), 0);
+            }
+            std::transform(
+                    bitmap.cbegin(),
+                    bitmap.cend(),
+                    m_relevant_logtypes_bitmap.cbegin(),
+                    m_relevant_logtypes_bitmap.begin(),
+                    [](uint64_t lhs, uint64_t rhs) { return lhs | rhs; }
+            );
         }
     }
     m_prev_segment_id = segment_id;
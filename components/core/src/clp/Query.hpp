@@ -1,6 +1,8 @@
 #ifndef CLP_QUERY_HPP
 #define CLP_QUERY_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <set>
 #include <string>
@@ -76,6 +78,9 @@ private:
  */
 class SubQuery {
 public:
+    // Constants
+    static constexpr size_t cNumBitsPerBitmapWord{64};
+
     // Methods
     auto operator==(SubQuery const& rhs) const -> bool = default;
 
@@ -143,7 +148,21 @@ public:
      * @param logtype
      * @return true if matched, false otherwise
      */
-    bool matches_logtype(logtype_dictionary_id_t logtype) const;
+    bool matches_logtype(logtype_dictionary_id_t logtype) const {
+        auto const word_ix{static_cast<size_t>(logtype) / cNumBitsPerBitmapWord};
+        auto const bit_ix{logtype % cNumBitsPerBitmapWord};
+        return word_ix < m_possible_logtypes_bitmap.size()
+               && 0 != ((m_possible_logtypes_bitmap[word_ix] >> bit_ix) & 1U);
+    }
+
+    /**
+     * @return A bitmap of the possible logtypes in this subquery, where bit `i` of word
+     * `i / cNumBitsPerBitmapWord` is set if logtype `i` is possible. Logtypes beyond the end of the
+     * bitmap aren't possible.
+     */
+    std::vector<uint64_t> const& get_possible_logtypes_bitmap() const {
+        return m_possible_logtypes_bitmap;
+    }
     /**
      * Whether the given variables contain the subquery's variables in order (but not necessarily
      * contiguously)
@@ -157,6 +176,8 @@ public:
 private:
     // Variables
     std::unordered_set<logtype_dictionary_id_t> m_possible_logtypes;
+    // Dense copy of `m_possible_logtypes`, so that scans can check each message's logtype cheaply
+    std::vector<uint64_t> m_possible_logtypes_bitmap;
     std::set<segment_id_t> m_ids_of_matching_segments;
     std::vector<QueryVar> m_vars;
     bool m_wildcard_match_required{false};
@@ -214,6 +235,19 @@ public:
         return m_relevant_sub_queries;
     }
 
+    /**
+     * Whether the given logtype ID matches one of the possible logtypes in any relevant sub-query.
+     * This allows scans to skip messages before checking each relevant sub-query.
+     * @param logtype
+     * @return true if matched, false otherwise
+     */
+    bool logtype_matches_relevant_sub_queries(logtype_dictionary_id_t logtype) const {
+        auto const word_ix{static_cast<size_t>(logtype) / SubQuery::cNumBitsPerBitmapWord};
+        auto const bit_ix{logtype % SubQuery::cNumBitsPerBitmapWord};
+        return word_ix < m_relevant_logtypes_bitmap.size()
+               && 0 != ((m_relevant_logtypes_bitmap[word_ix] >> bit_ix) & 1U);
+    }
+
     /**
      * Calculates the segment IDs that should contain a match for each subquery's logtypes and
      * QueryVars.
@@ -238,6 +272,8 @@ private:
     bool m_search_string_matches_all{true};
     std::vector<SubQuery> m_sub_queries;
     std::vector<SubQuery const*> m_relevant_sub_queries;
+    // Union of the possible-logtype bitmaps of the relevant sub-queries
+    std::vector<uint64_t> m_relevant_logtypes_bitmap;
     segment_id_t m_prev_segment_id{cInvalidSegmentId};
 };
 
@@ -50,6 +50,11 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                     po::value<string>(&config_file_path)->value_name("FILE")
                             ->default_value(config_file_path),
                     "Use configuration options from FILE"
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_threads)->value_name("NUM")
+                            ->default_value(m_num_threads),
+                    "Number of threads to search segments with"
             );
     // clang-format on
     m_metadata_db_config.emplace(options_general);
@@ -261,6 +266,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             }
         }
 
+        if (m_num_threads < 1) {
+            throw invalid_argument("num-threads must be non-zero.");
+        }
+
         switch (output_method_input) {
             case (char)OutputMethod::StdoutText:
             case (char)OutputMethod::StdoutBinary:
@@ -1,9 +1,18 @@
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <string>
+#include <vector>
 
 #include <log_surgeon/Lexer.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -17,6 +26,7 @@
 #include "../GrepCore.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/Constants.hpp"
+#include "../Thread.hpp"
 #include "../Utils.hpp"
 #include "CommandLineArguments.hpp"
 
@@ -39,15 +49,121 @@ using clp::streaming_archive::reader::Archive;
 using clp::streaming_archive::reader::File;
 using clp::streaming_archive::reader::Message;
 using clp::string_utils::clean_up_wildcard_search_string;
+using clp::Thread;
 using clp::TraceableException;
 using clp::variable_dictionary_id_t;
 using std::cerr;
 using std::cout;
 using std::endl;
+using std::make_unique;
 using std::string;
 using std::to_string;
 using std::vector;
 
+namespace {
+/**
+ * Buffers search results before writing them to stdout. Each search thread has its own buffer, so
+ * that results from different threads don't interleave and stdout only needs to be locked once per
+ * batch of results.
+ */
+class OutputBuffer {
+public:
+    // Constants
+    static constexpr size_t cFlushThreshold{64UL * 1024};
+
+    // Constructors
+    explicit OutputBuffer(std::mutex& stdout_mutex) : m_stdout_mutex{stdout_mutex} {}
+
+    // Delete copy & move constructors and assignment operators
+    OutputBuffer(OutputBuffer const&) = delete;
+    OutputBuffer(OutputBuffer&&) = delete;
+    auto operator=(OutputBuffer const&) -> OutputBuffer& = delete;
+    auto operator=(OutputBuffer&&) -> OutputBuffer& = delete;
+
+    // Methods
+    auto append(char const* data, size_t length) -> void { m_buf.append(data, length); }
+
+    /**
+     * Appends the object representation of the given value.
+     * @tparam T
+     * @param value
+     */
+    template <typename T>
+    auto append_value(T const& value) -> void {
+        append(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+
+    /**
+     * Flushes the buffer if it has reached the flush threshold. Callers should only call this
+     * between results so that a result is never split across batches.
+     */
+    auto flush_if_full() -> void {
+        if (m_buf.size() >= cFlushThreshold) {
+            flush();
+        }
+    }
+
+    auto flush() -> void;
+
+private:
+    // Variables
+    std::string m_buf;
+    std::mutex& m_stdout_mutex;
+};
+
+/**
+ * Searches the files in the segments claimed from a shared list, one segment at a time.
+ */
+class SearchThread : public Thread {
+public:
+    // Constructors
+    SearchThread(
+            vector<Query> const& queries,
+            CommandLineArguments const& command_line_args,
+            Archive& archive,
+            Archive::ThreadLocalReader& archive_reader,
+            vector<std::optional<segment_id_t>> const& segments_to_search,
+            std::atomic_size_t& next_segment_ix,
+            std::mutex& stdout_mutex
+    )
+            : m_queries{queries},
+              m_command_line_args{command_line_args},
+              m_archive{archive},
+              m_archive_reader{archive_reader},
+              m_segments_to_search{segments_to_search},
+              m_next_segment_ix{next_segment_ix},
+              m_stdout_mutex{stdout_mutex} {}
+
+    // Methods
+    /**
+     * @return Whether all claimed segments were searched successfully. Only valid after the
+     * thread has been joined.
+     */
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+    /**
+     * @return The number of matches found. Only valid after the thread has been joined.
+     */
+    [[nodiscard]] auto get_num_matches() const -> size_t { return m_num_matches; }
+
+protected:
+    // Methods
+    void thread_method() override;
+
+private:
+    // Variables
+    vector<Query> m_queries;
+    CommandLineArguments const& m_command_line_args;
+    Archive& m_archive;
+    Archive::ThreadLocalReader& m_archive_reader;
+    vector<std::optional<segment_id_t>> const& m_segments_to_search;
+    std::atomic_size_t& m_next_segment_ix;
+    std::mutex& m_stdout_mutex;
+    size_t m_num_matches{0};
+    bool m_succeeded{false};
+};
+}  // namespace
+
 /**
  * Opens the archive and reads the dictionaries
  * @param archive_path
@@ -58,50 +174,76 @@ static bool open_archive(string const& archive_path, Archive& archive_reader);
 /**
  * Opens a compressed file or logs any errors if it couldn't be opened
  * @param file_metadata_ix
- * @param archive
+ * @param archive_reader
  * @param compressed_file
  * @return true on success, false otherwise
  */
 static bool open_compressed_file(
         MetadataDB::FileIterator& file_metadata_ix,
-        Archive& archive,
+        Archive::ThreadLocalReader& archive_reader,
         File& compressed_file
 );
+/**
+ * Searches the files in the segments claimed from a shared list until there are no more segments
+ * to claim
+ * @param queries
+ * @param command_line_args
+ * @param archive
+ * @param archive_reader The calling thread's reader for the archive
+ * @param segments_to_search The segments to search, where std::nullopt means all files in the
+ * archive
+ * @param next_segment_ix Index of the next unclaimed segment in `segments_to_search`
+ * @param stdout_mutex
+ * @return The total number of matches found across all segments
+ */
+static size_t search_segments(
+        vector<Query>& queries,
+        CommandLineArguments const& command_line_args,
+        Archive& archive,
+        Archive::ThreadLocalReader& archive_reader,
+        vector<std::optional<segment_id_t>> const& segments_to_search,
+        std::atomic_size_t& next_segment_ix,
+        std::mutex& stdout_mutex
+);
 /**
  * Searches all files referenced by a given database cursor
  * @param queries
  * @param output_method
  * @param archive
+ * @param archive_reader
  * @param file_metadata_ix
+ * @param output_buffer
  * @return The total number of matches found across all files
  */
 static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod output_method,
         Archive& archive,
-        MetadataDB::FileIterator& file_metadata_ix
+        Archive::ThreadLocalReader& archive_reader,
+        MetadataDB::FileIterator& file_metadata_ix,
+        OutputBuffer& output_buffer
 );
 /**
- * Prints search result to stdout in text format
+ * Buffers search result for stdout in text format
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg The OutputBuffer to append to
  */
-static void print_result_text(
+static void buffer_result_text(
         string const& orig_file_path,
         Message const& compressed_msg,
         string const& decompressed_msg,
         void* custom_arg
 );
 /**
- * Prints search result to stdout in binary format
+ * Buffers search result for stdout in binary format
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg The OutputBuffer to append to
  */
-static void print_result_binary(
+static void buffer_result_binary(
         string const& orig_file_path,
         Message const& compressed_msg,
         string const& decompressed_msg,
@@ -138,6 +280,57 @@ static GlobalMetadataDB::ArchiveIterator* get_archive_iterator(
     }
 }
 
+namespace {
+auto OutputBuffer::flush() -> void {
+    if (m_buf.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> const lock{m_stdout_mutex};
+        if (fwrite(m_buf.data(), sizeof(char), m_buf.size(), stdout) < m_buf.size()) {
+            SPDLOG_ERROR("Failed to write results to stdout, errno={}", errno);
+        }
+    }
+    m_buf.clear();
+}
+
+void SearchThread::thread_method() {
+    try {
+        m_num_matches = search_segments(
+                m_queries,
+                m_command_line_args,
+                m_archive,
+                m_archive_reader,
+                m_segments_to_search,
+                m_next_segment_ix,
+                m_stdout_mutex
+        );
+        m_succeeded = true;
+    } catch (TraceableException& e) {
+        auto const error_code = e.get_error_code();
+        if (ErrorCode_errno == error_code) {
+            SPDLOG_ERROR(
+                    "Search failed: {}:{} {}, errno={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    errno
+            );
+        } else {
+            SPDLOG_ERROR(
+                    "Search failed: {}:{} {}, error_code={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    error_code
+            );
+        }
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("Search failed: Unexpected exception - {}", e.what());
+    }
+}
+}  // namespace
+
 static bool open_archive(string const& archive_path, Archive& archive_reader) {
     ErrorCode error_code;
 
@@ -271,45 +464,92 @@ static bool search(
         }
 
         if (!no_queries_match) {
-            size_t num_matches;
+            // Files in different segments can be searched independently, so each segment is a
+            // unit of work that can be claimed by any search thread.
+            vector<std::optional<segment_id_t>> segments_to_search;
             if (is_superseding_query) {
-                auto file_metadata_ix = archive.get_file_iterator(
-                        search_begin_ts,
-                        search_end_ts,
-                        command_line_args.get_file_path(),
-                        false
-                );
-                num_matches = search_files(
-                        queries,
-                        command_line_args.get_output_method(),
-                        archive,
-                        *file_metadata_ix
-                );
+                if (1 == command_line_args.get_num_threads()) {
+                    segments_to_search.emplace_back(std::nullopt);
+                } else {
+                    std::set<segment_id_t> ids_of_segments_in_range;
+                    auto file_metadata_ix = archive.get_file_iterator(
+                            search_begin_ts,
+                            search_end_ts,
+                            command_line_args.get_file_path(),
+                            false
+                    );
+                    for (; file_metadata_ix->has_next(); file_metadata_ix->next()) {
+                        ids_of_segments_in_range.emplace(file_metadata_ix->get_segment_id());
+                    }
+                    segments_to_search.assign(
+                            ids_of_segments_in_range.cbegin(),
+                            ids_of_segments_in_range.cend()
+                    );
+                }
             } else {
-                auto file_metadata_ix_ptr = archive.get_file_iterator(
-                        search_begin_ts,
-                        search_end_ts,
-                        command_line_args.get_file_path(),
-                        clp::cInvalidSegmentId,
-                        false
+                segments_to_search.emplace_back(clp::cInvalidSegmentId);
+                segments_to_search.insert(
+                        segments_to_search.end(),
+                        ids_of_segments_to_search.cbegin(),
+                        ids_of_segments_to_search.cend()
                 );
-                auto& file_metadata_ix = *file_metadata_ix_ptr;
-                num_matches = search_files(
+            }
+
+            auto const num_threads = std::min(
+                    command_line_args.get_num_threads(),
+                    std::max<size_t>(segments_to_search.size(), 1)
+            );
+            // Opening a reader may write to the archive's metadata DB, so the readers are opened
+            // sequentially before any thread starts.
+            vector<Archive::ThreadLocalReader> archive_readers(num_threads);
+            for (auto& archive_reader : archive_readers) {
+                archive_reader.open(archive);
+            }
+
+            std::atomic_size_t next_segment_ix{0};
+            std::mutex stdout_mutex;
+            size_t num_matches{0};
+            bool all_segments_searched_successfully{true};
+            if (1 == num_threads) {
+                num_matches = search_segments(
                         queries,
-                        command_line_args.get_output_method(),
+                        command_line_args,
                         archive,
-                        file_metadata_ix
+                        archive_readers.front(),
+                        segments_to_search,
+                        next_segment_ix,
+                        stdout_mutex
                 );
-                for (auto segment_id : ids_of_segments_to_search) {
-                    file_metadata_ix.set_segment_id(segment_id);
-                    num_matches += search_files(
+            } else {
+                vector<std::unique_ptr<SearchThread>> search_threads;
+                search_threads.reserve(num_threads);
+                for (auto& archive_reader : archive_readers) {
+                    auto& search_thread = search_threads.emplace_back(make_unique<SearchThread>(
                             queries,
-                            command_line_args.get_output_method(),
+                            command_line_args,
                             archive,
-                            file_metadata_ix
-                    );
+                            archive_reader,
+                            segments_to_search,
+                            next_segment_ix,
+                            stdout_mutex
+                    ));
+                    search_thread->start();
+                }
+                for (auto& search_thread : search_threads) {
+                    search_thread->join();
+                    if (false == search_thread->succeeded()) {
+                        all_segments_searched_successfully = false;
+                    }
+                    num_matches += search_thread->get_num_matches();
                 }
             }
+
+            for (auto& archive_reader : archive_readers) {
+                archive_reader.close();
+            }
+            if (false == all_segments_searched_successfully) {
+                return false;
+            }
             SPDLOG_DEBUG("# matches found: {}", num_matches);
         }
     } catch (TraceableException& e) {
@@ -340,10 +580,10 @@ static bool search(
 
 static bool open_compressed_file(
         MetadataDB::FileIterator& file_metadata_ix,
-        Archive& archive,
+        Archive::ThreadLocalReader& archive_reader,
         File& compressed_file
 ) {
-    ErrorCode error_code = archive.open_file(compressed_file, file_metadata_ix);
+    ErrorCode error_code = archive_reader.open_file(compressed_file, file_metadata_ix);
     if (clp::ErrorCode_Success == error_code) {
         return true;
     }
@@ -359,26 +599,70 @@ static bool open_compressed_file(
     return false;
 }
 
+static size_t search_segments(
+        vector<Query>& queries,
+        CommandLineArguments const& command_line_args,
+        Archive& archive,
+        Archive::ThreadLocalReader& archive_reader,
+        vector<std::optional<segment_id_t>> const& segments_to_search,
+        std::atomic_size_t& next_segment_ix,
+        std::mutex& stdout_mutex
+) {
+    size_t num_matches = 0;
+
+    OutputBuffer output_buffer{stdout_mutex};
+    for (auto segment_ix = next_segment_ix++; segment_ix < segments_to_search.size();
+         segment_ix = next_segment_ix++)
+    {
+        auto const& segment_id = segments_to_search[segment_ix];
+        auto file_metadata_ix
+                = segment_id.has_value()
+                          ? archive_reader.get_file_iterator(
+                                    command_line_args.get_search_begin_ts(),
+                                    command_line_args.get_search_end_ts(),
+                                    command_line_args.get_file_path(),
+                                    segment_id.value(),
+                                    false
+                            )
+                          : archive_reader.get_file_iterator(
+                                    command_line_args.get_search_begin_ts(),
+                                    command_line_args.get_search_end_ts(),
+                                    command_line_args.get_file_path(),
+                                    false
+                            );
+        num_matches += search_files(
+                queries,
+                command_line_args.get_output_method(),
+                archive,
+                archive_reader,
+                *file_metadata_ix,
+                output_buffer
+        );
+    }
+    output_buffer.flush();
+
+    return num_matches;
+}
+
 static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod const output_method,
         Archive& archive,
-        MetadataDB::FileIterator& file_metadata_ix
+        Archive::ThreadLocalReader& archive_reader,
+        MetadataDB::FileIterator& file_metadata_ix,
+        OutputBuffer& output_buffer
 ) {
     size_t num_matches = 0;
 
     File compressed_file;
     // Setup output method
     Grep::OutputFunc output_func;
-    void* output_func_arg;
     switch (output_method) {
         case CommandLineArguments::OutputMethod::StdoutText:
-            output_func = print_result_text;
-            output_func_arg = nullptr;
+            output_func = buffer_result_text;
             break;
         case CommandLineArguments::OutputMethod::StdoutBinary:
-            output_func = print_result_binary;
-            output_func_arg = nullptr;
+            output_func = buffer_result_binary;
             break;
         default:
             SPDLOG_ERROR("Unknown output method - {}", (char)output_method);
@@ -387,7 +671,7 @@ static size_t search_files(
 
     // Run all queries on each file
     for (; file_metadata_ix.has_next(); file_metadata_ix.next()) {
-        if (open_compressed_file(file_metadata_ix, archive, compressed_file)) {
+        if (open_compressed_file(file_metadata_ix, archive_reader, compressed_file)) {
             Grep::calculate_sub_queries_relevant_to_file(compressed_file, queries);
 
             for (auto const& query : queries) {
@@ -398,7 +682,7 @@ static size_t search_files(
                         archive,
                         compressed_file,
                         output_func,
-                        output_func_arg
+                        &output_buffer
                 );
             }
         }
@@ -408,77 +692,48 @@ static size_t search_files(
     return num_matches;
 }
 
-static void print_result_text(
+static void buffer_result_text(
         string const& orig_file_path,
         Message const& compressed_msg,
         string const& decompressed_msg,
         void* custom_arg
 ) {
-    printf("%s:%s", orig_file_path.c_str(), decompressed_msg.c_str());
+    auto& output_buffer = *static_cast<OutputBuffer*>(custom_arg);
+    output_buffer.append(orig_file_path.c_str(), orig_file_path.length());
+    output_buffer.append(":", 1);
+    output_buffer.append(decompressed_msg.c_str(), decompressed_msg.length());
+    output_buffer.flush_if_full();
 }
 
-static void print_result_binary(
+static void buffer_result_binary(
         string const& orig_file_path,
         Message const& compressed_msg,
         string const& decompressed_msg,
         void* custom_arg
 ) {
-    bool write_successful = true;
-    do {
-        size_t length;
-        size_t num_elems_written;
-
-        // Write file path
-        length = orig_file_path.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
-        num_elems_written = fwrite(orig_file_path.c_str(), sizeof(char), length, stdout);
-        if (num_elems_written < length) {
-            write_successful = false;
-            break;
-        }
+    auto& output_buffer = *static_cast<OutputBuffer*>(custom_arg);
 
-        // Write timestamp
-        epochtime_t timestamp = compressed_msg.get_ts_in_milli();
-        num_elems_written = fwrite(&timestamp, sizeof(timestamp), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
+    // Write file path
+    output_buffer.append_value(orig_file_path.length());
+    output_buffer.append(orig_file_path.c_str(), orig_file_path.length());
 
-        // Write logtype ID
-        auto logtype_id = compressed_msg.get_logtype_id();
-        num_elems_written = fwrite(&logtype_id, sizeof(logtype_id), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
+    // Write timestamp
+    output_buffer.append_value(compressed_msg.get_ts_in_milli());
 
-        // Write message
-        length = decompressed_msg.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
-        num_elems_written = fwrite(decompressed_msg.c_str(), sizeof(char), length, stdout);
-        if (num_elems_written < length) {
-            write_successful = false;
-            break;
-        }
-    } while (false);
-    if (!write_successful) {
-        SPDLOG_ERROR("Failed to write result in binary form, errno={}", errno);
-    }
+    // Write logtype ID
+    output_buffer.append_value(compressed_msg.get_logtype_id());
+
+    // Write message
+    output_buffer.append_value(decompressed_msg.length());
+    output_buffer.append(decompressed_msg.c_str(), decompressed_msg.length());
+
+    output_buffer.flush_if_full();
 }
 
 int main(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
@@ -327,6 +327,10 @@ auto CommandLineArguments::parse_search_arguments(
             "file-path",
             po::value<string>(&m_file_path)->value_name("PATH"),
             "Limit search to files with the path PATH"
+    )(
+            "num-threads",
+            po::value<size_t>(&m_num_threads)->value_name("NUM")->default_value(m_num_threads),
+            "Number of threads to search segments with"
     );
 
     po::options_description options_aggregation("Aggregation Options");
@@ -553,6 +557,10 @@ auto CommandLineArguments::parse_search_arguments(
         throw invalid_argument("file-path cannot be an empty string.");
     }
 
+    if (m_num_threads < 1) {
+        throw invalid_argument("num-threads must be non-zero.");
+    }
+
     // Validate count by time bucket size
     if (parsed_command_line_options.count("count-by-time") > 0) {
         m_do_count_by_time_aggregation = true;
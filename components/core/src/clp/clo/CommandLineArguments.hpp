@@ -73,6 +73,8 @@ public:
 
     epochtime_t get_search_end_ts() const { return m_search_end_ts; }
 
+    size_t get_num_threads() const { return m_num_threads; }
+
     std::string const& get_mongodb_uri() const { return m_mongodb_uri; }
 
     std::string const& get_mongodb_collection() const { return m_mongodb_collection; }
@@ -194,6 +196,7 @@ private:
     std::string m_search_string;
     std::string m_file_path;
     epochtime_t m_search_begin_ts, m_search_end_ts;
+    size_t m_num_threads{1};
 
     // Network output variables
     std::string m_network_dest_host;
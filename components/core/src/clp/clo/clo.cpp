@@ -1,9 +1,15 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <mongocxx/instance.hpp>
 #include <nlohmann/json.hpp>
@@ -19,6 +25,7 @@
 #include "../GrepCore.hpp"
 #include "../ir/constants.hpp"
 #include "../spdlog_with_specializations.hpp"
+#include "../Thread.hpp"
 #include "../Utils.hpp"
 #include "CommandLineArguments.hpp"
 #include "constants.hpp"
@@ -51,11 +58,13 @@ using clp::streaming_archive::reader::Archive;
 using clp::streaming_archive::reader::File;
 using clp::streaming_archive::reader::Message;
 using clp::string_utils::clean_up_wildcard_search_string;
+using clp::Thread;
 using clp::TraceableException;
 using clp::variable_dictionary_id_t;
 using std::cerr;
 using std::cout;
 using std::endl;
+using std::make_unique;
 using std::runtime_error;
 using std::string;
 using std::to_string;
@@ -100,6 +109,23 @@ static void search_files(
         std::unique_ptr<OutputHandler>& output_handler,
         std::set<clp::segment_id_t> const& segments_to_search
 );
+/**
+ * Searches the given segments on multiple threads. Each thread claims one segment at a time, opens
+ * its files through its own archive reader, and adds its results to the output handler in batches.
+ * @param command_line_args
+ * @param query
+ * @param archive
+ * @param output_handler
+ * @param segments_to_search
+ * @return Whether all claimed segments were searched successfully
+ */
+static bool search_segments_in_parallel(
+        CommandLineArguments const& command_line_args,
+        Query const& query,
+        Archive& archive,
+        std::unique_ptr<OutputHandler>& output_handler,
+        vector<segment_id_t> const& segments_to_search
+);
 /**
  * Searches an archive with the given path
  * @param command_line_args
@@ -112,6 +138,94 @@ static bool search_archive(
 );
 
 namespace {
+/**
+ * State shared by the threads searching an archive in parallel.
+ */
+struct SharedSearchState {
+    SharedSearchState(
+            std::unique_ptr<OutputHandler>& output_handler,
+            vector<segment_id_t> const& segments_to_search
+    )
+            : output_handler{output_handler},
+              segments_to_search{segments_to_search} {}
+
+    // Output handlers aren't thread-safe, so all accesses must hold `output_handler_mutex`.
+    std::unique_ptr<OutputHandler>& output_handler;
+    std::mutex output_handler_mutex;
+    vector<segment_id_t> const& segments_to_search;
+    std::atomic_size_t next_segment_ix{0};
+    // Set once any thread fails to send a result, so that all threads stop searching.
+    std::atomic_bool result_send_failed{false};
+};
+
+/**
+ * Searches the files in the segments claimed from the shared state, buffering results before adding
+ * them to the shared output handler.
+ */
+class SearchThread : public Thread {
+public:
+    // Constants
+    static constexpr size_t cResultBatchSize{1024};
+
+    // Constructors
+    SearchThread(
+            CommandLineArguments const& command_line_args,
+            Query const& query,
+            Archive& archive,
+            Archive::ThreadLocalReader& archive_reader,
+            SharedSearchState& shared_state
+    )
+            : m_command_line_args{command_line_args},
+              m_query{query},
+              m_archive{archive},
+              m_archive_reader{archive_reader},
+              m_shared_state{shared_state} {}
+
+    // Methods
+    /**
+     * @return Whether all claimed segments were searched successfully. Only valid after the
+     * thread has been joined.
+     */
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+protected:
+    // Methods
+    void thread_method() override;
+
+private:
+    // Types
+    struct BufferedResult {
+        string orig_file_path;
+        string orig_file_id;
+        Message encoded_message;
+        string decompressed_message;
+    };
+
+    // Methods
+    /**
+     * Searches all files in the given segment.
+     * @param segment_id
+     * @return Whether all results were sent successfully.
+     */
+    auto search_segment(segment_id_t segment_id) -> bool;
+
+    /**
+     * Adds all buffered results to the shared output handler.
+     * @return Whether all results were sent successfully.
+     */
+    auto flush_results() -> bool;
+
+    // Variables
+    CommandLineArguments const& m_command_line_args;
+    Query m_query;
+    Archive& m_archive;
+    Archive::ThreadLocalReader& m_archive_reader;
+    SharedSearchState& m_shared_state;
+    vector<BufferedResult> m_results;
+    size_t m_num_results{0};
+    bool m_succeeded{false};
+};
+
 /**
  * Extracts a file split as IR chunks, writing them to the local filesystem and writing their
  * metadata to the results cache.
@@ -366,6 +480,140 @@ bool search(CommandLineArguments const& command_line_args) {
     }
 }
 
+void SearchThread::thread_method() {
+    try {
+        for (auto segment_ix = m_shared_state.next_segment_ix++;
+             segment_ix < m_shared_state.segments_to_search.size();
+             segment_ix = m_shared_state.next_segment_ix++)
+        {
+            if (m_shared_state.result_send_failed) {
+                break;
+            }
+            if (false == search_segment(m_shared_state.segments_to_search[segment_ix])) {
+                m_shared_state.result_send_failed = true;
+                break;
+            }
+        }
+        m_succeeded = true;
+    } catch (TraceableException& e) {
+        auto const error_code = e.get_error_code();
+        if (ErrorCode_errno == error_code) {
+            SPDLOG_ERROR(
+                    "Search failed: {}:{} {}, errno={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    errno
+            );
+        } else {
+            SPDLOG_ERROR(
+                    "Search failed: {}:{} {}, error_code={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    error_code
+            );
+        }
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("Search failed: Unexpected exception - {}", e.what());
+    }
+}
+
+auto SearchThread::search_segment(segment_id_t segment_id) -> bool {
+    auto file_metadata_ix_ptr = m_archive_reader.get_file_iterator(
+            m_command_line_args.get_search_begin_ts(),
+            m_command_line_args.get_search_end_ts(),
+            m_command_line_args.get_file_path(),
+            segment_id,
+            true
+    );
+    auto& file_metadata_ix = *file_metadata_ix_ptr;
+
+    File compressed_file;
+    for (; file_metadata_ix.has_next(); file_metadata_ix.next()) {
+        if (m_shared_state.result_send_failed) {
+            return true;
+        }
+
+        {
+            std::lock_guard<std::mutex> const lock{m_shared_state.output_handler_mutex};
+            if (m_shared_state.output_handler->can_skip_file(file_metadata_ix)) {
+                continue;
+            }
+        }
+
+        ErrorCode error_code = m_archive_reader.open_file(compressed_file, file_metadata_ix);
+        if (ErrorCode_Success != error_code) {
+            string orig_path;
+            file_metadata_ix.get_path(orig_path);
+            if (ErrorCode_errno == error_code) {
+                SPDLOG_ERROR("Failed to open {}, errno={}", orig_path.c_str(), errno);
+            } else {
+                SPDLOG_ERROR("Failed to open {}, error={}", orig_path.c_str(), error_code);
+            }
+            continue;
+        }
+
+        m_query.make_sub_queries_relevant_to_segment(compressed_file.get_segment_id());
+        while (true) {
+            // Results are decompressed directly into the buffer, reusing the buffered results'
+            // allocations across batches.
+            if (m_num_results == m_results.size()) {
+                m_results.emplace_back();
+            }
+            auto& result = m_results[m_num_results];
+            if (false
+                == Grep::search_and_decompress(
+                        m_query,
+                        m_archive,
+                        compressed_file,
+                        result.encoded_message,
+                        result.decompressed_message
+                ))
+            {
+                break;
+            }
+            result.orig_file_path = compressed_file.get_orig_path();
+            result.orig_file_id = compressed_file.get_orig_file_id_as_string();
+            ++m_num_results;
+
+            if (m_num_results >= cResultBatchSize && false == flush_results()) {
+                m_archive.close_file(compressed_file);
+                return false;
+            }
+        }
+        m_archive.close_file(compressed_file);
+    }
+
+    // Flush at the end of each segment so that `can_skip_file` sees the latest results before the
+    // next segment is searched.
+    return flush_results();
+}
+
+auto SearchThread::flush_results() -> bool {
+    if (0 == m_num_results) {
+        return true;
+    }
+    auto const num_results = m_num_results;
+    m_num_results = 0;
+
+    std::lock_guard<std::mutex> const lock{m_shared_state.output_handler_mutex};
+    for (size_t i = 0; i < num_results; ++i) {
+        auto const& result = m_results[i];
+        if (ErrorCode_Success
+            != m_shared_state.output_handler->add_result(
+                    result.orig_file_path,
+                    result.orig_file_id,
+                    result.encoded_message,
+                    result.decompressed_message
+            ))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool validate_archive_path(std::filesystem::path const& archive_path) {
     if (false == std::filesystem::exists(archive_path)) {
         SPDLOG_ERROR("Archive '{}' doesn't exist.", archive_path.string());
@@ -475,6 +723,52 @@ void search_files(
     }
 }
 
+static bool search_segments_in_parallel(
+        CommandLineArguments const& command_line_args,
+        Query const& query,
+        Archive& archive,
+        std::unique_ptr<OutputHandler>& output_handler,
+        vector<segment_id_t> const& segments_to_search
+) {
+    auto const num_threads = std::min(
+            command_line_args.get_num_threads(),
+            std::max<size_t>(segments_to_search.size(), 1)
+    );
+    // Opening a reader may write to the archive's metadata DB, so the readers are opened
+    // sequentially before any thread starts.
+    vector<Archive::ThreadLocalReader> archive_readers(num_threads);
+    for (auto& archive_reader : archive_readers) {
+        archive_reader.open(archive);
+    }
+
+    SharedSearchState shared_state{output_handler, segments_to_search};
+    vector<unique_ptr<SearchThread>> search_threads;
+    search_threads.reserve(num_threads);
+    for (auto& archive_reader : archive_readers) {
+        auto& search_thread = search_threads.emplace_back(make_unique<SearchThread>(
+                command_line_args,
+                query,
+                archive,
+                archive_reader,
+                shared_state
+        ));
+        search_thread->start();
+    }
+
+    bool all_segments_searched_successfully = true;
+    for (auto& search_thread : search_threads) {
+        search_thread->join();
+        if (false == search_thread->succeeded()) {
+            all_segments_searched_successfully = false;
+        }
+    }
+
+    for (auto& archive_reader : archive_readers) {
+        archive_reader.close();
+    }
+    return all_segments_searched_successfully;
+}
+
 static bool search_archive(
         CommandLineArguments const& command_line_args,
         std::unique_ptr<OutputHandler> output_handler
@@ -550,13 +844,44 @@ static bool search_archive(
             true
     );
     auto& file_metadata_ix = *file_metadata_ix_ptr;
-    search_files(
-            query,
-            archive_reader,
-            file_metadata_ix,
-            output_handler,
-            ids_of_segments_to_search
-    );
+    if (1 == command_line_args.get_num_threads()) {
+        search_files(
+                query,
+                archive_reader,
+                file_metadata_ix,
+                output_handler,
+                ids_of_segments_to_search
+        );
+    } else {
+        // Collect the segments to search in the order their files are iterated (by descending
+        // segment end timestamp), so that segments likely to contain the latest results are
+        // claimed first.
+        vector<segment_id_t> segments_to_search;
+        std::unordered_set<segment_id_t> ids_of_collected_segments;
+        for (; file_metadata_ix.has_next(); file_metadata_ix.next()) {
+            auto const segment_id = file_metadata_ix.get_segment_id();
+            if (query.contains_sub_queries() && 0 == ids_of_segments_to_search.count(segment_id))
+            {
+                continue;
+            }
+            if (ids_of_collected_segments.emplace(segment_id).second) {
+                segments_to_search.push_back(segment_id);
+            }
+        }
+        if (false
+            == search_segments_in_parallel(
+                    command_line_args,
+                    query,
+                    archive_reader,
+                    output_handler,
+                    segments_to_search
+            ))
+        {
+            file_metadata_ix_ptr.reset(nullptr);
+            archive_reader.close();
+            return false;
+        }
+    }
     file_metadata_ix_ptr.reset(nullptr);
 
     archive_reader.close();
@@ -575,7 +900,7 @@ static bool search_archive(
 int main(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
@@ -347,6 +347,31 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->value_name("LEVEL")
                             ->default_value(m_compression_level),
                     "1 (fast/low compression) to 19 (slow/high compression)"
+            )(
+                    "compression-workers",
+                    po::value<int>(&m_compression_worker_options.num_workers)
+                            ->value_name("NUM")
+                            ->default_value(m_compression_worker_options.num_workers),
+                    "Number of threads zstd uses to compress each segment (0 compresses on the"
+                    " archive's thread)"
+            )(
+                    "compression-job-size",
+                    po::value<size_t>(&m_compression_worker_options.job_size)
+                            ->value_name("SIZE")
+                            ->default_value(m_compression_worker_options.job_size),
+                    "Size (B) of each job handed to a compression thread (0 lets zstd choose)"
+            )(
+                    "compression-long-distance-matching",
+                    po::bool_switch(
+                            &m_compression_worker_options.enable_long_distance_matching
+                    ),
+                    "Find matches far apart in large segments at the cost of memory"
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_threads),
+                    "Number of threads to compress with. Each thread writes its own archives."
             )(
                     "print-archive-stats-progress",
                     po::bool_switch(&m_print_archive_stats_progress),
@@ -416,6 +441,21 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                 throw invalid_argument("target-data-size-of-dictionaries must be non-zero.");
             }
 
+            if (m_num_threads < 1) {
+                throw invalid_argument("num-threads must be non-zero.");
+            }
+
+            if (m_compression_worker_options.num_workers < 0) {
+                throw invalid_argument("compression-workers cannot be negative.");
+            }
+            if (0 != m_compression_worker_options.job_size
+                && 0 == m_compression_worker_options.num_workers)
+            {
+                throw invalid_argument(
+                        "compression-job-size requires compression-workers to be positive."
+                );
+            }
+
             if (false == m_path_prefix_to_remove.empty()) {
                 if (false == boost::filesystem::exists(m_path_prefix_to_remove)) {
                     throw invalid_argument("Specified prefix to remove does not exist.");
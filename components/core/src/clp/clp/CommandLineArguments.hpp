@@ -9,6 +9,7 @@
 
 #include "../CommandLineArgumentsBase.hpp"
 #include "../GlobalMetadataDBConfig.hpp"
+#include "../streaming_compression/zstd/Compressor.hpp"
 
 namespace clp::clp {
 class CommandLineArguments : public CommandLineArgumentsBase {
@@ -62,6 +63,12 @@ public:
 
     int get_compression_level() const { return m_compression_level; }
 
+    streaming_compression::zstd::WorkerOptions const& get_compression_worker_options() const {
+        return m_compression_worker_options;
+    }
+
+    size_t get_num_threads() const { return m_num_threads; }
+
     Command get_command() const { return m_command; }
 
     std::string const& get_archives_dir() const { return m_archives_dir; }
@@ -100,6 +107,8 @@ private:
     size_t m_target_segment_uncompressed_size;
     size_t m_target_data_size_of_dictionaries;
     int m_compression_level;
+    streaming_compression::zstd::WorkerOptions m_compression_worker_options;
+    size_t m_num_threads{1};
     Command m_command;
     std::string m_archives_dir;
     std::vector<std::string> m_input_paths;
@@ -3,9 +3,12 @@
 
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <vector>
 
+#include "../EncodedVariableInterpreter.hpp"
 #include "../ErrorCode.hpp"
 #include "../FileWriter.hpp"
 #include "../ir/constants.hpp"
@@ -37,6 +40,9 @@ public:
      * Decompresses the given file split into one or more IR files (chunks). The function creates a
      * new IR chunk when the current IR chunk exceeds ir_target_size.
      *
+     * Messages are transcoded directly from their archive encoding (logtype and encoded variables)
+     * into IR, rather than being decompressed into text and then re-parsed.
+     *
      * @tparam IrOutputHandler Function to handle the resulting IR chunks.
      * Signature: (std::filesystem::path const& ir_file_path, string const& orig_file_id,
      * size_t begin_message_ix, size_t end_message_ix, bool is_last_chunk) -> bool;
@@ -113,15 +119,19 @@ auto FileDecompressor::decompress_to_ir(
         return false;
     }
 
-    while (archive_reader.get_next_message(m_encoded_file, m_encoded_message)) {
-        if (false
-            == archive_reader
-                       .decompress_message_without_ts(m_encoded_message, m_decompressed_message))
-        {
-            SPDLOG_ERROR("Failed to decompress message");
-            return false;
-        }
+    auto const& logtype_dict = archive_reader.get_logtype_dictionary();
+    auto const& var_dict = archive_reader.get_var_dictionary();
+    auto const transcode_message = [&](std::string& logtype, std::vector<int8_t>& ir_buf) -> bool {
+        return EncodedVariableInterpreter::transcode_message_to_four_byte_ir(
+                logtype_dict.get_entry(m_encoded_message.get_logtype_id()),
+                var_dict,
+                m_encoded_message.get_vars(),
+                logtype,
+                ir_buf
+        );
+    };
 
+    while (archive_reader.get_next_message(m_encoded_file, m_encoded_message)) {
         if (ir_serializer.get_serialized_size() >= ir_target_size) {
             ir_serializer.close();
 
@@ -146,14 +156,14 @@ auto FileDecompressor::decompress_to_ir(
         }
 
         if (false
-            == ir_serializer.serialize_log_event(
+            == ir_serializer.serialize_encoded_log_event(
                     m_encoded_message.get_ts_in_milli(),
-                    m_decompressed_message
+                    transcode_message
             ))
         {
             SPDLOG_ERROR(
-                    "Failed to serialize log event: {} with ts {}",
-                    m_decompressed_message.c_str(),
+                    "Failed to transcode log event with logtype ID {} and ts {}",
+                    m_encoded_message.get_logtype_id(),
                     m_encoded_message.get_ts_in_milli()
             );
             return false;
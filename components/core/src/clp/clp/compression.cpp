@@ -1,8 +1,12 @@
 #include "compression.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 #include <archive_entry.h>
 #include <boost/filesystem/operations.hpp>
@@ -12,6 +16,8 @@
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/writer/Archive.hpp"
 #include "../streaming_archive/writer/utils.hpp"
+#include "../Thread.hpp"
+#include "../TraceableException.hpp"
 #include "../Utils.hpp"
 #include "FileCompressor.hpp"
 #include "utils.hpp"
@@ -27,6 +33,29 @@ using std::unique_ptr;
 using std::vector;
 
 namespace clp::clp {
+namespace {
+/**
+ * A range of files that must be compressed in order into the same sequence of archives: either a
+ * single ungrouped file or all files in a group.
+ */
+struct CompressionTask {
+    vector<FileToCompress>::const_iterator begin;
+    vector<FileToCompress>::const_iterator end;
+};
+
+/**
+ * State shared by all threads compressing a set of files.
+ */
+struct SharedCompressionState {
+    vector<CompressionTask> tasks;
+    std::atomic_size_t next_task_ix{0};
+    size_t num_files_to_compress{0};
+    std::atomic_size_t num_files_compressed{0};
+    std::mutex progress_mutex;
+    std::mutex global_metadata_db_mutex;
+};
+}  // namespace
+
 // Local prototypes
 /**
  * Comparator to sort files based on their group ID
@@ -43,6 +72,99 @@ static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress c
  */
 static bool
 file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress const& rhs);
+/**
+ * Claims tasks from the shared state and compresses them into a sequence of archives until no tasks
+ * remain. The archives' IDs and creator ID are generated by this method, so each caller writes its
+ * own sequence of archives.
+ * @param command_line_args
+ * @param archive_user_config
+ * @param empty_directory_paths Empty directories to add to the first archive, or nullptr if there
+ * are none. If non-null, an archive is created even if there are no tasks to claim.
+ * @param target_encoded_file_size
+ * @param reader_parser
+ * @param use_heuristic
+ * @param shared_state
+ * @return true if all claimed files were compressed successfully, false otherwise
+ */
+static bool compress_tasks(
+        CommandLineArguments const& command_line_args,
+        streaming_archive::writer::Archive::UserConfig archive_user_config,
+        vector<string> const* empty_directory_paths,
+        size_t target_encoded_file_size,
+        std::unique_ptr<log_surgeon::ReaderParser> reader_parser,
+        bool use_heuristic,
+        SharedCompressionState& shared_state
+);
+
+namespace {
+/**
+ * Thread that runs `compress_tasks`.
+ */
+class CompressionThread : public Thread {
+public:
+    // Constructors
+    CompressionThread(
+            CommandLineArguments const& command_line_args,
+            streaming_archive::writer::Archive::UserConfig const& archive_user_config,
+            vector<string> const* empty_directory_paths,
+            size_t target_encoded_file_size,
+            std::unique_ptr<log_surgeon::ReaderParser> reader_parser,
+            bool use_heuristic,
+            SharedCompressionState& shared_state
+    )
+            : m_command_line_args{command_line_args},
+              m_archive_user_config{archive_user_config},
+              m_empty_directory_paths{empty_directory_paths},
+              m_target_encoded_file_size{target_encoded_file_size},
+              m_reader_parser{std::move(reader_parser)},
+              m_use_heuristic{use_heuristic},
+              m_shared_state{shared_state} {}
+
+    // Methods
+    /**
+     * @return Whether all files claimed by the thread were compressed successfully. Only valid
+     * after the thread has been joined.
+     */
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+protected:
+    // Methods
+    void thread_method() override {
+        try {
+            m_succeeded = compress_tasks(
+                    m_command_line_args,
+                    m_archive_user_config,
+                    m_empty_directory_paths,
+                    m_target_encoded_file_size,
+                    std::move(m_reader_parser),
+                    m_use_heuristic,
+                    m_shared_state
+            );
+        } catch (TraceableException& e) {
+            SPDLOG_ERROR(
+                    "Compression failed: {}:{} {}, error_code={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    e.get_error_code()
+            );
+        } catch (std::exception& e) {
+            SPDLOG_ERROR("Compression failed: Unexpected exception - {}", e.what());
+        }
+    }
+
+private:
+    // Variables
+    CommandLineArguments const& m_command_line_args;
+    streaming_archive::writer::Archive::UserConfig m_archive_user_config;
+    vector<string> const* m_empty_directory_paths;
+    size_t m_target_encoded_file_size;
+    std::unique_ptr<log_surgeon::ReaderParser> m_reader_parser;
+    bool m_use_heuristic;
+    SharedCompressionState& m_shared_state;
+    bool m_succeeded{false};
+};
+}  // namespace
 
 static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress const& rhs) {
     return lhs.get_group_id() < rhs.get_group_id();
@@ -54,6 +176,85 @@ file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress con
            > boost::filesystem::last_write_time(rhs.get_path());
 }
 
+static bool compress_tasks(
+        CommandLineArguments const& command_line_args,
+        streaming_archive::writer::Archive::UserConfig archive_user_config,
+        vector<string> const* empty_directory_paths,
+        size_t target_encoded_file_size,
+        std::unique_ptr<log_surgeon::ReaderParser> reader_parser,
+        bool use_heuristic,
+        SharedCompressionState& shared_state
+) {
+    auto claim_task = [&]() -> CompressionTask const* {
+        auto const task_ix = shared_state.next_task_ix++;
+        if (task_ix >= shared_state.tasks.size()) {
+            return nullptr;
+        }
+        return &shared_state.tasks[task_ix];
+    };
+
+    auto const* task = claim_task();
+    if (nullptr == task && nullptr == empty_directory_paths) {
+        // Avoid creating an empty archive
+        return true;
+    }
+
+    auto uuid_generator = boost::uuids::random_generator();
+    archive_user_config.id = uuid_generator();
+    archive_user_config.creator_id = uuid_generator();
+    archive_user_config.creation_num = 0;
+
+    // Open Archive
+    streaming_archive::writer::Archive archive_writer;
+    // Set schema file if specified by user
+    if (false == use_heuristic) {
+        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
+    }
+    // Open archive
+    archive_writer.open(archive_user_config);
+
+    if (nullptr != empty_directory_paths) {
+        archive_writer.add_empty_directories(*empty_directory_paths);
+    }
+
+    bool all_files_compressed_successfully = true;
+    FileCompressor file_compressor(uuid_generator, std::move(reader_parser));
+    auto target_data_size_of_dictionaries
+            = command_line_args.get_target_data_size_of_dictionaries();
+
+    // Compress all files
+    for (; nullptr != task; task = claim_task()) {
+        for (auto it = task->begin; it != task->end; ++it) {
+            if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries)
+            {
+                split_archive(archive_user_config, archive_writer);
+            }
+            if (false
+                == file_compressor.compress_file(
+                        target_data_size_of_dictionaries,
+                        archive_user_config,
+                        target_encoded_file_size,
+                        *it,
+                        archive_writer,
+                        use_heuristic
+                ))
+            {
+                all_files_compressed_successfully = false;
+            }
+            if (command_line_args.show_progress()) {
+                auto const num_files_compressed = ++shared_state.num_files_compressed;
+                std::lock_guard<std::mutex> const progress_lock{shared_state.progress_mutex};
+                cerr << "Compressed " << num_files_compressed << '/'
+                     << shared_state.num_files_to_compress << " files" << '\r';
+            }
+        }
+    }
+
+    archive_writer.close();
+
+    return all_files_compressed_successfully;
+}
+
 bool compress(
         CommandLineArguments& command_line_args,
         vector<FileToCompress>& files_to_compress,
@@ -82,101 +283,102 @@ bool compress(
         return false;
     }
 
-    auto uuid_generator = boost::uuids::random_generator();
-
     // Setup config
+    // NOTE: The archive & creator IDs are generated by each thread that writes archives.
     streaming_archive::writer::Archive::UserConfig archive_user_config;
-    archive_user_config.id = uuid_generator();
-    archive_user_config.creator_id = uuid_generator();
     archive_user_config.creation_num = 0;
     archive_user_config.target_segment_uncompressed_size
             = command_line_args.get_target_segment_uncompressed_size();
     archive_user_config.compression_level = command_line_args.get_compression_level();
+    archive_user_config.compression_worker_options
+            = command_line_args.get_compression_worker_options();
     archive_user_config.output_dir = command_line_args.get_output_dir();
     archive_user_config.global_metadata_db = global_metadata_db.get();
     archive_user_config.print_archive_stats_progress
             = command_line_args.print_archive_stats_progress();
 
-    // Open Archive
-    streaming_archive::writer::Archive archive_writer;
-    // Set schema file if specified by user
-    if (false == command_line_args.get_use_heuristic()) {
-        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
-    }
-    // Open archive
-    archive_writer.open(archive_user_config);
-
-    archive_writer.add_empty_directories(empty_directory_paths);
-
-    bool all_files_compressed_successfully = true;
-    FileCompressor file_compressor(uuid_generator, std::move(reader_parser));
-    auto target_data_size_of_dictionaries
-            = command_line_args.get_target_data_size_of_dictionaries();
-
-    // Compress all files
-    size_t num_files_compressed = 0;
-    size_t num_files_to_compress = 0;
-    if (command_line_args.show_progress()) {
-        num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size();
-    }
     if (command_line_args.sort_input_files()) {
         sort(files_to_compress.begin(),
              files_to_compress.end(),
              file_gt_last_write_time_comparator);
     }
-    for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
-        }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    *it,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
-            all_files_compressed_successfully = false;
-        }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
-    }
-
     // Sort files by group ID to avoid spreading groups over multiple segments
     sort(grouped_files_to_compress.begin(),
          grouped_files_to_compress.end(),
          file_group_id_comparator);
-    // Compress grouped files
-    for (auto const& file_to_compress : grouped_files_to_compress) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
+
+    // Ungrouped files can be compressed independently, whereas each group must be compressed by a
+    // single thread so that it isn't spread over multiple archives.
+    SharedCompressionState shared_state;
+    shared_state.tasks.reserve(files_to_compress.size() + grouped_files_to_compress.size());
+    for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
+        shared_state.tasks.push_back({it, it + 1});
+    }
+    for (auto it = grouped_files_to_compress.cbegin(); it != grouped_files_to_compress.cend();) {
+        auto const group_id = it->get_group_id();
+        auto const group_end = std::find_if(
+                it,
+                grouped_files_to_compress.cend(),
+                [&](FileToCompress const& file) { return file.get_group_id() != group_id; }
+        );
+        shared_state.tasks.push_back({it, group_end});
+        it = group_end;
+    }
+    if (command_line_args.show_progress()) {
+        shared_state.num_files_to_compress
+                = files_to_compress.size() + grouped_files_to_compress.size();
+    }
+
+    auto const num_threads = std::min(
+            command_line_args.get_num_threads(),
+            std::max<size_t>(shared_state.tasks.size(), 1)
+    );
+    if (1 == num_threads) {
+        return compress_tasks(
+                command_line_args,
+                archive_user_config,
+                &empty_directory_paths,
+                target_encoded_file_size,
+                std::move(reader_parser),
+                use_heuristic,
+                shared_state
+        );
+    }
+
+    // Each thread writes its own archives, so the global metadata DB is the only shared resource
+    // that needs to be synchronized.
+    archive_user_config.global_metadata_db_mutex = &shared_state.global_metadata_db_mutex;
+    vector<unique_ptr<CompressionThread>> compression_threads;
+    compression_threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        // log-surgeon's parser isn't thread-safe, so each thread needs its own instance.
+        std::unique_ptr<log_surgeon::ReaderParser> thread_reader_parser;
+        if (0 == i) {
+            thread_reader_parser = std::move(reader_parser);
+        } else if (false == use_heuristic) {
+            thread_reader_parser = make_unique<log_surgeon::ReaderParser>(
+                    command_line_args.get_schema_file_path()
+            );
         }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    file_to_compress,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
+        auto& compression_thread = compression_threads.emplace_back(make_unique<CompressionThread>(
+                command_line_args,
+                archive_user_config,
+                0 == i ? &empty_directory_paths : nullptr,
+                target_encoded_file_size,
+                std::move(thread_reader_parser),
+                use_heuristic,
+                shared_state
+        ));
+        compression_thread->start();
+    }
+
+    bool all_files_compressed_successfully = true;
+    for (auto& compression_thread : compression_threads) {
+        compression_thread->join();
+        if (false == compression_thread->succeeded()) {
             all_files_compressed_successfully = false;
         }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
     }
-
-    archive_writer.close();
-
     return all_files_compressed_successfully;
 }
 
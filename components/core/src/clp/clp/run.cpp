@@ -25,7 +25,7 @@ namespace clp::clp {
 int run(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
@@ -1,5 +1,11 @@
 #include "database_utils.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <fmt/base.h>
 #include <fmt/format.h>
 
@@ -70,6 +76,37 @@ string get_placeholders_sql(size_t num_placeholders) {
     return {buffer.data(), buffer.size()};
 }
 
+string get_multi_row_placeholders_sql(size_t num_placeholders_per_row, size_t num_rows) {
+    auto const row_placeholders = get_placeholders_sql(num_placeholders_per_row);
+
+    fmt::memory_buffer buffer;
+    auto buffer_ix = std::back_inserter(buffer);
+
+    size_t i = 0;
+    fmt::format_to(buffer_ix, "({})", row_placeholders);
+    ++i;
+    for (; i < num_rows; ++i) {
+        fmt::format_to(buffer_ix, ",({})", row_placeholders);
+    }
+
+    return {buffer.data(), buffer.size()};
+}
+
+size_t
+get_multi_row_placeholder_ix(size_t field_ix, size_t row_ix, size_t num_placeholders_per_row) {
+    return row_ix * num_placeholders_per_row + field_ix;
+}
+
+vector<size_t> get_multi_row_batch_sizes(size_t num_rows, size_t max_rows_per_batch) {
+    vector<size_t> batch_sizes;
+    for (size_t batch_begin_ix = 0; batch_begin_ix < num_rows;
+         batch_begin_ix += max_rows_per_batch)
+    {
+        batch_sizes.push_back(std::min(num_rows - batch_begin_ix, max_rows_per_batch));
+    }
+    return batch_sizes;
+}
+
 string get_numbered_placeholders_sql(size_t num_placeholders) {
     fmt::memory_buffer buffer;
     auto buffer_ix = std::back_inserter(buffer);
@@ -98,6 +135,24 @@ string get_set_field_sql(vector<string> const& field_names, size_t begin_ix, siz
     return {buffer.data(), buffer.size()};
 }
 
+string get_set_field_to_inserted_values_sql(
+        vector<string> const& field_names,
+        size_t begin_ix,
+        size_t end_ix
+) {
+    fmt::memory_buffer buffer;
+    auto buffer_ix = std::back_inserter(buffer);
+
+    size_t i = begin_ix;
+    fmt::format_to(buffer_ix, "{0} = VALUES({0})", field_names[i]);
+    ++i;
+    for (; i < end_ix; ++i) {
+        fmt::format_to(buffer_ix, ",{0} = VALUES({0})", field_names[i]);
+    }
+
+    return {buffer.data(), buffer.size()};
+}
+
 string get_numbered_set_field_sql(
         vector<pair<string, string>> const& field_names_and_types,
         size_t begin_ix
@@ -1,6 +1,7 @@
 #ifndef CLP_DATABASE_UTILS_HPP
 #define CLP_DATABASE_UTILS_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,32 @@ std::string get_field_names_sql(std::vector<std::string> const& field_names);
  * @return The SQL
  */
 std::string get_placeholders_sql(size_t num_placeholders);
+/**
+ * Gets the SQL for the given number of rows of placeholders in the form "(?,?,...),(?,?,...),..."
+ * so that a multi-row INSERT can be executed as a single statement
+ * @param num_placeholders_per_row
+ * @param num_rows
+ * @return The SQL
+ */
+std::string get_multi_row_placeholders_sql(size_t num_placeholders_per_row, size_t num_rows);
+/**
+ * Gets the index of a field's placeholder within the placeholders generated by
+ * `get_multi_row_placeholders_sql`
+ * @param field_ix Index of the field within its row
+ * @param row_ix Index of the row within the statement
+ * @param num_placeholders_per_row
+ * @return The index of the placeholder
+ */
+size_t
+get_multi_row_placeholder_ix(size_t field_ix, size_t row_ix, size_t num_placeholders_per_row);
+/**
+ * Splits the given number of rows into batches that can each be inserted by a single multi-row
+ * statement. Every batch except the last contains `max_rows_per_batch` rows.
+ * @param num_rows
+ * @param max_rows_per_batch
+ * @return The number of rows in each batch
+ */
+std::vector<size_t> get_multi_row_batch_sizes(size_t num_rows, size_t max_rows_per_batch);
 /**
  * Gets the SQL for the given number of numbered placeholders
  * @param num_placeholders
@@ -51,6 +78,20 @@ std::string get_numbered_placeholders_sql(size_t num_placeholders);
  */
 std::string
 get_set_field_sql(std::vector<std::string> const& field_names, size_t begin_ix, size_t end_ix);
+/**
+ * Gets the SQL to set a list of fields to the values of the row being inserted in the form
+ * "field_name1 = VALUES(field_name1),field_name2 = VALUES(field_name2),...", for use in the
+ * ON DUPLICATE KEY UPDATE clause of a multi-row INSERT
+ * @param field_names
+ * @param begin_ix Which field to start from
+ * @param end_ix Which field to end before
+ * @return The SQL
+ */
+std::string get_set_field_to_inserted_values_sql(
+        std::vector<std::string> const& field_names,
+        size_t begin_ix,
+        size_t end_ix
+);
 /**
  * Gets the SQL to set a list of fields to numbered placeholders in the form
  * "field_name1 = ?1,field_name2 = ?2,..."
@@ -1,5 +1,9 @@
 #include "KeyValuePairLogEvent.hpp"
 
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <stack>
@@ -18,6 +22,7 @@
 #include "../time_types.hpp"
 #include "EncodedTextAst.hpp"
 #include "SchemaTree.hpp"
+#include "utils.hpp"
 #include "Value.hpp"
 
 using std::string;
@@ -204,6 +209,36 @@ private:
         vector<bool> const& schema_subtree_bitmap
 ) -> ystdlib::error_handling::Result<nlohmann::json>;
 
+/**
+ * Appends the given value to `output` as a JSON value.
+ * @param node The schema tree node of the value.
+ * @param optional_val
+ * @param output
+ * @return Whether the value was appended successfully.
+ */
+[[nodiscard]] auto append_json_value(
+        SchemaTree::Node const& node,
+        std::optional<Value> const& optional_val,
+        string& output
+) -> bool;
+
+/**
+ * Serializes the given node-ID-value pairs into a JSON object string, appending it to `output`.
+ * @param schema_tree
+ * @param node_id_value_pairs
+ * @param schema_subtree_bitmap
+ * @param output
+ * @return A void result on success, or an error code indicating the failure:
+ * - std::errc::protocol_error if a key or value in the log event couldn't be decoded or isn't
+ *   valid UTF-8.
+ */
+[[nodiscard]] auto serialize_node_id_value_pairs_to_json_str(
+        SchemaTree const& schema_tree,
+        KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+        vector<bool> const& schema_subtree_bitmap,
+        string& output
+) -> ystdlib::error_handling::Result<void>;
+
 /**
  * @param node A non-root schema tree node.
  * @param parent_node_id_to_key_names
@@ -479,12 +514,14 @@ auto serialize_node_id_value_pairs_to_json(
         }
         auto const child_schema_tree_node_id{top.get_next_child_schema_tree_node()};
         auto const& child_schema_tree_node{schema_tree.get_node(child_schema_tree_node_id)};
-        if (node_id_value_pairs.contains(child_schema_tree_node_id)) {
+        if (auto const it{node_id_value_pairs.find(child_schema_tree_node_id)};
+            node_id_value_pairs.end() != it)
+        {
             // Handle leaf node
             if (false
                 == insert_kv_pair_into_json_obj(
                         child_schema_tree_node,
-                        node_id_value_pairs.at(child_schema_tree_node_id),
+                        it->second,
                         top.get_json_obj()
                 ))
             {
@@ -507,6 +544,167 @@ auto serialize_node_id_value_pairs_to_json(
     return root_json_obj;
 }
 
+auto append_json_value(
+        SchemaTree::Node const& node,
+        std::optional<Value> const& optional_val,
+        string& output
+) -> bool {
+    if (false == optional_val.has_value()) {
+        output += "{}";
+        return true;
+    }
+
+    try {
+        auto const& val{optional_val.value()};
+        switch (node.get_type()) {
+            case SchemaTree::Node::Type::Int: {
+                // Large enough for any 64-bit integer
+                constexpr size_t cBufSize{24};
+                std::array<char, cBufSize> buf{};
+                auto const [end, ec]{std::to_chars(
+                        buf.data(),
+                        buf.data() + buf.size(),
+                        val.get_immutable_view<value_int_t>()
+                )};
+                if (std::errc{} != ec) {
+                    return false;
+                }
+                output.append(buf.data(), end);
+                break;
+            }
+            case SchemaTree::Node::Type::Float: {
+                auto const float_val{val.get_immutable_view<value_float_t>()};
+                if (false == std::isfinite(float_val)) {
+                    // Consistent with `nlohmann::json`, which serializes non-finite numbers as null
+                    output += "null";
+                    break;
+                }
+                // Large enough for the shortest round-trip representation of any double
+                constexpr size_t cBufSize{32};
+                std::array<char, cBufSize> buf{};
+                auto const [end, ec]{
+                        std::to_chars(buf.data(), buf.data() + buf.size(), float_val)
+                };
+                if (std::errc{} != ec) {
+                    return false;
+                }
+                std::string_view const float_str{buf.data(), static_cast<size_t>(end - buf.data())};
+                output += float_str;
+                if (std::string_view::npos == float_str.find_first_of(".e")) {
+                    // Keep the value recognizable as a float, consistent with `nlohmann::json`
+                    output += ".0";
+                }
+                break;
+            }
+            case SchemaTree::Node::Type::Bool:
+                output += val.get_immutable_view<value_bool_t>() ? "true" : "false";
+                break;
+            case SchemaTree::Node::Type::Str: {
+                output += '"';
+                if (val.is<string>()) {
+                    if (false
+                        == validate_and_append_escaped_utf8_string(
+                                val.get_immutable_view<string>(),
+                                output
+                        ))
+                    {
+                        return false;
+                    }
+                } else {
+                    auto const decoded_result{decode_as_encoded_text_ast(val)};
+                    if (false == decoded_result.has_value()
+                        || false
+                                   == validate_and_append_escaped_utf8_string(
+                                           decoded_result.value(),
+                                           output
+                                   ))
+                    {
+                        return false;
+                    }
+                }
+                output += '"';
+                break;
+            }
+            case SchemaTree::Node::Type::UnstructuredArray: {
+                // The decoded text of an unstructured array is already a JSON array.
+                auto const decoded_result{decode_as_encoded_text_ast(val)};
+                if (false == decoded_result.has_value()) {
+                    return false;
+                }
+                output += decoded_result.value();
+                break;
+            }
+            case SchemaTree::Node::Type::Obj:
+                output += "null";
+                break;
+            default:
+                return false;
+        }
+    } catch (Value::OperationFailed const& ex) {
+        return false;
+    }
+    return true;
+}
+
+auto serialize_node_id_value_pairs_to_json_str(
+        SchemaTree const& schema_tree,
+        KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+        vector<bool> const& schema_subtree_bitmap,
+        string& output
+) -> ystdlib::error_handling::Result<void> {
+    struct DfsFrame {
+        SchemaTree::Node const* node;
+        size_t next_child_idx;
+        bool is_first_member;
+    };
+
+    // Traverse the schema tree in DFS order, but only traverse the nodes that are set in
+    // `schema_subtree_bitmap`. Each non-leaf node opens a JSON object on the way down and closes it
+    // on the way up; each leaf node is written as a member of its parent's object.
+    vector<DfsFrame> dfs_stack;
+    output += '{';
+    dfs_stack.push_back({&schema_tree.get_root(), 0, true});
+    while (false == dfs_stack.empty()) {
+        auto& top{dfs_stack.back()};
+        auto const& children_ids{top.node->get_children_ids()};
+        while (top.next_child_idx < children_ids.size()
+               && false == schema_subtree_bitmap[children_ids[top.next_child_idx]])
+        {
+            ++top.next_child_idx;
+        }
+        if (top.next_child_idx == children_ids.size()) {
+            output += '}';
+            dfs_stack.pop_back();
+            continue;
+        }
+
+        auto const child_id{children_ids[top.next_child_idx]};
+        ++top.next_child_idx;
+        if (false == top.is_first_member) {
+            output += ',';
+        }
+        top.is_first_member = false;
+
+        auto const& child_node{schema_tree.get_node(child_id)};
+        output += '"';
+        if (false == validate_and_append_escaped_utf8_string(child_node.get_key_name(), output)) {
+            return std::errc::protocol_error;
+        }
+        output += "\":";
+
+        if (auto const it{node_id_value_pairs.find(child_id)}; node_id_value_pairs.end() != it) {
+            if (false == append_json_value(child_node, it->second, output)) {
+                return std::errc::protocol_error;
+            }
+        } else {
+            // NOTE: `top` is invalidated after this point.
+            output += '{';
+            dfs_stack.push_back({&child_node, 0, true});
+        }
+    }
+    return ystdlib::error_handling::success();
+}
+
 auto check_key_uniqueness_among_sibling_nodes(
         SchemaTree::Node const& node,
         std::unordered_map<SchemaTree::Node::id_t, std::unordered_set<std::string_view>>&
@@ -613,4 +811,30 @@ auto KeyValuePairLogEvent::serialize_to_json() const
     return {std::move(serialized_auto_gen_kv_pairs_result.value()),
             std::move(serialized_user_gen_kv_pairs_result.value())};
 }
+
+auto KeyValuePairLogEvent::serialize_auto_gen_kv_pairs_to_json_str(string& output) const
+        -> ystdlib::error_handling::Result<void> {
+    auto const schema_subtree_bitmap{
+            YSTDLIB_ERROR_HANDLING_TRYX(get_auto_gen_keys_schema_subtree_bitmap())
+    };
+    return serialize_node_id_value_pairs_to_json_str(
+            *m_auto_gen_keys_schema_tree,
+            m_auto_gen_node_id_value_pairs,
+            schema_subtree_bitmap,
+            output
+    );
+}
+
+auto KeyValuePairLogEvent::serialize_user_gen_kv_pairs_to_json_str(string& output) const
+        -> ystdlib::error_handling::Result<void> {
+    auto const schema_subtree_bitmap{
+            YSTDLIB_ERROR_HANDLING_TRYX(get_user_gen_keys_schema_subtree_bitmap())
+    };
+    return serialize_node_id_value_pairs_to_json_str(
+            *m_user_gen_keys_schema_tree,
+            m_user_gen_node_id_value_pairs,
+            schema_subtree_bitmap,
+            output
+    );
+}
 }  // namespace clp::ffi
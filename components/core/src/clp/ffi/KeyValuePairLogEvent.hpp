@@ -2,8 +2,7 @@
 #define CLP_FFI_KEYVALUEPAIRLOGEVENT_HPP
 
 #include <memory>
-#include <optional>
-#include <unordered_map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -11,8 +10,8 @@
 #include <ystdlib/error_handling/Result.hpp>
 
 #include "../time_types.hpp"
+#include "NodeIdValuePairs.hpp"
 #include "SchemaTree.hpp"
-#include "Value.hpp"
 
 namespace clp::ffi {
 /**
@@ -28,7 +27,7 @@ namespace clp::ffi {
 class KeyValuePairLogEvent {
 public:
     // Types
-    using NodeIdValuePairs = std::unordered_map<SchemaTree::Node::id_t, std::optional<Value>>;
+    using NodeIdValuePairs = ::clp::ffi::NodeIdValuePairs;
 
     // Factory functions
     /**
@@ -113,6 +112,31 @@ public:
     [[nodiscard]] auto serialize_to_json() const
             -> ystdlib::error_handling::Result<std::pair<nlohmann::json, nlohmann::json>>;
 
+    /**
+     * Serializes the auto-generated key-value pairs into a JSON object string, appending it to the
+     * given buffer. Unlike `serialize_to_json`, this doesn't construct any intermediate
+     * `nlohmann::json` objects, and keys are emitted in schema-tree order rather than sorted.
+     * @param output Returns the buffer with the JSON object string appended. On failure, the
+     * buffer's contents are unspecified.
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `get_auto_gen_keys_schema_subtree_bitmap`'s return values on failure.
+     * - Forwards `serialize_node_id_value_pairs_to_json_str`'s return values on failure.
+     */
+    [[nodiscard]] auto serialize_auto_gen_kv_pairs_to_json_str(std::string& output) const
+            -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Serializes the user-generated key-value pairs into a JSON object string, appending it to the
+     * given buffer. See `serialize_auto_gen_kv_pairs_to_json_str` for details.
+     * @param output Returns the buffer with the JSON object string appended. On failure, the
+     * buffer's contents are unspecified.
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `get_user_gen_keys_schema_subtree_bitmap`'s return values on failure.
+     * - Forwards `serialize_node_id_value_pairs_to_json_str`'s return values on failure.
+     */
+    [[nodiscard]] auto serialize_user_gen_kv_pairs_to_json_str(std::string& output) const
+            -> ystdlib::error_handling::Result<void>;
+
 private:
     // Constructor
     KeyValuePairLogEvent(
@@ -0,0 +1,185 @@
+#ifndef CLP_FFI_NODEIDVALUEPAIRS_HPP
+#define CLP_FFI_NODEIDVALUEPAIRS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "SchemaTree.hpp"
+#include "Value.hpp"
+
+namespace clp::ffi {
+/**
+ * A collection of schema-tree-node-ID & value pairs, where each node ID appears at most once.
+ *
+ * The pairs are stored contiguously in insertion order, and looked up through a flat
+ * open-addressing table of indices into the pairs. Compared to a node-based hash map, this avoids
+ * allocating a hash node per pair, which matters since a collection is created for every
+ * deserialized log event. The table's size is proportional to the number of pairs rather than to
+ * the largest node ID, so a log event with a few keys stays cheap even when the schema tree has
+ * grown large.
+ *
+ * Iteration visits the pairs in insertion order.
+ */
+class NodeIdValuePairs {
+public:
+    // Types
+    using value_type = std::pair<SchemaTree::Node::id_t, std::optional<Value>>;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    // Constructors
+    NodeIdValuePairs() = default;
+
+    NodeIdValuePairs(std::initializer_list<value_type> pairs) {
+        reserve(pairs.size());
+        for (auto const& [node_id, optional_value] : pairs) {
+            emplace(node_id, optional_value);
+        }
+    }
+
+    // Methods
+    /**
+     * Inserts a pair if the given node ID isn't already in the collection.
+     * @tparam ValueArgs
+     * @param node_id
+     * @param value_args Arguments to construct the `std::optional<Value>` with.
+     * @return Whether the pair was inserted.
+     */
+    template <typename... ValueArgs>
+    auto emplace(SchemaTree::Node::id_t node_id, ValueArgs&&... value_args) -> bool {
+        if (m_slots.size() < get_num_slots_required(m_pairs.size() + 1)) {
+            rehash(get_num_slots_required(m_pairs.size() + 1));
+        }
+        auto const slot{find_slot(node_id)};
+        if (0 != m_slots[slot]) {
+            return false;
+        }
+        m_pairs.emplace_back(
+                std::piecewise_construct,
+                std::forward_as_tuple(node_id),
+                std::forward_as_tuple(std::forward<ValueArgs>(value_args)...)
+        );
+        m_slots[slot] = static_cast<index_t>(m_pairs.size());
+        return true;
+    }
+
+    [[nodiscard]] auto contains(SchemaTree::Node::id_t node_id) const -> bool {
+        return false == m_slots.empty() && 0 != m_slots[find_slot(node_id)];
+    }
+
+    /**
+     * @param node_id
+     * @return An iterator to the pair with the given node ID, or `end()` if there's no such pair.
+     */
+    [[nodiscard]] auto find(SchemaTree::Node::id_t node_id) const -> const_iterator {
+        if (m_slots.empty()) {
+            return m_pairs.cend();
+        }
+        auto const pair_idx{m_slots[find_slot(node_id)]};
+        if (0 == pair_idx) {
+            return m_pairs.cend();
+        }
+        return m_pairs.cbegin() + static_cast<std::ptrdiff_t>(pair_idx - 1);
+    }
+
+    /**
+     * @param node_id
+     * @return The value paired with the given node ID.
+     * @throw std::out_of_range if there's no pair with the given node ID.
+     */
+    [[nodiscard]] auto at(SchemaTree::Node::id_t node_id) const -> std::optional<Value> const& {
+        auto const it{find(node_id)};
+        if (m_pairs.cend() == it) {
+            throw std::out_of_range("NodeIdValuePairs::at: node ID not found.");
+        }
+        return it->second;
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return m_pairs.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_pairs.empty(); }
+
+    /**
+     * Reserves space for the given number of pairs.
+     * @param num_pairs
+     */
+    auto reserve(size_t num_pairs) -> void {
+        m_pairs.reserve(num_pairs);
+        if (m_slots.size() < get_num_slots_required(num_pairs)) {
+            rehash(get_num_slots_required(num_pairs));
+        }
+    }
+
+    /**
+     * Removes all pairs while retaining the allocated capacity, so the collection can be reused.
+     */
+    auto clear() -> void {
+        std::fill(m_slots.begin(), m_slots.end(), 0);
+        m_pairs.clear();
+    }
+
+    [[nodiscard]] auto begin() const -> const_iterator { return m_pairs.cbegin(); }
+
+    [[nodiscard]] auto end() const -> const_iterator { return m_pairs.cend(); }
+
+private:
+    // Types
+    using index_t = uint32_t;
+
+    // Constants
+    static constexpr size_t cMinNumSlots{16};
+
+    // Methods
+    /**
+     * @param num_pairs
+     * @return The number of slots (a power of two) needed to hold the given number of pairs while
+     * keeping the table at most half full.
+     */
+    [[nodiscard]] static auto get_num_slots_required(size_t num_pairs) -> size_t {
+        return std::max(cMinNumSlots, std::bit_ceil(2 * num_pairs));
+    }
+
+    /**
+     * @param node_id
+     * @return The slot containing the given node ID's pair if it exists, or the empty slot where it
+     * would be inserted otherwise.
+     */
+    [[nodiscard]] auto find_slot(SchemaTree::Node::id_t node_id) const -> size_t {
+        // Fibonacci hashing spreads out node IDs with a common stride; the table is never full, so
+        // linear probing always terminates.
+        constexpr uint64_t cHashMultiplier{0x9E37'79B9'7F4A'7C15ULL};
+        auto const mask{m_slots.size() - 1};
+        auto slot{static_cast<size_t>((static_cast<uint64_t>(node_id) * cHashMultiplier) >> 32U)
+                  & mask};
+        while (0 != m_slots[slot] && node_id != m_pairs[m_slots[slot] - 1].first) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    /**
+     * Resizes the table to the given number of slots and reinserts every pair.
+     * @param num_slots
+     */
+    auto rehash(size_t num_slots) -> void {
+        m_slots.assign(num_slots, 0);
+        for (size_t i{0}; i < m_pairs.size(); ++i) {
+            m_slots[find_slot(m_pairs[i].first)] = static_cast<index_t>(i + 1);
+        }
+    }
+
+    // Variables
+    std::vector<value_type> m_pairs;
+    // Open-addressing table where each slot holds 1 + the index of a pair in `m_pairs`, or 0 if the
+    // slot is empty.
+    std::vector<index_t> m_slots;
+};
+}  // namespace clp::ffi
+
+#endif  // CLP_FFI_NODEIDVALUEPAIRS_HPP
@@ -1,8 +1,10 @@
 #include "SchemaTree.hpp"
 
 #include <cstddef>
+#include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "../ErrorCode.hpp"
 
@@ -20,30 +22,32 @@ auto SchemaTree::get_node(Node::id_t id) const -> Node const& {
 }
 
 auto SchemaTree::try_get_node_id(NodeLocator const& locator) const -> std::optional<Node::id_t> {
-    auto const parent_id{static_cast<size_t>(locator.get_parent_id())};
-    if (m_tree_nodes.size() <= parent_id) {
+    auto const parent_id{locator.get_parent_id()};
+    if (m_tree_nodes.size() <= static_cast<size_t>(parent_id)) {
         return std::nullopt;
     }
-    std::optional<Node::id_t> node_id;
-    for (auto const child_id : m_tree_nodes[parent_id].get_children_ids()) {
-        auto const& node{m_tree_nodes[child_id]};
-        if (node.get_key_name() == locator.get_key_name() && node.get_type() == locator.get_type())
+    auto const key_name{locator.get_key_name()};
+    auto const type{locator.get_type()};
+    auto const [begin_it, end_it]{
+            m_node_id_index.equal_range(hash_locator(parent_id, key_name, type))
+    };
+    for (auto it{begin_it}; it != end_it; ++it) {
+        auto const& node{m_tree_nodes[it->second]};
+        if (node.get_parent_id_unsafe() == parent_id && node.get_type() == type
+            && node.get_key_name() == key_name)
         {
-            node_id.emplace(child_id);
-            break;
+            return it->second;
         }
     }
-    return node_id;
+    return std::nullopt;
 }
 
 auto SchemaTree::insert_node(NodeLocator const& locator) -> Node::id_t {
     if (try_get_node_id(locator).has_value()) {
         throw OperationFailed(ErrorCode_Failure, __FILE__, __LINE__, "Node already exists.");
     }
-    auto const node_id{static_cast<Node::id_t>(m_tree_nodes.size())};
-    m_tree_nodes.emplace_back(Node::create(node_id, locator));
-    auto& parent_node{m_tree_nodes[locator.get_parent_id()]};
-    if (Node::Type::Obj != parent_node.get_type()) {
+    auto const parent_id{locator.get_parent_id()};
+    if (Node::Type::Obj != m_tree_nodes[parent_id].get_type()) {
         throw OperationFailed(
                 ErrorCode_Failure,
                 __FILE__,
@@ -51,7 +55,13 @@ auto SchemaTree::insert_node(NodeLocator const& locator) -> Node::id_t {
                 "Non-object nodes cannot have children."
         );
     }
-    parent_node.append_new_child(node_id);
+    auto const node_id{static_cast<Node::id_t>(m_tree_nodes.size())};
+    m_tree_nodes.emplace_back(Node::create(node_id, locator));
+    m_tree_nodes[parent_id].append_new_child(node_id);
+    m_node_id_index.emplace(
+            hash_locator(parent_id, locator.get_key_name(), locator.get_type()),
+            node_id
+    );
     return node_id;
 }
 
@@ -63,10 +73,35 @@ auto SchemaTree::revert() -> void {
         auto const& node{m_tree_nodes.back()};
         auto const optional_parent_id{node.get_parent_id()};
         if (optional_parent_id.has_value()) {
-            m_tree_nodes[optional_parent_id.value()].remove_last_appended_child();
+            auto const parent_id{optional_parent_id.value()};
+            m_tree_nodes[parent_id].remove_last_appended_child();
+
+            auto const node_id{static_cast<Node::id_t>(m_tree_nodes.size() - 1)};
+            auto const [begin_it, end_it]{m_node_id_index.equal_range(
+                    hash_locator(parent_id, node.get_key_name(), node.get_type())
+            )};
+            for (auto it{begin_it}; it != end_it; ++it) {
+                if (node_id == it->second) {
+                    m_node_id_index.erase(it);
+                    break;
+                }
+            }
         }
         m_tree_nodes.pop_back();
     }
     m_snapshot_size.reset();
 }
+
+auto SchemaTree::hash_locator(Node::id_t parent_id, std::string_view key_name, Node::Type type)
+        -> size_t {
+    // Combine the hashes the same way as `boost::hash_combine`.
+    auto hash{std::hash<std::string_view>{}(key_name)};
+    auto const combine = [&](size_t value) -> void {
+        constexpr size_t cGoldenRatio{0x9e37'79b9};
+        hash ^= value + cGoldenRatio + (hash << 6U) + (hash >> 2U);
+    };
+    combine(static_cast<size_t>(parent_id));
+    combine(static_cast<size_t>(type));
+    return hash;
+}
 }  // namespace clp::ffi
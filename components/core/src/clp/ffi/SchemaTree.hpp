@@ -6,6 +6,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -275,6 +276,9 @@ public:
 
     /**
      * Tries to get the ID of a node corresponding to the given locator, if the node exists.
+     *
+     * The lookup goes through a hashed index rather than scanning the parent's children, so its
+     * cost doesn't grow with the number of siblings (e.g., for wide objects).
      * @param locator
      * @return The node's ID if it exists.
      * @return std::nullopt otherwise.
@@ -312,9 +316,25 @@ public:
     auto revert() -> void;
 
 private:
+    // Methods
+    /**
+     * @param parent_id
+     * @param key_name
+     * @param type
+     * @return The hash of a node's locator, used as the key of `m_node_id_index`.
+     */
+    [[nodiscard]] static auto
+    hash_locator(Node::id_t parent_id, std::string_view key_name, Node::Type type) -> size_t;
+
     // Variables
     std::optional<size_t> m_snapshot_size;
     std::vector<Node> m_tree_nodes;
+
+    // Maps the hash of each non-root node's locator to the node's ID. The index stores hashes
+    // rather than locators so that it doesn't hold views into `m_tree_nodes`, which would be
+    // invalidated whenever the vector reallocates; colliding entries are disambiguated by comparing
+    // against the nodes themselves.
+    std::unordered_multimap<size_t, Node::id_t> m_node_id_index;
 };
 }  // namespace clp::ffi
 #endif
@@ -0,0 +1,96 @@
+#ifndef CLP_FFI_IR_STREAM_SCHEMATREENODELOCATORCACHE_HPP
+#define CLP_FFI_IR_STREAM_SCHEMATREENODELOCATORCACHE_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../SchemaTree.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * A cache of the schema-tree node lookups made while serializing a log event, recorded in the order
+ * they were made.
+ *
+ * Consecutive log events in a stream usually share the same key sequence, so when serializing the
+ * next log event, the i-th lookup can first be compared against the i-th cached lookup. On a hit,
+ * this replaces hashing the key name and probing the schema tree with a single string comparison.
+ * On a miss, the caller falls back to the schema tree and records the result in the cache.
+ *
+ * NOTE: Cached node IDs are only valid as long as the corresponding nodes exist in the schema tree,
+ * so callers must clear the cache whenever the schema tree is reverted.
+ */
+class SchemaTreeNodeLocatorCache {
+public:
+    // Methods
+    /**
+     * Resets the cursor to the first cached lookup, to start serializing a new log event.
+     */
+    auto rewind() -> void { m_cursor = 0; }
+
+    /**
+     * Compares the given locator against the cached lookup at the current cursor, and advances
+     * the cursor.
+     * @param locator
+     * @return The cached node ID if the locator matches the cached lookup.
+     * @return std::nullopt otherwise.
+     */
+    [[nodiscard]] auto try_get_next(SchemaTree::NodeLocator const& locator)
+            -> std::optional<SchemaTree::Node::id_t> {
+        auto const idx{m_cursor++};
+        if (idx >= m_entries.size()) {
+            return std::nullopt;
+        }
+        auto const& entry{m_entries[idx]};
+        if (entry.parent_id != locator.get_parent_id() || entry.type != locator.get_type()
+            || entry.key_name != locator.get_key_name())
+        {
+            return std::nullopt;
+        }
+        return entry.node_id;
+    }
+
+    /**
+     * Records the lookup result for the locator last passed to `try_get_next`.
+     * @param locator
+     * @param node_id
+     */
+    auto update_last(SchemaTree::NodeLocator const& locator, SchemaTree::Node::id_t node_id)
+            -> void {
+        auto const idx{m_cursor - 1};
+        if (idx >= m_entries.size()) {
+            m_entries.resize(idx + 1);
+        }
+        auto& entry{m_entries[idx]};
+        entry.parent_id = locator.get_parent_id();
+        // Assigning (rather than constructing) the key name reuses the string's existing capacity.
+        entry.key_name.assign(locator.get_key_name());
+        entry.type = locator.get_type();
+        entry.node_id = node_id;
+    }
+
+    /**
+     * Removes all cached lookups.
+     */
+    auto clear() -> void {
+        m_entries.clear();
+        m_cursor = 0;
+    }
+
+private:
+    // Types
+    struct Entry {
+        SchemaTree::Node::id_t parent_id{};
+        std::string key_name;
+        SchemaTree::Node::Type type{};
+        SchemaTree::Node::id_t node_id{};
+    };
+
+    // Variables
+    std::vector<Entry> m_entries;
+    size_t m_cursor{0};
+};
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_SCHEMATREENODELOCATORCACHE_HPP
@@ -1,6 +1,7 @@
 #include "Serializer.hpp"
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <span>
@@ -22,6 +23,7 @@
 #include "../SchemaTree.hpp"
 #include "encoding_methods.hpp"
 #include "protocol_constants.hpp"
+#include "SchemaTreeNodeLocatorCache.hpp"
 #include "utils.hpp"
 
 using std::optional;
@@ -237,6 +239,8 @@ template <typename encoded_variable_t>
  * @tparam EmptyMapSerializationMethod
  * @param msgpack_map
  * @param schema_tree
+ * @param locator_cache Cache of the lookups made while serializing the previous msgpack map. It's
+ * consulted before `schema_tree` and updated on a miss.
  * @param schema_tree_node_serialization_method
  * @param node_id_value_pair_serialization_method
  * @param empty_map_serialization_method
@@ -255,6 +259,7 @@ template <
 [[nodiscard]] auto serialize_msgpack_map_using_dfs(
         msgpack::object_map const& msgpack_map,
         SchemaTree& schema_tree,
+        SchemaTreeNodeLocatorCache& locator_cache,
         SchemaTreeNodeSerializationMethod schema_tree_node_serialization_method,
         NodeIdValuePairSerializationMethod node_id_value_pair_serialization_method,
         EmptyMapSerializationMethod empty_map_serialization_method
@@ -447,10 +452,12 @@ template <
 [[nodiscard]] auto serialize_msgpack_map_using_dfs(
         msgpack::object_map const& msgpack_map,
         SchemaTree& schema_tree,
+        SchemaTreeNodeLocatorCache& locator_cache,
         SchemaTreeNodeSerializationMethod schema_tree_node_serialization_method,
         NodeIdValuePairSerializationMethod node_id_value_pair_serialization_method,
         EmptyMapSerializationMethod empty_map_serialization_method
 ) -> ystdlib::error_handling::Result<void> {
+    locator_cache.rewind();
     vector<MsgpackMapIterator> dfs_stack;
     dfs_stack.emplace_back(
             SchemaTree::cRootId,
@@ -482,10 +489,14 @@ template <
 
         // Get the schema-tree node that corresponds with the current kv-pair, or add it if it
         // doesn't exist.
-        auto opt_schema_tree_node_id{schema_tree.try_get_node_id(locator)};
+        auto opt_schema_tree_node_id{locator_cache.try_get_next(locator)};
         if (false == opt_schema_tree_node_id.has_value()) {
-            opt_schema_tree_node_id.emplace(schema_tree.insert_node(locator));
-            YSTDLIB_ERROR_HANDLING_TRYV(schema_tree_node_serialization_method(locator));
+            opt_schema_tree_node_id = schema_tree.try_get_node_id(locator);
+            if (false == opt_schema_tree_node_id.has_value()) {
+                opt_schema_tree_node_id.emplace(schema_tree.insert_node(locator));
+                YSTDLIB_ERROR_HANDLING_TRYV(schema_tree_node_serialization_method(locator));
+            }
+            locator_cache.update_last(locator, opt_schema_tree_node_id.value());
         }
         auto const schema_tree_node_id{opt_schema_tree_node_id.value()};
 
@@ -583,6 +594,9 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
             [&]() noexcept -> void {
                 m_user_gen_keys_schema_tree.revert();
                 m_auto_gen_keys_schema_tree.revert();
+                // The caches may reference nodes that no longer exist after reverting.
+                m_user_gen_locator_cache.clear();
+                m_auto_gen_locator_cache.clear();
             }
     };
 
@@ -595,7 +609,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
             = [this](
                       SchemaTree::NodeLocator const& locator
               ) -> ystdlib::error_handling::Result<void> {
-        return this->serialize_schema_tree_node<true>(locator);
+        return serialize_schema_tree_node<true>(locator, m_schema_tree_node_buf);
     };
 
     auto auto_gen_node_id_value_pairs_serialization_method
@@ -639,6 +653,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
         YSTDLIB_ERROR_HANDLING_TRYV(serialize_msgpack_map_using_dfs(
                 auto_gen_kv_pairs_map,
                 m_auto_gen_keys_schema_tree,
+                m_auto_gen_locator_cache,
                 auto_gen_schema_tree_node_serialization_method,
                 auto_gen_node_id_value_pairs_serialization_method,
                 auto_gen_empty_map_serialization_method
@@ -650,7 +665,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
             = [this](
                       SchemaTree::NodeLocator const& locator
               ) -> ystdlib::error_handling::Result<void> {
-        return this->serialize_schema_tree_node<false>(locator);
+        return serialize_schema_tree_node<false>(locator, m_schema_tree_node_buf);
     };
 
     auto user_gen_node_id_value_pairs_serialization_method
@@ -696,6 +711,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
         YSTDLIB_ERROR_HANDLING_TRYV(serialize_msgpack_map_using_dfs(
                 user_gen_kv_pairs_map,
                 m_user_gen_keys_schema_tree,
+                m_user_gen_locator_cache,
                 user_gen_schema_tree_node_serialization_method,
                 user_gen_node_id_value_pairs_serialization_method,
                 user_gen_empty_map_serialization_method
@@ -723,29 +739,57 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
     return success();
 }
 
+template <typename encoded_variable_t>
+auto Serializer<encoded_variable_t>::serialize_sync_point(Buffer& output_buf) const
+        -> ystdlib::error_handling::Result<void> {
+    // Node IDs are assigned in insertion order and a node's parent is always inserted before the
+    // node itself, so re-emitting the nodes in ID order yields a valid insertion sequence.
+    for (size_t id{SchemaTree::cRootId + 1}; id < m_auto_gen_keys_schema_tree.get_size(); ++id) {
+        auto const& node{
+                m_auto_gen_keys_schema_tree.get_node(static_cast<SchemaTree::Node::id_t>(id))
+        };
+        YSTDLIB_ERROR_HANDLING_TRYV(serialize_schema_tree_node<true>(
+                {node.get_parent_id_unsafe(), node.get_key_name(), node.get_type()},
+                output_buf
+        ));
+    }
+    for (size_t id{SchemaTree::cRootId + 1}; id < m_user_gen_keys_schema_tree.get_size(); ++id) {
+        auto const& node{
+                m_user_gen_keys_schema_tree.get_node(static_cast<SchemaTree::Node::id_t>(id))
+        };
+        YSTDLIB_ERROR_HANDLING_TRYV(serialize_schema_tree_node<false>(
+                {node.get_parent_id_unsafe(), node.get_key_name(), node.get_type()},
+                output_buf
+        ));
+    }
+    serialize_utc_offset_change(m_curr_utc_offset, output_buf);
+    return success();
+}
+
 template <typename encoded_variable_t>
 template <bool is_auto_generated_node>
 auto Serializer<encoded_variable_t>::serialize_schema_tree_node(
-        SchemaTree::NodeLocator const& locator
+        SchemaTree::NodeLocator const& locator,
+        Buffer& output_buf
 ) -> ystdlib::error_handling::Result<void> {
     switch (locator.get_type()) {
         case SchemaTree::Node::Type::Int:
-            m_schema_tree_node_buf.push_back(cProtocol::Payload::SchemaTreeNodeInt);
+            output_buf.push_back(cProtocol::Payload::SchemaTreeNodeInt);
             break;
         case SchemaTree::Node::Type::Float:
-            m_schema_tree_node_buf.push_back(cProtocol::Payload::SchemaTreeNodeFloat);
+            output_buf.push_back(cProtocol::Payload::SchemaTreeNodeFloat);
             break;
         case SchemaTree::Node::Type::Bool:
-            m_schema_tree_node_buf.push_back(cProtocol::Payload::SchemaTreeNodeBool);
+            output_buf.push_back(cProtocol::Payload::SchemaTreeNodeBool);
             break;
         case SchemaTree::Node::Type::Str:
-            m_schema_tree_node_buf.push_back(cProtocol::Payload::SchemaTreeNodeStr);
+            output_buf.push_back(cProtocol::Payload::SchemaTreeNodeStr);
             break;
         case SchemaTree::Node::Type::UnstructuredArray:
-            m_schema_tree_node_buf.push_back(cProtocol::Payload::SchemaTreeNodeUnstructuredArray);
+            output_buf.push_back(cProtocol::Payload::SchemaTreeNodeUnstructuredArray);
             break;
         case SchemaTree::Node::Type::Obj:
-            m_schema_tree_node_buf.push_back(cProtocol::Payload::SchemaTreeNodeObj);
+            output_buf.push_back(cProtocol::Payload::SchemaTreeNodeObj);
             break;
         default:
             return IrSerializationError{IrSerializationErrorEnum::UnknownSchemaTreeNodeType};
@@ -756,10 +800,10 @@ auto Serializer<encoded_variable_t>::serialize_schema_tree_node(
             cProtocol::Payload::EncodedSchemaTreeNodeParentIdByte,
             cProtocol::Payload::EncodedSchemaTreeNodeParentIdShort,
             cProtocol::Payload::EncodedSchemaTreeNodeParentIdInt
-    >(locator.get_parent_id(), m_schema_tree_node_buf);
+    >(locator.get_parent_id(), output_buf);
     YSTDLIB_ERROR_HANDLING_TRYV(encode_result);
 
-    if (false == serialize_string(locator.get_key_name(), m_schema_tree_node_buf)) {
+    if (false == serialize_string(locator.get_key_name(), output_buf)) {
         return IrSerializationError{IrSerializationErrorEnum::SchemaTreeNodeSerializationFailure};
     }
     return success();
@@ -788,16 +832,27 @@ template auto Serializer<four_byte_encoded_variable_t>::serialize_msgpack_map(
         msgpack::object_map const& user_gen_kv_pairs_map
 ) -> ystdlib::error_handling::Result<void>;
 
+template auto Serializer<eight_byte_encoded_variable_t>::serialize_sync_point(
+        Buffer& output_buf
+) const -> ystdlib::error_handling::Result<void>;
+template auto Serializer<four_byte_encoded_variable_t>::serialize_sync_point(
+        Buffer& output_buf
+) const -> ystdlib::error_handling::Result<void>;
+
 template auto Serializer<eight_byte_encoded_variable_t>::serialize_schema_tree_node<true>(
-        SchemaTree::NodeLocator const& locator
+        SchemaTree::NodeLocator const& locator,
+        Buffer& output_buf
 ) -> ystdlib::error_handling::Result<void>;
 template auto Serializer<eight_byte_encoded_variable_t>::serialize_schema_tree_node<false>(
-        SchemaTree::NodeLocator const& locator
+        SchemaTree::NodeLocator const& locator,
+        Buffer& output_buf
 ) -> ystdlib::error_handling::Result<void>;
 template auto Serializer<four_byte_encoded_variable_t>::serialize_schema_tree_node<true>(
-        SchemaTree::NodeLocator const& locator
+        SchemaTree::NodeLocator const& locator,
+        Buffer& output_buf
 ) -> ystdlib::error_handling::Result<void>;
 template auto Serializer<four_byte_encoded_variable_t>::serialize_schema_tree_node<false>(
-        SchemaTree::NodeLocator const& locator
+        SchemaTree::NodeLocator const& locator,
+        Buffer& output_buf
 ) -> ystdlib::error_handling::Result<void>;
 }  // namespace clp::ffi::ir_stream
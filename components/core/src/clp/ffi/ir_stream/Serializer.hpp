@@ -14,6 +14,7 @@
 #include "../../time_types.hpp"
 #include "../SchemaTree.hpp"
 #include "IrSerializationError.hpp"
+#include "SchemaTreeNodeLocatorCache.hpp"
 
 namespace clp::ffi::ir_stream {
 /**
@@ -103,15 +104,34 @@ public:
             msgpack::object_map const& user_gen_kv_pairs_map
     ) -> ystdlib::error_handling::Result<void>;
 
+    /**
+     * Serializes a sync point into the given buffer (instead of the underlying IR buffer).
+     *
+     * A sync point re-emits a schema tree node insertion IR unit for every non-root node in both
+     * schema trees (in node ID order), followed by a UTC offset change IR unit for the current UTC
+     * offset. Feeding a sync point to a deserializer that has only consumed the stream's preamble
+     * restores the deserializer state at the point where the sync point was taken, allowing it to
+     * resume deserialization from any log event boundary at or after that point.
+     *
+     * NOTE: Sync points are not part of the IR stream itself, so callers must store them
+     * out-of-band (e.g., in a sidecar index).
+     * @param output_buf
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `serialize_schema_tree_node`'s return values on failure.
+     */
+    [[nodiscard]] auto serialize_sync_point(Buffer& output_buf) const
+            -> ystdlib::error_handling::Result<void>;
+
 private:
     // Constructors
     Serializer() = default;
 
     // Methods
     /**
-     * Serializes a schema tree node identified by the given locator into `m_schema_tree_node_buf`.
+     * Serializes a schema tree node identified by the given locator into the given buffer.
      * @tparam is_auto_generated_node
      * @param locator
+     * @param output_buf
      * @return A void result on success, or an error code indicating the failure:
      * - IrSerializationErrorEnum::UnknownSchemaTreeNodeType if the node type is unsupported.
      * - IrSerializationErrorEnum::SchemaTreeNodeSerializationFailure if the key name couldn't be
@@ -119,13 +139,16 @@ private:
      * - Forwards `encode_and_serialize_schema_tree_node_id`'s return value on failure.
      */
     template <bool is_auto_generated_node>
-    [[nodiscard]] auto serialize_schema_tree_node(SchemaTree::NodeLocator const& locator)
+    [[nodiscard]] static auto
+    serialize_schema_tree_node(SchemaTree::NodeLocator const& locator, Buffer& output_buf)
             -> ystdlib::error_handling::Result<void>;
 
     UtcOffset m_curr_utc_offset{0};
     Buffer m_ir_buf;
     SchemaTree m_auto_gen_keys_schema_tree;
     SchemaTree m_user_gen_keys_schema_tree;
+    SchemaTreeNodeLocatorCache m_auto_gen_locator_cache;
+    SchemaTreeNodeLocatorCache m_user_gen_locator_cache;
 
     std::string m_logtype_buf;
     Buffer m_schema_tree_node_buf;
@@ -17,14 +17,6 @@ using std::vector;
 
 namespace clp::ffi::ir_stream {
 // Local function prototypes
-/**
- * Serializes the given logtype into the IR stream
- * @param logtype
- * @param ir_buf
- * @return true on success, false otherwise
- */
-static bool serialize_logtype(string_view logtype, vector<int8_t>& ir_buf);
-
 /**
  * Adds the basic metadata fields to the given JSON object
  * @param timestamp_pattern
@@ -51,29 +43,32 @@ public:
     explicit DictionaryVariableHandler(vector<int8_t>& ir_buf) : m_ir_buf(ir_buf) {}
 
     bool operator()(string_view message, size_t begin_pos, size_t end_pos) {
-        auto length = end_pos - begin_pos;
-        if (length <= UINT8_MAX) {
-            m_ir_buf.push_back(cProtocol::Payload::VarStrLenUByte);
-            m_ir_buf.push_back(bit_cast<int8_t>(static_cast<uint8_t>(length)));
-        } else if (length <= UINT16_MAX) {
-            m_ir_buf.push_back(cProtocol::Payload::VarStrLenUShort);
-            serialize_int(static_cast<uint16_t>(length), m_ir_buf);
-        } else if (length <= INT32_MAX) {
-            m_ir_buf.push_back(cProtocol::Payload::VarStrLenInt);
-            serialize_int(static_cast<int32_t>(length), m_ir_buf);
-        } else {
-            return false;
-        }
-        auto message_begin = message.cbegin();
-        m_ir_buf.insert(m_ir_buf.cend(), message_begin + begin_pos, message_begin + end_pos);
-        return true;
+        return serialize_dict_var(message.substr(begin_pos, end_pos - begin_pos), m_ir_buf);
     }
 
 private:
     vector<int8_t>& m_ir_buf;
 };
 
-static bool serialize_logtype(string_view logtype, vector<int8_t>& ir_buf) {
+bool serialize_dict_var(string_view var, vector<int8_t>& ir_buf) {
+    auto length = var.length();
+    if (length <= UINT8_MAX) {
+        ir_buf.push_back(cProtocol::Payload::VarStrLenUByte);
+        ir_buf.push_back(bit_cast<int8_t>(static_cast<uint8_t>(length)));
+    } else if (length <= UINT16_MAX) {
+        ir_buf.push_back(cProtocol::Payload::VarStrLenUShort);
+        serialize_int(static_cast<uint16_t>(length), ir_buf);
+    } else if (length <= INT32_MAX) {
+        ir_buf.push_back(cProtocol::Payload::VarStrLenInt);
+        serialize_int(static_cast<int32_t>(length), ir_buf);
+    } else {
+        return false;
+    }
+    ir_buf.insert(ir_buf.cend(), var.cbegin(), var.cend());
+    return true;
+}
+
+bool serialize_logtype(string_view logtype, vector<int8_t>& ir_buf) {
     auto length = logtype.length();
     if (length <= UINT8_MAX) {
         ir_buf.push_back(cProtocol::Payload::LogtypeStrLenUByte);
@@ -216,8 +211,7 @@ bool serialize_log_event(
 
 bool serialize_message(string_view message, string& logtype, vector<int8_t>& ir_buf) {
     auto encoded_var_handler = [&ir_buf](four_byte_encoded_variable_t encoded_var) {
-        ir_buf.push_back(cProtocol::Payload::VarFourByteEncoding);
-        serialize_int(encoded_var, ir_buf);
+        serialize_encoded_var(encoded_var, ir_buf);
     };
 
     if (false
@@ -259,6 +253,11 @@ bool serialize_timestamp(epoch_time_ms_t timestamp_delta, std::vector<int8_t>& i
 
     return true;
 }
+
+void serialize_encoded_var(four_byte_encoded_variable_t encoded_var, vector<int8_t>& ir_buf) {
+    ir_buf.push_back(cProtocol::Payload::VarFourByteEncoding);
+    serialize_int(encoded_var, ir_buf);
+}
 }  // namespace four_byte_encoding
 
 void serialize_utc_offset_change(UtcOffset utc_offset, std::vector<int8_t>& ir_buf) {
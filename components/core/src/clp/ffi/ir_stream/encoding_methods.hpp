@@ -100,8 +100,32 @@ bool serialize_message(std::string_view message, std::string& logtype, std::vect
  * @return true on success, false otherwise
  */
 bool serialize_timestamp(ir::epoch_time_ms_t timestamp_delta, std::vector<int8_t>& ir_buf);
+
+/**
+ * Serializes the given encoded variable into the four-byte encoding IR stream
+ * @param encoded_var
+ * @param ir_buf
+ */
+void
+serialize_encoded_var(ir::four_byte_encoded_variable_t encoded_var, std::vector<int8_t>& ir_buf);
 }  // namespace four_byte_encoding
 
+/**
+ * Serializes the given dictionary variable into the IR stream
+ * @param var
+ * @param ir_buf
+ * @return true on success, false if the variable is too long to encode
+ */
+bool serialize_dict_var(std::string_view var, std::vector<int8_t>& ir_buf);
+
+/**
+ * Serializes the given logtype into the IR stream
+ * @param logtype
+ * @param ir_buf
+ * @return true on success, false if the logtype is too long to encode
+ */
+bool serialize_logtype(std::string_view logtype, std::vector<int8_t>& ir_buf);
+
 /**
  * Serializes the given UTC offset into the IR stream
  * @param utc_offset
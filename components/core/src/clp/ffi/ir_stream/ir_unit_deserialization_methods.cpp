@@ -102,6 +102,7 @@ deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& dese
  * log event.
  * @param reader
  * @param tag Takes the current tag as input and returns the last tag read.
+ * @param auto_gen_keys_schema_tree
  * @return A result containing a pair or an error code indicating the failure:
  * - The pair:
  *   - The auto-generated node-ID-value pairs.
@@ -109,12 +110,15 @@ deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& dese
  * - The possible error codes:
  *   - IrDeserializationErrorEnum::InvalidKeyGroupOrdering if the IR stream contains auto-generated
  *     key IDs *after* a user-generated key ID has been deserialized.
+ *   - std::errc::operation_not_permitted if an auto-generated key ID doesn't exist in
+ *     `auto_gen_keys_schema_tree`.
  *   - Forwards `deserialize_tag`'s return values on failure.
  *   - Forwards `deserialize_and_decode_schema_tree_node_id`'s return values on failure.
  */
 [[nodiscard]] auto deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(
         ReaderInterface& reader,
-        encoded_tag_t& tag
+        encoded_tag_t& tag,
+        SchemaTree const& auto_gen_keys_schema_tree
 ) -> ystdlib::error_handling::Result<std::pair<KeyValuePairLogEvent::NodeIdValuePairs, Schema>>;
 
 /**
@@ -164,9 +168,11 @@ template <ir::EncodedVariableTypeReq encoded_variable_t>
  * @param reader
  * @param tag
  * @param schema The log event's schema.
+ * @param schema_tree The schema tree that the IDs in `schema` refer to.
  * @param node_id_value_pairs Returns the constructed ID-value pairs.
  * @return A void result on success, or an error code indicating the failure:
  * - IrDeserializationErrorEnum::DuplicateKey if a key is duplicated in the deserialized log event.
+ * - std::errc::operation_not_permitted if a key ID doesn't exist in `schema_tree`.
  * - Forwards `deserialize_tag`'s return values on failure.
  * - Forwards `deserialize_value_and_insert_to_node_id_value_pairs`'s return values on failure.
  */
@@ -174,6 +180,7 @@ template <ir::EncodedVariableTypeReq encoded_variable_t>
         ReaderInterface& reader,
         encoded_tag_t tag,
         Schema const& schema,
+        SchemaTree const& schema_tree,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
 ) -> ystdlib::error_handling::Result<void>;
 
@@ -270,7 +277,8 @@ auto deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string&
 
 auto deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(
         ReaderInterface& reader,
-        encoded_tag_t& tag
+        encoded_tag_t& tag,
+        SchemaTree const& auto_gen_keys_schema_tree
 ) -> ystdlib::error_handling::Result<std::pair<KeyValuePairLogEvent::NodeIdValuePairs, Schema>> {
     KeyValuePairLogEvent::NodeIdValuePairs auto_gen_node_id_value_pairs;
     Schema user_gen_schema;
@@ -302,6 +310,11 @@ auto deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(
             break;
         }
 
+        // A key ID that doesn't exist in the schema tree means the stream is invalid, so fail
+        // before deserializing its value.
+        if (node_id >= auto_gen_keys_schema_tree.get_size()) {
+            return std::errc::operation_not_permitted;
+        }
         YSTDLIB_ERROR_HANDLING_TRYV(deserialize_value_and_insert_to_node_id_value_pairs(
                 reader,
                 tag,
@@ -419,11 +432,16 @@ auto deserialize_value_and_construct_node_id_value_pairs(
         ReaderInterface& reader,
         encoded_tag_t tag,
         Schema const& schema,
+        SchemaTree const& schema_tree,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
 ) -> ystdlib::error_handling::Result<void> {
     node_id_value_pairs.clear();
     node_id_value_pairs.reserve(schema.size());
     for (auto const node_id : schema) {
+        // A key ID that doesn't exist in the schema tree means the stream is invalid
+        if (node_id >= schema_tree.get_size()) {
+            return std::errc::operation_not_permitted;
+        }
         if (node_id_value_pairs.contains(node_id)) {
             // The key should be unique in a schema
             return IrDeserializationError{IrDeserializationErrorEnum::DuplicateKey};
@@ -513,7 +531,11 @@ auto deserialize_ir_unit_kv_pair_log_event(
         UtcOffset utc_offset
 ) -> ystdlib::error_handling::Result<KeyValuePairLogEvent> {
     auto auto_gen_node_id_value_pairs_and_user_gen_schema_result{
-            deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(reader, tag)
+            deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(
+                    reader,
+                    tag,
+                    *auto_gen_keys_schema_tree
+            )
     };
     if (auto_gen_node_id_value_pairs_and_user_gen_schema_result.has_error()) {
         return auto_gen_node_id_value_pairs_and_user_gen_schema_result.error();
@@ -527,6 +549,7 @@ auto deserialize_ir_unit_kv_pair_log_event(
                 reader,
                 tag,
                 user_gen_schema,
+                *user_gen_keys_schema_tree,
                 user_gen_node_id_value_pairs
         ));
     } else {
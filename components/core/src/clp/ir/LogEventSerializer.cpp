@@ -2,6 +2,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
@@ -9,6 +10,7 @@
 #include "../ErrorCode.hpp"
 #include "../ffi/ir_stream/encoding_methods.hpp"
 #include "../ffi/ir_stream/protocol_constants.hpp"
+#include "../ffi/ir_stream/utils.hpp"
 #include "../ir/types.hpp"
 #include "../type_utils.hpp"
 
@@ -99,36 +101,24 @@ auto LogEventSerializer<encoded_variable_t>::serialize_log_event(
         epoch_time_ms_t timestamp,
         string_view message
 ) -> bool {
-    if (false == m_is_open) {
-        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
-    }
-
-    string logtype;
-    bool res{};
-    auto const buf_size_before_serialization = m_ir_buf.size();
-    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
-        res = clp::ffi::ir_stream::eight_byte_encoding::serialize_log_event(
-                timestamp,
-                message,
-                logtype,
-                m_ir_buf
-        );
-    } else {
-        auto const timestamp_delta = timestamp - m_prev_event_timestamp;
-        m_prev_event_timestamp = timestamp;
-        res = clp::ffi::ir_stream::four_byte_encoding::serialize_log_event(
-                timestamp_delta,
-                message,
-                logtype,
-                m_ir_buf
-        );
-    }
-    if (false == res) {
-        return false;
-    }
-    m_serialized_size += m_ir_buf.size() - buf_size_before_serialization;
-    ++m_num_log_events;
-    return true;
+    return serialize_encoded_log_event(
+            timestamp,
+            [&](string& logtype, std::vector<int8_t>& ir_buf) -> bool {
+                if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+                    return clp::ffi::ir_stream::eight_byte_encoding::serialize_message(
+                            message,
+                            logtype,
+                            ir_buf
+                    );
+                } else {
+                    return clp::ffi::ir_stream::four_byte_encoding::serialize_message(
+                            message,
+                            logtype,
+                            ir_buf
+                    );
+                }
+            }
+    );
 }
 
 template <typename encoded_variable_t>
@@ -137,6 +127,27 @@ auto LogEventSerializer<encoded_variable_t>::close_writer() -> void {
     m_writer.close();
 }
 
+template <typename encoded_variable_t>
+auto LogEventSerializer<encoded_variable_t>::serialize_timestamp(epoch_time_ms_t timestamp)
+        -> bool {
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        m_ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Payload::TimestampVal);
+        clp::ffi::ir_stream::serialize_int(timestamp, m_ir_buf);
+        return true;
+    } else {
+        if (false
+            == clp::ffi::ir_stream::four_byte_encoding::serialize_timestamp(
+                    timestamp - m_prev_event_timestamp,
+                    m_ir_buf
+            ))
+        {
+            return false;
+        }
+        m_prev_event_timestamp = timestamp;
+        return true;
+    }
+}
+
 // Explicitly declare template specializations so that we can define the template methods in this
 // file
 template LogEventSerializer<eight_byte_encoded_variable_t>::~LogEventSerializer();
@@ -159,4 +170,10 @@ template auto LogEventSerializer<four_byte_encoded_variable_t>::serialize_log_ev
 ) -> bool;
 template auto LogEventSerializer<eight_byte_encoded_variable_t>::close_writer() -> void;
 template auto LogEventSerializer<four_byte_encoded_variable_t>::close_writer() -> void;
+template auto LogEventSerializer<eight_byte_encoded_variable_t>::serialize_timestamp(
+        epoch_time_ms_t timestamp
+) -> bool;
+template auto LogEventSerializer<four_byte_encoded_variable_t>::serialize_timestamp(
+        epoch_time_ms_t timestamp
+) -> bool;
 }  // namespace clp::ir
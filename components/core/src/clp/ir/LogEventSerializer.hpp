@@ -90,6 +90,22 @@ public:
     [[nodiscard]] auto serialize_log_event(epoch_time_ms_t timestamp, std::string_view message)
             -> bool;
 
+    /**
+     * Serializes a log event whose message has already been parsed and encoded (e.g., when
+     * transcoding from another encoded format), avoiding parsing the message's text.
+     * @tparam MessageSerializer Function to serialize the log event's message using this
+     * serializer's variable encoding.
+     * Signature: (std::string& logtype, std::vector<int8_t>& ir_buf) -> bool;
+     * The function returns whether it succeeded.
+     * @param timestamp
+     * @param message_serializer
+     * @return Whether the log event was successfully serialized.
+     */
+    template <typename MessageSerializer>
+    [[nodiscard]] auto
+    serialize_encoded_log_event(epoch_time_ms_t timestamp, MessageSerializer message_serializer)
+            -> bool;
+
 private:
     // Constants
     // NOTE: IR files currently store the log's timestamp pattern and timezone ID. However:
@@ -109,6 +125,13 @@ private:
      */
     auto close_writer() -> void;
 
+    /**
+     * Serializes the given log event's timestamp.
+     * @param timestamp
+     * @return Whether the timestamp was successfully serialized.
+     */
+    [[nodiscard]] auto serialize_timestamp(epoch_time_ms_t timestamp) -> bool;
+
     // Variables
     size_t m_num_log_events{0};
     size_t m_serialized_size{0};  // Bytes
@@ -119,12 +142,35 @@ private:
             EmptyType
     > m_prev_event_timestamp{};
 
+    std::string m_logtype_buf;
     std::vector<int8_t> m_ir_buf;
     FileWriter m_writer;
     streaming_compression::zstd::Compressor m_zstd_compressor;
 
     bool m_is_open{false};
 };
+
+template <typename encoded_variable_t>
+template <typename MessageSerializer>
+auto LogEventSerializer<encoded_variable_t>::serialize_encoded_log_event(
+        epoch_time_ms_t timestamp,
+        MessageSerializer message_serializer
+) -> bool {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    auto const buf_size_before_serialization = m_ir_buf.size();
+    if (false == message_serializer(m_logtype_buf, m_ir_buf)
+        || false == serialize_timestamp(timestamp))
+    {
+        m_ir_buf.resize(buf_size_before_serialization);
+        return false;
+    }
+    m_serialized_size += m_ir_buf.size() - buf_size_before_serialization;
+    ++m_num_log_events;
+    return true;
+}
 }  // namespace clp::ir
 
 #endif  // CLP_IR_LOGEVENTSERIALIZER_HPP
@@ -1,9 +1,20 @@
 #include "parsing.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
+
+    #define CLP_IR_PARSING_USE_SIMD 1
+#endif
+
 #include <string_utils/string_utils.hpp>
 
 #include "../type_utils.hpp"
@@ -13,6 +24,132 @@ using std::string;
 using std::string_view;
 
 namespace clp::ir {
+namespace {
+#if defined(CLP_IR_PARSING_USE_SIMD)
+// Number of characters classified at a time
+constexpr size_t cBlockSize{64};
+constexpr size_t cMaskWidth{64};
+static_assert(cBlockSize <= cMaskWidth);
+
+/**
+ * Bitmasks classifying each character in a block, where bit `i` corresponds to the block's `i`-th
+ * character.
+ */
+struct CharClassMasks {
+    uint64_t non_delim;
+    uint64_t decimal_digit;
+    uint64_t alphabet;
+};
+
+    #if defined(__AVX2__)
+/**
+ * @param chars
+ * @param lower
+ * @param upper
+ * @return A mask of the bytes in `chars` that are within [lower, upper].
+ * NOTE: The comparison is signed, so this only works when `lower` and `upper` are ASCII.
+ */
+[[nodiscard]] auto in_range(__m256i chars, char lower, char upper) -> __m256i {
+    return _mm256_and_si256(
+            _mm256_cmpgt_epi8(chars, _mm256_set1_epi8(static_cast<char>(lower - 1))),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(upper + 1)), chars)
+    );
+}
+
+/**
+ * Classifies 32 characters.
+ * @param chars
+ * @return The classification of each character, in the lower 32 bits of each mask.
+ */
+[[nodiscard]] auto classify_chars(__m256i chars) -> CharClassMasks {
+    auto const decimal_digit{in_range(chars, '0', '9')};
+    // Setting bit 5 maps upper-case letters to lower-case ones without mapping any other character
+    // into ['a', 'z'].
+    auto const alphabet{in_range(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), 'a', 'z')};
+    auto const other_non_delim{_mm256_or_si256(
+            _mm256_or_si256(
+                    _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('+')),
+                    in_range(chars, '-', '.')
+            ),
+            _mm256_or_si256(
+                    _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\\')),
+                    _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_'))
+            )
+    )};
+    auto const non_delim{
+            _mm256_or_si256(_mm256_or_si256(decimal_digit, alphabet), other_non_delim)
+    };
+    return {static_cast<uint32_t>(_mm256_movemask_epi8(non_delim)),
+            static_cast<uint32_t>(_mm256_movemask_epi8(decimal_digit)),
+            static_cast<uint32_t>(_mm256_movemask_epi8(alphabet))};
+}
+    #else
+/**
+ * @param chars
+ * @param lower
+ * @param upper
+ * @return A mask of the bytes in `chars` that are within [lower, upper].
+ * NOTE: The comparison is signed, so this only works when `lower` and `upper` are ASCII.
+ */
+[[nodiscard]] auto in_range(__m128i chars, char lower, char upper) -> __m128i {
+    return _mm_and_si128(
+            _mm_cmpgt_epi8(chars, _mm_set1_epi8(static_cast<char>(lower - 1))),
+            _mm_cmplt_epi8(chars, _mm_set1_epi8(static_cast<char>(upper + 1)))
+    );
+}
+
+/**
+ * Classifies 16 characters.
+ * @param chars
+ * @return The classification of each character, in the lower 16 bits of each mask.
+ */
+[[nodiscard]] auto classify_chars(__m128i chars) -> CharClassMasks {
+    auto const decimal_digit{in_range(chars, '0', '9')};
+    // Setting bit 5 maps upper-case letters to lower-case ones without mapping any other character
+    // into ['a', 'z'].
+    auto const alphabet{in_range(_mm_or_si128(chars, _mm_set1_epi8(0x20)), 'a', 'z')};
+    auto const other_non_delim{_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('+')), in_range(chars, '-', '.')),
+            _mm_or_si128(
+                    _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\')),
+                    _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'))
+            )
+    )};
+    auto const non_delim{_mm_or_si128(_mm_or_si128(decimal_digit, alphabet), other_non_delim)};
+    return {static_cast<uint32_t>(_mm_movemask_epi8(non_delim)),
+            static_cast<uint32_t>(_mm_movemask_epi8(decimal_digit)),
+            static_cast<uint32_t>(_mm_movemask_epi8(alphabet))};
+}
+    #endif
+
+/**
+ * Classifies `cBlockSize` characters with the same rules as `is_delim`,
+ * `string_utils::is_decimal_digit`, and `string_utils::is_alphabet`.
+ * @param block Pointer to `cBlockSize` readable characters.
+ * @return The classification of the block's characters.
+ */
+[[nodiscard]] auto classify_block(char const* block) -> CharClassMasks {
+    #if defined(__AVX2__)
+    using vector_t = __m256i;
+    #else
+    using vector_t = __m128i;
+    #endif
+    CharClassMasks masks{};
+    constexpr size_t cVectorSize{sizeof(vector_t)};
+    for (size_t offset{0}; offset < cBlockSize; offset += cVectorSize) {
+        vector_t chars;
+        std::memcpy(&chars, block + offset, cVectorSize);
+        auto const vector_masks{classify_chars(chars)};
+        masks.non_delim |= vector_masks.non_delim << offset;
+        masks.decimal_digit |= vector_masks.decimal_digit << offset;
+        masks.alphabet |= vector_masks.alphabet << offset;
+    }
+    return masks;
+}
+
+#endif
+}  // namespace
+
 /*
  * For performance, we rely on the ASCII ordering of characters to compare ranges of characters at a
  * time instead of comparing individual characters
@@ -35,6 +172,12 @@ bool is_var(std::string_view value) {
 }
 
 bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& end_pos) {
+    VariableBoundsFinder finder{str};
+    return finder.get_bounds_of_next_var(begin_pos, end_pos);
+}
+
+auto VariableBoundsFinder::get_bounds_of_next_var(size_t& begin_pos, size_t& end_pos) -> bool {
+    auto const str{m_str};
     auto const msg_length = str.length();
     if (msg_length <= end_pos) {
         return false;
@@ -44,12 +187,7 @@ bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& en
         begin_pos = end_pos;
 
         // Find next non-delimiter
-        for (; begin_pos < msg_length; ++begin_pos) {
-            auto c = str[begin_pos];
-            if (false == is_delim(c)) {
-                break;
-            }
-        }
+        begin_pos = find_next_non_delim(begin_pos);
         if (msg_length == begin_pos) {
             // Early exit for performance
             return false;
@@ -59,17 +197,7 @@ bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& en
         bool contains_alphabet = false;
 
         // Find next delimiter
-        end_pos = begin_pos;
-        for (; end_pos < msg_length; ++end_pos) {
-            auto c = str[end_pos];
-            if (string_utils::is_decimal_digit(c)) {
-                contains_decimal_digit = true;
-            } else if (string_utils::is_alphabet(c)) {
-                contains_alphabet = true;
-            } else if (is_delim(c)) {
-                break;
-            }
-        }
+        end_pos = find_next_delim(begin_pos, contains_decimal_digit, contains_alphabet);
 
         auto variable = str.substr(begin_pos, end_pos - begin_pos);
         // Treat token as variable if:
@@ -87,6 +215,95 @@ bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& en
     return (msg_length != begin_pos);
 }
 
+#if defined(CLP_IR_PARSING_USE_SIMD)
+auto VariableBoundsFinder::find_next_non_delim(size_t pos) -> size_t {
+    auto const length{m_str.length()};
+    while (pos < length) {
+        auto const num_valid_bits{load_block_containing(pos)};
+        auto const non_delim_mask{m_non_delim_mask >> (pos - m_block_begin_pos)};
+        if (0 != non_delim_mask) {
+            return std::min(pos + std::countr_zero(non_delim_mask), length);
+        }
+        pos += num_valid_bits;
+    }
+    return length;
+}
+
+auto VariableBoundsFinder::find_next_delim(
+        size_t pos,
+        bool& contains_decimal_digit,
+        bool& contains_alphabet
+) -> size_t {
+    // Positions past the end of the string are classified as delimiters, so this always terminates
+    // at or before the end of the string.
+    while (true) {
+        auto const num_valid_bits{load_block_containing(pos)};
+        auto const shift{pos - m_block_begin_pos};
+        auto const valid_bits_mask{
+                cMaskWidth == num_valid_bits ? UINT64_MAX : (uint64_t{1} << num_valid_bits) - 1
+        };
+        auto const delim_mask{~(m_non_delim_mask >> shift) & valid_bits_mask};
+        auto token_mask{valid_bits_mask};
+        if (0 != delim_mask) {
+            token_mask = (uint64_t{1} << std::countr_zero(delim_mask)) - 1;
+        }
+        contains_decimal_digit
+                = contains_decimal_digit || 0 != ((m_decimal_digit_mask >> shift) & token_mask);
+        contains_alphabet = contains_alphabet || 0 != ((m_alphabet_mask >> shift) & token_mask);
+        if (0 != delim_mask) {
+            return pos + std::countr_zero(delim_mask);
+        }
+        pos += num_valid_bits;
+    }
+}
+
+auto VariableBoundsFinder::load_block_containing(size_t pos) -> size_t {
+    if (pos < m_block_begin_pos || m_block_begin_pos + cBlockSize <= pos) {
+        CharClassMasks masks{};
+        if (pos + cBlockSize <= m_str.length()) {
+            masks = classify_block(m_str.data() + pos);
+        } else {
+            // Pad the end of the string with nulls, which are delimiters
+            std::array<char, cBlockSize> padded_block{};
+            std::memcpy(padded_block.data(), m_str.data() + pos, m_str.length() - pos);
+            masks = classify_block(padded_block.data());
+        }
+        m_block_begin_pos = pos;
+        m_non_delim_mask = masks.non_delim;
+        m_decimal_digit_mask = masks.decimal_digit;
+        m_alphabet_mask = masks.alphabet;
+    }
+    return m_block_begin_pos + cBlockSize - pos;
+}
+#else
+auto VariableBoundsFinder::find_next_non_delim(size_t pos) -> size_t {
+    for (; pos < m_str.length(); ++pos) {
+        if (false == is_delim(m_str[pos])) {
+            break;
+        }
+    }
+    return pos;
+}
+
+auto VariableBoundsFinder::find_next_delim(
+        size_t pos,
+        bool& contains_decimal_digit,
+        bool& contains_alphabet
+) -> size_t {
+    for (; pos < m_str.length(); ++pos) {
+        auto c = m_str[pos];
+        if (string_utils::is_decimal_digit(c)) {
+            contains_decimal_digit = true;
+        } else if (string_utils::is_alphabet(c)) {
+            contains_alphabet = true;
+        } else if (is_delim(c)) {
+            break;
+        }
+    }
+    return pos;
+}
+#endif
+
 void escape_and_append_const_to_logtype(string_view constant, string& logtype) {
     // clang-format off
     auto escape_handler = [&](
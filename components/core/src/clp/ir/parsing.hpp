@@ -10,6 +10,7 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -77,6 +78,84 @@ bool is_var(std::string_view value);
  */
 bool get_bounds_of_next_var(std::string_view str, size_t& begin_pos, size_t& end_pos);
 
+/**
+ * Finds the bounds of successive variables in a string, with the same semantics as
+ * `get_bounds_of_next_var`.
+ *
+ * Where SIMD instructions are available, the string's characters are classified a block at a time,
+ * and the last block's classification is reused across calls. So when finding all variables in a
+ * string, reusing a single instance is faster than repeatedly calling `get_bounds_of_next_var`.
+ *
+ * NOTE: The instance holds a view of the string, so the string must outlive it and must not be
+ * modified while it's in use.
+ */
+class VariableBoundsFinder {
+public:
+    // Constructors
+    VariableBoundsFinder() = default;
+
+    explicit VariableBoundsFinder(std::string_view str) : m_str{str} {}
+
+    // Methods
+    /**
+     * Switches to the given string, discarding any cached state.
+     * @param str
+     */
+    auto reset(std::string_view str) -> void {
+        m_str = str;
+        m_block_begin_pos = cNoBlockPos;
+    }
+
+    [[nodiscard]] auto get_str() const -> std::string_view { return m_str; }
+
+    /**
+     * Gets the bounds of the next variable in the string.
+     * @param begin_pos Begin position of last variable, changes to begin position of next variable
+     * @param end_pos End position of last variable, changes to end position of next variable
+     * @return true if a variable was found, false otherwise
+     */
+    [[nodiscard]] auto get_bounds_of_next_var(size_t& begin_pos, size_t& end_pos) -> bool;
+
+private:
+    // Constants
+    static constexpr size_t cNoBlockPos{SIZE_MAX / 2};
+
+    // Methods
+    /**
+     * @param pos
+     * @return The position of the first non-delimiter at or after `pos`, or the string's length if
+     * there's no such character.
+     */
+    [[nodiscard]] auto find_next_non_delim(size_t pos) -> size_t;
+
+    /**
+     * Finds the end of the token starting at `pos`, i.e., the first delimiter at or after `pos`.
+     * @param pos
+     * @param contains_decimal_digit Set to true if the token contains a decimal digit.
+     * @param contains_alphabet Set to true if the token contains an alphabet character.
+     * @return The position of the delimiter, or the string's length if there's no such character.
+     */
+    [[nodiscard]] auto
+    find_next_delim(size_t pos, bool& contains_decimal_digit, bool& contains_alphabet) -> size_t;
+
+    /**
+     * Classifies the block of characters starting at `pos`, unless the cached block contains
+     * `pos`. Positions past the end of the string are classified as delimiters.
+     * @param pos
+     * @return The number of characters at or after `pos` in the cached block.
+     */
+    auto load_block_containing(size_t pos) -> size_t;
+
+    // Variables
+    std::string_view m_str;
+    // Classification of the cached block of characters, where bit `i` of each mask corresponds to
+    // the character at `m_block_begin_pos + i`.
+    size_t m_block_begin_pos{cNoBlockPos};
+    uint64_t m_non_delim_mask{0};
+    uint64_t m_decimal_digit_mask{0};
+    uint64_t m_alphabet_mask{0};
+};
+
 /**
  * Appends a constant to the logtype, escaping any variable placeholders.
  * @param constant
@@ -111,6 +111,7 @@ void Archive::open(string const& path) {
 
 void Archive::close() {
     m_logtype_dictionary.close();
+    m_num_vars_per_logtype.clear();
     m_var_dictionary.close();
     m_segment_manager.close();
     m_segments_dir_path.clear();
@@ -121,10 +122,50 @@ void Archive::close() {
 void Archive::refresh_dictionaries() {
     m_logtype_dictionary.read_new_entries();
     m_var_dictionary.read_new_entries();
+
+    // Dictionaries are append-only, so we only need to add the new logtypes
+    auto const& logtype_entries = m_logtype_dictionary.get_entries();
+    for (auto logtype_id = m_num_vars_per_logtype.size(); logtype_id < logtype_entries.size();
+         ++logtype_id)
+    {
+        m_num_vars_per_logtype.push_back(
+                static_cast<uint32_t>(logtype_entries[logtype_id].get_num_variables())
+        );
+    }
 }
 
 ErrorCode Archive::open_file(File& file, MetadataDB::FileIterator const& file_metadata_ix) {
-    return file.open_me(m_logtype_dictionary, file_metadata_ix, m_segment_manager);
+    return file.open_me(
+            m_logtype_dictionary,
+            m_num_vars_per_logtype,
+            file_metadata_ix,
+            m_segment_manager
+    );
+}
+
+void Archive::ThreadLocalReader::open(Archive const& archive) {
+    m_archive = &archive;
+    auto const metadata_db_path = boost::filesystem::path(archive.m_path) / cMetadataDBFileName;
+    m_metadata_db.open(metadata_db_path.string());
+    m_segment_manager.open(archive.m_segments_dir_path);
+}
+
+void Archive::ThreadLocalReader::close() {
+    m_segment_manager.close();
+    m_metadata_db.close();
+    m_archive = nullptr;
+}
+
+ErrorCode Archive::ThreadLocalReader::open_file(
+        File& file,
+        MetadataDB::FileIterator const& file_metadata_ix
+) {
+    return file.open_me(
+            m_archive->m_logtype_dictionary,
+            m_archive->m_num_vars_per_logtype,
+            file_metadata_ix,
+            m_segment_manager
+    );
 }
 
 void Archive::close_file(File& file) {
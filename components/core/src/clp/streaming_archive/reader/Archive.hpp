@@ -1,12 +1,14 @@
 #ifndef CLP_STREAMING_ARCHIVE_READER_ARCHIVE_HPP
 #define CLP_STREAMING_ARCHIVE_READER_ARCHIVE_HPP
 
+#include <cstdint>
 #include <filesystem>
 #include <iterator>
 #include <list>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "../../ErrorCode.hpp"
 #include "../../LogTypeDictionaryReader.hpp"
@@ -16,6 +18,7 @@
 #include "../MetadataDB.hpp"
 #include "File.hpp"
 #include "Message.hpp"
+#include "SegmentManager.hpp"
 
 namespace clp::streaming_archive::reader {
 class Archive {
@@ -33,6 +36,91 @@ public:
         }
     };
 
+    /**
+     * Per-thread state for opening files from an archive concurrently.
+     *
+     * An archive reads file metadata and segments through a single metadata DB connection and
+     * segment manager, neither of which are thread-safe. A `ThreadLocalReader` has its own
+     * instances of both, while sharing the archive's dictionaries, which are read-only once
+     * they've been refreshed. So each thread can open files through its own reader, and then use
+     * the archive for the remaining operations on those files (searching, decompressing, etc.).
+     *
+     * NOTE: The archive must stay open, and its dictionaries must not be refreshed, while any of
+     * its readers are open.
+     */
+    class ThreadLocalReader {
+    public:
+        // Methods
+        /**
+         * Opens the reader for the given archive.
+         *
+         * NOTE: Opening the metadata DB may write to it (e.g., to create missing tables), so
+         * readers of the same archive should be opened sequentially.
+         * @param archive An open archive.
+         * @throw Same as MetadataDB::open
+         */
+        void open(Archive const& archive);
+        /**
+         * @throw Same as MetadataDB::close
+         */
+        void close();
+
+        /**
+         * Same as Archive::open_file, except that the file is read through the reader's segment
+         * manager.
+         */
+        ErrorCode open_file(File& file, MetadataDB::FileIterator const& file_metadata_ix);
+
+        /**
+         * Same as the corresponding Archive::get_file_iterator, except that the iterator uses the
+         * reader's metadata DB connection.
+         */
+        std::unique_ptr<MetadataDB::FileIterator> get_file_iterator(
+                epochtime_t begin_ts,
+                epochtime_t end_ts,
+                std::string const& file_path,
+                bool order_by_segment_end_ts
+        ) {
+            return m_metadata_db.get_file_iterator(
+                    begin_ts,
+                    end_ts,
+                    file_path,
+                    "",
+                    false,
+                    cInvalidSegmentId,
+                    order_by_segment_end_ts
+            );
+        }
+
+        /**
+         * Same as the corresponding Archive::get_file_iterator, except that the iterator uses the
+         * reader's metadata DB connection.
+         */
+        std::unique_ptr<MetadataDB::FileIterator> get_file_iterator(
+                epochtime_t begin_ts,
+                epochtime_t end_ts,
+                std::string const& file_path,
+                segment_id_t segment_id,
+                bool order_by_segment_end_ts
+        ) {
+            return m_metadata_db.get_file_iterator(
+                    begin_ts,
+                    end_ts,
+                    file_path,
+                    "",
+                    true,
+                    segment_id,
+                    order_by_segment_end_ts
+            );
+        }
+
+    private:
+        // Variables
+        Archive const* m_archive{nullptr};
+        SegmentManager m_segment_manager;
+        MetadataDB m_metadata_db;
+    };
+
     // Methods
     /**
      * Opens archive for reading
@@ -192,6 +280,9 @@ private:
     std::string m_path;
     std::string m_segments_dir_path;
     LogTypeDictionaryReader m_logtype_dictionary;
+    // The number of variables in each logtype, indexed by logtype ID, so that scans over a file's
+    // messages don't need to access each message's (much larger) logtype dictionary entry.
+    std::vector<uint32_t> m_num_vars_per_logtype;
     VariableDictionaryReader m_var_dictionary;
 
     SegmentManager m_segment_manager;
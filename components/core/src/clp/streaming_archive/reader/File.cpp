@@ -3,6 +3,12 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
 #include "../../EncodedVariableInterpreter.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../Constants.hpp"
@@ -21,10 +27,12 @@ epochtime_t File::get_end_ts() const {
 
 ErrorCode File::open_me(
         LogTypeDictionaryReader const& archive_logtype_dict,
+        std::vector<uint32_t> const& num_vars_per_logtype,
         MetadataDB::FileIterator const& file_metadata_ix,
         SegmentManager& segment_manager
 ) {
     m_archive_logtype_dict = &archive_logtype_dict;
+    m_num_vars_per_logtype = &num_vars_per_logtype;
 
     // Populate metadata from database document
     file_metadata_ix.get_id(m_id_as_string);
@@ -142,6 +150,7 @@ ErrorCode File::open_me(
 
     m_msgs_ix = 0;
     m_variables_ix = 0;
+    m_prefiltered_query = nullptr;
 
     m_current_ts_pattern_ix = 0;
     m_current_ts_in_milli = m_begin_ts;
@@ -173,11 +182,14 @@ void File::close_me() {
     m_orig_path.clear();
 
     m_archive_logtype_dict = nullptr;
+    m_num_vars_per_logtype = nullptr;
+    m_prefiltered_query = nullptr;
 }
 
 void File::reset_indices() {
     m_msgs_ix = 0;
     m_variables_ix = 0;
+    m_prefiltered_query = nullptr;
 }
 
 string const& File::get_orig_path() const {
@@ -250,49 +262,103 @@ bool File::find_message_in_time_range(
 }
 
 SubQuery const* File::find_message_matching_query(Query const& query, Message& msg) {
-    SubQuery const* matching_sub_query = nullptr;
-    while (m_msgs_ix < m_num_messages && nullptr == matching_sub_query) {
-        auto const curr_msg_ix{m_msgs_ix};
-        auto logtype_id = m_logtypes[curr_msg_ix];
-
-        // Get number of variables in logtype
-        auto const& logtype_dictionary_entry = m_archive_logtype_dict->get_entry(logtype_id);
-        auto const num_vars = logtype_dictionary_entry.get_num_variables();
-
-        auto const vars_begin_ix{m_variables_ix};
-        auto const vars_end_ix{m_variables_ix + num_vars};
-
-        // Advance indices
-        ++m_msgs_ix;
-        m_variables_ix = vars_end_ix;
-
-        auto const timestamp{m_timestamps[curr_msg_ix]};
-        if (false == query.timestamp_is_in_search_time_range(timestamp)) {
-            continue;
+    auto const& num_vars_per_logtype = *m_num_vars_per_logtype;
+    while (true) {
+        if (&query != m_prefiltered_query || m_prefiltered_msgs_ix != m_msgs_ix) {
+            if (m_msgs_ix >= m_num_messages || false == prefilter_next_block(query)) {
+                return nullptr;
+            }
         }
 
-        for (auto const* sub_query : query.get_relevant_sub_queries()) {
-            if (false == sub_query->matches_logtype(logtype_id)) {
-                continue;
+        while (m_next_block_candidate_ix < m_num_block_candidates) {
+            auto const msg_ix{m_block_candidate_msg_ixs[m_next_block_candidate_ix]};
+            auto const vars_begin_ix{m_block_candidate_variables_ixs[m_next_block_candidate_ix]};
+            ++m_next_block_candidate_ix;
+
+            auto const logtype_id{m_logtypes[msg_ix]};
+            std::span<encoded_variable_t const> const vars{
+                    m_variables + vars_begin_ix,
+                    num_vars_per_logtype[logtype_id]
+            };
+            for (auto const* sub_query : query.get_relevant_sub_queries()) {
+                if (false == sub_query->matches_logtype(logtype_id)
+                    || false == sub_query->matches_vars(vars))
+                {
+                    continue;
+                }
+
+                msg.clear_vars();
+                for (auto const var : vars) {
+                    msg.add_var(var);
+                }
+                msg.set_logtype_id(logtype_id);
+                msg.set_timestamp(m_timestamps[msg_ix]);
+                msg.set_msg_ix(m_begin_message_ix, msg_ix);
+
+                m_msgs_ix = msg_ix + 1;
+                m_variables_ix = vars_begin_ix + vars.size();
+                m_prefiltered_msgs_ix = m_msgs_ix;
+                return sub_query;
             }
+        }
 
-            msg.clear_vars();
-            for (auto vars_ix{vars_begin_ix}; vars_ix < vars_end_ix; ++vars_ix) {
-                msg.add_var(m_variables[vars_ix]);
-            }
-            if (false == sub_query->matches_vars(msg.get_vars())) {
-                continue;
-            }
+        // No (more) matches in the block, so skip to its end
+        m_msgs_ix = m_block_end_msgs_ix;
+        m_variables_ix = m_block_end_variables_ix;
+        m_prefiltered_query = nullptr;
+    }
+}
 
-            msg.set_logtype_id(logtype_id);
-            msg.set_timestamp(timestamp);
-            msg.set_msg_ix(m_begin_message_ix, curr_msg_ix);
-            matching_sub_query = sub_query;
-            break;
+bool File::prefilter_next_block(Query const& query) {
+    auto const& num_vars_per_logtype = *m_num_vars_per_logtype;
+    auto const block_begin_msgs_ix{m_msgs_ix};
+    auto const block_end_msgs_ix{std::min<size_t>(m_msgs_ix + cPrefilterBlockSize, m_num_messages)};
+    auto const block_size{block_end_msgs_ix - block_begin_msgs_ix};
+
+    m_block_timestamp_matches.resize(cPrefilterBlockSize);
+    m_block_candidate_msg_ixs.resize(cPrefilterBlockSize);
+    m_block_candidate_variables_ixs.resize(cPrefilterBlockSize);
+
+    // Check timestamps in a separate, branch-free pass so that the compiler can vectorize it
+    auto const search_begin_timestamp{query.get_search_begin_timestamp()};
+    auto const search_end_timestamp{query.get_search_end_timestamp()};
+    epochtime_t const* timestamps{m_timestamps + block_begin_msgs_ix};
+    for (size_t i{0}; i < block_size; ++i) {
+        m_block_timestamp_matches[i] = static_cast<uint8_t>(
+                (search_begin_timestamp <= timestamps[i]) & (timestamps[i] <= search_end_timestamp)
+        );
+    }
+
+    // Compute each message's variables offset and collect the candidates without branching on
+    // whether each message is a candidate
+    auto vars_ix{m_variables_ix};
+    size_t num_candidates{0};
+    for (size_t i{0}; i < block_size; ++i) {
+        auto const msg_ix{block_begin_msgs_ix + i};
+        auto const logtype_id{m_logtypes[msg_ix]};
+        if (logtype_id >= num_vars_per_logtype.size()) {
+            throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
         }
+        m_block_candidate_msg_ixs[num_candidates] = msg_ix;
+        m_block_candidate_variables_ixs[num_candidates] = vars_ix;
+        num_candidates += m_block_timestamp_matches[i]
+                          & static_cast<uint8_t>(query.logtype_matches_relevant_sub_queries(
+                                  logtype_id
+                          ));
+        vars_ix += num_vars_per_logtype[logtype_id];
+    }
+    if (vars_ix > m_num_variables) {
+        // Logtypes not in sync with variables, so stop search
+        return false;
     }
 
-    return matching_sub_query;
+    m_prefiltered_query = &query;
+    m_prefiltered_msgs_ix = m_msgs_ix;
+    m_block_end_msgs_ix = block_end_msgs_ix;
+    m_block_end_variables_ix = vars_ix;
+    m_num_block_candidates = num_candidates;
+    m_next_block_candidate_ix = 0;
+    return true;
 }
 
 bool File::get_next_message(Message& msg) {
@@ -1,6 +1,8 @@
 #ifndef CLP_STREAMING_ARCHIVE_READER_FILE_HPP
 #define CLP_STREAMING_ARCHIVE_READER_FILE_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <list>
 #include <set>
 #include <vector>
@@ -33,6 +35,7 @@ public:
     // Constructors
     File()
             : m_archive_logtype_dict(nullptr),
+              m_num_vars_per_logtype(nullptr),
               m_begin_ts(cEpochTimeMax),
               m_end_ts(cEpochTimeMin),
               m_segment_timestamps_decompressed_stream_pos(0),
@@ -75,6 +78,8 @@ private:
     /**
      * Opens file
      * @param archive_logtype_dict
+     * @param num_vars_per_logtype The number of variables in each logtype in
+     * `archive_logtype_dict`, indexed by logtype ID
      * @param file_metadata_ix
      * @param segment_manager
      * @return Same as SegmentManager::try_read
@@ -82,6 +87,7 @@ private:
      */
     ErrorCode open_me(
             LogTypeDictionaryReader const& archive_logtype_dict,
+            std::vector<uint32_t> const& num_vars_per_logtype,
             MetadataDB::FileIterator const& file_metadata_ix,
             SegmentManager& segment_manager
     );
@@ -114,12 +120,30 @@ private:
     );
     /**
      * Finds message matching the given query
+     *
+     * Messages are scanned in blocks: for each block, the timestamp and logtype columns are
+     * filtered first to find candidate messages (along with the offsets of their variables), and
+     * only the candidates' variables are then checked against the relevant sub-queries, in place.
+     * The remaining candidates of a block are kept across calls with the same query.
      * @param query
      * @param msg
      * @return nullptr if no message matched
      * @return pointer to matching subquery otherwise
+     * @throw streaming_archive::reader::File::OperationFailed if a message's logtype isn't in the
+     * logtype dictionary
      */
     SubQuery const* find_message_matching_query(Query const& query, Message& msg);
+    /**
+     * Filters the next block of messages, starting at the current message, to find the messages
+     * whose timestamps are in the query's time range and whose logtypes match one of the query's
+     * relevant sub-queries.
+     * @param query
+     * @return Whether the block was filtered successfully, i.e., the logtypes are in sync with the
+     * variables
+     * @throw streaming_archive::reader::File::OperationFailed if a message's logtype isn't in the
+     * logtype dictionary
+     */
+    bool prefilter_next_block(Query const& query);
     /**
      * Get next message in file
      * @param msg
@@ -127,8 +151,12 @@ private:
      */
     bool get_next_message(Message& msg);
 
+    // Constants
+    static constexpr size_t cPrefilterBlockSize{1024};
+
     // Variables
     LogTypeDictionaryReader const* m_archive_logtype_dict;
+    std::vector<uint32_t> const* m_num_vars_per_logtype;
 
     epochtime_t m_begin_ts;
     epochtime_t m_end_ts;
@@ -162,6 +190,17 @@ private:
 
     size_t m_split_ix;
     bool m_is_split;
+
+    // State of the block of messages filtered by `prefilter_next_block`
+    Query const* m_prefiltered_query{nullptr};
+    size_t m_prefiltered_msgs_ix{0};
+    size_t m_block_end_msgs_ix{0};
+    size_t m_block_end_variables_ix{0};
+    std::vector<uint8_t> m_block_timestamp_matches;
+    std::vector<size_t> m_block_candidate_msg_ixs;
+    std::vector<size_t> m_block_candidate_variables_ixs;
+    size_t m_num_block_candidates{0};
+    size_t m_next_block_candidate_ix{0};
 };
 }  // namespace clp::streaming_archive::reader
 
@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -123,6 +124,7 @@ void Archive::open(UserConfig const& user_config) {
     m_target_segment_uncompressed_size = user_config.target_segment_uncompressed_size;
     m_next_segment_id = 0;
     m_compression_level = user_config.compression_level;
+    m_compression_worker_options = user_config.compression_worker_options;
 
     /// TODO: add schema file size to m_stable_size???
     // Copy schema file into archive
@@ -158,6 +160,7 @@ void Archive::open(UserConfig const& user_config) {
     }
 
     m_global_metadata_db = user_config.global_metadata_db;
+    m_global_metadata_db_mutex = user_config.global_metadata_db_mutex;
 
     m_file = nullptr;
 
@@ -238,6 +241,7 @@ void Archive::close() {
 
     update_global_metadata();
     m_global_metadata_db = nullptr;
+    m_global_metadata_db_mutex = nullptr;
 
     for (auto* file : m_file_metadata_for_global_update) {
         delete file;
@@ -569,7 +573,12 @@ void Archive::append_file_contents_to_segment(
         vector<File*>& files_in_segment
 ) {
     if (!segment.is_open()) {
-        segment.open(m_segments_dir_path, m_next_segment_id++, m_compression_level);
+        segment.open(
+                m_segments_dir_path,
+                m_next_segment_id++,
+                m_compression_level,
+                m_compression_worker_options
+        );
     }
 
     m_file->append_to_segment(m_logtype_dict, segment);
@@ -705,7 +714,10 @@ auto Archive::print_archive_stats_progress() -> void {
     json_msg["id"] = m_id_as_string;
     json_msg["uncompressed_size"] = m_local_metadata->get_uncompressed_size_bytes();
     json_msg["size"] = m_local_metadata->get_compressed_size_bytes();
-    std::cout << json_msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::ignore) << std::endl;
+    // Write each message with a single insertion so that messages from archives written by
+    // concurrent threads don't interleave.
+    std::cout << (json_msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::ignore) + '\n')
+              << std::flush;
 }
 
 void Archive::update_local_metadata() {
@@ -717,6 +729,10 @@ void Archive::update_local_metadata() {
 }
 
 auto Archive::update_global_metadata() -> void {
+    std::unique_lock<std::mutex> global_metadata_db_lock;
+    if (nullptr != m_global_metadata_db_mutex) {
+        global_metadata_db_lock = std::unique_lock{*m_global_metadata_db_mutex};
+    }
     m_global_metadata_db->open();
     if (false == m_local_metadata.has_value()) {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
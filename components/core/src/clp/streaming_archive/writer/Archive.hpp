@@ -3,6 +3,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -19,6 +20,7 @@
 #include "../../GlobalMetadataDB.hpp"
 #include "../../ir/LogEvent.hpp"
 #include "../../LogTypeDictionaryWriter.hpp"
+#include "../../streaming_compression/zstd/Compressor.hpp"
 #include "../../VariableDictionaryWriter.hpp"
 #include "../ArchiveMetadata.hpp"
 #include "../MetadataDB.hpp"
@@ -36,6 +38,8 @@ public:
      * @param compression_level Compression level of the compressor being opened
      * @param output_dir Output directory
      * @param global_metadata_db
+     * @param global_metadata_db_mutex Mutex to hold while updating `global_metadata_db`, for when
+     * it's shared by archives written from multiple threads (nullptr otherwise)
      * @param print_archive_stats_progress Enable printing statistics about the archive as it's
      * compressed
      */
@@ -45,8 +49,10 @@ public:
         size_t creation_num;
         size_t target_segment_uncompressed_size;
         int compression_level;
+        streaming_compression::zstd::WorkerOptions compression_worker_options;
         std::string output_dir;
         GlobalMetadataDB* global_metadata_db;
+        std::mutex* global_metadata_db_mutex{nullptr};
         bool print_archive_stats_progress;
     };
 
@@ -355,6 +361,7 @@ private:
             m_var_ids_in_segment_for_files_without_timestamps;
 
     int m_compression_level;
+    streaming_compression::zstd::WorkerOptions m_compression_worker_options;
 
     MetadataDB m_metadata_db;
 
@@ -362,6 +369,7 @@ private:
     FileWriter m_metadata_file_writer;
 
     GlobalMetadataDB* m_global_metadata_db;
+    std::mutex* m_global_metadata_db_mutex{nullptr};
 
     bool m_print_archive_stats_progress;
 };
@@ -44,10 +44,16 @@ public:
      * @param segments_dir_path
      * @param id
      * @param compression_level
+     * @param worker_options Multi-threading options for the segment's compressor
      * @throw streaming_archive::writer::Segment::OperationFailed if segment wasn't closed
      * before this call
      */
-    void open(std::string const& segments_dir_path, segment_id_t id, int compression_level);
+    void open(
+            std::string const& segments_dir_path,
+            segment_id_t id,
+            int compression_level,
+            streaming_compression::zstd::WorkerOptions const& worker_options = {}
+    );
     /**
      * Closes the segment
      * @throw streaming_archive::writer::Segment::OperationFailed if compression fails
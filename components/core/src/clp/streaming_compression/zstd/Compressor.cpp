@@ -1,6 +1,8 @@
 #include "Compressor.hpp"
 
+#include <array>
 #include <cstddef>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 #include <zstd.h>
@@ -42,6 +44,8 @@ auto Compressor::open(WriterInterface& writer, int compression_level) -> void {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
     }
 
+    apply_worker_options();
+
     m_compressed_stream_writer = &writer;
 
     m_uncompressed_stream_pos = 0;
@@ -103,21 +107,29 @@ auto Compressor::flush() -> void {
         return;
     }
 
-    m_compressed_stream_block.pos = 0;
-    auto const end_stream_result{ZSTD_endStream(m_compression_stream, &m_compressed_stream_block)};
-    if (0 != ZSTD_isError(end_stream_result)) {
-        // Note: Output buffer is large enough that it is guaranteed to have enough room to be
-        // able to flush the entire buffer, so this can only be an error
-        SPDLOG_ERROR(
-                "streaming_compression::zstd::Compressor: ZSTD_endStream() error: {}",
-                ZSTD_getErrorName(end_stream_result)
-        );
-        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    // With multiple workers, ending the frame may take several calls to drain all pending jobs
+    while (true) {
+        m_compressed_stream_block.pos = 0;
+        auto const end_stream_result{
+                ZSTD_endStream(m_compression_stream, &m_compressed_stream_block)
+        };
+        if (0 != ZSTD_isError(end_stream_result)) {
+            SPDLOG_ERROR(
+                    "streaming_compression::zstd::Compressor: ZSTD_endStream() error: {}",
+                    ZSTD_getErrorName(end_stream_result)
+            );
+            throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+        }
+        if (m_compressed_stream_block.pos > 0) {
+            m_compressed_stream_writer->write(
+                    static_cast<char const*>(m_compressed_stream_block.dst),
+                    m_compressed_stream_block.pos
+            );
+        }
+        if (0 == end_stream_result) {
+            break;
+        }
     }
-    m_compressed_stream_writer->write(
-            static_cast<char const*>(m_compressed_stream_block.dst),
-            m_compressed_stream_block.pos
-    );
 
     m_compression_stream_contains_data = false;
 }
@@ -157,4 +169,27 @@ auto Compressor::flush_without_ending_frame() -> void {
         }
     }
 }
+
+auto Compressor::apply_worker_options() -> void {
+    // Parameters persist across sessions, so they're always set to undo any previous options
+    std::array<std::pair<ZSTD_cParameter, int>, 3> const parameters{{
+            {ZSTD_c_nbWorkers, m_worker_options.num_workers},
+            {ZSTD_c_jobSize, static_cast<int>(m_worker_options.job_size)},
+            {ZSTD_c_enableLongDistanceMatching,
+             m_worker_options.enable_long_distance_matching ? 1 : 0},
+    }};
+    for (auto const& [parameter, value] : parameters) {
+        auto const result{ZSTD_CCtx_setParameter(m_compression_stream, parameter, value)};
+        if (0 != ZSTD_isError(result)) {
+            SPDLOG_ERROR(
+                    "streaming_compression::zstd::Compressor: ZSTD_CCtx_setParameter({}, {}) "
+                    "error: {}",
+                    static_cast<int>(parameter),
+                    value,
+                    ZSTD_getErrorName(result)
+            );
+            throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+        }
+    }
+}
 }  // namespace clp::streaming_compression::zstd
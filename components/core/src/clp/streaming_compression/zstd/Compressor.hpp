@@ -13,6 +13,21 @@
 #include "Constants.hpp"
 
 namespace clp::streaming_compression::zstd {
+/**
+ * Options for zstd's multi-threaded compression. zstd splits the stream into jobs that are
+ * compressed in parallel, so it only pays off for streams of several MiB or more.
+ */
+struct WorkerOptions {
+    // Number of worker threads. 0 compresses synchronously on the calling thread.
+    int num_workers{0};
+    // Size (B) of each job handed to a worker. 0 lets zstd pick a size based on the compression
+    // level.
+    size_t job_size{0};
+    // Whether to use long-distance matching, which helps with repetitions far apart in large
+    // streams at the cost of memory.
+    bool enable_long_distance_matching{false};
+};
+
 class Compressor : public ::clp::streaming_compression::Compressor {
 public:
     // Types
@@ -85,12 +100,28 @@ public:
      */
     auto open(WriterInterface& writer, int compression_level) -> void;
 
+    /**
+     * Sets the multi-threading options used by subsequent calls to `open`.
+     * @param worker_options
+     */
+    auto set_worker_options(WorkerOptions const& worker_options) -> void {
+        m_worker_options = worker_options;
+    }
+
     /**
      * Flushes the stream without ending the current frame
      */
     auto flush_without_ending_frame() -> void;
 
 private:
+    // Methods
+    /**
+     * Applies the multi-threading options to the compression stream.
+     * @throw OperationFailed if zstd rejects the options, e.g. because it was built without
+     * multi-threading support.
+     */
+    auto apply_worker_options() -> void;
+
     // Variables
     WriterInterface* m_compressed_stream_writer{nullptr};
 
@@ -102,6 +133,8 @@ private:
     ZSTD_outBuffer m_compressed_stream_block;
 
     size_t m_uncompressed_stream_pos{0};
+
+    WorkerOptions m_worker_options;
 };
 }  // namespace clp::streaming_compression::zstd
 
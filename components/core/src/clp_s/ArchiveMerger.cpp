@@ -0,0 +1,352 @@
+#include "ArchiveMerger.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "archive_constants.hpp"
+#include "ArchiveReader.hpp"
+#include "ArchiveWriter.hpp"
+#include "ColumnReader.hpp"
+#include "ErrorCode.hpp"
+#include "InputConfig.hpp"
+#include "ParsedMessage.hpp"
+#include "SchemaReader.hpp"
+#include "SchemaTree.hpp"
+#include "TimestampDictionaryReader.hpp"
+
+namespace clp_s {
+namespace {
+/**
+ * The position of the next log event to append from an input table.
+ */
+struct TableCursor {
+    size_t table_idx{};
+    uint64_t message_idx{};
+    int64_t log_event_idx{};
+};
+
+struct LaterLogEventIdx {
+    auto operator()(TableCursor const& lhs, TableCursor const& rhs) const -> bool {
+        return lhs.log_event_idx > rhs.log_event_idx;
+    }
+};
+}  // namespace
+
+ArchiveMerger::ArchiveMerger(ArchiveMergerOption option) : m_option{std::move(option)} {
+    m_archive_options.archives_dir = m_option.archives_dir;
+    m_archive_options.compression_level = m_option.compression_level;
+    m_archive_options.print_archive_stats = m_option.print_archive_stats;
+    m_archive_options.single_file_archive = m_option.single_file_archive;
+    m_archive_options.min_table_size = m_option.min_table_size;
+    m_archive_options.zstd_dictionaries = m_option.zstd_dictionaries;
+    m_archive_options.zstd_worker_options = m_option.zstd_worker_options;
+}
+
+auto ArchiveMerger::merge() -> std::vector<ArchiveStats> {
+    auto const& archive_paths{m_option.archive_paths};
+    if (archive_paths.empty()) {
+        return {};
+    }
+
+    m_archive_options.id = m_generator();
+    m_archive_writer = std::make_unique<ArchiveWriter>();
+    m_archive_writer->open(m_archive_options);
+
+    auto const read_archive_async = [this](Path const& archive_path) {
+        return std::async(std::launch::async, [this, &archive_path]() {
+            return read_archive(archive_path);
+        });
+    };
+
+    // Read the next input archive while the current one is appended to the output archive.
+    auto next_input{read_archive_async(archive_paths.front())};
+    for (size_t i{0}; i < archive_paths.size(); ++i) {
+        auto input{next_input.get()};
+        bool const has_next_input{i + 1 < archive_paths.size()};
+        if (has_next_input) {
+            next_input = read_archive_async(archive_paths[i + 1]);
+        }
+
+        append_archive(input);
+        input.tables.clear();
+        input.reader->close();
+
+        if (has_next_input && m_archive_writer->get_data_size() >= m_option.target_encoded_size) {
+            split_archive();
+        }
+    }
+
+    m_archive_stats.emplace_back(m_archive_writer->close());
+    return std::move(m_archive_stats);
+}
+
+auto ArchiveMerger::read_archive(Path const& archive_path) const -> InputArchive {
+    InputArchive input{.reader = std::make_shared<ArchiveReader>()};
+    auto& reader{*input.reader};
+    reader.set_zstd_dictionary_registry(m_option.zstd_dictionaries);
+    reader.open(archive_path, m_option.network_auth);
+    if (reader.has_deprecated_timestamp_format()) {
+        SPDLOG_ERROR(
+                "Can't merge archive \"{}\" since it uses the deprecated timestamp format.",
+                archive_path.path
+        );
+        throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+    }
+    if (false == reader.has_log_order()) {
+        SPDLOG_ERROR(
+                "Can't merge archive \"{}\" since it doesn't record log order.",
+                archive_path.path
+        );
+        throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+    }
+
+    reader.read_dictionaries_and_metadata();
+    reader.open_packed_streams();
+    auto const& schema_ids{reader.get_schema_ids()};
+    input.tables.reserve(schema_ids.size());
+    for (auto const schema_id : schema_ids) {
+        input.tables.emplace_back(reader.read_table(schema_id, false, false));
+    }
+    return input;
+}
+
+auto ArchiveMerger::append_archive(InputArchive const& input) -> void {
+    auto const node_ids{add_schema_tree(input)};
+
+    auto const timestamp_dict{input.reader->get_timestamp_dictionary()};
+    std::vector<std::string> timestamp_keys(node_ids.size());
+    for (auto it{timestamp_dict->tokenized_column_to_range_begin()};
+         timestamp_dict->tokenized_column_to_range_end() != it;
+         ++it)
+    {
+        auto const* timestamp_entry{it->second};
+        for (auto const column_id : timestamp_entry->get_column_ids()) {
+            timestamp_keys.at(column_id) = timestamp_entry->get_key_name();
+        }
+    }
+
+    std::vector<TableTranslation> translations;
+    translations.reserve(input.tables.size());
+    std::priority_queue<TableCursor, std::vector<TableCursor>, LaterLogEventIdx> cursors;
+    auto const get_log_event_idx = [&](size_t table_idx, uint64_t message_idx) -> int64_t {
+        auto* column{input.tables[table_idx]
+                             ->get_columns()
+                             .at(translations[table_idx].log_event_idx_column)};
+        return std::get<int64_t>(column->extract_value(message_idx));
+    };
+    for (size_t table_idx{0}; table_idx < input.tables.size(); ++table_idx) {
+        translations.emplace_back(translate_table(input, *input.tables[table_idx], node_ids));
+        if (input.tables[table_idx]->get_num_messages() > 0) {
+            cursors.push({table_idx, 0, get_log_event_idx(table_idx, 0)});
+        }
+    }
+
+    // Every table stores its log events in log order, so the tables are merged to write the input's
+    // log events in log order.
+    auto const append_messages_before = [&](size_t end_log_event_idx) {
+        while (false == cursors.empty()
+               && static_cast<size_t>(cursors.top().log_event_idx) < end_log_event_idx)
+        {
+            auto cursor{cursors.top()};
+            cursors.pop();
+            auto const& table{*input.tables[cursor.table_idx]};
+            append_message(
+                    table,
+                    translations[cursor.table_idx],
+                    cursor.message_idx,
+                    *timestamp_dict,
+                    timestamp_keys
+            );
+            if (++cursor.message_idx < table.get_num_messages()) {
+                cursor.log_event_idx = get_log_event_idx(cursor.table_idx, cursor.message_idx);
+                cursors.push(cursor);
+            }
+        }
+    };
+
+    for (auto const& range : input.reader->get_range_index()) {
+        append_messages_before(range.start_index);
+        if (range.fields.empty()) {
+            continue;
+        }
+        for (auto const& [key, value] : range.fields.items()) {
+            if (auto const rc = m_archive_writer->add_field_to_current_range(key, value);
+                ErrorCodeSuccess != rc)
+            {
+                SPDLOG_ERROR(
+                        "Failed to add metadata field \"{}\" ({})",
+                        key,
+                        static_cast<int64_t>(rc)
+                );
+                throw OperationFailed(rc, __FILENAME__, __LINE__);
+            }
+        }
+        append_messages_before(range.end_index);
+        if (auto const rc = m_archive_writer->close_current_range(); ErrorCodeSuccess != rc) {
+            SPDLOG_ERROR("Failed to close metadata range: {}", static_cast<int64_t>(rc));
+            throw OperationFailed(rc, __FILENAME__, __LINE__);
+        }
+    }
+    append_messages_before(std::numeric_limits<size_t>::max());
+
+    m_archive_writer->increment_uncompressed_size(input.reader->get_header().uncompressed_size);
+}
+
+auto ArchiveMerger::add_schema_tree(InputArchive const& input) -> std::vector<int32_t> {
+    auto const& nodes{input.reader->get_schema_tree()->get_nodes()};
+    std::vector<int32_t> node_ids(nodes.size(), constants::cRootNodeId);
+    // Nodes are always added after their parents, so every parent is remapped before its children.
+    for (auto const& node : nodes) {
+        auto const parent_id{node.get_parent_id()};
+        auto const output_parent_id{
+                constants::cRootNodeId == parent_id ? constants::cRootNodeId
+                                                    : node_ids.at(parent_id)
+        };
+        node_ids.at(node.get_id()) = m_archive_writer->add_node(
+                output_parent_id,
+                node.get_type(),
+                node.get_key_name()
+        );
+    }
+    return node_ids;
+}
+
+auto ArchiveMerger::translate_table(
+        InputArchive const& input,
+        SchemaReader const& table,
+        std::vector<int32_t> const& node_ids
+) -> TableTranslation {
+    auto const& input_schema{input.reader->get_schema_map()->at(table.get_schema_id())};
+    TableTranslation translation;
+    for (size_t i{0}; i < input_schema.size(); ++i) {
+        auto const schema_entry{input_schema[i]};
+        if (i < input_schema.get_num_ordered()) {
+            translation.schema.insert_ordered(node_ids.at(schema_entry));
+        } else if (Schema::schema_entry_is_unordered_object(schema_entry)) {
+            // Unordered objects are tagged with their type and length rather than a node ID.
+            translation.schema.insert_unordered(schema_entry);
+        } else {
+            translation.schema.insert_unordered(node_ids.at(schema_entry));
+        }
+    }
+    translation.schema_id = m_archive_writer->add_schema(translation.schema);
+
+    auto const log_event_idx_node_id{
+            input.reader->get_schema_tree()->get_metadata_field_id(constants::cLogEventIdxName)
+    };
+    auto const& columns{table.get_columns()};
+    translation.log_event_idx_column = columns.size();
+    for (size_t i{0}; i < columns.size(); ++i) {
+        auto const column_id{columns[i]->get_id()};
+        if (log_event_idx_node_id == column_id) {
+            translation.log_event_idx_column = i;
+        }
+        translation.column_node_ids.push_back(node_ids.at(column_id));
+    }
+    if (columns.size() == translation.log_event_idx_column) {
+        SPDLOG_ERROR("Table {} doesn't record log order.", table.get_schema_id());
+        throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+    }
+    translation.num_ordered_columns = table.get_num_ordered_columns();
+    return translation;
+}
+
+auto ArchiveMerger::append_message(
+        SchemaReader const& table,
+        TableTranslation const& translation,
+        uint64_t message_idx,
+        TimestampDictionaryReader const& timestamp_dict,
+        std::vector<std::string> const& timestamp_keys
+) -> void {
+    m_message.clear();
+    auto const& columns{table.get_columns()};
+    for (size_t i{0}; i < columns.size(); ++i) {
+        auto* column{columns[i]};
+        auto const node_id{translation.column_node_ids[i]};
+        ParsedMessage::variable_t value;
+        if (translation.log_event_idx_column == i) {
+            // Log events are renumbered in the order they're appended to the output archive.
+            value = m_archive_writer->get_next_log_event_id();
+        } else {
+            switch (column->get_type()) {
+                case NodeType::Integer:
+                case NodeType::DeltaInteger:
+                    value = std::get<int64_t>(column->extract_value(message_idx));
+                    break;
+                case NodeType::Float:
+                    value = std::get<double>(column->extract_value(message_idx));
+                    break;
+                case NodeType::FormattedFloat:
+                    value = std::make_pair(
+                            std::get<double>(column->extract_value(message_idx)),
+                            static_cast<FormattedFloatColumnReader*>(column)->get_format(
+                                    message_idx
+                            )
+                    );
+                    break;
+                case NodeType::Boolean:
+                    value = 0 != std::get<uint8_t>(column->extract_value(message_idx));
+                    break;
+                case NodeType::DictionaryFloat:
+                case NodeType::ClpString:
+                case NodeType::VarString:
+                case NodeType::UnstructuredArray:
+                    // The output archive's dictionaries are built from the decoded strings, since
+                    // dictionary IDs and encoded variables are only meaningful in the input.
+                    m_string_buffer.clear();
+                    column->extract_string_value_into_buffer(message_idx, m_string_buffer);
+                    value = m_string_buffer;
+                    break;
+                case NodeType::Timestamp: {
+                    auto* timestamp_column{static_cast<TimestampColumnReader*>(column)};
+                    value = m_archive_writer->ingest_parsed_timestamp(
+                            timestamp_keys.at(column->get_id()),
+                            node_id,
+                            timestamp_column->get_encoded_time(message_idx),
+                            timestamp_dict.get_timestamp_pattern(
+                                    timestamp_column->get_timestamp_encoding(message_idx)
+                            )
+                    );
+                    break;
+                }
+                case NodeType::DeprecatedDateString:
+                case NodeType::Metadata:
+                case NodeType::NullValue:
+                case NodeType::Object:
+                case NodeType::StructuredArray:
+                case NodeType::Unknown:
+                default:
+                    SPDLOG_ERROR(
+                            "Can't merge column {} in table {}.",
+                            column->get_id(),
+                            table.get_schema_id()
+                    );
+                    throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+            }
+        }
+
+        if (i < translation.num_ordered_columns) {
+            m_message.add_value(node_id, value);
+        } else {
+            m_message.add_unordered_value(value);
+        }
+    }
+    m_archive_writer->append_message(translation.schema_id, translation.schema, m_message);
+}
+
+auto ArchiveMerger::split_archive() -> void {
+    m_archive_stats.emplace_back(m_archive_writer->close(true));
+    m_archive_options.id = m_generator();
+    m_archive_writer->open(m_archive_options);
+}
+}  // namespace clp_s
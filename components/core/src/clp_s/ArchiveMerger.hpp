@@ -0,0 +1,165 @@
+#ifndef CLP_S_ARCHIVEMERGER_HPP
+#define CLP_S_ARCHIVEMERGER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/uuid/random_generator.hpp>
+
+#include "ArchiveReader.hpp"
+#include "ArchiveWriter.hpp"
+#include "InputConfig.hpp"
+#include "ParsedMessage.hpp"
+#include "Schema.hpp"
+#include "SchemaReader.hpp"
+#include "TimestampDictionaryReader.hpp"
+#include "TraceableException.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDictionaryRegistry.hpp"
+
+namespace clp_s {
+struct ArchiveMergerOption {
+    std::vector<Path> archive_paths;
+    NetworkAuthOption network_auth{};
+    std::string archives_dir;
+    size_t target_encoded_size{};
+    size_t min_table_size{};
+    int compression_level{};
+    bool print_archive_stats{};
+    bool single_file_archive{false};
+    std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries;
+    ZstdWorkerOptions zstd_worker_options;
+};
+
+/**
+ * Merges many small archives into fewer, larger archives.
+ *
+ * Each input archive's schema tree is added to the output archive's schema tree, and every column
+ * value is copied into the output archive's tables through the remapped node IDs, so that tables
+ * with the same schema across inputs are concatenated and the dictionaries are deduplicated. Log
+ * events are written in log order, so each input's range index entries are carried over with their
+ * log event indices offset by the number of log events written before them.
+ *
+ * Only one input archive is decoded at a time while the next one is read on a separate thread, so
+ * memory use is bounded by the size of two input archives plus the output archive being written.
+ * The output archive is split once its encoded size reaches the target size after an input archive
+ * is appended.
+ */
+class ArchiveMerger {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    explicit ArchiveMerger(ArchiveMergerOption option);
+
+    // Methods
+    /**
+     * Merges the input archives.
+     * @return Statistics for every archive that was written.
+     * @throw OperationFailed if an input archive can't be merged, e.g., because it doesn't record
+     * log order or uses the deprecated timestamp format.
+     * @throw clp_s::TraceableException if reading or writing an archive fails.
+     */
+    [[nodiscard]] auto merge() -> std::vector<ArchiveStats>;
+
+private:
+    // Types
+    /**
+     * An input archive with every table read into memory.
+     */
+    struct InputArchive {
+        std::shared_ptr<ArchiveReader> reader;
+        std::vector<std::shared_ptr<SchemaReader>> tables;
+    };
+
+    /**
+     * How a table's columns are copied into the output archive.
+     */
+    struct TableTranslation {
+        int32_t schema_id{};
+        Schema schema;
+        // The output node ID of each column, in the order of `SchemaReader::get_columns`
+        std::vector<int32_t> column_node_ids;
+        size_t num_ordered_columns{};
+        size_t log_event_idx_column{};
+    };
+
+    // Methods
+    /**
+     * Opens an input archive and reads all of its tables.
+     * @param archive_path
+     * @return The input archive.
+     * @throw OperationFailed if the archive can't be merged.
+     */
+    [[nodiscard]] auto read_archive(Path const& archive_path) const -> InputArchive;
+
+    /**
+     * Appends every log event in an input archive to the output archive, in log order.
+     * @param input
+     * @throw OperationFailed if a range index entry can't be added to the output archive.
+     */
+    auto append_archive(InputArchive const& input) -> void;
+
+    /**
+     * Adds an input archive's schema tree to the output archive's schema tree.
+     * @param input
+     * @return The output node ID of each input node ID.
+     */
+    [[nodiscard]] auto add_schema_tree(InputArchive const& input) -> std::vector<int32_t>;
+
+    /**
+     * @param input
+     * @param table
+     * @param node_ids The output node ID of each input node ID.
+     * @return How `table`'s columns are copied into the output archive.
+     * @throw OperationFailed if the table doesn't record log order.
+     */
+    [[nodiscard]] auto translate_table(
+            InputArchive const& input,
+            SchemaReader const& table,
+            std::vector<int32_t> const& node_ids
+    ) -> TableTranslation;
+
+    /**
+     * Appends a log event from an input table to the output archive.
+     * @param table
+     * @param translation
+     * @param message_idx
+     * @param timestamp_dict The input archive's timestamp dictionary.
+     * @param timestamp_keys The timestamp dictionary key of each input timestamp column.
+     * @throw OperationFailed if the table contains a column that can't be merged.
+     */
+    auto append_message(
+            SchemaReader const& table,
+            TableTranslation const& translation,
+            uint64_t message_idx,
+            TimestampDictionaryReader const& timestamp_dict,
+            std::vector<std::string> const& timestamp_keys
+    ) -> void;
+
+    /**
+     * Closes the current output archive and opens a new one.
+     */
+    auto split_archive() -> void;
+
+    // Variables
+    ArchiveMergerOption m_option;
+    boost::uuids::random_generator m_generator;
+    ArchiveWriterOption m_archive_options{};
+    std::unique_ptr<ArchiveWriter> m_archive_writer;
+    ParsedMessage m_message;
+    std::string m_string_buffer;
+    std::vector<ArchiveStats> m_archive_stats;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ARCHIVEMERGER_HPP
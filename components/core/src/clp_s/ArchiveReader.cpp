@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <system_error>
 #include <utility>
 #include <vector>
@@ -15,6 +16,7 @@
 #include <clp/type_utils.hpp>
 #include <clp_s/archive_constants.hpp>
 #include <clp_s/ArchiveReaderAdaptor.hpp>
+#include <clp_s/ArrowRecordBatch.hpp>
 #include <clp_s/DictionaryEntry.hpp>
 #include <clp_s/ErrorCode.hpp>
 #include <clp_s/InputConfig.hpp>
@@ -55,6 +57,7 @@ auto ArchiveReader::open(
 }
 
 auto ArchiveReader::initialize_archive_reader() -> void {
+    m_archive_reader_adaptor->set_zstd_dictionary_registry(m_zstd_dictionaries);
     if (auto const rc = m_archive_reader_adaptor->load_archive_metadata(); ErrorCodeSuccess != rc) {
         throw OperationFailed(rc, __FILENAME__, __LINE__);
     }
@@ -121,6 +124,9 @@ auto ArchiveReader::read_metadata() -> ystdlib::error_handling::Result<void> {
     auto table_metadata_reader = m_archive_reader_adaptor->checkout_reader_for_section(
             constants::cArchiveTableMetadataFile
     );
+    m_table_metadata_decompressor.set_dictionary(
+            m_archive_reader_adaptor->get_zstd_dictionary(constants::cArchiveTableMetadataFile)
+    );
     m_table_metadata_decompressor.open(*table_metadata_reader, cDecompressorFileReadBufferCapacity);
 
     YSTDLIB_ERROR_HANDLING_TRYV(m_stream_reader.read_metadata(m_table_metadata_decompressor));
@@ -225,20 +231,37 @@ SchemaReader& ArchiveReader::read_schema_table(
     return m_schema_reader;
 }
 
+std::shared_ptr<SchemaReader> ArchiveReader::read_table(
+        int32_t schema_id,
+        bool should_extract_timestamp,
+        bool should_marshal_records
+) {
+    if (m_id_to_schema_metadata.count(schema_id) == 0) {
+        throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+    }
+
+    auto schema_reader = std::make_shared<SchemaReader>();
+    initialize_schema_reader(
+            *schema_reader,
+            schema_id,
+            should_extract_timestamp,
+            should_marshal_records
+    );
+    auto const& schema_metadata = m_id_to_schema_metadata[schema_id];
+    auto stream_buffer = read_stream(schema_metadata.stream_id(), false);
+    schema_reader->load(
+            stream_buffer,
+            schema_metadata.stream_offset(),
+            schema_metadata.uncompressed_size()
+    );
+    return schema_reader;
+}
+
 std::vector<std::shared_ptr<SchemaReader>> ArchiveReader::read_all_tables() {
     std::vector<std::shared_ptr<SchemaReader>> readers;
     readers.reserve(m_id_to_schema_metadata.size());
     for (auto schema_id : m_schema_ids) {
-        auto schema_reader = std::make_shared<SchemaReader>();
-        initialize_schema_reader(*schema_reader, schema_id, true, true);
-        auto const& schema_metadata = m_id_to_schema_metadata[schema_id];
-        auto stream_buffer = read_stream(schema_metadata.stream_id(), false);
-        schema_reader->load(
-                stream_buffer,
-                schema_metadata.stream_offset(),
-                schema_metadata.uncompressed_size()
-        );
-        readers.push_back(std::move(schema_reader));
+        readers.push_back(read_table(schema_id, true, true));
     }
     return readers;
 }
@@ -421,12 +444,39 @@ void ArchiveReader::initialize_schema_reader(
 }
 
 void ArchiveReader::store(FileWriter& writer) {
-    std::string message;
+    std::string messages;
+    for (auto schema_id : m_schema_ids) {
+        auto& schema_reader = read_schema_table(schema_id, false, true);
+        while (schema_reader.get_next_messages(messages, SchemaReader::cDefaultTargetBatchSize) > 0)
+        {
+            writer.write(messages.c_str(), messages.length());
+            messages.clear();
+        }
+    }
+}
+
+void ArchiveReader::store_record_batches(FileWriter& writer) {
+    ArrowRecordBatchBuilder builder;
+    std::string buffer;
     for (auto schema_id : m_schema_ids) {
         auto& schema_reader = read_schema_table(schema_id, false, true);
-        while (schema_reader.get_next_message(message)) {
-            writer.write(message.c_str(), message.length());
+        builder.clear();
+        schema_reader.initialize_record_batch_builder(builder);
+        builder.serialize_schema(buffer);
+        while (schema_reader.get_next_record_batch_rows(
+                       builder,
+                       ArrowRecordBatchBuilder::cDefaultTargetBatchSize
+               )
+               > 0)
+        {
+            builder.serialize_record_batch(buffer);
+            builder.clear_rows();
+            writer.write(buffer.c_str(), buffer.length());
+            buffer.clear();
         }
+        ArrowRecordBatchBuilder::serialize_end_of_stream(buffer);
+        writer.write(buffer.c_str(), buffer.length());
+        buffer.clear();
     }
 }
 
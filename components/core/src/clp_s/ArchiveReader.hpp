@@ -23,6 +23,7 @@
 #include <clp_s/search/Projection.hpp>
 #include <clp_s/SingleFileArchiveDefs.hpp>
 #include <clp_s/TimestampDictionaryReader.hpp>
+#include <clp_s/ZstdDictionaryRegistry.hpp>
 
 namespace clp_s {
 class ArchiveReader {
@@ -54,6 +55,16 @@ public:
             std::string_view archive_id
     ) -> void;
 
+    /**
+     * Sets the registry to load trained zstd dictionaries from when opening archives compressed
+     * with them. Must be called before `open`.
+     * @param zstd_dictionaries
+     */
+    auto set_zstd_dictionary_registry(std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries)
+            -> void {
+        m_zstd_dictionaries = std::move(zstd_dictionaries);
+    }
+
     /**
      * Reads the dictionaries and metadata.
      * @throws OperationFailed if reading or decompressing metadata fails.
@@ -119,6 +130,20 @@ public:
             bool should_marshal_records
     );
 
+    /**
+     * Reads a table from the archive into a new SchemaReader that owns its stream buffer, so that
+     * it remains valid as other tables are read.
+     * @param schema_id
+     * @param should_extract_timestamp
+     * @param should_marshal_records
+     * @return the schema reader
+     */
+    std::shared_ptr<SchemaReader> read_table(
+            int32_t schema_id,
+            bool should_extract_timestamp,
+            bool should_marshal_records
+    );
+
     /**
      * Loads all of the tables in the archive and returns SchemaReaders for them.
      * @return the schema readers for every table in the archive
@@ -149,12 +174,25 @@ public:
         return m_archive_reader_adaptor->get_header();
     }
 
+    [[nodiscard]] auto get_row_group_timestamp_index() const
+            -> RowGroupTimestampIndexPacket const& {
+        return m_archive_reader_adaptor->get_row_group_timestamp_index();
+    }
+
     /**
      * Writes decoded messages to a file.
      * @param writer
      */
     void store(FileWriter& writer);
 
+    /**
+     * Writes decoded messages to a file as Arrow record batches, with one Arrow IPC stream per
+     * table.
+     * @param writer
+     * @throw SchemaReader::OperationFailed if a table contains structured arrays.
+     */
+    void store_record_batches(FileWriter& writer);
+
     /**
      * Closes the archive.
      */
@@ -277,6 +315,7 @@ private:
     std::shared_ptr<LogTypeDictionaryReader> m_log_dict;
     std::shared_ptr<LogTypeDictionaryReader> m_array_dict;
     std::shared_ptr<ArchiveReaderAdaptor> m_archive_reader_adaptor;
+    std::shared_ptr<ZstdDictionaryRegistry> m_zstd_dictionaries;
 
     std::shared_ptr<SchemaTree> m_schema_tree;
     std::shared_ptr<ReaderUtils::SchemaMap> m_schema_map;
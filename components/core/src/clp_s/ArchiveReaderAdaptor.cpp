@@ -7,6 +7,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -24,6 +25,10 @@
 #include "ReaderUtils.hpp"
 #include "SingleFileArchiveDefs.hpp"
 
+#if CLP_BUILD_CLP_S_ENABLE_CURL
+    #include "../clp/NetworkRangeReader.hpp"
+#endif
+
 namespace clp_s {
 ArchiveReaderAdaptor::ArchiveReaderAdaptor(
         Path const& archive_path,
@@ -120,6 +125,54 @@ ErrorCode ArchiveReaderAdaptor::try_read_archive_info(ZstdDecompressor& decompre
     return ErrorCodeSuccess;
 }
 
+auto ArchiveReaderAdaptor::try_read_zstd_dictionaries(ZstdDecompressor& decompressor, size_t size)
+        -> ErrorCode {
+    std::vector<char> buffer(size);
+    if (auto const rc = decompressor.try_read_exact_length(buffer.data(), buffer.size());
+        ErrorCodeSuccess != rc)
+    {
+        return rc;
+    }
+
+    try {
+        auto obj_handle = msgpack::unpack(buffer.data(), buffer.size());
+        auto obj = obj_handle.get();
+        auto const zstd_dictionaries{obj.as<ZstdDictionariesPacket>()};
+        m_zstd_dictionary_ids.clear();
+        m_zstd_dictionary_ids.insert(
+                zstd_dictionaries.dictionary_ids.begin(),
+                zstd_dictionaries.dictionary_ids.end()
+        );
+    } catch (std::exception const& e) {
+        return ErrorCodeCorrupt;
+    }
+    return ErrorCodeSuccess;
+}
+
+auto ArchiveReaderAdaptor::try_read_row_group_timestamp_index(
+        ZstdDecompressor& decompressor,
+        size_t size
+) -> ErrorCode {
+    std::vector<char> buffer(size);
+    if (auto const rc = decompressor.try_read_exact_length(buffer.data(), buffer.size());
+        ErrorCodeSuccess != rc)
+    {
+        return rc;
+    }
+
+    try {
+        auto obj_handle = msgpack::unpack(buffer.data(), buffer.size());
+        auto obj = obj_handle.get();
+        m_row_group_timestamp_index = obj.as<RowGroupTimestampIndexPacket>();
+    } catch (std::exception const& e) {
+        return ErrorCodeCorrupt;
+    }
+    if (0 == m_row_group_timestamp_index.row_group_size) {
+        return ErrorCodeCorrupt;
+    }
+    return ErrorCodeSuccess;
+}
+
 auto ArchiveReaderAdaptor::try_read_range_index(ZstdDecompressor& decompressor, size_t size)
         -> ErrorCode {
     std::vector<char> buffer(size);
@@ -262,6 +315,12 @@ ErrorCode ArchiveReaderAdaptor::try_read_archive_metadata(ZstdDecompressor& deco
             case ArchiveMetadataPacketType::RangeIndex:
                 rc = try_read_range_index(decompressor, packet_size);
                 break;
+            case ArchiveMetadataPacketType::ZstdDictionaries:
+                rc = try_read_zstd_dictionaries(decompressor, packet_size);
+                break;
+            case ArchiveMetadataPacketType::RowGroupTimestampIndex:
+                rc = try_read_row_group_timestamp_index(decompressor, packet_size);
+                break;
             default:
                 rc = try_read_unknown_metadata_packet(decompressor, packet_size);
                 break;
@@ -288,7 +347,7 @@ std::shared_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::try_create_reader_at
             return nullptr;
         }
     } else {
-        return try_create_reader(m_archive_path, m_network_auth);
+        return try_create_random_access_reader(m_archive_path, m_network_auth);
     }
 }
 
@@ -351,9 +410,30 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
         }
     }
 
+    // The tables section is usually only partially read, so its streams are prefetched
+    // individually by `PackedStreamReader` instead.
+    if (constants::cArchiveTablesFile != section) {
+        prefetch(file_offset, next_file_offset);
+    }
+
     return std::make_unique<clp::BoundedReader>(m_reader.get(), next_file_offset);
 }
 
+auto ArchiveReaderAdaptor::prefetch(
+        [[maybe_unused]] size_t begin_offset,
+        [[maybe_unused]] size_t end_offset
+) -> void {
+#if CLP_BUILD_CLP_S_ENABLE_CURL
+    auto* range_reader{dynamic_cast<clp::NetworkRangeReader*>(m_reader.get())};
+    if (nullptr == range_reader) {
+        return;
+    }
+    // Prefetching is only an optimization, so any failure is left to be reported by the reads that
+    // follow.
+    std::ignore = range_reader->prefetch({{begin_offset, end_offset}});
+#endif
+}
+
 void ArchiveReaderAdaptor::checkin_reader_for_section(std::string_view section) {
     if (false == m_current_reader_holder.has_value()) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
@@ -374,4 +454,21 @@ auto ArchiveReaderAdaptor::get_metadata_for_log_event(int64_t log_event_idx)
     }
     return it->second;
 }
+
+auto ArchiveReaderAdaptor::get_zstd_dictionary(std::string_view section) -> ZSTD_DDict const* {
+    auto const it{m_zstd_dictionary_ids.find(section)};
+    if (m_zstd_dictionary_ids.end() == it) {
+        return nullptr;
+    }
+    if (nullptr == m_zstd_dictionaries) {
+        SPDLOG_ERROR(
+                "Archive section \"{}\" was compressed with zstd dictionary {} but no dictionary "
+                "registry was provided.",
+                section,
+                it->second
+        );
+        throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
+    }
+    return m_zstd_dictionaries->get_decompression_dictionary(it->second);
+}
 }  // namespace clp_s
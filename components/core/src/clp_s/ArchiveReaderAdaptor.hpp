@@ -2,6 +2,9 @@
 #define CLP_S_ARCHIVEREADERADAPTOR_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -23,6 +26,7 @@
 #include "TimestampDictionaryReader.hpp"
 #include "TraceableException.hpp"
 #include "ZstdDecompressor.hpp"
+#include "ZstdDictionaryRegistry.hpp"
 
 namespace clp_s {
 /**
@@ -93,6 +97,15 @@ public:
      */
     void checkin_reader_for_section(std::string_view section);
 
+    /**
+     * Hints that the given byte range of a single-file archive will be read soon. If the archive is
+     * read using HTTP range requests, the range is downloaded now (in parallel), otherwise this is
+     * a no-op.
+     * @param begin_offset
+     * @param end_offset
+     */
+    auto prefetch(size_t begin_offset, size_t end_offset) -> void;
+
     std::shared_ptr<TimestampDictionaryReader> get_timestamp_dictionary() {
         return m_timestamp_dictionary;
     }
@@ -108,6 +121,35 @@ public:
      */
     [[nodiscard]] auto get_metadata_for_log_event(int64_t log_event_idx) -> nlohmann::json const&;
 
+    /**
+     * Sets the registry to load the trained zstd dictionaries this archive was compressed with
+     * from.
+     * @param zstd_dictionaries
+     */
+    auto set_zstd_dictionary_registry(std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries)
+            -> void {
+        m_zstd_dictionaries = std::move(zstd_dictionaries);
+    }
+
+    /**
+     * @param section
+     * @return The trained zstd dictionary the given section was compressed with, or nullptr if the
+     * section was compressed without a dictionary.
+     * @throw OperationFailed if the section was compressed with a dictionary but no dictionary
+     * registry was set.
+     * @throw ZstdDictionaryRegistry::OperationFailed if the dictionary can't be loaded.
+     */
+    [[nodiscard]] auto get_zstd_dictionary(std::string_view section) -> ZSTD_DDict const*;
+
+    /**
+     * @return The timestamp range of every row group in the archive's sorted tables, or an empty
+     * index if the archive's tables weren't sorted.
+     */
+    [[nodiscard]] auto get_row_group_timestamp_index() const
+            -> RowGroupTimestampIndexPacket const& {
+        return m_row_group_timestamp_index;
+    }
+
 private:
     /**
      * Tries to read an ArchiveFileInfo packet from the archive metadata.
@@ -144,6 +186,23 @@ private:
      */
     auto try_read_range_index(ZstdDecompressor& decompressor, size_t size) -> ErrorCode;
 
+    /**
+     * Tries to read a ZstdDictionaries packet from the archive metadata.
+     * @param decompressor
+     * @param size The number of decompressed bytes making up the packet.
+     * @return ErrorCodeSuccess on success or the relevant ErrorCode on failure.
+     */
+    auto try_read_zstd_dictionaries(ZstdDecompressor& decompressor, size_t size) -> ErrorCode;
+
+    /**
+     * Tries to read a RowGroupTimestampIndex packet from the archive metadata.
+     * @param decompressor
+     * @param size The number of decompressed bytes making up the packet.
+     * @return ErrorCodeSuccess on success or the relevant ErrorCode on failure.
+     */
+    auto try_read_row_group_timestamp_index(ZstdDecompressor& decompressor, size_t size)
+            -> ErrorCode;
+
     /**
      * Tries to read an unknown metadata packet from the archive metadata.
      * @param decompressor
@@ -196,6 +255,9 @@ private:
     std::shared_ptr<clp::ReaderInterface> m_reader;
     std::vector<RangeIndexEntry> m_range_index;
     std::map<int64_t, nlohmann::json> m_non_empty_range_metadata_map;
+    std::map<std::string, uint32_t, std::less<>> m_zstd_dictionary_ids;
+    std::shared_ptr<ZstdDictionaryRegistry> m_zstd_dictionaries;
+    RowGroupTimestampIndexPacket m_row_group_timestamp_index{};
 };
 }  // namespace clp_s
 #endif  // CLP_S_ARCHIVEREADERADAPTOR_HPP
@@ -6,7 +6,9 @@
 #include <filesystem>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -27,6 +29,10 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
     m_archives_dir = option.archives_dir;
     m_authoritative_timestamp = option.authoritative_timestamp;
     m_authoritative_timestamp_namespace = option.authoritative_timestamp_namespace;
+    m_sort_key = option.sort_key;
+    m_sort_key_namespace = option.sort_key_namespace;
+    m_zstd_dictionaries = option.zstd_dictionaries;
+    m_tables_compressor.set_worker_options(option.zstd_worker_options);
     std::string working_dir_name = m_id;
     if (option.single_file_archive) {
         working_dir_name += constants::cTmpPostfix;
@@ -52,15 +58,30 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
 
     std::string var_dict_path = m_archive_path + constants::cArchiveVarDictFile;
     m_var_dict = std::make_shared<VariableDictionaryWriter>();
-    m_var_dict->open(var_dict_path, m_compression_level, UINT64_MAX);
+    m_var_dict->open(
+            var_dict_path,
+            m_compression_level,
+            UINT64_MAX,
+            get_zstd_dictionary(constants::cArchiveVarDictFile)
+    );
 
     std::string log_dict_path = m_archive_path + constants::cArchiveLogDictFile;
     m_log_dict = std::make_shared<LogTypeDictionaryWriter>();
-    m_log_dict->open(log_dict_path, m_compression_level, UINT64_MAX);
+    m_log_dict->open(
+            log_dict_path,
+            m_compression_level,
+            UINT64_MAX,
+            get_zstd_dictionary(constants::cArchiveLogDictFile)
+    );
 
     std::string array_dict_path = m_archive_path + constants::cArchiveArrayDictFile;
     m_array_dict = std::make_shared<LogTypeDictionaryWriter>();
-    m_array_dict->open(array_dict_path, m_compression_level, UINT64_MAX);
+    m_array_dict->open(
+            array_dict_path,
+            m_compression_level,
+            UINT64_MAX,
+            get_zstd_dictionary(constants::cArchiveArrayDictFile)
+    );
 }
 
 auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
@@ -72,8 +93,16 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
     auto var_dict_compressed_size = m_var_dict->close();
     auto log_dict_compressed_size = m_log_dict->close();
     auto array_dict_compressed_size = m_array_dict->close();
-    auto schema_tree_compressed_size = m_schema_tree.store(m_archive_path, m_compression_level);
-    auto schema_map_compressed_size = m_schema_map.store(m_archive_path, m_compression_level);
+    auto schema_tree_compressed_size = m_schema_tree.store(
+            m_archive_path,
+            m_compression_level,
+            get_zstd_dictionary(constants::cArchiveSchemaTreeFile)
+    );
+    auto schema_map_compressed_size = m_schema_map.store(
+            m_archive_path,
+            m_compression_level,
+            get_zstd_dictionary(constants::cArchiveSchemaMapFile)
+    );
     auto [table_metadata_compressed_size, table_compressed_size] = store_tables();
 
     std::vector<ArchiveFileInfo> files{
@@ -137,11 +166,30 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
     m_next_log_event_id = 0;
     m_authoritative_timestamp.clear();
     m_authoritative_timestamp_namespace.clear();
+    m_zstd_dictionary_ids.clear();
     m_matched_timestamp_prefix_length = 0ULL;
     m_matched_timestamp_prefix_node_id = constants::cRootNodeId;
+    m_sort_key.clear();
+    m_sort_key_namespace.clear();
+    m_row_group_timestamp_bounds.clear();
     return archive_stats;
 }
 
+auto ArchiveWriter::get_zstd_dictionary(std::string_view section) -> ZSTD_CDict const* {
+    if (nullptr == m_zstd_dictionaries) {
+        return nullptr;
+    }
+    auto const dictionary_id{m_zstd_dictionaries->get_dictionary_id(section)};
+    if (false == dictionary_id.has_value()) {
+        return nullptr;
+    }
+    auto const* dictionary{
+            m_zstd_dictionaries->get_compression_dictionary(*dictionary_id, m_compression_level)
+    };
+    m_zstd_dictionary_ids.insert_or_assign(std::string{section}, *dictionary_id);
+    return dictionary;
+}
+
 auto ArchiveWriter::write_single_file_archive(std::vector<ArchiveFileInfo> const& files)
         -> nlohmann::json {
     std::string single_file_archive_path = (std::filesystem::path(m_archives_dir) / m_id).string();
@@ -175,6 +223,12 @@ auto ArchiveWriter::write_archive_metadata(
     if (false == m_range_index_writer.empty()) {
         ++num_optional_packets;
     }
+    if (false == m_zstd_dictionary_ids.empty()) {
+        ++num_optional_packets;
+    }
+    if (false == m_row_group_timestamp_bounds.empty()) {
+        ++num_optional_packets;
+    }
     uint8_t const num_constant_packets{3U};
     compressor.write_numeric_value<uint8_t>(num_constant_packets + num_optional_packets);
 
@@ -203,6 +257,31 @@ auto ArchiveWriter::write_archive_metadata(
     compressor.write_numeric_value(static_cast<uint32_t>(encoded_timestamp_dict.size()));
     compressor.write(encoded_timestamp_dict.data(), encoded_timestamp_dict.size());
 
+    // Write the IDs of the zstd dictionaries used to compress the archive's sections
+    if (false == m_zstd_dictionary_ids.empty()) {
+        ZstdDictionariesPacket zstd_dictionaries{.dictionary_ids{m_zstd_dictionary_ids}};
+        msgpack_buffer = std::stringstream{};
+        msgpack::pack(msgpack_buffer, zstd_dictionaries);
+        std::string zstd_dictionaries_str = msgpack_buffer.str();
+        compressor.write_numeric_value(ArchiveMetadataPacketType::ZstdDictionaries);
+        compressor.write_numeric_value(static_cast<uint32_t>(zstd_dictionaries_str.size()));
+        compressor.write_string(zstd_dictionaries_str);
+    }
+
+    // Write the timestamp range of every row group in the sorted tables
+    if (false == m_row_group_timestamp_bounds.empty()) {
+        RowGroupTimestampIndexPacket row_group_timestamp_index{
+                .row_group_size = cRowGroupSize,
+                .timestamp_bounds{m_row_group_timestamp_bounds}
+        };
+        msgpack_buffer = std::stringstream{};
+        msgpack::pack(msgpack_buffer, row_group_timestamp_index);
+        std::string row_group_timestamp_index_str = msgpack_buffer.str();
+        compressor.write_numeric_value(ArchiveMetadataPacketType::RowGroupTimestampIndex);
+        compressor.write_numeric_value(static_cast<uint32_t>(row_group_timestamp_index_str.size()));
+        compressor.write_string(row_group_timestamp_index_str);
+    }
+
     // Write range index
     nlohmann::json archive_range_index;
     if (auto rc = m_range_index_writer.write(compressor, archive_range_index);
@@ -302,10 +381,15 @@ size_t ArchiveWriter::get_data_size() {
 }
 
 void ArchiveWriter::initialize_schema_writer(SchemaWriter* writer, Schema const& schema) {
+    bool const sort_records{false == m_sort_key.empty()};
+    bool found_timestamp_column{false};
+    size_t schema_idx{0};
     for (int32_t id : schema) {
+        bool const is_ordered{schema_idx++ < schema.get_num_ordered()};
         if (Schema::schema_entry_is_unordered_object(id)) {
             continue;
         }
+        auto const column_idx{writer->get_num_columns()};
         auto const& node = m_schema_tree.get_node(id);
         switch (node.get_type()) {
             case NodeType::Integer:
@@ -350,9 +434,46 @@ void ArchiveWriter::initialize_schema_writer(SchemaWriter* writer, Schema const&
             case NodeType::Unknown:
                 break;
         }
+
+        // Only the ordered columns hold one value per message that can be sorted and indexed.
+        if (false == sort_records || false == is_ordered
+            || column_idx == writer->get_num_columns())
+        {
+            continue;
+        }
+        if (NodeType::Timestamp == node.get_type() && false == found_timestamp_column) {
+            writer->set_timestamp_column(column_idx);
+            found_timestamp_column = true;
+        }
+        if (is_sort_key_node(id)) {
+            writer->set_sort_column(column_idx, node.get_type());
+        }
     }
 }
 
+auto ArchiveWriter::is_sort_key_node(int32_t node_id) const -> bool {
+    auto cur_node_id{node_id};
+    for (auto it{m_sort_key.crbegin()}; m_sort_key.crend() != it; ++it) {
+        if (constants::cRootNodeId == cur_node_id) {
+            return false;
+        }
+        auto const& node{m_schema_tree.get_node(cur_node_id)};
+        if (node.get_key_name() != *it
+            || (m_sort_key.crbegin() != it && NodeType::Object != node.get_type()))
+        {
+            return false;
+        }
+        cur_node_id = node.get_parent_id();
+    }
+    if (m_sort_key.empty() || constants::cRootNodeId == cur_node_id) {
+        return false;
+    }
+    auto const& namespace_node{m_schema_tree.get_node(cur_node_id)};
+    return NodeType::Object == namespace_node.get_type()
+           && constants::cRootNodeId == namespace_node.get_parent_id()
+           && namespace_node.get_key_name() == m_sort_key_namespace;
+}
+
 std::pair<size_t, size_t> ArchiveWriter::store_tables() {
     m_tables_file_writer.open(
             m_archive_path + constants::cArchiveTablesFile,
@@ -362,7 +483,11 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
             m_archive_path + constants::cArchiveTableMetadataFile,
             FileWriter::OpenMode::CreateForWriting
     );
-    m_table_metadata_compressor.open(m_table_metadata_file_writer, m_compression_level);
+    m_table_metadata_compressor.open(
+            m_table_metadata_file_writer,
+            m_compression_level,
+            get_zstd_dictionary(constants::cArchiveTableMetadataFile)
+    );
 
     /**
      * Packed stream metadata schema
@@ -418,8 +543,14 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
     uint64_t current_stream_offset{0};
     uint64_t current_stream_id{0};
     uint64_t current_table_file_offset{0};
-    m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+    auto const* tables_zstd_dictionary{get_zstd_dictionary(constants::cArchiveTablesFile)};
+    m_tables_compressor.open(m_tables_file_writer, m_compression_level, tables_zstd_dictionary);
     for (auto it : schemas) {
+        it->second->sort_messages();
+        auto row_group_timestamp_bounds{it->second->get_row_group_timestamp_bounds(cRowGroupSize)};
+        if (false == row_group_timestamp_bounds.empty()) {
+            m_row_group_timestamp_bounds.emplace(it->first, std::move(row_group_timestamp_bounds));
+        }
         it->second->store(m_tables_compressor);
         schema_metadata.emplace_back(
                 current_stream_id,
@@ -437,7 +568,11 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
             current_table_file_offset = m_tables_file_writer.get_pos();
 
             if (schemas.size() != schema_metadata.size()) {
-                m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+                m_tables_compressor.open(
+                        m_tables_file_writer,
+                        m_compression_level,
+                        tables_zstd_dictionary
+                );
             }
         }
     }
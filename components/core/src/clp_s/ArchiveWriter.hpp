@@ -2,6 +2,7 @@
 #define CLP_S_ARCHIVEWRITER_HPP
 
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -23,7 +24,10 @@
 #include <clp_s/SchemaTree.hpp>
 #include <clp_s/SchemaWriter.hpp>
 #include <clp_s/SingleFileArchiveDefs.hpp>
+#include <clp_s/timestamp_parser/TimestampParser.hpp>
 #include <clp_s/TimestampDictionaryWriter.hpp>
+#include <clp_s/ZstdCompressor.hpp>
+#include <clp_s/ZstdDictionaryRegistry.hpp>
 
 namespace clp_s {
 struct ArchiveWriterOption {
@@ -35,6 +39,13 @@ struct ArchiveWriterOption {
     size_t min_table_size;
     std::vector<std::string> authoritative_timestamp;
     std::string authoritative_timestamp_namespace;
+    // Key to sort the records in each schema table by, or empty to keep them in ingestion order
+    std::vector<std::string> sort_key;
+    std::string sort_key_namespace;
+    // Trained zstd dictionaries to compress archive sections with, if any
+    std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries;
+    // Multi-threading options for compressing schema tables, which dominate an archive's size
+    ZstdWorkerOptions zstd_worker_options;
 };
 
 class ArchiveStats {
@@ -103,6 +114,10 @@ private:
 
 class ArchiveWriter {
 public:
+    // Constants
+    // Number of consecutive records in a sorted table whose timestamp range is indexed together
+    static constexpr uint64_t cRowGroupSize{4096};
+
     class OperationFailed : public TraceableException {
     public:
         // Constructors
@@ -241,6 +256,23 @@ public:
         return m_timestamp_dict.ingest_unknown_precision_epoch_timestamp(key, node_id, timestamp);
     }
 
+    /**
+     * Ingests a timestamp that has already been parsed with a known pattern.
+     * @param key
+     * @param node_id
+     * @param timestamp
+     * @param pattern
+     * @return Forwards `TimestampDictionaryWriter::ingest_parsed_timestamp`'s return values.
+     */
+    [[nodiscard]] auto ingest_parsed_timestamp(
+            std::string_view key,
+            int32_t node_id,
+            epochtime_t timestamp,
+            timestamp_parser::TimestampPattern const& pattern
+    ) -> std::pair<epochtime_t, uint64_t> {
+        return m_timestamp_dict.ingest_parsed_timestamp(key, node_id, timestamp, pattern);
+    }
+
     /**
      * Increments the size of the original (uncompressed) logs ingested into the archive. This size
      * tracks the raw input size before any encoding or compression.
@@ -296,6 +328,12 @@ private:
      */
     void initialize_schema_writer(SchemaWriter* writer, Schema const& schema);
 
+    /**
+     * @param node_id
+     * @return Whether the node is the leaf of the path described by the sort key.
+     */
+    [[nodiscard]] auto is_sort_key_node(int32_t node_id) const -> bool;
+
     /**
      * Compresses and stores the tables.
      * @return A pair containing:
@@ -304,6 +342,14 @@ private:
      */
     [[nodiscard]] std::pair<size_t, size_t> store_tables();
 
+    /**
+     * Gets the trained zstd dictionary to compress the given archive section with, recording its ID
+     * in the archive's metadata.
+     * @param section
+     * @return The dictionary, or nullptr if the section should be compressed without one.
+     */
+    [[nodiscard]] auto get_zstd_dictionary(std::string_view section) -> ZSTD_CDict const*;
+
     /**
      * Writes the archive to a single file
      * @param files
@@ -357,12 +403,18 @@ private:
     bool m_print_archive_stats{};
     bool m_single_file_archive{};
     size_t m_min_table_size{};
+    std::shared_ptr<ZstdDictionaryRegistry> m_zstd_dictionaries;
+    std::map<std::string, uint32_t> m_zstd_dictionary_ids;
 
     std::vector<std::string> m_authoritative_timestamp;
     std::string m_authoritative_timestamp_namespace;
     size_t m_matched_timestamp_prefix_length{0ULL};
     int32_t m_matched_timestamp_prefix_node_id{constants::cRootNodeId};
 
+    std::vector<std::string> m_sort_key;
+    std::string m_sort_key_namespace;
+    std::map<int32_t, std::vector<epochtime_t>> m_row_group_timestamp_bounds;
+
     SchemaMap m_schema_map;
     SchemaTree m_schema_tree;
 
@@ -0,0 +1,500 @@
+#include "ArrowRecordBatch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ErrorCode.hpp"
+
+// Values are copied into Arrow buffers as-is, and the IPC schema declares them as little-endian.
+static_assert(std::endian::little == std::endian::native);
+
+namespace clp_s {
+namespace {
+// Arrow IPC constants from Schema.fbs and Message.fbs
+constexpr uint32_t cContinuationMarker{0xFFFF'FFFF};
+constexpr int16_t cMetadataVersionV5{4};
+constexpr uint8_t cMessageHeaderSchema{1};
+constexpr uint8_t cMessageHeaderRecordBatch{3};
+constexpr uint8_t cTypeNull{1};
+constexpr uint8_t cTypeInt{2};
+constexpr uint8_t cTypeFloatingPoint{3};
+constexpr uint8_t cTypeUtf8{5};
+constexpr uint8_t cTypeBool{6};
+constexpr uint8_t cTypeTimestamp{10};
+constexpr uint8_t cTypeStruct{13};
+constexpr int16_t cPrecisionDouble{2};
+constexpr int16_t cTimeUnitNanosecond{3};
+constexpr int16_t cEndiannessLittle{0};
+constexpr std::string_view cTimezoneUtc{"UTC"};
+
+// Buffers in the body of a record batch must be aligned to 8 bytes
+constexpr size_t cBodyAlignment{8};
+
+/**
+ * Minimal flatbuffers builder for encoding Arrow IPC metadata.
+ *
+ * Like the official builder, the buffer is built back to front so that every object is finished
+ * before the objects that refer to it. Objects are identified by their distance from the end of the
+ * buffer, which doesn't change as more objects are prepended.
+ */
+class FlatBufferBuilder {
+public:
+    // Types
+    using Offset = uint32_t;
+
+    // Methods
+    auto create_string(std::string_view value) -> Offset {
+        pre_align(value.size() + 1, sizeof(uint32_t));
+        pad(1);
+        push_bytes(value.data(), value.size());
+        push_scalar(static_cast<uint32_t>(value.size()));
+        return m_size;
+    }
+
+    auto create_offset_vector(std::span<Offset const> offsets) -> Offset {
+        pre_align(offsets.size() * sizeof(uint32_t), sizeof(uint32_t));
+        for (auto it{offsets.rbegin()}; offsets.rend() != it; ++it) {
+            push_offset(*it);
+        }
+        push_scalar(static_cast<uint32_t>(offsets.size()));
+        return m_size;
+    }
+
+    /**
+     * Creates a vector of structs that each contain two int64 fields, which is the layout of both
+     * `FieldNode` and `Buffer`.
+     * @param pairs
+     * @return The vector's offset.
+     */
+    auto create_int64_pair_vector(std::span<std::pair<int64_t, int64_t> const> pairs) -> Offset {
+        pre_align(pairs.size() * 2 * sizeof(int64_t), sizeof(int64_t));
+        for (auto it{pairs.rbegin()}; pairs.rend() != it; ++it) {
+            push_scalar(it->second);
+            push_scalar(it->first);
+        }
+        push_scalar(static_cast<uint32_t>(pairs.size()));
+        return m_size;
+    }
+
+    auto start_table() -> void {
+        m_fields.clear();
+        m_table_start = m_size;
+    }
+
+    template <typename T>
+    auto add_field(uint16_t field_id, T value) -> void {
+        align(sizeof(T));
+        push_scalar(value);
+        m_fields.emplace_back(field_id, m_size);
+    }
+
+    auto add_offset_field(uint16_t field_id, Offset offset) -> void {
+        push_offset(offset);
+        m_fields.emplace_back(field_id, m_size);
+    }
+
+    auto end_table() -> Offset {
+        // Placeholder for the offset to the vtable
+        align(sizeof(int32_t));
+        push_scalar(int32_t{0});
+        auto const table_offset{m_size};
+
+        uint16_t num_vtable_entries{0};
+        for (auto const& [field_id, field_offset] : m_fields) {
+            num_vtable_entries = std::max(num_vtable_entries, static_cast<uint16_t>(field_id + 1));
+        }
+        std::vector<uint16_t> vtable_entries(num_vtable_entries, 0);
+        for (auto const& [field_id, field_offset] : m_fields) {
+            vtable_entries[field_id] = static_cast<uint16_t>(table_offset - field_offset);
+        }
+        for (auto it{vtable_entries.rbegin()}; vtable_entries.rend() != it; ++it) {
+            push_scalar(*it);
+        }
+        push_scalar(static_cast<uint16_t>(table_offset - m_table_start));
+        push_scalar(static_cast<uint16_t>((2 + num_vtable_entries) * sizeof(uint16_t)));
+        auto const vtable_offset{m_size};
+
+        auto const vtable_distance{static_cast<int32_t>(vtable_offset - table_offset)};
+        std::memcpy(
+                m_buffer.data() + m_buffer.size() - table_offset,
+                &vtable_distance,
+                sizeof(vtable_distance)
+        );
+        return table_offset;
+    }
+
+    /**
+     * Finishes the buffer with the given root table.
+     * @param root
+     * @return A view of the finished buffer.
+     */
+    auto finish(Offset root) -> std::string_view {
+        pre_align(sizeof(uint32_t), m_min_alignment);
+        push_offset(root);
+        return {reinterpret_cast<char const*>(head()), m_size};
+    }
+
+private:
+    // Methods
+    [[nodiscard]] auto head() -> uint8_t* { return m_buffer.data() + m_buffer.size() - m_size; }
+
+    auto reserve(size_t num_bytes) -> void {
+        if (m_buffer.size() - m_size >= num_bytes) {
+            return;
+        }
+        constexpr size_t cMinCapacity{1024};
+        std::vector<uint8_t> buffer(
+                std::max({m_buffer.size() * 2, m_size + num_bytes, cMinCapacity})
+        );
+        std::memcpy(buffer.data() + buffer.size() - m_size, head(), m_size);
+        m_buffer = std::move(buffer);
+    }
+
+    auto pad(size_t num_bytes) -> void {
+        reserve(num_bytes);
+        m_size += num_bytes;
+        std::memset(head(), 0, num_bytes);
+    }
+
+    /**
+     * Pads the buffer so that it will be aligned to `alignment` after `num_bytes` are prepended.
+     * @param num_bytes
+     * @param alignment
+     */
+    auto pre_align(size_t num_bytes, size_t alignment) -> void {
+        m_min_alignment = std::max(m_min_alignment, alignment);
+        pad((~(m_size + num_bytes) + 1) & (alignment - 1));
+    }
+
+    auto align(size_t alignment) -> void { pre_align(0, alignment); }
+
+    auto push_bytes(void const* bytes, size_t num_bytes) -> void {
+        reserve(num_bytes);
+        m_size += num_bytes;
+        std::memcpy(head(), bytes, num_bytes);
+    }
+
+    template <typename T>
+    auto push_scalar(T value) -> void {
+        push_bytes(&value, sizeof(T));
+    }
+
+    auto push_offset(Offset offset) -> void {
+        align(sizeof(uint32_t));
+        push_scalar(static_cast<uint32_t>(m_size + sizeof(uint32_t) - offset));
+    }
+
+    // Variables
+    std::vector<uint8_t> m_buffer;
+    size_t m_size{0};
+    size_t m_min_alignment{1};
+    size_t m_table_start{0};
+    std::vector<std::pair<uint16_t, size_t>> m_fields;
+};
+
+/**
+ * @param size
+ * @return The number of padding bytes needed to align `size` to `cBodyAlignment`.
+ */
+auto get_body_padding(size_t size) -> size_t;
+
+/**
+ * Appends an encapsulated IPC message to the given buffer.
+ * @param builder A builder containing the finished message header.
+ * @param header_type
+ * @param header
+ * @param body_length
+ * @param buffer
+ */
+auto append_message(
+        FlatBufferBuilder& builder,
+        uint8_t header_type,
+        FlatBufferBuilder::Offset header,
+        int64_t body_length,
+        std::string& buffer
+) -> void;
+
+auto get_body_padding(size_t size) -> size_t {
+    return (cBodyAlignment - size % cBodyAlignment) % cBodyAlignment;
+}
+
+auto append_message(
+        FlatBufferBuilder& builder,
+        uint8_t header_type,
+        FlatBufferBuilder::Offset header,
+        int64_t body_length,
+        std::string& buffer
+) -> void {
+    builder.start_table();
+    builder.add_field(3, body_length);
+    builder.add_offset_field(2, header);
+    builder.add_field(0, cMetadataVersionV5);
+    builder.add_field(1, header_type);
+    auto const metadata{builder.finish(builder.end_table())};
+
+    // The metadata is padded so that the body that follows it is aligned
+    auto const padding{get_body_padding(sizeof(cContinuationMarker) + sizeof(int32_t)
+                                        + metadata.size())};
+    auto const metadata_length{static_cast<int32_t>(metadata.size() + padding)};
+    buffer.append(
+            reinterpret_cast<char const*>(&cContinuationMarker),
+            sizeof(cContinuationMarker)
+    );
+    buffer.append(reinterpret_cast<char const*>(&metadata_length), sizeof(metadata_length));
+    buffer.append(metadata);
+    buffer.append(padding, '\0');
+}
+}  // namespace
+
+auto ArrowRecordBatchBuilder::add_column(
+        std::string_view name,
+        ArrowType type,
+        int32_t parent_column_id
+) -> int32_t {
+    if (m_num_rows > 0
+        || (-1 != parent_column_id && ArrowType::Struct != m_columns[parent_column_id].type))
+    {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+
+    auto const column_id{static_cast<int32_t>(m_columns.size())};
+    auto& column{m_columns.emplace_back()};
+    column.name = name;
+    column.type = type;
+    if (ArrowType::Utf8 == type) {
+        column.offsets.push_back(0);
+    }
+    if (-1 == parent_column_id) {
+        m_top_level_columns.push_back(column_id);
+    } else {
+        m_columns[parent_column_id].children.push_back(column_id);
+    }
+    return column_id;
+}
+
+auto ArrowRecordBatchBuilder::append_bool(int32_t column_id, bool value) -> void {
+    auto& data{m_columns[column_id].data};
+    auto const byte_idx{static_cast<size_t>(m_num_rows / 8)};
+    if (data.size() <= byte_idx) {
+        data.push_back('\0');
+        ++m_buffered_size;
+    }
+    if (value) {
+        data[byte_idx] = static_cast<char>(data[byte_idx] | (1 << (m_num_rows % 8)));
+    }
+}
+
+auto ArrowRecordBatchBuilder::finish_utf8_value(int32_t column_id) -> void {
+    auto& column{m_columns[column_id]};
+    if (column.data.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+    }
+    auto const offset{static_cast<int32_t>(column.data.size())};
+    m_buffered_size += static_cast<size_t>(offset - column.offsets.back()) + sizeof(int32_t);
+    column.offsets.push_back(offset);
+}
+
+auto ArrowRecordBatchBuilder::clear_rows() -> void {
+    for (auto& column : m_columns) {
+        column.data.clear();
+        if (ArrowType::Utf8 == column.type) {
+            column.offsets.resize(1);
+        }
+    }
+    m_num_rows = 0;
+    m_buffered_size = 0;
+}
+
+auto ArrowRecordBatchBuilder::serialize_schema(std::string& buffer) const -> void {
+    FlatBufferBuilder builder;
+
+    // Children must be finished before their parents, so fields are created depth first
+    auto create_field = [&](auto const& create_child_field, int32_t column_id)
+            -> FlatBufferBuilder::Offset {
+        auto const& column{m_columns[column_id]};
+        std::vector<FlatBufferBuilder::Offset> children;
+        children.reserve(column.children.size());
+        for (auto const child_id : column.children) {
+            children.push_back(create_child_field(create_child_field, child_id));
+        }
+        auto const children_vector{builder.create_offset_vector(children)};
+        auto const name{builder.create_string(column.name)};
+
+        uint8_t type_type{};
+        FlatBufferBuilder::Offset type{};
+        switch (column.type) {
+            case ArrowType::Null:
+                type_type = cTypeNull;
+                builder.start_table();
+                type = builder.end_table();
+                break;
+            case ArrowType::Int64:
+                type_type = cTypeInt;
+                builder.start_table();
+                builder.add_field(0, int32_t{64});
+                builder.add_field(1, uint8_t{1});
+                type = builder.end_table();
+                break;
+            case ArrowType::Float64:
+                type_type = cTypeFloatingPoint;
+                builder.start_table();
+                builder.add_field(0, cPrecisionDouble);
+                type = builder.end_table();
+                break;
+            case ArrowType::Bool:
+                type_type = cTypeBool;
+                builder.start_table();
+                type = builder.end_table();
+                break;
+            case ArrowType::Utf8:
+                type_type = cTypeUtf8;
+                builder.start_table();
+                type = builder.end_table();
+                break;
+            case ArrowType::Timestamp: {
+                type_type = cTypeTimestamp;
+                auto const timezone{builder.create_string(cTimezoneUtc)};
+                builder.start_table();
+                builder.add_offset_field(1, timezone);
+                builder.add_field(0, cTimeUnitNanosecond);
+                type = builder.end_table();
+                break;
+            }
+            case ArrowType::Struct:
+                type_type = cTypeStruct;
+                builder.start_table();
+                type = builder.end_table();
+                break;
+        }
+
+        builder.start_table();
+        builder.add_offset_field(0, name);
+        builder.add_offset_field(3, type);
+        builder.add_offset_field(5, children_vector);
+        builder.add_field(1, uint8_t{1});
+        builder.add_field(2, type_type);
+        return builder.end_table();
+    };
+
+    std::vector<FlatBufferBuilder::Offset> fields;
+    fields.reserve(m_top_level_columns.size());
+    for (auto const column_id : m_top_level_columns) {
+        fields.push_back(create_field(create_field, column_id));
+    }
+    auto const fields_vector{builder.create_offset_vector(fields)};
+
+    builder.start_table();
+    builder.add_offset_field(1, fields_vector);
+    builder.add_field(0, cEndiannessLittle);
+    auto const schema{builder.end_table()};
+    append_message(builder, cMessageHeaderSchema, schema, 0, buffer);
+}
+
+auto ArrowRecordBatchBuilder::serialize_record_batch(std::string& buffer) const -> void {
+    // Nodes and buffers are listed in a depth-first traversal of the schema
+    std::vector<int32_t> ordered_column_ids;
+    ordered_column_ids.reserve(m_columns.size());
+    std::vector<int32_t> column_id_stack{m_top_level_columns.rbegin(), m_top_level_columns.rend()};
+    while (false == column_id_stack.empty()) {
+        auto const column_id{column_id_stack.back()};
+        column_id_stack.pop_back();
+        ordered_column_ids.push_back(column_id);
+        auto const& children{m_columns[column_id].children};
+        column_id_stack.insert(column_id_stack.end(), children.rbegin(), children.rend());
+    }
+
+    auto const num_rows{static_cast<size_t>(m_num_rows)};
+    std::vector<std::pair<int64_t, int64_t>> nodes;
+    std::vector<std::pair<int64_t, int64_t>> buffers;
+    std::vector<std::string_view> body_buffers;
+    nodes.reserve(ordered_column_ids.size());
+    int64_t body_length{0};
+    auto add_buffer = [&](std::string_view data) {
+        buffers.emplace_back(body_length, static_cast<int64_t>(data.size()));
+        body_buffers.push_back(data);
+        body_length += static_cast<int64_t>(data.size() + get_body_padding(data.size()));
+    };
+    for (auto const column_id : ordered_column_ids) {
+        auto const& column{m_columns[column_id]};
+        size_t expected_data_size{0};
+        switch (column.type) {
+            case ArrowType::Int64:
+            case ArrowType::Timestamp:
+                expected_data_size = num_rows * sizeof(int64_t);
+                break;
+            case ArrowType::Float64:
+                expected_data_size = num_rows * sizeof(double);
+                break;
+            case ArrowType::Bool:
+                expected_data_size = (num_rows + 7) / 8;
+                break;
+            case ArrowType::Utf8:
+                expected_data_size = static_cast<size_t>(column.offsets.back());
+                if (num_rows + 1 != column.offsets.size()) {
+                    throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+                }
+                break;
+            case ArrowType::Null:
+            case ArrowType::Struct:
+                break;
+        }
+        if (expected_data_size != column.data.size()) {
+            throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+        }
+
+        nodes.emplace_back(m_num_rows, ArrowType::Null == column.type ? m_num_rows : 0);
+        if (ArrowType::Null == column.type) {
+            continue;
+        }
+        // No values are null, so the validity bitmap can be omitted
+        add_buffer({});
+        if (ArrowType::Struct == column.type) {
+            continue;
+        }
+        if (ArrowType::Utf8 == column.type) {
+            add_buffer(
+                    {reinterpret_cast<char const*>(column.offsets.data()),
+                     column.offsets.size() * sizeof(int32_t)}
+            );
+        }
+        add_buffer(column.data);
+    }
+
+    FlatBufferBuilder builder;
+    auto const buffers_vector{builder.create_int64_pair_vector(buffers)};
+    auto const nodes_vector{builder.create_int64_pair_vector(nodes)};
+    builder.start_table();
+    builder.add_field(0, m_num_rows);
+    builder.add_offset_field(1, nodes_vector);
+    builder.add_offset_field(2, buffers_vector);
+    auto const record_batch{builder.end_table()};
+    append_message(builder, cMessageHeaderRecordBatch, record_batch, body_length, buffer);
+
+    buffer.reserve(buffer.size() + static_cast<size_t>(body_length));
+    for (auto const body_buffer : body_buffers) {
+        buffer.append(body_buffer);
+        buffer.append(get_body_padding(body_buffer.size()), '\0');
+    }
+}
+
+auto ArrowRecordBatchBuilder::serialize_end_of_stream(std::string& buffer) -> void {
+    constexpr int32_t cEndOfStreamMetadataLength{0};
+    buffer.append(
+            reinterpret_cast<char const*>(&cContinuationMarker),
+            sizeof(cContinuationMarker)
+    );
+    buffer.append(
+            reinterpret_cast<char const*>(&cEndOfStreamMetadataLength),
+            sizeof(cEndOfStreamMetadataLength)
+    );
+}
+}  // namespace clp_s
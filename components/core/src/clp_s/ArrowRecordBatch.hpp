@@ -0,0 +1,203 @@
+#ifndef CLP_S_ARROWRECORDBATCH_HPP
+#define CLP_S_ARROWRECORDBATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * The Arrow data types that records are converted to.
+ */
+enum class ArrowType : uint8_t {
+    Null = 0,
+    Int64,
+    Float64,
+    Bool,
+    Utf8,
+    // Nanoseconds since the UNIX epoch in UTC
+    Timestamp,
+    Struct
+};
+
+/**
+ * Builds Apache Arrow record batches column by column and serializes them in the Arrow IPC
+ * streaming format (https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format), so
+ * that records can be consumed by Arrow-based tools without being marshalled to and parsed from
+ * JSON.
+ *
+ * Columns are added once, in pre-order, to describe the schema, after which rows are appended by
+ * writing one value to every non-struct, non-null column and then calling `finish_row`. Since every
+ * row in a batch has a value for every column, no validity bitmaps are written and only null-typed
+ * columns have nulls.
+ *
+ * The IPC metadata (flatbuffers) is encoded by hand rather than through the Arrow C++ library since
+ * the subset of the format needed for these types is small.
+ */
+class ArrowRecordBatchBuilder {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    // Buffered size (B) at which a batch should be serialized and cleared
+    static constexpr size_t cDefaultTargetBatchSize{4ULL * 1024 * 1024};  // 4 MiB
+
+    // Methods
+    /**
+     * Adds a column to the schema. Must be called before any rows are appended.
+     * @param name
+     * @param type
+     * @param parent_column_id The ID of the struct column containing this column, or -1 if it's a
+     * top-level column.
+     * @return The ID of the new column.
+     * @throw OperationFailed if the parent isn't a struct column or rows have been appended.
+     */
+    auto add_column(std::string_view name, ArrowType type, int32_t parent_column_id) -> int32_t;
+
+    [[nodiscard]] auto get_num_columns() const -> size_t { return m_columns.size(); }
+
+    [[nodiscard]] auto get_column_type(int32_t column_id) const -> ArrowType {
+        return m_columns[column_id].type;
+    }
+
+    [[nodiscard]] auto get_num_rows() const -> int64_t { return m_num_rows; }
+
+    /**
+     * @return The total size of the buffered column data.
+     */
+    [[nodiscard]] auto get_buffered_size() const -> size_t { return m_buffered_size; }
+
+    /**
+     * Appends a value to an Int64 or Timestamp column.
+     * @param column_id
+     * @param value
+     */
+    auto append_int64(int32_t column_id, int64_t value) -> void {
+        append_fixed_width_value(column_id, value);
+    }
+
+    /**
+     * Appends a value to a Float64 column.
+     * @param column_id
+     * @param value
+     */
+    auto append_float64(int32_t column_id, double value) -> void {
+        append_fixed_width_value(column_id, value);
+    }
+
+    /**
+     * Appends a value to a Bool column.
+     * @param column_id
+     * @param value
+     */
+    auto append_bool(int32_t column_id, bool value) -> void;
+
+    /**
+     * Returns the data buffer of a Utf8 column so that the next value can be appended to it in
+     * place. The value must be completed with `finish_utf8_value`.
+     * @param column_id
+     * @return The column's data buffer.
+     */
+    [[nodiscard]] auto get_utf8_data(int32_t column_id) -> std::string& {
+        return m_columns[column_id].data;
+    }
+
+    /**
+     * Completes the value appended to a Utf8 column's data buffer since the last call.
+     * @param column_id
+     * @throw OperationFailed if the column's data no longer fits Arrow's 32-bit offsets.
+     */
+    auto finish_utf8_value(int32_t column_id) -> void;
+
+    /**
+     * Appends a value to a Utf8 column.
+     * @param column_id
+     * @param value
+     */
+    auto append_utf8(int32_t column_id, std::string_view value) -> void {
+        get_utf8_data(column_id).append(value);
+        finish_utf8_value(column_id);
+    }
+
+    /**
+     * Marks the current row as complete.
+     */
+    auto finish_row() -> void { ++m_num_rows; }
+
+    /**
+     * Clears all buffered rows while keeping the schema.
+     */
+    auto clear_rows() -> void;
+
+    /**
+     * Clears the schema and all buffered rows.
+     */
+    auto clear() -> void {
+        m_columns.clear();
+        m_top_level_columns.clear();
+        m_num_rows = 0;
+        m_buffered_size = 0;
+    }
+
+    /**
+     * Serializes the schema as an encapsulated IPC message, which must begin each IPC stream.
+     * @param buffer The buffer to append the message to.
+     */
+    auto serialize_schema(std::string& buffer) const -> void;
+
+    /**
+     * Serializes the buffered rows as an encapsulated IPC record batch message.
+     * @param buffer The buffer to append the message to.
+     */
+    auto serialize_record_batch(std::string& buffer) const -> void;
+
+    /**
+     * Serializes the end-of-stream marker, which must end each IPC stream.
+     * @param buffer The buffer to append the marker to.
+     */
+    static auto serialize_end_of_stream(std::string& buffer) -> void;
+
+private:
+    // Types
+    struct Column {
+        std::string name;
+        ArrowType type;
+        std::vector<int32_t> children;
+        // Values for fixed-width columns, bit-packed values for Bool columns, or concatenated
+        // values for Utf8 columns
+        std::string data;
+        // Value offsets for Utf8 columns
+        std::vector<int32_t> offsets;
+    };
+
+    // Methods
+    template <typename T>
+    auto append_fixed_width_value(int32_t column_id, T value) -> void {
+        auto& data{m_columns[column_id].data};
+        auto const size{data.size()};
+        data.resize(size + sizeof(T));
+        std::memcpy(data.data() + size, &value, sizeof(T));
+        m_buffered_size += sizeof(T);
+    }
+
+    // Variables
+    std::vector<Column> m_columns;
+    std::vector<int32_t> m_top_level_columns;
+    int64_t m_num_rows{0};
+    size_t m_buffered_size{0};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ARROWRECORDBATCH_HPP
@@ -192,6 +192,14 @@ public:
     auto extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer)
             -> void override;
 
+    /**
+     * @param cur_message
+     * @return The encoded format of the floating point value.
+     */
+    [[nodiscard]] auto get_format(uint64_t cur_message) -> float_format_t {
+        return m_formats[cur_message];
+    }
+
 private:
     UnalignedMemSpan<double> m_values;
     UnalignedMemSpan<float_format_t> m_formats;
@@ -402,6 +410,14 @@ public:
      */
     [[nodiscard]] auto get_encoded_time(uint64_t cur_message) -> epochtime_t;
 
+    /**
+     * @param cur_message
+     * @return The ID of the timestamp's pattern in the timestamp dictionary.
+     */
+    [[nodiscard]] auto get_timestamp_encoding(uint64_t cur_message) -> uint64_t {
+        return m_timestamp_encodings[cur_message];
+    }
+
 private:
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dict;
 
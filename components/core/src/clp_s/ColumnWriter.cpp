@@ -4,7 +4,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -20,6 +22,27 @@
 #include <clp_s/ZstdCompressor.hpp>
 
 namespace clp_s {
+namespace {
+/**
+ * Reorders a column's values.
+ * @tparam T
+ * @param order The position each value is moved from.
+ * @param values
+ */
+template <typename T>
+auto reorder_values(std::vector<size_t> const& order, std::vector<T>& values) -> void;
+
+template <typename T>
+auto reorder_values(std::vector<size_t> const& order, std::vector<T>& values) -> void {
+    std::vector<T> reordered_values;
+    reordered_values.reserve(values.size());
+    for (auto const idx : order) {
+        reordered_values.push_back(values[idx]);
+    }
+    values = std::move(reordered_values);
+}
+}  // namespace
+
 size_t Int64ColumnWriter::add_value(ParsedMessage::variable_t& value) {
     m_values.push_back(std::get<int64_t>(value));
     return sizeof(int64_t);
@@ -30,6 +53,10 @@ void Int64ColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+auto Int64ColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    reorder_values(order, m_values);
+}
+
 auto DeltaEncodedInt64ColumnWriter::add_value(int64_t value) -> size_t {
     m_values.emplace_back(value - m_cur);
     m_cur = value;
@@ -45,6 +72,22 @@ void DeltaEncodedInt64ColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+auto DeltaEncodedInt64ColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    std::vector<int64_t> values;
+    values.reserve(m_values.size());
+    int64_t cur{0};
+    for (auto const delta : m_values) {
+        cur += delta;
+        values.push_back(cur);
+    }
+
+    m_values.clear();
+    m_cur = 0;
+    for (auto const idx : order) {
+        std::ignore = add_value(values[idx]);
+    }
+}
+
 size_t FloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     m_values.push_back(std::get<double>(value));
     return sizeof(double);
@@ -55,6 +98,10 @@ void FloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+auto FloatColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    reorder_values(order, m_values);
+}
+
 size_t FormattedFloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     auto const& [float_value, format]{std::get<std::pair<double, float_format_t>>(value)};
     m_values.push_back(float_value);
@@ -70,6 +117,11 @@ void FormattedFloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_formats.data()), format_size);
 }
 
+auto FormattedFloatColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    reorder_values(order, m_values);
+    reorder_values(order, m_formats);
+}
+
 size_t DictionaryFloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     clp::variable_dictionary_id_t id{};
     m_var_dict->add_entry(std::get<std::string>(value), id);
@@ -82,6 +134,10 @@ void DictionaryFloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_var_dict_ids.data()), size);
 }
 
+auto DictionaryFloatColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    reorder_values(order, m_var_dict_ids);
+}
+
 size_t BooleanColumnWriter::add_value(ParsedMessage::variable_t& value) {
     m_values.push_back(std::get<bool>(value) ? 1 : 0);
     return sizeof(uint8_t);
@@ -92,6 +148,10 @@ void BooleanColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+auto BooleanColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    reorder_values(order, m_values);
+}
+
 auto ClpStringColumnWriter::add_value(ParsedMessage::variable_t& value) -> size_t {
     auto const offset{m_encoded_vars.size()};
     std::vector<clp::variable_dictionary_id_t> temp_var_dict_ids;
@@ -155,6 +215,32 @@ auto ClpStringColumnWriter::store(ZstdCompressor& compressor) -> void {
     compressor.write(reinterpret_cast<char const*>(m_encoded_vars.data()), encoded_vars_size);
 }
 
+auto ClpStringColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    std::vector<encoded_log_dict_id_t> logtypes;
+    std::vector<clp::encoded_variable_t> encoded_vars;
+    logtypes.reserve(m_logtypes.size());
+    encoded_vars.reserve(m_encoded_vars.size());
+    for (auto const idx : order) {
+        // A value's encoded variables end where the next value's encoded variables begin.
+        auto const encoded_id{m_logtypes[idx]};
+        auto const begin_offset{get_encoded_offset(encoded_id)};
+        auto const end_offset{
+                idx + 1 < m_logtypes.size() ? get_encoded_offset(m_logtypes[idx + 1])
+                                            : m_encoded_vars.size()
+        };
+        logtypes.push_back(
+                encode_log_dict_id(get_encoded_log_dict_id(encoded_id), encoded_vars.size())
+        );
+        encoded_vars.insert(
+                encoded_vars.end(),
+                m_encoded_vars.begin() + static_cast<std::ptrdiff_t>(begin_offset),
+                m_encoded_vars.begin() + static_cast<std::ptrdiff_t>(end_offset)
+        );
+    }
+    m_logtypes = std::move(logtypes);
+    m_encoded_vars = std::move(encoded_vars);
+}
+
 size_t VariableStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     clp::variable_dictionary_id_t id{};
     m_var_dict->add_entry(std::get<std::string>(value), id);
@@ -167,6 +253,10 @@ void VariableStringColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_var_dict_ids.data()), size);
 }
 
+auto VariableStringColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    reorder_values(order, m_var_dict_ids);
+}
+
 auto TimestampColumnWriter::add_value(ParsedMessage::variable_t& value) -> size_t {
     auto const [timestamp, encoding] = std::get<std::pair<epochtime_t, uint64_t>>(value);
     auto const encoded_timestamp_size{m_timestamps.add_value(timestamp)};
@@ -179,4 +269,9 @@ void TimestampColumnWriter::store(ZstdCompressor& compressor) {
     size_t const encodings_size{m_timestamp_encodings.size() * sizeof(uint64_t)};
     compressor.write(reinterpret_cast<char const*>(m_timestamp_encodings.data()), encodings_size);
 }
+
+auto TimestampColumnWriter::reorder(std::vector<size_t> const& order) -> void {
+    m_timestamps.reorder(order);
+    reorder_values(order, m_timestamp_encodings);
+}
 }  // namespace clp_s
@@ -44,6 +44,14 @@ public:
      */
     virtual auto store(ZstdCompressor& compressor) -> void = 0;
 
+    /**
+     * Reorders the values added to the column.
+     * @param order The position each value is moved from, i.e., after reordering, the value at
+     * position `i` is the value that was at position `order[i]`. Must be a permutation of the
+     * positions of the values in the column.
+     */
+    virtual auto reorder(std::vector<size_t> const& order) -> void = 0;
+
     /**
      * Returns the total size of the header data that will be written to the compressor. This header
      * size plus the sum of sizes returned by add_value is equal to the total size of data that will
@@ -61,6 +69,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
 private:
     // Data members
     std::vector<int64_t> m_values;
@@ -73,6 +83,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
     // Methods
     [[nodiscard]] auto add_value(int64_t value) -> size_t;
 
@@ -89,6 +101,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
 private:
     // Data members
     std::vector<double> m_values;
@@ -101,6 +115,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
 private:
     // Data members
     std::vector<double> m_values;
@@ -118,6 +134,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
 private:
     // Data members
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
@@ -131,6 +149,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
 private:
     // Data members
     std::vector<uint8_t> m_values;
@@ -154,6 +174,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
     // Methods
     [[nodiscard]] auto get_total_header_size() const -> size_t override { return sizeof(size_t); }
 
@@ -211,6 +233,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
 private:
     // Data members
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
@@ -224,6 +248,8 @@ public:
 
     auto store(ZstdCompressor& compressor) -> void override;
 
+    auto reorder(std::vector<size_t> const& order) -> void override;
+
 private:
     // Data members
     DeltaEncodedInt64ColumnWriter m_timestamps;
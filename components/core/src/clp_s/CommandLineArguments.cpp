@@ -26,6 +26,7 @@ constexpr std::string_view cNoAuth{"none"};
 constexpr std::string_view cS3Auth{"s3"};
 
 // Output handler constants
+constexpr std::string_view cArrowOutputHandlerName{"arrow"};
 constexpr std::string_view cFileOutputHandlerName{"file"};
 constexpr std::string_view cNetworkOutputHandlerName{"network"};
 constexpr std::string_view cReducerOutputHandlerName{"reducer"};
@@ -305,11 +306,15 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 std::cerr << "  c - compress" << std::endl;
                 std::cerr << "  x - decompress" << std::endl;
                 std::cerr << "  s - search" << std::endl;
+                std::cerr << "  d - train zstd dictionaries" << std::endl;
+                std::cerr << "  m - merge archives" << std::endl;
                 std::cerr << std::endl;
                 std::cerr << "Try "
                           << " c --help OR"
                           << " x --help OR"
-                          << " s --help for command-specific details." << std::endl;
+                          << " s --help OR"
+                          << " d --help OR"
+                          << " m --help for command-specific details." << std::endl;
 
                 po::options_description visible_options;
                 visible_options.add(general_options);
@@ -324,6 +329,8 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
             case (char)Command::Compress:
             case (char)Command::Extract:
             case (char)Command::Search:
+            case (char)Command::TrainDictionaries:
+            case (char)Command::Merge:
                 m_command = (Command)command_input;
                 break;
             default:
@@ -357,12 +364,35 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     po::value<int>(&m_compression_level)->value_name("LEVEL")->
                         default_value(m_compression_level),
                     "1 (fast/low compression) to 19 (slow/high compression)."
+            )(
+                    "compression-workers",
+                    po::value<int>(&m_zstd_worker_options.num_workers)->value_name("NUM")->
+                        default_value(m_zstd_worker_options.num_workers),
+                    "Number of threads zstd uses to compress each packed table (0 compresses on the"
+                    " ingestion thread)."
+            )(
+                    "compression-job-size",
+                    po::value<size_t>(&m_zstd_worker_options.job_size)->value_name("SIZE")->
+                        default_value(m_zstd_worker_options.job_size),
+                    "Size (B) of each job handed to a compression thread (0 lets zstd choose)."
+            )(
+                    "compression-long-distance-matching",
+                    po::bool_switch(&m_zstd_worker_options.enable_long_distance_matching),
+                    "Find matches far apart in large packed tables at the cost of memory."
             )(
                     "target-encoded-size",
                     po::value<size_t>(&m_target_encoded_size)->value_name("TARGET_ENCODED_SIZE")->
                         default_value(m_target_encoded_size),
                     "Target size (B) for the dictionaries and encoded messages before a new "
                     "archive is created."
+            )(
+                    "archive-flush-interval",
+                    po::value<uint64_t>(&m_archive_flush_interval_ms)->value_name("MS")->
+                        default_value(m_archive_flush_interval_ms),
+                    "Maximum time (ms) an archive is kept open before a new archive is created,"
+                    " so that ingested records become searchable within this interval while"
+                    " records keep arriving; an idle input doesn't close the archive (0"
+                    " disables)."
             )(
                     "min-table-size",
                     po::value<size_t>(&m_minimum_table_size)->value_name("MIN_TABLE_SIZE")->
@@ -378,6 +408,12 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     po::value<std::string>(&m_timestamp_key)->value_name("TIMESTAMP_COLUMN_KEY")->
                         default_value(m_timestamp_key),
                     "Path (e.g. x.y) for the field containing the log event's timestamp."
+            )(
+                    "sort-key",
+                    po::value<std::string>(&m_sort_key)->value_name("SORT_COLUMN_KEY")->
+                        default_value(m_sort_key),
+                    "Path (e.g. x.y) for the field to sort the records within each table by."
+                    " Requires --disable-log-order."
             )(
                     "files-from,f",
                     po::value<std::string>(&input_path_list_file_path)
@@ -419,6 +455,11 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     po::bool_switch(&m_disable_log_order),
                     "Do not record log order at ingestion time; Do not record the archive range"
                     " index."
+            )(
+                    "zstd-dictionaries",
+                    po::value<std::string>(&m_zstd_dictionaries_dir)->value_name("DIR"),
+                    "Compress archive sections with the trained zstd dictionaries in DIR (see the"
+                    " d command)"
             )(
                     "auth",
                     po::value<std::string>(&auth)
@@ -469,6 +510,18 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No archives directory specified.");
             }
 
+            if (m_zstd_worker_options.num_workers < 0) {
+                throw std::invalid_argument("compression-workers cannot be negative.");
+            }
+            if (0 != m_zstd_worker_options.job_size && 0 == m_zstd_worker_options.num_workers) {
+                throw std::invalid_argument(
+                        "compression-job-size requires compression-workers to be positive."
+                );
+            }
+            if (false == m_sort_key.empty() && false == m_disable_log_order) {
+                throw std::invalid_argument("sort-key requires disable-log-order.");
+            }
+
             if (false == input_path_list_file_path.empty()) {
                 if (false == read_paths_from_file(input_path_list_file_path, input_paths)) {
                     SPDLOG_ERROR("Failed to read paths from {}", input_path_list_file_path);
@@ -601,11 +654,19 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "print-ordered-chunk-stats",
                     po::bool_switch(&m_print_ordered_chunk_stats),
                     "Print statistics (ndjson) about each chunk file after it's extracted."
+            )(
+                    "arrow",
+                    po::bool_switch(&m_arrow_decompression),
+                    "Decompress records into an Arrow IPC stream file instead of JSON"
             )(
                     "archive-id",
                     po::value<std::string>(&archive_id)->value_name("ID"),
                     "Limit decompression to the archive with the given ID in a subdirectory of"
                     " archive-path"
+            )(
+                    "zstd-dictionaries",
+                    po::value<std::string>(&m_zstd_dictionaries_dir)->value_name("DIR"),
+                    "Directory of the trained zstd dictionaries the archives were compressed with"
             )(
                     "auth",
                     po::value<std::string>(&auth)
@@ -675,6 +736,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No output directory specified");
             }
 
+            if (m_arrow_decompression && m_ordered_decompression) {
+                throw std::invalid_argument("arrow can't be used with ordered argument");
+            }
+
             if (false == m_ordered_decompression) {
                 if (0 != m_target_ordered_chunk_size) {
                     throw std::invalid_argument(
@@ -755,6 +820,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "archive-id",
                 po::value<std::string>(&archive_id)->value_name("ID"),
                 "Limit search to the archive with the given ID in a subdirectory of archive-path"
+            )(
+                "zstd-dictionaries",
+                po::value<std::string>(&m_zstd_dictionaries_dir)->value_name("DIR"),
+                "Directory of the trained zstd dictionaries the archives were compressed with"
             )(
                 "projection",
                 po::value<std::vector<std::string>>(&m_projection_columns)
@@ -798,6 +867,14 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "unique",
                 po::value<std::string>(&aggregation_field)->value_name("FIELD"),
                 "Find the distinct values of the given field"
+            )(
+                "count-distinct",
+                po::value<std::string>(&aggregation_field)->value_name("FIELD"),
+                "Estimate the number of distinct values of the given field"
+            )(
+                "quantiles",
+                po::value<std::string>(&aggregation_field)->value_name("FIELD"),
+                "Estimate the 50th, 95th, and 99th percentiles of the given numeric field"
             );
             // clang-format on
             search_options.add(aggregation_options);
@@ -874,6 +951,24 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "The dataset name to include in each result document"
             );
 
+            ArrowOutputHandlerOptions arrow_options{};
+            po::options_description arrow_output_handler_options("Arrow Output Handler Options");
+            // clang-format off
+            arrow_output_handler_options.add_options()(
+                    "path",
+                    po::value<std::string>(&arrow_options.output_path)->value_name("PATH"),
+                    "Arrow IPC stream file output path"
+            )(
+                    "host",
+                    po::value<std::string>(&arrow_options.host)->value_name("HOST"),
+                    "Host the Arrow IPC stream should be sent to"
+            )(
+                    "port",
+                    po::value<int>(&arrow_options.port)->value_name("PORT"),
+                    "Port the Arrow IPC stream should be sent to"
+            );
+            // clang-format on
+
             FileOutputHandlerOptions file_options{};
             po::options_description file_output_handler_options("File Output Handler Options");
             file_output_handler_options.add_options()(
@@ -900,6 +995,9 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 std::cerr << "  " << cStdoutCacheOutputHandlerName
                           << " (default) - Output to stdout" << std::endl;
                 std::cerr << "  " << cFileOutputHandlerName << " - Output to a file" << std::endl;
+                std::cerr << "  " << cArrowOutputHandlerName
+                          << " - Output Arrow record batches to a file or network destination"
+                          << std::endl;
                 std::cerr << "  " << cNetworkOutputHandlerName
                           << " - Output to a network destination" << std::endl;
                 std::cerr << "  " << cResultsCacheOutputHandlerName
@@ -923,6 +1021,13 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                           << " " << cFileOutputHandlerName << " --path test.out" << std::endl;
                 std::cerr << std::endl;
 
+                std::cerr << "  # Search archives in archives-dir for logs matching a KQL query"
+                             R"( "level: INFO" and output Arrow record batches to a file)"
+                          << std::endl;
+                std::cerr << "  " << m_program_name << R"( s archives-dir "level: INFO")"
+                          << " " << cArrowOutputHandlerName << " --path test.arrows" << std::endl;
+                std::cerr << std::endl;
+
                 std::cerr << "  # Search archives in archives-dir for logs matching a KQL query"
                              R"( "level: INFO" and output to the results cache)"
                           << std::endl;
@@ -991,6 +1096,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 visible_options.add(match_options);
                 visible_options.add(aggregation_options);
                 visible_options.add(file_output_handler_options);
+                visible_options.add(arrow_output_handler_options);
                 visible_options.add(network_output_handler_options);
                 visible_options.add(results_cache_output_handler_options);
                 visible_options.add(reducer_output_handler_options);
@@ -1020,6 +1126,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                             )
             );
             std::map<std::string, po::options_description const*> const subcommands{
+                    {std::string{cArrowOutputHandlerName}, &arrow_output_handler_options},
                     {std::string{cFileOutputHandlerName}, &file_output_handler_options},
                     {std::string{cNetworkOutputHandlerName}, &network_output_handler_options},
                     {std::string{cReducerOutputHandlerName}, &reducer_output_handler_options},
@@ -1111,12 +1218,230 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     m_output_handler_options.emplace<FileOutputHandlerOptions>(
                             std::move(file_options)
                     );
+                } else if (cArrowOutputHandlerName == output_handler_name) {
+                    parse_arrow_output_handler_options(
+                            arrow_output_handler_options,
+                            output_handler_options,
+                            arrow_options
+                    );
+                    m_output_handler_options.emplace<ArrowOutputHandlerOptions>(
+                            std::move(arrow_options)
+                    );
                 } else if (output_handler_name.empty()) {
                     throw std::invalid_argument("OUTPUT_HANDLER cannot be an empty string.");
                 } else {
                     throw std::invalid_argument("Unknown OUTPUT_HANDLER: " + output_handler_name);
                 }
             }
+        } else if ((char)Command::TrainDictionaries == command_input) {
+            po::options_description train_dictionaries_positional_options;
+            std::string archive_path;
+            // clang-format off
+            train_dictionaries_positional_options.add_options()(
+                    "dictionaries-dir",
+                    po::value<std::string>(&m_zstd_dictionaries_dir),
+                    "The directory to store the trained dictionaries in"
+            )(
+                    "archive-path",
+                    po::value<std::string>(&archive_path),
+                    "Path to a directory containing sample archives, or the path to a single"
+                    " sample archive"
+            );
+            // clang-format on
+
+            po::options_description train_dictionaries_options("Training Options");
+            std::string auth{cNoAuth};
+            std::string archive_id;
+            // clang-format off
+            train_dictionaries_options.add_options()(
+                    "max-dictionary-size",
+                    po::value<size_t>(&m_max_zstd_dictionary_size)
+                            ->value_name("SIZE")
+                            ->default_value(m_max_zstd_dictionary_size),
+                    "Maximum size (B) of each trained dictionary"
+            )(
+                    "archive-id",
+                    po::value<std::string>(&archive_id)->value_name("ID"),
+                    "Limit training to the archive with the given ID in a subdirectory of"
+                    " archive-path"
+            )(
+                    "auth",
+                    po::value<std::string>(&auth)
+                        ->value_name("AUTH_METHOD")
+                        ->default_value(auth),
+                    "Type of authentication required for network requests (s3 | none)."
+                    " Authentication with s3 requires the AWS_ACCESS_KEY_ID and"
+                    " AWS_SECRET_ACCESS_KEY environment variables, and optionally the"
+                    " AWS_SESSION_TOKEN environment variable."
+            );
+            // clang-format on
+
+            po::positional_options_description positional_options;
+            positional_options.add("dictionaries-dir", 1);
+            positional_options.add("archive-path", 1);
+
+            po::options_description all_train_dictionaries_options;
+            all_train_dictionaries_options.add(train_dictionaries_options);
+            all_train_dictionaries_options.add(train_dictionaries_positional_options);
+
+            std::vector<std::string> unrecognized_options
+                    = po::collect_unrecognized(parsed.options, po::include_positional);
+            unrecognized_options.erase(unrecognized_options.begin());
+            po::store(
+                    po::command_line_parser(unrecognized_options)
+                            .options(all_train_dictionaries_options)
+                            .positional(positional_options)
+                            .run(),
+                    parsed_command_line_options
+            );
+            po::notify(parsed_command_line_options);
+
+            if (parsed_command_line_options.count("help")) {
+                print_train_dictionaries_usage();
+
+                std::cerr << "Examples:" << std::endl;
+                std::cerr << "  # Train dictionaries in dictionaries-dir from the archives in"
+                             " archives-dir"
+                          << std::endl;
+                std::cerr << "  " << m_program_name << " d dictionaries-dir archives-dir"
+                          << std::endl;
+
+                po::options_description visible_options;
+                visible_options.add(general_options);
+                visible_options.add(train_dictionaries_options);
+                std::cerr << visible_options << '\n';
+                return ParsingResult::InfoCommand;
+            }
+
+            if (m_zstd_dictionaries_dir.empty()) {
+                throw std::invalid_argument("No dictionaries directory specified.");
+            }
+
+            if (0 == m_max_zstd_dictionary_size) {
+                throw std::invalid_argument("max-dictionary-size must be greater than zero.");
+            }
+
+            validate_archive_paths(archive_path, archive_id, m_input_paths);
+
+            validate_network_auth(auth, m_network_auth);
+        } else if ((char)Command::Merge == command_input) {
+            po::options_description merge_positional_options;
+            std::string archive_path;
+            // clang-format off
+            merge_positional_options.add_options()(
+                    "archives-dir",
+                    po::value<std::string>(&m_archives_dir),
+                    "The directory to write the merged archives to"
+            )(
+                    "archive-path",
+                    po::value<std::string>(&archive_path),
+                    "Path to a directory containing the archives to merge"
+            );
+            // clang-format on
+
+            po::options_description merge_options("Merge Options");
+            std::string auth{cNoAuth};
+            std::string archive_id;
+            // clang-format off
+            merge_options.add_options()(
+                    "compression-level",
+                    po::value<int>(&m_compression_level)->value_name("LEVEL")->
+                        default_value(m_compression_level),
+                    "1 (fast/low compression) to 19 (slow/high compression)."
+            )(
+                    "compression-workers",
+                    po::value<int>(&m_zstd_worker_options.num_workers)->value_name("NUM")->
+                        default_value(m_zstd_worker_options.num_workers),
+                    "Number of threads zstd uses to compress each packed table (0 compresses on the"
+                    " merging thread)."
+            )(
+                    "target-encoded-size",
+                    po::value<size_t>(&m_target_encoded_size)->value_name("TARGET_ENCODED_SIZE")->
+                        default_value(m_target_encoded_size),
+                    "Target size (B) for the dictionaries and encoded messages before a new "
+                    "archive is created."
+            )(
+                    "min-table-size",
+                    po::value<size_t>(&m_minimum_table_size)->value_name("MIN_TABLE_SIZE")->
+                        default_value(m_minimum_table_size),
+                    "Minimum size (B) for a packed table before it gets compressed."
+            )(
+                    "print-archive-stats",
+                    po::bool_switch(&m_print_archive_stats),
+                    "Print statistics (json) about each archive after it's written."
+            )(
+                    "single-file-archive",
+                    po::bool_switch(&m_single_file_archive),
+                    "Create single archive files instead of multiple files."
+            )(
+                    "zstd-dictionaries",
+                    po::value<std::string>(&m_zstd_dictionaries_dir)->value_name("DIR"),
+                    "Read and write archive sections with the trained zstd dictionaries in DIR"
+                    " (see the d command)"
+            )(
+                    "archive-id",
+                    po::value<std::string>(&archive_id)->value_name("ID"),
+                    "Limit merging to the archive with the given ID in a subdirectory of"
+                    " archive-path"
+            )(
+                    "auth",
+                    po::value<std::string>(&auth)
+                        ->value_name("AUTH_METHOD")
+                        ->default_value(auth),
+                    "Type of authentication required for network requests (s3 | none)."
+                    " Authentication with s3 requires the AWS_ACCESS_KEY_ID and"
+                    " AWS_SECRET_ACCESS_KEY environment variables, and optionally the"
+                    " AWS_SESSION_TOKEN environment variable."
+            );
+            // clang-format on
+
+            po::positional_options_description positional_options;
+            positional_options.add("archives-dir", 1);
+            positional_options.add("archive-path", 1);
+
+            po::options_description all_merge_options;
+            all_merge_options.add(merge_options);
+            all_merge_options.add(merge_positional_options);
+
+            std::vector<std::string> unrecognized_options
+                    = po::collect_unrecognized(parsed.options, po::include_positional);
+            unrecognized_options.erase(unrecognized_options.begin());
+            po::store(
+                    po::command_line_parser(unrecognized_options)
+                            .options(all_merge_options)
+                            .positional(positional_options)
+                            .run(),
+                    parsed_command_line_options
+            );
+            po::notify(parsed_command_line_options);
+
+            if (parsed_command_line_options.count("help")) {
+                print_merge_usage();
+
+                std::cerr << "Examples:" << std::endl;
+                std::cerr << "  # Merge the archives in small-archives-dir into archives-dir"
+                          << std::endl;
+                std::cerr << "  " << m_program_name << " m archives-dir small-archives-dir"
+                          << std::endl;
+
+                po::options_description visible_options;
+                visible_options.add(general_options);
+                visible_options.add(merge_options);
+                std::cerr << visible_options << '\n';
+                return ParsingResult::InfoCommand;
+            }
+
+            if (m_archives_dir.empty()) {
+                throw std::invalid_argument("No archives directory specified.");
+            }
+
+            if (m_zstd_worker_options.num_workers < 0) {
+                throw std::invalid_argument("compression-workers cannot be negative.");
+            }
+
+            validate_archive_paths(archive_path, archive_id, m_input_paths);
+
+            validate_network_auth(auth, m_network_auth);
         }
     } catch (std::exception& e) {
         SPDLOG_ERROR("{}", e.what());
@@ -1163,19 +1488,23 @@ auto CommandLineArguments::parse_aggregation_options(
     auto const set_aggregator = [&](Aggregator value) {
         if (aggregator.has_value()) {
             throw std::invalid_argument(
-                    "The --count, --count-by-time, --min, --max, and --unique options are mutually"
-                    " exclusive."
+                    "The --count, --count-by-time, --min, --max, --unique, --count-distinct, and"
+                    " --quantiles options are mutually exclusive."
             );
         }
         aggregator = std::move(value);
     };
     auto const validate_aggregation_field = [&]() {
         if (aggregation_field.empty()) {
-            throw std::invalid_argument("The --min, --max, and --unique options require a field.");
+            throw std::invalid_argument(
+                    "The --min, --max, --unique, --count-distinct, and --quantiles options require"
+                    " a field."
+            );
         }
         if (search::ast::has_unescaped_wildcards(aggregation_field)) {
             throw std::invalid_argument(
-                    "The --min, --max, and --unique field must not contain wildcards."
+                    "The --min, --max, --unique, --count-distinct, and --quantiles field must not"
+                    " contain wildcards."
             );
         }
     };
@@ -1201,6 +1530,14 @@ auto CommandLineArguments::parse_aggregation_options(
         validate_aggregation_field();
         set_aggregator(UniqueAggregator{aggregation_field});
     }
+    if (parsed_options.count("count-distinct")) {
+        validate_aggregation_field();
+        set_aggregator(DistinctCountAggregator{aggregation_field});
+    }
+    if (parsed_options.count("quantiles")) {
+        validate_aggregation_field();
+        set_aggregator(QuantilesAggregator{aggregation_field});
+    }
     return aggregator;
 }
 
@@ -1244,12 +1581,12 @@ void CommandLineArguments::parse_reducer_output_handler_options(
     }
 
     if (false == m_aggregator.has_value()
-        || (false == std::holds_alternative<CountAggregator>(m_aggregator.value())
-            && false == std::holds_alternative<CountByTimeAggregator>(m_aggregator.value())))
+        || std::holds_alternative<MinMaxAggregator>(m_aggregator.value())
+        || std::holds_alternative<UniqueAggregator>(m_aggregator.value()))
     {
         throw std::invalid_argument(
-                "The reducer output handler currently only supports count and count-by-time"
-                " aggregations."
+                "The reducer output handler currently only supports count, count-by-time,"
+                " count-distinct, and quantiles aggregations."
         );
     }
 }
@@ -1303,6 +1640,43 @@ void CommandLineArguments::parse_file_output_handler_options(
     }
 }
 
+void CommandLineArguments::parse_arrow_output_handler_options(
+        po::options_description const& options_description,
+        std::vector<std::string> const& options,
+        ArrowOutputHandlerOptions& arrow_options
+) {
+    po::variables_map parsed_options;
+    parse_subcommand_options(options_description, options, parsed_options);
+
+    reject_aggregation_for_handler(cArrowOutputHandlerName);
+
+    bool const has_path{parsed_options.count("path") > 0};
+    bool const has_host{parsed_options.count("host") > 0};
+    if (has_path == has_host) {
+        throw std::invalid_argument("Exactly one of path or host must be specified.");
+    }
+
+    if (has_path) {
+        if (arrow_options.output_path.empty()) {
+            throw std::invalid_argument("path cannot be an empty string.");
+        }
+        if (parsed_options.count("port") > 0) {
+            throw std::invalid_argument("port can only be specified with host.");
+        }
+        return;
+    }
+
+    if (arrow_options.host.empty()) {
+        throw std::invalid_argument("host cannot be an empty string.");
+    }
+    if (parsed_options.count("port") == 0) {
+        throw std::invalid_argument("port must be specified.");
+    }
+    if (arrow_options.port <= 0) {
+        throw std::invalid_argument("port must be greater than zero.");
+    }
+}
+
 void CommandLineArguments::print_basic_usage() const {
     std::cerr << "Usage: " << m_program_name << " [OPTIONS] COMMAND [COMMAND ARGUMENTS]"
               << std::endl;
@@ -1323,4 +1697,14 @@ void CommandLineArguments::print_search_usage() const {
                  " [OUTPUT_HANDLER [OUTPUT_HANDLER_OPTIONS]]"
               << std::endl;
 }
+
+void CommandLineArguments::print_train_dictionaries_usage() const {
+    std::cerr << "Usage: " << m_program_name << " d [OPTIONS] DICTIONARIES_DIR ARCHIVES_DIR"
+              << std::endl;
+}
+
+void CommandLineArguments::print_merge_usage() const {
+    std::cerr << "Usage: " << m_program_name << " m [OPTIONS] ARCHIVES_DIR INPUT_ARCHIVES_DIR"
+              << std::endl;
+}
 }  // namespace clp_s
@@ -1,6 +1,8 @@
 #ifndef CLP_S_COMMANDLINEARGUMENTS_HPP
 #define CLP_S_COMMANDLINEARGUMENTS_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -16,6 +18,8 @@
 #include "../reducer/types.hpp"
 #include "Defs.hpp"
 #include "InputConfig.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDictionaryRegistry.hpp"
 
 namespace clp_s {
 class CommandLineArguments {
@@ -30,7 +34,9 @@ public:
     enum class Command : char {
         Compress = 'c',
         Extract = 'x',
-        Search = 's'
+        Search = 's',
+        TrainDictionaries = 'd',
+        Merge = 'm'
     };
 
     struct ResultsCacheOutputHandlerOptions {
@@ -41,6 +47,12 @@ public:
         uint64_t max_num_results{1000};
     };
 
+    struct ArrowOutputHandlerOptions {
+        std::string output_path;
+        std::string host;
+        int port{-1};
+    };
+
     struct FileOutputHandlerOptions {
         std::string output_path;
     };
@@ -60,6 +72,7 @@ public:
 
     using OutputHandlerOptionsVariant = std::
             variant<ResultsCacheOutputHandlerOptions,
+                    ArrowOutputHandlerOptions,
                     FileOutputHandlerOptions,
                     NetworkOutputHandlerOptions,
                     ReducerOutputHandlerOptions,
@@ -90,10 +103,16 @@ public:
 
     std::string const& get_timestamp_key() const { return m_timestamp_key; }
 
+    [[nodiscard]] auto get_sort_key() const -> std::string const& { return m_sort_key; }
+
     int get_compression_level() const { return m_compression_level; }
 
     size_t get_target_encoded_size() const { return m_target_encoded_size; }
 
+    [[nodiscard]] auto get_archive_flush_interval_ms() const -> uint64_t {
+        return m_archive_flush_interval_ms;
+    }
+
     size_t get_max_document_size() const { return m_max_document_size; }
 
     [[nodiscard]] bool print_archive_stats() const { return m_print_archive_stats; }
@@ -134,6 +153,8 @@ public:
 
     bool get_ordered_decompression() const { return m_ordered_decompression; }
 
+    [[nodiscard]] auto get_arrow_decompression() const -> bool { return m_arrow_decompression; }
+
     size_t get_target_ordered_chunk_size() const { return m_target_ordered_chunk_size; }
 
     size_t get_minimum_table_size() const { return m_minimum_table_size; }
@@ -142,6 +163,18 @@ public:
 
     bool get_record_log_order() const { return false == m_disable_log_order; }
 
+    [[nodiscard]] auto get_zstd_dictionaries_dir() const -> std::string const& {
+        return m_zstd_dictionaries_dir;
+    }
+
+    [[nodiscard]] auto get_max_zstd_dictionary_size() const -> size_t {
+        return m_max_zstd_dictionary_size;
+    }
+
+    [[nodiscard]] auto get_zstd_worker_options() const -> ZstdWorkerOptions const& {
+        return m_zstd_worker_options;
+    }
+
 private:
     // Methods
     /**
@@ -220,6 +253,19 @@ private:
             FileOutputHandlerOptions& file_options
     );
 
+    /**
+     * Validates output options related to the Arrow output handler.
+     * @param options_description
+     * @param options Vector of options previously parsed by boost::program_options and which may
+     * contain options that have the unrecognized flag set.
+     * @param arrow_options The parsed representation of the Arrow output handler options.
+     */
+    void parse_arrow_output_handler_options(
+            boost::program_options::options_description const& options_description,
+            std::vector<std::string> const& options,
+            ArrowOutputHandlerOptions& arrow_options
+    );
+
     void print_basic_usage() const;
 
     void print_compression_usage() const;
@@ -228,6 +274,10 @@ private:
 
     void print_search_usage() const;
 
+    void print_train_dictionaries_usage() const;
+
+    void print_merge_usage() const;
+
     // Variables
     std::string m_program_name;
     Command m_command;
@@ -239,18 +289,24 @@ private:
     std::string m_archives_dir;
     std::string m_output_dir;
     std::string m_timestamp_key;
+    std::string m_sort_key;
     int m_compression_level{3};
     size_t m_target_encoded_size{8ULL * 1024 * 1024 * 1024};  // 8 GiB
+    uint64_t m_archive_flush_interval_ms{0};
     bool m_print_archive_stats{false};
     size_t m_max_document_size{512ULL * 1024 * 1024};  // 512 MiB
     bool m_no_retain_float_format{false};
     bool m_single_file_archive{false};
     bool m_structurize_arrays{false};
     bool m_ordered_decompression{false};
+    bool m_arrow_decompression{false};
     size_t m_target_ordered_chunk_size{};
     bool m_print_ordered_chunk_stats{false};
     size_t m_minimum_table_size{1ULL * 1024 * 1024};  // 1 MiB
     bool m_disable_log_order{false};
+    std::string m_zstd_dictionaries_dir;
+    size_t m_max_zstd_dictionary_size{ZstdDictionaryRegistry::cDefaultMaxDictionarySize};
+    ZstdWorkerOptions m_zstd_worker_options;
     std::string m_mongodb_uri;
     std::string m_mongodb_collection;
 
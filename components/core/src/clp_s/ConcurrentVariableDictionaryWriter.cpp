@@ -0,0 +1,114 @@
+#include "ConcurrentVariableDictionaryWriter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/hash/hash.h>
+#include <spdlog/spdlog.h>
+#include <zstd.h>
+
+#include "../clp/Defs.h"
+#include "DictionaryEntry.hpp"
+#include "ErrorCode.hpp"
+#include "FileWriter.hpp"
+#include "ZstdCompressor.hpp"
+
+namespace clp_s {
+auto ConcurrentVariableDictionaryWriter::open(
+        std::string const& dictionary_path,
+        int compression_level,
+        clp::variable_dictionary_id_t max_id,
+        ZSTD_CDict const* zstd_dictionary
+) -> void {
+    if (m_is_open) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+
+    m_dictionary_file_writer.open(dictionary_path, FileWriter::OpenMode::CreateForWriting);
+    m_compression_level = compression_level;
+    m_zstd_dictionary = zstd_dictionary;
+
+    m_next_id = 0;
+    m_max_id = max_id;
+
+    m_data_size = 0;
+    m_is_open = true;
+}
+
+auto ConcurrentVariableDictionaryWriter::close() -> size_t {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
+    }
+
+    // IDs are dense, so every entry's ID is its position in the file.
+    auto const num_entries{get_num_entries()};
+    std::vector<std::string const*> values_by_id(num_entries, nullptr);
+    for (auto const& stripe : m_stripes) {
+        for (auto const& [value, id] : stripe.value_to_id) {
+            values_by_id[id] = &value;
+        }
+    }
+
+    m_dictionary_file_writer.write_numeric_value<uint64_t>(num_entries);
+    ZstdCompressor dictionary_compressor;
+    dictionary_compressor.open(m_dictionary_file_writer, m_compression_level, m_zstd_dictionary);
+    for (uint64_t id{0}; id < num_entries; ++id) {
+        VariableDictionaryEntry const entry{*values_by_id[id], id};
+        entry.write_to_file(dictionary_compressor);
+    }
+    dictionary_compressor.close();
+    auto const compressed_size{m_dictionary_file_writer.get_pos()};
+    m_dictionary_file_writer.close();
+
+    for (auto& stripe : m_stripes) {
+        stripe.value_to_id.clear();
+    }
+    m_zstd_dictionary = nullptr;
+    m_is_open = false;
+    return compressed_size;
+}
+
+auto ConcurrentVariableDictionaryWriter::add_entry(
+        std::string_view value,
+        clp::variable_dictionary_id_t& id
+) -> bool {
+    auto& stripe{get_stripe(value)};
+    std::lock_guard<std::mutex> const lock{stripe.mutex};
+
+    auto const it{stripe.value_to_id.find(value)};
+    if (stripe.value_to_id.end() != it) {
+        id = it->second;
+        return false;
+    }
+
+    // Only claim an ID if it's in range, so that the number of entries always equals the next ID.
+    auto next_id{m_next_id.load(std::memory_order_relaxed)};
+    do {
+        if (next_id > m_max_id) {
+            SPDLOG_ERROR("ConcurrentVariableDictionaryWriter ran out of IDs.");
+            throw OperationFailed(ErrorCodeOutOfBounds, __FILENAME__, __LINE__);
+        }
+    } while (false
+             == m_next_id.compare_exchange_weak(next_id, next_id + 1, std::memory_order_relaxed));
+    id = next_id;
+
+    stripe.value_to_id.emplace(value, id);
+    // Same as `VariableDictionaryEntry::get_data_size`
+    m_data_size.fetch_add(sizeof(id) + value.length(), std::memory_order_relaxed);
+    return true;
+}
+
+auto ConcurrentVariableDictionaryWriter::get_stripe(std::string_view value) -> Stripe& {
+    // Select the stripe using the hash's high bits since each stripe's hash map uses the low bits
+    // to tell apart values in the same probe group, and those bits would otherwise be the same for
+    // every value in a stripe.
+    constexpr auto cStripeShift{std::numeric_limits<size_t>::digits - cNumStripesLog2};
+    auto const hash{absl::Hash<std::string_view>{}(value)};
+    return m_stripes[hash >> cStripeShift];
+}
+}  // namespace clp_s
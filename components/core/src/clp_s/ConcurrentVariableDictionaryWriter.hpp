@@ -0,0 +1,141 @@
+#ifndef CLP_S_CONCURRENTVARIABLEDICTIONARYWRITER_HPP
+#define CLP_S_CONCURRENTVARIABLEDICTIONARYWRITER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <absl/container/flat_hash_map.h>
+#include <zstd.h>
+
+#include "../clp/Defs.h"
+#include "../clp/VariableDictionaryWriterReq.hpp"
+#include "ErrorCode.hpp"
+#include "FileWriter.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * A variable dictionary writer that multiple threads can add entries to concurrently, so that
+ * threads ingesting into the same archive can share one dictionary instead of each duplicating the
+ * entries they have in common.
+ *
+ * Entries are partitioned by the hash of their value across stripes that each have their own lock,
+ * so threads adding different values rarely contend. An entry's ID is assigned from a shared
+ * counter when the entry is first added and never changes, so IDs are dense but depend on the order
+ * in which threads add entries. Since the dictionary file stores entries in ID order, entries are
+ * kept in memory and only written when the dictionary is closed.
+ */
+class ConcurrentVariableDictionaryWriter {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    ConcurrentVariableDictionaryWriter() = default;
+
+    // Delete copy & move constructors and assignment operators
+    ConcurrentVariableDictionaryWriter(ConcurrentVariableDictionaryWriter const&) = delete;
+    ConcurrentVariableDictionaryWriter(ConcurrentVariableDictionaryWriter&&) = delete;
+    auto operator=(ConcurrentVariableDictionaryWriter const&)
+            -> ConcurrentVariableDictionaryWriter& = delete;
+    auto operator=(ConcurrentVariableDictionaryWriter&&)
+            -> ConcurrentVariableDictionaryWriter& = delete;
+
+    // Destructor
+    ~ConcurrentVariableDictionaryWriter() = default;
+
+    // Methods
+    /**
+     * Opens the dictionary for writing. Not thread-safe.
+     * @param dictionary_path
+     * @param compression_level
+     * @param max_id
+     * @param zstd_dictionary An optional trained zstd dictionary to compress the dictionary with
+     * @throw OperationFailed if the dictionary is already open.
+     */
+    auto
+    open(std::string const& dictionary_path,
+         int compression_level,
+         clp::variable_dictionary_id_t max_id,
+         ZSTD_CDict const* zstd_dictionary = nullptr) -> void;
+
+    /**
+     * Writes all entries to disk in ID order and closes the dictionary. Not thread-safe, so it must
+     * only be called once every thread has stopped adding entries.
+     * @return The compressed size of the dictionary in bytes.
+     * @throw OperationFailed if the dictionary isn't open.
+     */
+    [[nodiscard]] auto close() -> size_t;
+
+    /**
+     * Adds the given variable to the dictionary if it doesn't exist. Thread-safe.
+     * @param value
+     * @param id Returns the ID of the variable.
+     * @return Whether this call inserted a new entry.
+     * @throw OperationFailed if the dictionary ran out of IDs.
+     */
+    auto add_entry(std::string_view value, clp::variable_dictionary_id_t& id) -> bool;
+
+    /**
+     * @return The number of entries in the dictionary.
+     */
+    [[nodiscard]] auto get_num_entries() const -> uint64_t {
+        return m_next_id.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The size (in-memory) of the data contained in the dictionary.
+     */
+    [[nodiscard]] auto get_data_size() const -> size_t {
+        return m_data_size.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Types
+    // Aligned to separate cache lines so that threads locking different stripes don't contend.
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+        absl::flat_hash_map<std::string, clp::variable_dictionary_id_t> value_to_id;
+    };
+
+    // Constants
+    static constexpr size_t cNumStripesLog2{6};
+    static constexpr size_t cNumStripes{1ULL << cNumStripesLog2};
+
+    // Methods
+    /**
+     * @param value
+     * @return The stripe containing `value`.
+     */
+    [[nodiscard]] auto get_stripe(std::string_view value) -> Stripe&;
+
+    // Variables
+    bool m_is_open{false};
+    FileWriter m_dictionary_file_writer;
+    int m_compression_level{};
+    ZSTD_CDict const* m_zstd_dictionary{nullptr};
+
+    std::array<Stripe, cNumStripes> m_stripes;
+    std::atomic<uint64_t> m_next_id{0};
+    uint64_t m_max_id{};
+
+    // Size (in-memory) of the data contained in the dictionary
+    std::atomic<size_t> m_data_size{0};
+};
+
+// The writer must remain usable wherever `VariableDictionaryWriter` is, e.g., by
+// `EncodedVariableInterpreter`.
+static_assert(clp::VariableDictionaryWriterReq<ConcurrentVariableDictionaryWriter>);
+}  // namespace clp_s
+
+#endif  // CLP_S_CONCURRENTVARIABLEDICTIONARYWRITER_HPP
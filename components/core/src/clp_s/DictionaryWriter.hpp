@@ -4,6 +4,7 @@
 #define CLP_S_DICTIONARYWRITER_HPP
 
 #include <absl/container/flat_hash_map.h>
+#include <zstd.h>
 
 #include "../clp/Defs.h"
 #include "DictionaryEntry.hpp"
@@ -34,8 +35,14 @@ public:
      * @param dictionary_path
      * @param compression_level
      * @param max_id
+     * @param zstd_dictionary An optional trained zstd dictionary to compress the dictionary with
      */
-    void open(std::string const& dictionary_path, int compression_level, DictionaryIdType max_id);
+    void open(
+            std::string const& dictionary_path,
+            int compression_level,
+            DictionaryIdType max_id,
+            ZSTD_CDict const* zstd_dictionary = nullptr
+    );
 
     /**
      * Closes the dictionary
@@ -113,7 +120,8 @@ template <typename DictionaryIdType, typename EntryType>
 void DictionaryWriter<DictionaryIdType, EntryType>::open(
         std::string const& dictionary_path,
         int compression_level,
-        DictionaryIdType max_id
+        DictionaryIdType max_id,
+        ZSTD_CDict const* zstd_dictionary
 ) {
     if (m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
@@ -123,7 +131,7 @@ void DictionaryWriter<DictionaryIdType, EntryType>::open(
     // Write header
     m_dictionary_file_writer.write_numeric_value<uint64_t>(0);
     // Open compressor
-    m_dictionary_compressor.open(m_dictionary_file_writer, compression_level);
+    m_dictionary_compressor.open(m_dictionary_file_writer, compression_level, zstd_dictionary);
 
     m_next_id = 0;
     m_max_id = max_id;
@@ -38,6 +38,7 @@
 
 #if CLP_BUILD_CLP_S_ENABLE_CURL
     #include "../clp/aws/AwsAuthenticationSigner.hpp"
+    #include "../clp/NetworkRangeReader.hpp"
     #include "../clp/NetworkReader.hpp"
 #endif
 
@@ -191,6 +192,25 @@ auto could_be_json(char const* peek_buf, size_t peek_size) -> bool;
  */
 auto could_be_logtext(char const* peek_buf, size_t peek_size) -> bool;
 
+/**
+ * Tries to create a reader that streams the data at the given URL.
+ * @param url
+ * @param auth
+ * @return The opened reader, or nullptr on error.
+ */
+auto try_create_network_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface>;
+
+/**
+ * Tries to create a reader that fetches the data at the given URL using range requests, falling
+ * back to a streaming reader if the server doesn't support range requests.
+ * @param url
+ * @param auth
+ * @return The opened reader, or nullptr on error.
+ */
+auto try_create_network_range_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface>;
+
 auto try_create_file_reader(std::string_view const file_path)
         -> std::shared_ptr<clp::ReaderInterface> {
     try {
@@ -238,28 +258,56 @@ auto try_sign_url(std::string& url) -> bool {
     return true;
 }
 
-auto try_create_network_reader(std::string_view const url, NetworkAuthOption const& auth)
-        -> std::shared_ptr<clp::ReaderInterface> {
+auto try_get_request_url(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::optional<std::string> {
     std::string request_url{url};
     switch (auth.method) {
         case AuthMethod::S3PresignedUrlV4:
             if (false == try_sign_url(request_url)) {
-                return nullptr;
+                return std::nullopt;
             }
             break;
         case AuthMethod::None:
             break;
         default:
-            return nullptr;
+            return std::nullopt;
+    }
+    return request_url;
+}
+
+auto try_create_network_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    auto const request_url{try_get_request_url(url, auth)};
+    if (false == request_url.has_value()) {
+        return nullptr;
     }
 
     try {
-        return std::make_shared<clp::NetworkReader>(request_url);
+        return std::make_shared<clp::NetworkReader>(request_url.value());
     } catch (clp::NetworkReader::OperationFailed const& e) {
         SPDLOG_ERROR("Failed to open url for reading - {}", e.what());
         return nullptr;
     }
 }
+
+auto try_create_network_range_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    auto const request_url{try_get_request_url(url, auth)};
+    if (false == request_url.has_value()) {
+        return nullptr;
+    }
+
+    try {
+        return std::make_shared<clp::NetworkRangeReader>(request_url.value());
+    } catch (clp::NetworkRangeReader::OperationFailed const& e) {
+        if (clp::ErrorCode_Unsupported != e.get_error_code()) {
+            SPDLOG_ERROR("Failed to open url for reading - {}", e.what());
+            return nullptr;
+        }
+    }
+    SPDLOG_WARN("Server doesn't support range requests; falling back to streaming - {}", url);
+    return try_create_network_reader(url, auth);
+}
 #else
 auto try_create_network_reader(
         [[maybe_unused]] std::string_view const url,
@@ -268,6 +316,11 @@ auto try_create_network_reader(
     SPDLOG_ERROR("This build of clp-s does not support network inputs (libcurl excluded).");
     return nullptr;
 }
+
+auto try_create_network_range_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    return try_create_network_reader(url, auth);
+}
 #endif
 
 auto could_be_zstd(char const* peek_buf, size_t peek_size) -> bool {
@@ -515,6 +568,14 @@ auto try_create_reader(Path const& path, NetworkAuthOption const& network_auth)
     }
 }
 
+auto try_create_random_access_reader(Path const& path, NetworkAuthOption const& network_auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    if (InputSource::Network == path.source) {
+        return try_create_network_range_reader(path.path, network_auth);
+    }
+    return try_create_reader(path, network_auth);
+}
+
 [[nodiscard]] auto try_deduce_reader_type(std::shared_ptr<clp::ReaderInterface> reader)
         -> std::pair<std::vector<std::shared_ptr<clp::ReaderInterface>>, FileType> {
     constexpr size_t cFileReadBufferCapacity = 64 * 1024;  // 64 KiB
@@ -35,6 +35,7 @@ JsonConstructor::JsonConstructor(JsonConstructorOption const& option) : m_option
 
 void JsonConstructor::store() {
     m_archive_reader = std::make_unique<ArchiveReader>();
+    m_archive_reader->set_zstd_dictionary_registry(m_option.zstd_dictionaries);
     m_archive_reader->open(m_option.archive_path, m_option.network_auth);
     m_archive_reader->read_dictionaries_and_metadata();
 
@@ -46,7 +47,16 @@ void JsonConstructor::store() {
     }
 
     m_archive_reader->open_packed_streams();
-    if (false == m_option.ordered || false == m_archive_reader->has_log_order()) {
+    if (m_option.arrow) {
+        FileWriter writer;
+        writer.open(
+                m_option.output_dir + "/original.arrows",
+                FileWriter::OpenMode::CreateIfNonexistentForAppending
+        );
+        m_archive_reader->store_record_batches(writer);
+
+        writer.close();
+    } else if (false == m_option.ordered || false == m_archive_reader->has_log_order()) {
         FileWriter writer;
         writer.open(
                 m_option.output_dir + "/original",
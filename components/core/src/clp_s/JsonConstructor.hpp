@@ -1,6 +1,7 @@
 #ifndef CLP_S_JSONCONSTRUCTOR_HPP
 #define CLP_S_JSONCONSTRUCTOR_HPP
 
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
@@ -10,6 +11,7 @@
 #include "ErrorCode.hpp"
 #include "InputConfig.hpp"
 #include "TraceableException.hpp"
+#include "ZstdDictionaryRegistry.hpp"
 
 namespace clp_s {
 struct MetadataDbOption {
@@ -26,9 +28,11 @@ struct JsonConstructorOption {
     NetworkAuthOption network_auth{};
     std::string output_dir;
     bool ordered{false};
+    bool arrow{false};
     bool print_ordered_chunk_stats{false};
     size_t target_ordered_chunk_size{};
     std::optional<MetadataDbOption> metadata_db{std::nullopt};
+    std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries;
 };
 
 class JsonConstructor {
@@ -56,7 +60,8 @@ public:
     explicit JsonConstructor(JsonConstructorOption const& option);
 
     /**
-     * Decompresses each archive and stores the decompressed files in the output directory
+     * Decompresses each archive and stores the decompressed files in the output directory, either
+     * as JSON or, if `arrow` is set, as an Arrow IPC stream file.
      */
     void store();
 
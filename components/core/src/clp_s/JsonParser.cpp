@@ -53,6 +53,21 @@ namespace {
  */
 auto trim_trailing_whitespace(std::string_view str) -> std::string_view;
 
+/**
+ * Tokenizes a key naming a single column and unescapes each of its tokens.
+ * @param key
+ * @param key_description Describes the key's purpose in error messages.
+ * @param tokens Returns the key's unescaped tokens.
+ * @param descriptor_namespace Returns the key's namespace.
+ * @throw JsonParser::OperationFailed if the key is invalid or contains wildcards.
+ */
+auto tokenize_key(
+        std::string_view key,
+        std::string_view key_description,
+        std::vector<std::string>& tokens,
+        std::string& descriptor_namespace
+) -> void;
+
 /**
  * Checks whether marshalling a double value to a string using a specific format matches the
  * original floating point string.
@@ -129,6 +144,39 @@ auto trim_trailing_whitespace(std::string_view str) -> std::string_view {
     return str.substr(0ULL, substr_size);
 }
 
+auto tokenize_key(
+        std::string_view key,
+        std::string_view key_description,
+        std::vector<std::string>& tokens,
+        std::string& descriptor_namespace
+) -> void {
+    if (false
+        == clp_s::search::ast::tokenize_column_descriptor(
+                std::string{key},
+                tokens,
+                descriptor_namespace
+        ))
+    {
+        SPDLOG_ERROR("Can not parse invalid {} key: \"{}\"", key_description, key);
+        throw JsonParser::OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+
+    // Unescape individual tokens to match unescaped JSON and confirm there are no wildcards in the
+    // column.
+    auto column = clp_s::search::ast::ColumnDescriptor::create_from_escaped_tokens(
+            tokens,
+            descriptor_namespace
+    );
+    tokens.clear();
+    for (auto it = column->descriptor_begin(); it != column->descriptor_end(); ++it) {
+        if (it->wildcard()) {
+            SPDLOG_ERROR("Can not use wildcards in {} key: \"{}\"", key_description, key);
+            throw JsonParser::OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+        }
+        tokens.push_back(it->get_token());
+    }
+}
+
 auto round_trip_is_identical(std::string_view float_str, double value, float_format_t format)
         -> bool {
     auto const restore_result{restore_encoded_float(value, format)};
@@ -138,6 +186,7 @@ auto round_trip_is_identical(std::string_view float_str, double value, float_for
 
 JsonParser::JsonParser(JsonParserOption const& option)
         : m_target_encoded_size(option.target_encoded_size),
+          m_archive_flush_interval(option.archive_flush_interval_ms),
           m_max_document_size(option.max_document_size),
           m_timestamp_key(option.timestamp_key),
           m_structurize_arrays(option.structurize_arrays),
@@ -146,31 +195,16 @@ JsonParser::JsonParser(JsonParserOption const& option)
           m_input_paths_and_canonical_filenames{option.input_paths_and_canonical_filenames},
           m_network_auth(option.network_auth) {
     if (false == m_timestamp_key.empty()) {
-        if (false
-            == clp_s::search::ast::tokenize_column_descriptor(
-                    m_timestamp_key,
-                    m_timestamp_column,
-                    m_timestamp_namespace
-            ))
-        {
-            SPDLOG_ERROR("Can not parse invalid timestamp key: \"{}\"", m_timestamp_key);
-            throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
-        }
+        tokenize_key(m_timestamp_key, "timestamp", m_timestamp_column, m_timestamp_namespace);
+    }
 
-        // Unescape individual tokens to match unescaped JSON and confirm there are no wildcards in
-        // the timestamp column.
-        auto column = clp_s::search::ast::ColumnDescriptor::create_from_escaped_tokens(
-                m_timestamp_column,
-                m_timestamp_namespace
-        );
-        m_timestamp_column.clear();
-        for (auto it = column->descriptor_begin(); it != column->descriptor_end(); ++it) {
-            if (it->wildcard()) {
-                SPDLOG_ERROR("Timestamp key can not contain wildcards: \"{}\"", m_timestamp_key);
-                throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
-            }
-            m_timestamp_column.push_back(it->get_token());
+    if (false == option.sort_key.empty()) {
+        // Sorting reorders the records within each table, so their log order can't be recorded.
+        if (m_record_log_order) {
+            SPDLOG_ERROR("Can not sort records while recording log order.");
+            throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
         }
+        tokenize_key(option.sort_key, "sort", m_sort_column, m_sort_namespace);
     }
 
     m_archive_options.archives_dir = option.archives_dir;
@@ -181,9 +215,14 @@ JsonParser::JsonParser(JsonParserOption const& option)
     m_archive_options.id = m_generator();
     m_archive_options.authoritative_timestamp = m_timestamp_column;
     m_archive_options.authoritative_timestamp_namespace = m_timestamp_namespace;
+    m_archive_options.sort_key = m_sort_column;
+    m_archive_options.sort_key_namespace = m_sort_namespace;
+    m_archive_options.zstd_dictionaries = option.zstd_dictionaries;
+    m_archive_options.zstd_worker_options = option.zstd_worker_options;
 
     m_archive_writer = std::make_unique<ArchiveWriter>();
     m_archive_writer->open(m_archive_options);
+    m_archive_open_time = std::chrono::steady_clock::now();
 }
 
 void JsonParser::parse_obj_in_array(simdjson::ondemand::object line, int32_t parent_node_id) {
@@ -872,7 +911,7 @@ auto JsonParser::ingest_json(
                 ->append_message(current_schema_id, m_current_schema, m_current_parsed_message);
 
         bytes_consumed_up_to_prev_record = json_file_iterator.get_num_bytes_consumed();
-        if (m_archive_writer->get_data_size() >= m_target_encoded_size) {
+        if (should_split_archive()) {
             m_archive_writer->increment_uncompressed_size(
                     bytes_consumed_up_to_prev_record - bytes_consumed_up_to_prev_archive
             );
@@ -1050,7 +1089,7 @@ auto JsonParser::ingest_kvir(
                 return false;
             }
 
-            if (m_archive_writer->get_data_size() >= m_target_encoded_size) {
+            if (should_split_archive()) {
                 m_ir_node_to_archive_node_id_mapping.clear();
                 m_autogen_ir_node_to_archive_node_id_mapping.clear();
                 curr_pos = reader->get_pos();
@@ -1407,9 +1446,20 @@ auto JsonParser::store() -> std::vector<ArchiveStats> {
     return std::move(m_archive_stats);
 }
 
+auto JsonParser::should_split_archive() const -> bool {
+    if (m_archive_writer->get_data_size() >= m_target_encoded_size) {
+        return true;
+    }
+    // Closing archives on a time bound lets records ingested from a live source become searchable
+    // without waiting for the archive to fill up; closed archives are never rewritten.
+    return m_archive_flush_interval.count() > 0
+           && std::chrono::steady_clock::now() - m_archive_open_time >= m_archive_flush_interval;
+}
+
 void JsonParser::split_archive() {
     m_archive_stats.emplace_back(m_archive_writer->close(true));
     m_archive_options.id = m_generator();
     m_archive_writer->open(m_archive_options);
+    m_archive_open_time = std::chrono::steady_clock::now();
 }
 }  // namespace clp_s
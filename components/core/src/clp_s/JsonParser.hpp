@@ -1,6 +1,7 @@
 #ifndef CLP_S_JSONPARSER_HPP
 #define CLP_S_JSONPARSER_HPP
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -25,13 +26,21 @@
 #include <clp_s/Schema.hpp>
 #include <clp_s/SchemaTree.hpp>
 #include <clp_s/TraceableException.hpp>
+#include <clp_s/ZstdCompressor.hpp>
+#include <clp_s/ZstdDictionaryRegistry.hpp>
 
 namespace clp_s {
 struct JsonParserOption {
     std::vector<std::pair<Path, std::string>> input_paths_and_canonical_filenames;
     std::string timestamp_key;
+    // Key to sort the records within each table by; requires `record_log_order` to be false
+    std::string sort_key;
     std::string archives_dir;
     size_t target_encoded_size{};
+    // Maximum time (ms) an archive is kept open before it's closed and a new one is created, or 0
+    // to split archives by size alone. The bound is only checked as records are ingested, so it
+    // doesn't hold while the input is idle.
+    uint64_t archive_flush_interval_ms{0};
     size_t max_document_size{};
     size_t min_table_size{};
     int compression_level{};
@@ -41,6 +50,8 @@ struct JsonParserOption {
     bool retain_float_format{false};
     bool single_file_archive{false};
     NetworkAuthOption network_auth{};
+    std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries;
+    ZstdWorkerOptions zstd_worker_options;
 };
 
 class JsonParser {
@@ -73,7 +84,7 @@ public:
 private:
     /**
      * Parses JSON input and ingests it into the current archive, splitting the archive if it grows
-     * beyond the target encoded size.
+     * beyond the target encoded size or has been open longer than the flush interval.
      * @param reader
      * @param path
      * @param file_name_in_metadata
@@ -89,7 +100,7 @@ private:
 
     /**
      * Parses KV-IR input and ingests it into the current archive, splitting the archive if it grows
-     * beyond the target encoded size.
+     * beyond the target encoded size or has been open longer than the flush interval.
      * @param reader
      * @param path
      * @param file_name_in_metadata
@@ -203,7 +214,15 @@ private:
     void parse_obj_in_array(simdjson::ondemand::object line, int32_t parent_node_id);
 
     /**
-     * Splits the archive if the size of the archive exceeds the maximum size
+     * NOTE: This is only called after a record is ingested, so an archive stays open for as long
+     * as the input is idle, regardless of the flush interval.
+     * @return Whether the current archive has reached the target encoded size or has been open for
+     * longer than the flush interval.
+     */
+    [[nodiscard]] auto should_split_archive() const -> bool;
+
+    /**
+     * Closes the current archive and opens a new one.
      */
     void split_archive();
 
@@ -224,11 +243,15 @@ private:
     std::string m_timestamp_key;
     std::vector<std::string> m_timestamp_column;
     std::string m_timestamp_namespace;
+    std::vector<std::string> m_sort_column;
+    std::string m_sort_namespace;
 
     boost::uuids::random_generator m_generator;
     std::unique_ptr<ArchiveWriter> m_archive_writer;
     ArchiveWriterOption m_archive_options{};
     size_t m_target_encoded_size;
+    std::chrono::milliseconds m_archive_flush_interval;
+    std::chrono::steady_clock::time_point m_archive_open_time;
     size_t m_max_document_size;
     bool m_structurize_arrays{false};
     bool m_record_log_order{true};
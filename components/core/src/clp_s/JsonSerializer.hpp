@@ -47,6 +47,14 @@ public:
      */
     void reset() {
         m_json_string.clear();
+        reset_ops();
+    }
+
+    /**
+     * Resets the JsonSerializer for the next record without clearing the serialized string, so that
+     * the next record is appended after the previous ones.
+     */
+    void reset_ops() {
         m_op_list_index = 0;
         m_special_keys_index = 0;
     }
@@ -0,0 +1,299 @@
+#include "KvIrBlockIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ystdlib/error_handling/ErrorCode.hpp>
+#include <ystdlib/error_handling/Result.hpp>
+
+#include "../clp/ErrorCode.hpp"
+#include "../clp/ReaderInterface.hpp"
+#include "../clp/type_utils.hpp"
+#include "../clp/WriterInterface.hpp"
+#include "Defs.hpp"
+#include "filter/BloomFilter.hpp"
+
+using clp_s::KvIrBlockIndexErrorEnum;
+using KvIrBlockIndexErrorCategory = ystdlib::error_handling::ErrorCategory<KvIrBlockIndexErrorEnum>;
+
+namespace clp_s {
+namespace {
+constexpr char cTokenDelimiter{' '};
+
+/**
+ * Invokes `callback` on every non-empty, space-delimited token in `value`.
+ * @tparam Callback Signature: (std::string_view token) -> void
+ * @param value
+ * @param callback
+ */
+template <typename Callback>
+auto for_each_token(std::string_view value, Callback callback) -> void {
+    size_t token_begin{0};
+    while (token_begin < value.size()) {
+        auto token_end{value.find(cTokenDelimiter, token_begin)};
+        if (std::string_view::npos == token_end) {
+            token_end = value.size();
+        }
+        if (token_end > token_begin) {
+            callback(value.substr(token_begin, token_end - token_begin));
+        }
+        token_begin = token_end + 1;
+    }
+}
+
+/**
+ * Reads a length-prefixed byte sequence.
+ * @param reader
+ * @return A result containing the bytes on success, or an error code indicating the failure:
+ * - KvIrBlockIndexErrorEnum::ReadFailure if the bytes can't be read.
+ */
+[[nodiscard]] auto read_bytes(clp::ReaderInterface& reader)
+        -> ystdlib::error_handling::Result<std::vector<int8_t>> {
+    uint64_t size{};
+    if (clp::ErrorCode_Success != reader.try_read_numeric_value(size)) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+    }
+    std::vector<int8_t> bytes(static_cast<size_t>(size));
+    if (false == bytes.empty()
+        && clp::ErrorCode_Success
+                   != reader.try_read_exact_length(
+                           clp::size_checked_pointer_cast<char>(bytes.data()),
+                           bytes.size()
+                   ))
+    {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+    }
+    return bytes;
+}
+
+/**
+ * Writes a length-prefixed byte sequence.
+ * @param bytes
+ * @param writer
+ */
+auto write_bytes(std::vector<int8_t> const& bytes, clp::WriterInterface& writer) -> void {
+    writer.write_numeric_value<uint64_t>(bytes.size());
+    if (false == bytes.empty()) {
+        writer.write(clp::size_checked_pointer_cast<char const>(bytes.data()), bytes.size());
+    }
+}
+}  // namespace
+
+auto KvIrBlockIndexWriter::start_block(uint64_t stream_offset, std::vector<int8_t> sync_point)
+        -> ystdlib::error_handling::Result<void> {
+    if (m_is_block_started) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::BlockAlreadyStarted};
+    }
+    m_is_block_started = true;
+    m_block_stream_offset = stream_offset;
+    m_block_num_log_events = 0;
+    m_block_timestamp_range.reset();
+    m_block_sync_point = std::move(sync_point);
+    m_block_string_values.clear();
+    return ystdlib::error_handling::success();
+}
+
+auto KvIrBlockIndexWriter::add_log_event(std::optional<epochtime_t> timestamp) -> void {
+    ++m_block_num_log_events;
+    if (false == timestamp.has_value()) {
+        return;
+    }
+    auto const ts{timestamp.value()};
+    if (false == m_block_timestamp_range.has_value()) {
+        m_block_timestamp_range.emplace(ts, ts);
+        return;
+    }
+    auto& [min_ts, max_ts] = m_block_timestamp_range.value();
+    min_ts = std::min(min_ts, ts);
+    max_ts = std::max(max_ts, ts);
+}
+
+auto KvIrBlockIndexWriter::add_string_value(std::string_view value) -> void {
+    m_block_string_values.emplace(value);
+    for_each_token(value, [&](std::string_view token) -> void {
+        if (token.size() != value.size()) {
+            m_block_string_values.emplace(token);
+        }
+    });
+}
+
+auto KvIrBlockIndexWriter::end_block() -> ystdlib::error_handling::Result<void> {
+    if (false == m_is_block_started) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::BlockNotStarted};
+    }
+    m_is_block_started = false;
+    if (0 == m_block_num_log_events) {
+        return ystdlib::error_handling::success();
+    }
+
+    auto string_filter{YSTDLIB_ERROR_HANDLING_TRYX(
+            filter::BloomFilter::create(m_block_string_values.size(), m_false_positive_rate)
+    )};
+    for (auto const& value : m_block_string_values) {
+        string_filter.add(value);
+    }
+    m_blocks.emplace_back(
+            KvIrBlock{
+                    .stream_offset = m_block_stream_offset,
+                    .num_log_events = m_block_num_log_events,
+                    .timestamp_range = m_block_timestamp_range,
+                    .sync_point = std::move(m_block_sync_point),
+                    .string_filter = std::move(string_filter)
+            }
+    );
+    m_block_sync_point.clear();
+    m_block_string_values.clear();
+    return ystdlib::error_handling::success();
+}
+
+auto KvIrBlockIndexWriter::write(clp::WriterInterface& writer) const -> void {
+    writer.write(KvIrBlockIndex::cMagicNumber.data(), KvIrBlockIndex::cMagicNumber.size());
+    writer.write_numeric_value(KvIrBlockIndex::cFormatVersion);
+    writer.write_numeric_value<uint8_t>(m_is_stream_compressed ? 1 : 0);
+    write_bytes(m_preamble, writer);
+    writer.write_numeric_value<uint64_t>(m_blocks.size());
+    for (auto const& block : m_blocks) {
+        writer.write_numeric_value(block.stream_offset);
+        writer.write_numeric_value(block.num_log_events);
+        if (block.timestamp_range.has_value()) {
+            writer.write_numeric_value<uint8_t>(1);
+            writer.write_numeric_value(block.timestamp_range->first);
+            writer.write_numeric_value(block.timestamp_range->second);
+        } else {
+            writer.write_numeric_value<uint8_t>(0);
+        }
+        write_bytes(block.sync_point, writer);
+        block.string_filter.write(writer);
+    }
+}
+
+auto KvIrBlockIndex::try_read(clp::ReaderInterface& reader)
+        -> ystdlib::error_handling::Result<KvIrBlockIndex> {
+    std::string magic_number;
+    if (clp::ErrorCode_Success != reader.try_read_string(cMagicNumber.size(), magic_number)) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+    }
+    if (magic_number != cMagicNumber) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::CorruptIndex};
+    }
+
+    uint8_t version{};
+    if (clp::ErrorCode_Success != reader.try_read_numeric_value(version)) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+    }
+    if (cFormatVersion != version) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::UnsupportedVersion};
+    }
+
+    uint8_t is_stream_compressed{};
+    if (clp::ErrorCode_Success != reader.try_read_numeric_value(is_stream_compressed)) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+    }
+    auto preamble{YSTDLIB_ERROR_HANDLING_TRYX(read_bytes(reader))};
+
+    uint64_t num_blocks{};
+    if (clp::ErrorCode_Success != reader.try_read_numeric_value(num_blocks)) {
+        return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+    }
+    std::vector<KvIrBlock> blocks;
+    for (uint64_t i{0}; i < num_blocks; ++i) {
+        uint64_t stream_offset{};
+        uint64_t num_log_events{};
+        uint8_t has_timestamp_range{};
+        if (clp::ErrorCode_Success != reader.try_read_numeric_value(stream_offset)
+            || clp::ErrorCode_Success != reader.try_read_numeric_value(num_log_events)
+            || clp::ErrorCode_Success != reader.try_read_numeric_value(has_timestamp_range))
+        {
+            return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+        }
+
+        std::optional<std::pair<epochtime_t, epochtime_t>> timestamp_range;
+        if (0 != has_timestamp_range) {
+            epochtime_t min_ts{};
+            epochtime_t max_ts{};
+            if (clp::ErrorCode_Success != reader.try_read_numeric_value(min_ts)
+                || clp::ErrorCode_Success != reader.try_read_numeric_value(max_ts))
+            {
+                return KvIrBlockIndexError{KvIrBlockIndexErrorEnum::ReadFailure};
+            }
+            timestamp_range.emplace(min_ts, max_ts);
+        }
+
+        auto sync_point{YSTDLIB_ERROR_HANDLING_TRYX(read_bytes(reader))};
+        auto string_filter{YSTDLIB_ERROR_HANDLING_TRYX(filter::BloomFilter::try_read(reader))};
+        blocks.emplace_back(
+                KvIrBlock{
+                        .stream_offset = stream_offset,
+                        .num_log_events = num_log_events,
+                        .timestamp_range = timestamp_range,
+                        .sync_point = std::move(sync_point),
+                        .string_filter = std::move(string_filter)
+                }
+        );
+    }
+
+    return KvIrBlockIndex{std::move(preamble), 0 != is_stream_compressed, std::move(blocks)};
+}
+
+auto KvIrBlockIndex::get_candidate_blocks(
+        std::optional<epochtime_t> begin_ts,
+        std::optional<epochtime_t> end_ts,
+        std::vector<std::string> const& required_values
+) const -> std::vector<size_t> {
+    std::vector<size_t> candidate_blocks;
+    for (size_t block_idx{0}; block_idx < m_blocks.size(); ++block_idx) {
+        auto const& block{m_blocks[block_idx]};
+        // Blocks without any timestamps are kept since timestamp filters don't apply to log events
+        // without timestamps (they're returned when searching a stream without an index).
+        if ((begin_ts.has_value() || end_ts.has_value()) && block.timestamp_range.has_value()) {
+            auto const [min_ts, max_ts] = block.timestamp_range.value();
+            if ((begin_ts.has_value() && max_ts < begin_ts.value())
+                || (end_ts.has_value() && min_ts > end_ts.value()))
+            {
+                continue;
+            }
+        }
+
+        auto const contains_all_required_values{std::ranges::all_of(
+                required_values,
+                [&](std::string const& value) -> bool {
+                    return block.string_filter.possibly_contains(value);
+                }
+        )};
+        if (contains_all_required_values) {
+            candidate_blocks.emplace_back(block_idx);
+        }
+    }
+    return candidate_blocks;
+}
+}  // namespace clp_s
+
+template <>
+auto KvIrBlockIndexErrorCategory::name() const noexcept -> char const* {
+    return "clp_s::KvIrBlockIndex";
+}
+
+template <>
+auto KvIrBlockIndexErrorCategory::message(KvIrBlockIndexErrorEnum error_enum) const
+        -> std::string {
+    switch (error_enum) {
+        case KvIrBlockIndexErrorEnum::BlockNotStarted:
+            return "No block has been started.";
+        case KvIrBlockIndexErrorEnum::BlockAlreadyStarted:
+            return "The previous block hasn't been ended.";
+        case KvIrBlockIndexErrorEnum::CorruptIndex:
+            return "The block index is corrupt.";
+        case KvIrBlockIndexErrorEnum::ReadFailure:
+            return "Failed to read the block index.";
+        case KvIrBlockIndexErrorEnum::UnsupportedVersion:
+            return "Unsupported block index format version.";
+        default:
+            return "Unknown error.";
+    }
+}
@@ -0,0 +1,214 @@
+#ifndef CLP_S_KVIRBLOCKINDEX_HPP
+#define CLP_S_KVIRBLOCKINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <ystdlib/error_handling/ErrorCode.hpp>
+#include <ystdlib/error_handling/Result.hpp>
+
+#include "../clp/ReaderInterface.hpp"
+#include "../clp/WriterInterface.hpp"
+#include "Defs.hpp"
+#include "filter/BloomFilter.hpp"
+
+namespace clp_s {
+enum class KvIrBlockIndexErrorEnum : uint8_t {
+    BlockNotStarted = 1,
+    BlockAlreadyStarted,
+    CorruptIndex,
+    ReadFailure,
+    UnsupportedVersion,
+};
+
+using KvIrBlockIndexError = ystdlib::error_handling::ErrorCode<KvIrBlockIndexErrorEnum>;
+
+// File extension of the sidecar index written next to a kv-pair IR stream
+constexpr std::string_view cKvIrBlockIndexFileExtension{".blkidx"};
+
+/**
+ * A block of log events in a kv-pair IR stream, as described by a `KvIrBlockIndex`.
+ *
+ * Every block starts at a position in the on-disk stream where a reader can start reading
+ * independently of the preceding bytes (for zstd-compressed streams, the start of a zstd frame).
+ * The block's sync point restores the deserializer's schema-tree and UTC offset state at the
+ * start of the block (see `clp::ffi::ir_stream::Serializer::serialize_sync_point`).
+ */
+struct KvIrBlock {
+    uint64_t stream_offset{0};
+    uint64_t num_log_events{0};
+    std::optional<std::pair<epochtime_t, epochtime_t>> timestamp_range;
+    std::vector<int8_t> sync_point;
+    filter::BloomFilter string_filter;
+};
+
+/**
+ * Builds the sidecar block index for a kv-pair IR stream while the stream is being written.
+ *
+ * Callers are expected to:
+ * - call `start_block` at a position where the on-disk stream can be read independently (e.g.,
+ *   right after ending a zstd frame);
+ * - call `add_log_event` (and `add_string_value`) for every log event in the block;
+ * - call `end_block` before starting the next block or writing the index.
+ *
+ * Each string value is inserted into the block's Bloom filter both as a whole and split into its
+ * space-delimited tokens, so that both exact-value and token-bounded wildcard queries can prune
+ * blocks.
+ */
+class KvIrBlockIndexWriter {
+public:
+    // Constants
+    static constexpr size_t cDefaultTargetBlockSize{4ULL * 1024ULL * 1024ULL};  // 4 MiB
+    static constexpr double cDefaultFalsePositiveRate{0.01};
+
+    // Constructor
+    /**
+     * @param preamble The serialized preamble (magic number and metadata) of the IR stream.
+     * @param is_stream_compressed Whether the on-disk stream is zstd-compressed.
+     * @param false_positive_rate The target false-positive rate of each block's Bloom filter.
+     */
+    KvIrBlockIndexWriter(
+            std::vector<int8_t> preamble,
+            bool is_stream_compressed,
+            double false_positive_rate = cDefaultFalsePositiveRate
+    )
+            : m_preamble{std::move(preamble)},
+              m_is_stream_compressed{is_stream_compressed},
+              m_false_positive_rate{false_positive_rate} {}
+
+    // Methods
+    /**
+     * Starts a new block.
+     * @param stream_offset The offset of the block's first byte in the on-disk stream.
+     * @param sync_point The serialized sync point for the block.
+     * @return A void result on success, or an error code indicating the failure:
+     * - KvIrBlockIndexErrorEnum::BlockAlreadyStarted if the previous block hasn't been ended.
+     */
+    [[nodiscard]] auto start_block(uint64_t stream_offset, std::vector<int8_t> sync_point)
+            -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Records a log event in the current block.
+     * @param timestamp The log event's timestamp in epoch milliseconds, if any.
+     */
+    auto add_log_event(std::optional<epochtime_t> timestamp) -> void;
+
+    /**
+     * Records a string value of a log event in the current block.
+     * @param value
+     */
+    auto add_string_value(std::string_view value) -> void;
+
+    /**
+     * Ends the current block and builds its Bloom filter. Empty blocks are discarded.
+     * @return A void result on success, or an error code indicating the failure:
+     * - KvIrBlockIndexErrorEnum::BlockNotStarted if no block has been started.
+     * - Forwards `filter::BloomFilter::create`'s return values on failure.
+     */
+    [[nodiscard]] auto end_block() -> ystdlib::error_handling::Result<void>;
+
+    [[nodiscard]] auto is_block_started() const -> bool { return m_is_block_started; }
+
+    [[nodiscard]] auto get_num_blocks() const -> size_t { return m_blocks.size(); }
+
+    /**
+     * Writes the index to the given writer.
+     * @param writer
+     */
+    auto write(clp::WriterInterface& writer) const -> void;
+
+private:
+    std::vector<int8_t> m_preamble;
+    bool m_is_stream_compressed;
+    double m_false_positive_rate;
+    std::vector<KvIrBlock> m_blocks;
+
+    // State of the current block
+    bool m_is_block_started{false};
+    uint64_t m_block_stream_offset{0};
+    uint64_t m_block_num_log_events{0};
+    std::optional<std::pair<epochtime_t, epochtime_t>> m_block_timestamp_range;
+    std::vector<int8_t> m_block_sync_point;
+    std::unordered_set<std::string> m_block_string_values;
+};
+
+/**
+ * The sidecar block index of a kv-pair IR stream.
+ *
+ * Serialized format (integers are little-endian):
+ * - magic number (`cMagicNumber`) and format version (uint8_t)
+ * - whether the stream is zstd-compressed (uint8_t)
+ * - preamble size (uint64_t) followed by the preamble bytes
+ * - number of blocks (uint64_t), followed by, for each block:
+ *   - stream offset (uint64_t) and number of log events (uint64_t)
+ *   - whether the block has a timestamp range (uint8_t), followed by the min and max timestamps
+ *     (int64_t) if so
+ *   - sync point size (uint64_t) followed by the sync point bytes
+ *   - the block's Bloom filter (see `filter::BloomFilter::write`)
+ */
+class KvIrBlockIndex {
+public:
+    // Constants
+    static constexpr std::string_view cMagicNumber{"KVIRBIDX"};
+    static constexpr uint8_t cFormatVersion{1};
+
+    // Factory function
+    /**
+     * Reads an index from the given reader.
+     * @param reader
+     * @return A result containing the index on success, or an error code indicating the failure:
+     * - KvIrBlockIndexErrorEnum::ReadFailure if the index is truncated or can't be read.
+     * - KvIrBlockIndexErrorEnum::CorruptIndex if the magic number is invalid.
+     * - KvIrBlockIndexErrorEnum::UnsupportedVersion if the format version is unsupported.
+     * - Forwards `filter::BloomFilter::try_read`'s return values on failure.
+     */
+    [[nodiscard]] static auto try_read(clp::ReaderInterface& reader)
+            -> ystdlib::error_handling::Result<KvIrBlockIndex>;
+
+    // Methods
+    [[nodiscard]] auto get_preamble() const -> std::vector<int8_t> const& { return m_preamble; }
+
+    [[nodiscard]] auto is_stream_compressed() const -> bool { return m_is_stream_compressed; }
+
+    [[nodiscard]] auto get_blocks() const -> std::vector<KvIrBlock> const& { return m_blocks; }
+
+    /**
+     * Finds the blocks that may contain log events matching the given constraints. Blocks without
+     * any timestamps are never excluded by the timestamp bounds.
+     * @param begin_ts Inclusive lower bound on timestamps, if any.
+     * @param end_ts Inclusive upper bound on timestamps, if any.
+     * @param required_values String values (or tokens) that every matching log event must contain.
+     * @return The indices of the candidate blocks, in stream order.
+     */
+    [[nodiscard]] auto get_candidate_blocks(
+            std::optional<epochtime_t> begin_ts,
+            std::optional<epochtime_t> end_ts,
+            std::vector<std::string> const& required_values
+    ) const -> std::vector<size_t>;
+
+private:
+    // Constructor
+    KvIrBlockIndex(
+            std::vector<int8_t> preamble,
+            bool is_stream_compressed,
+            std::vector<KvIrBlock> blocks
+    )
+            : m_preamble{std::move(preamble)},
+              m_is_stream_compressed{is_stream_compressed},
+              m_blocks{std::move(blocks)} {}
+
+    std::vector<int8_t> m_preamble;
+    bool m_is_stream_compressed;
+    std::vector<KvIrBlock> m_blocks;
+};
+}  // namespace clp_s
+
+YSTDLIB_ERROR_HANDLING_MARK_AS_ERROR_CODE_ENUM(clp_s::KvIrBlockIndexErrorEnum);
+
+#endif  // CLP_S_KVIRBLOCKINDEX_HPP
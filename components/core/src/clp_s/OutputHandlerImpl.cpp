@@ -1,5 +1,12 @@
 #include "OutputHandlerImpl.hpp"
 
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -18,7 +25,11 @@
 
 #include "../clp/networking/socket_utils.hpp"
 #include "../reducer/CountOperator.hpp"
+#include "../reducer/DistinctCountOperator.hpp"
 #include "../reducer/network_utils.hpp"
+#include "../reducer/Operator.hpp"
+#include "../reducer/Pipeline.hpp"
+#include "../reducer/QuantilesOperator.hpp"
 #include "../reducer/Record.hpp"
 #include "archive_constants.hpp"
 #include "search/OutputHandler.hpp"
@@ -28,6 +39,54 @@ using std::string;
 using std::string_view;
 
 namespace clp_s {
+namespace {
+/**
+ * Sends a partial sketch to the reducer as a single record group, in the form the given operator
+ * merges.
+ * @param reducer_socket_fd
+ * @param op The reducer operator that merges the sketch.
+ * @param sketch_key The key of the sketch element in the operator's records.
+ * @param serialized_sketch
+ * @return Whether the sketch was sent successfully.
+ */
+auto send_partial_sketch(
+        int reducer_socket_fd,
+        std::shared_ptr<reducer::Operator> const& op,
+        char const* sketch_key,
+        std::vector<uint8_t> const& serialized_sketch
+) -> bool;
+
+auto send_partial_sketch(
+        int reducer_socket_fd,
+        std::shared_ptr<reducer::Operator> const& op,
+        char const* sketch_key,
+        std::vector<uint8_t> const& serialized_sketch
+) -> bool {
+    reducer::Pipeline pipeline{reducer::PipelineInputMode::IntraStage};
+    pipeline.add_pipeline_stage(op);
+    reducer::SingleBinaryRecordAdapter record{sketch_key};
+    record.set_record_value(serialized_sketch);
+    pipeline.push_record(record);
+    return reducer::send_pipeline_results(reducer_socket_fd, pipeline.finish());
+}
+}  // namespace
+
+void StandardOutputHandler::write_batch(string_view messages, size_t num_messages) {
+    // Keep the batch ordered after anything previously written through `std::cout`
+    std::cout.flush();
+    while (false == messages.empty()) {
+        auto const num_bytes_written{::write(STDOUT_FILENO, messages.data(), messages.size())};
+        if (num_bytes_written < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            SPDLOG_ERROR("Failed to write search results to stdout, errno={}", errno);
+            throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+        }
+        messages.remove_prefix(static_cast<size_t>(num_bytes_written));
+    }
+}
+
 void FileOutputHandler::write(
         string_view message,
         epochtime_t timestamp,
@@ -70,6 +129,74 @@ void NetworkOutputHandler::write(
     }
 }
 
+ArrowOutputHandler::ArrowOutputHandler(
+        CommandLineArguments::ArrowOutputHandlerOptions const& options
+)
+        : ::clp_s::search::OutputHandler(false, true) {
+    if (false == options.output_path.empty()) {
+        m_file_writer.open(
+                options.output_path,
+                FileWriter::OpenMode::CreateIfNonexistentForAppending
+        );
+        return;
+    }
+    m_socket_fd = clp::networking::connect_to_server(options.host, std::to_string(options.port));
+    if (-1 == m_socket_fd) {
+        SPDLOG_ERROR("Failed to connect to the server, errno={}", errno);
+        throw OperationFailed(ErrorCode::ErrorCodeFailureNetwork, __FILENAME__, __LINE__);
+    }
+}
+
+ArrowOutputHandler::~ArrowOutputHandler() {
+    if (-1 != m_socket_fd) {
+        close(m_socket_fd);
+    }
+    m_file_writer.close();
+}
+
+void ArrowOutputHandler::write_record_batch(ArrowRecordBatchBuilder const& record_batch) {
+    if (false == m_is_stream_open) {
+        record_batch.serialize_schema(m_buffer);
+        m_is_stream_open = true;
+    }
+    record_batch.serialize_record_batch(m_buffer);
+    if (auto const error_code{write_buffer()}; ErrorCode::ErrorCodeSuccess != error_code) {
+        throw OperationFailed(error_code, __FILENAME__, __LINE__);
+    }
+}
+
+auto ArrowOutputHandler::flush() -> ErrorCode {
+    if (false == m_is_stream_open) {
+        return ErrorCode::ErrorCodeSuccess;
+    }
+    m_is_stream_open = false;
+    ArrowRecordBatchBuilder::serialize_end_of_stream(m_buffer);
+    return write_buffer();
+}
+
+auto ArrowOutputHandler::write_buffer() -> ErrorCode {
+    if (-1 == m_socket_fd) {
+        m_file_writer.write(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+        return ErrorCode::ErrorCodeSuccess;
+    }
+
+    string_view remaining{m_buffer};
+    while (false == remaining.empty()) {
+        auto const num_bytes_sent{send(m_socket_fd, remaining.data(), remaining.size(), 0)};
+        if (num_bytes_sent < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            SPDLOG_ERROR("Failed to send Arrow record batches, errno={}", errno);
+            return ErrorCode::ErrorCodeFailureNetwork;
+        }
+        remaining.remove_prefix(static_cast<size_t>(num_bytes_sent));
+    }
+    m_buffer.clear();
+    return ErrorCode::ErrorCodeSuccess;
+}
+
 ResultsCacheOutputHandler::ResultsCacheOutputHandler(
         string_view uri,
         string_view collection,
@@ -212,4 +339,40 @@ auto CountByTimeReducerOutputHandler::finish() -> ErrorCode {
     }
     return ErrorCode::ErrorCodeSuccess;
 }
+
+auto DistinctCountReducerOutputHandler::finish() -> ErrorCode {
+    if (0 == m_aggregator.get_sketch().estimate()) {
+        // Nothing matched, so there's no partial result to send
+        return ErrorCode::ErrorCodeSuccess;
+    }
+    if (false
+        == send_partial_sketch(
+                m_reducer_socket_fd,
+                std::make_shared<reducer::DistinctCountOperator>(),
+                static_cast<char const*>(reducer::DistinctCountOperator::cSketchKey),
+                m_aggregator.get_sketch().serialize()
+        ))
+    {
+        return ErrorCode::ErrorCodeFailureNetwork;
+    }
+    return ErrorCode::ErrorCodeSuccess;
+}
+
+auto QuantilesReducerOutputHandler::finish() -> ErrorCode {
+    if (m_aggregator.get_sketch().empty()) {
+        // Nothing matched, so there's no partial result to send
+        return ErrorCode::ErrorCodeSuccess;
+    }
+    if (false
+        == send_partial_sketch(
+                m_reducer_socket_fd,
+                std::make_shared<reducer::QuantilesOperator>(),
+                static_cast<char const*>(reducer::QuantilesOperator::cSketchKey),
+                m_aggregator.get_sketch().serialize()
+        ))
+    {
+        return ErrorCode::ErrorCodeFailureNetwork;
+    }
+    return ErrorCode::ErrorCodeSuccess;
+}
 }  // namespace clp_s
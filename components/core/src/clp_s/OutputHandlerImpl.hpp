@@ -26,6 +26,7 @@
 
 #include "../reducer/Pipeline.hpp"
 #include "../reducer/RecordGroupIterator.hpp"
+#include "ArrowRecordBatch.hpp"
 #include "Defs.hpp"
 #include "FileWriter.hpp"
 #include "search/OutputHandler.hpp"
@@ -37,6 +38,14 @@ namespace clp_s {
  */
 class StandardOutputHandler : public ::clp_s::search::OutputHandler {
 public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
     // Constructors
     explicit StandardOutputHandler(bool should_output_metadata = false)
             : ::clp_s::search::OutputHandler(should_output_metadata, true) {}
@@ -52,6 +61,15 @@ public:
     }
 
     void write(std::string_view message) override { std::cout << message; }
+
+    /**
+     * Writes the batch straight to the stdout file descriptor to avoid copying it through
+     * `std::cout`'s buffer.
+     * @param messages
+     * @param num_messages
+     * @throw OperationFailed if writing to stdout fails.
+     */
+    void write_batch(std::string_view messages, size_t num_messages) override;
 };
 
 /**
@@ -82,6 +100,65 @@ private:
     FileWriter m_file_writer;
 };
 
+/**
+ * Output handler that writes matched records as Arrow record batches to a file or network
+ * destination.
+ *
+ * The output is a sequence of Arrow IPC streams, one for each table with matches, since the schema
+ * of an IPC stream can't change. Files are appended to so that the results from every searched
+ * archive are kept.
+ */
+class ArrowOutputHandler : public ::clp_s::search::OutputHandler {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    explicit ArrowOutputHandler(CommandLineArguments::ArrowOutputHandlerOptions const& options);
+
+    // Destructor
+    ~ArrowOutputHandler() override;
+
+    // Methods inherited from OutputHandler
+    void write(
+            std::string_view message,
+            epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) override {}
+
+    void write(std::string_view message) override {}
+
+    void write_record_batch(ArrowRecordBatchBuilder const& record_batch) override;
+
+    /**
+     * Ends the IPC stream for the table that was just searched, if any of its records matched.
+     * @return ErrorCodeSuccess on success or relevant error code on error
+     */
+    [[nodiscard]] auto flush() -> ErrorCode override;
+
+    [[nodiscard]] auto should_output_record_batches() const -> bool override { return true; }
+
+private:
+    // Methods
+    /**
+     * Writes the contents of `m_buffer` to the destination and clears it.
+     * @return ErrorCodeSuccess on success or relevant error code on error
+     */
+    [[nodiscard]] auto write_buffer() -> ErrorCode;
+
+    // Variables
+    FileWriter m_file_writer;
+    int m_socket_fd{-1};
+    std::string m_buffer;
+    bool m_is_stream_open{false};
+};
+
 /**
  * Output handler that writes to a network destination.
  */
@@ -290,6 +367,88 @@ private:
     int64_t m_count_by_time_bucket_size_millisecs;
 };
 
+/**
+ * Output handler that estimates the number of distinct values of a field and sends the partial
+ * HyperLogLog sketch to a reducer, which merges the sketches from every search worker.
+ */
+class DistinctCountReducerOutputHandler : public search::OutputHandler {
+public:
+    // Constructors
+    DistinctCountReducerOutputHandler(int reducer_socket_fd, DistinctCountAggregator aggregator)
+            : search::OutputHandler{
+                      DistinctCountAggregator::cNeedsMetadata,
+                      DistinctCountAggregator::cNeedsMarshalledRecord
+              },
+              m_reducer_socket_fd{reducer_socket_fd},
+              m_aggregator{std::move(aggregator)} {}
+
+    // Methods implementing OutputHandler
+    auto write(
+            std::string_view message,
+            epochtime_t timestamp_millisecs,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) -> void override {
+        m_aggregator.add_record(message, timestamp_millisecs);
+    }
+
+    auto write(std::string_view message) -> void override { m_aggregator.add_record(message, 0); }
+
+    // Methods overriding OutputHandler
+    /**
+     * Flushes the sketch.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailureNetwork on network error
+     */
+    auto finish() -> ErrorCode override;
+
+private:
+    // Data members
+    int m_reducer_socket_fd;
+    DistinctCountAggregator m_aggregator;
+};
+
+/**
+ * Output handler that estimates the percentiles of a numeric field and sends the partial t-digest
+ * to a reducer, which merges the digests from every search worker.
+ */
+class QuantilesReducerOutputHandler : public search::OutputHandler {
+public:
+    // Constructors
+    QuantilesReducerOutputHandler(int reducer_socket_fd, QuantilesAggregator aggregator)
+            : search::OutputHandler{
+                      QuantilesAggregator::cNeedsMetadata,
+                      QuantilesAggregator::cNeedsMarshalledRecord
+              },
+              m_reducer_socket_fd{reducer_socket_fd},
+              m_aggregator{std::move(aggregator)} {}
+
+    // Methods implementing OutputHandler
+    auto write(
+            std::string_view message,
+            epochtime_t timestamp_millisecs,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) -> void override {
+        m_aggregator.add_record(message, timestamp_millisecs);
+    }
+
+    auto write(std::string_view message) -> void override { m_aggregator.add_record(message, 0); }
+
+    // Methods overriding OutputHandler
+    /**
+     * Flushes the digest.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailureNetwork on network error
+     */
+    auto finish() -> ErrorCode override;
+
+private:
+    // Data members
+    int m_reducer_socket_fd;
+    QuantilesAggregator m_aggregator;
+};
+
 /**
  * Output handler that runs an `Aggregation` and writes its results to an `AggregationSink`.
  * @tparam AggT The type of aggregator to run.
@@ -386,8 +545,8 @@ public:
     };
 
     // Constructors
-    VectorOutputHandler(std::vector<QueryResult>& output)
-            : search::OutputHandler{true, true},
+    VectorOutputHandler(std::vector<QueryResult>& output, bool should_output_metadata = true)
+            : search::OutputHandler{should_output_metadata, true},
               m_output(output) {}
 
     // Methods inherited from OutputHandler
@@ -74,6 +74,9 @@ void PackedStreamReader::open_packed_streams(std::shared_ptr<ArchiveReaderAdapto
     }
     m_adaptor = adaptor;
     m_packed_stream_reader = m_adaptor->checkout_reader_for_section(constants::cArchiveTablesFile);
+    m_packed_stream_decompressor.set_dictionary(
+            m_adaptor->get_zstd_dictionary(constants::cArchiveTablesFile)
+    );
     if (auto rc = m_packed_stream_reader->try_get_pos(m_begin_offset);
         clp::ErrorCode::ErrorCode_Success != rc)
     {
@@ -142,6 +145,7 @@ PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf,
     if ((stream_id + 1) < m_stream_metadata.size()) {
         end_pos = m_begin_offset + m_stream_metadata[stream_id + 1].file_offset;
     }
+    m_adaptor->prefetch(adjusted_file_offset, end_pos);
     clp::BoundedReader bounded_reader{m_packed_stream_reader.get(), end_pos};
 
     m_packed_stream_decompressor.open(bounded_reader, cDecompressorFileReadBufferCapacity);
@@ -14,6 +14,9 @@ std::shared_ptr<SchemaTree> ReaderUtils::read_schema_tree(ArchiveReaderAdaptor&
 
     auto schema_tree_reader
             = adaptor.checkout_reader_for_section(constants::cArchiveSchemaTreeFile);
+    schema_tree_decompressor.set_dictionary(
+            adaptor.get_zstd_dictionary(constants::cArchiveSchemaTreeFile)
+    );
     schema_tree_decompressor.open(*schema_tree_reader, cDecompressorFileReadBufferCapacity);
 
     uint64_t num_nodes{0};
@@ -92,6 +95,9 @@ std::shared_ptr<ReaderUtils::SchemaMap> ReaderUtils::read_schemas(ArchiveReaderA
     ZstdDecompressor schema_id_decompressor;
 
     auto schema_id_reader = adaptor.checkout_reader_for_section(constants::cArchiveSchemaMapFile);
+    schema_id_decompressor.set_dictionary(
+            adaptor.get_zstd_dictionary(constants::cArchiveSchemaMapFile)
+    );
     schema_id_decompressor.open(*schema_id_reader, cDecompressorFileReadBufferCapacity);
 
     uint64_t schema_size{0};
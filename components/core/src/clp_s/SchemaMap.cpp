@@ -17,7 +17,11 @@ int32_t SchemaMap::add_schema(Schema const& schema) {
     return m_current_schema_id++;
 }
 
-size_t SchemaMap::store(std::string const& archives_dir, int compression_level) {
+size_t SchemaMap::store(
+        std::string const& archives_dir,
+        int compression_level,
+        ZSTD_CDict const* zstd_dictionary
+) {
     FileWriter schema_map_writer;
     ZstdCompressor schema_map_compressor;
 
@@ -26,7 +30,7 @@ size_t SchemaMap::store(std::string const& archives_dir, int compression_level)
             archives_dir + constants::cArchiveSchemaMapFile,
             FileWriter::OpenMode::CreateForWriting
     );
-    schema_map_compressor.open(schema_map_writer, compression_level);
+    schema_map_compressor.open(schema_map_writer, compression_level, zstd_dictionary);
     schema_map_compressor.write_numeric_value(static_cast<uint64_t>(m_schema_map.size()));
     for (auto const& schema_mapping : m_schema_map) {
         auto const& schema = schema_mapping.first;
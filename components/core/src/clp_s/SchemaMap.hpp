@@ -4,6 +4,8 @@
 #include <map>
 #include <string>
 
+#include <zstd.h>
+
 #include "Schema.hpp"
 
 namespace clp_s {
@@ -26,9 +28,14 @@ public:
      * Write the contents of the SchemaMap to the schema map file
      * @param archives_dir
      * @param compression_level
+     * @param zstd_dictionary An optional trained zstd dictionary to compress the map with
      * @return the compressed size of the SchemaMap in bytes
      */
-    [[nodiscard]] size_t store(std::string const& archives_dir, int compression_level);
+    [[nodiscard]] size_t store(
+            std::string const& archives_dir,
+            int compression_level,
+            ZSTD_CDict const* zstd_dictionary = nullptr
+    );
 
     /**
      * Clear the schema map
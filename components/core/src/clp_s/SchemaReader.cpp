@@ -76,6 +76,12 @@ SchemaReader::load(std::shared_ptr<char[]> stream_buffer, size_t offset, size_t
 
 auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
     m_json_serializer.reset();
+    append_json_string(message_index);
+    return m_json_serializer.get_serialized_string();
+}
+
+void SchemaReader::append_json_string(uint64_t message_index) {
+    m_json_serializer.reset_ops();
     m_json_serializer.begin_document();
     size_t column_id_index = 0;
     BaseColumnReader* column;
@@ -208,23 +214,26 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
     }
 
     m_json_serializer.end_document();
-    return m_json_serializer.get_serialized_string();
 }
 
-bool SchemaReader::get_next_message(std::string& message) {
-    if (m_cur_message >= m_num_messages) {
-        return false;
-    }
-
+void SchemaReader::marshal_message(uint64_t message_index, std::string& message) {
     if (false == m_serializer_initialized) {
         initialize_serializer();
     }
-    message = generate_json_string(m_cur_message);
+    m_json_serializer.reset();
+    append_json_string(message_index);
+    auto& serialized_message{m_json_serializer.get_serialized_string()};
+    serialized_message += '\n';
+    message.assign(serialized_message);
+}
 
-    if (message.back() != '\n') {
-        message += '\n';
+bool SchemaReader::get_next_message(std::string& message) {
+    if (m_cur_message >= m_num_messages) {
+        return false;
     }
 
+    marshal_message(m_cur_message, message);
+
     ++m_cur_message;
     return true;
 }
@@ -239,14 +248,7 @@ bool SchemaReader::get_next_message(std::string& message, FilterClass& filter) {
     }
 
     if (m_should_marshal_records) {
-        if (false == m_serializer_initialized) {
-            initialize_serializer();
-        }
-        message = generate_json_string(m_cur_message);
-
-        if (message.back() != '\n') {
-            message += '\n';
-        }
+        marshal_message(m_cur_message, message);
     }
 
     ++m_cur_message;
@@ -263,14 +265,7 @@ bool SchemaReader::get_next_message_with_metadata(
     }
 
     if (m_should_marshal_records) {
-        if (false == m_serializer_initialized) {
-            initialize_serializer();
-        }
-        message = generate_json_string(m_cur_message);
-
-        if (message.back() != '\n') {
-            message += '\n';
-        }
+        marshal_message(m_cur_message, message);
     }
 
     timestamp = m_get_timestamp();
@@ -297,14 +292,7 @@ bool SchemaReader::get_next_message_with_metadata(
     }
 
     if (m_should_marshal_records) {
-        if (false == m_serializer_initialized) {
-            initialize_serializer();
-        }
-        message = generate_json_string(m_cur_message);
-
-        if (message.back() != '\n') {
-            message += '\n';
-        }
+        marshal_message(m_cur_message, message);
     }
 
     timestamp = m_get_timestamp();
@@ -314,6 +302,144 @@ bool SchemaReader::get_next_message_with_metadata(
     return true;
 }
 
+size_t SchemaReader::get_next_messages(std::string& buffer, size_t target_buffer_size) {
+    return get_next_messages(buffer, target_buffer_size, nullptr);
+}
+
+size_t SchemaReader::get_next_messages(
+        std::string& buffer,
+        size_t target_buffer_size,
+        FilterClass& filter
+) {
+    return get_next_messages(buffer, target_buffer_size, &filter);
+}
+
+size_t SchemaReader::get_next_messages(
+        std::string& buffer,
+        size_t target_buffer_size,
+        FilterClass* filter
+) {
+    bool const should_marshal_records{nullptr == filter || m_should_marshal_records};
+    if (should_marshal_records && false == m_serializer_initialized) {
+        initialize_serializer();
+    }
+
+    // Serialize directly into the caller's buffer so that messages are never copied out of the
+    // serializer
+    auto& serialized_messages{m_json_serializer.get_serialized_string()};
+    serialized_messages.swap(buffer);
+    size_t num_messages{0};
+    try {
+        while (m_cur_message < m_num_messages
+               && (false == should_marshal_records
+                   || serialized_messages.size() < target_buffer_size))
+        {
+            if (nullptr != filter && false == filter->filter(m_cur_message)) {
+                ++m_cur_message;
+                continue;
+            }
+            if (should_marshal_records) {
+                append_json_string(m_cur_message);
+                serialized_messages += '\n';
+            }
+            ++m_cur_message;
+            ++num_messages;
+        }
+    } catch (...) {
+        serialized_messages.swap(buffer);
+        throw;
+    }
+    serialized_messages.swap(buffer);
+    return num_messages;
+}
+
+void SchemaReader::initialize_record_batch_builder(ArrowRecordBatchBuilder& builder) {
+    initialize_local_schema_tree();
+    m_record_batch_columns.clear();
+    if (auto subtree_root = m_local_schema_tree.get_object_subtree_node_id_for_namespace(
+                constants::cDefaultNamespace
+        );
+        -1 != subtree_root)
+    {
+        generate_record_batch_schema(subtree_root, -1, builder);
+    }
+}
+
+size_t SchemaReader::get_next_record_batch_rows(
+        ArrowRecordBatchBuilder& builder,
+        size_t target_batch_size
+) {
+    return get_next_record_batch_rows(builder, target_batch_size, nullptr);
+}
+
+size_t SchemaReader::get_next_record_batch_rows(
+        ArrowRecordBatchBuilder& builder,
+        size_t target_batch_size,
+        FilterClass& filter
+) {
+    return get_next_record_batch_rows(builder, target_batch_size, &filter);
+}
+
+size_t SchemaReader::get_next_record_batch_rows(
+        ArrowRecordBatchBuilder& builder,
+        size_t target_batch_size,
+        FilterClass* filter
+) {
+    size_t num_rows{0};
+    while (m_cur_message < m_num_messages && builder.get_buffered_size() < target_batch_size) {
+        if (nullptr != filter && false == filter->filter(m_cur_message)) {
+            ++m_cur_message;
+            continue;
+        }
+        for (size_t i{0}; i < m_record_batch_columns.size(); ++i) {
+            auto const column_id{static_cast<int32_t>(i)};
+            auto* column{m_record_batch_columns[i]};
+            switch (builder.get_column_type(column_id)) {
+                case ArrowType::Int64:
+                    builder.append_int64(
+                            column_id,
+                            std::get<int64_t>(column->extract_value(m_cur_message))
+                    );
+                    break;
+                case ArrowType::Float64:
+                    builder.append_float64(
+                            column_id,
+                            std::get<double>(column->extract_value(m_cur_message))
+                    );
+                    break;
+                case ArrowType::Bool:
+                    builder.append_bool(
+                            column_id,
+                            0 != std::get<uint8_t>(column->extract_value(m_cur_message))
+                    );
+                    break;
+                case ArrowType::Utf8:
+                    column->extract_string_value_into_buffer(
+                            m_cur_message,
+                            builder.get_utf8_data(column_id)
+                    );
+                    builder.finish_utf8_value(column_id);
+                    break;
+                case ArrowType::Timestamp:
+                    builder.append_int64(
+                            column_id,
+                            static_cast<TimestampColumnReader*>(column)->get_encoded_time(
+                                    m_cur_message
+                            )
+                    );
+                    break;
+                case ArrowType::Null:
+                case ArrowType::Struct:
+                    break;
+            }
+        }
+        builder.finish_row();
+        ++m_cur_message;
+        ++num_rows;
+    }
+    return num_rows;
+}
+
 void SchemaReader::initialize_filter(FilterClass& filter) {
     filter.init(this, m_columns);
 }
@@ -629,6 +755,25 @@ void SchemaReader::initialize_serializer() {
     }
 
     m_serializer_initialized = true;
+    initialize_local_schema_tree();
+
+    // TODO: this code will have to change once we allow mixing log lines parsed by different
+    // parsers and if we add support for serializing auto-generated keys in regular JSON.
+    if (auto subtree_root = m_local_schema_tree.get_object_subtree_node_id_for_namespace(
+                constants::cDefaultNamespace
+        );
+        -1 != subtree_root)
+    {
+        generate_json_template(subtree_root);
+    }
+}
+
+void SchemaReader::initialize_local_schema_tree() {
+    if (m_local_schema_tree_initialized) {
+        return;
+    }
+
+    m_local_schema_tree_initialized = true;
 
     for (int32_t global_column_id : m_ordered_schema) {
         if (m_projection->matches_node(global_column_id)) {
@@ -644,16 +789,6 @@ void SchemaReader::initialize_serializer() {
             generate_local_tree(it->first);
         }
     }
-
-    // TODO: this code will have to change once we allow mixing log lines parsed by different
-    // parsers and if we add support for serializing auto-generated keys in regular JSON.
-    if (auto subtree_root = m_local_schema_tree.get_object_subtree_node_id_for_namespace(
-                constants::cDefaultNamespace
-        );
-        -1 != subtree_root)
-    {
-        generate_json_template(subtree_root);
-    }
 }
 
 void SchemaReader::generate_json_template(int32_t id) {
@@ -738,4 +873,57 @@ void SchemaReader::generate_json_template(int32_t id) {
         }
     }
 }
+
+void SchemaReader::generate_record_batch_schema(
+        int32_t id,
+        int32_t parent_column_id,
+        ArrowRecordBatchBuilder& builder
+) {
+    auto const& node = m_local_schema_tree.get_node(id);
+    for (int32_t child_id : node.get_children_ids()) {
+        int32_t child_global_id = m_local_id_to_global_id[child_id];
+        auto const& child_node = m_local_schema_tree.get_node(child_id);
+        auto key = child_node.get_key_name();
+        auto add_column = [&](ArrowType type, BaseColumnReader* column) -> int32_t {
+            m_record_batch_columns.push_back(column);
+            return builder.add_column(key, type, parent_column_id);
+        };
+        switch (child_node.get_type()) {
+            case NodeType::Object: {
+                auto const column_id{add_column(ArrowType::Struct, nullptr)};
+                generate_record_batch_schema(child_id, column_id, builder);
+                break;
+            }
+            case NodeType::StructuredArray:
+                throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+            case NodeType::DeltaInteger:
+            case NodeType::Integer:
+                add_column(ArrowType::Int64, m_column_map.at(child_global_id));
+                break;
+            case NodeType::Float:
+            case NodeType::FormattedFloat:
+            case NodeType::DictionaryFloat:
+                add_column(ArrowType::Float64, m_column_map.at(child_global_id));
+                break;
+            case NodeType::Boolean:
+                add_column(ArrowType::Bool, m_column_map.at(child_global_id));
+                break;
+            case NodeType::ClpString:
+            case NodeType::VarString:
+            case NodeType::DeprecatedDateString:
+            case NodeType::UnstructuredArray:
+                add_column(ArrowType::Utf8, m_column_map.at(child_global_id));
+                break;
+            case NodeType::Timestamp:
+                add_column(ArrowType::Timestamp, m_column_map.at(child_global_id));
+                break;
+            case NodeType::NullValue:
+                add_column(ArrowType::Null, nullptr);
+                break;
+            case NodeType::Metadata:
+            case NodeType::Unknown:
+                break;
+        }
+    }
+}
 }  // namespace clp_s
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "ArrowRecordBatch.hpp"
 #include "ColumnReader.hpp"
 #include "FileReader.hpp"
 #include "JsonSerializer.hpp"
@@ -56,6 +57,10 @@ public:
                 : TraceableException(error_code, filename, line_number) {}
     };
 
+    // Constants
+    // Size (B) at which a batch of marshalled messages is handed back to the caller
+    static constexpr size_t cDefaultTargetBatchSize{256ULL * 1024};  // 256 KiB
+
     /**
      * Metadata describing one schema table entry.
      *
@@ -150,7 +155,9 @@ public:
         m_global_id_to_local_id.clear();
         m_global_id_to_unordered_object.clear();
         m_local_schema_tree.clear();
+        m_local_schema_tree_initialized = false;
         m_json_serializer.clear();
+        m_record_batch_columns.clear();
         m_global_schema_tree = std::move(schema_tree);
         m_projection = std::move(projection);
         m_should_marshal_records = should_marshal_records;
@@ -195,6 +202,19 @@ public:
      */
     uint64_t get_num_messages() const { return m_num_messages; }
 
+    /**
+     * @return The column readers in the order their columns appear in the schema, with the columns
+     * of unordered objects last.
+     */
+    [[nodiscard]] auto get_columns() const -> std::vector<BaseColumnReader*> const& {
+        return m_columns;
+    }
+
+    /**
+     * @return The number of column readers that don't belong to unordered objects.
+     */
+    [[nodiscard]] auto get_num_ordered_columns() const -> size_t { return m_column_map.size(); }
+
     /**
      * Generates a JSON string from the encoded columns
      * @param message_index The index of the message to generate the JSON string for.
@@ -245,6 +265,61 @@ public:
             FilterClass& filter
     );
 
+    /**
+     * Marshals the next messages directly into `buffer`, each terminated by a newline, until
+     * `buffer` reaches `target_buffer_size` or there are no more messages. This avoids allocating
+     * and copying a string per message.
+     * @param buffer The buffer to append messages to. Its existing contents are preserved.
+     * @param target_buffer_size
+     * @return The number of messages appended
+     */
+    size_t get_next_messages(std::string& buffer, size_t target_buffer_size);
+
+    /**
+     * Marshals the next messages matching a filter directly into `buffer`, each terminated by a
+     * newline, until `buffer` reaches `target_buffer_size` or there are no more messages. If
+     * records aren't being marshalled, `buffer` is left unchanged and all remaining matching
+     * messages are consumed.
+     * @param buffer The buffer to append messages to. Its existing contents are preserved.
+     * @param target_buffer_size
+     * @param filter
+     * @return The number of matching messages
+     */
+    size_t get_next_messages(std::string& buffer, size_t target_buffer_size, FilterClass& filter);
+
+    /**
+     * Adds the projected columns of this table to `builder`'s schema so that messages can be
+     * converted to Arrow record batches. Objects are converted to structs, timestamps to
+     * nanosecond timestamps, and values without a native Arrow equivalent (e.g., unstructured
+     * arrays) to strings formatted as they would be in JSON.
+     * @param builder A builder with no columns.
+     * @throw OperationFailed if the table contains structured arrays, which aren't supported.
+     */
+    void initialize_record_batch_builder(ArrowRecordBatchBuilder& builder);
+
+    /**
+     * Appends the next messages to `builder` as rows until its buffered size reaches
+     * `target_batch_size` or there are no more messages.
+     * @param builder A builder initialized with `initialize_record_batch_builder`.
+     * @param target_batch_size
+     * @return The number of rows appended
+     */
+    size_t get_next_record_batch_rows(ArrowRecordBatchBuilder& builder, size_t target_batch_size);
+
+    /**
+     * Appends the next messages matching a filter to `builder` as rows until its buffered size
+     * reaches `target_batch_size` or there are no more messages.
+     * @param builder A builder initialized with `initialize_record_batch_builder`.
+     * @param target_batch_size
+     * @param filter
+     * @return The number of rows appended
+     */
+    size_t get_next_record_batch_rows(
+            ArrowRecordBatchBuilder& builder,
+            size_t target_batch_size,
+            FilterClass& filter
+    );
+
     /**
      * Initializes the filter
      * @param filter
@@ -310,12 +385,29 @@ private:
      */
     void generate_local_tree(int32_t global_id);
 
+    /**
+     * Generates the local schema tree containing the projected columns of this table.
+     */
+    void initialize_local_schema_tree();
+
     /**
      * Generates a json template
      * @param id
      */
     void generate_json_template(int32_t id);
 
+    /**
+     * Adds the children of a local schema tree node to a record batch builder's schema
+     * @param id
+     * @param parent_column_id The builder column corresponding to the node, or -1 for the root.
+     * @param builder
+     */
+    void generate_record_batch_schema(
+            int32_t id,
+            int32_t parent_column_id,
+            ArrowRecordBatchBuilder& builder
+    );
+
     /**
      * Generates a json template for a structured array
      * @param id
@@ -365,6 +457,43 @@ private:
             std::vector<int32_t>& path_to_intersection
     );
 
+    /**
+     * Appends the JSON string for a message to the serializer's buffer, after any messages already
+     * in it.
+     * @param message_index
+     */
+    void append_json_string(uint64_t message_index);
+
+    /**
+     * Marshals a message into the given string, terminated by a newline.
+     * @param message_index
+     * @param message Reassigned rather than replaced so that it keeps its capacity across calls.
+     */
+    void marshal_message(uint64_t message_index, std::string& message);
+
+    /**
+     * Implements `get_next_messages` for an optional filter.
+     * @param buffer
+     * @param target_buffer_size
+     * @param filter The filter messages must match, or nullptr to accept all messages.
+     * @return The number of messages consumed
+     */
+    size_t
+    get_next_messages(std::string& buffer, size_t target_buffer_size, FilterClass* filter);
+
+    /**
+     * Implements `get_next_record_batch_rows` for an optional filter.
+     * @param builder
+     * @param target_batch_size
+     * @param filter The filter messages must match, or nullptr to accept all messages.
+     * @return The number of rows appended
+     */
+    size_t get_next_record_batch_rows(
+            ArrowRecordBatchBuilder& builder,
+            size_t target_batch_size,
+            FilterClass* filter
+    );
+
     int32_t m_schema_id;
     uint64_t m_num_messages;
     uint64_t m_cur_message;
@@ -381,6 +510,7 @@ private:
 
     std::shared_ptr<SchemaTree> m_global_schema_tree;
     SchemaTree m_local_schema_tree;
+    bool m_local_schema_tree_initialized{false};
     std::unordered_map<int32_t, int32_t> m_global_id_to_local_id;
     std::unordered_map<int32_t, int32_t> m_local_id_to_global_id;
 
@@ -389,6 +519,10 @@ private:
     bool m_serializer_initialized{false};
     std::shared_ptr<search::Projection> m_projection;
 
+    // The column reader for each column of the record batch builder, or nullptr for struct and
+    // null columns
+    std::vector<BaseColumnReader*> m_record_batch_columns;
+
     std::map<int32_t, std::pair<size_t, std::span<int32_t>>> m_global_id_to_unordered_object;
 };
 }  // namespace clp_s
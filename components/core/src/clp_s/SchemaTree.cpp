@@ -94,7 +94,11 @@ int32_t SchemaTree::get_metadata_field_id(std::string_view const field_name) con
     return -1;
 }
 
-auto SchemaTree::store(std::string const& archives_dir, int compression_level) -> size_t {
+auto SchemaTree::store(
+        std::string const& archives_dir,
+        int compression_level,
+        ZSTD_CDict const* zstd_dictionary
+) -> size_t {
     FileWriter schema_tree_writer;
     ZstdCompressor schema_tree_compressor;
 
@@ -102,7 +106,7 @@ auto SchemaTree::store(std::string const& archives_dir, int compression_level) -
             archives_dir + constants::cArchiveSchemaTreeFile,
             FileWriter::OpenMode::CreateForWriting
     );
-    schema_tree_compressor.open(schema_tree_writer, compression_level);
+    schema_tree_compressor.open(schema_tree_writer, compression_level, zstd_dictionary);
 
     schema_tree_compressor.write_numeric_value(static_cast<uint64_t>(m_nodes.size()));
     for (auto const& node : m_nodes) {
@@ -12,6 +12,7 @@
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
+#include <zstd.h>
 
 #include "archive_constants.hpp"
 #include "search/ast/Literal.hpp"
@@ -189,9 +190,14 @@ public:
      * Write the contents of the SchemaTree to the schema tree file
      * @param archives_dir
      * @param compression_level
+     * @param zstd_dictionary An optional trained zstd dictionary to compress the tree with
      * @return the compressed size of the SchemaTree in bytes
      */
-    [[nodiscard]] auto store(std::string const& archives_dir, int compression_level) -> size_t;
+    [[nodiscard]] auto store(
+            std::string const& archives_dir,
+            int compression_level,
+            ZSTD_CDict const* zstd_dictionary = nullptr
+    ) -> size_t;
 
     /**
      * Clear the schema tree
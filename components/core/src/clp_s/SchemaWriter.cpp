@@ -1,18 +1,97 @@
 #include "SchemaWriter.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/EncodedTextAst.hpp>
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+
+#include "Defs.hpp"
+#include "FloatFormatEncoding.hpp"
+#include "ParsedMessage.hpp"
+#include "SchemaTree.hpp"
 
 namespace clp_s {
+namespace {
+/**
+ * @param value
+ * @param column_type The type of the column `value` belongs to.
+ * @return The key to sort `value`'s message by.
+ * @throw clp::ffi::ir_stream::DecodingException if `value` is an encoded text AST that can't be
+ * decoded.
+ */
+auto get_sort_key(ParsedMessage::variable_t const& value, NodeType column_type)
+        -> SchemaWriter::sort_key_t;
+
+auto get_sort_key(ParsedMessage::variable_t const& value, NodeType column_type)
+        -> SchemaWriter::sort_key_t {
+    return std::visit(
+            [&](auto const& typed_value) -> SchemaWriter::sort_key_t {
+                using value_t = std::decay_t<decltype(typed_value)>;
+                if constexpr (std::is_same_v<value_t, bool>) {
+                    return static_cast<int64_t>(typed_value);
+                } else if constexpr (std::is_same_v<value_t, std::pair<epochtime_t, uint64_t>>
+                                     || std::is_same_v<value_t, std::pair<double, float_format_t>>)
+                {
+                    return typed_value.first;
+                } else if constexpr (std::is_same_v<value_t, clp::ffi::EightByteEncodedTextAst>
+                                     || std::is_same_v<value_t, clp::ffi::FourByteEncodedTextAst>)
+                {
+                    auto result{typed_value.to_string()};
+                    if (result.has_error()) {
+                        auto const error{result.error()};
+                        throw clp::ffi::ir_stream::DecodingException(
+                                clp::ErrorCode_Failure,
+                                __FILENAME__,
+                                __LINE__,
+                                fmt::format("{}: {}", error.category().name(), error.message())
+                        );
+                    }
+                    return std::move(result.value());
+                } else if constexpr (std::is_same_v<value_t, std::string>) {
+                    // Dictionary floats keep their original text so they can be decompressed
+                    // losslessly, but they must still be compared as numbers. `strtod` (unlike
+                    // `stod`) doesn't throw on values that underflow to subnormals.
+                    if (NodeType::DictionaryFloat == column_type) {
+                        return std::strtod(typed_value.c_str(), nullptr);
+                    }
+                    return typed_value;
+                } else {
+                    return typed_value;
+                }
+            },
+            value
+    );
+}
+}  // namespace
+
 void SchemaWriter::append_column(std::unique_ptr<BaseColumnWriter> column_writer) {
     m_total_uncompressed_size += column_writer->get_total_header_size();
     m_columns.emplace_back(std::move(column_writer));
 }
 
 size_t SchemaWriter::append_message(ParsedMessage& message) {
-    int count{};
+    size_t count{};
     size_t total_size{};
     for (auto& i : message.get_content()) {
         total_size += m_columns[count]->add_value(i.second);
+        if (m_sort_column_idx == count) {
+            m_sort_keys.emplace_back(get_sort_key(i.second, m_sort_column_type));
+        }
+        if (m_timestamp_column_idx == count) {
+            m_timestamps.push_back(std::get<std::pair<epochtime_t, uint64_t>>(i.second).first);
+        }
         ++count;
     }
 
@@ -26,6 +105,52 @@ size_t SchemaWriter::append_message(ParsedMessage& message) {
     return total_size;
 }
 
+void SchemaWriter::sort_messages() {
+    if (m_sort_keys.empty()) {
+        return;
+    }
+
+    std::vector<size_t> order(m_sort_keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return m_sort_keys[lhs] < m_sort_keys[rhs];
+    });
+    m_sort_keys.clear();
+    if (std::is_sorted(order.begin(), order.end())) {
+        return;
+    }
+
+    for (auto& writer : m_columns) {
+        writer->reorder(order);
+    }
+    if (false == m_timestamps.empty()) {
+        std::vector<epochtime_t> timestamps;
+        timestamps.reserve(m_timestamps.size());
+        for (auto const idx : order) {
+            timestamps.push_back(m_timestamps[idx]);
+        }
+        m_timestamps = std::move(timestamps);
+    }
+}
+
+auto SchemaWriter::get_row_group_timestamp_bounds(uint64_t row_group_size) const
+        -> std::vector<epochtime_t> {
+    std::vector<epochtime_t> bounds;
+    if (0 == row_group_size) {
+        return bounds;
+    }
+    for (size_t begin{0}; begin < m_timestamps.size(); begin += row_group_size) {
+        auto const end{std::min<size_t>(begin + row_group_size, m_timestamps.size())};
+        auto const [min_it, max_it] = std::minmax_element(
+                m_timestamps.begin() + static_cast<std::ptrdiff_t>(begin),
+                m_timestamps.begin() + static_cast<std::ptrdiff_t>(end)
+        );
+        bounds.push_back(*min_it);
+        bounds.push_back(*max_it);
+    }
+    return bounds;
+}
+
 void SchemaWriter::store(ZstdCompressor& compressor) {
     for (auto& writer : m_columns) {
         writer->store(compressor);
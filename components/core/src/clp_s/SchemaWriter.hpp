@@ -1,17 +1,27 @@
 #ifndef CLP_S_SCHEMAWRITER_HPP
 #define CLP_S_SCHEMAWRITER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <variant>
 #include <vector>
 
 #include "ColumnWriter.hpp"
+#include "Defs.hpp"
 #include "FileWriter.hpp"
+#include "SchemaTree.hpp"
 #include "ParsedMessage.hpp"
 #include "ZstdCompressor.hpp"
 
 namespace clp_s {
 class SchemaWriter {
 public:
+    // Types
+    using sort_key_t = std::variant<int64_t, double, std::string>;
+
     // Constructor
     SchemaWriter() : m_num_messages(0) {}
 
@@ -31,6 +41,27 @@ public:
      */
     void append_column(std::unique_ptr<BaseColumnWriter> column_writer);
 
+    [[nodiscard]] auto get_num_columns() const -> size_t { return m_columns.size(); }
+
+    /**
+     * Sets the column to sort messages by when `sort_messages` is called. Must be called before any
+     * message is appended.
+     * @param column_idx
+     * @param column_type The type of the column's node, used to compare values by what they
+     * represent rather than how they're stored (e.g., dictionary floats are stored as strings).
+     */
+    void set_sort_column(size_t column_idx, NodeType column_type) {
+        m_sort_column_idx = column_idx;
+        m_sort_column_type = column_type;
+    }
+
+    /**
+     * Sets the column containing the authoritative timestamp, whose range is tracked for every row
+     * group. Must be called before any message is appended.
+     * @param column_idx
+     */
+    void set_timestamp_column(size_t column_idx) { m_timestamp_column_idx = column_idx; }
+
     /**
      * Appends a message to the schema writer.
      * @param message
@@ -38,6 +69,20 @@ public:
      */
     size_t append_message(ParsedMessage& message);
 
+    /**
+     * Sorts the appended messages by the value of the sort column, keeping messages with equal
+     * values in the order they were appended. Does nothing if no sort column was set.
+     */
+    void sort_messages();
+
+    /**
+     * @param row_group_size The number of consecutive messages in each row group.
+     * @return The minimum and maximum timestamp in each row group, flattened as
+     * `[min_0, max_0, min_1, max_1, ...]`, or an empty vector if no timestamp column was set.
+     */
+    [[nodiscard]] auto get_row_group_timestamp_bounds(uint64_t row_group_size) const
+            -> std::vector<epochtime_t>;
+
     /**
      * Stores the columns to disk.
      * @param compressor
@@ -56,6 +101,12 @@ private:
     size_t m_total_uncompressed_size{};
 
     std::vector<std::unique_ptr<BaseColumnWriter>> m_columns;
+
+    std::optional<size_t> m_sort_column_idx;
+    NodeType m_sort_column_type{NodeType::Unknown};
+    std::vector<sort_key_t> m_sort_keys;
+    std::optional<size_t> m_timestamp_column_idx;
+    std::vector<epochtime_t> m_timestamps;
 };
 }  // namespace clp_s
 
@@ -4,6 +4,7 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <map>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -103,7 +104,9 @@ enum struct ArchiveMetadataPacketType : uint8_t {
     ArchiveInfo = 0,
     ArchiveFileInfo = 1,
     TimestampDictionary = 2,
-    RangeIndex = 3
+    RangeIndex = 3,
+    ZstdDictionaries = 4,
+    RowGroupTimestampIndex = 5
 };
 
 struct ArchiveInfoPacket {
@@ -125,6 +128,29 @@ struct ArchiveFileInfoPacket {
 
     MSGPACK_DEFINE_MAP(files);
 };
+
+/**
+ * Maps each archive section compressed with a trained zstd dictionary to the ID of that
+ * dictionary. Sections that don't appear in the map were compressed without a dictionary.
+ */
+struct ZstdDictionariesPacket {
+    std::map<std::string, uint32_t> dictionary_ids;
+
+    MSGPACK_DEFINE_MAP(dictionary_ids);
+};
+
+/**
+ * Records the range of the authoritative timestamp in every row group of each schema table, where
+ * a row group is a run of `row_group_size` consecutive records in a table. Each schema ID maps to
+ * the minimum and maximum epoch timestamp of its row groups, flattened as
+ * `[min_0, max_0, min_1, max_1, ...]`. Tables without a timestamp column don't appear in the map.
+ */
+struct RowGroupTimestampIndexPacket {
+    uint64_t row_group_size;
+    std::map<int32_t, std::vector<int64_t>> timestamp_bounds;
+
+    MSGPACK_DEFINE_MAP(row_group_size, timestamp_bounds);
+};
 }  // namespace clp_s
 
 #endif  // CLP_S_ARCHIVEDEFS_HPP
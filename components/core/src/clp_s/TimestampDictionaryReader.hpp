@@ -63,6 +63,16 @@ public:
             std::string& buffer
     ) const;
 
+    /**
+     * @param format_id
+     * @return The timestamp pattern referenced by `format_id`.
+     * @throws std::out_of_range if no pattern is referenced by `format_id`.
+     */
+    [[nodiscard]] auto get_timestamp_pattern(uint64_t format_id) const
+            -> timestamp_parser::TimestampPattern const& {
+        return m_timestamp_patterns.at(format_id);
+    }
+
     /**
      * Gets iterators for the column to range mappings
      * @return begin and end iterators for the column to range mappings
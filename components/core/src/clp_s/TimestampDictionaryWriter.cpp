@@ -187,6 +187,41 @@ auto TimestampDictionaryWriter::ingest_unknown_precision_epoch_timestamp(
     return {epoch_timestamp, pattern_it->second.second};
 }
 
+auto TimestampDictionaryWriter::ingest_parsed_timestamp(
+        std::string_view key,
+        int32_t node_id,
+        epochtime_t timestamp,
+        timestamp_parser::TimestampPattern const& pattern
+) -> std::pair<epochtime_t, uint64_t> {
+    auto& [_, timestamp_entry] = *m_column_id_to_range.try_emplace(node_id, key, node_id).first;
+    timestamp_entry.ingest_timestamp(timestamp);
+
+    auto const raw_pattern{pattern.get_pattern()};
+    if (false == pattern.is_quoted_pattern()) {
+        std::string numeric_pattern{raw_pattern};
+        auto pattern_it{m_numeric_pattern_to_id.find(numeric_pattern)};
+        if (m_numeric_pattern_to_id.end() == pattern_it) {
+            auto const new_pattern_id{m_next_id++};
+            pattern_it = m_numeric_pattern_to_id
+                                 .emplace(
+                                         std::move(numeric_pattern),
+                                         std::make_pair(pattern, new_pattern_id)
+                                 )
+                                 .first;
+        }
+        return {timestamp, pattern_it->second.second};
+    }
+
+    for (auto const& [quoted_pattern, pattern_id] : m_string_pattern_and_id_pairs) {
+        if (quoted_pattern.get_pattern() == raw_pattern) {
+            return {timestamp, pattern_id};
+        }
+    }
+    auto const new_pattern_id{m_next_id++};
+    m_string_pattern_and_id_pairs.emplace_back(pattern, new_pattern_id);
+    return {timestamp, new_pattern_id};
+}
+
 epochtime_t TimestampDictionaryWriter::get_begin_timestamp() const {
     auto it = m_column_id_to_range.begin();
     if (m_column_id_to_range.end() == it) {
@@ -88,6 +88,24 @@ public:
             int64_t timestamp
     ) -> std::pair<epochtime_t, uint64_t>;
 
+    /**
+     * Ingests a timestamp that has already been parsed with a known pattern, e.g., a timestamp read
+     * from another archive.
+     * @param key
+     * @param node_id
+     * @param timestamp The timestamp in epoch nanoseconds.
+     * @param pattern
+     * @return A pair containing:
+     * - The timestamp in epoch nanoseconds.
+     * - The pattern ID corresponding to `pattern` in this dictionary.
+     */
+    [[nodiscard]] auto ingest_parsed_timestamp(
+            std::string_view key,
+            int32_t node_id,
+            epochtime_t timestamp,
+            timestamp_parser::TimestampPattern const& pattern
+    ) -> std::pair<epochtime_t, uint64_t>;
+
     /**
      * @return The beginning of this archive's time range as milliseconds since the UNIX epoch
      */
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <optional>
 #include <set>
 
 #include <boost/url.hpp>
@@ -13,6 +14,7 @@
 #include <string_utils/string_utils.hpp>
 
 #if CLP_BUILD_CLP_S_ENABLE_CURL
+    #include "../clp/NetworkRangeReader.hpp"
     #include "../clp/NetworkReader.hpp"
 #endif
 #include "archive_constants.hpp"
@@ -154,16 +156,32 @@ bool FileUtils::get_last_non_empty_path_component(std::string_view const path, s
 }
 
 #if CLP_BUILD_CLP_S_ENABLE_CURL
+namespace {
+/**
+ * @param reader
+ * @return CURL error info if the reader is a `clp::NetworkReader` or `clp::NetworkRangeReader` that
+ * has encountered a CURL error, or std::nullopt otherwise.
+ */
+auto get_curl_error_info(clp::ReaderInterface const* reader)
+        -> std::optional<clp::NetworkReader::CurlErrorInfo> {
+    if (auto const* network_reader{dynamic_cast<clp::NetworkReader const*>(reader)};
+        nullptr != network_reader)
+    {
+        return network_reader->get_curl_error_info();
+    }
+    if (auto const* range_reader{dynamic_cast<clp::NetworkRangeReader const*>(reader)};
+        nullptr != range_reader)
+    {
+        return range_reader->get_curl_error_info();
+    }
+    return std::nullopt;
+}
+}  // namespace
+
 auto
 NetworkUtils::check_and_log_curl_error(std::string_view path, clp::ReaderInterface const* reader)
         -> bool {
-    auto const* network_reader{dynamic_cast<clp::NetworkReader const*>(reader)};
-    if (nullptr == network_reader) {
-        return false;
-    }
-    if (auto const curl_error_info = network_reader->get_curl_error_info();
-        curl_error_info.has_value())
-    {
+    if (auto const curl_error_info = get_curl_error_info(reader); curl_error_info.has_value()) {
         SPDLOG_ERROR(
                 "Encountered curl error while reading {} - Code: {} - Message: {}",
                 path,
@@ -176,11 +194,7 @@ NetworkUtils::check_and_log_curl_error(std::string_view path, clp::ReaderInterfa
 }
 
 auto NetworkUtils::is_retryable_curl_error(clp::ReaderInterface const* reader) -> bool {
-    auto const* network_reader{dynamic_cast<clp::NetworkReader const*>(reader)};
-    if (nullptr == network_reader) {
-        return false;
-    }
-    auto const curl_error_info = network_reader->get_curl_error_info();
+    auto const curl_error_info = get_curl_error_info(reader);
     if (false == curl_error_info.has_value()) {
         return false;
     }
@@ -54,8 +54,9 @@ public:
 class NetworkUtils {
 public:
     /**
-     * Checks if a reader is a `clp::NetworkReader` that has encountered a CURL error, and logs
-     * relevant CURL error information if a CURL error has occurred.
+     * Checks if a reader is a `clp::NetworkReader` or `clp::NetworkRangeReader` that has
+     * encountered a CURL error, and logs relevant CURL error information if a CURL error has
+     * occurred.
      * @param path The path that the reader has opened.
      * @param reader The open reader which may have experienced a CURL error.
      * @return Whether a CURL error has occurred on the reader.
@@ -64,8 +65,9 @@ public:
     check_and_log_curl_error(std::string_view path, clp::ReaderInterface const* reader) -> bool;
 
     /**
-     * Checks if a reader is a `clp::NetworkReader` that has encountered a transient (retryable)
-     * CURL error such as HTTP 500, 502, 503, 504, SSL connection reset, or empty reply.
+     * Checks if a reader is a `clp::NetworkReader` or `clp::NetworkRangeReader` that has
+     * encountered a transient (retryable) CURL error such as HTTP 500, 502, 503, 504, SSL
+     * connection reset, or empty reply.
      * @param reader The open reader which may have experienced a CURL error.
      * @return Whether a retryable CURL error has occurred on the reader.
      */
@@ -1,6 +1,9 @@
 // Code from CLP
 #include "ZstdCompressor.hpp"
 
+#include <array>
+#include <utility>
+
 #include <spdlog/spdlog.h>
 
 namespace clp_s {
@@ -19,7 +22,11 @@ ZstdCompressor::~ZstdCompressor() {
     ZSTD_freeCStream(m_compression_stream);
 }
 
-void ZstdCompressor::open(FileWriter& file_writer, int const compression_level) {
+void ZstdCompressor::open(
+        FileWriter& file_writer,
+        int const compression_level,
+        ZSTD_CDict const* dictionary
+) {
     if (nullptr != m_compressed_stream_file_writer) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
@@ -31,20 +38,59 @@ void ZstdCompressor::open(FileWriter& file_writer, int const compression_level)
     m_compressed_stream_block.size = compressed_stream_block_size;
 
     // Setup compression stream
-    auto init_result = ZSTD_initCStream(m_compression_stream, compression_level);
-    if (ZSTD_isError(init_result)) {
-        SPDLOG_ERROR(
-                "ZstdCompressor: ZSTD_initCStream() error: {}",
-                ZSTD_getErrorName(init_result)
-        );
-        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    if (nullptr == dictionary) {
+        auto init_result = ZSTD_initCStream(m_compression_stream, compression_level);
+        if (ZSTD_isError(init_result)) {
+            SPDLOG_ERROR(
+                    "ZstdCompressor: ZSTD_initCStream() error: {}",
+                    ZSTD_getErrorName(init_result)
+            );
+            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+    } else {
+        // The digested dictionary carries its own compression parameters
+        auto init_result = ZSTD_CCtx_reset(m_compression_stream, ZSTD_reset_session_only);
+        if (false == ZSTD_isError(init_result)) {
+            init_result = ZSTD_CCtx_refCDict(m_compression_stream, dictionary);
+        }
+        if (ZSTD_isError(init_result)) {
+            SPDLOG_ERROR(
+                    "ZstdCompressor: ZSTD_CCtx_refCDict() error: {}",
+                    ZSTD_getErrorName(init_result)
+            );
+            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
     }
 
+    apply_worker_options();
+
     m_compressed_stream_file_writer = &file_writer;
 
     m_uncompressed_stream_pos = 0;
 }
 
+void ZstdCompressor::apply_worker_options() {
+    // Parameters persist across sessions, so they're always set to undo any previous options
+    std::array<std::pair<ZSTD_cParameter, int>, 3> const parameters{{
+            {ZSTD_c_nbWorkers, m_worker_options.num_workers},
+            {ZSTD_c_jobSize, static_cast<int>(m_worker_options.job_size)},
+            {ZSTD_c_enableLongDistanceMatching,
+             m_worker_options.enable_long_distance_matching ? 1 : 0},
+    }};
+    for (auto const& [parameter, value] : parameters) {
+        auto const result = ZSTD_CCtx_setParameter(m_compression_stream, parameter, value);
+        if (ZSTD_isError(result)) {
+            SPDLOG_ERROR(
+                    "ZstdCompressor: ZSTD_CCtx_setParameter({}, {}) error: {}",
+                    static_cast<int>(parameter),
+                    value,
+                    ZSTD_getErrorName(result)
+            );
+            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+    }
+}
+
 void ZstdCompressor::close() {
     if (nullptr == m_compressed_stream_file_writer) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
@@ -100,21 +146,25 @@ void ZstdCompressor::flush() {
         return;
     }
 
-    m_compressed_stream_block.pos = 0;
-    auto end_stream_result = ZSTD_endStream(m_compression_stream, &m_compressed_stream_block);
-    if (end_stream_result) {
-        // Note: Output buffer is large enough that it is guaranteed to have enough room to be able
-        // to Flush the entire buffer, so this can only be an error
-        SPDLOG_ERROR(
-                "ZstdCompressor: ZSTD_endStream() error: {}",
-                ZSTD_getErrorName(end_stream_result)
+    // With multiple workers, ending the stream may take several calls to drain all pending jobs
+    while (true) {
+        m_compressed_stream_block.pos = 0;
+        auto end_stream_result = ZSTD_endStream(m_compression_stream, &m_compressed_stream_block);
+        if (ZSTD_isError(end_stream_result)) {
+            SPDLOG_ERROR(
+                    "ZstdCompressor: ZSTD_endStream() error: {}",
+                    ZSTD_getErrorName(end_stream_result)
+            );
+            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+        m_compressed_stream_file_writer->write(
+                reinterpret_cast<char const*>(m_compressed_stream_block.dst),
+                m_compressed_stream_block.pos
         );
-        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        if (0 == end_stream_result) {
+            break;
+        }
     }
-    m_compressed_stream_file_writer->write(
-            reinterpret_cast<char const*>(m_compressed_stream_block.dst),
-            m_compressed_stream_block.pos
-    );
 
     m_compression_stream_contains_data = false;
 }
@@ -3,6 +3,7 @@
 #ifndef CLP_S_ZSTDCOMPRESSOR_HPP
 #define CLP_S_ZSTDCOMPRESSOR_HPP
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -16,6 +17,21 @@
 namespace clp_s {
 constexpr int cDefaultCompressionLevel = 3;
 
+/**
+ * Options for zstd's multi-threaded compression. Multi-threading only pays off for large streams
+ * (several MiB or more), since zstd splits a stream into jobs that are compressed in parallel.
+ */
+struct ZstdWorkerOptions {
+    // Number of worker threads. 0 compresses synchronously on the calling thread.
+    int num_workers{0};
+    // Size (B) of each job handed to a worker. 0 lets zstd pick a size based on the compression
+    // level.
+    size_t job_size{0};
+    // Whether to use long-distance matching, which helps with repetitions far apart in large
+    // streams at the cost of memory.
+    bool enable_long_distance_matching{false};
+};
+
 class ZstdCompressor : public Compressor {
 public:
     // Types
@@ -76,10 +92,33 @@ public:
      * Initialize streaming compressor
      * @param file_writer
      * @param compression_level
+     * @param dictionary A trained dictionary to compress with, or nullptr to compress without one.
+     * When set, the compression level the dictionary was digested with is used instead of
+     * `compression_level`.
+     */
+    void open(
+            FileWriter& file_writer,
+            int compression_level = cDefaultCompressionLevel,
+            ZSTD_CDict const* dictionary = nullptr
+    );
+
+    /**
+     * Sets the multi-threading options used by subsequent calls to `open`.
+     * @param worker_options
      */
-    void open(FileWriter& file_writer, int compression_level = cDefaultCompressionLevel);
+    void set_worker_options(ZstdWorkerOptions const& worker_options) {
+        m_worker_options = worker_options;
+    }
 
 private:
+    // Methods
+    /**
+     * Applies the multi-threading options to the compression stream.
+     * @throw OperationFailed if zstd rejects the options, e.g. because it was built without
+     * multi-threading support.
+     */
+    void apply_worker_options();
+
     // Variables
     FileWriter* m_compressed_stream_file_writer{};
 
@@ -91,6 +130,8 @@ private:
     std::unique_ptr<char[]> m_compressed_stream_block_buffer;
 
     size_t m_uncompressed_stream_pos{};
+
+    ZstdWorkerOptions m_worker_options;
 };
 }  // namespace clp_s
 
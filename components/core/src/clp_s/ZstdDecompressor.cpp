@@ -292,6 +292,17 @@ void ZstdDecompressor::reset_stream() {
     }
 
     ZSTD_initDStream(m_decompression_stream);
+    if (nullptr != m_dictionary) {
+        if (auto const result = ZSTD_DCtx_refDDict(m_decompression_stream, m_dictionary);
+            ZSTD_isError(result))
+        {
+            SPDLOG_ERROR(
+                    "ZstdDecompressor: ZSTD_DCtx_refDDict() error: {}",
+                    ZSTD_getErrorName(result)
+            );
+            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+    }
     m_decompressed_stream_pos = 0;
 
     m_compressed_stream_block.pos = 0;
@@ -64,6 +64,12 @@ public:
      */
     ErrorCode open(std::string const& compressed_file_path);
 
+    /**
+     * Sets the dictionary used to decompress streams opened after this call.
+     * @param dictionary A trained dictionary, or nullptr to decompress without one.
+     */
+    void set_dictionary(ZSTD_DDict const* dictionary) { m_dictionary = dictionary; }
+
     // Methods implementing the ReaderInterface
     /**
      * Tries to read up to a given number of bytes from the decompressor
@@ -128,6 +134,7 @@ private:
 
     // Compressed stream variables
     ZSTD_DStream* m_decompression_stream;
+    ZSTD_DDict const* m_dictionary{nullptr};
 
     std::optional<clp::ReadOnlyMemoryMappedFile> m_memory_mapped_file;
     FileReader* m_file_reader;
@@ -0,0 +1,218 @@
+#include "ZstdDictionaryRegistry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <zdict.h>
+#include <zstd.h>
+
+#include "ErrorCode.hpp"
+
+namespace clp_s {
+namespace {
+constexpr char cManifestSectionsKey[] = "sections";
+}  // namespace
+
+ZstdDictionaryRegistry::ZstdDictionaryRegistry(std::string registry_dir)
+        : m_registry_dir{std::move(registry_dir)} {
+    std::error_code ec;
+    auto const manifest_path{std::filesystem::path{m_registry_dir} / cManifestFileName};
+    if (false == std::filesystem::exists(manifest_path, ec)) {
+        return;
+    }
+    std::ifstream manifest_file{manifest_path};
+    try {
+        // Avoid brace initialization to avoid wrapping the parsed manifest in a JSON array
+        auto const manifest = nlohmann::json::parse(manifest_file);
+        for (auto const& item : manifest.at(cManifestSectionsKey).items()) {
+            m_section_to_dictionary_id.emplace(item.key(), item.value().get<uint32_t>());
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to parse zstd dictionary registry manifest - {}", e.what());
+        throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+    }
+}
+
+auto ZstdDictionaryRegistry::train_dictionary(
+        std::span<char const> samples,
+        std::span<size_t const> sample_sizes,
+        size_t max_dictionary_size
+) -> std::optional<std::vector<char>> {
+    std::vector<char> dictionary(max_dictionary_size);
+    auto const dictionary_size{ZDICT_trainFromBuffer(
+            dictionary.data(),
+            dictionary.size(),
+            samples.data(),
+            sample_sizes.data(),
+            static_cast<unsigned>(sample_sizes.size())
+    )};
+    if (ZDICT_isError(dictionary_size)) {
+        SPDLOG_WARN(
+                "Failed to train zstd dictionary - {}",
+                ZDICT_getErrorName(dictionary_size)
+        );
+        return std::nullopt;
+    }
+    dictionary.resize(dictionary_size);
+    return dictionary;
+}
+
+auto ZstdDictionaryRegistry::get_dictionary_id(std::string_view section) const
+        -> std::optional<uint32_t> {
+    std::lock_guard const lock{m_mutex};
+    auto const it{m_section_to_dictionary_id.find(section)};
+    if (m_section_to_dictionary_id.end() == it) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+auto ZstdDictionaryRegistry::get_compression_dictionary(
+        uint32_t dictionary_id,
+        int compression_level
+) -> ZSTD_CDict const* {
+    std::lock_guard const lock{m_mutex};
+    auto& dictionary{m_compression_dictionaries[{dictionary_id, compression_level}]};
+    if (nullptr == dictionary) {
+        auto const contents{read_dictionary(dictionary_id)};
+        dictionary.reset(ZSTD_createCDict(contents.data(), contents.size(), compression_level));
+        if (nullptr == dictionary) {
+            m_compression_dictionaries.erase({dictionary_id, compression_level});
+            SPDLOG_ERROR("ZSTD_createCDict() failed for zstd dictionary {}", dictionary_id);
+            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+    }
+    return dictionary.get();
+}
+
+auto ZstdDictionaryRegistry::get_decompression_dictionary(uint32_t dictionary_id)
+        -> ZSTD_DDict const* {
+    std::lock_guard const lock{m_mutex};
+    auto& dictionary{m_decompression_dictionaries[dictionary_id]};
+    if (nullptr == dictionary) {
+        auto const contents{read_dictionary(dictionary_id)};
+        dictionary.reset(ZSTD_createDDict(contents.data(), contents.size()));
+        if (nullptr == dictionary) {
+            m_decompression_dictionaries.erase(dictionary_id);
+            SPDLOG_ERROR("ZSTD_createDDict() failed for zstd dictionary {}", dictionary_id);
+            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+    }
+    return dictionary.get();
+}
+
+auto ZstdDictionaryRegistry::add_dictionary(
+        std::string_view section,
+        std::span<char const> dictionary
+) -> uint32_t {
+    auto const dictionary_id{ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size())};
+    if (0 == dictionary_id) {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+
+    std::lock_guard const lock{m_mutex};
+    // The directory is only created once a dictionary is added so that registries which are only
+    // read from (e.g., on read-only mounts) are never modified.
+    std::error_code ec;
+    std::filesystem::create_directories(m_registry_dir, ec);
+    if (ec) {
+        SPDLOG_ERROR(
+                "Failed to create zstd dictionary registry \"{}\" - ({}) {}",
+                m_registry_dir,
+                ec.value(),
+                ec.message()
+        );
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+
+    auto const dictionary_path{get_dictionary_path(dictionary_id)};
+    if (std::filesystem::exists(dictionary_path, ec)) {
+        // zstd picks dictionary IDs randomly, so a different dictionary with the same ID would
+        // make archives referencing the existing one undecodable.
+        if (read_dictionary(dictionary_id)
+            != std::vector<char>{dictionary.begin(), dictionary.end()})
+        {
+            SPDLOG_ERROR("A different zstd dictionary with ID {} already exists", dictionary_id);
+            throw OperationFailed(ErrorCodeFileExists, __FILENAME__, __LINE__);
+        }
+    } else {
+        std::ofstream dictionary_file{dictionary_path, std::ios::binary};
+        dictionary_file.write(dictionary.data(), static_cast<std::streamsize>(dictionary.size()));
+        if (false == dictionary_file.good()) {
+            SPDLOG_ERROR("Failed to write zstd dictionary \"{}\"", dictionary_path);
+            throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+        }
+    }
+
+    m_section_to_dictionary_id.insert_or_assign(std::string{section}, dictionary_id);
+    write_manifest();
+    return dictionary_id;
+}
+
+auto ZstdDictionaryRegistry::get_dictionary_path(uint32_t dictionary_id) const -> std::string {
+    return (std::filesystem::path{m_registry_dir}
+            / (std::to_string(dictionary_id) + cDictionaryFileExtension))
+            .string();
+}
+
+auto ZstdDictionaryRegistry::read_dictionary(uint32_t dictionary_id) const -> std::vector<char> {
+    auto const dictionary_path{get_dictionary_path(dictionary_id)};
+    std::ifstream dictionary_file{dictionary_path, std::ios::binary};
+    if (false == dictionary_file.is_open()) {
+        SPDLOG_ERROR("Failed to open zstd dictionary \"{}\"", dictionary_path);
+        throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+    }
+    std::vector<char> contents{
+            std::istreambuf_iterator<char>{dictionary_file},
+            std::istreambuf_iterator<char>{}
+    };
+    if (dictionary_file.bad()) {
+        SPDLOG_ERROR("Failed to read zstd dictionary \"{}\"", dictionary_path);
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+    return contents;
+}
+
+auto ZstdDictionaryRegistry::write_manifest() const -> void {
+    nlohmann::json manifest;
+    manifest[cManifestSectionsKey] = m_section_to_dictionary_id;
+
+    auto const manifest_path{std::filesystem::path{m_registry_dir} / cManifestFileName};
+    auto tmp_manifest_path{manifest_path};
+    tmp_manifest_path += constants::cTmpPostfix;
+    {
+        std::ofstream manifest_file{tmp_manifest_path};
+        manifest_file << manifest.dump(4) << '\n';
+        if (false == manifest_file.good()) {
+            SPDLOG_ERROR("Failed to write \"{}\"", tmp_manifest_path.string());
+            throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_manifest_path, manifest_path, ec);
+    if (ec) {
+        SPDLOG_ERROR(
+                "Failed to replace \"{}\" - ({}) {}",
+                manifest_path.string(),
+                ec.value(),
+                ec.message()
+        );
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+}
+}  // namespace clp_s
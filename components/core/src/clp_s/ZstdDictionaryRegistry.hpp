@@ -0,0 +1,183 @@
+#ifndef CLP_S_ZSTDDICTIONARYREGISTRY_HPP
+#define CLP_S_ZSTDDICTIONARYREGISTRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+#include "archive_constants.hpp"
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * The archive sections that can be compressed with a trained zstd dictionary, in the order they're
+ * laid out in a single-file archive. Each section is compressed with its own dictionary since the
+ * contents of different sections have little in common.
+ */
+constexpr std::array<std::string_view, 7> cZstdDictionarySections{
+        constants::cArchiveSchemaTreeFile,
+        constants::cArchiveSchemaMapFile,
+        constants::cArchiveTableMetadataFile,
+        constants::cArchiveVarDictFile,
+        constants::cArchiveLogDictFile,
+        constants::cArchiveArrayDictFile,
+        constants::cArchiveTablesFile
+};
+
+/**
+ * A directory of trained zstd dictionaries shared by many archives.
+ *
+ * Each dictionary is stored in `<dictionary ID>.zdict`, where the ID is the one zstd embeds in the
+ * dictionary. Archives record the IDs of the dictionaries their sections were compressed with, so
+ * dictionaries must never be removed from the registry while archives still reference them.
+ *
+ * The registry's manifest maps each archive section to the dictionary that new archives should be
+ * compressed with. Adding a dictionary for a section replaces the section's entry in the manifest
+ * but leaves older dictionaries in place so that existing archives remain readable.
+ *
+ * Digested dictionaries (`ZSTD_CDict`/`ZSTD_DDict`) are created on first use and cached, so that
+ * the many small streams in an archive don't each pay the cost of loading a dictionary.
+ */
+class ZstdDictionaryRegistry {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    static constexpr char cManifestFileName[] = "manifest.json";
+    static constexpr char cDictionaryFileExtension[] = ".zdict";
+    // The default maximum dictionary size used by the zstd CLI
+    static constexpr size_t cDefaultMaxDictionarySize{112'640};
+
+    // Constructors
+    /**
+     * Opens the registry in the given directory. The directory isn't created until a dictionary is
+     * added, so opening a registry to read from it never modifies the filesystem.
+     * @param registry_dir
+     * @throw OperationFailed if the manifest can't be parsed.
+     */
+    explicit ZstdDictionaryRegistry(std::string registry_dir);
+
+    // Delete copy constructor and assignment operator
+    ZstdDictionaryRegistry(ZstdDictionaryRegistry const&) = delete;
+    auto operator=(ZstdDictionaryRegistry const&) -> ZstdDictionaryRegistry& = delete;
+
+    // Delete move constructor and assignment operator
+    ZstdDictionaryRegistry(ZstdDictionaryRegistry&&) = delete;
+    auto operator=(ZstdDictionaryRegistry&&) -> ZstdDictionaryRegistry& = delete;
+
+    // Destructor
+    ~ZstdDictionaryRegistry() = default;
+
+    // Static methods
+    /**
+     * Trains a dictionary from the given samples.
+     * @param samples The samples, concatenated.
+     * @param sample_sizes The size of each sample in `samples`.
+     * @param max_dictionary_size
+     * @return The trained dictionary, or std::nullopt if zstd couldn't train a dictionary (e.g.,
+     * because there weren't enough samples).
+     */
+    [[nodiscard]] static auto train_dictionary(
+            std::span<char const> samples,
+            std::span<size_t const> sample_sizes,
+            size_t max_dictionary_size
+    ) -> std::optional<std::vector<char>>;
+
+    // Methods
+    [[nodiscard]] auto get_registry_dir() const -> std::string const& { return m_registry_dir; }
+
+    /**
+     * @param section
+     * @return The ID of the dictionary new archives should compress `section` with, or
+     * std::nullopt if there is no dictionary for the section.
+     */
+    [[nodiscard]] auto get_dictionary_id(std::string_view section) const -> std::optional<uint32_t>;
+
+    /**
+     * @param dictionary_id
+     * @param compression_level
+     * @return The digested dictionary for compressing at the given level.
+     * @throw OperationFailed if the dictionary doesn't exist or can't be loaded.
+     */
+    [[nodiscard]] auto get_compression_dictionary(uint32_t dictionary_id, int compression_level)
+            -> ZSTD_CDict const*;
+
+    /**
+     * @param dictionary_id
+     * @return The digested dictionary for decompression.
+     * @throw OperationFailed if the dictionary doesn't exist or can't be loaded.
+     */
+    [[nodiscard]] auto get_decompression_dictionary(uint32_t dictionary_id) -> ZSTD_DDict const*;
+
+    /**
+     * Adds a dictionary to the registry and makes it the dictionary new archives compress
+     * `section` with.
+     * @param section
+     * @param dictionary
+     * @return The dictionary's ID.
+     * @throw OperationFailed if `dictionary` isn't a zstd dictionary with an ID, or if the registry
+     * directory, dictionary, or manifest can't be written.
+     */
+    auto add_dictionary(std::string_view section, std::span<char const> dictionary) -> uint32_t;
+
+private:
+    // Types
+    struct CDictDeleter {
+        auto operator()(ZSTD_CDict* dictionary) const -> void { ZSTD_freeCDict(dictionary); }
+    };
+
+    struct DDictDeleter {
+        auto operator()(ZSTD_DDict* dictionary) const -> void { ZSTD_freeDDict(dictionary); }
+    };
+
+    // Methods
+    /**
+     * @param dictionary_id
+     * @return The path of the file containing the given dictionary.
+     */
+    [[nodiscard]] auto get_dictionary_path(uint32_t dictionary_id) const -> std::string;
+
+    /**
+     * Reads the given dictionary from disk.
+     * @param dictionary_id
+     * @return The dictionary's contents.
+     * @throw OperationFailed if the dictionary can't be read.
+     */
+    [[nodiscard]] auto read_dictionary(uint32_t dictionary_id) const -> std::vector<char>;
+
+    /**
+     * Writes the manifest to disk, replacing the previous manifest atomically.
+     * @throw OperationFailed if the manifest can't be written.
+     */
+    auto write_manifest() const -> void;
+
+    // Variables
+    std::string m_registry_dir;
+    mutable std::mutex m_mutex;
+    std::map<std::string, uint32_t, std::less<>> m_section_to_dictionary_id;
+    std::map<std::pair<uint32_t, int>, std::unique_ptr<ZSTD_CDict, CDictDeleter>>
+            m_compression_dictionaries;
+    std::map<uint32_t, std::unique_ptr<ZSTD_DDict, DDictDeleter>> m_decompression_dictionaries;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ZSTDDICTIONARYREGISTRY_HPP
@@ -0,0 +1,124 @@
+#include "ZstdDictionaryTrainer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+#include "../clp/ErrorCode.hpp"
+#include "archive_constants.hpp"
+#include "ArchiveReaderAdaptor.hpp"
+#include "ErrorCode.hpp"
+#include "InputConfig.hpp"
+#include "ZstdDecompressor.hpp"
+#include "ZstdDictionaryRegistry.hpp"
+
+namespace clp_s {
+namespace {
+/**
+ * @param section
+ * @return Whether the given section is a dictionary, which begins with an uncompressed header.
+ */
+auto is_dictionary_section(std::string_view section) -> bool;
+
+auto is_dictionary_section(std::string_view section) -> bool {
+    return constants::cArchiveVarDictFile == section || constants::cArchiveLogDictFile == section
+           || constants::cArchiveArrayDictFile == section;
+}
+}  // namespace
+
+auto ZstdDictionaryTrainer::add_samples_from_archive(
+        Path const& archive_path,
+        NetworkAuthOption const& network_auth
+) -> void {
+    constexpr size_t cDecompressorFileReadBufferCapacity{64 * 1024};  // 64 KiB
+
+    ArchiveReaderAdaptor adaptor{archive_path, network_auth};
+    // The sample archives may themselves have been compressed with dictionaries from the registry
+    adaptor.set_zstd_dictionary_registry(m_registry);
+    if (auto const rc{adaptor.load_archive_metadata()}; ErrorCodeSuccess != rc) {
+        throw OperationFailed(rc, __FILENAME__, __LINE__);
+    }
+
+    ZstdDecompressor decompressor;
+    // Sections must be checked out in the order they're laid out in single-file archives.
+    for (auto const section : cZstdDictionarySections) {
+        auto& samples{m_section_to_samples[section]};
+        if (is_full(samples)) {
+            continue;
+        }
+
+        auto reader{adaptor.checkout_reader_for_section(section)};
+        if (is_dictionary_section(section)) {
+            uint64_t num_entries{};
+            if (auto const rc{reader->try_read_numeric_value(num_entries)};
+                clp::ErrorCode_Success != rc)
+            {
+                throw OperationFailed(static_cast<ErrorCode>(rc), __FILENAME__, __LINE__);
+            }
+        }
+        decompressor.set_dictionary(adaptor.get_zstd_dictionary(section));
+        decompressor.open(*reader, cDecompressorFileReadBufferCapacity);
+
+        while (false == is_full(samples)) {
+            auto const sample_begin{samples.data.size()};
+            samples.data.resize(sample_begin + cSampleSize);
+            size_t num_bytes_read{};
+            auto const rc{decompressor.try_read(
+                    samples.data.data() + sample_begin,
+                    cSampleSize,
+                    num_bytes_read
+            )};
+            samples.data.resize(sample_begin + num_bytes_read);
+            if (ErrorCodeEndOfFile == rc) {
+                break;
+            }
+            if (ErrorCodeSuccess != rc) {
+                throw OperationFailed(rc, __FILENAME__, __LINE__);
+            }
+            samples.sizes.push_back(num_bytes_read);
+        }
+
+        decompressor.close();
+        adaptor.checkin_reader_for_section(section);
+    }
+}
+
+auto ZstdDictionaryTrainer::train() -> size_t {
+    size_t num_dictionaries{0};
+    for (auto const section : cZstdDictionarySections) {
+        auto const it{m_section_to_samples.find(section)};
+        if (m_section_to_samples.end() == it || it->second.sizes.empty()) {
+            SPDLOG_WARN("No samples for archive section \"{}\"", section);
+            continue;
+        }
+
+        auto const& samples{it->second};
+        auto const dictionary{ZstdDictionaryRegistry::train_dictionary(
+                samples.data,
+                samples.sizes,
+                m_max_dictionary_size
+        )};
+        if (false == dictionary.has_value()) {
+            SPDLOG_WARN(
+                    "Skipping archive section \"{}\" - couldn't train a dictionary from {} B of"
+                    " samples",
+                    section,
+                    samples.data.size()
+            );
+            continue;
+        }
+
+        auto const dictionary_id{m_registry->add_dictionary(section, dictionary.value())};
+        SPDLOG_INFO(
+                "Trained {} B zstd dictionary {} for archive section \"{}\"",
+                dictionary->size(),
+                dictionary_id,
+                section
+        );
+        ++num_dictionaries;
+    }
+    return num_dictionaries;
+}
+}  // namespace clp_s
@@ -0,0 +1,88 @@
+#ifndef CLP_S_ZSTDDICTIONARYTRAINER_HPP
+#define CLP_S_ZSTDDICTIONARYTRAINER_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "InputConfig.hpp"
+#include "TraceableException.hpp"
+#include "ZstdDictionaryRegistry.hpp"
+
+namespace clp_s {
+/**
+ * Trains a zstd dictionary for each archive section from the decompressed contents of a set of
+ * sample archives, and adds the dictionaries to a registry so that subsequent archives can be
+ * compressed with them.
+ *
+ * Each section's contents are split into fixed-size samples since zstd trains best on many small
+ * samples, and sampling stops once a section has ~100x the maximum dictionary size worth of
+ * samples, as recommended by zstd.
+ */
+class ZstdDictionaryTrainer {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    static constexpr size_t cSampleSize{4 * 1024};
+    static constexpr size_t cMaxSamplesSizeToDictionarySizeRatio{100};
+
+    // Constructors
+    ZstdDictionaryTrainer(
+            std::shared_ptr<ZstdDictionaryRegistry> registry,
+            size_t max_dictionary_size
+    )
+            : m_registry{std::move(registry)},
+              m_max_dictionary_size{max_dictionary_size} {}
+
+    // Methods
+    /**
+     * Adds the contents of the given archive's sections to the samples.
+     * @param archive_path
+     * @param network_auth
+     * @throw OperationFailed if the archive can't be read.
+     */
+    auto add_samples_from_archive(Path const& archive_path, NetworkAuthOption const& network_auth)
+            -> void;
+
+    /**
+     * Trains a dictionary for each section with samples and adds it to the registry. Sections for
+     * which zstd can't train a dictionary are skipped with a warning.
+     * @return The number of dictionaries added to the registry.
+     * @throw ZstdDictionaryRegistry::OperationFailed if a dictionary can't be added.
+     */
+    auto train() -> size_t;
+
+private:
+    // Types
+    struct Samples {
+        std::vector<char> data;
+        std::vector<size_t> sizes;
+    };
+
+    // Methods
+    /**
+     * @param samples
+     * @return Whether `samples` has enough data that no more samples should be added.
+     */
+    [[nodiscard]] auto is_full(Samples const& samples) const -> bool {
+        return samples.data.size() >= cMaxSamplesSizeToDictionarySizeRatio * m_max_dictionary_size;
+    }
+
+    // Variables
+    std::shared_ptr<ZstdDictionaryRegistry> m_registry;
+    size_t m_max_dictionary_size;
+    std::map<std::string_view, Samples> m_section_to_samples;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ZSTDDICTIONARYTRAINER_HPP
@@ -11,6 +11,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <clp/type_utils.hpp>
 #include <clp_s/archive_constants.hpp>
 #include <clp_s/int_float_compare.hpp>
 #include <clp_s/search/ast/SearchUtils.hpp>
@@ -202,4 +203,65 @@ auto UniqueAggregator::get_results() const -> std::vector<AggregationResult> {
     }
     return results;
 }
+
+DistinctCountAggregator::DistinctCountAggregator(string_view field)
+        : m_field{field},
+          m_field_path{tokenize_aggregation_field(field)} {}
+
+auto DistinctCountAggregator::add_record(string_view message, epochtime_t) -> void {
+    nlohmann::json doc;
+    auto const* const value{find_field_value(message, m_field_path, doc)};
+    if (nullptr == value) {
+        return;
+    }
+    auto const aggregation_value{to_aggregation_value(*value)};
+    if (false == aggregation_value.has_value()) {
+        return;
+    }
+    std::visit(
+            clp::overloaded{
+                    [&](int64_t held) { m_sketch.add_int64(held); },
+                    [&](double held) { m_sketch.add_double(held); },
+                    [&](string const& held) { m_sketch.add_string(held); },
+                    [&](bool held) { m_sketch.add_bool(held); }
+            },
+            aggregation_value.value()
+    );
+}
+
+auto DistinctCountAggregator::get_results() const -> std::vector<AggregationResult> {
+    auto const count{static_cast<int64_t>(m_sketch.estimate())};
+    if (0 == count) {
+        return {};
+    }
+    AggregationResult result;
+    result.emplace_back(constants::results_cache::search::cField, m_field);
+    result.emplace_back(constants::results_cache::search::cCount, count);
+    return {std::move(result)};
+}
+
+QuantilesAggregator::QuantilesAggregator(string_view field)
+        : m_field{field},
+          m_field_path{tokenize_aggregation_field(field)} {}
+
+auto QuantilesAggregator::add_record(string_view message, epochtime_t) -> void {
+    nlohmann::json doc;
+    auto const* const value{find_field_value(message, m_field_path, doc)};
+    if (nullptr == value || false == value->is_number()) {
+        return;
+    }
+    m_digest.add(value->get<double>());
+}
+
+auto QuantilesAggregator::get_results() const -> std::vector<AggregationResult> {
+    if (m_digest.empty()) {
+        return {};
+    }
+    AggregationResult result;
+    result.emplace_back(constants::results_cache::search::cField, m_field);
+    result.emplace_back(constants::results_cache::search::cP50, m_digest.quantile(0.5));
+    result.emplace_back(constants::results_cache::search::cP95, m_digest.quantile(0.95));
+    result.emplace_back(constants::results_cache::search::cP99, m_digest.quantile(0.99));
+    return {std::move(result)};
+}
 }  // namespace clp_s
@@ -15,6 +15,9 @@
 
 #include <clp_s/Defs.hpp>
 
+#include "../reducer/HyperLogLog.hpp"
+#include "../reducer/TDigest.hpp"
+
 namespace clp_s {
 /**
  * A single typed value in an aggregation's result document.
@@ -182,11 +185,78 @@ private:
     std::set<AggregationValue> m_values;
 };
 
+/**
+ * Estimates the number of distinct values of a target field across matched records using a
+ * HyperLogLog sketch, so that memory use stays bounded regardless of the field's cardinality.
+ */
+class DistinctCountAggregator {
+public:
+    // Static constants
+    static constexpr bool cNeedsMetadata{false};
+    static constexpr bool cNeedsMarshalledRecord{true};
+
+    // Constructors
+    explicit DistinctCountAggregator(std::string_view field);
+
+    // Methods
+    auto add_record(std::string_view message, [[maybe_unused]] epochtime_t timestamp_millisecs)
+            -> void;
+
+    [[nodiscard]] auto get_results() const -> std::vector<AggregationResult>;
+
+    /**
+     * @return The sketch of the values seen so far, e.g., to send to a reducer as a partial result.
+     */
+    [[nodiscard]] auto get_sketch() const -> reducer::HyperLogLog const& { return m_sketch; }
+
+private:
+    // Data members
+    std::string m_field;
+    std::vector<std::string> m_field_path;
+    reducer::HyperLogLog m_sketch;
+};
+
+/**
+ * Estimates the median, 95th, and 99th percentiles of a numeric target field across matched
+ * records using a t-digest, so that memory use stays bounded regardless of the number of records.
+ */
+class QuantilesAggregator {
+public:
+    // Static constants
+    static constexpr bool cNeedsMetadata{false};
+    static constexpr bool cNeedsMarshalledRecord{true};
+
+    // Constructors
+    explicit QuantilesAggregator(std::string_view field);
+
+    // Methods
+    auto add_record(std::string_view message, [[maybe_unused]] epochtime_t timestamp_millisecs)
+            -> void;
+
+    [[nodiscard]] auto get_results() const -> std::vector<AggregationResult>;
+
+    /**
+     * @return The digest of the values seen so far, e.g., to send to a reducer as a partial result.
+     */
+    [[nodiscard]] auto get_sketch() const -> reducer::TDigest const& { return m_digest; }
+
+private:
+    // Data members
+    std::string m_field;
+    std::vector<std::string> m_field_path;
+    reducer::TDigest m_digest;
+};
+
 /**
  * One of the supported aggregators that a search can apply to its matched records.
  */
-using Aggregator
-        = std::variant<CountAggregator, CountByTimeAggregator, MinMaxAggregator, UniqueAggregator>;
+using Aggregator = std::variant<
+        CountAggregator,
+        CountByTimeAggregator,
+        MinMaxAggregator,
+        UniqueAggregator,
+        DistinctCountAggregator,
+        QuantilesAggregator>;
 }  // namespace clp_s
 
 #endif  // CLP_S_AGGREGATORS_HPP
@@ -64,6 +64,9 @@ constexpr char cMin[]{"min"};
 constexpr char cMax[]{"max"};
 constexpr char cField[]{"field"};
 constexpr char cValue[]{"value"};
+constexpr char cP50[]{"p50"};
+constexpr char cP95[]{"p95"};
+constexpr char cP99[]{"p99"};
 }  // namespace results_cache::search
 }  // namespace clp_s::constants
 #endif  // CLP_S_ARCHIVE_CONSTANTS_HPP
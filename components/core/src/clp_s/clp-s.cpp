@@ -19,6 +19,7 @@
 #if CLP_BUILD_CLP_S_ENABLE_CURL
     #include "../clp/CurlGlobalInstance.hpp"
 #endif
+#include <utils/profiling/HotPathProfiler.hpp>
 #include <utils/profiling/Reporter.hpp>
 #include <utils/profiling/ScopedProfiler.hpp>
 #include <utils/profiling/Stopwatch.hpp>
@@ -30,6 +31,7 @@
 #include "../clp/ir/constants.hpp"
 #include "../clp/streaming_archive/ArchiveMetadata.hpp"
 #include "../reducer/network_utils.hpp"
+#include "ArchiveMerger.hpp"
 #include "CommandLineArguments.hpp"
 #include "Defs.hpp"
 #include "JsonConstructor.hpp"
@@ -50,6 +52,8 @@
 #include "search/Projection.hpp"
 #include "search/SchemaMatch.hpp"
 #include "SingleFileArchiveDefs.hpp"
+#include "ZstdDictionaryRegistry.hpp"
+#include "ZstdDictionaryTrainer.hpp"
 
 using namespace clp_s::search;
 using clp_s::cArchiveFormatDevelopmentVersionFlag;
@@ -67,6 +71,29 @@ namespace {
  */
 bool compress(CommandLineArguments const& command_line_arguments);
 
+/**
+ * Opens the zstd dictionary registry specified by the command line arguments, if any.
+ * @param command_line_arguments
+ * @return The registry, or nullptr if no registry was specified.
+ * @throw ZstdDictionaryRegistry::OperationFailed if the registry can't be opened.
+ */
+auto open_zstd_dictionary_registry(CommandLineArguments const& command_line_arguments)
+        -> std::shared_ptr<clp_s::ZstdDictionaryRegistry>;
+
+/**
+ * Trains zstd dictionaries from the archives specified by the command line arguments.
+ * @param command_line_arguments
+ * @return Whether any dictionaries were trained.
+ */
+auto train_dictionaries(CommandLineArguments const& command_line_arguments) -> bool;
+
+/**
+ * Merges the archives specified by the command line arguments into fewer, larger archives.
+ * @param command_line_arguments
+ * @return Whether merging was successful
+ */
+auto merge_archives(CommandLineArguments const& command_line_arguments) -> bool;
+
 /**
  * Decompresses the archive specified by the given JsonConstructorOption.
  * @param json_constructor_option
@@ -112,15 +139,19 @@ bool compress(CommandLineArguments const& command_line_arguments) {
     option.network_auth = command_line_arguments.get_network_auth();
     option.archives_dir = archives_dir.string();
     option.target_encoded_size = command_line_arguments.get_target_encoded_size();
+    option.archive_flush_interval_ms = command_line_arguments.get_archive_flush_interval_ms();
     option.max_document_size = command_line_arguments.get_max_document_size();
     option.min_table_size = command_line_arguments.get_minimum_table_size();
     option.compression_level = command_line_arguments.get_compression_level();
     option.timestamp_key = command_line_arguments.get_timestamp_key();
+    option.sort_key = command_line_arguments.get_sort_key();
     option.print_archive_stats = command_line_arguments.print_archive_stats();
     option.retain_float_format = command_line_arguments.get_retain_float_format();
     option.single_file_archive = command_line_arguments.get_single_file_archive();
     option.structurize_arrays = command_line_arguments.get_structurize_arrays();
     option.record_log_order = command_line_arguments.get_record_log_order();
+    option.zstd_dictionaries = open_zstd_dictionary_registry(command_line_arguments);
+    option.zstd_worker_options = command_line_arguments.get_zstd_worker_options();
 
     clp_s::JsonParser parser(option);
     if (false == parser.ingest()) {
@@ -131,6 +162,62 @@ bool compress(CommandLineArguments const& command_line_arguments) {
     return true;
 }
 
+auto open_zstd_dictionary_registry(CommandLineArguments const& command_line_arguments)
+        -> std::shared_ptr<clp_s::ZstdDictionaryRegistry> {
+    auto const& zstd_dictionaries_dir{command_line_arguments.get_zstd_dictionaries_dir()};
+    if (zstd_dictionaries_dir.empty()) {
+        return nullptr;
+    }
+    return std::make_shared<clp_s::ZstdDictionaryRegistry>(zstd_dictionaries_dir);
+}
+
+auto train_dictionaries(CommandLineArguments const& command_line_arguments) -> bool {
+    clp_s::ZstdDictionaryTrainer trainer{
+            open_zstd_dictionary_registry(command_line_arguments),
+            command_line_arguments.get_max_zstd_dictionary_size()
+    };
+    for (auto const& archive_path : command_line_arguments.get_input_paths()) {
+        trainer.add_samples_from_archive(archive_path, command_line_arguments.get_network_auth());
+    }
+    if (0 == trainer.train()) {
+        SPDLOG_ERROR("Failed to train any zstd dictionaries.");
+        return false;
+    }
+    return true;
+}
+
+auto merge_archives(CommandLineArguments const& command_line_arguments) -> bool {
+    auto const archives_dir = std::filesystem::path(command_line_arguments.get_archives_dir());
+
+    // Create output directory in case it doesn't exist
+    try {
+        std::filesystem::create_directory(archives_dir.string());
+    } catch (std::exception& e) {
+        SPDLOG_ERROR(
+                "Failed to create archives directory {} - {}",
+                archives_dir.string(),
+                e.what()
+        );
+        return false;
+    }
+
+    clp_s::ArchiveMergerOption option{};
+    option.archive_paths = command_line_arguments.get_input_paths();
+    option.network_auth = command_line_arguments.get_network_auth();
+    option.archives_dir = archives_dir.string();
+    option.target_encoded_size = command_line_arguments.get_target_encoded_size();
+    option.min_table_size = command_line_arguments.get_minimum_table_size();
+    option.compression_level = command_line_arguments.get_compression_level();
+    option.print_archive_stats = command_line_arguments.print_archive_stats();
+    option.single_file_archive = command_line_arguments.get_single_file_archive();
+    option.zstd_dictionaries = open_zstd_dictionary_registry(command_line_arguments);
+    option.zstd_worker_options = command_line_arguments.get_zstd_worker_options();
+
+    clp_s::ArchiveMerger merger{std::move(option)};
+    std::ignore = merger.merge();
+    return true;
+}
+
 void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_option) {
     clp_s::JsonConstructor constructor(json_constructor_option);
     constructor.store();
@@ -299,6 +386,10 @@ bool search_archive(
     try {
         std::visit(
                 clp::overloaded{
+                        [&](CommandLineArguments::ArrowOutputHandlerOptions const& options)
+                                -> void {
+                            output_handler = std::make_unique<clp_s::ArrowOutputHandler>(options);
+                        },
                         [&](CommandLineArguments::FileOutputHandlerOptions const& options) -> void {
                             output_handler = std::make_unique<clp_s::FileOutputHandler>(
                                     options.output_path,
@@ -327,10 +418,29 @@ bool search_archive(
                                                 std::get<clp_s::CountByTimeAggregator>(aggregator)
                                                         .get_bucket_size_millisecs()
                                         );
+                            } else if (std::holds_alternative<clp_s::DistinctCountAggregator>(
+                                               aggregator
+                                       ))
+                            {
+                                output_handler = std::make_unique<
+                                        clp_s::DistinctCountReducerOutputHandler>(
+                                        reducer_socket_fd,
+                                        std::get<clp_s::DistinctCountAggregator>(aggregator)
+                                );
+                            } else if (std::holds_alternative<clp_s::QuantilesAggregator>(
+                                               aggregator
+                                       ))
+                            {
+                                output_handler
+                                        = std::make_unique<clp_s::QuantilesReducerOutputHandler>(
+                                                reducer_socket_fd,
+                                                std::get<clp_s::QuantilesAggregator>(aggregator)
+                                        );
                             } else {
                                 throw std::invalid_argument(
-                                        "The reducer output handler only supports the count and "
-                                        "count-by-time aggregations."
+                                        "The reducer output handler only supports the count, "
+                                        "count-by-time, count-distinct, and quantiles "
+                                        "aggregations."
                                 );
                             }
                         },
@@ -453,6 +563,7 @@ int main(int argc, char const* argv[]) {
         clp_s::JsonConstructorOption option{};
         option.output_dir = command_line_arguments.get_output_dir();
         option.ordered = command_line_arguments.get_ordered_decompression();
+        option.arrow = command_line_arguments.get_arrow_decompression();
         option.target_ordered_chunk_size = command_line_arguments.get_target_ordered_chunk_size();
         option.print_ordered_chunk_stats = command_line_arguments.print_ordered_chunk_stats();
         option.network_auth = command_line_arguments.get_network_auth();
@@ -463,6 +574,7 @@ int main(int argc, char const* argv[]) {
         }
 
         try {
+            option.zstd_dictionaries = open_zstd_dictionary_registry(command_line_arguments);
             for (auto const& archive_path : command_line_arguments.get_input_paths()) {
                 option.archive_path = archive_path;
                 decompress_archive(option);
@@ -471,6 +583,26 @@ int main(int argc, char const* argv[]) {
             SPDLOG_ERROR("Encountered error during decompression - {}", e.what());
             return 1;
         }
+    } else if (CommandLineArguments::Command::TrainDictionaries
+               == command_line_arguments.get_command())
+    {
+        try {
+            if (false == train_dictionaries(command_line_arguments)) {
+                return 1;
+            }
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Encountered error while training dictionaries - {}", e.what());
+            return 1;
+        }
+    } else if (CommandLineArguments::Command::Merge == command_line_arguments.get_command()) {
+        try {
+            if (false == merge_archives(command_line_arguments)) {
+                return 1;
+            }
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Encountered error while merging archives - {}", e.what());
+            return 1;
+        }
     } else {
         auto const& query = command_line_arguments.get_query();
         auto query_stream = std::istringstream(query);
@@ -501,6 +633,14 @@ int main(int argc, char const* argv[]) {
         }
 
         auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
+        try {
+            archive_reader->set_zstd_dictionary_registry(
+                    open_zstd_dictionary_registry(command_line_arguments)
+            );
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to open zstd dictionary registry - {}", e.what());
+            return 1;
+        }
         for (auto const& input_path : command_line_arguments.get_input_paths()) {
             if (std::string::npos != input_path.path.find(clp::ir::cIrFileExtension)) {
                 auto const result{clp_s::search_kv_ir_stream(
@@ -587,6 +727,7 @@ int main(int argc, char const* argv[]) {
             {
                 return 1;
             }
+            utils::profiling::HotPathProfiler::for_each_measurement(emit_measurement);
             archive_reader->close();
         }
     }
@@ -1,5 +1,6 @@
 #include "ClpArchiveReader.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <memory>
@@ -15,21 +16,27 @@
 #include <clp/BufferReader.hpp>
 #include <clp_s/archive_constants.hpp>
 #include <clp_s/ArchiveReader.hpp>
+#include <clp_s/ffi/sfa/EventDecoder.hpp>
 #include <clp_s/ffi/sfa/SfaErrorCode.hpp>
 #include <clp_s/InputConfig.hpp>
+#include <clp_s/ZstdDictionaryRegistry.hpp>
 
 namespace clp_s::ffi::sfa {
 template <typename ReturnType>
 using Result = ystdlib::error_handling::Result<ReturnType>;
 
-auto ClpArchiveReader::create(std::string_view archive_path) -> Result<ClpArchiveReader> {
-    std::unique_ptr<clp_s::ArchiveReader> reader;
-
+auto ClpArchiveReader::create(
+        std::string_view archive_path,
+        std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries
+) -> Result<ClpArchiveReader> {
     try {
-        auto path{get_path_object_for_raw_path(archive_path)};
-        reader = std::make_unique<clp_s::ArchiveReader>();
-        reader->open(path, NetworkAuthOption{});
-        auto clp_archive_reader{ClpArchiveReader{std::move(reader), nullptr}};
+        auto archive_reader{open_archive(archive_path, nullptr, zstd_dictionaries)};
+        auto clp_archive_reader{ClpArchiveReader{
+                std::move(archive_reader),
+                archive_path,
+                nullptr,
+                std::move(zstd_dictionaries)
+        }};
         YSTDLIB_ERROR_HANDLING_TRYV(clp_archive_reader.precompute_archive_metadata());
         return clp_archive_reader;
     } catch (std::bad_alloc const&) {
@@ -44,26 +51,19 @@ auto ClpArchiveReader::create(std::string_view archive_path) -> Result<ClpArchiv
     }
 }
 
-auto ClpArchiveReader::create(std::vector<char>&& archive_data) -> Result<ClpArchiveReader> {
-    // `clp_s::ArchiveReader` requires an archive ID, but `clp_s::ffi::sfa::ClpArchiveReader` never
-    // uses it. Provide a dummy value solely to satisfy the constructor.
-    constexpr std::string_view cDefaultArchiveId{"default"};
-
-    std::unique_ptr<clp_s::ArchiveReader> archive_reader;
-    std::shared_ptr<std::vector<char>> archive_data_owner;
-
+auto ClpArchiveReader::create(
+        std::vector<char>&& archive_data,
+        std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries
+) -> Result<ClpArchiveReader> {
     try {
-        archive_data_owner = std::make_shared<std::vector<char>>(std::move(archive_data));
-        auto reader{std::make_shared<clp::BufferReader>(
-                archive_data_owner->data(),
-                archive_data_owner->size()
-        )};
-
-        archive_reader = std::make_unique<clp_s::ArchiveReader>();
-        archive_reader->open(reader, cDefaultArchiveId);
-        auto clp_archive_reader{
-                ClpArchiveReader{std::move(archive_reader), std::move(archive_data_owner)}
-        };
+        auto archive_data_owner{std::make_shared<std::vector<char>>(std::move(archive_data))};
+        auto archive_reader{open_archive({}, archive_data_owner, zstd_dictionaries)};
+        auto clp_archive_reader{ClpArchiveReader{
+                std::move(archive_reader),
+                {},
+                std::move(archive_data_owner),
+                std::move(zstd_dictionaries)
+        }};
         YSTDLIB_ERROR_HANDLING_TRYV(clp_archive_reader.precompute_archive_metadata());
         return clp_archive_reader;
     } catch (std::bad_alloc const&) {
@@ -77,10 +77,14 @@ auto ClpArchiveReader::create(std::vector<char>&& archive_data) -> Result<ClpArc
 
 ClpArchiveReader::ClpArchiveReader(
         std::unique_ptr<clp_s::ArchiveReader> reader,
-        std::shared_ptr<std::vector<char>> archive_data
+        std::string_view archive_path,
+        std::shared_ptr<std::vector<char>> archive_data,
+        std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries
 )
         : m_archive_reader{std::move(reader)},
-          m_archive_data{std::move(archive_data)} {}
+          m_archive_path{archive_path},
+          m_archive_data{std::move(archive_data)},
+          m_zstd_dictionaries{std::move(zstd_dictionaries)} {}
 
 ClpArchiveReader::ClpArchiveReader(ClpArchiveReader&& rhs) noexcept {
     move_from(rhs);
@@ -100,7 +104,74 @@ ClpArchiveReader::~ClpArchiveReader() noexcept {
     close();
 }
 
+auto ClpArchiveReader::start_decoding(DecodeOptions const& options) -> Result<void> {
+    if (nullptr == m_archive_reader) {
+        return SfaErrorCode{SfaErrorCodeEnum::NotInit};
+    }
+
+    m_event_decoder.reset();
+    try {
+        // Tables can only be read once, in the order they're stored, so each decoding pass reads
+        // the archive through its own reader.
+        auto archive_reader{open_archive(m_archive_path, m_archive_data, m_zstd_dictionaries)};
+        m_event_decoder = YSTDLIB_ERROR_HANDLING_TRYX(
+                EventDecoder::create(std::move(archive_reader), options)
+        );
+        return ystdlib::error_handling::success();
+    } catch (std::bad_alloc const&) {
+        SPDLOG_ERROR("Failed to start decoding events: out of memory.");
+        return SfaErrorCode{SfaErrorCodeEnum::NoMemory};
+    } catch (std::exception const& ex) {
+        SPDLOG_ERROR("Exception while starting to decode events: {}", ex.what());
+        return SfaErrorCode{SfaErrorCodeEnum::IoFailure};
+    }
+}
+
+auto ClpArchiveReader::decode_next_batch(size_t max_num_events, EventBatch& batch)
+        -> Result<size_t> {
+    if (nullptr == m_event_decoder) {
+        return SfaErrorCode{SfaErrorCodeEnum::NotInit};
+    }
+
+    try {
+        return m_event_decoder->decode_next_batch(max_num_events, batch);
+    } catch (std::bad_alloc const&) {
+        SPDLOG_ERROR("Failed to decode events: out of memory.");
+        m_event_decoder.reset();
+        return SfaErrorCode{SfaErrorCodeEnum::NoMemory};
+    } catch (std::exception const& ex) {
+        SPDLOG_ERROR("Exception while decoding events: {}", ex.what());
+        m_event_decoder.reset();
+        return SfaErrorCode{SfaErrorCodeEnum::IoFailure};
+    }
+}
+
+auto ClpArchiveReader::open_archive(
+        std::string_view archive_path,
+        std::shared_ptr<std::vector<char>> const& archive_data,
+        std::shared_ptr<ZstdDictionaryRegistry> const& zstd_dictionaries
+) -> std::unique_ptr<clp_s::ArchiveReader> {
+    // `clp_s::ArchiveReader` requires an archive ID, but `clp_s::ffi::sfa::ClpArchiveReader` never
+    // uses it. Provide a dummy value solely to satisfy the constructor.
+    constexpr std::string_view cDefaultArchiveId{"default"};
+
+    auto archive_reader{std::make_unique<clp_s::ArchiveReader>()};
+    archive_reader->set_zstd_dictionary_registry(zstd_dictionaries);
+    if (nullptr == archive_data) {
+        archive_reader->open(get_path_object_for_raw_path(archive_path), NetworkAuthOption{});
+    } else {
+        archive_reader->open(
+                std::make_shared<clp::BufferReader>(archive_data->data(), archive_data->size()),
+                cDefaultArchiveId
+        );
+    }
+    return archive_reader;
+}
+
 auto ClpArchiveReader::close() noexcept -> void {
+    // Release the decoder first since it may still be reading the archive's data.
+    m_event_decoder.reset();
+
     // FFI frontends may invoke destruction paths multiple times (e.g., explicit close followed by
     // GC finalization). Guard against this by checking for a null reader before attempting to
     // close.
@@ -119,10 +190,13 @@ auto ClpArchiveReader::close() noexcept -> void {
 
 auto ClpArchiveReader::move_from(ClpArchiveReader& rhs) noexcept -> void {
     m_archive_reader = std::move(rhs.m_archive_reader);
+    m_archive_path = std::move(rhs.m_archive_path);
     m_archive_data = std::move(rhs.m_archive_data);
+    m_zstd_dictionaries = std::move(rhs.m_zstd_dictionaries);
     m_event_count = std::exchange(rhs.m_event_count, 0);
     m_file_names = std::move(rhs.m_file_names);
     m_file_infos = std::move(rhs.m_file_infos);
+    m_event_decoder = std::move(rhs.m_event_decoder);
 }
 
 auto ClpArchiveReader::precompute_archive_metadata() -> Result<void> {
@@ -1,6 +1,7 @@
 #ifndef CLP_S_FFI_SFA_CLPARCHIVEREADER_HPP
 #define CLP_S_FFI_SFA_CLPARCHIVEREADER_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -12,9 +13,13 @@
 namespace clp_s {
 // Forward include
 class ArchiveReader;
+class ZstdDictionaryRegistry;
 }  // namespace clp_s
 
 namespace clp_s::ffi::sfa {
+// Forward declaration
+class EventDecoder;
+
 /**
  * Metadata describing a single source file's event-index range within a single-file archive.
  */
@@ -44,6 +49,113 @@ private:
     int64_t m_end_index{0};
 };
 
+/**
+ * Options controlling which events `ClpArchiveReader` decodes and in what order.
+ */
+struct DecodeOptions {
+    // KQL query that decoded events must match. An empty query matches every event.
+    std::string query;
+    // Columns to include in decoded events. If empty, every column is included.
+    std::vector<std::string> projection;
+    bool ignore_case{false};
+    // Whether to decode events in log order rather than one schema table at a time. Archives
+    // without log order information are always decoded one schema table at a time.
+    bool ordered{true};
+};
+
+/**
+ * A batch of decoded events, each marshalled as a JSON object.
+ *
+ * The events are stored back to back in a single buffer, each terminated by a newline, so that
+ * bindings can hand the whole batch (or individual events) to their runtime without copying each
+ * event into a separate object. The batch's buffers are reused by every call it's passed to, so
+ * decoding an archive through one batch only allocates until the buffers reach their largest size.
+ */
+class EventBatch {
+public:
+    // Methods
+    [[nodiscard]] auto get_num_events() const -> size_t { return m_log_event_indices.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_log_event_indices.empty(); }
+
+    /**
+     * @param idx
+     * @return The JSON object for the event at index `idx` in the batch, without its newline.
+     */
+    [[nodiscard]] auto get_event(size_t idx) const -> std::string_view {
+        auto const begin{0 == idx ? 0 : m_end_offsets[idx - 1]};
+        return std::string_view{m_buffer}.substr(begin, m_end_offsets[idx] - begin - 1);
+    }
+
+    /**
+     * @param idx
+     * @return The log event index of the event at index `idx` in the batch.
+     */
+    [[nodiscard]] auto get_log_event_idx(size_t idx) const -> int64_t {
+        return m_log_event_indices[idx];
+    }
+
+    /**
+     * @param idx
+     * @return The timestamp (milliseconds since the UNIX epoch) of the event at index `idx` in the
+     * batch, or 0 if the event has no timestamp.
+     */
+    [[nodiscard]] auto get_timestamp(size_t idx) const -> int64_t { return m_timestamps[idx]; }
+
+    /**
+     * @return Every event in the batch, each terminated by a newline.
+     */
+    [[nodiscard]] auto get_buffer() const -> std::string const& { return m_buffer; }
+
+    /**
+     * @return The offset in the buffer just past each event's newline.
+     */
+    [[nodiscard]] auto get_end_offsets() const -> std::vector<size_t> const& {
+        return m_end_offsets;
+    }
+
+    [[nodiscard]] auto get_log_event_indices() const -> std::vector<int64_t> const& {
+        return m_log_event_indices;
+    }
+
+    [[nodiscard]] auto get_timestamps() const -> std::vector<int64_t> const& {
+        return m_timestamps;
+    }
+
+    /**
+     * Clears the batch while keeping the capacity of its buffers.
+     */
+    auto clear() -> void {
+        m_buffer.clear();
+        m_end_offsets.clear();
+        m_log_event_indices.clear();
+        m_timestamps.clear();
+    }
+
+private:
+    friend class EventDecoder;
+
+    // Methods
+    /**
+     * Appends an event to the batch.
+     * @param event The event's JSON object, terminated by a newline.
+     * @param log_event_idx
+     * @param timestamp
+     */
+    auto append(std::string_view event, int64_t log_event_idx, int64_t timestamp) -> void {
+        m_buffer.append(event);
+        m_end_offsets.push_back(m_buffer.size());
+        m_log_event_indices.push_back(log_event_idx);
+        m_timestamps.push_back(timestamp);
+    }
+
+    // Members
+    std::string m_buffer;
+    std::vector<size_t> m_end_offsets;
+    std::vector<int64_t> m_log_event_indices;
+    std::vector<int64_t> m_timestamps;
+};
+
 /**
  * A thin wrapper around `clp_s::ArchiveReader` for single file archive FFI entrypoints.
  */
@@ -54,27 +166,35 @@ public:
      * Creates an SFA reader from a filesystem archive path.
      *
      * @param archive_path Path to the single-file archive.
+     * @param zstd_dictionaries The registry of trained zstd dictionaries the archive was compressed
+     * with, if any.
      * @return A result containing the newly constructed `ClpArchiveReader` on success, or an
      * error code indicating the failure:
      * - `SfaErrorCodeEnum::IoFailure` if archive open/initialization fails.
      * - `SfaErrorCodeEnum::NoMemory` if archive initialization fails due to OOM issues.
      * - Forwards `ClpArchiveReader::precompute_archive_metadata`'s return values on failure.
      */
-    [[nodiscard]] static auto create(std::string_view archive_path)
-            -> ystdlib::error_handling::Result<ClpArchiveReader>;
+    [[nodiscard]] static auto create(
+            std::string_view archive_path,
+            std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries = nullptr
+    ) -> ystdlib::error_handling::Result<ClpArchiveReader>;
 
     /**
      * Creates an SFA reader from in memory archive bytes, taking ownership of the buffer.
      *
      * @param archive_data Bytes of a single-file archive.
+     * @param zstd_dictionaries The registry of trained zstd dictionaries the archive was compressed
+     * with, if any.
      * @return A result containing the newly constructed `ClpArchiveReader` on success, or an
      * error code indicating the failure:
      * - `SfaErrorCodeEnum::IoFailure` if archive open/initialization fails.
      * - `SfaErrorCodeEnum::NoMemory` if allocating/copying archive bytes fails.
      * - Forwards `ClpArchiveReader::precompute_archive_metadata`'s return values on failure.
      */
-    [[nodiscard]] static auto create(std::vector<char>&& archive_data)
-            -> ystdlib::error_handling::Result<ClpArchiveReader>;
+    [[nodiscard]] static auto create(
+            std::vector<char>&& archive_data,
+            std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries = nullptr
+    ) -> ystdlib::error_handling::Result<ClpArchiveReader>;
 
     // Destructor
     ~ClpArchiveReader() noexcept;
@@ -101,13 +221,61 @@ public:
      */
     [[nodiscard]] auto get_file_infos() const -> std::vector<FileInfo> { return m_file_infos; }
 
+    /**
+     * Starts decoding the archive's events, discarding any decoding already in progress. The events
+     * are then retrieved with `decode_next_batch`.
+     *
+     * @param options
+     * @return A void result on success, or an error code indicating the failure:
+     * - `SfaErrorCodeEnum::NotInit` if the reader has been closed.
+     * - `SfaErrorCodeEnum::InvalidQuery` if the query can't be parsed or a projected column is
+     *   invalid.
+     * - `SfaErrorCodeEnum::IoFailure` if reading the archive fails.
+     * - `SfaErrorCodeEnum::NoMemory` if reading the archive fails due to OOM issues.
+     */
+    [[nodiscard]] auto start_decoding(DecodeOptions const& options)
+            -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Decodes the next events into `batch`, replacing its contents.
+     *
+     * @param max_num_events The maximum number of events to decode.
+     * @param batch
+     * @return A result containing the number of events decoded, which is 0 once every event has
+     * been decoded, or an error code indicating the failure:
+     * - `SfaErrorCodeEnum::NotInit` if `start_decoding` hasn't succeeded since the reader was
+     *   created.
+     * - `SfaErrorCodeEnum::IoFailure` if reading the archive fails.
+     * - `SfaErrorCodeEnum::NoMemory` if reading the archive fails due to OOM issues.
+     */
+    [[nodiscard]] auto decode_next_batch(size_t max_num_events, EventBatch& batch)
+            -> ystdlib::error_handling::Result<size_t>;
+
 private:
     // Constructors
     explicit ClpArchiveReader(
             std::unique_ptr<clp_s::ArchiveReader> reader,
-            std::shared_ptr<std::vector<char>> archive_data
+            std::string_view archive_path,
+            std::shared_ptr<std::vector<char>> archive_data,
+            std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries
     );
 
+    // Static methods
+    /**
+     * Opens an archive either from a filesystem path or from in memory archive bytes.
+     *
+     * @param archive_path Path to the single-file archive, used if `archive_data` is null.
+     * @param archive_data Bytes of a single-file archive.
+     * @param zstd_dictionaries
+     * @return The opened archive reader.
+     * @throw clp_s::ArchiveReader::OperationFailed if the archive can't be opened.
+     */
+    [[nodiscard]] static auto open_archive(
+            std::string_view archive_path,
+            std::shared_ptr<std::vector<char>> const& archive_data,
+            std::shared_ptr<ZstdDictionaryRegistry> const& zstd_dictionaries
+    ) -> std::unique_ptr<clp_s::ArchiveReader>;
+
     // Methods
     /**
      * Cleans up underlying resources.
@@ -133,10 +301,13 @@ private:
 
     // Members
     std::unique_ptr<clp_s::ArchiveReader> m_archive_reader;
+    std::string m_archive_path;
     std::shared_ptr<std::vector<char>> m_archive_data;
+    std::shared_ptr<ZstdDictionaryRegistry> m_zstd_dictionaries;
     uint64_t m_event_count{0};
     std::vector<std::string> m_file_names;
     std::vector<FileInfo> m_file_infos;
+    std::unique_ptr<EventDecoder> m_event_decoder;
 };
 }  // namespace clp_s::ffi::sfa
 
@@ -0,0 +1,317 @@
+#include "EventDecoder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <ystdlib/error_handling/Result.hpp>
+
+#include <clp_s/ArchiveReader.hpp>
+#include <clp_s/ffi/sfa/ClpArchiveReader.hpp>
+#include <clp_s/ffi/sfa/SfaErrorCode.hpp>
+#include <clp_s/SchemaReader.hpp>
+#include <clp_s/search/ast/ColumnDescriptor.hpp>
+#include <clp_s/search/ast/EmptyExpr.hpp>
+#include <clp_s/search/ast/Expression.hpp>
+#include <clp_s/search/ast/SearchUtils.hpp>
+#include <clp_s/search/ast/SetTimestampLiteralPrecision.hpp>
+#include <clp_s/search/ast/TimestampLiteral.hpp>
+#include <clp_s/search/EvaluateRangeIndexFilters.hpp>
+#include <clp_s/search/EvaluateTimestampIndex.hpp>
+#include <clp_s/search/kql/kql.hpp>
+#include <clp_s/search/Projection.hpp>
+#include <clp_s/search/QueryRunner.hpp>
+#include <clp_s/search/SchemaMatch.hpp>
+#include <clp_s/Utils.hpp>
+
+namespace clp_s::ffi::sfa {
+template <typename ReturnType>
+using Result = ystdlib::error_handling::Result<ReturnType>;
+
+namespace {
+/**
+ * Narrows a query against an archive's metadata and schemas, following the same passes as a clp-s
+ * search.
+ * @param archive_reader
+ * @param query
+ * @param ignore_case
+ * @param match Returns the schema match for the query.
+ * @return A result containing the narrowed query, which is `nullptr` if no event can match, or
+ * `SfaErrorCodeEnum::InvalidQuery` if the query can't be parsed.
+ */
+auto narrow_query(
+        ArchiveReader& archive_reader,
+        std::string const& query,
+        bool ignore_case,
+        std::shared_ptr<search::SchemaMatch>& match
+) -> Result<std::shared_ptr<search::ast::Expression>>;
+
+/**
+ * Sets the columns to include in decoded events.
+ * @param archive_reader
+ * @param columns
+ * @return A void result on success, or `SfaErrorCodeEnum::InvalidQuery` if a column is invalid.
+ */
+auto set_projection(ArchiveReader& archive_reader, std::vector<std::string> const& columns)
+        -> Result<void>;
+
+auto narrow_query(
+        ArchiveReader& archive_reader,
+        std::string const& query,
+        bool ignore_case,
+        std::shared_ptr<search::SchemaMatch>& match
+) -> Result<std::shared_ptr<search::ast::Expression>> {
+    auto query_stream{std::istringstream{query}};
+    auto expr{search::kql::parse_kql_expression(query_stream)};
+    if (nullptr == expr) {
+        return SfaErrorCode{SfaErrorCodeEnum::InvalidQuery};
+    }
+
+    auto const is_empty = [](std::shared_ptr<search::ast::Expression> const& expression) -> bool {
+        return nullptr != std::dynamic_pointer_cast<search::ast::EmptyExpr>(expression);
+    };
+    if (is_empty(expr)) {
+        return nullptr;
+    }
+    if (expr = search::ast::preprocess_query(expr); is_empty(expr)) {
+        return nullptr;
+    }
+
+    search::EvaluateRangeIndexFilters metadata_filter_pass{
+            archive_reader.get_range_index(),
+            false == ignore_case
+    };
+    if (expr = metadata_filter_pass.run(expr); is_empty(expr)) {
+        return nullptr;
+    }
+
+    search::EvaluateTimestampIndex timestamp_index{archive_reader.get_timestamp_dictionary()};
+    if (EvaluatedValue::False == timestamp_index.run(expr)) {
+        return nullptr;
+    }
+
+    if (archive_reader.has_deprecated_timestamp_format()) {
+        search::ast::SetTimestampLiteralPrecision date_precision_pass{
+                search::ast::TimestampLiteral::Precision::Milliseconds
+        };
+        expr = date_precision_pass.run(expr);
+    }
+
+    match = std::make_shared<search::SchemaMatch>(
+            archive_reader.get_schema_tree(),
+            archive_reader.get_schema_map()
+    );
+    if (expr = match->run(expr); is_empty(expr)) {
+        return nullptr;
+    }
+
+    // Some ambiguous columns may now match the timestamp column after column resolution.
+    if (EvaluatedValue::False == timestamp_index.run(expr)) {
+        return nullptr;
+    }
+    return expr;
+}
+
+auto set_projection(ArchiveReader& archive_reader, std::vector<std::string> const& columns)
+        -> Result<void> {
+    if (columns.empty()) {
+        return ystdlib::error_handling::success();
+    }
+
+    auto projection{
+            std::make_shared<search::Projection>(search::ProjectionMode::ReturnSelectedColumns)
+    };
+    try {
+        for (auto const& column : columns) {
+            std::vector<std::string> descriptor_tokens;
+            std::string descriptor_namespace;
+            if (false
+                == search::ast::tokenize_column_descriptor(
+                        column,
+                        descriptor_tokens,
+                        descriptor_namespace
+                ))
+            {
+                SPDLOG_ERROR("Can not tokenize invalid column: \"{}\"", column);
+                return SfaErrorCode{SfaErrorCodeEnum::InvalidQuery};
+            }
+            projection->add_column(
+                    search::ast::ColumnDescriptor::create_from_escaped_tokens(
+                            descriptor_tokens,
+                            descriptor_namespace
+                    )
+            );
+        }
+    } catch (std::exception const& ex) {
+        SPDLOG_ERROR("Invalid projection: {}", ex.what());
+        return SfaErrorCode{SfaErrorCodeEnum::InvalidQuery};
+    }
+    projection->resolve_columns(archive_reader.get_schema_tree());
+    archive_reader.set_projection(projection);
+    return ystdlib::error_handling::success();
+}
+}  // namespace
+
+auto EventDecoder::create(
+        std::shared_ptr<ArchiveReader> archive_reader,
+        DecodeOptions const& options
+) -> Result<std::unique_ptr<EventDecoder>> {
+    archive_reader->read_dictionaries_and_metadata();
+
+    std::shared_ptr<search::SchemaMatch> match;
+    std::shared_ptr<search::ast::Expression> expr;
+    bool has_matching_schemas{true};
+    if (false == options.query.empty()) {
+        expr = YSTDLIB_ERROR_HANDLING_TRYX(
+                narrow_query(*archive_reader, options.query, options.ignore_case, match)
+        );
+        has_matching_schemas = nullptr != expr;
+    }
+    YSTDLIB_ERROR_HANDLING_TRYV(set_projection(*archive_reader, options.projection));
+
+    std::vector<int32_t> schema_ids;
+    if (has_matching_schemas) {
+        for (auto const schema_id : archive_reader->get_schema_ids()) {
+            if (nullptr == match || match->schema_matched(schema_id)) {
+                schema_ids.push_back(schema_id);
+            }
+        }
+    }
+
+    bool ordered{options.ordered};
+    if (ordered && false == archive_reader->has_log_order()) {
+        SPDLOG_WARN(
+                "This archive is missing ordering information and can not be decoded in log"
+                " order. Falling back to decoding one schema table at a time."
+        );
+        ordered = false;
+    }
+
+    archive_reader->open_packed_streams();
+    std::unique_ptr<EventDecoder> decoder{new EventDecoder{
+            std::move(archive_reader),
+            std::move(match),
+            std::move(expr),
+            options.ignore_case,
+            ordered,
+            std::move(schema_ids)
+    }};
+    if (ordered) {
+        // Tables can only be read in the order they're stored, so every table has to be read
+        // before any events can be merged.
+        while (decoder->load_next_table()) {}
+    }
+    return decoder;
+}
+
+EventDecoder::EventDecoder(
+        std::shared_ptr<ArchiveReader> archive_reader,
+        std::shared_ptr<search::SchemaMatch> match,
+        std::shared_ptr<search::ast::Expression> expr,
+        bool ignore_case,
+        bool ordered,
+        std::vector<int32_t> schema_ids
+)
+        : m_archive_reader{std::move(archive_reader)},
+          m_match{std::move(match)},
+          m_expr{std::move(expr)},
+          m_ignore_case{ignore_case},
+          m_ordered{ordered},
+          m_schema_ids{std::move(schema_ids)} {
+    m_cursors.reserve(m_ordered ? m_schema_ids.size() : 1);
+}
+
+EventDecoder::~EventDecoder() noexcept {
+    // Release the tables before closing the archive they were read from.
+    m_cursor_queue = {};
+    m_cursors.clear();
+    try {
+        m_archive_reader->close();
+    } catch (std::exception const& ex) {
+        SPDLOG_ERROR("Exception while closing EventDecoder: {}", ex.what());
+    }
+}
+
+auto EventDecoder::decode_next_batch(size_t max_num_events, EventBatch& batch) -> size_t {
+    batch.clear();
+    while (batch.get_num_events() < max_num_events) {
+        if (m_cursor_queue.empty() && false == load_next_table()) {
+            break;
+        }
+
+        auto* cursor{m_cursor_queue.top()};
+        m_cursor_queue.pop();
+        batch.append(cursor->event, cursor->log_event_idx, cursor->timestamp);
+        if (cursor->decode_next_event()) {
+            m_cursor_queue.push(cursor);
+        } else {
+            release_table(*cursor);
+        }
+    }
+    return batch.get_num_events();
+}
+
+auto EventDecoder::TableCursor::decode_next_event() -> bool {
+    if (nullptr == filter) {
+        return reader->get_next_message_with_metadata(event, timestamp, log_event_idx);
+    }
+    return reader->get_next_message_with_metadata(event, timestamp, log_event_idx, *filter);
+}
+
+auto EventDecoder::load_next_table() -> bool {
+    while (m_next_schema_idx < m_schema_ids.size()) {
+        auto const schema_id{m_schema_ids[m_next_schema_idx]};
+        ++m_next_schema_idx;
+
+        // Reuse the last cursor unless it's still decoding a table.
+        if (m_cursors.empty() || (m_ordered && nullptr != m_cursors.back().reader)) {
+            m_cursors.emplace_back();
+        }
+        auto& cursor{m_cursors.back()};
+
+        if (nullptr != m_match) {
+            if (nullptr == cursor.query_runner) {
+                cursor.query_runner = std::make_unique<search::QueryRunner>(
+                        m_match,
+                        m_expr,
+                        m_archive_reader,
+                        m_ignore_case
+                );
+                cursor.query_runner->global_init();
+            }
+            if (EvaluatedValue::False == cursor.query_runner->schema_init(schema_id)) {
+                continue;
+            }
+        }
+
+        if (m_ordered) {
+            cursor.owned_reader = m_archive_reader->read_table(schema_id, true, true);
+            cursor.reader = cursor.owned_reader.get();
+        } else {
+            cursor.reader = &m_archive_reader->read_schema_table(schema_id, true, true);
+        }
+        if (nullptr != cursor.query_runner) {
+            cursor.filter = &cursor.query_runner->prepare_filter(*cursor.reader);
+        }
+
+        if (cursor.decode_next_event()) {
+            m_cursor_queue.push(&cursor);
+            return true;
+        }
+        release_table(cursor);
+    }
+    return false;
+}
+
+auto EventDecoder::release_table(TableCursor& cursor) -> void {
+    cursor.owned_reader.reset();
+    cursor.reader = nullptr;
+    cursor.filter = nullptr;
+}
+}  // namespace clp_s::ffi::sfa
@@ -0,0 +1,140 @@
+#ifndef CLP_S_FFI_SFA_EVENTDECODER_HPP
+#define CLP_S_FFI_SFA_EVENTDECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <ystdlib/error_handling/Result.hpp>
+
+#include <clp_s/ArchiveReader.hpp>
+#include <clp_s/Defs.hpp>
+#include <clp_s/ffi/sfa/ClpArchiveReader.hpp>
+#include <clp_s/SchemaReader.hpp>
+#include <clp_s/search/ast/Expression.hpp>
+#include <clp_s/search/QueryRunner.hpp>
+#include <clp_s/search/SchemaMatch.hpp>
+
+namespace clp_s::ffi::sfa {
+/**
+ * Decodes the events in an archive in batches for `ClpArchiveReader`, optionally filtering them
+ * with a query.
+ *
+ * Events are decoded either one schema table at a time, in the order the tables are stored, or in
+ * log order by merging every table that may contain matching events. Each table's next matching
+ * event is marshalled into a string owned by the table's cursor and reused for every event in the
+ * table, so decoding doesn't allocate per event.
+ */
+class EventDecoder {
+public:
+    // Factory function
+    /**
+     * Prepares to decode the events in an archive.
+     *
+     * @param archive_reader An open archive reader that hasn't read any tables.
+     * @param options
+     * @return A result containing the newly created `EventDecoder` on success, or an error code
+     * indicating the failure:
+     * - `SfaErrorCodeEnum::InvalidQuery` if the query can't be parsed or a projected column is
+     *   invalid.
+     * @throw clp_s::TraceableException if reading the archive fails.
+     */
+    [[nodiscard]] static auto
+    create(std::shared_ptr<ArchiveReader> archive_reader, DecodeOptions const& options)
+            -> ystdlib::error_handling::Result<std::unique_ptr<EventDecoder>>;
+
+    // Destructor
+    ~EventDecoder() noexcept;
+
+    // Delete copy & move constructors and assignment operators
+    EventDecoder(EventDecoder const&) = delete;
+    auto operator=(EventDecoder const&) -> EventDecoder& = delete;
+    EventDecoder(EventDecoder&&) = delete;
+    auto operator=(EventDecoder&&) -> EventDecoder& = delete;
+
+    // Methods
+    /**
+     * Decodes the next events into `batch`, replacing its contents.
+     *
+     * @param max_num_events The maximum number of events to decode.
+     * @param batch
+     * @return The number of events decoded, which is 0 once every event has been decoded.
+     * @throw clp_s::TraceableException if reading the archive fails.
+     */
+    [[nodiscard]] auto decode_next_batch(size_t max_num_events, EventBatch& batch) -> size_t;
+
+private:
+    // Types
+    /**
+     * The decoding state of a single schema table.
+     */
+    struct TableCursor {
+        // Methods
+        /**
+         * Decodes the table's next matching event into the cursor.
+         * @return Whether the table had another matching event.
+         */
+        [[nodiscard]] auto decode_next_event() -> bool;
+
+        // Members
+        // Only set when the table is read into its own reader, so that it can be released once
+        // every event in the table has been decoded.
+        std::shared_ptr<SchemaReader> owned_reader;
+        SchemaReader* reader{nullptr};
+        std::unique_ptr<search::QueryRunner> query_runner;
+        FilterClass* filter{nullptr};
+        std::string event;
+        epochtime_t timestamp{0};
+        int64_t log_event_idx{0};
+    };
+
+    struct LaterLogEventIdx {
+        auto operator()(TableCursor const* lhs, TableCursor const* rhs) const -> bool {
+            return lhs->log_event_idx > rhs->log_event_idx;
+        }
+    };
+
+    // Constructor
+    EventDecoder(
+            std::shared_ptr<ArchiveReader> archive_reader,
+            std::shared_ptr<search::SchemaMatch> match,
+            std::shared_ptr<search::ast::Expression> expr,
+            bool ignore_case,
+            bool ordered,
+            std::vector<int32_t> schema_ids
+    );
+
+    // Methods
+    /**
+     * Reads the next table that has a matching event and queues its cursor.
+     * @return Whether a table was queued.
+     */
+    [[nodiscard]] auto load_next_table() -> bool;
+
+    /**
+     * Releases the table read by a cursor once every event in it has been decoded.
+     * @param cursor
+     */
+    static auto release_table(TableCursor& cursor) -> void;
+
+    // Members
+    std::shared_ptr<ArchiveReader> m_archive_reader;
+    // Null if every event should be decoded
+    std::shared_ptr<search::SchemaMatch> m_match;
+    std::shared_ptr<search::ast::Expression> m_expr;
+    bool m_ignore_case{false};
+    bool m_ordered{false};
+    // The tables that may contain matching events, in the order they're stored in the archive
+    std::vector<int32_t> m_schema_ids;
+    size_t m_next_schema_idx{0};
+    // One cursor per table when decoding in log order, or a single reused cursor otherwise. Cursors
+    // are never added past the reserved capacity so that pointers to them remain valid.
+    std::vector<TableCursor> m_cursors;
+    std::priority_queue<TableCursor*, std::vector<TableCursor*>, LaterLogEventIdx> m_cursor_queue;
+};
+}  // namespace clp_s::ffi::sfa
+
+#endif  // CLP_S_FFI_SFA_EVENTDECODER_HPP
@@ -21,6 +21,8 @@ auto SfaErrorCategory::message(SfaErrorCodeEnum error_enum) const -> std::string
             return "insufficient memory";
         case SfaErrorCodeEnum::NotInit:
             return "the object is not initialized or has already been closed";
+        case SfaErrorCodeEnum::InvalidQuery:
+            return "the query or projection is invalid";
         default:
             return "unknown error code enum";
     }
@@ -13,6 +13,7 @@ enum class SfaErrorCodeEnum : uint8_t {
     IoFailure,
     NoMemory,
     NotInit,
+    InvalidQuery,
 };
 
 using SfaErrorCode = ystdlib::error_handling::ErrorCode<SfaErrorCodeEnum>;
@@ -20,6 +20,16 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
     po::options_description general_options("General Options");
     general_options.add_options()("help,h", "Print help");
 
+    // Define input options
+    po::options_description input_options("Input Options");
+    // clang-format off
+    input_options.add_options()(
+            "zstd-dictionaries",
+            po::value<std::string>(&m_zstd_dictionaries_dir)->value_name("DIR"),
+            "Directory of the trained zstd dictionaries the archive was compressed with"
+    );
+    // clang-format on
+
     // Define output options
     po::options_description output_options("Output Options");
     // clang-format off
@@ -34,6 +44,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
     // Define visible options
     po::options_description visible_options;
     visible_options.add(general_options);
+    visible_options.add(input_options);
     visible_options.add(output_options);
 
     std::string archive_path;
@@ -56,6 +67,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
     // Aggregate all options
     po::options_description all_options;
     all_options.add(general_options);
+    all_options.add(input_options);
     all_options.add(output_options);
     all_options.add(positional_options);
 
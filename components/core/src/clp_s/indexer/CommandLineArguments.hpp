@@ -38,6 +38,8 @@ public:
 
     bool should_create_table() const { return m_should_create_table; }
 
+    std::string const& get_zstd_dictionaries_dir() const { return m_zstd_dictionaries_dir; }
+
 private:
     // Methods
     void print_basic_usage() const;
@@ -46,6 +48,7 @@ private:
     std::string m_program_name;
     std::string m_dataset_name;
     Path m_archive_path;
+    std::string m_zstd_dictionaries_dir;
 
     std::optional<clp::GlobalMetadataDBConfig> m_metadata_db_config;
     bool m_should_create_table{false};
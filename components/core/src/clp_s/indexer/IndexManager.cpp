@@ -1,5 +1,6 @@
 #include "IndexManager.hpp"
 
+#include <exception>
 #include <filesystem>
 #include <memory>
 #include <stack>
@@ -38,7 +39,12 @@ IndexManager::IndexManager(
 
 IndexManager::~IndexManager() {
     if (m_output_type == OutputType::Database) {
-        m_mysql_index_storage->close();
+        // `close` inserts any buffered fields, which can throw
+        try {
+            m_mysql_index_storage->close();
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to close index storage: {}", e.what());
+        }
     }
 }
 
@@ -46,12 +52,14 @@ void IndexManager::update_metadata(std::string const& dataset_name, Path const&
     m_mysql_index_storage->init(dataset_name, m_should_create_table);
 
     ArchiveReader archive_reader;
+    archive_reader.set_zstd_dictionary_registry(m_zstd_dictionaries);
     archive_reader.open(archive_path, NetworkAuthOption{});
 
     traverse_schema_tree_and_update_metadata(
             archive_reader.get_schema_tree(),
             archive_reader.get_timestamp_dictionary()
     );
+    m_mysql_index_storage->flush();
 }
 
 std::string IndexManager::escape_key_name(std::string_view const key_name) {
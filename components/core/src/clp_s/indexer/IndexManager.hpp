@@ -4,10 +4,12 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 
 #include "../../clp/GlobalMetadataDBConfig.hpp"
 #include "../ArchiveReader.hpp"
 #include "../TimestampDictionaryReader.hpp"
+#include "../ZstdDictionaryRegistry.hpp"
 #include "MySQLIndexStorage.hpp"
 
 namespace clp_s::indexer {
@@ -53,6 +55,15 @@ public:
     ~IndexManager();
 
     // Methods
+    /**
+     * Sets the registry to load trained zstd dictionaries from when opening archives compressed
+     * with them.
+     * @param zstd_dictionaries
+     */
+    void set_zstd_dictionary_registry(std::shared_ptr<ZstdDictionaryRegistry> zstd_dictionaries) {
+        m_zstd_dictionaries = std::move(zstd_dictionaries);
+    }
+
     /**
      * Updates the metadata for a given archive
      * @param dataset_name
@@ -82,6 +93,7 @@ private:
     std::shared_ptr<MySQLIndexStorage> m_mysql_index_storage;
     bool m_should_create_table{false};
     std::function<void(std::string&, NodeType)> m_field_update_callback;
+    std::shared_ptr<ZstdDictionaryRegistry> m_zstd_dictionaries;
 };
 }  // namespace clp_s::indexer
 #endif  // CLP_S_INDEXER_INDEXMANAGER_HPP
@@ -1,5 +1,11 @@
 #include "MySQLIndexStorage.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <fmt/base.h>
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
@@ -28,6 +34,9 @@ void MySQLIndexStorage::init(std::string const& dataset_name, bool should_create
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
 
+    // Fields buffered for the previous table must be inserted before switching tables
+    flush();
+
     auto const table_name{
             fmt::format("{}{}_{}", m_table_prefix, dataset_name, cColumnMetadataTableSuffix)
     };
@@ -44,29 +53,9 @@ void MySQLIndexStorage::init(std::string const& dataset_name, bool should_create
         );
     }
 
-    m_insert_field_statement.reset();
-
-    std::vector<std::string> table_metadata_field_names(
-            clp::enum_to_underlying_type(TableMetadataFieldIndexes::Length)
-    );
-    table_metadata_field_names[clp::enum_to_underlying_type(TableMetadataFieldIndexes::Name)]
-            = "name";
-    table_metadata_field_names[clp::enum_to_underlying_type(TableMetadataFieldIndexes::Type)]
-            = "type";
-    fmt::memory_buffer statement_buffer;
-    auto statement_buffer_ix = std::back_inserter(statement_buffer);
-
-    fmt::format_to(
-            statement_buffer_ix,
-            "INSERT IGNORE INTO {} ({}) VALUES ({})",
-            table_name,
-            clp::get_field_names_sql(table_metadata_field_names),
-            clp::get_placeholders_sql(table_metadata_field_names.size())
-    );
-    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
-    m_insert_field_statement = std::make_unique<clp::MySQLPreparedStatement>(
-            m_db.prepare_statement(statement_buffer.data(), statement_buffer.size())
-    );
+    m_table_name = table_name;
+    m_insert_fields_statement = prepare_insert_fields_statement(cMaxFieldsPerInsert);
+    m_buffered_fields.reserve(cMaxFieldsPerInsert);
 
     m_is_init = true;
 }
@@ -76,28 +65,84 @@ void MySQLIndexStorage::add_field(std::string const& field_name, NodeType field_
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
 
-    auto& statement_bindings = m_insert_field_statement->get_statement_bindings();
-    statement_bindings.bind_varchar(
-            clp::enum_to_underlying_type(TableMetadataFieldIndexes::Name),
-            field_name.c_str(),
-            field_name.length()
-    );
+    m_buffered_fields.emplace_back(field_name, static_cast<uint8_t>(field_type));
+    if (cMaxFieldsPerInsert == m_buffered_fields.size()) {
+        flush();
+    }
+}
 
-    auto field_type_value = static_cast<uint8_t>(field_type);
-    statement_bindings.bind_uint8(
-            clp::enum_to_underlying_type(TableMetadataFieldIndexes::Type),
-            field_type_value
-    );
+void MySQLIndexStorage::flush() {
+    if (m_buffered_fields.empty()) {
+        return;
+    }
 
-    if (false == m_insert_field_statement->execute()) {
+    std::unique_ptr<clp::MySQLPreparedStatement> partial_batch_statement;
+    auto* statement = m_insert_fields_statement.get();
+    if (cMaxFieldsPerInsert != m_buffered_fields.size()) {
+        partial_batch_statement = prepare_insert_fields_statement(m_buffered_fields.size());
+        statement = partial_batch_statement.get();
+    }
+
+    auto& statement_bindings = statement->get_statement_bindings();
+    for (size_t i = 0; i < m_buffered_fields.size(); ++i) {
+        auto& [field_name, field_type_value] = m_buffered_fields[i];
+        auto const get_placeholder_ix = [&](TableMetadataFieldIndexes field) -> size_t {
+            return clp::get_multi_row_placeholder_ix(
+                    clp::enum_to_underlying_type(field),
+                    i,
+                    clp::enum_to_underlying_type(TableMetadataFieldIndexes::Length)
+            );
+        };
+        statement_bindings.bind_varchar(
+                get_placeholder_ix(TableMetadataFieldIndexes::Name),
+                field_name.c_str(),
+                field_name.length()
+        );
+        statement_bindings.bind_uint8(
+                get_placeholder_ix(TableMetadataFieldIndexes::Type),
+                field_type_value
+        );
+    }
+
+    if (false == statement->execute()) {
         throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
     }
+    m_buffered_fields.clear();
 }
 
 void MySQLIndexStorage::close() {
-    m_insert_field_statement.reset();
+    if (m_is_init) {
+        flush();
+    }
+    m_buffered_fields.clear();
+    m_insert_fields_statement.reset();
     m_db.close();
     m_is_open = false;
     m_is_init = false;
 }
+
+auto MySQLIndexStorage::prepare_insert_fields_statement(size_t num_fields)
+        -> std::unique_ptr<clp::MySQLPreparedStatement> {
+    std::vector<std::string> table_metadata_field_names(
+            clp::enum_to_underlying_type(TableMetadataFieldIndexes::Length)
+    );
+    table_metadata_field_names[clp::enum_to_underlying_type(TableMetadataFieldIndexes::Name)]
+            = "name";
+    table_metadata_field_names[clp::enum_to_underlying_type(TableMetadataFieldIndexes::Type)]
+            = "type";
+    fmt::memory_buffer statement_buffer;
+    auto statement_buffer_ix = std::back_inserter(statement_buffer);
+
+    fmt::format_to(
+            statement_buffer_ix,
+            "INSERT IGNORE INTO {} ({}) VALUES {}",
+            m_table_name,
+            clp::get_field_names_sql(table_metadata_field_names),
+            clp::get_multi_row_placeholders_sql(table_metadata_field_names.size(), num_fields)
+    );
+    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
+    return std::make_unique<clp::MySQLPreparedStatement>(
+            m_db.prepare_statement(statement_buffer.data(), statement_buffer.size())
+    );
+}
 }  // namespace clp_s::indexer
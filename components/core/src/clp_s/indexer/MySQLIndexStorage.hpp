@@ -1,6 +1,13 @@
 #ifndef CLP_S_INDEXER_MYSQLINDEXSTORAGE_HPP
 #define CLP_S_INDEXER_MYSQLINDEXSTORAGE_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "../../clp/MySQLDB.hpp"
 #include "../../clp/MySQLPreparedStatement.hpp"
 #include "../SchemaTree.hpp"
@@ -54,18 +61,39 @@ public:
     void init(std::string const& dataset_name, bool should_create_table);
 
     /**
-     * Closes the database connection
+     * Inserts any buffered fields into the table and closes the database connection
      */
     void close();
 
     /**
-     * Adds a field (column) to the table
+     * Adds a field (column) to the table. Fields are buffered and inserted in batches, so they may
+     * not be in the table until `flush` is called.
      * @param field_name
      * @param field_type
      */
     void add_field(std::string const& field_name, NodeType field_type);
 
+    /**
+     * Inserts all buffered fields into the table
+     */
+    void flush();
+
 private:
+    // Constants
+    // Maximum number of fields to insert with a single statement. Buffered fields are only written
+    // when a batch fills, or by `init`, `flush`, and `close`; there's no background or time-based
+    // flush.
+    static constexpr size_t cMaxFieldsPerInsert{512};
+
+    // Methods
+    /**
+     * Prepares a statement that inserts the given number of fields at once
+     * @param num_fields
+     * @return The prepared statement
+     */
+    [[nodiscard]] auto prepare_insert_fields_statement(size_t num_fields)
+            -> std::unique_ptr<clp::MySQLPreparedStatement>;
+
     // Variables
     bool m_is_open{};
     bool m_is_init{};
@@ -78,7 +106,9 @@ private:
 
     clp::MySQLDB m_db;
 
-    std::unique_ptr<clp::MySQLPreparedStatement> m_insert_field_statement;
+    std::string m_table_name;
+    std::unique_ptr<clp::MySQLPreparedStatement> m_insert_fields_statement;
+    std::vector<std::pair<std::string, uint8_t>> m_buffered_fields;
 };
 }  // namespace clp_s::indexer
 
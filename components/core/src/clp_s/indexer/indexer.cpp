@@ -1,9 +1,11 @@
 #include <exception>
 #include <filesystem>
+#include <memory>
 
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include "../ZstdDictionaryRegistry.hpp"
 #include "CommandLineArguments.hpp"
 #include "IndexManager.hpp"
 
@@ -35,6 +37,13 @@ int main(int argc, char const* argv[]) {
                 command_line_arguments.get_db_config(),
                 command_line_arguments.should_create_table()
         );
+        if (auto const& zstd_dictionaries_dir{command_line_arguments.get_zstd_dictionaries_dir()};
+            false == zstd_dictionaries_dir.empty())
+        {
+            index_manager.set_zstd_dictionary_registry(
+                    std::make_shared<clp_s::ZstdDictionaryRegistry>(zstd_dictionaries_dir)
+            );
+        }
         index_manager.update_metadata(
                 command_line_arguments.get_dataset_name(),
                 command_line_arguments.get_archive_path()
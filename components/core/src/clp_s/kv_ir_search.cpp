@@ -2,34 +2,48 @@
 
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <ostream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <variant>
+#include <vector>
 
-#include <fmt/format.h>
-#include <nlohmann/json_fwd.hpp>
 #include <spdlog/spdlog.h>
 #include <ystdlib/error_handling/ErrorCode.hpp>
 #include <ystdlib/error_handling/Result.hpp>
 
+#include "../clp/BufferReader.hpp"
 #include "../clp/ErrorCode.hpp"
 #include "../clp/ffi/ir_stream/Deserializer.hpp"
 #include "../clp/ffi/ir_stream/IrUnitType.hpp"
 #include "../clp/ffi/ir_stream/search/QueryHandler.hpp"
 #include "../clp/ffi/KeyValuePairLogEvent.hpp"
 #include "../clp/ffi/SchemaTree.hpp"
+#include "../clp/FileReader.hpp"
 #include "../clp/ReaderInterface.hpp"
 #include "../clp/spdlog_with_specializations.hpp"
 #include "../clp/streaming_compression/zstd/Decompressor.hpp"
 #include "../clp/time_types.hpp"
 #include "../clp/TraceableException.hpp"
+#include "../clp/type_utils.hpp"
 #include "CommandLineArguments.hpp"
 #include "InputConfig.hpp"
+#include "KvIrBlockIndex.hpp"
+#include "search/ast/AndExpr.hpp"
 #include "search/ast/Expression.hpp"
+#include "search/ast/FilterExpr.hpp"
+#include "search/ast/FilterOperation.hpp"
+#include "search/ast/SearchUtils.hpp"
 #include "search/ast/SetTimestampLiteralPrecision.hpp"
+#include "search/ast/StringLiteral.hpp"
 #include "search/ast/TimestampLiteral.hpp"
 
 // This include has a circular dependency with the `.inc` file.
@@ -39,7 +53,11 @@
 
 using clp_s::KvIrSearchError;
 using clp_s::KvIrSearchErrorEnum;
+using clp_s::search::ast::AndExpr;
+using clp_s::search::ast::FilterExpr;
+using clp_s::search::ast::FilterOperation;
 using clp_s::search::ast::SetTimestampLiteralPrecision;
+using clp_s::search::ast::StringLiteral;
 using clp_s::search::ast::TimestampLiteral;
 using KvIrSearchErrorCategory = ystdlib::error_handling::ErrorCategory<KvIrSearchErrorEnum>;
 
@@ -52,20 +70,13 @@ using clp::ffi::KeyValuePairLogEvent;
 using clp::ffi::SchemaTree;
 using clp::UtcOffset;
 
+/**
+ * Writes every log event it handles to an output stream as a line of JSON.
+ */
 class IrUnitHandler {
 public:
-    // Factory function
-    /**
-     * @param command_line_arguments
-     * @param reducer_socket_fd
-     * @return A result containing the created IrUnitHandler on success, or an error code indicating
-     * the failure:
-     * - KvIrSearchErrorEnum::UnsupportedOutputHandlerType if the output handler type is not
-     *   supported.
-     */
-    [[nodiscard]] static auto
-    create(CommandLineArguments const& command_line_arguments, int reducer_socket_fd)
-            -> ystdlib::error_handling::Result<IrUnitHandler>;
+    // Constructor
+    explicit IrUnitHandler(std::ostream& output) : m_output{&output} {}
 
     // Delete copy constructor and assignment operator
     IrUnitHandler(IrUnitHandler const&) = delete;
@@ -103,183 +114,360 @@ public:
     }
 
 private:
-    // Constructor
-    IrUnitHandler() = default;
+    // Variables
+    std::ostream* m_output;
+    std::string m_json_buf;
 };
 
+constexpr auto cTrivialNewProjectedSchemaTreeNodeCallback
+        = []([[maybe_unused]] bool is_auto_generated,
+             [[maybe_unused]] SchemaTree::Node::id_t node_id,
+             [[maybe_unused]] std::pair<std::string_view, size_t> projected_key_and_index)
+        -> ystdlib::error_handling::Result<void> { return ystdlib::error_handling::success(); };
+
+using QueryHandlerType = clp::ffi::ir_stream::search::
+        QueryHandler<decltype(cTrivialNewProjectedSchemaTreeNodeCallback)>;
+
 /**
- * Deserializes the kv-pair IR stream from the given stream reader and performs query search.
- * @param stream_reader The stream reader to read the kv-pair IR stream from.
- * @param command_line_arguments
+ * Creates a deserializer that searches the kv-pair IR stream with the given query, reading the
+ * stream's preamble from the given reader.
+ * @param reader
  * @param query
- * @param reducer_socket_fd
- * @return A void result on success, or an error code indicating the failure:
+ * @param options
+ * @param output
+ * @return A result containing the deserializer on success, or an error code indicating the failure:
  * - KvIrSearchErrorEnum::DeserializerCreationFailure if `clp::ffi::ir_stream::Deserializer::create`
  *   failed. This specific error code is returned instead of propagating the return values of
  *   `clp::ffi::ir_stream::Deserializer::create`, allowing callers to identify cases where the input
  *   might not be a kv-pair IR stream.
- * - Forwards `clp::ffi::ir_stream::Deserializer::deserialize_next_ir_unit`'s return values.
  * - Forwards `clp::ffi::ir_stream::search::QueryHandler::create`'s return values.
- * - Forwards `IrUnitHandler::create`'s return values.
+ */
+[[nodiscard]] auto create_deserializer(
+        clp::ReaderInterface& reader,
+        std::shared_ptr<search::ast::Expression> query,
+        KvIrSearchOptions const& options,
+        std::ostream& output
+)
+        -> ystdlib::error_handling::Result<
+                clp::ffi::ir_stream::Deserializer<IrUnitHandler, QueryHandlerType>>;
+
+/**
+ * Deserializes the kv-pair IR stream from the given stream reader and performs query search.
+ * @param stream_reader The stream reader to read the kv-pair IR stream from.
+ * @param query
+ * @param options
+ * @param output
+ * @return A void result on success, or an error code indicating the failure:
+ * - Forwards `create_deserializer`'s return values.
+ * - Forwards `clp::ffi::ir_stream::Deserializer::deserialize_next_ir_unit`'s return values.
  */
 [[nodiscard]] auto deserialize_and_search_kv_ir_stream(
         clp::ReaderInterface& stream_reader,
-        CommandLineArguments const& command_line_arguments,
         std::shared_ptr<search::ast::Expression> query,
-        int reducer_socket_fd
+        KvIrSearchOptions const& options,
+        std::ostream& output
 ) -> ystdlib::error_handling::Result<void>;
 
-auto IrUnitHandler::create(
-        CommandLineArguments const& command_line_arguments,
-        [[maybe_unused]] int reducer_socket_fd
-) -> ystdlib::error_handling::Result<IrUnitHandler> {
-    if (false
-        == std::holds_alternative<CommandLineArguments::StdoutOutputHandlerOptions>(
-                command_line_arguments.get_output_handler_options()
-        ))
-    {
-        SPDLOG_ERROR(
-                "kv-ir search: Only stdout output is supported in the current implementation."
-        );
-        return KvIrSearchError{KvIrSearchErrorEnum::UnsupportedOutputHandlerType};
-    }
-    return IrUnitHandler{};
-}
+/**
+ * Tries to read the sidecar block index of the given kv-pair IR stream.
+ * @param stream_path
+ * @return The block index if the stream is on the local filesystem and has a readable sidecar
+ * block index, or std::nullopt otherwise.
+ */
+[[nodiscard]] auto try_read_block_index(Path const& stream_path) -> std::optional<KvIrBlockIndex>;
+
+/**
+ * Collects the string values that every log event matching the given query must contain (as a
+ * whole value, or as a space-delimited token), by walking the query's top-level conjunction of
+ * string equality filters.
+ * @param expr
+ * @param required_values Returns the collected values.
+ */
+auto collect_required_string_values(
+        std::shared_ptr<search::ast::Expression> const& expr,
+        std::vector<std::string>& required_values
+) -> void;
 
 /**
- * The following clang-tidy check is disabled because this function is intentionally designed as a
- * non-static member function for the following reasons:
- * - It is expected to be extended in the future to support additional search features.
- * - It must be invoked through an object created by the factory function, which ensures all
- *   necessary validations are performed.
+ * Searches the candidate blocks of an indexed kv-pair IR stream with the given query.
+ *
+ * Each block is deserialized by a dedicated deserializer that's initialized with the stream's
+ * preamble and the block's sync point, so the blocks that can't match are never read.
+ * @param raw_reader A reader for the on-disk stream.
+ * @param block_index
+ * @param query
+ * @param options
+ * @param output
+ * @return A void result on success, or an error code indicating the failure:
+ * - KvIrSearchErrorEnum::BlockSeekFailure if the reader can't seek to a candidate block.
+ * - Forwards `create_deserializer`'s return values.
+ * - Forwards `clp::ffi::ir_stream::Deserializer::deserialize_next_ir_unit`'s return values.
  */
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+[[nodiscard]] auto search_kv_ir_stream_blocks(
+        clp::ReaderInterface& raw_reader,
+        KvIrBlockIndex const& block_index,
+        std::shared_ptr<search::ast::Expression> const& query,
+        KvIrSearchOptions const& options,
+        std::ostream& output
+) -> ystdlib::error_handling::Result<void>;
+
 auto IrUnitHandler::handle_log_event(
         clp::ffi::KeyValuePairLogEvent log_event,
         [[maybe_unused]] size_t log_event_idx
 ) -> IRErrorCode {
-    auto const serialize_result{log_event.serialize_to_json()};
+    constexpr std::string_view cAutoGenKeyPrefix{"{\"auto_generated_kv_pairs\":"};
+    constexpr std::string_view cUserGenKeyPrefix{",\"user_generated_kv_pairs\":"};
+
+    // The JSON string is written directly into a reused buffer to avoid constructing intermediate
+    // `nlohmann::json` objects and reallocating the output for every log event.
+    m_json_buf.clear();
+    m_json_buf += cAutoGenKeyPrefix;
+    auto serialize_result{log_event.serialize_auto_gen_kv_pairs_to_json_str(m_json_buf)};
+    if (false == serialize_result.has_error()) {
+        m_json_buf += cUserGenKeyPrefix;
+        serialize_result = log_event.serialize_user_gen_kv_pairs_to_json_str(m_json_buf);
+    }
     if (serialize_result.has_error()) {
         SPDLOG_ERROR(
-                "kv-ir search: Failed to serialize kv-pair log event to JSON objects."
+                "kv-ir search: Failed to serialize kv-pair log event into JSON strings."
                 " error_category={}, error={}",
                 serialize_result.error().category().name(),
                 serialize_result.error().message()
         );
         return IRErrorCode::IRErrorCode_Decode_Error;
     }
-    auto const& [auto_gen_kv_pairs, user_gen_kv_pairs] = serialize_result.value();
-
-    try {
-        constexpr std::string_view cAutoGenKey{"\"auto_generated_kv_pairs\""};
-        constexpr std::string_view cUserGenKey{"\"user_generated_kv_pairs\""};
-        std::cout << fmt::format(
-                "{{{}:{},{}:{}}}\n",
-                cAutoGenKey,
-                auto_gen_kv_pairs.dump(),
-                cUserGenKey,
-                user_gen_kv_pairs.dump()
-        );
-    } catch (nlohmann::json::exception const& ex) {
-        SPDLOG_ERROR(
-                "kv-ir search: Failed to serialize kv-pair log event into JSON strings."
-                " ErrorMessage={}",
-                ex.what()
-        );
-        return IRErrorCode::IRErrorCode_Corrupted_IR;
-    }
+    m_json_buf += "}\n";
+    *m_output << m_json_buf;
 
     return IRErrorCode::IRErrorCode_Success;
 }
 
-auto deserialize_and_search_kv_ir_stream(
-        clp::ReaderInterface& stream_reader,
-        CommandLineArguments const& command_line_arguments,
+auto create_deserializer(
+        clp::ReaderInterface& reader,
         std::shared_ptr<search::ast::Expression> query,
-        int reducer_socket_fd
-) -> ystdlib::error_handling::Result<void> {
-    auto trivial_new_projected_schema_tree_node_callback
-            = []([[maybe_unused]] bool is_auto_generated,
-                 [[maybe_unused]] SchemaTree::Node::id_t node_id,
-                 [[maybe_unused]] std::pair<std::string_view, size_t> projected_key_and_index)
-            -> ystdlib::error_handling::Result<void> { return ystdlib::error_handling::success(); };
-    using QueryHandlerType = clp::ffi::ir_stream::search::
-            QueryHandler<decltype(trivial_new_projected_schema_tree_node_callback)>;
-
-    auto ir_unit_handler{YSTDLIB_ERROR_HANDLING_TRYX(
-            IrUnitHandler::create(command_line_arguments, reducer_socket_fd)
-    )};
+        KvIrSearchOptions const& options,
+        std::ostream& output
+)
+        -> ystdlib::error_handling::Result<
+                clp::ffi::ir_stream::Deserializer<IrUnitHandler, QueryHandlerType>> {
     auto query_handler{YSTDLIB_ERROR_HANDLING_TRYX(
             QueryHandlerType::create(
-                    trivial_new_projected_schema_tree_node_callback,
+                    cTrivialNewProjectedSchemaTreeNodeCallback,
                     std::move(query),
                     {},
-                    false == command_line_arguments.get_ignore_case()
+                    false == options.ignore_case
             )
     )};
 
     auto deserializer_result{
-            make_deserializer(stream_reader, std::move(ir_unit_handler), std::move(query_handler))
+            make_deserializer(reader, IrUnitHandler{output}, std::move(query_handler))
     };
-
     if (deserializer_result.has_error()) {
         return KvIrSearchError{KvIrSearchErrorEnum::DeserializerCreationFailure};
     }
+    return std::move(deserializer_result.value());
+}
 
-    auto& deserializer{deserializer_result.value()};
+auto deserialize_and_search_kv_ir_stream(
+        clp::ReaderInterface& stream_reader,
+        std::shared_ptr<search::ast::Expression> query,
+        KvIrSearchOptions const& options,
+        std::ostream& output
+) -> ystdlib::error_handling::Result<void> {
+    auto deserializer{YSTDLIB_ERROR_HANDLING_TRYX(
+            create_deserializer(stream_reader, std::move(query), options, output)
+    )};
     while (IrUnitType::EndOfStream
            != YSTDLIB_ERROR_HANDLING_TRYX(deserializer.deserialize_next_ir_unit(stream_reader)))
     {}
 
     return ystdlib::error_handling::success();
 }
-}  // namespace
 
-auto search_kv_ir_stream(
-        Path const& stream_path,
-        CommandLineArguments const& command_line_arguments,
-        std::shared_ptr<search::ast::Expression> query,
-        int reducer_socket_fd
-) -> ystdlib::error_handling::Result<void> {
-    if (false == command_line_arguments.get_projection_columns().empty()) {
-        SPDLOG_ERROR("kv-ir search: Projection support is not implemented.");
-        return KvIrSearchError{KvIrSearchErrorEnum::ProjectionSupportNotImplemented};
+auto try_read_block_index(Path const& stream_path) -> std::optional<KvIrBlockIndex> {
+    if (InputSource::Filesystem != stream_path.source) {
+        return std::nullopt;
+    }
+    auto const index_path{stream_path.path + std::string{cKvIrBlockIndexFileExtension}};
+    std::error_code ec;
+    if (false == std::filesystem::is_regular_file(index_path, ec)) {
+        return std::nullopt;
     }
 
-    if (command_line_arguments.get_aggregator().has_value()) {
-        SPDLOG_ERROR("kv-ir search: Aggregation support is not implemented.");
-        return KvIrSearchError{KvIrSearchErrorEnum::AggregationSupportNotImplemented};
+    try {
+        clp::FileReader index_reader{index_path};
+        auto index_result{KvIrBlockIndex::try_read(index_reader)};
+        if (index_result.has_error()) {
+            SPDLOG_WARN(
+                    "kv-ir search: Ignoring unreadable block index {}: {} - {}",
+                    index_path,
+                    index_result.error().category().name(),
+                    index_result.error().message()
+            );
+            return std::nullopt;
+        }
+        return std::move(index_result.value());
+    } catch (std::exception const& ex) {
+        SPDLOG_WARN("kv-ir search: Ignoring unreadable block index {}: {}", index_path, ex.what());
+        return std::nullopt;
     }
+}
 
-    auto const raw_reader{
-            try_create_reader(stream_path, command_line_arguments.get_network_auth())
-    };
-    if (nullptr == raw_reader) {
-        return KvIrSearchError{KvIrSearchErrorEnum::StreamReaderCreationFailure};
+auto collect_required_string_values(
+        std::shared_ptr<search::ast::Expression> const& expr,
+        std::vector<std::string>& required_values
+) -> void {
+    if (nullptr == expr || expr->is_inverted()) {
+        return;
     }
 
-    if (command_line_arguments.get_search_begin_ts().has_value()
-        || command_line_arguments.get_search_end_ts().has_value())
+    if (auto const and_expr{std::dynamic_pointer_cast<AndExpr>(expr)}; nullptr != and_expr) {
+        for (auto const& operand : and_expr->get_op_list()) {
+            collect_required_string_values(
+                    std::dynamic_pointer_cast<search::ast::Expression>(operand),
+                    required_values
+            );
+        }
+        return;
+    }
+
+    auto const filter_expr{std::dynamic_pointer_cast<FilterExpr>(expr)};
+    if (nullptr == filter_expr || FilterOperation::EQ != filter_expr->get_operation()) {
+        return;
+    }
+    auto const literal{std::dynamic_pointer_cast<StringLiteral>(filter_expr->get_operand())};
+    if (nullptr == literal) {
+        return;
+    }
+
+    // Only string values are recorded in the block index, so skip literals that may also match
+    // non-string values. Literals with escape sequences are skipped for simplicity.
+    int64_t int_value{};
+    double float_value{};
+    bool bool_value{};
+    if (literal->as_int(int_value, FilterOperation::EQ)
+        || literal->as_float(float_value, FilterOperation::EQ)
+        || literal->as_bool(bool_value, FilterOperation::EQ)
+        || literal->as_null(FilterOperation::EQ))
     {
-        SPDLOG_WARN(
-                "kv-ir search: Timestamp filters are currently not supported."
-                " Values will be ignored."
-        );
+        return;
+    }
+    auto const& value{literal->get()};
+    if (std::string::npos != value.find('\\')) {
+        return;
     }
 
+    if (false == search::ast::has_unescaped_wildcards(value)) {
+        required_values.emplace_back(value);
+        return;
+    }
+
+    // For wildcard queries, every token that's delimited by spaces on both sides must appear as a
+    // whole token in a matching value.
+    constexpr char cTokenDelimiter{' '};
+    auto token_begin{value.find(cTokenDelimiter)};
+    while (std::string::npos != token_begin) {
+        ++token_begin;
+        auto const token_end{value.find(cTokenDelimiter, token_begin)};
+        if (std::string::npos == token_end) {
+            break;
+        }
+        auto const token{std::string_view{value}.substr(token_begin, token_end - token_begin)};
+        if (false == token.empty() && false == search::ast::has_unescaped_wildcards(token)) {
+            required_values.emplace_back(token);
+        }
+        token_begin = token_end;
+    }
+}
+
+auto search_kv_ir_stream_blocks(
+        clp::ReaderInterface& raw_reader,
+        KvIrBlockIndex const& block_index,
+        std::shared_ptr<search::ast::Expression> const& query,
+        KvIrSearchOptions const& options,
+        std::ostream& output
+) -> ystdlib::error_handling::Result<void> {
+    std::vector<std::string> required_values;
+    if (false == options.ignore_case) {
+        collect_required_string_values(query, required_values);
+    }
+    auto const candidate_blocks{
+            block_index.get_candidate_blocks(options.begin_ts, options.end_ts, required_values)
+    };
+    SPDLOG_DEBUG(
+            "kv-ir search: Searching {} of {} blocks.",
+            candidate_blocks.size(),
+            block_index.get_blocks().size()
+    );
+
+    auto const& preamble{block_index.get_preamble()};
+    for (auto const block_idx : candidate_blocks) {
+        auto const& block{block_index.get_blocks()[block_idx]};
+        if (clp::ErrorCode_Success != raw_reader.try_seek_from_begin(block.stream_offset)) {
+            return KvIrSearchError{KvIrSearchErrorEnum::BlockSeekFailure};
+        }
+
+        clp::BufferReader preamble_reader{
+                clp::size_checked_pointer_cast<char const>(preamble.data()),
+                preamble.size()
+        };
+        auto deserializer{YSTDLIB_ERROR_HANDLING_TRYX(
+                create_deserializer(preamble_reader, query->copy(), options, output)
+        )};
+
+        clp::BufferReader sync_point_reader{
+                clp::size_checked_pointer_cast<char const>(block.sync_point.data()),
+                block.sync_point.size()
+        };
+        while (sync_point_reader.get_pos() < block.sync_point.size()) {
+            YSTDLIB_ERROR_HANDLING_TRYV(deserializer.deserialize_next_ir_unit(sync_point_reader));
+        }
+
+        clp::streaming_compression::zstd::Decompressor decompressor;
+        clp::ReaderInterface* block_reader{&raw_reader};
+        if (block_index.is_stream_compressed()) {
+            constexpr size_t cReaderBufferSize{64L * 1024L};  // 64 KiB
+            decompressor.open(raw_reader, cReaderBufferSize);
+            block_reader = &decompressor;
+        }
+        while (deserializer.get_num_log_events_deserialized() < block.num_log_events) {
+            if (IrUnitType::EndOfStream
+                == YSTDLIB_ERROR_HANDLING_TRYX(deserializer.deserialize_next_ir_unit(*block_reader)
+                ))
+            {
+                break;
+            }
+        }
+        if (block_index.is_stream_compressed()) {
+            decompressor.close();
+        }
+    }
+
+    return ystdlib::error_handling::success();
+}
+}  // namespace
+
+auto search_kv_ir_stream(
+        clp::ReaderInterface& raw_reader,
+        KvIrBlockIndex const* block_index,
+        std::shared_ptr<search::ast::Expression> query,
+        KvIrSearchOptions const& options,
+        std::ostream& output
+) -> ystdlib::error_handling::Result<void> {
     SetTimestampLiteralPrecision date_precision_pass{TimestampLiteral::Precision::Milliseconds};
     query = date_precision_pass.run(query);
 
     try {
+        if (nullptr != block_index) {
+            return search_kv_ir_stream_blocks(raw_reader, *block_index, query, options, output);
+        }
+
         clp::streaming_compression::zstd::Decompressor decompressor;
         constexpr size_t cReaderBufferSize{64L * 1024L};  // 64 KiB
-        decompressor.open(*raw_reader, cReaderBufferSize);
-        YSTDLIB_ERROR_HANDLING_TRYV(deserialize_and_search_kv_ir_stream(
-                decompressor,
-                command_line_arguments,
-                std::move(query),
-                reducer_socket_fd
-        ));
+        decompressor.open(raw_reader, cReaderBufferSize);
+        YSTDLIB_ERROR_HANDLING_TRYV(
+                deserialize_and_search_kv_ir_stream(decompressor, std::move(query), options, output)
+        );
         decompressor.close();
     } catch (clp::TraceableException const& ex) {
         auto const err{ex.get_error_code()};
@@ -301,6 +489,70 @@ auto search_kv_ir_stream(
 
     return ystdlib::error_handling::success();
 }
+
+auto search_kv_ir_stream(
+        Path const& stream_path,
+        CommandLineArguments const& command_line_arguments,
+        std::shared_ptr<search::ast::Expression> query,
+        [[maybe_unused]] int reducer_socket_fd
+) -> ystdlib::error_handling::Result<void> {
+    if (false == command_line_arguments.get_projection_columns().empty()) {
+        SPDLOG_ERROR("kv-ir search: Projection support is not implemented.");
+        return KvIrSearchError{KvIrSearchErrorEnum::ProjectionSupportNotImplemented};
+    }
+
+    if (command_line_arguments.get_aggregator().has_value()) {
+        SPDLOG_ERROR("kv-ir search: Aggregation support is not implemented.");
+        return KvIrSearchError{KvIrSearchErrorEnum::AggregationSupportNotImplemented};
+    }
+
+    if (false
+        == std::holds_alternative<CommandLineArguments::StdoutOutputHandlerOptions>(
+                command_line_arguments.get_output_handler_options()
+        ))
+    {
+        SPDLOG_ERROR(
+                "kv-ir search: Only stdout output is supported in the current implementation."
+        );
+        return KvIrSearchError{KvIrSearchErrorEnum::UnsupportedOutputHandlerType};
+    }
+
+    auto const raw_reader{
+            try_create_reader(stream_path, command_line_arguments.get_network_auth())
+    };
+    if (nullptr == raw_reader) {
+        return KvIrSearchError{KvIrSearchErrorEnum::StreamReaderCreationFailure};
+    }
+
+    auto const optional_block_index{try_read_block_index(stream_path)};
+    if (command_line_arguments.get_search_begin_ts().has_value()
+        || command_line_arguments.get_search_end_ts().has_value())
+    {
+        if (optional_block_index.has_value()) {
+            SPDLOG_WARN(
+                    "kv-ir search: Timestamp filters are only applied at block granularity."
+                    " Log events outside the given range may be returned."
+            );
+        } else {
+            SPDLOG_WARN(
+                    "kv-ir search: Timestamp filters are currently not supported."
+                    " Values will be ignored."
+            );
+        }
+    }
+
+    return search_kv_ir_stream(
+            *raw_reader,
+            optional_block_index.has_value() ? &optional_block_index.value() : nullptr,
+            std::move(query),
+            KvIrSearchOptions{
+                    .begin_ts = command_line_arguments.get_search_begin_ts(),
+                    .end_ts = command_line_arguments.get_search_end_ts(),
+                    .ignore_case = command_line_arguments.get_ignore_case()
+            },
+            std::cout
+    );
+}
 }  // namespace clp_s
 
 template <>
@@ -315,6 +567,8 @@ auto KvIrSearchErrorCategory::message(KvIrSearchErrorEnum error_enum) const -> s
             return "clp legacy error.";
         case KvIrSearchErrorEnum::AggregationSupportNotImplemented:
             return "Aggregation support is not implemented.";
+        case KvIrSearchErrorEnum::BlockSeekFailure:
+            return "Failed to seek to a block of the kv-pair IR stream.";
         case KvIrSearchErrorEnum::DeserializerCreationFailure:
             return "Failed to create `clp::ffi::ir_stream::Deserializer`.";
         case KvIrSearchErrorEnum::ProjectionSupportNotImplemented:
@@ -3,18 +3,24 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <ostream>
 
 #include <ystdlib/error_handling/ErrorCode.hpp>
 #include <ystdlib/error_handling/Result.hpp>
 
+#include "../clp/ReaderInterface.hpp"
 #include "CommandLineArguments.hpp"
+#include "Defs.hpp"
 #include "InputConfig.hpp"
+#include "KvIrBlockIndex.hpp"
 #include "search/ast/Expression.hpp"
 
 namespace clp_s {
 enum class KvIrSearchErrorEnum : uint8_t {
     ClpLegacyError = 1,
     AggregationSupportNotImplemented,
+    BlockSeekFailure,
     DeserializerCreationFailure,
     ProjectionSupportNotImplemented,
     StreamReaderCreationFailure,
@@ -24,18 +30,60 @@ enum class KvIrSearchErrorEnum : uint8_t {
 using KvIrSearchError = ystdlib::error_handling::ErrorCode<KvIrSearchErrorEnum>;
 
 /**
- * Searches the given kv-pair IR stream with the given query.
+ * Options for searching a kv-pair IR stream.
+ */
+struct KvIrSearchOptions {
+    // Inclusive timestamp bounds, in epoch milliseconds
+    std::optional<epochtime_t> begin_ts;
+    std::optional<epochtime_t> end_ts;
+    bool ignore_case{false};
+};
+
+/**
+ * Searches the given zstd-compressed kv-pair IR stream with the given query, writing each matching
+ * log event to `output` as a line of JSON.
+ *
+ * If a block index is given, only the blocks that may match the query's required string values
+ * and the given timestamp bounds are deserialized and searched. Timestamp bounds are only applied
+ * at block granularity, and are ignored entirely if no block index is given.
+ * @param raw_reader A reader for the on-disk stream.
+ * @param block_index The stream's sidecar block index, or nullptr if the stream isn't indexed.
+ * @param query
+ * @param options
+ * @param output
+ * @return A void result on success, or an error code indicating the failure:
+ * - KvIrSearchErrorEnum::ClpLegacyError if a `clp::TraceableException` is caught.
+ * - KvIrSearchErrorEnum::BlockSeekFailure if the reader can't seek to a candidate block.
+ * - KvIrSearchErrorEnum::DeserializerCreationFailure if `clp::ffi::ir_stream::Deserializer::create`
+ *   failed.
+ * - Forwards `clp::ffi::ir_stream::search::QueryHandler::create`'s return values.
+ * - Forwards `clp::ffi::ir_stream::Deserializer::deserialize_next_ir_unit`'s return values.
+ */
+[[nodiscard]] auto search_kv_ir_stream(
+        clp::ReaderInterface& raw_reader,
+        KvIrBlockIndex const* block_index,
+        std::shared_ptr<search::ast::Expression> query,
+        KvIrSearchOptions const& options,
+        std::ostream& output
+) -> ystdlib::error_handling::Result<void>;
+
+/**
+ * Searches the given kv-pair IR stream with the given query, writing matches to stdout.
+ *
+ * If the stream is on the local filesystem and has a sidecar block index (see `KvIrBlockIndex`),
+ * only the blocks that may match the query's timestamp bounds and required string values are
+ * deserialized and searched.
  * @param stream_path The path to the kv-pair IR stream.
  * @param command_line_arguments
  * @param query
  * @param reducer_socket_fd
  * @return A void result on success, or an error code indicating the failure:
- * - KvIrSearchErrorEnum::ClpLegacyError if a `clp::TraceableException` is caught.
  * - KvIrSearchErrorEnum::AggregationSupportNotImplemented if an aggregation is requested.
  * - KvIrSearchErrorEnum::ProjectionSupportNotImplemented if projection is non-empty.
+ * - KvIrSearchErrorEnum::UnsupportedOutputHandlerType if the output handler isn't stdout.
  * - KvIrSearchErrorEnum::StreamReaderCreationFailure if the stream reader cannot be successfully
  *   created.
- * - Forwards `deserialize_and_search_kv_ir_stream`'s return values.
+ * - Forwards the return values of `search_kv_ir_stream` above.
  */
 [[nodiscard]] auto search_kv_ir_stream(
         Path const& stream_path,
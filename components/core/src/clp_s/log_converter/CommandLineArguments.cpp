@@ -148,6 +148,11 @@ auto CommandLineArguments::parse_arguments(int argc, char const** argv)
                 "no-compress-converted-files",
                 po::bool_switch(&no_compress_converted_files),
                 "Disable compression on the converted KV-IR files."
+        )(
+                "write-block-index",
+                po::bool_switch(&m_write_block_index),
+                "Write a sidecar block index next to each converted KV-IR file so that searches"
+                " can skip blocks that can't match."
         );
         // clang-format on
 
@@ -1,8 +1,10 @@
 #include "LogSerializer.hpp"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
@@ -24,6 +26,9 @@
 #include <clp/ir/types.hpp>
 #include <clp/streaming_compression/zstd/Compressor.hpp>
 
+#include "../KvIrBlockIndex.hpp"
+#include "../timestamp_parser/TimestampParser.hpp"
+
 namespace clp_s::log_converter {
 namespace {
 constexpr msgpack::object_map cEmptyMap{.size = 0U, .ptr = nullptr};
@@ -33,7 +38,8 @@ constexpr std::string_view cUncompressedFileExtension{".clp"};
 auto LogSerializer::create(
         std::string_view output_dir,
         std::string_view original_file_path,
-        bool compress_with_zstd
+        bool compress_with_zstd,
+        bool write_block_index
 ) -> ystdlib::error_handling::Result<LogSerializer> {
     nlohmann::json metadata;
     metadata.emplace(cOriginalFileMetadataKey, original_file_path);
@@ -60,18 +66,32 @@ auto LogSerializer::create(
         return std::errc::no_such_file_or_directory;
     }
 
-    if (false == compress_with_zstd) {
-        return LogSerializer{std::move(serializer), std::move(nested_writers)};
+    if (compress_with_zstd) {
+        try {
+            auto compressor{std::make_unique<clp::streaming_compression::zstd::Compressor>()};
+            compressor->open(*nested_writers.back().get());
+            nested_writers.emplace_back(std::move(compressor));
+        } catch (std::exception const&) {
+            return std::errc::protocol_error;
+        }
     }
 
-    try {
-        auto compressor{std::make_unique<clp::streaming_compression::zstd::Compressor>()};
-        compressor->open(*nested_writers.back().get());
-        nested_writers.emplace_back(std::move(compressor));
-    } catch (std::exception const&) {
-        return std::errc::protocol_error;
+    LogSerializer log_serializer{std::move(serializer), std::move(nested_writers)};
+    if (false == write_block_index) {
+        return log_serializer;
     }
-    return LogSerializer{std::move(serializer), std::move(nested_writers)};
+
+    auto const preamble{log_serializer.m_serializer.get_ir_buf_view()};
+    log_serializer.m_block_index_writer.emplace(
+            std::vector<int8_t>{preamble.begin(), preamble.end()},
+            compress_with_zstd
+    );
+    log_serializer.m_block_index_path
+            = converted_path.string() + std::string{cKvIrBlockIndexFileExtension};
+    log_serializer.m_timestamp_patterns
+            = YSTDLIB_ERROR_HANDLING_TRYX(timestamp_parser::get_all_default_timestamp_patterns());
+    YSTDLIB_ERROR_HANDLING_TRYV(log_serializer.start_block());
+    return log_serializer;
 }
 
 auto LogSerializer::add_message(std::string_view timestamp, std::string_view message)
@@ -87,7 +107,13 @@ auto LogSerializer::add_message(std::string_view timestamp, std::string_view mes
             .size = static_cast<uint32_t>(fields.size()),
             .ptr = fields.data()
     };
+    auto const num_ir_bytes_before{m_serializer.get_ir_buf_view().size()};
     YSTDLIB_ERROR_HANDLING_TRYV(m_serializer.serialize_msgpack_map(cEmptyMap, record));
+    YSTDLIB_ERROR_HANDLING_TRYV(index_log_event(
+            timestamp,
+            message,
+            m_serializer.get_ir_buf_view().size() - num_ir_bytes_before
+    ));
     if (m_serializer.get_ir_buf_view().size() > cMaxIrBufSize) {
         flush_buffer();
     }
@@ -100,10 +126,96 @@ auto LogSerializer::add_message(std::string_view message) -> ystdlib::error_hand
             .val = msgpack::object{message}
     };
     msgpack::object_map const record{.size = 1U, .ptr = &message_field};
+    auto const num_ir_bytes_before{m_serializer.get_ir_buf_view().size()};
     YSTDLIB_ERROR_HANDLING_TRYV(m_serializer.serialize_msgpack_map(cEmptyMap, record));
+    YSTDLIB_ERROR_HANDLING_TRYV(index_log_event(
+            std::nullopt,
+            message,
+            m_serializer.get_ir_buf_view().size() - num_ir_bytes_before
+    ));
     if (m_serializer.get_ir_buf_view().size() > cMaxIrBufSize) {
         flush_buffer();
     }
     return ystdlib::error_handling::success();
 }
+
+auto LogSerializer::close() -> ystdlib::error_handling::Result<void> {
+    flush_buffer();
+    m_nested_writers.back()->write_numeric_value(clp::ffi::ir_stream::cProtocol::Eof);
+    for (auto it{m_nested_writers.rbegin()}; it != m_nested_writers.rend(); ++it) {
+        if (auto compressor{dynamic_cast<clp::streaming_compression::Compressor*>(it->get())};
+            nullptr != compressor)
+        {
+            compressor->close();
+        } else if (auto file_writer{dynamic_cast<clp::FileWriter*>(it->get())};
+                   nullptr != file_writer)
+        {
+            file_writer->close();
+        }
+    }
+
+    if (false == m_block_index_writer.has_value()) {
+        return ystdlib::error_handling::success();
+    }
+    YSTDLIB_ERROR_HANDLING_TRYV(end_block());
+    try {
+        clp::FileWriter index_writer;
+        index_writer.open(m_block_index_path, clp::FileWriter::OpenMode::CREATE_FOR_WRITING);
+        m_block_index_writer->write(index_writer);
+        index_writer.close();
+    } catch (std::exception const&) {
+        return std::errc::io_error;
+    }
+    return ystdlib::error_handling::success();
+}
+
+auto LogSerializer::index_log_event(
+        std::optional<std::string_view> timestamp,
+        std::string_view message,
+        size_t num_ir_bytes
+) -> ystdlib::error_handling::Result<void> {
+    if (false == m_block_index_writer.has_value()) {
+        return ystdlib::error_handling::success();
+    }
+
+    std::optional<epochtime_t> epoch_timestamp;
+    if (timestamp.has_value()) {
+        auto const optional_parsed_timestamp{timestamp_parser::search_known_timestamp_patterns(
+                timestamp.value(),
+                m_timestamp_patterns,
+                false,
+                m_generated_timestamp_pattern
+        )};
+        if (optional_parsed_timestamp.has_value()) {
+            epoch_timestamp.emplace(
+                    optional_parsed_timestamp.value().first / cNanosecondsInMillisecond
+            );
+        }
+        m_block_index_writer->add_string_value(timestamp.value());
+    }
+    m_block_index_writer->add_log_event(epoch_timestamp);
+    m_block_index_writer->add_string_value(message);
+
+    m_num_ir_bytes_in_block += num_ir_bytes;
+    if (m_num_ir_bytes_in_block >= KvIrBlockIndexWriter::cDefaultTargetBlockSize) {
+        YSTDLIB_ERROR_HANDLING_TRYV(end_block());
+        YSTDLIB_ERROR_HANDLING_TRYV(start_block());
+    }
+    return ystdlib::error_handling::success();
+}
+
+auto LogSerializer::start_block() -> ystdlib::error_handling::Result<void> {
+    // Flushing the outermost writer ends the current zstd frame (if the output is compressed), so
+    // that the new block can be decompressed independently of the preceding bytes.
+    flush_buffer();
+    m_nested_writers.back()->flush();
+
+    std::vector<int8_t> sync_point;
+    YSTDLIB_ERROR_HANDLING_TRYV(m_serializer.serialize_sync_point(sync_point));
+    m_num_ir_bytes_in_block = 0;
+    return m_block_index_writer->start_block(
+            m_nested_writers.front()->get_pos(),
+            std::move(sync_point)
+    );
+}
 }  // namespace clp_s::log_converter
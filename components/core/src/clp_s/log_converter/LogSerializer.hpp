@@ -3,6 +3,8 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -17,6 +19,10 @@
 #include <clp/type_utils.hpp>
 #include <clp/WriterInterface.hpp>
 
+#include "../Defs.hpp"
+#include "../KvIrBlockIndex.hpp"
+#include "../timestamp_parser/TimestampParser.hpp"
+
 namespace clp_s::log_converter {
 /**
  * Utility class that generates KV-IR corresponding to a converted input file.
@@ -29,16 +35,21 @@ public:
      * @param output_dir The destination directory for generated KV-IR.
      * @param original_file_path The original path for the file being converted to KV-IR.
      * @param compress_with_zstd Whether the output KV-IR should be zstd-compressed.
+     * @param write_block_index Whether a sidecar block index (see `KvIrBlockIndex`) should be
+     * written next to the output KV-IR.
      * @return A result containing a `LogSerializer` on success, or an error code indicating the
      * failure:
      * - std::errc::no_such_file_or_directory if a `clp::FileWriter` fails to open an output file.
      * - std::errc::protocol_error if a `clp::zstd::Compressor` fails to open a compression stream.
      * - Forwards `clp::ffi::ir_stream::Serializer<>::create()`'s return values.
+     * - Forwards `timestamp_parser::get_all_default_timestamp_patterns()`'s return values.
+     * - Forwards `start_block()`'s return values.
      */
     [[nodiscard]] static auto create(
             std::string_view output_dir,
             std::string_view original_file_path,
-            bool compress_with_zstd
+            bool compress_with_zstd,
+            bool write_block_index = false
     ) -> ystdlib::error_handling::Result<LogSerializer>;
 
     // Constructors
@@ -64,6 +75,7 @@ public:
      * @param message
      * @return A void result on success, or an error code indicating the failure:
      * - Forwards `clp::ffi::ir_stream::Serializer<>::serialize_msgpack_map`'s return values.
+     * - Forwards `index_log_event()`'s return values.
      */
     [[nodiscard]] auto add_message(std::string_view timestamp, std::string_view message)
             -> ystdlib::error_handling::Result<void>;
@@ -73,28 +85,18 @@ public:
      * @param message
      * @return A void result on success, or an error code indicating the failure:
      * - Forwards `clp::ffi::ir_stream::Serializer<>::serialize_msgpack_map`'s return values.
+     * - Forwards `index_log_event()`'s return values.
      */
     [[nodiscard]] auto add_message(std::string_view message)
             -> ystdlib::error_handling::Result<void>;
 
     /**
-     * Closes and flushes the serialized output.
+     * Closes and flushes the serialized output, and writes the block index if enabled.
+     * @return A void result on success, or an error code indicating the failure:
+     * - std::errc::io_error if the block index can't be written.
+     * - Forwards `KvIrBlockIndexWriter::end_block()`'s return values.
      */
-    void close() {
-        flush_buffer();
-        m_nested_writers.back()->write_numeric_value(clp::ffi::ir_stream::cProtocol::Eof);
-        for (auto it{m_nested_writers.rbegin()}; it != m_nested_writers.rend(); ++it) {
-            if (auto compressor{dynamic_cast<clp::streaming_compression::Compressor*>(it->get())};
-                nullptr != compressor)
-            {
-                compressor->close();
-            } else if (auto file_writer{dynamic_cast<clp::FileWriter*>(it->get())};
-                       nullptr != file_writer)
-            {
-                file_writer->close();
-            }
-        }
-    }
+    [[nodiscard]] auto close() -> ystdlib::error_handling::Result<void>;
 
 private:
     // Constants
@@ -102,6 +104,7 @@ private:
     static constexpr std::string_view cTimestampKey{"timestamp"};
     static constexpr std::string_view cMessageKey{"message"};
     static constexpr size_t cMaxIrBufSize{64ULL * 1024ULL};  // 64 KiB
+    static constexpr epochtime_t cNanosecondsInMillisecond{1000 * 1000};
 
     // Constructors
     explicit LogSerializer(
@@ -112,6 +115,41 @@ private:
               m_nested_writers{std::move(nested_writers)} {}
 
     // Methods
+    /**
+     * Records a serialized log event in the block index (if enabled), sealing the current block
+     * and starting a new one once the block reaches its target size.
+     * @param timestamp
+     * @param message
+     * @param num_ir_bytes The number of IR bytes the log event was serialized into.
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `end_block()`'s return values.
+     * - Forwards `start_block()`'s return values.
+     */
+    [[nodiscard]] auto index_log_event(
+            std::optional<std::string_view> timestamp,
+            std::string_view message,
+            size_t num_ir_bytes
+    ) -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Makes the output readable from the current position onwards (by flushing the IR buffer and
+     * ending the current zstd frame, if any), and starts a new block in the block index at that
+     * position.
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `clp::ffi::ir_stream::Serializer<>::serialize_sync_point`'s return values.
+     * - Forwards `KvIrBlockIndexWriter::start_block`'s return values.
+     */
+    [[nodiscard]] auto start_block() -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Ends the current block in the block index.
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `KvIrBlockIndexWriter::end_block`'s return values.
+     */
+    [[nodiscard]] auto end_block() -> ystdlib::error_handling::Result<void> {
+        return m_block_index_writer->end_block();
+    }
+
     /**
      * Flushes the buffer from the serializer to the output file.
      */
@@ -130,6 +168,13 @@ private:
     // NOTE: This class depends on there being at least one writer in `m_nested_writers` at all
     // times.
     std::vector<std::unique_ptr<clp::WriterInterface>> m_nested_writers;
+
+    // Block index state
+    std::optional<KvIrBlockIndexWriter> m_block_index_writer;
+    std::string m_block_index_path;
+    size_t m_num_ir_bytes_in_block{0};
+    std::vector<timestamp_parser::TimestampPattern> m_timestamp_patterns;
+    std::string m_generated_timestamp_pattern;
 };
 }  // namespace clp_s::log_converter
 
@@ -53,7 +53,8 @@ auto convert_files(CommandLineArguments const& command_line_arguments) -> bool {
                         path,
                         nested_readers.back().get(),
                         command_line_arguments.get_output_dir(),
-                        command_line_arguments.get_compress_converted_files()
+                        command_line_arguments.get_compress_converted_files(),
+                        command_line_arguments.get_write_block_index()
                 )};
                 if (convert_result.has_error()) {
                     auto const& error{convert_result.error()};
@@ -84,7 +85,8 @@ auto convert_files(CommandLineArguments const& command_line_arguments) -> bool {
                             path,
                             reader.get(),
                             command_line_arguments.get_output_dir(),
-                            command_line_arguments.get_compress_converted_files()
+                            command_line_arguments.get_compress_converted_files(),
+                            command_line_arguments.get_write_block_index()
                     )};
                     if (convert_result.has_error()) {
                         auto const& error{convert_result.error()};
@@ -66,8 +66,8 @@ EvaluatedValue EvaluateTimestampIndex::run(std::shared_ptr<Expression> const& ex
             return EvaluatedValue::Unknown;
         }
 
-        for (auto range_it = m_timestamp_dict->tokenized_column_to_range_begin();
-             range_it != m_timestamp_dict->tokenized_column_to_range_end();
+        for (auto range_it = m_tokenized_column_to_range.begin();
+             range_it != m_tokenized_column_to_range.end();
              range_it++)
         {
             // Don't attempt to evaluate the timestamp index against columns with wildcard tokens.
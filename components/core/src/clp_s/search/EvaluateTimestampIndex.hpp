@@ -2,17 +2,35 @@
 #define CLP_S_SEARCH_EVALUATETIMESTAMPINDEX_HPP
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "../TimestampDictionaryReader.hpp"
+#include "../TimestampEntry.hpp"
 #include "../Utils.hpp"
 #include "ast/Expression.hpp"
 
 namespace clp_s::search {
 class EvaluateTimestampIndex {
 public:
+    // Types
+    using tokenized_column_to_range_t
+            = std::vector<std::pair<std::vector<std::string>, TimestampEntry*>>;
+
     // Constructors
     EvaluateTimestampIndex(std::shared_ptr<TimestampDictionaryReader> const& timestamp_dict)
-            : m_timestamp_dict(timestamp_dict) {}
+            : m_tokenized_column_to_range(
+                      timestamp_dict->tokenized_column_to_range_begin(),
+                      timestamp_dict->tokenized_column_to_range_end()
+              ) {}
+
+    /**
+     * @param tokenized_column_to_range The timestamp range of each column, e.g., within a single
+     * row group rather than the whole archive.
+     */
+    explicit EvaluateTimestampIndex(tokenized_column_to_range_t tokenized_column_to_range)
+            : m_tokenized_column_to_range(std::move(tokenized_column_to_range)) {}
 
     /**
      * Takes an expression and attempts to prove its output (true/false/unknown) based on
@@ -26,7 +44,7 @@ public:
     EvaluatedValue run(std::shared_ptr<ast::Expression> const& expr);
 
 private:
-    std::shared_ptr<TimestampDictionaryReader> m_timestamp_dict;
+    tokenized_column_to_range_t m_tokenized_column_to_range;
 };
 }  // namespace clp_s::search
 
@@ -1,12 +1,21 @@
 #include "Output.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include <spdlog/spdlog.h>
+#include <utils/profiling/HotPathProfiler.hpp>
 
 #include "../../clp/type_utils.hpp"
+#include "../ArrowRecordBatch.hpp"
+#include "../SchemaReader.hpp"
 #include "../SchemaTree.hpp"
+#include "../TimestampDictionaryReader.hpp"
+#include "../TimestampEntry.hpp"
 #include "../Utils.hpp"
 #include "ast/AndExpr.hpp"
 #include "ast/ColumnDescriptor.hpp"
@@ -32,6 +41,103 @@ using clp_s::search::ast::OrExpr;
 #define eval(op, a, b) (((op) == FilterOperation::EQ) ? ((a) == (b)) : ((a) != (b)))
 
 namespace clp_s::search {
+namespace {
+/**
+ * Rejects the records in row groups that can't match the query, and delegates the filtering of all
+ * other records to the wrapped filter.
+ */
+class RowGroupFilter : public FilterClass {
+public:
+    // Constructors
+    RowGroupFilter(
+            FilterClass& filter,
+            uint64_t row_group_size,
+            std::vector<bool> const& row_group_may_match
+    )
+            : m_filter{filter},
+              m_row_group_size{row_group_size},
+              m_row_group_may_match{row_group_may_match} {}
+
+    // Methods inherited from FilterClass
+    void init(SchemaReader* reader, std::vector<BaseColumnReader*> const& column_readers) override {
+        m_filter.init(reader, column_readers);
+    }
+
+    void init(
+            SchemaReader* reader,
+            std::unordered_map<int32_t, BaseColumnReader*> const& column_map
+    ) override {
+        m_filter.init(reader, column_map);
+    }
+
+    bool filter(uint64_t cur_message) override {
+        auto const row_group_idx{cur_message / m_row_group_size};
+        if (row_group_idx < m_row_group_may_match.size()
+            && false == m_row_group_may_match[row_group_idx])
+        {
+            return false;
+        }
+        return m_filter.filter(cur_message);
+    }
+
+private:
+    FilterClass& m_filter;
+    uint64_t m_row_group_size;
+    std::vector<bool> const& m_row_group_may_match;
+};
+
+/**
+ * Evaluates a query against the timestamp range of each row group in a sorted table.
+ * @param expr
+ * @param timestamp_dict
+ * @param timestamp_bounds The table's row group timestamp bounds, flattened as
+ * `[min_0, max_0, min_1, max_1, ...]`.
+ * @return Whether each row group may contain a record matching the query, or an empty vector if
+ * the row groups can't be evaluated.
+ */
+auto evaluate_row_groups(
+        std::shared_ptr<Expression> const& expr,
+        TimestampDictionaryReader& timestamp_dict,
+        std::vector<epochtime_t> const& timestamp_bounds
+) -> std::vector<bool>;
+
+auto evaluate_row_groups(
+        std::shared_ptr<Expression> const& expr,
+        TimestampDictionaryReader& timestamp_dict,
+        std::vector<epochtime_t> const& timestamp_bounds
+) -> std::vector<bool> {
+    // Row group bounds are recorded for the authoritative timestamp, which is always the first
+    // column in the timestamp dictionary.
+    auto const& authoritative_timestamp{
+            timestamp_dict.get_authoritative_timestamp_tokenized_column()
+    };
+    if (false == authoritative_timestamp.has_value()
+        || timestamp_dict.tokenized_column_to_range_begin()
+                   == timestamp_dict.tokenized_column_to_range_end()
+        || TimestampEntry::TimestampEncoding::Epoch
+                   != timestamp_dict.tokenized_column_to_range_begin()
+                              ->second->get_timestamp_encoding())
+    {
+        return {};
+    }
+    auto const& [tokens, _] = authoritative_timestamp.value();
+    auto const* authoritative_entry{timestamp_dict.tokenized_column_to_range_begin()->second};
+
+    std::vector<bool> row_group_may_match;
+    row_group_may_match.reserve(timestamp_bounds.size() / 2);
+    for (size_t i{0}; i + 1 < timestamp_bounds.size(); i += 2) {
+        TimestampEntry row_group_entry{authoritative_entry->get_key_name(), 0};
+        row_group_entry.ingest_timestamp(timestamp_bounds[i]);
+        row_group_entry.ingest_timestamp(timestamp_bounds[i + 1]);
+        EvaluateTimestampIndex row_group_index{
+                EvaluateTimestampIndex::tokenized_column_to_range_t{{tokens, &row_group_entry}}
+        };
+        row_group_may_match.push_back(EvaluatedValue::False != row_group_index.run(expr));
+    }
+    return row_group_may_match;
+}
+}  // namespace
+
 bool Output::filter() {
     std::vector<int32_t> matched_schemas;
     bool has_array = false;
@@ -96,36 +202,94 @@ bool Output::filter() {
     m_archive_reader->open_packed_streams();
 
     std::string message;
+    ArrowRecordBatchBuilder record_batch_builder;
     auto const archive_id = m_archive_reader->get_archive_id();
+    auto const& row_group_timestamp_index{m_archive_reader->get_row_group_timestamp_index()};
     bool scanned_any_ert{false};
     for (int32_t schema_id : matched_schemas) {
         if (EvaluatedValue::False == m_query_runner.schema_init(schema_id)) {
             continue;
         }
+
+        // Skip the table if none of its row groups can match based on their timestamp ranges.
+        std::vector<bool> row_group_may_match;
+        if (auto const bounds_it{row_group_timestamp_index.timestamp_bounds.find(schema_id)};
+            row_group_timestamp_index.timestamp_bounds.end() != bounds_it)
+        {
+            row_group_may_match = evaluate_row_groups(
+                    m_expr,
+                    *m_archive_reader->get_timestamp_dictionary(),
+                    bounds_it->second
+            );
+            if (false == row_group_may_match.empty()
+                && std::ranges::none_of(row_group_may_match, [](bool may_match) {
+                       return may_match;
+                   }))
+            {
+                continue;
+            }
+        }
         scanned_any_ert = true;
+        PROFILE_HOT_SCOPE("search.scan_schema_table");
 
         auto& reader = m_archive_reader->read_schema_table(
                 schema_id,
                 m_output_handler->should_output_metadata(),
                 m_should_marshal_records
         );
-        auto& filter = m_query_runner.prepare_filter(reader);
+        auto& query_filter = m_query_runner.prepare_filter(reader);
+        RowGroupFilter row_group_filter{
+                query_filter,
+                row_group_timestamp_index.row_group_size,
+                row_group_may_match
+        };
+        FilterClass& filter = row_group_may_match.empty()
+                                      ? query_filter
+                                      : static_cast<FilterClass&>(row_group_filter);
 
         bool schema_has_match{false};
-        if (m_output_handler->should_output_metadata()) {
+        if (m_output_handler->should_output_record_batches()) {
+            record_batch_builder.clear();
+            reader.initialize_record_batch_builder(record_batch_builder);
+            while (reader.get_next_record_batch_rows(
+                           record_batch_builder,
+                           ArrowRecordBatchBuilder::cDefaultTargetBatchSize,
+                           filter
+                   )
+                   > 0)
+            {
+                PROFILE_HOT_SCOPE("search.write_result");
+                schema_has_match = true;
+                m_result_metrics.num_archive_records_matching_query
+                        += record_batch_builder.get_num_rows();
+                m_output_handler->write_record_batch(record_batch_builder);
+                record_batch_builder.clear_rows();
+            }
+        } else if (m_output_handler->should_output_metadata()) {
             epochtime_t timestamp{};
             int64_t log_event_idx{};
             while (reader.get_next_message_with_metadata(message, timestamp, log_event_idx, filter))
             {
+                PROFILE_HOT_SCOPE("search.write_result");
                 schema_has_match = true;
                 ++m_result_metrics.num_archive_records_matching_query;
                 m_output_handler->write(message, timestamp, archive_id, log_event_idx);
             }
         } else {
-            while (reader.get_next_message(message, filter)) {
+            while (true) {
+                message.clear();
+                auto const num_messages{reader.get_next_messages(
+                        message,
+                        SchemaReader::cDefaultTargetBatchSize,
+                        filter
+                )};
+                if (0 == num_messages) {
+                    break;
+                }
+                PROFILE_HOT_SCOPE("search.write_result");
                 schema_has_match = true;
-                ++m_result_metrics.num_archive_records_matching_query;
-                m_output_handler->write(message);
+                m_result_metrics.num_archive_records_matching_query += num_messages;
+                m_output_handler->write_batch(message, num_messages);
             }
         }
         if (schema_has_match) {
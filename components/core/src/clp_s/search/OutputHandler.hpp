@@ -1,9 +1,12 @@
 #ifndef CLP_S_SEARCH_OUTPUTHANDLER_HPP
 #define CLP_S_SEARCH_OUTPUTHANDLER_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <string_view>
 #include <vector>
 
+#include "../ArrowRecordBatch.hpp"
 #include "../Defs.hpp"
 #include "../ErrorCode.hpp"
 
@@ -42,6 +45,35 @@ public:
      */
     virtual void write(std::string_view message) = 0;
 
+    /**
+     * Writes a batch of messages to the output handler. By default, each message is written with
+     * `write(std::string_view)`.
+     * @param messages The messages, each terminated by a newline, or an empty string if records
+     * aren't being marshalled.
+     * @param num_messages
+     */
+    virtual void write_batch(std::string_view messages, size_t num_messages) {
+        if (messages.empty()) {
+            for (size_t i{0}; i < num_messages; ++i) {
+                write(messages);
+            }
+            return;
+        }
+        while (false == messages.empty()) {
+            auto const message_length{messages.find('\n') + 1};
+            write(messages.substr(0, message_length));
+            messages.remove_prefix(std::min(message_length, messages.size()));
+        }
+    }
+
+    /**
+     * Writes a batch of matched records from the current table. Only called for handlers that
+     * output record batches, in which case the batches written between calls to `flush` all have
+     * the same schema.
+     * @param record_batch
+     */
+    virtual void write_record_batch(ArrowRecordBatchBuilder const& record_batch) {}
+
     /**
      * Flushes the output handler after each table that gets searched.
      * @return ErrorCodeSuccess on success or relevant error code on error
@@ -58,6 +90,12 @@ public:
 
     [[nodiscard]] auto should_marshal_records() const -> bool { return m_should_marshal_records; }
 
+    /**
+     * @return Whether matched records should be written with `write_record_batch` rather than as
+     * marshalled messages.
+     */
+    [[nodiscard]] virtual auto should_output_record_batches() const -> bool { return false; }
+
 private:
     bool m_should_output_metadata{};
     bool m_should_marshal_records{};
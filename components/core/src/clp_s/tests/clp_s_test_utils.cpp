@@ -1,8 +1,11 @@
 #include "clp_s_test_utils.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -11,6 +14,7 @@
 #include "../src/clp_s/InputConfig.hpp"
 #include "../src/clp_s/JsonParser.hpp"
 #include "../src/clp_s/TimestampPattern.hpp"
+#include "../src/clp_s/ZstdDictionaryRegistry.hpp"
 
 auto compress_archive(
         std::string const& file_path,
@@ -18,7 +22,10 @@ auto compress_archive(
         std::optional<std::string> timestamp_key,
         bool retain_float_format,
         bool single_file_archive,
-        bool structurize_arrays
+        bool structurize_arrays,
+        std::shared_ptr<clp_s::ZstdDictionaryRegistry> zstd_dictionaries,
+        uint64_t archive_flush_interval_ms,
+        std::optional<std::string> sort_key
 ) -> std::vector<clp_s::ArchiveStats> {
     constexpr auto cDefaultTargetEncodedSize{8ULL * 1024 * 1024 * 1024};  // 8 GiB
     constexpr auto cDefaultMaxDocumentSize{512ULL * 1024 * 1024};  // 512 MiB
@@ -43,9 +50,15 @@ auto compress_archive(
     parser_option.retain_float_format = retain_float_format;
     parser_option.structurize_arrays = structurize_arrays;
     parser_option.single_file_archive = single_file_archive;
+    parser_option.zstd_dictionaries = std::move(zstd_dictionaries);
+    parser_option.archive_flush_interval_ms = archive_flush_interval_ms;
     if (timestamp_key.has_value()) {
         parser_option.timestamp_key = std::move(timestamp_key.value());
     }
+    if (sort_key.has_value()) {
+        parser_option.sort_key = std::move(sort_key.value());
+        parser_option.record_log_order = false;
+    }
 
     clp_s::JsonParser parser{parser_option};
     std::vector<clp_s::ArchiveStats> archive_stats;
@@ -1,12 +1,15 @@
 #ifndef CLP_S_TEST_UTILS_HPP
 #define CLP_S_TEST_UTILS_HPP
 
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include "../src/clp_s/ArchiveWriter.hpp"
 #include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/ZstdDictionaryRegistry.hpp"
 
 /**
  * Compresses a file into an archive directory according to a given set of configuration options.
@@ -19,6 +22,10 @@
  * @param retain_float_format
  * @param single_file_archive
  * @param structurize_arrays
+ * @param zstd_dictionaries Trained zstd dictionaries to compress the archive with, if any
+ * @param archive_flush_interval_ms The maximum time an archive is kept open, or 0 for no limit
+ * @param sort_key The key to sort the records in each table by, if any. Log order isn't recorded
+ * when records are sorted.
  * @return Statistics for every compressed archive.
  */
 [[nodiscard]] auto compress_archive(
@@ -27,6 +34,9 @@
         std::optional<std::string> timestamp_key,
         bool retain_float_format,
         bool single_file_archive,
-        bool structurize_arrays
+        bool structurize_arrays,
+        std::shared_ptr<clp_s::ZstdDictionaryRegistry> zstd_dictionaries = nullptr,
+        uint64_t archive_flush_interval_ms = 0,
+        std::optional<std::string> sort_key = std::nullopt
 ) -> std::vector<clp_s::ArchiveStats>;
 #endif  // CLP_S_TEST_UTILS_HPP
@@ -0,0 +1,124 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/JsonConstructor.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestFlushIntervalInputFile{"test-archive-flush-interval.jsonl"};
+constexpr std::string_view cTestFlushIntervalArchiveDirectory{
+        "test-archive-flush-interval-archive"
+};
+constexpr std::string_view cTestFlushIntervalOutputDirectory{"test-archive-flush-interval-out"};
+// Enough records that ingesting them takes well over `cShortFlushIntervalMs`
+constexpr size_t cNumRecords{50'000};
+constexpr uint64_t cShortFlushIntervalMs{1};
+// Far longer than ingesting the records takes
+constexpr uint64_t cLongFlushIntervalMs{24ULL * 60 * 60 * 1000};
+
+namespace {
+/**
+ * Writes `cNumRecords` JSON records to `cTestFlushIntervalInputFile`.
+ */
+auto write_input_file() -> void;
+
+/**
+ * Decompresses every archive in `cTestFlushIntervalArchiveDirectory`.
+ * @return The total number of records decompressed.
+ */
+auto extract_and_count_records() -> size_t;
+
+auto write_input_file() -> void {
+    std::ofstream input_file{std::string{cTestFlushIntervalInputFile}};
+    for (size_t i{0}; i < cNumRecords; ++i) {
+        input_file << fmt::format(
+                R"({{"timestamp":{},"level":"INFO","message":"Request {} completed in {} ms"}})"
+                "\n",
+                1'700'000'000'000 + i,
+                i,
+                i % 1000
+        );
+    }
+}
+
+auto extract_and_count_records() -> size_t {
+    std::filesystem::create_directory(cTestFlushIntervalOutputDirectory);
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = cTestFlushIntervalOutputDirectory;
+    for (auto const& entry :
+         std::filesystem::directory_iterator(cTestFlushIntervalArchiveDirectory))
+    {
+        constructor_option.archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        clp_s::JsonConstructor constructor{constructor_option};
+        REQUIRE_NOTHROW(constructor.store());
+    }
+
+    size_t num_records{0};
+    for (auto const& entry :
+         std::filesystem::recursive_directory_iterator(cTestFlushIntervalOutputDirectory))
+    {
+        if (false == entry.is_regular_file()) {
+            continue;
+        }
+        std::ifstream extracted_file{entry.path()};
+        std::string line;
+        while (std::getline(extracted_file, line)) {
+            ++num_records;
+        }
+    }
+    return num_records;
+}
+}  // namespace
+
+TEST_CASE("clp-s-archive-flush-interval", "[clp-s][archive-flush-interval]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestFlushIntervalInputFile},
+             std::string{cTestFlushIntervalArchiveDirectory},
+             std::string{cTestFlushIntervalOutputDirectory}}
+    };
+    write_input_file();
+
+    auto compress = [](uint64_t archive_flush_interval_ms) {
+        return compress_archive(
+                std::string{cTestFlushIntervalInputFile},
+                std::string{cTestFlushIntervalArchiveDirectory},
+                std::nullopt,
+                false,
+                false,
+                false,
+                nullptr,
+                archive_flush_interval_ms
+        );
+    };
+
+    SECTION("No flush interval") {
+        REQUIRE((1 == compress(0).size()));
+        REQUIRE((cNumRecords == extract_and_count_records()));
+    }
+
+    SECTION("Flush interval longer than ingestion") {
+        REQUIRE((1 == compress(cLongFlushIntervalMs).size()));
+        REQUIRE((cNumRecords == extract_and_count_records()));
+    }
+
+    SECTION("Flush interval shorter than ingestion") {
+        auto const num_archives{compress(cShortFlushIntervalMs).size()};
+        REQUIRE((1 < num_archives));
+        // The interval is only checked after each record, so no more than one archive can be
+        // closed per record (plus the archive that's open when ingestion ends).
+        REQUIRE((num_archives <= cNumRecords + 1));
+        REQUIRE((cNumRecords == extract_and_count_records()));
+    }
+}
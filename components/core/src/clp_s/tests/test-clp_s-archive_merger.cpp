@@ -0,0 +1,165 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../src/clp_s/ArchiveMerger.hpp"
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/ArchiveWriter.hpp"
+#include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/JsonConstructor.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestArchiveMergerInputDirectory{"test-archive-merger-input"};
+constexpr std::string_view cTestArchiveMergerArchiveDirectory{"test-archive-merger-archive"};
+constexpr std::string_view cTestArchiveMergerOutputDirectory{"test-archive-merger-out"};
+constexpr std::string_view cTestArchiveMergerInputFileDirectory{"test_log_files"};
+constexpr std::string_view cTestArchiveMergerNoFloatsInputFile{"test_no_floats_sorted.jsonl"};
+constexpr std::string_view cTestArchiveMergerTimestampInputFile{"test_timestamp.jsonl"};
+constexpr std::string_view cTestArchiveMergerTimestampKey{"timestamp"};
+constexpr size_t cNumRecordsInNoFloatsInputFile{4};
+constexpr size_t cNumRecordsInTimestampInputFile{5};
+
+namespace {
+auto get_test_input_local_path(std::string_view test_input_file) -> std::string;
+
+auto get_archive_path(std::string_view archive_dir, std::string const& archive_id) -> clp_s::Path;
+
+/**
+ * Decompresses an archive in log order.
+ * @param archive_path
+ * @return The archive's log events in log order.
+ */
+auto extract_in_log_order(clp_s::Path const& archive_path) -> std::vector<nlohmann::json>;
+
+auto get_test_input_local_path(std::string_view test_input_file) -> std::string {
+    std::filesystem::path const current_file_path{__FILE__};
+    auto const tests_dir{current_file_path.parent_path()};
+    return (tests_dir / cTestArchiveMergerInputFileDirectory / test_input_file).string();
+}
+
+auto get_archive_path(std::string_view archive_dir, std::string const& archive_id) -> clp_s::Path {
+    return clp_s::Path{
+            .source{clp_s::InputSource::Filesystem},
+            .path{(std::filesystem::path{archive_dir} / archive_id).string()}
+    };
+}
+
+auto extract_in_log_order(clp_s::Path const& archive_path) -> std::vector<nlohmann::json> {
+    std::filesystem::remove_all(cTestArchiveMergerOutputDirectory);
+
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.archive_path = archive_path;
+    constructor_option.output_dir = cTestArchiveMergerOutputDirectory;
+    constructor_option.ordered = true;
+    clp_s::JsonConstructor constructor{constructor_option};
+    REQUIRE_NOTHROW(constructor.store());
+
+    std::vector<nlohmann::json> log_events;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestArchiveMergerOutputDirectory))
+    {
+        std::ifstream extracted_file{entry.path()};
+        std::string line;
+        while (std::getline(extracted_file, line)) {
+            log_events.emplace_back(nlohmann::json::parse(line));
+        }
+    }
+    return log_events;
+}
+}  // namespace
+
+TEST_CASE("clp-s-archive-merger", "[clp-s][archive-merger]") {
+    auto const structurize_arrays = GENERATE(true, false);
+    auto const single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestArchiveMergerInputDirectory},
+             std::string{cTestArchiveMergerArchiveDirectory},
+             std::string{cTestArchiveMergerOutputDirectory}}
+    };
+
+    std::vector<clp_s::ArchiveStats> input_stats;
+    std::vector<clp_s::Path> input_paths;
+    std::vector<nlohmann::json> expected_log_events;
+    auto const compress_input = [&](std::string_view test_input_file,
+                                    std::optional<std::string> timestamp_key) {
+        auto archive_stats{compress_archive(
+                get_test_input_local_path(test_input_file),
+                std::string{cTestArchiveMergerInputDirectory},
+                std::move(timestamp_key),
+                true,
+                single_file_archive,
+                structurize_arrays
+        )};
+        REQUIRE((1ULL == archive_stats.size()));
+        auto const& stats{input_stats.emplace_back(std::move(archive_stats.front()))};
+        auto const& archive_path{
+                input_paths.emplace_back(
+                        get_archive_path(cTestArchiveMergerInputDirectory, stats.get_id())
+                )
+        };
+        for (auto& log_event : extract_in_log_order(archive_path)) {
+            expected_log_events.emplace_back(std::move(log_event));
+        }
+    };
+    compress_input(cTestArchiveMergerNoFloatsInputFile, std::nullopt);
+    compress_input(
+            cTestArchiveMergerTimestampInputFile,
+            std::string{cTestArchiveMergerTimestampKey}
+    );
+    REQUIRE(
+            (cNumRecordsInNoFloatsInputFile + cNumRecordsInTimestampInputFile
+             == expected_log_events.size())
+    );
+
+    clp_s::ArchiveMergerOption option{};
+    option.archive_paths = input_paths;
+    option.archives_dir = cTestArchiveMergerArchiveDirectory;
+    option.target_encoded_size = 8ULL * 1024 * 1024 * 1024;
+    option.min_table_size = 1ULL * 1024 * 1024;
+    option.compression_level = 3;
+    option.single_file_archive = single_file_archive;
+    std::filesystem::create_directory(cTestArchiveMergerArchiveDirectory);
+
+    std::vector<clp_s::ArchiveStats> merged_stats;
+    clp_s::ArchiveMerger merger{option};
+    REQUIRE_NOTHROW(merged_stats = merger.merge());
+    REQUIRE((1ULL == merged_stats.size()));
+    auto const& stats{merged_stats.front()};
+    REQUIRE((input_stats.back().get_begin_timestamp() == stats.get_begin_timestamp()));
+    REQUIRE((input_stats.back().get_end_timestamp() == stats.get_end_timestamp()));
+
+    auto const merged_archive_path{
+            get_archive_path(cTestArchiveMergerArchiveDirectory, stats.get_id())
+    };
+    REQUIRE((expected_log_events == extract_in_log_order(merged_archive_path)));
+
+    // Each input's range index entry is carried over at its offset in the merged log order.
+    clp_s::ArchiveReader archive_reader;
+    REQUIRE_NOTHROW(archive_reader.open(merged_archive_path, clp_s::NetworkAuthOption{}));
+    auto const& range_index{archive_reader.get_range_index()};
+    REQUIRE((2ULL == range_index.size()));
+    REQUIRE((0ULL == range_index.at(0).start_index));
+    REQUIRE((cNumRecordsInNoFloatsInputFile == range_index.at(0).end_index));
+    REQUIRE((cNumRecordsInNoFloatsInputFile == range_index.at(1).start_index));
+    REQUIRE(
+            (cNumRecordsInNoFloatsInputFile + cNumRecordsInTimestampInputFile
+             == range_index.at(1).end_index)
+    );
+    for (size_t i{0}; i < input_paths.size(); ++i) {
+        clp_s::ArchiveReader input_reader;
+        REQUIRE_NOTHROW(input_reader.open(input_paths[i], clp_s::NetworkAuthOption{}));
+        REQUIRE((input_reader.get_range_index().front().fields == range_index.at(i).fields));
+        REQUIRE_NOTHROW(input_reader.close());
+    }
+    REQUIRE_NOTHROW(archive_reader.close());
+}
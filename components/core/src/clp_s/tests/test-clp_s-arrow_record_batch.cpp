@@ -0,0 +1,240 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/clp_s/ArrowRecordBatch.hpp"
+#include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/JsonConstructor.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestArrowArchiveDirectory{"test-arrow-archive"};
+constexpr std::string_view cTestArrowOutputDirectory{"test-arrow-out"};
+constexpr std::string_view cTestArrowInputFileDirectory{"test_log_files"};
+constexpr std::string_view cTestArrowInputFile{"test_no_floats_sorted.jsonl"};
+constexpr int64_t cNumRecordsInInputFile{4};
+
+// Arrow IPC message header types
+constexpr uint8_t cEndOfStream{0};
+constexpr uint8_t cSchema{1};
+constexpr uint8_t cRecordBatch{3};
+
+namespace {
+/**
+ * The parts of an encapsulated Arrow IPC message that the tests check.
+ */
+struct IpcMessage {
+    uint8_t header_type{cEndOfStream};
+    int64_t body_length{0};
+    int64_t num_rows{0};
+};
+
+auto get_test_input_local_path() -> std::string;
+
+template <typename T>
+auto read_value(std::string_view buffer, size_t pos) -> T;
+
+/**
+ * @param buffer A buffer containing a flatbuffers table.
+ * @param table The position of the table in `buffer`.
+ * @param field_id
+ * @return The position of the field in `buffer`, or std::nullopt if the field isn't set.
+ */
+auto find_field(std::string_view buffer, size_t table, uint16_t field_id) -> std::optional<size_t>;
+
+/**
+ * Parses the encapsulated messages in an Arrow IPC stream, including end-of-stream markers.
+ *
+ * This helper uses `REQUIRE...` statements to assert that the messages are aligned as required by
+ * the Arrow IPC format.
+ *
+ * @param stream
+ * @return The parsed messages.
+ */
+auto parse_ipc_messages(std::string_view stream) -> std::vector<IpcMessage>;
+
+auto get_test_input_local_path() -> std::string {
+    std::filesystem::path const current_file_path{__FILE__};
+    auto const tests_dir{current_file_path.parent_path()};
+    return (tests_dir / cTestArrowInputFileDirectory / cTestArrowInputFile).string();
+}
+
+template <typename T>
+auto read_value(std::string_view buffer, size_t pos) -> T {
+    REQUIRE(pos + sizeof(T) <= buffer.size());
+    T value{};
+    std::memcpy(&value, buffer.data() + pos, sizeof(T));
+    return value;
+}
+
+auto find_field(std::string_view buffer, size_t table, uint16_t field_id) -> std::optional<size_t> {
+    auto const vtable{table - read_value<int32_t>(buffer, table)};
+    auto const vtable_size{read_value<uint16_t>(buffer, vtable)};
+    size_t const entry_pos{sizeof(uint16_t) * (2 + field_id)};
+    if (entry_pos >= vtable_size) {
+        return std::nullopt;
+    }
+    auto const field_offset{read_value<uint16_t>(buffer, vtable + entry_pos)};
+    if (0 == field_offset) {
+        return std::nullopt;
+    }
+    return table + field_offset;
+}
+
+auto parse_ipc_messages(std::string_view stream) -> std::vector<IpcMessage> {
+    constexpr size_t cAlignment{8};
+    constexpr uint32_t cContinuationMarker{0xFFFF'FFFF};
+
+    std::vector<IpcMessage> messages;
+    size_t pos{0};
+    while (pos < stream.size()) {
+        REQUIRE((0 == pos % cAlignment));
+        REQUIRE((cContinuationMarker == read_value<uint32_t>(stream, pos)));
+        auto const metadata_length{static_cast<size_t>(read_value<int32_t>(stream, pos + 4))};
+        pos += 8;
+        auto& message{messages.emplace_back()};
+        if (0 == metadata_length) {
+            continue;
+        }
+
+        auto const metadata{stream.substr(pos, metadata_length)};
+        auto const root{static_cast<size_t>(read_value<uint32_t>(metadata, 0))};
+        auto const header_type_pos{find_field(metadata, root, 1)};
+        auto const header_pos{find_field(metadata, root, 2)};
+        auto const body_length_pos{find_field(metadata, root, 3)};
+        REQUIRE(header_type_pos.has_value());
+        REQUIRE(header_pos.has_value());
+        message.header_type = read_value<uint8_t>(metadata, header_type_pos.value());
+        if (body_length_pos.has_value()) {
+            message.body_length = read_value<int64_t>(metadata, body_length_pos.value());
+        }
+        if (cRecordBatch == message.header_type) {
+            auto const header{
+                    header_pos.value() + read_value<uint32_t>(metadata, header_pos.value())
+            };
+            auto const length_pos{find_field(metadata, header, 0)};
+            REQUIRE(length_pos.has_value());
+            message.num_rows = read_value<int64_t>(metadata, length_pos.value());
+        }
+
+        REQUIRE((0 == message.body_length % cAlignment));
+        pos += metadata_length + static_cast<size_t>(message.body_length);
+    }
+    REQUIRE((stream.size() == pos));
+    return messages;
+}
+}  // namespace
+
+TEST_CASE("clp-s-arrow-record-batch", "[clp-s][arrow]") {
+    clp_s::ArrowRecordBatchBuilder builder;
+    auto const int_column{builder.add_column("int", clp_s::ArrowType::Int64, -1)};
+    auto const object_column{builder.add_column("object", clp_s::ArrowType::Struct, -1)};
+    auto const string_column{builder.add_column("string", clp_s::ArrowType::Utf8, object_column)};
+    std::ignore = builder.add_column("null", clp_s::ArrowType::Null, object_column);
+    auto const bool_column{builder.add_column("bool", clp_s::ArrowType::Bool, -1)};
+    auto const timestamp_column{builder.add_column("ts", clp_s::ArrowType::Timestamp, -1)};
+    REQUIRE_THROWS(builder.add_column("invalid", clp_s::ArrowType::Int64, int_column));
+
+    std::string stream;
+    builder.serialize_schema(stream);
+    constexpr int64_t cNumRows{3};
+    for (int64_t i{0}; i < cNumRows; ++i) {
+        builder.append_int64(int_column, i);
+        builder.append_utf8(string_column, std::string(static_cast<size_t>(i + 1), 'a'));
+        builder.append_bool(bool_column, 0 == i % 2);
+        builder.append_int64(timestamp_column, i * 1'000'000);
+        builder.finish_row();
+    }
+    REQUIRE((cNumRows == builder.get_num_rows()));
+    REQUIRE_THROWS(builder.add_column("late", clp_s::ArrowType::Int64, -1));
+    builder.serialize_record_batch(stream);
+
+    builder.clear_rows();
+    REQUIRE((0 == builder.get_num_rows()));
+    REQUIRE((0 == builder.get_buffered_size()));
+    builder.serialize_record_batch(stream);
+    clp_s::ArrowRecordBatchBuilder::serialize_end_of_stream(stream);
+
+    auto const messages{parse_ipc_messages(stream)};
+    REQUIRE((4 == messages.size()));
+    REQUIRE((cSchema == messages[0].header_type));
+    REQUIRE((0 == messages[0].body_length));
+    REQUIRE((cRecordBatch == messages[1].header_type));
+    REQUIRE((cNumRows == messages[1].num_rows));
+    // Each buffer is padded to 8 bytes: ints (24), string offsets (16), string data (6 -> 8), bools
+    // (1 -> 8), and timestamps (24)
+    REQUIRE((80 == messages[1].body_length));
+    REQUIRE((cRecordBatch == messages[2].header_type));
+    REQUIRE((0 == messages[2].num_rows));
+    REQUIRE((cEndOfStream == messages[3].header_type));
+}
+
+TEST_CASE("clp-s-arrow-decompression", "[clp-s][arrow]") {
+    auto const single_file_archive{GENERATE(true, false)};
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestArrowArchiveDirectory}, std::string{cTestArrowOutputDirectory}}
+    };
+
+    std::ignore = compress_archive(
+            get_test_input_local_path(),
+            std::string{cTestArrowArchiveDirectory},
+            std::nullopt,
+            false,
+            single_file_archive,
+            false
+    );
+
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = cTestArrowOutputDirectory;
+    constructor_option.arrow = true;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestArrowArchiveDirectory)) {
+        constructor_option.archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        clp_s::JsonConstructor constructor{constructor_option};
+        REQUIRE_NOTHROW(constructor.store());
+    }
+
+    std::ifstream output_file{
+            std::filesystem::path{cTestArrowOutputDirectory} / "original.arrows",
+            std::ios::binary
+    };
+    std::string const stream{
+            std::istreambuf_iterator<char>{output_file},
+            std::istreambuf_iterator<char>{}
+    };
+    auto const messages{parse_ipc_messages(stream)};
+
+    // Every table is written as a separate stream that begins with a schema and ends with an
+    // end-of-stream marker.
+    int64_t num_rows{0};
+    bool is_stream_open{false};
+    for (auto const& message : messages) {
+        if (cSchema == message.header_type) {
+            REQUIRE_FALSE(is_stream_open);
+            is_stream_open = true;
+        } else if (cRecordBatch == message.header_type) {
+            REQUIRE(is_stream_open);
+            num_rows += message.num_rows;
+        } else {
+            REQUIRE((cEndOfStream == message.header_type));
+            REQUIRE(is_stream_open);
+            is_stream_open = false;
+        }
+    }
+    REQUIRE_FALSE(is_stream_open);
+    REQUIRE((cNumRecordsInInputFile == num_rows));
+}
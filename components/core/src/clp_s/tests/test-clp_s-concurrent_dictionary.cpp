@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp_s/ConcurrentVariableDictionaryWriter.hpp"
+#include "../src/clp_s/DictionaryEntry.hpp"
+#include "../src/clp_s/FileReader.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestConcurrentDictionaryFile{"test-concurrent-dictionary.dict"};
+constexpr size_t cNumThreads{8};
+constexpr size_t cNumValues{4096};
+
+TEST_CASE("clp-s-concurrent-dictionary", "[clp-s][concurrent-dictionary]") {
+    TestOutputCleaner const test_cleanup{{std::string{cTestConcurrentDictionaryFile}}};
+
+    std::vector<std::string> values;
+    values.reserve(cNumValues);
+    for (size_t i{0}; i < cNumValues; ++i) {
+        values.emplace_back(fmt::format("var_{}", i));
+    }
+
+    clp_s::ConcurrentVariableDictionaryWriter writer;
+    writer.open(std::string{cTestConcurrentDictionaryFile}, 3, UINT64_MAX);
+
+    // Every thread adds every value, each in a different order, so that threads race to add the
+    // same values.
+    std::vector<std::vector<clp::variable_dictionary_id_t>> ids_per_thread(
+            cNumThreads,
+            std::vector<clp::variable_dictionary_id_t>(cNumValues)
+    );
+    std::vector<size_t> num_new_entries_per_thread(cNumThreads, 0);
+    std::vector<std::thread> threads;
+    threads.reserve(cNumThreads);
+    for (size_t thread_idx{0}; thread_idx < cNumThreads; ++thread_idx) {
+        threads.emplace_back([&, thread_idx]() {
+            std::vector<size_t> order(cNumValues);
+            for (size_t i{0}; i < cNumValues; ++i) {
+                order[i] = i;
+            }
+            std::mt19937 generator{static_cast<std::mt19937::result_type>(thread_idx)};
+            std::shuffle(order.begin(), order.end(), generator);
+            for (auto const value_idx : order) {
+                if (writer.add_entry(values[value_idx], ids_per_thread[thread_idx][value_idx])) {
+                    ++num_new_entries_per_thread[thread_idx];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Each value was inserted exactly once and every thread saw the same dense IDs.
+    size_t num_new_entries{0};
+    for (auto const num_new_entries_in_thread : num_new_entries_per_thread) {
+        num_new_entries += num_new_entries_in_thread;
+    }
+    REQUIRE((cNumValues == num_new_entries));
+    REQUIRE((cNumValues == writer.get_num_entries()));
+    auto const& ids{ids_per_thread.front()};
+    for (auto const& thread_ids : ids_per_thread) {
+        REQUIRE((ids == thread_ids));
+    }
+    auto sorted_ids{ids};
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    for (size_t i{0}; i < cNumValues; ++i) {
+        REQUIRE((i == sorted_ids[i]));
+    }
+
+    REQUIRE((0 < writer.close()));
+
+    // The dictionary stores entries in ID order.
+    clp_s::FileReader file_reader;
+    file_reader.open(std::string{cTestConcurrentDictionaryFile});
+    uint64_t num_entries{};
+    REQUIRE(file_reader.read_numeric_value(num_entries, false));
+    REQUIRE((cNumValues == num_entries));
+    clp_s::ZstdDecompressor decompressor;
+    decompressor.open(file_reader, 64 * 1024);
+    std::vector<std::string> values_by_id(cNumValues);
+    for (size_t i{0}; i < cNumValues; ++i) {
+        values_by_id[ids[i]] = values[i];
+    }
+    for (uint64_t id{0}; id < num_entries; ++id) {
+        clp_s::VariableDictionaryEntry entry;
+        entry.read_from_file(decompressor, id, false);
+        REQUIRE((values_by_id[id] == entry.get_value()));
+    }
+    decompressor.close();
+    file_reader.close();
+}
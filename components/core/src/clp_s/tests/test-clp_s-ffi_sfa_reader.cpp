@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -5,6 +7,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -13,12 +16,17 @@
 
 #include "../src/clp/ReadOnlyMemoryMappedFile.hpp"
 #include "../src/clp_s/ffi/sfa/ClpArchiveReader.hpp"
+#include "../src/clp_s/ffi/sfa/SfaErrorCode.hpp"
 #include "clp_s_test_utils.hpp"
 #include "TestOutputCleaner.hpp"
 
 namespace {
 using clp::ReadOnlyMemoryMappedFile;
 using clp_s::ffi::sfa::ClpArchiveReader;
+using clp_s::ffi::sfa::DecodeOptions;
+using clp_s::ffi::sfa::EventBatch;
+using clp_s::ffi::sfa::SfaErrorCode;
+using clp_s::ffi::sfa::SfaErrorCodeEnum;
 using ystdlib::error_handling::Result;
 using ystdlib::error_handling::success;
 
@@ -107,6 +115,42 @@ auto create_reader_from_bytes(std::filesystem::path const& archive_path)
     return ClpArchiveReader::create(std::vector<char>{view.begin(), view.end()});
 }
 
+/**
+ * Decodes every event selected by `options` through a single reused batch.
+ *
+ * This helper uses `REQUIRE...` statements to assert that decoding was successful.
+ *
+ * @param reader
+ * @param options
+ * @param batch_size
+ * @return The log event index and JSON of every decoded event, in decoding order.
+ */
+auto decode_all_events(ClpArchiveReader& reader, DecodeOptions const& options, size_t batch_size)
+        -> std::vector<std::pair<int64_t, std::string>> {
+    REQUIRE(false == reader.start_decoding(options).has_error());
+
+    std::vector<std::pair<int64_t, std::string>> events;
+    EventBatch batch;
+    while (true) {
+        auto const result{reader.decode_next_batch(batch_size, batch)};
+        REQUIRE(false == result.has_error());
+        auto const num_events{result.value()};
+        REQUIRE(num_events == batch.get_num_events());
+        REQUIRE(num_events <= batch_size);
+        if (0 == num_events) {
+            break;
+        }
+        REQUIRE(batch.get_buffer().size() == batch.get_end_offsets().back());
+        for (size_t i{0}; i < num_events; ++i) {
+            auto const event{batch.get_event(i)};
+            REQUIRE(event.starts_with('{'));
+            REQUIRE(event.ends_with('}'));
+            events.emplace_back(batch.get_log_event_idx(i), std::string{event});
+        }
+    }
+    return events;
+}
+
 auto run_single_log_file_test(
         std::filesystem::path const& archive_path,
         std::string const& expected_file_name,
@@ -139,3 +183,63 @@ TEST_CASE("clp_s_ffi_sfa_reader", "[clp-s][ffi][sfa]") {
     };
     REQUIRE(false == test_result.has_error());
 }
+
+TEST_CASE("clp_s_ffi_sfa_reader_decode", "[clp-s][ffi][sfa]") {
+    TestOutputCleaner const test_cleanup{{get_archive_output_root_dir().string()}};
+
+    auto const batch_size{GENERATE(static_cast<size_t>(1), static_cast<size_t>(3))};
+
+    auto const log_path{get_log_local_path(cInputNoFloats)};
+    auto const archive_path{generate_single_file_archive(log_path)};
+    auto const num_events{static_cast<int64_t>(get_num_lines(log_path))};
+
+    auto reader_result{create_reader_from_path(archive_path)};
+    REQUIRE(false == reader_result.has_error());
+    auto& reader{reader_result.value()};
+
+    EventBatch batch;
+    auto const not_started_result{reader.decode_next_batch(1, batch)};
+    REQUIRE(not_started_result.has_error());
+    REQUIRE((SfaErrorCode{SfaErrorCodeEnum::NotInit} == not_started_result.error()));
+
+    DecodeOptions options;
+    SECTION("Log order") {
+        auto const events{decode_all_events(reader, options, batch_size)};
+        REQUIRE((num_events == static_cast<int64_t>(events.size())));
+        for (int64_t i{0}; i < num_events; ++i) {
+            REQUIRE((i == events[i].first));
+        }
+
+        // Decoding can be restarted.
+        REQUIRE((events == decode_all_events(reader, options, batch_size)));
+    }
+
+    SECTION("Table order") {
+        options.ordered = false;
+        auto events{decode_all_events(reader, options, batch_size)};
+        REQUIRE((num_events == static_cast<int64_t>(events.size())));
+        std::ranges::sort(events);
+        for (int64_t i{0}; i < num_events; ++i) {
+            REQUIRE((i == events[i].first));
+        }
+    }
+
+    SECTION("Query and projection") {
+        options.query = "nonempty_object.int8_max: 127";
+        options.projection = {"int8_max"};
+        auto const events{decode_all_events(reader, options, batch_size)};
+        std::vector<std::pair<int64_t, std::string>> const expected_events{
+                {1, R"({"int8_max":127})"},
+                {2, R"({"int8_max":127})"}
+        };
+        REQUIRE((expected_events == events));
+    }
+
+    SECTION("Invalid query") {
+        options.query = "NOT :";
+        auto const result{reader.start_decoding(options)};
+        REQUIRE(result.has_error());
+        REQUIRE((SfaErrorCode{SfaErrorCodeEnum::InvalidQuery} == result.error()));
+        REQUIRE(reader.decode_next_batch(1, batch).has_error());
+    }
+}
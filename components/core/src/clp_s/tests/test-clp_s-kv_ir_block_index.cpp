@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <msgpack.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../src/clp/ffi/ir_stream/protocol_constants.hpp"
+#include "../src/clp/ffi/ir_stream/Serializer.hpp"
+#include "../src/clp/FileReader.hpp"
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp/ir/types.hpp"
+#include "../src/clp/streaming_compression/zstd/Compressor.hpp"
+#include "../src/clp/type_utils.hpp"
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/KvIrBlockIndex.hpp"
+#include "../src/clp_s/kv_ir_search.hpp"
+#include "../src/clp_s/search/kql/kql.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestBlockIndexPath{"test-kv-ir-block-index.blkidx"};
+constexpr std::string_view cTestIndexedStreamPath{"test-kv-ir-block-index.clp.zst"};
+constexpr std::string_view cTestIndexedStreamIndexPath{"test-kv-ir-block-index.clp.zst.blkidx"};
+
+namespace {
+/**
+ * Writes an index with three blocks:
+ * - block 0: timestamps [100, 200], containing "connection refused" and "db-1".
+ * - block 1: timestamps [300, 400], containing "connection accepted" and "db-2".
+ * - block 2: no timestamps, containing "heartbeat".
+ * An empty block is also started and ended to verify that it's discarded.
+ * @param writer
+ */
+auto write_test_index(clp::FileWriter& writer) -> void;
+
+/**
+ * @return The log events of the test stream, grouped into blocks:
+ * - block 0: timestamps [100, 200].
+ * - block 1: timestamps [300, 400], reusing keys from block 0 and adding the "host" key.
+ * - block 2: no timestamps.
+ */
+auto get_test_stream_blocks() -> std::vector<std::vector<nlohmann::json>>;
+
+/**
+ * Writes a zstd-compressed kv-pair IR stream containing the log events from
+ * `get_test_stream_blocks`, along with its block index. Each block starts at a new zstd frame and
+ * has a sync point, so the keys reused from earlier blocks are only known to a reader that starts
+ * at the block through the sync point.
+ */
+auto write_test_indexed_stream() -> void;
+
+/**
+ * Searches the test stream.
+ * @param query A KQL query.
+ * @param options
+ * @param use_index Whether to search using the stream's block index.
+ * @return The user-generated kv-pairs of each matching log event, in the order they were returned.
+ */
+auto search_test_stream(
+        std::string_view query,
+        clp_s::KvIrSearchOptions const& options,
+        bool use_index
+) -> std::vector<nlohmann::json>;
+
+auto write_test_index(clp::FileWriter& writer) -> void {
+    clp_s::KvIrBlockIndexWriter index_writer{std::vector<int8_t>{1, 2, 3}, true};
+
+    REQUIRE(false == index_writer.start_block(0, std::vector<int8_t>{4}).has_error());
+    REQUIRE(index_writer.start_block(0, {}).has_error());
+    index_writer.add_log_event(100);
+    index_writer.add_string_value("connection refused");
+    index_writer.add_log_event(200);
+    index_writer.add_string_value("db-1");
+    REQUIRE(false == index_writer.end_block().has_error());
+
+    REQUIRE(false == index_writer.start_block(10, std::vector<int8_t>{5, 6}).has_error());
+    REQUIRE(false == index_writer.end_block().has_error());
+
+    REQUIRE(false == index_writer.start_block(10, std::vector<int8_t>{5, 6}).has_error());
+    index_writer.add_log_event(400);
+    index_writer.add_string_value("connection accepted");
+    index_writer.add_log_event(300);
+    index_writer.add_string_value("db-2");
+    REQUIRE(false == index_writer.end_block().has_error());
+
+    REQUIRE(false == index_writer.start_block(20, {}).has_error());
+    index_writer.add_log_event(std::nullopt);
+    index_writer.add_string_value("heartbeat");
+    REQUIRE(false == index_writer.end_block().has_error());
+    REQUIRE(index_writer.end_block().has_error());
+
+    REQUIRE(3 == index_writer.get_num_blocks());
+    index_writer.write(writer);
+}
+
+auto get_test_stream_blocks() -> std::vector<std::vector<nlohmann::json>> {
+    return {
+            {{{"timestamp", 100}, {"level", "INFO"}, {"message", "connection accepted"}},
+             {{"timestamp", 200}, {"level", "ERROR"}, {"message", "connection refused"}}},
+            {{{"timestamp", 300}, {"level", "ERROR"}, {"message", "disk full"}, {"host", "db-2"}},
+             {{"timestamp", 400}, {"level", "INFO"}, {"message", "connection accepted"}}},
+            {{{"level", "ERROR"}, {"message", "heartbeat missed"}},
+             {{"level", "INFO"}, {"message", "heartbeat"}}}
+    };
+}
+
+auto write_test_indexed_stream() -> void {
+    auto serializer_result{
+            clp::ffi::ir_stream::Serializer<clp::ir::eight_byte_encoded_variable_t>::create()
+    };
+    REQUIRE(false == serializer_result.has_error());
+    auto& serializer{serializer_result.value()};
+
+    clp::FileWriter file_writer;
+    file_writer.open(
+            std::string{cTestIndexedStreamPath},
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    clp::streaming_compression::zstd::Compressor compressor;
+    compressor.open(file_writer);
+    auto const flush_ir_buf = [&]() -> void {
+        auto const ir_buf{serializer.get_ir_buf_view()};
+        compressor.write(
+                clp::size_checked_pointer_cast<char const>(ir_buf.data()),
+                ir_buf.size_bytes()
+        );
+        serializer.clear_ir_buf();
+    };
+
+    auto const preamble{serializer.get_ir_buf_view()};
+    clp_s::KvIrBlockIndexWriter index_writer{
+            std::vector<int8_t>{preamble.begin(), preamble.end()},
+            true
+    };
+    auto const empty_map_bytes{nlohmann::json::to_msgpack(nlohmann::json::object())};
+    auto const empty_map_handle{msgpack::unpack(
+            clp::size_checked_pointer_cast<char const>(empty_map_bytes.data()),
+            empty_map_bytes.size()
+    )};
+    for (auto const& block : get_test_stream_blocks()) {
+        // Flushing the compressor ends the current zstd frame, so the block can be read on its own.
+        flush_ir_buf();
+        compressor.flush();
+        std::vector<int8_t> sync_point;
+        REQUIRE(false == serializer.serialize_sync_point(sync_point).has_error());
+        auto const start_block_result{
+                index_writer.start_block(file_writer.get_pos(), std::move(sync_point))
+        };
+        REQUIRE(false == start_block_result.has_error());
+
+        for (auto const& log_event : block) {
+            auto const msgpack_bytes{nlohmann::json::to_msgpack(log_event)};
+            auto const msgpack_handle{msgpack::unpack(
+                    clp::size_checked_pointer_cast<char const>(msgpack_bytes.data()),
+                    msgpack_bytes.size()
+            )};
+            auto const serialize_result{serializer.serialize_msgpack_map(
+                    empty_map_handle.get().via.map,
+                    msgpack_handle.get().via.map
+            )};
+            REQUIRE(false == serialize_result.has_error());
+
+            std::optional<clp_s::epochtime_t> timestamp;
+            if (log_event.contains("timestamp")) {
+                timestamp = log_event.at("timestamp").get<clp_s::epochtime_t>();
+            }
+            index_writer.add_log_event(timestamp);
+            for (auto const& [key, value] : log_event.items()) {
+                if (value.is_string()) {
+                    index_writer.add_string_value(value.get<std::string>());
+                }
+            }
+        }
+        REQUIRE(false == index_writer.end_block().has_error());
+    }
+    flush_ir_buf();
+    compressor.write_numeric_value(clp::ffi::ir_stream::cProtocol::Eof);
+    compressor.close();
+    file_writer.close();
+
+    clp::FileWriter index_file_writer;
+    index_file_writer.open(
+            std::string{cTestIndexedStreamIndexPath},
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    index_writer.write(index_file_writer);
+    index_file_writer.close();
+}
+
+auto search_test_stream(
+        std::string_view query,
+        clp_s::KvIrSearchOptions const& options,
+        bool use_index
+) -> std::vector<nlohmann::json> {
+    std::istringstream query_stream{std::string{query}};
+    auto const expr{clp_s::search::kql::parse_kql_expression(query_stream)};
+    REQUIRE(nullptr != expr);
+
+    std::optional<clp_s::KvIrBlockIndex> block_index;
+    if (use_index) {
+        clp::FileReader index_reader{std::string{cTestIndexedStreamIndexPath}};
+        auto index_result{clp_s::KvIrBlockIndex::try_read(index_reader)};
+        REQUIRE(false == index_result.has_error());
+        block_index.emplace(std::move(index_result.value()));
+    }
+
+    clp::FileReader stream_reader{std::string{cTestIndexedStreamPath}};
+    std::ostringstream output;
+    auto const search_result{clp_s::search_kv_ir_stream(
+            stream_reader,
+            block_index.has_value() ? &block_index.value() : nullptr,
+            expr,
+            options,
+            output
+    )};
+    REQUIRE(false == search_result.has_error());
+
+    std::vector<nlohmann::json> matches;
+    std::istringstream output_stream{output.str()};
+    std::string line;
+    while (std::getline(output_stream, line)) {
+        matches.emplace_back(nlohmann::json::parse(line).at("user_generated_kv_pairs"));
+    }
+    return matches;
+}
+}  // namespace
+
+TEST_CASE("kv_ir_block_index", "[clp_s][KvIrBlockIndex]") {
+    TestOutputCleaner const test_cleanup{{std::string{cTestBlockIndexPath}}};
+
+    clp::FileWriter writer;
+    writer.open(std::string{cTestBlockIndexPath}, clp::FileWriter::OpenMode::CREATE_FOR_WRITING);
+    write_test_index(writer);
+    writer.close();
+
+    clp::FileReader reader{std::string{cTestBlockIndexPath}};
+    auto index_result{clp_s::KvIrBlockIndex::try_read(reader)};
+    REQUIRE(false == index_result.has_error());
+    auto const& index{index_result.value()};
+
+    REQUIRE(index.is_stream_compressed());
+    REQUIRE(std::vector<int8_t>{1, 2, 3} == index.get_preamble());
+    auto const& blocks{index.get_blocks()};
+    REQUIRE(3 == blocks.size());
+    REQUIRE(0 == blocks[0].stream_offset);
+    REQUIRE(2 == blocks[0].num_log_events);
+    REQUIRE(std::vector<int8_t>{4} == blocks[0].sync_point);
+    REQUIRE(blocks[1].timestamp_range.has_value());
+    REQUIRE(300 == blocks[1].timestamp_range->first);
+    REQUIRE(400 == blocks[1].timestamp_range->second);
+    REQUIRE(false == blocks[2].timestamp_range.has_value());
+
+    using Candidates = std::vector<size_t>;
+    REQUIRE(Candidates{0, 1, 2} == index.get_candidate_blocks(std::nullopt, std::nullopt, {}));
+    REQUIRE(Candidates{1, 2} == index.get_candidate_blocks(250, std::nullopt, {}));
+    REQUIRE(Candidates{0, 2} == index.get_candidate_blocks(std::nullopt, 250, {}));
+    REQUIRE(Candidates{2} == index.get_candidate_blocks(201, 299, {}));
+
+    // Whole values and their tokens are indexed, so there are no false negatives for either.
+    auto const refused_candidates{
+            index.get_candidate_blocks(std::nullopt, std::nullopt, {"connection refused"})
+    };
+    REQUIRE(refused_candidates.end()
+            != std::find(refused_candidates.begin(), refused_candidates.end(), 0));
+    auto const token_candidates{
+            index.get_candidate_blocks(std::nullopt, std::nullopt, {"connection", "db-2"})
+    };
+    REQUIRE(token_candidates.end()
+            != std::find(token_candidates.begin(), token_candidates.end(), 1));
+
+    // Blocks without timestamps aren't excluded by a timestamp filter.
+    auto const heartbeat_candidates{index.get_candidate_blocks(0, 1000, {"heartbeat"})};
+    REQUIRE(heartbeat_candidates.end()
+            != std::find(heartbeat_candidates.begin(), heartbeat_candidates.end(), 2));
+}
+
+TEST_CASE("kv_ir_block_index_rejects_corrupt_input", "[clp_s][KvIrBlockIndex]") {
+    TestOutputCleaner const test_cleanup{{std::string{cTestBlockIndexPath}}};
+
+    clp::FileWriter writer;
+    writer.open(std::string{cTestBlockIndexPath}, clp::FileWriter::OpenMode::CREATE_FOR_WRITING);
+    constexpr std::string_view cBadMagicNumber{"NOTANIDX"};
+    writer.write(cBadMagicNumber.data(), cBadMagicNumber.size());
+    writer.close();
+
+    clp::FileReader reader{std::string{cTestBlockIndexPath}};
+    auto const index_result{clp_s::KvIrBlockIndex::try_read(reader)};
+    REQUIRE(index_result.has_error());
+    REQUIRE(clp_s::KvIrBlockIndexError{clp_s::KvIrBlockIndexErrorEnum::CorruptIndex}
+            == index_result.error());
+}
+
+TEST_CASE("kv_ir_block_index_search", "[clp_s][KvIrBlockIndex]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestIndexedStreamPath}, std::string{cTestIndexedStreamIndexPath}}
+    };
+    write_test_indexed_stream();
+    auto const blocks{get_test_stream_blocks()};
+
+    // Without a time filter, searching with the index must return exactly what a full scan does.
+    auto const require_same_matches
+            = [](std::string_view query, clp_s::KvIrSearchOptions const& options) -> void {
+        auto const indexed_matches{search_test_stream(query, options, true)};
+        auto const scanned_matches{search_test_stream(query, options, false)};
+        REQUIRE((scanned_matches == indexed_matches));
+    };
+    require_same_matches("level: ERROR", {});
+    require_same_matches("message: \"connection refused\"", {});
+    require_same_matches("host: db-2", {});
+    require_same_matches("message: heartbeat*", {});
+    REQUIRE((std::vector<nlohmann::json>{blocks[0][1], blocks[1][0], blocks[2][0]}
+             == search_test_stream("level: ERROR", {}, true)));
+    REQUIRE((std::vector<nlohmann::json>{blocks[1][0]}
+             == search_test_stream("host: db-2", {}, true)));
+
+    // A time filter covering every timestamp must still return log events without timestamps.
+    require_same_matches("level: ERROR", {.begin_ts = 0, .end_ts = 1000});
+
+    // Otherwise, the time filter only prunes whole blocks.
+    REQUIRE((std::vector<nlohmann::json>{blocks[1][0], blocks[2][0]}
+             == search_test_stream("level: ERROR", {.begin_ts = 250, .end_ts = 1000}, true)));
+    REQUIRE((std::vector<nlohmann::json>{blocks[2][0]}
+             == search_test_stream("level: ERROR", {.begin_ts = 201, .end_ts = 299}, true)));
+}
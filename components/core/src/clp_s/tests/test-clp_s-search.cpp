@@ -1,8 +1,13 @@
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <numeric>
 #include <optional>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
@@ -17,6 +22,7 @@
 
 #include "../src/clp_s/archive_constants.hpp"
 #include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/ArchiveWriter.hpp"
 #include "../src/clp_s/InputConfig.hpp"
 #include "../src/clp_s/OutputHandlerImpl.hpp"
 #include "../src/clp_s/search/ast/ColumnDescriptor.hpp"
@@ -44,6 +50,7 @@ constexpr std::string_view cTestSearchInputFile{"test_search.jsonl"};
 constexpr std::string_view cTestSearchFormattedFloatFile{"test_search_formatted_float.jsonl"};
 constexpr std::string_view cTestSearchFloatTimestampFile{"test_search_float_timestamp.jsonl"};
 constexpr std::string_view cTestSearchIntTimestampFile{"test_search_int_timestamp.jsonl"};
+constexpr std::string_view cTestSearchSortedInputFile{"test-clp-s-search-sorted.jsonl"};
 constexpr std::string_view cTestIdxKey{"idx"};
 constexpr std::string_view cTestTimestampKey{"timestamp"};
 
@@ -63,6 +70,16 @@ void validate_results(
         std::vector<clp_s::VectorOutputHandler::QueryResult> const& results,
         std::vector<int64_t> const& expected_results
 );
+auto write_shuffled_timestamp_input(size_t num_records, int64_t first_timestamp) -> void;
+
+/**
+ * @param idx
+ * @param first_timestamp
+ * @return The timestamp of the record with the given index written by
+ * `write_shuffled_timestamp_input`. Timestamps are spaced apart so that there are gaps between
+ * consecutive records.
+ */
+auto get_shuffled_input_timestamp(int64_t idx, int64_t first_timestamp) -> int64_t;
 
 auto get_test_input_path_relative_to_tests_dir(std::string_view test_input_path)
         -> std::filesystem::path {
@@ -129,6 +146,25 @@ void validate_results(
     REQUIRE(results.size() == expected_results.size());
 }
 
+auto get_shuffled_input_timestamp(int64_t idx, int64_t first_timestamp) -> int64_t {
+    return first_timestamp + 2 * idx;
+}
+
+auto write_shuffled_timestamp_input(size_t num_records, int64_t first_timestamp) -> void {
+    std::vector<int64_t> indices(num_records);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::mt19937 generator{0};
+    std::shuffle(indices.begin(), indices.end(), generator);
+
+    std::ofstream input_file{std::string{cTestSearchSortedInputFile}};
+    for (auto const idx : indices) {
+        input_file << nlohmann::json{
+                {cTestIdxKey, idx},
+                {cTestTimestampKey, get_shuffled_input_timestamp(idx, first_timestamp)}
+        }.dump() << '\n';
+    }
+}
+
 void
 search(std::string const& query, bool ignore_case, std::vector<int64_t> const& expected_results) {
     auto query_stream = std::istringstream{query};
@@ -156,49 +192,63 @@ void search(
     expr = convert_pass.run(expr);
     REQUIRE(nullptr != expr);
 
-    std::vector<clp_s::VectorOutputHandler::QueryResult> results;
-    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
-        auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
-        auto archive_path = clp_s::Path{
-                .source{clp_s::InputSource::Filesystem},
-                .path{entry.path().string()}
-        };
-        archive_reader->open(archive_path, clp_s::NetworkAuthOption{});
-
-        auto archive_expr = expr->copy();
-
-        clp_s::search::EvaluateRangeIndexFilters metadata_filter_pass{
-                archive_reader->get_range_index(),
-                false == ignore_case
-        };
-        archive_expr = metadata_filter_pass.run(archive_expr);
-        REQUIRE(nullptr != archive_expr);
-        REQUIRE(nullptr == std::dynamic_pointer_cast<clp_s::search::ast::EmptyExpr>(archive_expr));
-
-        auto timestamp_dict = archive_reader->get_timestamp_dictionary();
-        clp_s::search::EvaluateTimestampIndex timestamp_index_pass(timestamp_dict);
-        REQUIRE(clp_s::EvaluatedValue::False != timestamp_index_pass.run(archive_expr));
-
-        auto match_pass = std::make_shared<clp_s::search::SchemaMatch>(
-                archive_reader->get_schema_tree(),
-                archive_reader->get_schema_map()
-        );
-        archive_expr = match_pass->run(archive_expr);
-        REQUIRE(nullptr != archive_expr);
-
-        auto output_handler = std::make_unique<clp_s::VectorOutputHandler>(results);
-        clp_s::search::Output output_pass(
-                match_pass,
-                archive_expr,
-                archive_reader,
-                std::move(output_handler),
-                ignore_case
-        );
-        output_pass.filter();
-        archive_reader->close();
-    }
+    // Without metadata, results are marshalled and written in batches
+    for (bool const should_output_metadata : {true, false}) {
+        std::vector<clp_s::VectorOutputHandler::QueryResult> results;
+        for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+            auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
+            auto archive_path = clp_s::Path{
+                    .source{clp_s::InputSource::Filesystem},
+                    .path{entry.path().string()}
+            };
+            archive_reader->open(archive_path, clp_s::NetworkAuthOption{});
+
+            auto archive_expr = expr->copy();
+
+            clp_s::search::EvaluateRangeIndexFilters metadata_filter_pass{
+                    archive_reader->get_range_index(),
+                    false == ignore_case
+            };
+            archive_expr = metadata_filter_pass.run(archive_expr);
+            REQUIRE(nullptr != archive_expr);
+            REQUIRE(
+                    nullptr
+                    == std::dynamic_pointer_cast<clp_s::search::ast::EmptyExpr>(archive_expr)
+            );
+
+            auto timestamp_dict = archive_reader->get_timestamp_dictionary();
+            clp_s::search::EvaluateTimestampIndex timestamp_index_pass(timestamp_dict);
+            if (clp_s::EvaluatedValue::False == timestamp_index_pass.run(archive_expr)) {
+                // The archive can only be skipped if nothing in it should match
+                REQUIRE(expected_results.empty());
+                archive_reader->close();
+                continue;
+            }
+
+            auto match_pass = std::make_shared<clp_s::search::SchemaMatch>(
+                    archive_reader->get_schema_tree(),
+                    archive_reader->get_schema_map()
+            );
+            archive_expr = match_pass->run(archive_expr);
+            REQUIRE(nullptr != archive_expr);
 
-    validate_results(results, expected_results);
+            auto output_handler = std::make_unique<clp_s::VectorOutputHandler>(
+                    results,
+                    should_output_metadata
+            );
+            clp_s::search::Output output_pass(
+                    match_pass,
+                    archive_expr,
+                    archive_reader,
+                    std::move(output_handler),
+                    ignore_case
+            );
+            output_pass.filter();
+            archive_reader->close();
+        }
+
+        validate_results(results, expected_results);
+    }
 }
 }  // namespace
 
@@ -355,3 +405,95 @@ TEST_CASE("clp-s-search-epoch-timestamp", "[clp-s][search]") {
         REQUIRE_NOTHROW(search(query, false, expected_results));
     }
 }
+
+TEST_CASE("clp-s-search-sorted-row-groups", "[clp-s][search]") {
+    // Spans several row groups, with a partial row group at the end
+    constexpr int64_t cRowGroupSize{clp_s::ArchiveWriter::cRowGroupSize};
+    constexpr int64_t cNumRecords{3 * cRowGroupSize + 1000};
+    constexpr int64_t cFirstTimestampMs{1'700'000'000'000};
+
+    // Timestamps increase with idx, so when sorted by timestamp, row group `i` contains the records
+    // with idx in [i * cRowGroupSize, (i + 1) * cRowGroupSize).
+    auto const timestamp_range_query = [&](int64_t begin_idx, int64_t end_idx) -> std::string {
+        return fmt::format(
+                R"aa(timestamp >= timestamp("{}") AND timestamp <= timestamp("{}"))aa",
+                get_shuffled_input_timestamp(begin_idx, cFirstTimestampMs),
+                get_shuffled_input_timestamp(end_idx, cFirstTimestampMs)
+        );
+    };
+    auto const get_indices = [&](auto const& predicate) -> std::vector<int64_t> {
+        std::vector<int64_t> indices;
+        for (int64_t idx{0}; idx < cNumRecords; ++idx) {
+            if (predicate(idx)) {
+                indices.push_back(idx);
+            }
+        }
+        return indices;
+    };
+    auto const in_range = [&](int64_t begin_idx, int64_t end_idx) {
+        return get_indices([&](int64_t idx) { return begin_idx <= idx && idx <= end_idx; });
+    };
+    auto const not_in_range = [&](int64_t begin_idx, int64_t end_idx) {
+        return get_indices([&](int64_t idx) { return idx < begin_idx || end_idx < idx; });
+    };
+
+    std::vector<std::pair<std::string, std::vector<int64_t>>> const queries_and_results{
+            // Inside a single row group
+            {timestamp_range_query(100, 200), in_range(100, 200)},
+            // Spanning several row groups
+            {timestamp_range_query(cRowGroupSize - 10, 2 * cRowGroupSize + 10),
+             in_range(cRowGroupSize - 10, 2 * cRowGroupSize + 10)},
+            // Exactly one row group
+            {timestamp_range_query(cRowGroupSize, 2 * cRowGroupSize - 1),
+             in_range(cRowGroupSize, 2 * cRowGroupSize - 1)},
+            // Inside the partial row group at the end
+            {timestamp_range_query(cNumRecords - 10, cNumRecords - 1),
+             in_range(cNumRecords - 10, cNumRecords - 1)},
+            // Between two consecutive records inside a row group
+            {fmt::format(
+                     R"aa(timestamp: timestamp("{}"))aa",
+                     get_shuffled_input_timestamp(100, cFirstTimestampMs) + 1
+             ),
+             {}},
+            // Outside the archive
+            {timestamp_range_query(cNumRecords + 10, cNumRecords + 20), {}},
+            {timestamp_range_query(-20, -10), {}},
+            // Negated ranges, which can only skip row groups entirely inside the range
+            {fmt::format("NOT ({})", timestamp_range_query(100, 200)), not_in_range(100, 200)},
+            {fmt::format("NOT ({})", timestamp_range_query(cRowGroupSize, 2 * cRowGroupSize - 1)),
+             not_in_range(cRowGroupSize, 2 * cRowGroupSize - 1)},
+            {fmt::format("NOT ({})", timestamp_range_query(0, cNumRecords - 1)), {}}
+    };
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSearchArchiveDirectory}, std::string{cTestSearchSortedInputFile}}
+    };
+    write_shuffled_timestamp_input(cNumRecords, cFirstTimestampMs);
+
+    // Searching the sorted archive, which skips row groups, should match the same records as
+    // searching an unsorted archive, which has no row group index.
+    for (bool const sort_by_timestamp : {false, true}) {
+        CAPTURE(sort_by_timestamp);
+        std::filesystem::remove_all(cTestSearchArchiveDirectory);
+        REQUIRE_NOTHROW(
+                std::ignore = compress_archive(
+                        std::string{cTestSearchSortedInputFile},
+                        std::string{cTestSearchArchiveDirectory},
+                        std::string{cTestTimestampKey},
+                        false,
+                        single_file_archive,
+                        false,
+                        nullptr,
+                        0,
+                        sort_by_timestamp ? std::optional<std::string>{cTestTimestampKey}
+                                          : std::nullopt
+                )
+        );
+
+        for (auto const& [query, expected_results] : queries_and_results) {
+            CAPTURE(query);
+            REQUIRE_NOTHROW(search(query, false, expected_results));
+        }
+    }
+}
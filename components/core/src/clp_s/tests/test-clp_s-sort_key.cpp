@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/ArchiveWriter.hpp"
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/JsonConstructor.hpp"
+#include "../src/clp_s/JsonParser.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestSortKeyInputFile{"test-sort-key.jsonl"};
+constexpr std::string_view cTestSortKeyArchiveDirectory{"test-sort-key-archive"};
+constexpr std::string_view cTestSortKeyOutputDirectory{"test-sort-key-out"};
+constexpr std::string_view cTestSortKeyTimestampKey{"timestamp"};
+constexpr std::string_view cTestSortKeyFloatKey{"value"};
+// Spans several row groups, with a partial row group at the end
+constexpr size_t cNumRecords{10'000};
+constexpr int64_t cFirstTimestampMs{1'700'000'000'000};
+
+namespace {
+/**
+ * Writes records with distinct timestamps to the input file in a shuffled order.
+ */
+auto write_shuffled_input() -> void;
+
+/**
+ * Writes records to the input file in a shuffled order, each with a float that has too many
+ * significant digits to be encoded with its format, so that it's stored as a dictionary float.
+ * @return The floats' values, sorted numerically.
+ */
+auto write_shuffled_dictionary_float_input() -> std::vector<std::string>;
+
+/**
+ * Compresses the input file sorted by the given key.
+ * @param single_file_archive
+ * @param record_log_order
+ * @param sort_key
+ * @param retain_float_format
+ * @return Statistics for every archive that was written.
+ */
+auto compress_sorted(
+        bool single_file_archive,
+        bool record_log_order,
+        std::string_view sort_key,
+        bool retain_float_format
+) -> std::vector<clp_s::ArchiveStats>;
+
+/**
+ * Decompresses an archive in the order its records are stored.
+ * @param archive_path
+ * @return The raw JSON of each record.
+ */
+auto extract_records(clp_s::Path const& archive_path) -> std::vector<std::string>;
+
+auto write_shuffled_input() -> void {
+    std::vector<int64_t> timestamps(cNumRecords);
+    std::iota(timestamps.begin(), timestamps.end(), cFirstTimestampMs);
+    std::mt19937 generator{0};
+    std::shuffle(timestamps.begin(), timestamps.end(), generator);
+
+    std::string const timestamp_key{cTestSortKeyTimestampKey};
+    std::ofstream input_file{std::string{cTestSortKeyInputFile}};
+    for (auto const timestamp : timestamps) {
+        input_file << nlohmann::json{{timestamp_key, timestamp}}.dump() << '\n';
+    }
+}
+
+auto write_shuffled_dictionary_float_input() -> std::vector<std::string> {
+    constexpr int cNumValues{200};
+    // The values are generated in numeric order, which differs from their lexicographic order,
+    // e.g., "-1..." < "-10..." and "10..." < "9...".
+    std::vector<std::string> values;
+    for (int i{-cNumValues / 2}; i < cNumValues / 2; ++i) {
+        values.emplace_back(fmt::format("{}.123456789123456789", i));
+    }
+    auto shuffled_values{values};
+    std::mt19937 generator{0};
+    std::shuffle(shuffled_values.begin(), shuffled_values.end(), generator);
+
+    std::ofstream input_file{std::string{cTestSortKeyInputFile}};
+    for (auto const& value : shuffled_values) {
+        input_file << fmt::format(R"({{"{}":{}}})", cTestSortKeyFloatKey, value) << '\n';
+    }
+    return values;
+}
+
+auto compress_sorted(
+        bool single_file_archive,
+        bool record_log_order,
+        std::string_view sort_key,
+        bool retain_float_format
+) -> std::vector<clp_s::ArchiveStats> {
+    std::filesystem::create_directory(cTestSortKeyArchiveDirectory);
+
+    clp_s::JsonParserOption parser_option{};
+    parser_option.input_paths_and_canonical_filenames.emplace_back(
+            clp_s::Path{
+                    .source = clp_s::InputSource::Filesystem,
+                    .path = std::string{cTestSortKeyInputFile}
+            },
+            std::string{cTestSortKeyInputFile}
+    );
+    parser_option.archives_dir = cTestSortKeyArchiveDirectory;
+    parser_option.target_encoded_size = 8ULL * 1024 * 1024 * 1024;
+    parser_option.max_document_size = 512ULL * 1024 * 1024;
+    parser_option.min_table_size = 1ULL * 1024 * 1024;
+    parser_option.compression_level = 3;
+    parser_option.single_file_archive = single_file_archive;
+    parser_option.record_log_order = record_log_order;
+    parser_option.retain_float_format = retain_float_format;
+    parser_option.timestamp_key = cTestSortKeyTimestampKey;
+    parser_option.sort_key = sort_key;
+
+    clp_s::JsonParser parser{parser_option};
+    std::vector<clp_s::ArchiveStats> archive_stats;
+    REQUIRE(parser.ingest());
+    REQUIRE_NOTHROW(archive_stats = parser.store());
+    return archive_stats;
+}
+
+auto extract_records(clp_s::Path const& archive_path) -> std::vector<std::string> {
+    std::filesystem::remove_all(cTestSortKeyOutputDirectory);
+
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.archive_path = archive_path;
+    constructor_option.output_dir = cTestSortKeyOutputDirectory;
+    clp_s::JsonConstructor constructor{constructor_option};
+    REQUIRE_NOTHROW(constructor.store());
+
+    std::vector<std::string> records;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSortKeyOutputDirectory)) {
+        std::ifstream extracted_file{entry.path()};
+        std::string line;
+        while (std::getline(extracted_file, line)) {
+            records.emplace_back(std::move(line));
+        }
+    }
+    return records;
+}
+}  // namespace
+
+TEST_CASE("clp-s-sort-key", "[clp-s][sort-key]") {
+    auto const single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSortKeyInputFile},
+             std::string{cTestSortKeyArchiveDirectory},
+             std::string{cTestSortKeyOutputDirectory}}
+    };
+    write_shuffled_input();
+
+    // Sorting can't preserve log order.
+    REQUIRE_THROWS_AS(
+            compress_sorted(single_file_archive, true, cTestSortKeyTimestampKey, false),
+            clp_s::JsonParser::OperationFailed
+    );
+
+    auto const archive_stats{
+            compress_sorted(single_file_archive, false, cTestSortKeyTimestampKey, false)
+    };
+    REQUIRE((1ULL == archive_stats.size()));
+    auto const archive_path{clp_s::Path{
+            .source{clp_s::InputSource::Filesystem},
+            .path{(std::filesystem::path{cTestSortKeyArchiveDirectory}
+                   / archive_stats.front().get_id())
+                          .string()}
+    }};
+
+    std::string const timestamp_key{cTestSortKeyTimestampKey};
+    std::vector<int64_t> timestamps;
+    for (auto const& record : extract_records(archive_path)) {
+        timestamps.push_back(nlohmann::json::parse(record).at(timestamp_key).get<int64_t>());
+    }
+    REQUIRE((cNumRecords == timestamps.size()));
+    REQUIRE(std::is_sorted(timestamps.begin(), timestamps.end()));
+
+    clp_s::ArchiveReader archive_reader;
+    REQUIRE_NOTHROW(archive_reader.open(archive_path, clp_s::NetworkAuthOption{}));
+    auto const& row_group_timestamp_index{archive_reader.get_row_group_timestamp_index()};
+    REQUIRE((1ULL == row_group_timestamp_index.timestamp_bounds.size()));
+    auto const row_group_size{row_group_timestamp_index.row_group_size};
+    REQUIRE((0 != row_group_size));
+    auto const& bounds{row_group_timestamp_index.timestamp_bounds.begin()->second};
+    auto const num_row_groups{(cNumRecords + row_group_size - 1) / row_group_size};
+    REQUIRE((2 * num_row_groups == bounds.size()));
+
+    // Row groups are sorted and disjoint, and together span the archive's time range.
+    auto const to_ms = [](clp_s::epochtime_t timestamp) -> clp_s::epochtime_t {
+        constexpr clp_s::epochtime_t cNanosecondsInMillisecond{1'000'000};
+        return timestamp / cNanosecondsInMillisecond;
+    };
+    REQUIRE((archive_stats.front().get_begin_timestamp() == to_ms(bounds.front())));
+    REQUIRE((archive_stats.front().get_end_timestamp() == to_ms(bounds.back())));
+    for (size_t i{0}; i < num_row_groups; ++i) {
+        auto const first_record{i * row_group_size};
+        auto const last_record{std::min<size_t>(first_record + row_group_size, cNumRecords) - 1};
+        REQUIRE((timestamps[first_record] == to_ms(bounds[2 * i])));
+        REQUIRE((timestamps[last_record] == to_ms(bounds[2 * i + 1])));
+    }
+    REQUIRE_NOTHROW(archive_reader.close());
+}
+
+TEST_CASE("clp-s-sort-key-dictionary-float", "[clp-s][sort-key]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSortKeyInputFile},
+             std::string{cTestSortKeyArchiveDirectory},
+             std::string{cTestSortKeyOutputDirectory}}
+    };
+    auto const expected_values{write_shuffled_dictionary_float_input()};
+
+    auto const archive_stats{compress_sorted(false, false, cTestSortKeyFloatKey, true)};
+    REQUIRE((1ULL == archive_stats.size()));
+    auto const archive_path{clp_s::Path{
+            .source{clp_s::InputSource::Filesystem},
+            .path{(std::filesystem::path{cTestSortKeyArchiveDirectory}
+                   / archive_stats.front().get_id())
+                          .string()}
+    }};
+
+    // Dictionary floats retain their original text, so compare the extracted text directly
+    std::vector<std::string> expected_records;
+    for (auto const& value : expected_values) {
+        expected_records.emplace_back(fmt::format(R"({{"{}":{}}})", cTestSortKeyFloatKey, value));
+    }
+    REQUIRE((expected_records == extract_records(archive_path)));
+}
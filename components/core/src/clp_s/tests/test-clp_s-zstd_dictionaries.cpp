@@ -0,0 +1,327 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <fmt/format.h>
+#include <zstd.h>
+
+#include "../src/clp_s/archive_constants.hpp"
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/FileWriter.hpp"
+#include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/JsonConstructor.hpp"
+#include "../src/clp_s/ZstdCompressor.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+#include "../src/clp_s/ZstdDictionaryRegistry.hpp"
+#include "../src/clp_s/ZstdDictionaryTrainer.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestZstdDictionariesRegistryDirectory{"test-zstd-dictionaries"};
+constexpr std::string_view cTestZstdDictionariesArchiveDirectory{"test-zstd-dictionaries-archive"};
+constexpr std::string_view cTestZstdDictionariesOutputDirectory{"test-zstd-dictionaries-out"};
+constexpr std::string_view cTestZstdDictionariesCompressedFile{"test-zstd-dictionaries.zst"};
+constexpr std::string_view cTestZstdDictionariesInputFileDirectory{"test_log_files"};
+constexpr std::string_view cTestZstdDictionariesInputFile{"test_no_floats_sorted.jsonl"};
+constexpr std::string_view cTestZstdDictionariesSampleFile{"test-zstd-dictionaries-samples.jsonl"};
+constexpr size_t cNumRecordsInInputFile{4};
+constexpr size_t cMaxDictionarySize{16 * 1024};
+constexpr int cCompressionLevel{3};
+
+namespace {
+/**
+ * Samples of log events similar to the ones the dictionaries are tested on.
+ */
+struct Samples {
+    std::vector<char> data;
+    std::vector<size_t> sizes;
+};
+
+auto get_test_input_local_path() -> std::string;
+auto get_log_event(size_t i) -> std::string;
+auto generate_samples() -> Samples;
+auto train_dictionary() -> std::vector<char>;
+auto compress(std::string_view data, ZSTD_CDict const* dictionary) -> size_t;
+auto decompress(size_t data_size, ZSTD_DDict const* dictionary) -> std::string;
+auto count_extracted_records() -> size_t;
+auto write_sample_file(size_t num_log_events) -> void;
+
+auto get_test_input_local_path() -> std::string {
+    std::filesystem::path const current_file_path{__FILE__};
+    auto const tests_dir{current_file_path.parent_path()};
+    return (tests_dir / cTestZstdDictionariesInputFileDirectory / cTestZstdDictionariesInputFile)
+            .string();
+}
+
+auto get_log_event(size_t i) -> std::string {
+    constexpr std::array<std::string_view, 3> cLevels{"INFO", "WARN", "ERROR"};
+    return fmt::format(
+            R"({{"timestamp":{},"level":"{}","service":"service-{}","message":"Request {} )"
+            R"(completed in {} ms","path":"/api/v1/users/{}"}})"
+            "\n",
+            1'700'000'000'000 + i * 37,
+            cLevels.at(i % cLevels.size()),
+            i % 7,
+            i,
+            (i * 13) % 1000,
+            (i * 7919) % 100'000
+    );
+}
+
+auto generate_samples() -> Samples {
+    constexpr size_t cNumSamples{2000};
+    Samples samples;
+    for (size_t i{0}; i < cNumSamples; ++i) {
+        auto const log_event{get_log_event(i)};
+        samples.data.insert(samples.data.end(), log_event.begin(), log_event.end());
+        samples.sizes.push_back(log_event.size());
+    }
+    return samples;
+}
+
+auto train_dictionary() -> std::vector<char> {
+    auto const samples{generate_samples()};
+    auto dictionary{clp_s::ZstdDictionaryRegistry::train_dictionary(
+            samples.data,
+            samples.sizes,
+            cMaxDictionarySize
+    )};
+    REQUIRE(dictionary.has_value());
+    return std::move(dictionary.value());
+}
+
+auto compress(std::string_view data, ZSTD_CDict const* dictionary) -> size_t {
+    clp_s::FileWriter file_writer;
+    file_writer.open(
+            std::string{cTestZstdDictionariesCompressedFile},
+            clp_s::FileWriter::OpenMode::CreateForWriting
+    );
+    clp_s::ZstdCompressor compressor;
+    compressor.open(file_writer, cCompressionLevel, dictionary);
+    compressor.write(data.data(), data.size());
+    compressor.close();
+    auto const compressed_size{file_writer.get_pos()};
+    file_writer.close();
+    return compressed_size;
+}
+
+auto decompress(size_t data_size, ZSTD_DDict const* dictionary) -> std::string {
+    clp_s::ZstdDecompressor decompressor;
+    decompressor.set_dictionary(dictionary);
+    REQUIRE((clp_s::ErrorCodeSuccess
+             == decompressor.open(std::string{cTestZstdDictionariesCompressedFile})));
+    std::string data(data_size, '\0');
+    REQUIRE((clp_s::ErrorCodeSuccess == decompressor.try_read_exact_length(data.data(), data_size))
+    );
+    decompressor.close();
+    return data;
+}
+
+auto count_extracted_records() -> size_t {
+    size_t num_records{0};
+    for (auto const& entry :
+         std::filesystem::recursive_directory_iterator(cTestZstdDictionariesOutputDirectory))
+    {
+        if (false == entry.is_regular_file()) {
+            continue;
+        }
+        std::ifstream extracted_file{entry.path()};
+        std::string line;
+        while (std::getline(extracted_file, line)) {
+            ++num_records;
+        }
+    }
+    return num_records;
+}
+
+auto write_sample_file(size_t num_log_events) -> void {
+    std::ofstream sample_file{std::string{cTestZstdDictionariesSampleFile}};
+    for (size_t i{0}; i < num_log_events; ++i) {
+        sample_file << get_log_event(i);
+    }
+}
+}  // namespace
+
+TEST_CASE("clp-s-zstd-dictionary-registry", "[clp-s][zstd-dictionaries]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestZstdDictionariesRegistryDirectory},
+             std::string{cTestZstdDictionariesCompressedFile}}
+    };
+
+    auto const dictionary{train_dictionary()};
+    uint32_t dictionary_id{};
+    {
+        clp_s::ZstdDictionaryRegistry registry{std::string{cTestZstdDictionariesRegistryDirectory}};
+        REQUIRE_FALSE(registry.get_dictionary_id(clp_s::constants::cArchiveTablesFile).has_value());
+        dictionary_id = registry.add_dictionary(clp_s::constants::cArchiveTablesFile, dictionary);
+        REQUIRE(0 != dictionary_id);
+
+        // Re-adding the same dictionary should be a no-op
+        REQUIRE(dictionary_id
+                == registry.add_dictionary(clp_s::constants::cArchiveTablesFile, dictionary));
+    }
+
+    // The manifest should survive reopening the registry
+    clp_s::ZstdDictionaryRegistry registry{std::string{cTestZstdDictionariesRegistryDirectory}};
+    REQUIRE((registry.get_dictionary_id(clp_s::constants::cArchiveTablesFile)
+             == std::optional<uint32_t>{dictionary_id}));
+    REQUIRE_FALSE(registry.get_dictionary_id(clp_s::constants::cArchiveVarDictFile).has_value());
+
+    // Small streams of data similar to the samples should compress better with the dictionary
+    std::string data;
+    for (size_t i{10'000}; i < 10'010; ++i) {
+        data += get_log_event(i);
+    }
+    auto const compressed_size_without_dictionary{compress(data, nullptr)};
+    REQUIRE(decompress(data.size(), nullptr) == data);
+
+    auto const compressed_size_with_dictionary{compress(
+            data,
+            registry.get_compression_dictionary(dictionary_id, cCompressionLevel)
+    )};
+    REQUIRE(decompress(data.size(), registry.get_decompression_dictionary(dictionary_id)) == data);
+    REQUIRE(compressed_size_with_dictionary < compressed_size_without_dictionary);
+
+    // Digested dictionaries should be cached
+    REQUIRE(registry.get_decompression_dictionary(dictionary_id)
+            == registry.get_decompression_dictionary(dictionary_id));
+}
+
+TEST_CASE("clp-s-zstd-dictionary-archive", "[clp-s][zstd-dictionaries]") {
+    auto const single_file_archive{GENERATE(true, false)};
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestZstdDictionariesRegistryDirectory},
+             std::string{cTestZstdDictionariesArchiveDirectory},
+             std::string{cTestZstdDictionariesOutputDirectory}}
+    };
+
+    auto const registry{std::make_shared<clp_s::ZstdDictionaryRegistry>(
+            std::string{cTestZstdDictionariesRegistryDirectory}
+    )};
+    auto const dictionary{train_dictionary()};
+    for (auto const section : clp_s::cZstdDictionarySections) {
+        std::ignore = registry->add_dictionary(section, dictionary);
+    }
+
+    std::ignore = compress_archive(
+            get_test_input_local_path(),
+            std::string{cTestZstdDictionariesArchiveDirectory},
+            std::nullopt,
+            false,
+            single_file_archive,
+            false,
+            registry
+    );
+
+    std::filesystem::create_directory(cTestZstdDictionariesOutputDirectory);
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = cTestZstdDictionariesOutputDirectory;
+    constructor_option.zstd_dictionaries = registry;
+    for (auto const& entry :
+         std::filesystem::directory_iterator(cTestZstdDictionariesArchiveDirectory))
+    {
+        clp_s::Path const archive_path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+
+        // Archives compressed with dictionaries can't be read without them
+        clp_s::ArchiveReader archive_reader;
+        REQUIRE_THROWS(archive_reader.open(archive_path, clp_s::NetworkAuthOption{}));
+
+        constructor_option.archive_path = archive_path;
+        clp_s::JsonConstructor constructor{constructor_option};
+        REQUIRE_NOTHROW(constructor.store());
+    }
+    REQUIRE(cNumRecordsInInputFile == count_extracted_records());
+}
+
+TEST_CASE("clp-s-zstd-dictionary-trainer", "[clp-s][zstd-dictionaries]") {
+    constexpr size_t cNumSampleLogEvents{5000};
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestZstdDictionariesRegistryDirectory},
+             std::string{cTestZstdDictionariesArchiveDirectory},
+             std::string{cTestZstdDictionariesOutputDirectory},
+             std::string{cTestZstdDictionariesSampleFile}}
+    };
+
+    write_sample_file(cNumSampleLogEvents);
+    std::ignore = compress_archive(
+            std::string{cTestZstdDictionariesSampleFile},
+            std::string{cTestZstdDictionariesArchiveDirectory},
+            std::nullopt,
+            false,
+            false,
+            false
+    );
+
+    auto const registry{std::make_shared<clp_s::ZstdDictionaryRegistry>(
+            std::string{cTestZstdDictionariesRegistryDirectory}
+    )};
+    // Opening a registry shouldn't create it, so that read-only registries can be opened
+    REQUIRE_FALSE(std::filesystem::exists(cTestZstdDictionariesRegistryDirectory));
+
+    clp_s::ZstdDictionaryTrainer trainer{registry, cMaxDictionarySize};
+    for (auto const& entry :
+         std::filesystem::directory_iterator(cTestZstdDictionariesArchiveDirectory))
+    {
+        trainer.add_samples_from_archive(
+                clp_s::Path{.source{clp_s::InputSource::Filesystem}, .path{entry.path().string()}},
+                clp_s::NetworkAuthOption{}
+        );
+    }
+    auto const num_dictionaries{trainer.train()};
+    REQUIRE(0 < num_dictionaries);
+
+    // Every trained dictionary should be registered for its section
+    size_t num_sections_with_dictionaries{0};
+    for (auto const section : clp_s::cZstdDictionarySections) {
+        if (registry->get_dictionary_id(section).has_value()) {
+            ++num_sections_with_dictionaries;
+        }
+    }
+    REQUIRE((num_dictionaries == num_sections_with_dictionaries));
+    // The records table is by far the largest section, so it always has enough samples
+    REQUIRE(registry->get_dictionary_id(clp_s::constants::cArchiveTablesFile).has_value());
+
+    // Archives compressed with the trained dictionaries should round-trip
+    std::filesystem::remove_all(cTestZstdDictionariesArchiveDirectory);
+    std::ignore = compress_archive(
+            std::string{cTestZstdDictionariesSampleFile},
+            std::string{cTestZstdDictionariesArchiveDirectory},
+            std::nullopt,
+            false,
+            false,
+            false,
+            registry
+    );
+
+    std::filesystem::create_directory(cTestZstdDictionariesOutputDirectory);
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = cTestZstdDictionariesOutputDirectory;
+    constructor_option.zstd_dictionaries = registry;
+    for (auto const& entry :
+         std::filesystem::directory_iterator(cTestZstdDictionariesArchiveDirectory))
+    {
+        constructor_option.archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        clp_s::JsonConstructor constructor{constructor_option};
+        REQUIRE_NOTHROW(constructor.store());
+    }
+    REQUIRE((cNumSampleLogEvents == count_extracted_records()));
+}
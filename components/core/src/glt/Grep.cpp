@@ -1,6 +1,13 @@
 #include "Grep.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 #include <string_utils/string_utils.hpp>
 
@@ -16,8 +23,11 @@ using clp::string_utils::is_wildcard;
 using clp::string_utils::wildcard_match_unsafe;
 using glt::ir::is_delim;
 using glt::streaming_archive::reader::Archive;
+using glt::streaming_archive::reader::CombinedLogtypeTable;
 using glt::streaming_archive::reader::File;
+using glt::streaming_archive::reader::LogtypeTable;
 using glt::streaming_archive::reader::Message;
+using glt::streaming_archive::reader::SingleLogtypeTableManager;
 using std::string;
 using std::vector;
 
@@ -87,6 +97,24 @@ private:
     size_t m_current_possible_type_ix;
 };
 
+// A search result buffered by a thread scanning a table
+struct BufferedResult {
+    string orig_file_path;
+    Message compressed_msg;
+    string decompressed_msg;
+};
+
+// The tables and decompressor used by a thread to scan the tables of a segment
+struct TableScanState {
+    LogtypeTable logtype_table;
+    CombinedLogtypeTable combined_table;
+    SingleLogtypeTableManager::CombinedTableDecompressor combined_table_decompressor;
+};
+
+// Scans a table using the given state, and outputs up to the given limit of results using the given
+// method. Returns the number of results output.
+using TableScanTask = std::function<size_t(TableScanState&, size_t, Grep::OutputFunc, void*)>;
+
 QueryToken::QueryToken(
         string const& query_string,
         size_t const begin_pos,
@@ -308,6 +336,136 @@ SubQueryMatchabilityResult generate_logtypes_and_vars_for_subquery(
         bool ignore_case,
         SubQuery& sub_query
 );
+/**
+ * Finds all messages in the given logtype table that match the given queries and outputs them
+ * using the given method
+ * @param query_for_logtype
+ * @param query
+ * @param limit
+ * @param archive
+ * @param logtype_table Opened for the logtype and closed before returning
+ * @param output_func
+ * @param output_func_arg
+ * @return Number of matches found
+ * @throw Same as Grep::search_segment_optimized_and_output
+ */
+size_t search_logtype_table(
+        LogtypeQueries const& query_for_logtype,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        LogtypeTable& logtype_table,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+);
+/**
+ * Outputs all messages in the given logtype table within the query's time range using the given
+ * method
+ * @param logtype_id
+ * @param query
+ * @param limit
+ * @param archive
+ * @param logtype_table Opened for the logtype and closed before returning
+ * @param output_func
+ * @param output_func_arg
+ * @return Number of matches found
+ * @throw Same as Grep::output_message_in_segment_within_time_range
+ */
+size_t output_logtype_table_within_time_range(
+        logtype_dictionary_id_t logtype_id,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        LogtypeTable& logtype_table,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+);
+/**
+ * Finds all messages in the given combined table that match the given queries and outputs them
+ * using the given method
+ * @param table_id
+ * @param queries
+ * @param query
+ * @param limit
+ * @param archive
+ * @param combined_table Opened for the table and closed before returning
+ * @param decompressor Used to read the combined table
+ * @param output_func
+ * @param output_func_arg
+ * @return Number of matches found
+ * @throw Same as Grep::search_combined_table_and_output
+ */
+size_t search_combined_table(
+        combined_table_id_t table_id,
+        vector<LogtypeQueries> const& queries,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        CombinedLogtypeTable& combined_table,
+        SingleLogtypeTableManager::CombinedTableDecompressor& decompressor,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+);
+/**
+ * Outputs all messages in the given combined table within the query's time range using the given
+ * method
+ * @param table_id
+ * @param query
+ * @param limit
+ * @param archive
+ * @param combined_table Opened for the table and closed before returning
+ * @param decompressor Used to read the combined table
+ * @param output_func
+ * @param output_func_arg
+ * @return Number of matches found
+ * @throw Same as Grep::output_message_in_combined_segment_within_time_range
+ */
+size_t output_combined_table_within_time_range(
+        combined_table_id_t table_id,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        CombinedLogtypeTable& combined_table,
+        SingleLogtypeTableManager::CombinedTableDecompressor& decompressor,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+);
+/**
+ * Output function that appends the result to the vector of BufferedResult given as the custom
+ * argument
+ * @param orig_file_path
+ * @param compressed_msg
+ * @param decompressed_msg
+ * @param custom_arg
+ */
+void buffer_result(
+        string const& orig_file_path,
+        Message const& compressed_msg,
+        string const& decompressed_msg,
+        void* custom_arg
+);
+/**
+ * Runs the given table scans on the given number of threads, and outputs their results using the
+ * given method in the order of the scans (i.e., the same order as running the scans serially).
+ *
+ * Each thread repeatedly claims the next unclaimed scan, so threads that finish small tables early
+ * move on to the remaining ones. Each thread scans with its own tables and decompressor, and
+ * buffers a scan's results until all earlier scans have been output.
+ * @param tasks
+ * @param num_threads
+ * @param limit
+ * @param output_func
+ * @param output_func_arg
+ * @return Number of matches output
+ * @throw Any exception thrown by a scan
+ */
+size_t run_table_scan_tasks(
+        vector<TableScanTask> const& tasks,
+        size_t num_threads,
+        size_t limit,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+);
 
 bool process_var_token(
         QueryToken const& query_token,
@@ -480,6 +638,387 @@ SubQueryMatchabilityResult generate_logtypes_and_vars_for_subquery(
 
     return SubQueryMatchabilityResult::MayMatch;
 }
+
+size_t search_logtype_table(
+        LogtypeQueries const& query_for_logtype,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        LogtypeTable& logtype_table,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+) {
+    size_t num_matches = 0;
+
+    auto logtype_id = query_for_logtype.get_logtype_id();
+    archive.get_logtype_table_manager().open_logtype_table(logtype_id, logtype_table);
+
+    // Load timestamps. Variable columns are loaded on demand while the sub-queries are evaluated,
+    // so columns that no candidate row reaches are never decompressed.
+    logtype_table.load_timestamp();
+
+    std::vector<size_t> matched_row_ix;
+    std::vector<bool> wildcard_required;
+    // Find matching message
+    archive.find_message_matching_with_logtype_query_optimized(
+            logtype_table,
+            query_for_logtype.get_queries(),
+            matched_row_ix,
+            wildcard_required,
+            query
+    );
+
+    size_t num_potential_matches = matched_row_ix.size();
+    if (num_potential_matches != 0) {
+        // Decompress match
+        auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
+        std::vector<epochtime_t> loaded_ts(num_potential_matches);
+        std::vector<file_id_t> loaded_file_id(num_potential_matches);
+        std::vector<encoded_variable_t> loaded_vars(num_potential_matches * num_vars);
+        logtype_table.load_remaining_data_into_vec(
+                loaded_ts,
+                loaded_file_id,
+                loaded_vars,
+                matched_row_ix
+        );
+        num_matches = archive.decompress_messages_and_output(
+                logtype_id,
+                loaded_ts,
+                loaded_file_id,
+                loaded_vars,
+                wildcard_required,
+                query,
+                limit,
+                output_func,
+                output_func_arg
+        );
+    }
+    logtype_table.close();
+    return num_matches;
+}
+
+size_t output_logtype_table_within_time_range(
+        logtype_dictionary_id_t logtype_id,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        LogtypeTable& logtype_table,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+) {
+    size_t num_matches = 0;
+
+    // In this branch, subqueries should not exist, so the only predicate that can be evaluated on
+    // the encoded messages is the time range.
+    archive.get_logtype_table_manager().open_logtype_table(logtype_id, logtype_table);
+    logtype_table.load_timestamp();
+    std::vector<size_t> matched_row_ix;
+    logtype_table.find_rows_in_time_range(
+            query.get_search_begin_timestamp(),
+            query.get_search_end_timestamp(),
+            matched_row_ix
+    );
+
+    size_t num_potential_matches = matched_row_ix.size();
+    if (num_potential_matches != 0) {
+        // Only decompress the remaining columns up to the last row in the time range
+        auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
+        std::vector<epochtime_t> loaded_ts(num_potential_matches);
+        std::vector<file_id_t> loaded_file_id(num_potential_matches);
+        std::vector<encoded_variable_t> loaded_vars(num_potential_matches * num_vars);
+        logtype_table.load_remaining_data_into_vec(
+                loaded_ts,
+                loaded_file_id,
+                loaded_vars,
+                matched_row_ix
+        );
+        // Whether wildcard match is required is determined by the query itself
+        std::vector<bool> wildcard_required(num_potential_matches, false);
+        num_matches = archive.decompress_messages_and_output(
+                logtype_id,
+                loaded_ts,
+                loaded_file_id,
+                loaded_vars,
+                wildcard_required,
+                query,
+                limit,
+                output_func,
+                output_func_arg
+        );
+    }
+    logtype_table.close();
+    return num_matches;
+}
+
+size_t search_combined_table(
+        combined_table_id_t table_id,
+        vector<LogtypeQueries> const& queries,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        CombinedLogtypeTable& combined_table,
+        SingleLogtypeTableManager::CombinedTableDecompressor& decompressor,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+) {
+    size_t num_matches = 0;
+
+    Message compressed_msg;
+    string decompressed_msg;
+    auto const& logtype_table_manager = archive.get_logtype_table_manager();
+    logtype_table_manager.open_combined_table(table_id, combined_table, decompressor);
+    for (auto const& iter : queries) {
+        logtype_dictionary_id_t logtype_id = iter.get_logtype_id();
+        logtype_table_manager.load_logtype_table_from_combine(
+                logtype_id,
+                combined_table,
+                decompressor
+        );
+
+        auto const& queries_by_logtype = iter.get_queries();
+
+        // Initialize message
+        auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
+        compressed_msg.resize_var(num_vars);
+        compressed_msg.set_logtype_id(logtype_id);
+
+        size_t left_boundary = 0;
+        size_t right_boundary = num_vars;
+
+        bool required_wild_card;
+        while (num_matches < limit) {
+            // Find matching message
+            bool found_matched = archive.find_message_matching_with_logtype_query_from_combined(
+                    combined_table,
+                    queries_by_logtype,
+                    compressed_msg,
+                    required_wild_card,
+                    query,
+                    left_boundary,
+                    right_boundary
+            );
+            if (found_matched == false) {
+                break;
+            }
+            // Decompress match
+            bool decompress_successful = archive.decompress_message_with_fixed_timestamp_pattern(
+                    compressed_msg,
+                    decompressed_msg
+            );
+            if (!decompress_successful) {
+                break;
+            }
+
+            // Perform wildcard match if required
+            // Check if:
+            // - Sub-query requires wildcard match, or
+            // - no subqueries exist and the search string is not a match-all
+            if ((query.contains_sub_queries() && required_wild_card)
+                || (query.contains_sub_queries() == false
+                    && query.search_string_matches_all() == false))
+            {
+                bool matched = wildcard_match_unsafe(
+                        decompressed_msg,
+                        query.get_search_string(),
+                        query.get_ignore_case() == false
+                );
+                if (!matched) {
+                    continue;
+                }
+            }
+            std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
+            // Print match
+            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            ++num_matches;
+        }
+        combined_table.close_logtype_table();
+    }
+    combined_table.close();
+    decompressor.close();
+    return num_matches;
+}
+
+size_t output_combined_table_within_time_range(
+        combined_table_id_t table_id,
+        Query const& query,
+        size_t limit,
+        Archive const& archive,
+        CombinedLogtypeTable& combined_table,
+        SingleLogtypeTableManager::CombinedTableDecompressor& decompressor,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+) {
+    size_t num_matches = 0;
+
+    Message compressed_msg;
+    string decompressed_msg;
+    auto const& logtype_table_manager = archive.get_logtype_table_manager();
+    logtype_table_manager.open_combined_table(table_id, combined_table, decompressor);
+    auto const& logtype_order = logtype_table_manager.get_combined_order().at(table_id);
+    for (auto const& logtype_id : logtype_order) {
+        // load the logtype id
+        logtype_table_manager.load_logtype_table_from_combine(
+                logtype_id,
+                combined_table,
+                decompressor
+        );
+        auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
+        compressed_msg.resize_var(num_vars);
+        compressed_msg.set_logtype_id(logtype_id);
+        while (num_matches < limit) {
+            // Find matching message
+            bool found_message = combined_table.get_next_message(compressed_msg);
+            if (!found_message) {
+                break;
+            }
+            if (!query.timestamp_is_in_search_time_range(compressed_msg.get_ts_in_milli())) {
+                continue;
+            }
+            bool decompress_successful = archive.decompress_message_with_fixed_timestamp_pattern(
+                    compressed_msg,
+                    decompressed_msg
+            );
+            if (!decompress_successful) {
+                break;
+            }
+            // Perform wildcard match if required
+            // In this execution branch, subqueries should not exist
+            // So just check if the search string is not a match-all
+            if (query.search_string_matches_all() == false) {
+                bool matched = wildcard_match_unsafe(
+                        decompressed_msg,
+                        query.get_search_string(),
+                        query.get_ignore_case() == false
+                );
+                if (!matched) {
+                    continue;
+                }
+            }
+            std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
+            // Print match
+            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            ++num_matches;
+        }
+        combined_table.close_logtype_table();
+    }
+    combined_table.close();
+    decompressor.close();
+    return num_matches;
+}
+
+void buffer_result(
+        string const& orig_file_path,
+        Message const& compressed_msg,
+        string const& decompressed_msg,
+        void* custom_arg
+) {
+    static_cast<vector<BufferedResult>*>(custom_arg)
+            ->push_back({orig_file_path, compressed_msg, decompressed_msg});
+}
+
+size_t run_table_scan_tasks(
+        vector<TableScanTask> const& tasks,
+        size_t num_threads,
+        size_t limit,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+) {
+    num_threads = std::min(num_threads, tasks.size());
+    if (num_threads <= 1) {
+        // Nothing to parallelize, so output results directly
+        size_t num_matches = 0;
+        TableScanState state;
+        for (auto const& task : tasks) {
+            if (num_matches >= limit) {
+                break;
+            }
+            num_matches += task(state, limit - num_matches, output_func, output_func_arg);
+        }
+        return num_matches;
+    }
+
+    struct TaskResult {
+        vector<BufferedResult> results;
+        std::exception_ptr exception;
+        bool done{false};
+    };
+    vector<TaskResult> task_results(tasks.size());
+    std::mutex task_results_mutex;
+    std::condition_variable task_done_cv;
+    std::atomic_size_t next_task_ix{0};
+    std::atomic_bool stop{false};
+
+    auto scan_tables = [&]() {
+        TableScanState state;
+        while (false == stop) {
+            auto const task_ix = next_task_ix++;
+            if (task_ix >= tasks.size()) {
+                break;
+            }
+            // Each scan can only be limited by the overall limit since the number of results
+            // output by earlier scans isn't known yet
+            vector<BufferedResult> results;
+            std::exception_ptr exception;
+            try {
+                tasks[task_ix](state, limit, buffer_result, &results);
+            } catch (...) {
+                exception = std::current_exception();
+                stop = true;
+            }
+            {
+                std::lock_guard<std::mutex> lock(task_results_mutex);
+                auto& task_result = task_results[task_ix];
+                task_result.results = std::move(results);
+                task_result.exception = exception;
+                task_result.done = true;
+            }
+            task_done_cv.notify_all();
+        }
+    };
+    vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(scan_tables);
+    }
+
+    // Output the results of each scan once it and all earlier scans are done. Since scans are
+    // claimed in order, every scan up to the first failed one is guaranteed to complete.
+    size_t num_matches = 0;
+    std::exception_ptr exception;
+    for (size_t task_ix = 0; task_ix < tasks.size() && num_matches < limit; ++task_ix) {
+        vector<BufferedResult> results;
+        {
+            std::unique_lock<std::mutex> lock(task_results_mutex);
+            auto& task_result = task_results[task_ix];
+            task_done_cv.wait(lock, [&task_result]() { return task_result.done; });
+            results = std::move(task_result.results);
+            exception = task_result.exception;
+        }
+        if (nullptr != exception) {
+            break;
+        }
+        for (auto const& result : results) {
+            if (num_matches >= limit) {
+                break;
+            }
+            output_func(
+                    result.orig_file_path,
+                    result.compressed_msg,
+                    result.decompressed_msg,
+                    output_func_arg
+            );
+            ++num_matches;
+        }
+    }
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (nullptr != exception) {
+        std::rethrow_exception(exception);
+    }
+    return num_matches;
+}
 }  // namespace
 
 std::optional<Query> Grep::process_raw_query(
@@ -931,53 +1470,22 @@ size_t Grep::output_message_in_segment_within_time_range(
 ) {
     size_t num_matches = 0;
 
-    Message compressed_msg;
-    string decompressed_msg;
-
     // Get the correct order of looping through logtypes
     auto& logtype_table_manager = archive.get_logtype_table_manager();
     auto const& logtype_order = logtype_table_manager.get_single_order();
     for (auto const& logtype_id : logtype_order) {
-        logtype_table_manager.open_logtype_table(logtype_id);
-        logtype_table_manager.load_all();
-        auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
-        compressed_msg.resize_var(num_vars);
-        compressed_msg.set_logtype_id(logtype_id);
-        while (num_matches < limit) {
-            // Find matching message
-            bool found_message = archive.get_next_message_in_logtype_table(compressed_msg);
-            if (!found_message) {
-                break;
-            }
-            if (!query.timestamp_is_in_search_time_range(compressed_msg.get_ts_in_milli())) {
-                continue;
-            }
-            bool decompress_successful = archive.decompress_message_with_fixed_timestamp_pattern(
-                    compressed_msg,
-                    decompressed_msg
-            );
-            if (!decompress_successful) {
-                break;
-            }
-            // Perform wildcard match if required
-            // In this branch, subqueries should not exist
-            // So just check if the search string is not a match-all
-            if (query.search_string_matches_all() == false) {
-                bool matched = wildcard_match_unsafe(
-                        decompressed_msg,
-                        query.get_search_string(),
-                        query.get_ignore_case() == false
-                );
-                if (!matched) {
-                    continue;
-                }
-            }
-            std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
-            // Print match
-            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
-            ++num_matches;
+        if (num_matches >= limit) {
+            break;
         }
-        logtype_table_manager.close_logtype_table();
+        num_matches += output_logtype_table_within_time_range(
+                logtype_id,
+                query,
+                limit - num_matches,
+                archive,
+                logtype_table_manager.logtype_table(),
+                output_func,
+                output_func_arg
+        );
     }
     return num_matches;
 }
@@ -991,64 +1499,82 @@ size_t Grep::output_message_in_combined_segment_within_time_range(
 ) {
     size_t num_matches = 0;
 
-    Message compressed_msg;
-    string decompressed_msg;
     auto& logtype_table_manager = archive.get_logtype_table_manager();
     size_t combined_table_count = logtype_table_manager.get_combined_table_count();
-    auto const& combined_logtype_order = logtype_table_manager.get_combined_order();
-    auto& combined_tables = logtype_table_manager.combined_tables();
     for (size_t table_ix = 0; table_ix < combined_table_count; table_ix++) {
-        // load the combined table
-        logtype_table_manager.open_combined_table(table_ix);
-        auto const& logtype_order = combined_logtype_order.at(table_ix);
-
-        for (auto const& logtype_id : logtype_order) {
-            // load the logtype id
-            logtype_table_manager.load_logtype_table_from_combine(logtype_id);
-            auto num_vars
-                    = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
-            compressed_msg.resize_var(num_vars);
-            compressed_msg.set_logtype_id(logtype_id);
-            while (num_matches < limit) {
-                // Find matching message
-                bool found_message = combined_tables.get_next_message(compressed_msg);
-                if (!found_message) {
-                    break;
-                }
-                if (!query.timestamp_is_in_search_time_range(compressed_msg.get_ts_in_milli())) {
-                    continue;
-                }
-                bool decompress_successful
-                        = archive.decompress_message_with_fixed_timestamp_pattern(
-                                compressed_msg,
-                                decompressed_msg
-                        );
-                if (!decompress_successful) {
-                    break;
+        if (num_matches >= limit) {
+            break;
+        }
+        num_matches += output_combined_table_within_time_range(
+                table_ix,
+                query,
+                limit - num_matches,
+                archive,
+                logtype_table_manager.combined_tables(),
+                logtype_table_manager.combined_table_decompressor(),
+                output_func,
+                output_func_arg
+        );
+    }
+    return num_matches;
+}
+
+size_t Grep::output_message_in_segment_within_time_range_in_parallel(
+        Query const& query,
+        size_t limit,
+        Archive& archive,
+        size_t num_threads,
+        OutputFunc output_func,
+        void* output_func_arg
+) {
+    auto const& logtype_table_manager = archive.get_logtype_table_manager();
+    auto const& logtype_order = logtype_table_manager.get_single_order();
+    size_t combined_table_count = logtype_table_manager.get_combined_table_count();
+
+    vector<TableScanTask> tasks;
+    tasks.reserve(logtype_order.size() + combined_table_count);
+    for (auto const logtype_id : logtype_order) {
+        tasks.emplace_back(
+                [&, logtype_id](
+                        TableScanState& state,
+                        size_t task_limit,
+                        OutputFunc func,
+                        void* func_arg
+                ) {
+                    return output_logtype_table_within_time_range(
+                            logtype_id,
+                            query,
+                            task_limit,
+                            archive,
+                            state.logtype_table,
+                            func,
+                            func_arg
+                    );
                 }
-                // Perform wildcard match if required
-                // In this execution branch, subqueries should not exist
-                // So just check if the search string is not a match-all
-                if (query.search_string_matches_all() == false) {
-                    bool matched = wildcard_match_unsafe(
-                            decompressed_msg,
-                            query.get_search_string(),
-                            query.get_ignore_case() == false
+        );
+    }
+    for (size_t table_ix = 0; table_ix < combined_table_count; table_ix++) {
+        tasks.emplace_back(
+                [&, table_ix](
+                        TableScanState& state,
+                        size_t task_limit,
+                        OutputFunc func,
+                        void* func_arg
+                ) {
+                    return output_combined_table_within_time_range(
+                            table_ix,
+                            query,
+                            task_limit,
+                            archive,
+                            state.combined_table,
+                            state.combined_table_decompressor,
+                            func,
+                            func_arg
                     );
-                    if (!matched) {
-                        continue;
-                    }
                 }
-                std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
-                // Print match
-                output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
-                ++num_matches;
-            }
-            combined_tables.close_logtype_table();
-        }
-        logtype_table_manager.close_combined_table();
+        );
     }
-    return num_matches;
+    return run_table_scan_tasks(tasks, num_threads, limit, output_func, output_func_arg);
 }
 
 size_t Grep::search_segment_and_output(
@@ -1136,75 +1662,18 @@ size_t Grep::search_combined_table_and_output(
         OutputFunc output_func,
         void* output_func_arg
 ) {
-    size_t num_matches = 0;
-
-    Message compressed_msg;
-    string decompressed_msg;
     auto& logtype_table_manager = archive.get_logtype_table_manager();
-    logtype_table_manager.open_combined_table(table_id);
-    for (auto const& iter : queries) {
-        logtype_dictionary_id_t logtype_id = iter.get_logtype_id();
-        logtype_table_manager.load_logtype_table_from_combine(logtype_id);
-
-        auto const& queries_by_logtype = iter.get_queries();
-
-        // Initialize message
-        auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
-        compressed_msg.resize_var(num_vars);
-        compressed_msg.set_logtype_id(logtype_id);
-
-        size_t left_boundary = 0;
-        size_t right_boundary = num_vars;
-
-        bool required_wild_card;
-        while (num_matches < limit) {
-            // Find matching message
-            bool found_matched = archive.find_message_matching_with_logtype_query_from_combined(
-                    queries_by_logtype,
-                    compressed_msg,
-                    required_wild_card,
-                    query,
-                    left_boundary,
-                    right_boundary
-            );
-            if (found_matched == false) {
-                break;
-            }
-            // Decompress match
-            bool decompress_successful = archive.decompress_message_with_fixed_timestamp_pattern(
-                    compressed_msg,
-                    decompressed_msg
-            );
-            if (!decompress_successful) {
-                break;
-            }
-
-            // Perform wildcard match if required
-            // Check if:
-            // - Sub-query requires wildcard match, or
-            // - no subqueries exist and the search string is not a match-all
-            if ((query.contains_sub_queries() && required_wild_card)
-                || (query.contains_sub_queries() == false
-                    && query.search_string_matches_all() == false))
-            {
-                bool matched = wildcard_match_unsafe(
-                        decompressed_msg,
-                        query.get_search_string(),
-                        query.get_ignore_case() == false
-                );
-                if (!matched) {
-                    continue;
-                }
-            }
-            std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
-            // Print match
-            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
-            ++num_matches;
-        }
-        logtype_table_manager.combined_tables().close_logtype_table();
-    }
-    logtype_table_manager.close_combined_table();
-    return num_matches;
+    return search_combined_table(
+            table_id,
+            queries,
+            query,
+            limit,
+            archive,
+            logtype_table_manager.combined_tables(),
+            logtype_table_manager.combined_table_decompressor(),
+            output_func,
+            output_func_arg
+    );
 }
 
 size_t Grep::search_segment_optimized_and_output(
@@ -1217,62 +1686,80 @@ size_t Grep::search_segment_optimized_and_output(
 ) {
     size_t num_matches = 0;
 
-    Message compressed_msg;
-    string decompressed_msg;
-
     // Go through each logtype
     auto& logtype_table_manager = archive.get_logtype_table_manager();
     for (auto const& query_for_logtype : queries) {
-        // preload the data
-        auto logtype_id = query_for_logtype.get_logtype_id();
-        auto const& sub_queries = query_for_logtype.get_queries();
-        logtype_table_manager.open_logtype_table(logtype_id);
-
-        auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
-
-        size_t left_boundary = 0;
-        size_t right_boundary = num_vars;
-
-        // load timestamps and columns that fall into the ranges.
-        logtype_table_manager.load_ts();
-        logtype_table_manager.load_partial_columns(left_boundary, right_boundary);
-
-        std::vector<size_t> matched_row_ix;
-        std::vector<bool> wildcard_required;
-        // Find matching message
-        archive.find_message_matching_with_logtype_query_optimized(
-                sub_queries,
-                matched_row_ix,
-                wildcard_required,
-                query
-        );
-
-        size_t num_potential_matches = matched_row_ix.size();
-        if (num_potential_matches != 0) {
-            // Decompress match
-            std::vector<epochtime_t> loaded_ts(num_potential_matches);
-            std::vector<file_id_t> loaded_file_id(num_potential_matches);
-            std::vector<encoded_variable_t> loaded_vars(num_potential_matches * num_vars);
-            logtype_table_manager.logtype_table().load_remaining_data_into_vec(
-                    loaded_ts,
-                    loaded_file_id,
-                    loaded_vars,
-                    matched_row_ix
-            );
-            num_matches += archive.decompress_messages_and_output(
-                    logtype_id,
-                    loaded_ts,
-                    loaded_file_id,
-                    loaded_vars,
-                    wildcard_required,
-                    query,
-                    output_func,
-                    output_func_arg
-            );
+        if (num_matches >= limit) {
+            break;
         }
-        logtype_table_manager.close_logtype_table();
+        num_matches += search_logtype_table(
+                query_for_logtype,
+                query,
+                limit - num_matches,
+                archive,
+                logtype_table_manager.logtype_table(),
+                output_func,
+                output_func_arg
+        );
     }
 
     return num_matches;
 }
+
+size_t Grep::search_segment_in_parallel_and_output(
+        std::vector<LogtypeQueries> const& single_table_queries,
+        std::map<combined_table_id_t, std::vector<LogtypeQueries>> const& combined_table_queries,
+        Query const& query,
+        size_t limit,
+        Archive& archive,
+        size_t num_threads,
+        OutputFunc output_func,
+        void* output_func_arg
+) {
+    vector<TableScanTask> tasks;
+    tasks.reserve(single_table_queries.size() + combined_table_queries.size());
+    for (auto const& query_for_logtype : single_table_queries) {
+        tasks.emplace_back(
+                [&](
+                        TableScanState& state,
+                        size_t task_limit,
+                        OutputFunc func,
+                        void* func_arg
+                ) {
+                    return search_logtype_table(
+                            query_for_logtype,
+                            query,
+                            task_limit,
+                            archive,
+                            state.logtype_table,
+                            func,
+                            func_arg
+                    );
+                }
+        );
+    }
+    for (auto const& iter : combined_table_queries) {
+        tasks.emplace_back(
+                [&](
+                        TableScanState& state,
+                        size_t task_limit,
+                        OutputFunc func,
+                        void* func_arg
+                ) {
+                    return search_combined_table(
+                            iter.first,
+                            iter.second,
+                            query,
+                            task_limit,
+                            archive,
+                            state.combined_table,
+                            state.combined_table_decompressor,
+                            func,
+                            func_arg
+                    );
+                }
+        );
+    }
+    return run_table_scan_tasks(tasks, num_threads, limit, output_func, output_func_arg);
+}
 }  // namespace glt
@@ -1,8 +1,10 @@
 #ifndef GLT_GREP_HPP
 #define GLT_GREP_HPP
 
+#include <map>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "Defs.h"
 #include "Query.hpp"
@@ -178,6 +180,29 @@ public:
             OutputFunc output_func,
             void* output_func_arg
     );
+
+    /**
+     * Same as output_message_in_segment_within_time_range followed by
+     * output_message_in_combined_segment_within_time_range, except that the segment's tables are
+     * scanned concurrently using the given number of threads. Results are output in the same order
+     * as the serial methods.
+     * @param query
+     * @param limit
+     * @param archive
+     * @param num_threads
+     * @param output_func Only called from the calling thread
+     * @param output_func_arg
+     * @return Number of matches found
+     * @throw Same as output_message_in_segment_within_time_range
+     */
+    static size_t output_message_in_segment_within_time_range_in_parallel(
+            Query const& query,
+            size_t limit,
+            streaming_archive::reader::Archive& archive,
+            size_t num_threads,
+            OutputFunc output_func,
+            void* output_func_arg
+    );
     /**
      * Searches the segment with the given queries and outputs any results using the given method
      * This method is optimized such that it only scans through columns that are necessary
@@ -200,6 +225,33 @@ public:
             OutputFunc output_func,
             void* output_func_arg
     );
+    /**
+     * Same as search_segment_optimized_and_output for the single tables followed by
+     * search_combined_table_and_output for each combined table, except that the tables are scanned
+     * concurrently using the given number of threads. Results are output in the same order as the
+     * serial methods.
+     * @param single_table_queries
+     * @param combined_table_queries
+     * @param query
+     * @param limit
+     * @param archive
+     * @param num_threads
+     * @param output_func Only called from the calling thread
+     * @param output_func_arg
+     * @return Number of matches found
+     * @throw Same as search_segment_optimized_and_output
+     */
+    static size_t search_segment_in_parallel_and_output(
+            std::vector<LogtypeQueries> const& single_table_queries,
+            std::map<combined_table_id_t, std::vector<LogtypeQueries>> const&
+                    combined_table_queries,
+            Query const& query,
+            size_t limit,
+            streaming_archive::reader::Archive& archive,
+            size_t num_threads,
+            OutputFunc output_func,
+            void* output_func_arg
+    );
     /**
      * Converted a query of class Query into a set of LogtypeQueries, indexed by logtype_id
      * specifically, a Query could have n subqueries, each subquery has a fixed "vars_to_match" and
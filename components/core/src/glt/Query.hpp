@@ -43,6 +43,11 @@ public:
 
     bool is_dict_var() const { return m_is_dict_var; }
 
+    /**
+     * @return The precise variable. Only valid if `is_precise_var()` is true.
+     */
+    encoded_variable_t get_precise_var() const { return m_precise_var; }
+
     VariableDictionaryEntry const* get_var_dict_entry() const { return m_var_dict_entry; }
 
     std::unordered_set<VariableDictionaryEntry const*> const&
@@ -245,6 +250,8 @@ public:
 
     bool get_wildcard_flag() const { return m_wildcard_match_required; }
 
+    std::vector<QueryVar> const& get_vars() const { return m_vars; }
+
 private:
     // Variables
     std::vector<QueryVar> m_vars;
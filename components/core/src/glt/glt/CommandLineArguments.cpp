@@ -407,6 +407,12 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                     "ignore-case,i",
                     po::bool_switch(&m_ignore_case),
                     "Ignore case distinctions in both WILDCARD STRING and the input files"
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_threads),
+                    "Number of threads used to scan each segment's logtype tables"
             );
 
             // Define visible options
@@ -483,6 +489,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                 throw invalid_argument("Wildcard string not specified or empty.");
             }
 
+            if (m_num_threads < 1) {
+                throw invalid_argument("num-threads must be non-zero.");
+            }
+
             // Validate timestamp range and compute m_search_begin_ts and m_search_end_ts
             if (parsed_command_line_options.count("teq")) {
                 if (parsed_command_line_options.count("tgt")
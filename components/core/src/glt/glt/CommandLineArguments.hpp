@@ -37,6 +37,7 @@ public:
               m_compression_level(3),
               m_combine_threshold(0.1),
               m_ignore_case(false),
+              m_num_threads(1),
               m_output_method(OutputMethod::StdoutText),
               m_search_begin_ts(cEpochTimeMin),
               m_search_end_ts(cEpochTimeMax) {}
@@ -85,6 +86,8 @@ public:
 
     std::string const& get_file_path() const { return m_file_path; }
 
+    size_t get_num_threads() const { return m_num_threads; }
+
     OutputMethod get_output_method() const { return m_output_method; }
 
     epochtime_t get_search_begin_ts() const { return m_search_begin_ts; }
@@ -119,6 +122,7 @@ private:
     bool m_ignore_case;
     std::string m_search_string;
     std::string m_file_path;
+    size_t m_num_threads;
     OutputMethod m_output_method;
     epochtime_t m_search_begin_ts, m_search_end_ts;
 };
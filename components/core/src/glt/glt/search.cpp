@@ -49,13 +49,15 @@ static bool open_archive(string const& archive_path, Archive& archive_reader);
  * @param output_method
  * @param archive
  * @param segment_id
+ * @param num_threads Number of threads used to scan the segment's tables
  * @return The total number of matches found across all files
  */
 static size_t search_segments(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod output_method,
         Archive& archive,
-        size_t segment_id
+        size_t segment_id,
+        size_t num_threads
 );
 /**
  * get all messages in the segment within query's time range
@@ -63,13 +65,14 @@ static size_t search_segments(
  * @param query
  * @param output_method
  * @param archive
- * @param segment_id
+ * @param num_threads Number of threads used to scan the segment's tables
  * @return The total number of matches found across all files
  */
 static size_t find_message_in_segment_within_time_range(
         Query const& query,
         CommandLineArguments::OutputMethod output_method,
-        Archive& archive
+        Archive& archive,
+        size_t num_threads
 );
 /**
  * Prints search result to stdout in text format
@@ -245,7 +248,8 @@ static bool search(
                     num_matches += find_message_in_segment_within_time_range(
                             query,
                             command_line_args.get_output_method(),
-                            archive
+                            archive,
+                            command_line_args.get_num_threads()
                     );
                     archive.close_logtype_table_manager();
                 }
@@ -256,7 +260,8 @@ static bool search(
                             queries,
                             command_line_args.get_output_method(),
                             archive,
-                            segment_id
+                            segment_id,
+                            command_line_args.get_num_threads()
                     );
                     archive.close_logtype_table_manager();
                 }
@@ -292,7 +297,8 @@ static bool search(
 static size_t find_message_in_segment_within_time_range(
         Query const& query,
         CommandLineArguments::OutputMethod const output_method,
-        Archive& archive
+        Archive& archive,
+        size_t const num_threads
 ) {
     size_t num_matches = 0;
 
@@ -312,6 +318,16 @@ static size_t find_message_in_segment_within_time_range(
             SPDLOG_ERROR("Unknown output method - {}", (char)output_method);
             return num_matches;
     }
+    if (num_threads > 1) {
+        return Grep::output_message_in_segment_within_time_range_in_parallel(
+                query,
+                SIZE_MAX,
+                archive,
+                num_threads,
+                output_func,
+                output_func_arg
+        );
+    }
     num_matches = Grep::output_message_in_segment_within_time_range(
             query,
             SIZE_MAX,
@@ -333,7 +349,8 @@ static size_t search_segments(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod const output_method,
         Archive& archive,
-        size_t segment_id
+        size_t segment_id,
+        size_t const num_threads
 ) {
     size_t num_matches = 0;
 
@@ -371,8 +388,22 @@ static size_t search_segments(
                 combined_table_queires
         );
 
+        if (num_threads > 1) {
+            num_matches += Grep::search_segment_in_parallel_and_output(
+                    single_table_queries,
+                    combined_table_queires,
+                    query,
+                    SIZE_MAX,
+                    archive,
+                    num_threads,
+                    output_func,
+                    output_func_arg
+            );
+            continue;
+        }
+
         // first search through the single variable table
-        num_matches += Grep::search_segment_and_output(
+        num_matches += Grep::search_segment_optimized_and_output(
                 single_table_queries,
                 query,
                 SIZE_MAX,
@@ -2,8 +2,12 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 #include <boost/filesystem.hpp>
@@ -340,7 +344,26 @@ bool Archive::find_message_matching_with_logtype_query_from_combined(
         size_t left_boundary,
         size_t right_boundary
 ) {
-    auto& combined_tables = m_logtype_table_manager.combined_tables();
+    return find_message_matching_with_logtype_query_from_combined(
+            m_logtype_table_manager.combined_tables(),
+            logtype_query,
+            msg,
+            wildcard,
+            query,
+            left_boundary,
+            right_boundary
+    );
+}
+
+bool Archive::find_message_matching_with_logtype_query_from_combined(
+        CombinedLogtypeTable& combined_tables,
+        std::vector<LogtypeQuery> const& logtype_query,
+        Message& msg,
+        bool& wildcard,
+        Query const& query,
+        size_t left_boundary,
+        size_t right_boundary
+) const {
     while (true) {
         // break if there's no next message
         if (!combined_tables.get_next_message_partial(msg, left_boundary, right_boundary)) {
@@ -394,27 +417,71 @@ void Archive::find_message_matching_with_logtype_query_optimized(
         std::vector<bool>& wildcard,
         Query const& query
 ) {
-    epochtime_t ts;
-    auto& logtype_table = m_logtype_table_manager.logtype_table();
-    size_t num_row = logtype_table.get_num_row();
-    size_t num_column = logtype_table.get_num_column();
-    std::vector<encoded_variable_t> vars_to_load(num_column);
-    for (size_t row_ix = 0; row_ix < num_row; row_ix++) {
-        m_logtype_table_manager.peek_next_ts(ts);
-        if (query.timestamp_is_in_search_time_range(ts)) {
-            // that means we need to loop through every loop. that takes time.
-            for (auto const& possible_sub_query : logtype_query) {
-                logtype_table.get_next_row(vars_to_load, 0, num_column);
-                if (possible_sub_query.matches_vars(vars_to_load)) {
-                    // Message matches completely, so set remaining properties
-                    wildcard.push_back(possible_sub_query.get_wildcard_flag());
-                    matched_rows.push_back(row_ix);
-                    // don't need to look into other sub-queries as long as there is a match
-                    break;
-                }
-            }
+    find_message_matching_with_logtype_query_optimized(
+            m_logtype_table_manager.logtype_table(),
+            logtype_query,
+            matched_rows,
+            wildcard,
+            query
+    );
+}
+
+void Archive::find_message_matching_with_logtype_query_optimized(
+        LogtypeTable& logtype_table,
+        std::vector<LogtypeQuery> const& logtype_query,
+        std::vector<size_t>& matched_rows,
+        std::vector<bool>& wildcard,
+        Query const& query
+) const {
+    std::vector<size_t> unmatched_rows;
+    logtype_table.find_rows_in_time_range(
+            query.get_search_begin_timestamp(),
+            query.get_search_end_timestamp(),
+            unmatched_rows
+    );
+    if (unmatched_rows.empty()) {
+        return;
+    }
+
+    // Since a row is matched by the first sub-query that matches it, each sub-query only needs to
+    // be evaluated on the rows that no earlier sub-query matched.
+    constexpr int8_t cUnmatched{-1};
+    std::vector<int8_t> row_wildcard_flags(logtype_table.get_num_row(), cUnmatched);
+    auto const candidate_rows = unmatched_rows;
+    std::vector<size_t> sub_query_matched_rows;
+    std::vector<size_t> remaining_rows;
+    for (auto const& possible_sub_query : logtype_query) {
+        logtype_table.find_rows_matching_vars(
+                possible_sub_query.get_vars(),
+                unmatched_rows,
+                sub_query_matched_rows
+        );
+        if (sub_query_matched_rows.empty()) {
+            continue;
+        }
+        auto const wildcard_flag = static_cast<int8_t>(possible_sub_query.get_wildcard_flag());
+        for (auto const row_ix : sub_query_matched_rows) {
+            row_wildcard_flags[row_ix] = wildcard_flag;
+        }
+        remaining_rows.clear();
+        std::set_difference(
+                unmatched_rows.cbegin(),
+                unmatched_rows.cend(),
+                sub_query_matched_rows.cbegin(),
+                sub_query_matched_rows.cend(),
+                std::back_inserter(remaining_rows)
+        );
+        std::swap(unmatched_rows, remaining_rows);
+        if (unmatched_rows.empty()) {
+            break;
+        }
+    }
+
+    for (auto const row_ix : candidate_rows) {
+        if (cUnmatched != row_wildcard_flags[row_ix]) {
+            matched_rows.push_back(row_ix);
+            wildcard.push_back(1 == row_wildcard_flags[row_ix]);
         }
-        m_logtype_table_manager.skip_row();
     }
 }
 
@@ -425,17 +492,21 @@ size_t Archive::decompress_messages_and_output(
         std::vector<encoded_variable_t>& vars,
         std::vector<bool>& wildcard_required,
         Query const& query,
+        size_t limit,
         OutputFunc output_func,
         void* output_func_arg
-) {
+) const {
     auto const& logtype_entry = m_logtype_dictionary.get_entry(logtype_id);
     size_t num_vars = logtype_entry.get_num_variables();
     size_t const total_matches = wildcard_required.size();
     std::string decompressed_msg;
-    // The sole purpose of this dummy message is to call output func
-    Message dummy_compressed_msg;
+    Message compressed_msg;
+    compressed_msg.set_logtype_id(logtype_id);
+    compressed_msg.resize_var(num_vars);
+    std::string const fixed_timestamp_pattern = "%Y-%m-%d %H:%M:%S,%3";
+    TimestampPattern const ts_pattern(0, fixed_timestamp_pattern);
     size_t matches = 0;
-    for (size_t ix = 0; ix < total_matches; ix++) {
+    for (size_t ix = 0; ix < total_matches && matches < limit; ix++) {
         decompressed_msg.clear();
 
         // first decompress the message with fixed time stamp
@@ -456,8 +527,6 @@ size_t Archive::decompress_messages_and_output(
             throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
         }
         if (ts[ix] != 0) {
-            std::string const fixed_timestamp_pattern = "%Y-%m-%d %H:%M:%S,%3";
-            TimestampPattern ts_pattern(0, fixed_timestamp_pattern);
             ts_pattern.insert_formatted_timestamp(ts[ix], decompressed_msg);
         }
         // Perform wildcard match if required
@@ -478,9 +547,12 @@ size_t Archive::decompress_messages_and_output(
             }
         }
         matches++;
+        compressed_msg.set_timestamp(ts[ix]);
+        compressed_msg.set_file_id(id[ix]);
+        compressed_msg.load_vars_from(vars, num_vars, vars_offset);
         std::string const& orig_file_path = get_file_name(id[ix]);
         // Print match
-        output_func(orig_file_path, dummy_compressed_msg, decompressed_msg, output_func_arg);
+        output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
     }
     return matches;
 }
@@ -488,7 +560,7 @@ size_t Archive::decompress_messages_and_output(
 bool Archive::decompress_message_with_fixed_timestamp_pattern(
         Message const& compressed_msg,
         std::string& decompressed_msg
-) {
+) const {
     decompressed_msg.clear();
 
     // Build original message content
@@ -154,17 +154,16 @@ public:
             Query const& query
     );
     /**
-     * This functions assumes a specific logtype is loaded with m_variable_column_manager.
-     * The function takes in all logtype_query associated with the logtype,
-     * and finds next matching message in the 2D variable table
+     * This functions assumes a specific logtype table is open with its timestamps loaded.
+     * The function takes in all logtype_query associated with the logtype, and finds all matching
+     * rows in the table by evaluating the queries column-wise (see
+     * LogtypeTable::find_rows_matching_vars). Each row is matched by the first query that matches
+     * it.
      *
      * @param logtype_query
-     * @param matched_rows,
-     * @param wildcard (by reference)
+     * @param matched_rows Returns the indices of the matching rows, in ascending order
+     * @param wildcard Returns, for each matching row, whether it still requires wildcard match
      * @param query (to provide time range info)
-     * @return Return true if a matching message is found. wildcard gets set to true if the matching
-     * message still requires wildcard match
-     * @throw Same as streaming_archive::reader::File::open_me
      */
     void find_message_matching_with_logtype_query_optimized(
             std::vector<LogtypeQuery> const& logtype_query,
@@ -172,6 +171,22 @@ public:
             std::vector<bool>& wildcard,
             Query const& query
     );
+    /**
+     * Same as above, except it searches the given table rather than the one loaded with the
+     * logtype table manager
+     * @param logtype_table
+     * @param logtype_query
+     * @param matched_rows
+     * @param wildcard
+     * @param query
+     */
+    void find_message_matching_with_logtype_query_optimized(
+            LogtypeTable& logtype_table,
+            std::vector<LogtypeQuery> const& logtype_query,
+            std::vector<size_t>& matched_rows,
+            std::vector<bool>& wildcard,
+            Query const& query
+    ) const;
     bool find_message_matching_with_logtype_query_from_combined(
             std::vector<LogtypeQuery> const& logtype_query,
             Message& msg,
@@ -180,6 +195,27 @@ public:
             size_t left,
             size_t right
     );
+    /**
+     * Same as above, except it searches the given combined table rather than the one loaded with
+     * the logtype table manager
+     * @param combined_table
+     * @param logtype_query
+     * @param msg
+     * @param wildcard
+     * @param query
+     * @param left
+     * @param right
+     * @return Same as above
+     */
+    bool find_message_matching_with_logtype_query_from_combined(
+            CombinedLogtypeTable& combined_table,
+            std::vector<LogtypeQuery> const& logtype_query,
+            Message& msg,
+            bool& wildcard,
+            Query const& query,
+            size_t left,
+            size_t right
+    ) const;
 
     /**
      * This functions assumes a specific logtype is loaded with m_variable_column_manager.
@@ -207,10 +243,29 @@ public:
         return m_logtype_table_manager;
     }
 
+    streaming_archive::reader::SingleLogtypeTableManager const& get_logtype_table_manager() const {
+        return m_logtype_table_manager;
+    }
+
     void open_logtype_table_manager(size_t segment_id);
     void close_logtype_table_manager();
 
     // Message decompression methods
+    // NOTE: These methods only read the archive's dictionaries, so they can be called concurrently.
+    /**
+     * Decompresses the given messages of a logtype using a fixed timestamp pattern, performs
+     * wildcard match where required, and outputs the messages that match
+     * @param logtype_id
+     * @param ts
+     * @param id
+     * @param vars The messages' variables, stored row by row
+     * @param wildcard_required
+     * @param query
+     * @param limit Maximum number of matches to output
+     * @param output_func
+     * @param output_func_arg
+     * @return The number of matches output
+     */
     size_t decompress_messages_and_output(
             logtype_dictionary_id_t logtype_id,
             std::vector<epochtime_t>& ts,
@@ -218,9 +273,10 @@ public:
             std::vector<encoded_variable_t>& vars,
             std::vector<bool>& wildcard_required,
             Query const& query,
+            size_t limit,
             OutputFunc output_func,
             void* output_func_arg
-    );
+    ) const;
     /**
      * Decompresses a given message using a fixed timestamp pattern
      * @param file
@@ -232,7 +288,7 @@ public:
     bool decompress_message_with_fixed_timestamp_pattern(
             Message const& compressed_msg,
             std::string& decompressed_msg
-    );
+    ) const;
 
 private:
     // Variables
@@ -1,9 +1,56 @@
 #include "LogtypeTable.hpp"
 
+// C++ libraries
+#include <algorithm>
+#include <cstdint>
+
 // Boost libraries
 #include <boost/filesystem.hpp>
 
 namespace glt::streaming_archive::reader {
+namespace {
+/**
+ * Keeps the rows whose value in the given column matches the given query variable.
+ * @param query_var
+ * @param column
+ * @param rows
+ * @param num_rows
+ * @return The number of rows kept, which are compacted (in order) to the front of `rows`.
+ */
+size_t filter_rows(
+        QueryVar const& query_var,
+        encoded_variable_t const* column,
+        size_t* rows,
+        size_t num_rows
+);
+
+size_t filter_rows(
+        QueryVar const& query_var,
+        encoded_variable_t const* column,
+        size_t* rows,
+        size_t num_rows
+) {
+    size_t num_kept = 0;
+    if (query_var.is_precise_var()) {
+        // Compact the rows without branching on the comparison, so that the loop is unaffected by
+        // how (un)predictable the matches are.
+        auto const precise_var = query_var.get_precise_var();
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto const row_ix = rows[i];
+            rows[num_kept] = row_ix;
+            num_kept += static_cast<size_t>(column[row_ix] == precise_var);
+        }
+    } else {
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto const row_ix = rows[i];
+            rows[num_kept] = row_ix;
+            num_kept += static_cast<size_t>(query_var.matches(column[row_ix]));
+        }
+    }
+    return num_kept;
+}
+}  // namespace
+
 void LogtypeTable::open_and_load_all(char const* buffer, LogtypeMetadata const& metadata) {
     open(buffer, metadata);
     load_all();
@@ -154,6 +201,118 @@ void LogtypeTable::load_remaining_data_into_vec(
     load_vars_into_vec(vars, potential_matched_row);
 }
 
+void LogtypeTable::find_rows_in_time_range(
+        epochtime_t begin_ts,
+        epochtime_t end_ts,
+        std::vector<size_t>& matched_rows
+) const {
+    matched_rows.resize(m_num_row);
+    size_t num_matched = 0;
+    for (size_t row_ix = 0; row_ix < m_num_row; ++row_ix) {
+        auto const ts = m_timestamps[row_ix];
+        matched_rows[num_matched] = row_ix;
+        num_matched += static_cast<size_t>(begin_ts <= ts && ts <= end_ts);
+    }
+    matched_rows.resize(num_matched);
+}
+
+void LogtypeTable::find_rows_matching_vars(
+        std::vector<QueryVar> const& query_vars,
+        std::vector<size_t> const& candidate_rows,
+        std::vector<size_t>& matched_rows
+) {
+    matched_rows = candidate_rows;
+    size_t const num_query_vars = query_vars.size();
+    if (num_query_vars > m_num_columns) {
+        // Not enough variables to satisfy the query
+        matched_rows.clear();
+        return;
+    }
+
+    size_t num_rows = matched_rows.size();
+    if (num_query_vars == m_num_columns) {
+        // Every query variable must match the column at the same index, so each column is a
+        // simple filter over the remaining rows.
+        for (size_t column_ix = 0; column_ix < m_num_columns && num_rows > 0; ++column_ix) {
+            if (false == m_column_loaded[column_ix]) {
+                load_column(column_ix);
+            }
+            num_rows = filter_rows(
+                    query_vars[column_ix],
+                    &m_column_based_variables[column_ix * m_num_row],
+                    matched_rows.data(),
+                    num_rows
+            );
+        }
+        matched_rows.resize(num_rows);
+        return;
+    }
+
+    // Otherwise, track how many query variables each row has matched so far. Like
+    // LogtypeQuery::matches_vars, each column is greedily matched against the next unmatched
+    // query variable.
+    std::vector<uint32_t> num_matched_query_vars(num_rows, 0);
+    // When all query variables are precise, matching is a comparison against the next unmatched
+    // variable, which can be done without branching. The extra trailing value is never matched
+    // since rows that matched every query variable are excluded from the comparison.
+    bool const all_query_vars_precise = std::all_of(
+            query_vars.cbegin(),
+            query_vars.cend(),
+            [](QueryVar const& query_var) { return query_var.is_precise_var(); }
+    );
+    std::vector<encoded_variable_t> precise_query_vars(num_query_vars + 1, 0);
+    if (all_query_vars_precise) {
+        std::transform(
+                query_vars.cbegin(),
+                query_vars.cend(),
+                precise_query_vars.begin(),
+                [](QueryVar const& query_var) { return query_var.get_precise_var(); }
+        );
+    }
+    for (size_t column_ix = 0; column_ix < m_num_columns && num_rows > 0; ++column_ix) {
+        if (false == m_column_loaded[column_ix]) {
+            load_column(column_ix);
+        }
+        auto const* column = &m_column_based_variables[column_ix * m_num_row];
+
+        // After this column, a row can only match if it has matched enough query variables to
+        // match the rest with the remaining columns.
+        size_t const num_remaining_columns = m_num_columns - column_ix - 1;
+        size_t const min_num_matched = num_query_vars > num_remaining_columns
+                                               ? num_query_vars - num_remaining_columns
+                                               : 0;
+        size_t num_kept = 0;
+        if (all_query_vars_precise) {
+            for (size_t i = 0; i < num_rows; ++i) {
+                auto const row_ix = matched_rows[i];
+                size_t num_matched = num_matched_query_vars[i];
+                num_matched += static_cast<size_t>(
+                        (num_matched < num_query_vars)
+                        & (column[row_ix] == precise_query_vars[num_matched])
+                );
+                matched_rows[num_kept] = row_ix;
+                num_matched_query_vars[num_kept] = static_cast<uint32_t>(num_matched);
+                num_kept += static_cast<size_t>(num_matched >= min_num_matched);
+            }
+        } else {
+            for (size_t i = 0; i < num_rows; ++i) {
+                auto const row_ix = matched_rows[i];
+                size_t num_matched = num_matched_query_vars[i];
+                if (num_matched < num_query_vars) {
+                    num_matched += static_cast<size_t>(
+                            query_vars[num_matched].matches(column[row_ix])
+                    );
+                }
+                matched_rows[num_kept] = row_ix;
+                num_matched_query_vars[num_kept] = static_cast<uint32_t>(num_matched);
+                num_kept += static_cast<size_t>(num_matched >= min_num_matched);
+            }
+        }
+        num_rows = num_kept;
+    }
+    matched_rows.resize(num_rows);
+}
+
 void LogtypeTable::load_timestamp() {
     m_timestamps.resize(m_num_row);
     size_t num_bytes_read = 0;
@@ -10,6 +10,7 @@
 // Project headers
 #include "../../Defs.h"
 #include "../../ErrorCode.hpp"
+#include "../../Query.hpp"
 #include "../../streaming_compression/passthrough/Decompressor.hpp"
 #include "../../streaming_compression/zstd/Decompressor.hpp"
 #include "LogtypeMetadata.hpp"
@@ -74,6 +75,38 @@ public:
             std::vector<size_t> const& potential_matched_row
     );
 
+    /**
+     * Finds the rows whose timestamp is in the given time range (begin and end inclusive). The
+     * timestamps must have been loaded.
+     * @param begin_ts
+     * @param end_ts
+     * @param matched_rows Returns the indices of the matching rows, in ascending order
+     */
+    void find_rows_in_time_range(
+            epochtime_t begin_ts,
+            epochtime_t end_ts,
+            std::vector<size_t>& matched_rows
+    ) const;
+
+    /**
+     * Finds the rows, among the given candidate rows, whose variables contain the given query
+     * variables in order (but not necessarily contiguously), i.e., the rows that
+     * LogtypeQuery::matches_vars would match.
+     *
+     * Rather than assembling each row, the query variables are evaluated one column at a time
+     * over the remaining candidates, and rows that can no longer match are dropped after each
+     * column. Columns are loaded on demand, so columns after the last remaining candidate is
+     * dropped are never decompressed.
+     * @param query_vars
+     * @param candidate_rows Row indices, in ascending order
+     * @param matched_rows Returns the indices of the matching rows, in ascending order
+     */
+    void find_rows_matching_vars(
+            std::vector<QueryVar> const& query_vars,
+            std::vector<size_t> const& candidate_rows,
+            std::vector<size_t>& matched_rows
+    );
+
     /**
      * Get row in the loaded 2D variable columns with row_index = offset
      * @param msg
@@ -13,11 +13,25 @@ void SingleLogtypeTableManager::open_logtype_table(logtype_dictionary_id_t logty
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
     }
 
-    auto const& logtype_metadata = m_logtype_table_metadata[logtype_id];
-    m_logtype_table.open(m_memory_mapped_segment_file.data(), logtype_metadata);
+    open_logtype_table(logtype_id, m_logtype_table);
     m_logtype_table_loaded = true;
 }
 
+void SingleLogtypeTableManager::open_logtype_table(
+        logtype_dictionary_id_t logtype_id,
+        LogtypeTable& logtype_table
+) const {
+    if (!m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+    auto const metadata_it = m_logtype_table_metadata.find(logtype_id);
+    if (m_logtype_table_metadata.cend() == metadata_it) {
+        SPDLOG_ERROR("logtype id {} doesn't have a single table", logtype_id);
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+    logtype_table.open(m_memory_mapped_segment_file.data(), metadata_it->second);
+}
+
 void SingleLogtypeTableManager::close_logtype_table() {
     m_logtype_table.close();
     m_logtype_table_loaded = false;
@@ -48,11 +62,28 @@ void SingleLogtypeTableManager::load_ts() {
 }
 
 void SingleLogtypeTableManager::open_combined_table(combined_table_id_t table_id) {
-    char const* compressed_stream_ptr
-            = m_memory_mapped_segment_file.data() + m_combined_table_info[table_id].m_begin_offset;
-    size_t compressed_stream_size = m_combined_table_info[table_id].m_size;
-    m_combined_table_decompressor.open(compressed_stream_ptr, compressed_stream_size);
-    m_combined_tables.open(table_id);
+    open_combined_table(table_id, m_combined_tables, m_combined_table_decompressor);
+}
+
+void SingleLogtypeTableManager::open_combined_table(
+        combined_table_id_t table_id,
+        CombinedLogtypeTable& combined_table,
+        CombinedTableDecompressor& decompressor
+) const {
+    if (!m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+    auto const table_info_it = m_combined_table_info.find(table_id);
+    if (m_combined_table_info.cend() == table_info_it) {
+        SPDLOG_ERROR("combined table {} doesn't exist", table_id);
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+    auto const& table_info = table_info_it->second;
+    decompressor.open(
+            m_memory_mapped_segment_file.data() + table_info.m_begin_offset,
+            table_info.m_size
+    );
+    combined_table.open(table_id);
 }
 
 void SingleLogtypeTableManager::close_combined_table() {
@@ -63,11 +94,15 @@ void SingleLogtypeTableManager::close_combined_table() {
 void SingleLogtypeTableManager::load_logtype_table_from_combine(
         logtype_dictionary_id_t logtype_id
 ) {
-    m_combined_tables.load_logtype_table(
-            logtype_id,
-            m_combined_table_decompressor,
-            m_combined_tables_metadata
-    );
+    load_logtype_table_from_combine(logtype_id, m_combined_tables, m_combined_table_decompressor);
+}
+
+void SingleLogtypeTableManager::load_logtype_table_from_combine(
+        logtype_dictionary_id_t logtype_id,
+        CombinedLogtypeTable& combined_table,
+        CombinedTableDecompressor& decompressor
+) const {
+    combined_table.load_logtype_table(logtype_id, decompressor, m_combined_tables_metadata);
 }
 
 // rearrange queries to separate them into single table and combined table ones.
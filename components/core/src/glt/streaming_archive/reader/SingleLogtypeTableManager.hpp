@@ -11,11 +11,54 @@
 namespace glt::streaming_archive::reader {
 class SingleLogtypeTableManager : public streaming_archive::reader::LogtypeTableManager {
 public:
+    // Types
+#if USE_PASSTHROUGH_COMPRESSION
+    using CombinedTableDecompressor = streaming_compression::passthrough::Decompressor;
+#elif USE_ZSTD_COMPRESSION
+    using CombinedTableDecompressor = streaming_compression::zstd::Decompressor;
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+
     SingleLogtypeTableManager() : m_logtype_table_loaded(false) {}
 
     void open_logtype_table(logtype_dictionary_id_t logtype_id);
     void close_logtype_table();
 
+    // The following methods open tables owned by the caller rather than the manager, so that
+    // multiple threads can scan different tables of the memory-mapped segment concurrently. Each
+    // thread must use its own tables and decompressor.
+    /**
+     * Opens the given caller-owned table for the given logtype
+     * @param logtype_id
+     * @param logtype_table
+     * @throw OperationFailed if the manager isn't open or the logtype has no single table
+     */
+    void open_logtype_table(logtype_dictionary_id_t logtype_id, LogtypeTable& logtype_table) const;
+    /**
+     * Opens the given caller-owned combined table, reading it with the given decompressor
+     * @param table_id
+     * @param combined_table
+     * @param decompressor
+     * @throw OperationFailed if the manager isn't open or the combined table doesn't exist
+     */
+    void open_combined_table(
+            combined_table_id_t table_id,
+            CombinedLogtypeTable& combined_table,
+            CombinedTableDecompressor& decompressor
+    ) const;
+    /**
+     * Loads the given logtype from a combined table opened with `open_combined_table`
+     * @param logtype_id
+     * @param combined_table
+     * @param decompressor
+     */
+    void load_logtype_table_from_combine(
+            logtype_dictionary_id_t logtype_id,
+            CombinedLogtypeTable& combined_table,
+            CombinedTableDecompressor& decompressor
+    ) const;
+
     void load_all();
     void load_partial_columns(size_t l, size_t r);
     void load_ts();
@@ -39,19 +82,17 @@ public:
 
     CombinedLogtypeTable& combined_tables() { return m_combined_tables; }
 
+    CombinedTableDecompressor& combined_table_decompressor() {
+        return m_combined_table_decompressor;
+    }
+
 private:
     bool m_logtype_table_loaded;
     LogtypeTable m_logtype_table;
     CombinedLogtypeTable m_combined_tables;
 
     // compressor for combined table. try to reuse only one compressor
-#if USE_PASSTHROUGH_COMPRESSION
-    streaming_compression::passthrough::Decompressor m_combined_table_decompressor;
-#elif USE_ZSTD_COMPRESSION
-    streaming_compression::zstd::Decompressor m_combined_table_decompressor;
-#else
-    static_assert(false, "Unsupported compression mode.");
-#endif
+    CombinedTableDecompressor m_combined_table_decompressor;
 };
 }  // namespace glt::streaming_archive::reader
 
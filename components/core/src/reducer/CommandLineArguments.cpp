@@ -46,6 +46,12 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             po::value<int>(&m_upsert_interval)
                 ->default_value(m_upsert_interval),
             "Interval for upserting timeline aggregation results (ms)"
+        )(
+            "num-io-threads",
+            po::value<size_t>(&m_num_io_threads)
+                ->default_value(m_num_io_threads),
+            "Number of threads receiving and aggregating results, each with its own shard of the"
+            " aggregation state"
         );
 
         po::options_description all_options;
@@ -96,6 +102,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
         if (m_upsert_interval <= 0) {
             throw std::invalid_argument("upsert-interval cannot be <= 0.");
         }
+
+        if (0 == m_num_io_threads) {
+            throw std::invalid_argument("num-io-threads cannot be 0.");
+        }
     } catch (std::exception& e) {
         SPDLOG_ERROR("Failed to validate command line arguments - {}", e.what());
         print_basic_usage();
@@ -1,9 +1,11 @@
 #ifndef REDUCER_COUNTOPERATOR_HPP
 #define REDUCER_COUNTOPERATOR_HPP
 
-#include <map>
+#include <cstdint>
 #include <string>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "GroupTags.hpp"
 #include "Operator.hpp"
 
@@ -27,7 +29,7 @@ public:
     ) override;
 
 private:
-    std::map<GroupTags, int64_t> m_group_count;
+    absl::flat_hash_map<GroupTags, int64_t> m_group_count;
 };
 }  // namespace reducer
 
@@ -57,6 +57,11 @@ std::vector<uint8_t> serialize(
                 case ValueType::Double:
                     record[key] = record_it.get().get_double_value(key);
                     break;
+                case ValueType::Binary: {
+                    auto const value = record_it.get().get_binary_value(key);
+                    record[key] = nlohmann::json::binary({value.begin(), value.end()});
+                    break;
+                }
             }
         }
         records.emplace_back(std::move(record));
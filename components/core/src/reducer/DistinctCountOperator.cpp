@@ -0,0 +1,86 @@
+#include "DistinctCountOperator.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "HyperLogLog.hpp"
+#include "RecordGroupIterator.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+namespace {
+constexpr std::array<TypedRecordKey, 2> cResultRecordKeys{
+        TypedRecordKey{DistinctCountOperator::cCountKey, ValueType::Int64},
+        TypedRecordKey{DistinctCountOperator::cSketchKey, ValueType::Binary}
+};
+}  // namespace
+
+void DistinctCountOperator::push_intra_stage_record_group(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it
+) {
+    for (; false == record_it.done(); record_it.next()) {
+        auto partial_sketch = HyperLogLog::deserialize(
+                record_it.get().get_binary_value(static_cast<char const*>(cSketchKey))
+        );
+        if (false == partial_sketch.has_value()) {
+            // Drop malformed sketches
+            continue;
+        }
+        auto [it, inserted] = m_group_sketches.try_emplace(tags, std::move(partial_sketch.value()));
+        if (inserted) {
+            continue;
+        }
+        // NOTE: Sketches with a different precision than the group's sketch can't be merged, so
+        // they're dropped.
+        std::ignore = it->second.merge(partial_sketch.value());
+    }
+}
+
+void DistinctCountOperator::push_inter_stage_record_group(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it
+) {
+    auto& sketch = m_group_sketches[tags];
+
+    for (; false == record_it.done(); record_it.next()) {
+        sketch.add_string(record_it.get().get_string_view(static_cast<char const*>(cValueKey)));
+    }
+}
+
+std::unique_ptr<RecordGroupIterator> DistinctCountOperator::get_stored_result_iterator() {
+    return std::make_unique<MapRecordGroupIterator<HyperLogLog, ResultRecordAdapter>>(
+            m_group_sketches
+    );
+}
+
+void DistinctCountOperator::ResultRecordAdapter::set_record_value(HyperLogLog const& sketch) {
+    m_count = static_cast<int64_t>(sketch.estimate());
+    m_serialized_sketch = sketch.serialize();
+}
+
+int64_t DistinctCountOperator::ResultRecordAdapter::get_int64_value(std::string_view key) const {
+    if (key == static_cast<char const*>(cCountKey)) {
+        return m_count;
+    }
+    return 0;
+}
+
+std::span<uint8_t const>
+DistinctCountOperator::ResultRecordAdapter::get_binary_value(std::string_view key) const {
+    if (key == static_cast<char const*>(cSketchKey)) {
+        return m_serialized_sketch;
+    }
+    return {};
+}
+
+std::unique_ptr<RecordTypedKeyIterator>
+DistinctCountOperator::ResultRecordAdapter::typed_key_iter() const {
+    return std::make_unique<TypedKeyListIterator>(cResultRecordKeys);
+}
+}  // namespace reducer
@@ -0,0 +1,66 @@
+#ifndef REDUCER_DISTINCTCOUNTOPERATOR_HPP
+#define REDUCER_DISTINCTCOUNTOPERATOR_HPP
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "GroupTags.hpp"
+#include "HyperLogLog.hpp"
+#include "Operator.hpp"
+#include "Record.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+/**
+ * Distinct count operator that estimates the number of distinct values per record group using a
+ * HyperLogLog sketch.
+ *
+ * As a combiner, the operator adds the string value of each record's `cValueKey` element to the
+ * group's sketch. As a reducer, it merges the partial sketches in each record's `cSketchKey`
+ * element. Each result record contains the group's estimated distinct count and its sketch, so that
+ * results can be merged further downstream.
+ */
+class DistinctCountOperator : public Operator {
+public:
+    static constexpr char cValueKey[] = "value";
+    static constexpr char cCountKey[] = "count";
+    static constexpr char cSketchKey[] = "sketch";
+
+    void
+    push_intra_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override;
+
+    void
+    push_inter_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override;
+
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator() override;
+
+private:
+    /**
+     * Record adapter which exposes a sketch's estimated distinct count and serialized form.
+     */
+    class ResultRecordAdapter : public Record {
+    public:
+        void set_record_value(HyperLogLog const& sketch);
+
+        [[nodiscard]] int64_t get_int64_value(std::string_view key) const override;
+
+        [[nodiscard]] std::span<uint8_t const> get_binary_value(std::string_view key
+        ) const override;
+
+        [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override;
+
+    private:
+        int64_t m_count{0};
+        std::vector<uint8_t> m_serialized_sketch;
+    };
+
+    absl::flat_hash_map<GroupTags, HyperLogLog> m_group_sketches;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_DISTINCTCOUNTOPERATOR_HPP
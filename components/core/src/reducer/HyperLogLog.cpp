@@ -0,0 +1,238 @@
+#include "HyperLogLog.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <xxhash.h>
+
+namespace reducer {
+namespace {
+constexpr uint8_t cSerializationVersion{1};
+
+/**
+ * Encodings of the sketch's registers in its serialized form.
+ */
+enum class RegisterEncoding : uint8_t {
+    // One byte per register
+    Dense = 0,
+    // A 4-byte entry count followed by a (2-byte index, 1-byte value) entry per non-empty register
+    Sparse = 1
+};
+
+constexpr size_t cHeaderSize{3};
+constexpr size_t cSparseCountSize{4};
+constexpr size_t cSparseEntrySize{3};
+
+/**
+ * Seeds used to hash each type of value, so that values of different types with equal byte
+ * representations don't collide.
+ */
+enum class HashSeed : uint64_t {
+    String = 0,
+    Int64,
+    Double,
+    Bool
+};
+
+/**
+ * @param value
+ * @param size
+ * @param seed
+ * @return The seeded 64-bit XXH3 hash of the given bytes.
+ */
+uint64_t hash_bytes(void const* value, size_t size, HashSeed seed);
+
+/**
+ * @param precision
+ * @return The bias-correction constant for a sketch with 2^precision registers.
+ */
+double get_alpha(uint8_t precision);
+
+uint64_t hash_bytes(void const* value, size_t size, HashSeed seed) {
+    return static_cast<uint64_t>(XXH3_64bits_withSeed(value, size, static_cast<uint64_t>(seed)));
+}
+
+double get_alpha(uint8_t precision) {
+    switch (precision) {
+        case 4:
+            return 0.673;
+        case 5:
+            return 0.697;
+        case 6:
+            return 0.709;
+        default: {
+            auto const num_registers = static_cast<double>(1ULL << precision);
+            return 0.7213 / (1.0 + 1.079 / num_registers);
+        }
+    }
+}
+}  // namespace
+
+HyperLogLog::HyperLogLog(uint8_t precision) : m_precision{precision} {
+    if (precision < cMinPrecision || precision > cMaxPrecision) {
+        throw std::invalid_argument("HyperLogLog precision is out of range.");
+    }
+    m_registers.resize(1ULL << precision, 0);
+}
+
+std::optional<HyperLogLog> HyperLogLog::deserialize(std::span<uint8_t const> serialized_sketch) {
+    if (serialized_sketch.size() < cHeaderSize || cSerializationVersion != serialized_sketch[0]) {
+        return std::nullopt;
+    }
+    auto const precision = serialized_sketch[1];
+    if (precision < cMinPrecision || precision > cMaxPrecision) {
+        return std::nullopt;
+    }
+    HyperLogLog sketch{precision};
+    auto const num_registers = sketch.m_registers.size();
+    uint8_t const max_register_value = 64 - precision + 1;
+    auto const payload = serialized_sketch.subspan(cHeaderSize);
+
+    switch (static_cast<RegisterEncoding>(serialized_sketch[2])) {
+        case RegisterEncoding::Dense:
+            if (payload.size() != num_registers) {
+                return std::nullopt;
+            }
+            for (size_t i = 0; i < num_registers; ++i) {
+                if (payload[i] > max_register_value) {
+                    return std::nullopt;
+                }
+                sketch.m_registers[i] = payload[i];
+            }
+            break;
+        case RegisterEncoding::Sparse: {
+            if (payload.size() < cSparseCountSize) {
+                return std::nullopt;
+            }
+            uint32_t num_entries{0};
+            for (size_t i = 0; i < cSparseCountSize; ++i) {
+                num_entries |= static_cast<uint32_t>(payload[i]) << (8 * i);
+            }
+            if (payload.size() - cSparseCountSize != num_entries * cSparseEntrySize) {
+                return std::nullopt;
+            }
+            for (size_t pos = cSparseCountSize; pos < payload.size(); pos += cSparseEntrySize) {
+                size_t const register_idx = payload[pos] | (payload[pos + 1] << 8);
+                auto const register_value = payload[pos + 2];
+                if (register_idx >= num_registers || register_value > max_register_value) {
+                    return std::nullopt;
+                }
+                sketch.m_registers[register_idx] = register_value;
+            }
+            break;
+        }
+        default:
+            return std::nullopt;
+    }
+    return sketch;
+}
+
+void HyperLogLog::add_string(std::string_view value) {
+    add_hash(hash_bytes(value.data(), value.size(), HashSeed::String));
+}
+
+void HyperLogLog::add_int64(int64_t value) {
+    add_hash(hash_bytes(&value, sizeof(value), HashSeed::Int64));
+}
+
+void HyperLogLog::add_double(double value) {
+    if (0.0 == value) {
+        // Treat -0.0 and 0.0 as the same value
+        value = 0.0;
+    }
+    add_hash(hash_bytes(&value, sizeof(value), HashSeed::Double));
+}
+
+void HyperLogLog::add_bool(bool value) {
+    uint8_t const byte = value ? 1 : 0;
+    add_hash(hash_bytes(&byte, sizeof(byte), HashSeed::Bool));
+}
+
+bool HyperLogLog::merge(HyperLogLog const& other) {
+    if (other.m_precision != m_precision) {
+        return false;
+    }
+    for (size_t i = 0; i < m_registers.size(); ++i) {
+        m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+    return true;
+}
+
+uint64_t HyperLogLog::estimate() const {
+    auto const num_registers = static_cast<double>(m_registers.size());
+    double harmonic_sum{0.0};
+    size_t num_empty_registers{0};
+    for (auto const register_value : m_registers) {
+        harmonic_sum += std::ldexp(1.0, -static_cast<int>(register_value));
+        if (0 == register_value) {
+            ++num_empty_registers;
+        }
+    }
+
+    auto estimate = get_alpha(m_precision) * num_registers * num_registers / harmonic_sum;
+    if (estimate <= 2.5 * num_registers && num_empty_registers > 0) {
+        // Use linear counting for small cardinalities, where the raw estimate is heavily biased.
+        // NOTE: Since we use 64-bit hashes, there's no need for a large-range correction.
+        estimate = num_registers
+                   * std::log(num_registers / static_cast<double>(num_empty_registers));
+    }
+    return static_cast<uint64_t>(std::llround(estimate));
+}
+
+std::vector<uint8_t> HyperLogLog::serialize() const {
+    auto const num_nonempty_registers = static_cast<size_t>(std::count_if(
+            m_registers.cbegin(),
+            m_registers.cend(),
+            [](uint8_t register_value) { return 0 != register_value; }
+    ));
+
+    std::vector<uint8_t> serialized_sketch{cSerializationVersion, m_precision};
+    if (cSparseCountSize + num_nonempty_registers * cSparseEntrySize < m_registers.size()) {
+        serialized_sketch.push_back(static_cast<uint8_t>(RegisterEncoding::Sparse));
+        serialized_sketch.reserve(
+                cHeaderSize + cSparseCountSize + num_nonempty_registers * cSparseEntrySize
+        );
+        for (size_t i = 0; i < cSparseCountSize; ++i) {
+            serialized_sketch.push_back(
+                    static_cast<uint8_t>((num_nonempty_registers >> (8 * i)) & 0xFF)
+            );
+        }
+        for (size_t i = 0; i < m_registers.size(); ++i) {
+            if (0 == m_registers[i]) {
+                continue;
+            }
+            serialized_sketch.push_back(static_cast<uint8_t>(i & 0xFF));
+            serialized_sketch.push_back(static_cast<uint8_t>((i >> 8) & 0xFF));
+            serialized_sketch.push_back(m_registers[i]);
+        }
+    } else {
+        serialized_sketch.push_back(static_cast<uint8_t>(RegisterEncoding::Dense));
+        serialized_sketch.insert(
+                serialized_sketch.end(),
+                m_registers.cbegin(),
+                m_registers.cend()
+        );
+    }
+    return serialized_sketch;
+}
+
+void HyperLogLog::add_hash(uint64_t hash) {
+    // The top `m_precision` bits select the register and the position of the first set bit in the
+    // remaining bits determines the register's value.
+    auto const register_idx = hash >> (64 - m_precision);
+    auto const remaining_bits = hash << m_precision;
+    uint8_t const max_register_value = 64 - m_precision + 1;
+    auto const register_value = static_cast<uint8_t>(
+            std::min<int>(std::countl_zero(remaining_bits) + 1, max_register_value)
+    );
+    m_registers[register_idx] = std::max(m_registers[register_idx], register_value);
+}
+}  // namespace reducer
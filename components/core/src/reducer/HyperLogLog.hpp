@@ -0,0 +1,86 @@
+#ifndef REDUCER_HYPERLOGLOG_HPP
+#define REDUCER_HYPERLOGLOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reducer {
+/**
+ * A HyperLogLog sketch that estimates the number of distinct values added to it using a fixed
+ * amount of memory (one byte per register).
+ *
+ * Sketches with the same precision can be merged, making them suitable for aggregating distinct
+ * counts across search workers: each worker sends a partial sketch and the reducer merges them.
+ * Values are hashed with XXH3 so that sketches built by different processes are compatible.
+ *
+ * The standard error of the estimate is roughly 1.04 / sqrt(2^precision), e.g., ~1.6% for the
+ * default precision.
+ */
+class HyperLogLog {
+public:
+    // Constants
+    static constexpr uint8_t cMinPrecision{4};
+    static constexpr uint8_t cMaxPrecision{16};
+    static constexpr uint8_t cDefaultPrecision{12};
+
+    // Constructors
+    /**
+     * @param precision The number of hash bits used to select a register.
+     * @throw std::invalid_argument if the precision isn't in [cMinPrecision, cMaxPrecision].
+     */
+    explicit HyperLogLog(uint8_t precision = cDefaultPrecision);
+
+    // Methods
+    /**
+     * Deserializes a sketch produced by serialize().
+     * @param serialized_sketch
+     * @return The sketch on success, or std::nullopt if the serialized sketch is malformed.
+     */
+    [[nodiscard]] static std::optional<HyperLogLog>
+    deserialize(std::span<uint8_t const> serialized_sketch);
+
+    [[nodiscard]] uint8_t get_precision() const { return m_precision; }
+
+    /**
+     * Adds a value to the sketch. Values of different types are treated as distinct even if their
+     * representations are equal.
+     * @param value
+     */
+    void add_string(std::string_view value);
+    void add_int64(int64_t value);
+    void add_double(double value);
+    void add_bool(bool value);
+
+    /**
+     * Merges another sketch into this one.
+     * @param other
+     * @return Whether the sketches could be merged (i.e., whether they have the same precision).
+     */
+    [[nodiscard]] bool merge(HyperLogLog const& other);
+
+    /**
+     * @return The estimated number of distinct values added to the sketch.
+     */
+    [[nodiscard]] uint64_t estimate() const;
+
+    /**
+     * Serializes the sketch. Sketches with few non-empty registers are encoded sparsely.
+     * @return The serialized sketch.
+     */
+    [[nodiscard]] std::vector<uint8_t> serialize() const;
+
+private:
+    // Methods
+    void add_hash(uint64_t hash);
+
+    // Variables
+    uint8_t m_precision;
+    std::vector<uint8_t> m_registers;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_HYPERLOGLOG_HPP
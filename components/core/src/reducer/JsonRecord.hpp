@@ -1,6 +1,10 @@
 #ifndef REDUCER_JSONRECORD_HPP
 #define REDUCER_JSONRECORD_HPP
 
+#include <cstdint>
+#include <span>
+#include <string_view>
+
 #include <nlohmann/json.hpp>
 
 #include "Record.hpp"
@@ -25,6 +29,15 @@ public:
         return (*m_record)[key].template get<double>();
     }
 
+    [[nodiscard]] std::span<uint8_t const> get_binary_value(std::string_view key) const override {
+        auto const& value = (*m_record)[key];
+        if (false == value.is_binary()) {
+            return {};
+        }
+        auto const& binary = value.get_binary();
+        return {binary.data(), binary.size()};
+    }
+
     // TODO: Provide a real iterator. This is fine to omit for now since it isn't used by any
     // existing code.
     [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override {
@@ -0,0 +1,89 @@
+#include "PipelineShard.hpp"
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+#include <boost/asio.hpp>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Pipeline.hpp"
+#include "RecordGroupIterator.hpp"
+
+namespace reducer {
+namespace {
+/**
+ * Pushes every record group from the given iterator into the given pipeline.
+ * @param results
+ * @param pipeline
+ */
+void push_results(RecordGroupIterator& results, Pipeline& pipeline);
+
+void push_results(RecordGroupIterator& results, Pipeline& pipeline) {
+    for (; false == results.done(); results.next()) {
+        auto& group = results.get();
+        pipeline.push_record_group(group.get_tags(), group.record_iter());
+    }
+}
+}  // namespace
+
+void PipelineShard::start() {
+    m_ioctx.restart();
+    m_work_guard.emplace(boost::asio::make_work_guard(m_ioctx));
+    m_thread = std::thread{[this]() { m_ioctx.run(); }};
+}
+
+void PipelineShard::stop() {
+    m_work_guard.reset();
+    m_ioctx.stop();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void PipelineShard::set_pipeline(std::unique_ptr<Pipeline> pipeline, bool track_updated_tags) {
+    std::lock_guard<std::mutex> const lock{m_pipeline_mutex};
+    m_pipeline = std::move(pipeline);
+    m_track_updated_tags = track_updated_tags;
+    m_updated_tags.clear();
+}
+
+void PipelineShard::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
+    std::lock_guard<std::mutex> const lock{m_pipeline_mutex};
+    if (nullptr == m_pipeline) {
+        return;
+    }
+    if (m_track_updated_tags) {
+        m_updated_tags.insert(tags);
+    }
+    m_pipeline->push_record_group(tags, record_it);
+}
+
+void PipelineShard::take_updated_tags(std::set<GroupTags>& updated_tags) {
+    std::lock_guard<std::mutex> const lock{m_pipeline_mutex};
+    updated_tags.merge(m_updated_tags);
+    m_updated_tags.clear();
+}
+
+void PipelineShard::merge_results_into(Pipeline& merged_pipeline) {
+    std::lock_guard<std::mutex> const lock{m_pipeline_mutex};
+    if (nullptr == m_pipeline) {
+        return;
+    }
+    push_results(*m_pipeline->finish(), merged_pipeline);
+}
+
+void PipelineShard::merge_results_into(
+        Pipeline& merged_pipeline,
+        std::set<GroupTags> const& filtered_tags
+) {
+    std::lock_guard<std::mutex> const lock{m_pipeline_mutex};
+    if (nullptr == m_pipeline) {
+        return;
+    }
+    push_results(*m_pipeline->finish(filtered_tags), merged_pipeline);
+}
+}  // namespace reducer
@@ -0,0 +1,102 @@
+#ifndef REDUCER_PIPELINESHARD_HPP
+#define REDUCER_PIPELINESHARD_HPP
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+
+#include <boost/asio.hpp>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Pipeline.hpp"
+
+namespace reducer {
+/**
+ * A shard of the reducer's aggregation state. Each shard runs its own event loop on a dedicated
+ * thread, which services the receiver connections assigned to the shard, and owns a pipeline that
+ * aggregates the record groups those connections receive. Since each connection only ever pushes
+ * into its own shard's pipeline, shards aggregate in parallel without contending with each other;
+ * their results are merged when they're published.
+ */
+class PipelineShard {
+public:
+    // Constructors
+    PipelineShard() = default;
+
+    // Disallow copy and move
+    PipelineShard(PipelineShard const&) = delete;
+    PipelineShard(PipelineShard&&) = delete;
+    PipelineShard& operator=(PipelineShard const&) = delete;
+    PipelineShard& operator=(PipelineShard&&) = delete;
+
+    // Destructor
+    ~PipelineShard() { stop(); }
+
+    // Methods
+    boost::asio::io_context& get_io_context() { return m_ioctx; }
+
+    /**
+     * Starts a thread that runs the shard's event loop until stop() is called.
+     */
+    void start();
+
+    /**
+     * Stops the shard's event loop and waits for its thread to exit. Any handlers that haven't run
+     * yet are left in the event loop and destroyed along with the shard.
+     */
+    void stop();
+
+    /**
+     * Sets the pipeline that record groups pushed into this shard are aggregated by.
+     * @param pipeline
+     * @param track_updated_tags Whether to track the tags of the record groups pushed into this
+     * shard so that they can be retrieved with take_updated_tags().
+     */
+    void set_pipeline(std::unique_ptr<Pipeline> pipeline, bool track_updated_tags);
+
+    /**
+     * Pushes a record group into the shard's pipeline.
+     * @param tags The tags in the record group.
+     * @param record_it An iterator for the records in the record group.
+     */
+    void push_record_group(GroupTags const& tags, ConstRecordIterator& record_it);
+
+    /**
+     * Moves the tags of the record groups pushed since the last call into the given set.
+     * @param updated_tags
+     */
+    void take_updated_tags(std::set<GroupTags>& updated_tags);
+
+    /**
+     * Finishes the shard's pipeline and pushes its results into the given pipeline, which must
+     * reduce them the same way the shard's pipeline does. This must only be called once no more
+     * record groups will be pushed into the shard.
+     * @param merged_pipeline
+     */
+    void merge_results_into(Pipeline& merged_pipeline);
+
+    /**
+     * Pushes the shard's current results for the given tags into the given pipeline, which must
+     * reduce them the same way the shard's pipeline does.
+     * @param merged_pipeline
+     * @param filtered_tags
+     */
+    void merge_results_into(Pipeline& merged_pipeline, std::set<GroupTags> const& filtered_tags);
+
+private:
+    boost::asio::io_context m_ioctx;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>
+            m_work_guard;
+    std::thread m_thread;
+
+    std::mutex m_pipeline_mutex;
+    std::unique_ptr<Pipeline> m_pipeline;
+    bool m_track_updated_tags{false};
+    std::set<GroupTags> m_updated_tags;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_PIPELINESHARD_HPP
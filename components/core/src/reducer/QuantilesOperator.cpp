@@ -0,0 +1,92 @@
+#include "QuantilesOperator.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "RecordGroupIterator.hpp"
+#include "RecordTypedKeyIterator.hpp"
+#include "TDigest.hpp"
+
+namespace reducer {
+namespace {
+constexpr std::array<TypedRecordKey, 4> cResultRecordKeys{
+        TypedRecordKey{QuantilesOperator::cP50Key, ValueType::Double},
+        TypedRecordKey{QuantilesOperator::cP95Key, ValueType::Double},
+        TypedRecordKey{QuantilesOperator::cP99Key, ValueType::Double},
+        TypedRecordKey{QuantilesOperator::cSketchKey, ValueType::Binary}
+};
+}  // namespace
+
+void QuantilesOperator::push_intra_stage_record_group(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it
+) {
+    for (; false == record_it.done(); record_it.next()) {
+        auto partial_digest = TDigest::deserialize(
+                record_it.get().get_binary_value(static_cast<char const*>(cSketchKey))
+        );
+        if (false == partial_digest.has_value()) {
+            // Drop malformed digests
+            continue;
+        }
+        auto [it, inserted] = m_group_digests.try_emplace(tags, std::move(partial_digest.value()));
+        if (false == inserted) {
+            it->second.merge(partial_digest.value());
+        }
+    }
+}
+
+void QuantilesOperator::push_inter_stage_record_group(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it
+) {
+    auto& digest = m_group_digests[tags];
+
+    for (; false == record_it.done(); record_it.next()) {
+        digest.add(record_it.get().get_double_value(static_cast<char const*>(cValueKey)));
+    }
+}
+
+std::unique_ptr<RecordGroupIterator> QuantilesOperator::get_stored_result_iterator() {
+    return std::make_unique<MapRecordGroupIterator<TDigest, ResultRecordAdapter>>(
+            m_group_digests
+    );
+}
+
+void QuantilesOperator::ResultRecordAdapter::set_record_value(TDigest const& digest) {
+    m_p50 = digest.quantile(0.5);
+    m_p95 = digest.quantile(0.95);
+    m_p99 = digest.quantile(0.99);
+    m_serialized_digest = digest.serialize();
+}
+
+double QuantilesOperator::ResultRecordAdapter::get_double_value(std::string_view key) const {
+    if (key == static_cast<char const*>(cP50Key)) {
+        return m_p50;
+    }
+    if (key == static_cast<char const*>(cP95Key)) {
+        return m_p95;
+    }
+    if (key == static_cast<char const*>(cP99Key)) {
+        return m_p99;
+    }
+    return 0.0;
+}
+
+std::span<uint8_t const>
+QuantilesOperator::ResultRecordAdapter::get_binary_value(std::string_view key) const {
+    if (key == static_cast<char const*>(cSketchKey)) {
+        return m_serialized_digest;
+    }
+    return {};
+}
+
+std::unique_ptr<RecordTypedKeyIterator> QuantilesOperator::ResultRecordAdapter::typed_key_iter(
+) const {
+    return std::make_unique<TypedKeyListIterator>(cResultRecordKeys);
+}
+}  // namespace reducer
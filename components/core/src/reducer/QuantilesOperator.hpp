@@ -0,0 +1,70 @@
+#ifndef REDUCER_QUANTILESOPERATOR_HPP
+#define REDUCER_QUANTILESOPERATOR_HPP
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "GroupTags.hpp"
+#include "Operator.hpp"
+#include "Record.hpp"
+#include "RecordTypedKeyIterator.hpp"
+#include "TDigest.hpp"
+
+namespace reducer {
+/**
+ * Quantiles operator that estimates the median, 95th, and 99th percentiles of the values in each
+ * record group using a t-digest.
+ *
+ * As a combiner, the operator adds the numeric value of each record's `cValueKey` element to the
+ * group's digest. As a reducer, it merges the partial digests in each record's `cSketchKey`
+ * element. Each result record contains the group's estimated percentiles and its digest, so that
+ * results can be merged further downstream.
+ */
+class QuantilesOperator : public Operator {
+public:
+    static constexpr char cValueKey[] = "value";
+    static constexpr char cP50Key[] = "p50";
+    static constexpr char cP95Key[] = "p95";
+    static constexpr char cP99Key[] = "p99";
+    static constexpr char cSketchKey[] = "sketch";
+
+    void
+    push_intra_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override;
+
+    void
+    push_inter_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override;
+
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator() override;
+
+private:
+    /**
+     * Record adapter which exposes a digest's estimated percentiles and serialized form.
+     */
+    class ResultRecordAdapter : public Record {
+    public:
+        void set_record_value(TDigest const& digest);
+
+        [[nodiscard]] double get_double_value(std::string_view key) const override;
+
+        [[nodiscard]] std::span<uint8_t const> get_binary_value(std::string_view key
+        ) const override;
+
+        [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override;
+
+    private:
+        double m_p50{0.0};
+        double m_p95{0.0};
+        double m_p99{0.0};
+        std::vector<uint8_t> m_serialized_digest;
+    };
+
+    absl::flat_hash_map<GroupTags, TDigest> m_group_digests;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_QUANTILESOPERATOR_HPP
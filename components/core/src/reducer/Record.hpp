@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <variant>
@@ -32,6 +33,12 @@ public:
         return 0.0;
     }
 
+    [[nodiscard]] virtual std::span<uint8_t const> get_binary_value(
+            [[maybe_unused]] std::string_view key
+    ) const {
+        return {};
+    }
+
     /**
      * @return An iterator to the key and value type of each element in this record.
      */
@@ -94,6 +101,34 @@ private:
     int64_t m_value{};
 };
 
+/**
+ * Record implementation which exposes a single binary key-value pair.
+ *
+ * The value associated with the key can be updated allowing this class to act as an adapter for a
+ * larger set of data.
+ */
+class SingleBinaryRecordAdapter : public Record {
+public:
+    explicit SingleBinaryRecordAdapter(std::string key_name) : m_key_name{std::move(key_name)} {}
+
+    void set_record_value(std::span<uint8_t const> value) { m_value = value; }
+
+    [[nodiscard]] std::span<uint8_t const> get_binary_value(std::string_view key) const override {
+        if (key == m_key_name) {
+            return m_value;
+        }
+        return {};
+    }
+
+    [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override {
+        return std::make_unique<SingleTypedKeyIterator>(m_key_name, ValueType::Binary);
+    }
+
+private:
+    std::string m_key_name;
+    std::span<uint8_t const> m_value;
+};
+
 /**
  * Record implementation for an empty record.
  */
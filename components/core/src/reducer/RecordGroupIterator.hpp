@@ -5,6 +5,8 @@
 #include <set>
 #include <utility>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "RecordGroup.hpp"
 
 namespace reducer {
@@ -36,11 +38,14 @@ public:
 };
 
 /**
- * A RecordGroupIterator that exposes a map which maps GroupTags to int64_t values.
+ * A RecordGroupIterator that exposes a hash map which maps GroupTags to int64_t values.
  */
 class Int64MapRecordGroupIterator : public RecordGroupIterator {
 public:
-    Int64MapRecordGroupIterator(std::map<GroupTags, int64_t> const& map, std::string key)
+    Int64MapRecordGroupIterator(
+            absl::flat_hash_map<GroupTags, int64_t> const& map,
+            std::string key
+    )
             : m_map_it{map.cbegin()},
               m_map_end_it{map.cend()},
               m_record{std::move(key)},
@@ -60,8 +65,8 @@ public:
 private:
     SingleInt64RecordAdapter m_record;
     SingleRecordGroup m_group;
-    std::map<GroupTags, int64_t>::const_iterator m_map_it;
-    std::map<GroupTags, int64_t>::const_iterator m_map_end_it;
+    absl::flat_hash_map<GroupTags, int64_t>::const_iterator m_map_it;
+    absl::flat_hash_map<GroupTags, int64_t>::const_iterator m_map_end_it;
 };
 
 /**
@@ -96,13 +101,13 @@ private:
 };
 
 /**
- * A RecordGroupIterator that exposes a map which maps GroupTags keys to int64_t values, filtered
- * by another set of GroupTags.
+ * A RecordGroupIterator that exposes a hash map which maps GroupTags keys to int64_t values,
+ * filtered by another set of GroupTags.
  */
 class FilteredInt64MapRecordGroupIterator : public RecordGroupIterator {
 public:
     FilteredInt64MapRecordGroupIterator(
-            std::map<GroupTags, int64_t> const& map,
+            absl::flat_hash_map<GroupTags, int64_t> const& map,
             std::set<GroupTags> const& filter,
             std::string key
     )
@@ -151,13 +156,45 @@ private:
 
     SingleInt64RecordAdapter m_record;
     SingleRecordGroup m_group;
-    std::map<GroupTags, int64_t> const& m_map;
-    std::map<GroupTags, int64_t>::const_iterator m_map_end_it;
-    std::map<GroupTags, int64_t>::const_iterator m_map_it;
+    absl::flat_hash_map<GroupTags, int64_t> const& m_map;
+    absl::flat_hash_map<GroupTags, int64_t>::const_iterator m_map_end_it;
+    absl::flat_hash_map<GroupTags, int64_t>::const_iterator m_map_it;
     std::set<GroupTags>::const_iterator m_filter_it;
     std::set<GroupTags>::const_iterator m_filter_end_it;
 };
 
+/**
+ * A RecordGroupIterator that exposes a hash map which maps GroupTags to values of any type, using a
+ * record adapter to expose each value as a record.
+ * @tparam MappedType
+ * @tparam RecordAdapterType A Record with a `set_record_value(MappedType const&)` method.
+ */
+template <typename MappedType, typename RecordAdapterType>
+class MapRecordGroupIterator : public RecordGroupIterator {
+public:
+    explicit MapRecordGroupIterator(absl::flat_hash_map<GroupTags, MappedType> const& map)
+            : m_map_it{map.cbegin()},
+              m_map_end_it{map.cend()},
+              m_group{nullptr, m_record} {}
+
+    RecordGroup& get() override {
+        m_record.set_record_value(m_map_it->second);
+        m_group.set_tags(&m_map_it->first);
+        m_group.reset_record_iterator();
+        return m_group;
+    }
+
+    void next() override { ++m_map_it; }
+
+    bool done() override { return m_map_it == m_map_end_it; }
+
+private:
+    RecordAdapterType m_record;
+    SingleRecordGroup m_group;
+    typename absl::flat_hash_map<GroupTags, MappedType>::const_iterator m_map_it;
+    typename absl::flat_hash_map<GroupTags, MappedType>::const_iterator m_map_end_it;
+};
+
 /**
  * A RecordGroupIterator over an empty RecordGroup.
  */
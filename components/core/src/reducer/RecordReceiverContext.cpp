@@ -64,7 +64,7 @@ bool RecordReceiverContext::read_record_groups_packet() {
         read_head += sizeof(record_size);
 
         auto record_group = DeserializedRecordGroup{read_head, record_size};
-        m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
+        m_shard.push_record_group(record_group.get_tags(), record_group.record_iter());
         m_buf_num_bytes_occupied -= (record_size + sizeof(record_size));
         read_head += record_size;
     }
@@ -4,18 +4,30 @@
 #include <cstdint>
 #include <memory>
 
+#include <boost/asio.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
+#include "PipelineShard.hpp"
 #include "ServerContext.hpp"
 
 namespace reducer {
+/**
+ * Class which holds the state of a connection receiving results from a search worker.
+ *
+ * The connection's socket, and so its handlers, run on the event loop of the shard it's assigned
+ * to, and the results it receives are pushed into that shard's pipeline. The receiver also holds
+ * work on the server's event loop until it's destroyed, so that the server doesn't finish running
+ * before every connection has been closed.
+ */
 class RecordReceiverContext {
 public:
     static constexpr size_t cMinBufSize = 1024;
 
-    explicit RecordReceiverContext(std::shared_ptr<ServerContext> const& ctx)
+    RecordReceiverContext(std::shared_ptr<ServerContext> const& ctx, PipelineShard& shard)
             : m_server_ctx{ctx},
-              m_socket{ctx->get_io_context()},
+              m_server_work_guard{boost::asio::make_work_guard(ctx->get_io_context())},
+              m_shard{shard},
+              m_socket{shard.get_io_context()},
               m_buf(cMinBufSize) {}
 
     ~RecordReceiverContext() { m_socket.close(); }
@@ -29,7 +41,7 @@ public:
     static std::shared_ptr<RecordReceiverContext> new_receiver(
             std::shared_ptr<ServerContext> const& ctx
     ) {
-        auto receiver = std::make_shared<RecordReceiverContext>(ctx);
+        auto receiver = std::make_shared<RecordReceiverContext>(ctx, ctx->assign_shard());
 
         // Clear the v6_only flag to allow ipv4 and ipv6 connections, but only on Linux. For full
         // portability, we need separate v4 and v6 acceptors.
@@ -83,6 +95,8 @@ private:
     static constexpr size_t cMaxRecordSize = 16ULL * 1024 * 1024;
 
     std::shared_ptr<ServerContext> m_server_ctx;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_server_work_guard;
+    PipelineShard& m_shard;
     boost::asio::ip::tcp::socket m_socket;
     std::vector<char> m_buf;
     size_t m_buf_num_bytes_occupied{0};
@@ -1,6 +1,9 @@
 #ifndef REDUCER_RECORDTYPEDKEYITERATOR_HPP
 #define REDUCER_RECORDTYPEDKEYITERATOR_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string_view>
 
 namespace reducer {
@@ -10,7 +13,8 @@ namespace reducer {
 enum class ValueType : uint8_t {
     String,
     Int64,
-    Double
+    Double,
+    Binary
 };
 
 /**
@@ -23,7 +27,7 @@ class TypedRecordKey {
 public:
     TypedRecordKey() = default;
 
-    TypedRecordKey(std::string_view key, ValueType type) : m_key{key}, m_type{type} {}
+    constexpr TypedRecordKey(std::string_view key, ValueType type) : m_key{key}, m_type{type} {}
 
     [[nodiscard]] std::string_view get_key() const { return m_key; }
 
@@ -90,6 +94,24 @@ private:
     ValueType m_type;
     bool m_done{false};
 };
+
+/**
+ * A RecordTypedKeyIterator over a fixed list of typed keys.
+ */
+class TypedKeyListIterator : public RecordTypedKeyIterator {
+public:
+    explicit TypedKeyListIterator(std::span<TypedRecordKey const> keys) : m_keys{keys} {}
+
+    TypedRecordKey get() override { return m_keys[m_idx]; }
+
+    void next() override { ++m_idx; }
+
+    bool done() override { return m_idx >= m_keys.size(); }
+
+private:
+    std::span<TypedRecordKey const> m_keys;
+    size_t m_idx{0};
+};
 }  // namespace reducer
 
 #endif  // REDUCER_RECORDTYPEDKEYITERATOR_HPP
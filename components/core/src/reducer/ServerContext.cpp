@@ -1,5 +1,9 @@
 #include "ServerContext.hpp"
 
+#include <cstddef>
+#include <memory>
+#include <set>
+
 #include <bsoncxx/builder/stream/document.hpp>
 #include <mongocxx/bulk_write.hpp>
 #include <mongocxx/client.hpp>
@@ -15,6 +19,10 @@
 #include "CommandLineArguments.hpp"
 #include "CountOperator.hpp"
 #include "DeserializedRecordGroup.hpp"
+#include "DistinctCountOperator.hpp"
+#include "Pipeline.hpp"
+#include "PipelineShard.hpp"
+#include "QuantilesOperator.hpp"
 
 using boost::asio::ip::tcp;
 using std::vector;
@@ -57,7 +65,10 @@ ServerContext::ServerContext(CommandLineArguments& args)
           m_upsert_timer{m_ioctx},
           m_reducer_host{args.get_reducer_host()},
           m_reducer_port{args.get_reducer_port()},
+          m_num_shards{args.get_num_io_threads()},
           m_upsert_interval{args.get_upsert_interval()} {
+    create_shards();
+
     mongocxx::uri mongodb_uri = mongocxx::uri(args.get_mongodb_uri());
     try {
         m_mongodb_client = mongocxx::client(mongodb_uri);
@@ -70,14 +81,34 @@ ServerContext::ServerContext(CommandLineArguments& args)
 
 void ServerContext::reset() {
     m_ioctx.restart();
-    m_pipeline.reset(nullptr);
+    create_shards();
     m_status = ServerStatus::Idle;
     m_job_id = -1;
+    m_aggregation_type = AggregationType::Count;
     m_is_timeline_aggregation = false;
     m_updated_tags.clear();
     m_num_active_receiver_tasks = 0;
 }
 
+void ServerContext::run() {
+    for (auto& shard : m_shards) {
+        shard->start();
+    }
+    try {
+        m_ioctx.run();
+    } catch (...) {
+        for (auto& shard : m_shards) {
+            shard->stop();
+        }
+        throw;
+    }
+    // Every receiver holds work on the server's event loop until it's destroyed, so the shards have
+    // no connections left at this point.
+    for (auto& shard : m_shards) {
+        shard->stop();
+    }
+}
+
 void ServerContext::stop_event_loop() {
     m_tcp_acceptor.cancel();
     m_scheduler_socket.close();
@@ -132,12 +163,20 @@ bool ServerContext::ack_query_scheduler() {
 }
 
 void ServerContext::decrement_num_active_receiver_tasks() {
-    --m_num_active_receiver_tasks;
-    if (0 == m_num_active_receiver_tasks && ServerStatus::ReceivedAllResults == m_status) {
-        if (false == try_finalize_results()) {
-            m_status = ServerStatus::UnrecoverableFailure;
+    boost::asio::post(m_ioctx, [this]() {
+        --m_num_active_receiver_tasks;
+        if (0 == m_num_active_receiver_tasks && ServerStatus::ReceivedAllResults == m_status) {
+            if (false == try_finalize_results()) {
+                m_status = ServerStatus::UnrecoverableFailure;
+            }
         }
-    }
+    });
+}
+
+PipelineShard& ServerContext::assign_shard() {
+    auto& shard = *m_shards[m_next_shard_idx];
+    m_next_shard_idx = (m_next_shard_idx + 1) % m_shards.size();
+    return shard;
 }
 
 void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
@@ -145,41 +184,45 @@ void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
 
     SPDLOG_INFO("Setting up pipeline for job {}", m_job_id);
 
-    // For now, all pipelines only perform count and optionally, group-by time and count for the
-    // timeline aggregation.
-    // TODO: We'll need to implement more general pipeline initialization once more operators are
-    // needed.
-    m_pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
-    m_pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
-
-    if (query_config.count(cJobAttributes::TimeBucketSize) > 0
-        && false == query_config[cJobAttributes::TimeBucketSize].is_null())
-    {
+    auto const has_attribute = [&](char const* attribute) {
+        return query_config.count(attribute) > 0 && false == query_config[attribute].is_null();
+    };
+    if (has_attribute(cJobAttributes::TimeBucketSize)) {
         m_is_timeline_aggregation = true;
     }
+    if (has_attribute(cJobAttributes::CountDistinctField)) {
+        m_aggregation_type = AggregationType::DistinctCount;
+    } else if (has_attribute(cJobAttributes::QuantilesField)) {
+        m_aggregation_type = AggregationType::Quantiles;
+    }
+
+    for (auto& shard : m_shards) {
+        shard->set_pipeline(create_pipeline(), m_is_timeline_aggregation);
+    }
 
     auto collection_name = std::to_string(m_job_id);
     m_mongodb_results_collection = m_mongodb_results_database[collection_name];
 }
 
-void ServerContext::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
-    if (m_is_timeline_aggregation) {
-        m_updated_tags.insert(tags);
-    }
-    m_pipeline->push_record_group(tags, record_it);
-}
-
 bool ServerContext::upsert_timeline_results() {
+    for (auto& shard : m_shards) {
+        shard->take_updated_tags(m_updated_tags);
+    }
     if (m_updated_tags.empty()) {
         return true;
     }
 
+    // A bucket's count may be spread over several shards, so we need to merge every shard's count
+    // for each updated bucket.
+    auto merged_pipeline = create_pipeline();
+    for (auto& shard : m_shards) {
+        shard->merge_results_into(*merged_pipeline, m_updated_tags);
+    }
+
     bool any_updates = false;
     auto bulk_write = m_mongodb_results_collection.create_bulk_write();
     vector<vector<uint8_t>> results;
-    for (auto group_it = m_pipeline->finish(m_updated_tags); false == group_it->done();
-         group_it->next())
-    {
+    for (auto group_it = merged_pipeline->finish(); false == group_it->done(); group_it->next()) {
         int64_t timestamp{std::stoll(group_it->get().get_tags().front())};
 
         auto& group = group_it->get();
@@ -211,9 +254,14 @@ bool ServerContext::upsert_timeline_results() {
 }
 
 bool ServerContext::publish_pipeline_results() {
+    auto merged_pipeline = create_pipeline();
+    for (auto& shard : m_shards) {
+        shard->merge_results_into(*merged_pipeline);
+    }
+
     vector<vector<uint8_t>> results;
     vector<bsoncxx::document::view> result_documents;
-    for (auto group_it = m_pipeline->finish(); false == group_it->done(); group_it->next()) {
+    for (auto group_it = merged_pipeline->finish(); false == group_it->done(); group_it->next()) {
         auto& group = group_it->get();
         results.push_back(
                 serialize(group.get_tags(), group.record_iter(), nlohmann::json::to_bson)
@@ -257,4 +305,35 @@ bool ServerContext::try_finalize_results() {
     // Notify the query scheduler that the results have been pushed
     return ack_query_scheduler();
 }
+
+void ServerContext::create_shards() {
+    // Destroy the existing shards first so that their connections are closed before any new ones
+    // are accepted.
+    m_shards.clear();
+    for (size_t i = 0; i < m_num_shards; ++i) {
+        m_shards.emplace_back(std::make_unique<PipelineShard>());
+    }
+    m_next_shard_idx = 0;
+}
+
+std::unique_ptr<Pipeline> ServerContext::create_pipeline() const {
+    // For now, all pipelines consist of a single operator that merges the partial results sent by
+    // the search workers (and optionally, group-by time for the timeline aggregation).
+    // TODO: We'll need to implement more general pipeline initialization once multi-stage
+    // pipelines are needed.
+    auto pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
+    switch (m_aggregation_type) {
+        case AggregationType::DistinctCount:
+            pipeline->add_pipeline_stage(std::make_shared<DistinctCountOperator>());
+            break;
+        case AggregationType::Quantiles:
+            pipeline->add_pipeline_stage(std::make_shared<QuantilesOperator>());
+            break;
+        case AggregationType::Count:
+        default:
+            pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+            break;
+    }
+    return pipeline;
+}
 }  // namespace reducer
@@ -1,8 +1,12 @@
 #ifndef REDUCER_SERVERCONTEXT_HPP
 #define REDUCER_SERVERCONTEXT_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <mongocxx/client.hpp>
@@ -12,6 +16,7 @@
 #include "../clp/TraceableException.hpp"
 #include "CommandLineArguments.hpp"
 #include "Pipeline.hpp"
+#include "PipelineShard.hpp"
 #include "types.hpp"
 
 namespace reducer {
@@ -23,14 +28,30 @@ enum class ServerStatus : uint8_t {
     UnrecoverableFailure
 };
 
+/**
+ * The aggregations the reducer can perform.
+ */
+enum class AggregationType : uint8_t {
+    Count,
+    DistinctCount,
+    Quantiles
+};
+
 namespace cJobAttributes {
 constexpr char JobId[] = "job_id";
 constexpr char TimeBucketSize[] = "count_by_time_bucket_size";
+constexpr char CountDistinctField[] = "count_distinct_field";
+constexpr char QuantilesField[] = "quantiles_field";
 }  // namespace cJobAttributes
 
 /**
  * Class which manages interactions with the jobs database and result cache database. Also holds
  * state for the reducer job this server is handling.
+ *
+ * The server's control tasks (accepting connections, listening for scheduler updates, and
+ * publishing results) run on a single event loop, while the connections receiving results are
+ * spread over a pool of PipelineShards, each with its own event loop thread and pipeline. The
+ * shards' results are merged whenever results are published.
  */
 class ServerContext {
 public:
@@ -58,9 +79,10 @@ public:
     void reset();
 
     /**
-     * Executes the server event loop until no tasks remain.
+     * Executes the server event loop until no tasks remain, with each shard's event loop running on
+     * its own thread in the meantime.
      */
-    void run() { m_ioctx.run(); }
+    void run();
 
     /**
      * Stops the event loop by closing the connection to the scheduler, and cancelling any ongoing
@@ -86,30 +108,34 @@ public:
 
     /**
      * Increments the number of active receiver tasks which may receive some results.
+     * NOTE: This method must be called from the server's event loop.
      */
     void increment_num_active_receiver_tasks() { ++m_num_active_receiver_tasks; }
 
     /**
      * Decrements the number of active receiver tasks, and calls try_finalize_results if the server
-     * is in the state ReceivedAllResults and there are no remaining active receiver tasks.
+     * is in the state ReceivedAllResults and there are no remaining active receiver tasks. Since
+     * receiver tasks run on the shards' event loops, the decrement is posted to the server's event
+     * loop rather than performed immediately.
      */
     void decrement_num_active_receiver_tasks();
 
     /**
-     * Sets up an in-memory aggregation pipeline according to the given query config.
-     * @param query_config
+     * Assigns a shard to a new receiver connection. Connections are assigned to shards round-robin
+     * so that each shard receives a similar share of the results.
+     * NOTE: This method must be called from the server's event loop.
+     * @return The assigned shard.
      */
-    void set_up_pipeline(nlohmann::json const& query_config);
+    PipelineShard& assign_shard();
 
     /**
-     * Pushes a record group into the reducer pipeline.
-     * @param group_tags The tags in the record group.
-     * @param record_it An iterator for the records in the record group.
+     * Sets up an in-memory aggregation pipeline according to the given query config.
+     * @param query_config
      */
-    void push_record_group(GroupTags const& tags, ConstRecordIterator& record_it);
+    void set_up_pipeline(nlohmann::json const& query_config);
 
     /**
-     * Upserts the current set of timeline entries from the reducer pipeline to MongoDB and clears
+     * Upserts the current set of timeline entries from the shards' pipelines to MongoDB and clears
      * the tags that were updated in the last period. This method is executed repeatedly in the main
      * polling loop while running a reduction pipeline that is set to periodically upsert results.
      * @return Whether the upsert succeeded (or was unnecessary).
@@ -117,7 +143,7 @@ public:
     bool upsert_timeline_results();
 
     /**
-     * Publishes the reducer pipeline results to MongoDB.
+     * Merges the shards' pipeline results and publishes them to MongoDB.
      * @return Whether the publication succeeded.
      */
     bool publish_pipeline_results();
@@ -143,9 +169,9 @@ public:
 
     [[nodiscard]] int get_reducer_port() const { return m_reducer_port; }
 
-    [[nodiscard]] ServerStatus get_status() const { return m_status; }
+    [[nodiscard]] ServerStatus get_status() const { return m_status.load(); }
 
-    void set_status(ServerStatus new_status) { m_status = new_status; }
+    void set_status(ServerStatus new_status) { m_status.store(new_status); }
 
     [[nodiscard]] job_id_t get_job_id() const { return m_job_id; }
 
@@ -156,6 +182,16 @@ public:
     [[nodiscard]] int get_upsert_interval() const { return m_upsert_interval; }
 
 private:
+    /**
+     * Creates the shards, replacing any existing ones along with any connections they still hold.
+     */
+    void create_shards();
+
+    /**
+     * @return A new pipeline for the current job.
+     */
+    [[nodiscard]] std::unique_ptr<Pipeline> create_pipeline() const;
+
     boost::asio::io_context m_ioctx;
     boost::asio::ip::tcp::acceptor m_tcp_acceptor;
     boost::asio::ip::tcp::socket m_scheduler_socket;
@@ -165,11 +201,16 @@ private:
     int m_reducer_port;
     int m_num_active_receiver_tasks{0};
 
-    ServerStatus m_status{ServerStatus::Idle};
+    std::atomic<ServerStatus> m_status{ServerStatus::Idle};
     job_id_t m_job_id{-1};
 
-    std::unique_ptr<Pipeline> m_pipeline;
+    size_t m_num_shards;
+    std::vector<std::unique_ptr<PipelineShard>> m_shards;
+    size_t m_next_shard_idx{0};
+
+    AggregationType m_aggregation_type{AggregationType::Count};
     bool m_is_timeline_aggregation{false};
+    // Tags updated since the last successful upsert
     std::set<GroupTags> m_updated_tags;
 
     boost::asio::steady_timer m_upsert_timer;
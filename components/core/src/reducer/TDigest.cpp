@@ -0,0 +1,303 @@
+#include "TDigest.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace reducer {
+namespace {
+constexpr uint8_t cSerializationVersion{1};
+constexpr double cMaxCompression{10'000.0};
+// The number of centroids to buffer (relative to the compression) before compressing them
+constexpr double cBufferCapacityFactor{5.0};
+
+/**
+ * Appends an unsigned integer to the buffer as a LEB128 varint.
+ * @param value
+ * @param buf
+ */
+void write_varint(uint64_t value, std::vector<uint8_t>& buf);
+
+/**
+ * Appends a double to the buffer in little-endian order.
+ * @param value
+ * @param buf
+ */
+void write_double(double value, std::vector<uint8_t>& buf);
+
+/**
+ * Reads a LEB128 varint from the buffer.
+ * @param buf
+ * @param pos The position to read from. Returns the position after the varint.
+ * @return The value on success, or std::nullopt if the buffer is truncated or the varint is too
+ * long.
+ */
+std::optional<uint64_t> read_varint(std::span<uint8_t const> buf, size_t& pos);
+
+/**
+ * Reads a little-endian double from the buffer.
+ * @param buf
+ * @param pos The position to read from. Returns the position after the double.
+ * @return The value on success, or std::nullopt if the buffer is truncated.
+ */
+std::optional<double> read_double(std::span<uint8_t const> buf, size_t& pos);
+
+/**
+ * @param compression
+ * @param q The fraction of the digest's weight preceding a centroid.
+ * @return The maximum fraction of the digest's weight that can precede the end of a centroid that
+ * starts at `q`, according to the digest's (arcsine) scale function.
+ */
+double get_quantile_limit(double compression, double q);
+
+void write_varint(uint64_t value, std::vector<uint8_t>& buf) {
+    while (value >= 0x80) {
+        buf.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(value));
+}
+
+void write_double(double value, std::vector<uint8_t>& buf) {
+    auto const bits = std::bit_cast<uint64_t>(value);
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+        buf.push_back(static_cast<uint8_t>((bits >> (8 * i)) & 0xFF));
+    }
+}
+
+std::optional<uint64_t> read_varint(std::span<uint8_t const> buf, size_t& pos) {
+    uint64_t value{0};
+    for (size_t shift = 0; shift < 64; shift += 7) {
+        if (pos >= buf.size()) {
+            return std::nullopt;
+        }
+        auto const byte = buf[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (0 == (byte & 0x80)) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<double> read_double(std::span<uint8_t const> buf, size_t& pos) {
+    if (buf.size() - pos < sizeof(uint64_t)) {
+        return std::nullopt;
+    }
+    uint64_t bits{0};
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+        bits |= static_cast<uint64_t>(buf[pos++]) << (8 * i);
+    }
+    return std::bit_cast<double>(bits);
+}
+
+double get_quantile_limit(double compression, double q) {
+    auto const scale = compression / (2 * std::numbers::pi);
+    auto const k = scale * std::asin(2 * q - 1) + 1;
+    return (std::sin(std::min(k / scale, std::numbers::pi / 2)) + 1) / 2;
+}
+}  // namespace
+
+TDigest::TDigest(double compression) : m_compression{compression} {
+    if (false == (compression > 0.0 && compression <= cMaxCompression)) {
+        throw std::invalid_argument("TDigest compression is out of range.");
+    }
+    m_buffer_capacity = static_cast<size_t>(std::ceil(cBufferCapacityFactor * compression));
+}
+
+std::optional<TDigest> TDigest::deserialize(std::span<uint8_t const> serialized_digest) {
+    size_t pos{0};
+    if (serialized_digest.empty() || cSerializationVersion != serialized_digest[pos++]) {
+        return std::nullopt;
+    }
+    auto const compression = read_double(serialized_digest, pos);
+    auto const min = read_double(serialized_digest, pos);
+    auto const max = read_double(serialized_digest, pos);
+    auto const num_centroids = read_varint(serialized_digest, pos);
+    if (false == compression.has_value() || false == min.has_value() || false == max.has_value()
+        || false == num_centroids.has_value()
+        || false == (compression.value() > 0.0 && compression.value() <= cMaxCompression))
+    {
+        return std::nullopt;
+    }
+
+    TDigest digest{compression.value()};
+    digest.m_min = min.value();
+    digest.m_max = max.value();
+    // Each centroid takes at least 9 bytes, so bound the reservation by the remaining size
+    digest.m_centroids.reserve(
+            std::min<uint64_t>(num_centroids.value(), (serialized_digest.size() - pos) / 9)
+    );
+    double prev_mean{-std::numeric_limits<double>::infinity()};
+    for (uint64_t i = 0; i < num_centroids.value(); ++i) {
+        auto const mean = read_double(serialized_digest, pos);
+        auto const weight = read_varint(serialized_digest, pos);
+        if (false == mean.has_value() || false == weight.has_value() || 0 == weight.value()
+            || mean.value() < prev_mean
+            || weight.value() > std::numeric_limits<uint64_t>::max() - digest.m_count)
+        {
+            return std::nullopt;
+        }
+        prev_mean = mean.value();
+        digest.m_centroids.push_back({mean.value(), weight.value()});
+        digest.m_count += weight.value();
+    }
+    if (pos != serialized_digest.size()) {
+        return std::nullopt;
+    }
+    return digest;
+}
+
+void TDigest::add(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    if (0 == m_count) {
+        m_min = value;
+        m_max = value;
+    } else {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    ++m_count;
+    m_buffer.push_back({value, 1});
+    if (m_buffer.size() >= m_buffer_capacity) {
+        compress();
+    }
+}
+
+void TDigest::merge(TDigest const& other) {
+    if (other.empty()) {
+        return;
+    }
+    if (0 == m_count) {
+        m_min = other.m_min;
+        m_max = other.m_max;
+    } else {
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+    m_count += other.m_count;
+    m_buffer.insert(m_buffer.end(), other.m_centroids.cbegin(), other.m_centroids.cend());
+    m_buffer.insert(m_buffer.end(), other.m_buffer.cbegin(), other.m_buffer.cend());
+    if (m_buffer.size() >= m_buffer_capacity) {
+        compress();
+    }
+}
+
+double TDigest::quantile(double q) const {
+    if (0 == m_count) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (false == m_buffer.empty()) {
+        return compressed().quantile(q);
+    }
+    if (q <= 0.0) {
+        return m_min;
+    }
+    if (q >= 1.0) {
+        return m_max;
+    }
+    if (1 == m_centroids.size()) {
+        return m_centroids.front().mean;
+    }
+
+    // Treat each centroid's weight as being centered on its mean and interpolate between the means
+    // of the two centroids surrounding the target weight. Beyond the outermost centroids, we
+    // interpolate towards the digest's exact minimum and maximum.
+    auto const target_weight = q * static_cast<double>(m_count);
+    auto const& first = m_centroids.front();
+    auto const first_half_weight = static_cast<double>(first.weight) / 2;
+    if (target_weight < first_half_weight) {
+        return m_min + (first.mean - m_min) * target_weight / first_half_weight;
+    }
+
+    auto weight_so_far = first_half_weight;
+    for (size_t i = 0; i + 1 < m_centroids.size(); ++i) {
+        auto const& left = m_centroids[i];
+        auto const& right = m_centroids[i + 1];
+        auto const gap_weight = static_cast<double>(left.weight + right.weight) / 2;
+        if (weight_so_far + gap_weight > target_weight) {
+            auto const fraction = (target_weight - weight_so_far) / gap_weight;
+            return left.mean + (right.mean - left.mean) * fraction;
+        }
+        weight_so_far += gap_weight;
+    }
+
+    auto const& last = m_centroids.back();
+    auto const last_half_weight = static_cast<double>(last.weight) / 2;
+    auto const fraction = std::min((target_weight - weight_so_far) / last_half_weight, 1.0);
+    return last.mean + (m_max - last.mean) * fraction;
+}
+
+std::vector<uint8_t> TDigest::serialize() const {
+    if (false == m_buffer.empty()) {
+        return compressed().serialize();
+    }
+
+    std::vector<uint8_t> serialized_digest;
+    serialized_digest.reserve(3 * sizeof(double) + m_centroids.size() * (sizeof(double) + 2) + 4);
+    serialized_digest.push_back(cSerializationVersion);
+    write_double(m_compression, serialized_digest);
+    write_double(m_min, serialized_digest);
+    write_double(m_max, serialized_digest);
+    write_varint(m_centroids.size(), serialized_digest);
+    for (auto const& centroid : m_centroids) {
+        write_double(centroid.mean, serialized_digest);
+        write_varint(centroid.weight, serialized_digest);
+    }
+    return serialized_digest;
+}
+
+void TDigest::compress() {
+    if (m_buffer.empty()) {
+        return;
+    }
+
+    m_buffer.insert(m_buffer.end(), m_centroids.cbegin(), m_centroids.cend());
+    std::sort(m_buffer.begin(), m_buffer.end(), [](Centroid const& lhs, Centroid const& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    auto const total_weight = static_cast<double>(m_count);
+    std::vector<Centroid> merged_centroids;
+    merged_centroids.reserve(m_centroids.size() + 1);
+    auto current = m_buffer.front();
+    double weight_so_far{0.0};
+    auto weight_limit = total_weight * get_quantile_limit(m_compression, 0.0);
+    for (size_t i = 1; i < m_buffer.size(); ++i) {
+        auto const& next = m_buffer[i];
+        auto const merged_weight = static_cast<double>(current.weight + next.weight);
+        if (weight_so_far + merged_weight <= weight_limit) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * static_cast<double>(next.weight)
+                            / static_cast<double>(current.weight);
+        } else {
+            weight_so_far += static_cast<double>(current.weight);
+            merged_centroids.push_back(current);
+            weight_limit = total_weight
+                           * get_quantile_limit(m_compression, weight_so_far / total_weight);
+            current = next;
+        }
+    }
+    merged_centroids.push_back(current);
+
+    m_centroids = std::move(merged_centroids);
+    m_buffer.clear();
+}
+
+TDigest TDigest::compressed() const {
+    auto digest = *this;
+    digest.compress();
+    return digest;
+}
+}  // namespace reducer
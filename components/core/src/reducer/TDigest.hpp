@@ -0,0 +1,99 @@
+#ifndef REDUCER_TDIGEST_HPP
+#define REDUCER_TDIGEST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace reducer {
+/**
+ * A merging t-digest that estimates quantiles of the values added to it using memory proportional
+ * to its compression factor rather than to the number of values.
+ *
+ * The digest summarizes values as weighted centroids, keeping centroids small near the tails of the
+ * distribution so that extreme quantiles (e.g., p99) remain accurate. Digests can be merged, making
+ * them suitable for aggregating quantiles across search workers: each worker sends a partial digest
+ * and the reducer merges them.
+ */
+class TDigest {
+public:
+    // Constants
+    static constexpr double cDefaultCompression{100.0};
+
+    // Constructors
+    /**
+     * @param compression Bounds the number of centroids (roughly 2 * compression), trading memory
+     * for accuracy.
+     * @throw std::invalid_argument if the compression isn't positive.
+     */
+    explicit TDigest(double compression = cDefaultCompression);
+
+    // Methods
+    /**
+     * Deserializes a digest produced by serialize().
+     * @param serialized_digest
+     * @return The digest on success, or std::nullopt if the serialized digest is malformed.
+     */
+    [[nodiscard]] static std::optional<TDigest>
+    deserialize(std::span<uint8_t const> serialized_digest);
+
+    [[nodiscard]] uint64_t get_count() const { return m_count; }
+
+    [[nodiscard]] bool empty() const { return 0 == m_count; }
+
+    /**
+     * Adds a value to the digest. NaN values are ignored.
+     * @param value
+     */
+    void add(double value);
+
+    /**
+     * Merges another digest into this one.
+     * @param other
+     */
+    void merge(TDigest const& other);
+
+    /**
+     * @param q A quantile in [0, 1].
+     * @return The estimated value at the given quantile, or NaN if the digest is empty.
+     */
+    [[nodiscard]] double quantile(double q) const;
+
+    /**
+     * @return The serialized digest.
+     */
+    [[nodiscard]] std::vector<uint8_t> serialize() const;
+
+private:
+    // Types
+    struct Centroid {
+        double mean;
+        uint64_t weight;
+    };
+
+    // Methods
+    /**
+     * Merges the buffered centroids into the digest's centroids, combining adjacent centroids as
+     * long as they stay within the size bound for their position in the distribution.
+     */
+    void compress();
+
+    /**
+     * @return A copy of the digest with no buffered centroids.
+     */
+    [[nodiscard]] TDigest compressed() const;
+
+    // Variables
+    double m_compression;
+    size_t m_buffer_capacity{0};
+    std::vector<Centroid> m_centroids;
+    std::vector<Centroid> m_buffer;
+    uint64_t m_count{0};
+    double m_min{0.0};
+    double m_max{0.0};
+};
+}  // namespace reducer
+
+#endif  // REDUCER_TDIGEST_HPP
@@ -0,0 +1,139 @@
+#include "CommandLineArguments.hpp"
+
+#include <iostream>
+
+#include <boost/program_options.hpp>
+
+#include "../../clp/spdlog_with_specializations.hpp"
+
+namespace po = boost::program_options;
+
+namespace reducer::load_generator {
+clp::CommandLineArgumentsBase::ParsingResult
+CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
+    try {
+        po::options_description options_general("General Options");
+        options_general.add_options()("help,h", "Print help");
+
+        po::options_description options_load_generator("Load Generator Options");
+        options_load_generator.add_options()(
+            "reducer-host",
+            po::value<std::string>(&m_reducer_host)
+                ->default_value(m_reducer_host),
+            "Host the reducer is running on"
+        )(
+            "reducer-port",
+            po::value<int>(&m_reducer_port)
+                ->default_value(m_reducer_port),
+            "Port the reducer is listening on"
+        )(
+            "job-id",
+            po::value<job_id_t>(&m_job_id),
+            "ID of the job the reducer is running"
+        )(
+            "num-connections",
+            po::value<size_t>(&m_num_connections)
+                ->default_value(m_num_connections),
+            "Number of concurrent connections to replay the recording over, each acting as a"
+            " search worker"
+        )(
+            "num-repetitions",
+            po::value<size_t>(&m_num_repetitions)
+                ->default_value(m_num_repetitions),
+            "Number of times each connection replays the recording"
+        )(
+            "generate-num-groups",
+            po::value<size_t>(&m_num_groups_to_generate)
+                ->default_value(m_num_groups_to_generate),
+            "Instead of replaying the recording, write a synthetic recording of count results with"
+            " this many distinct groups to the recording path"
+        );
+
+        po::options_description options_positional;
+        options_positional.add_options()(
+            "recording-path",
+            po::value<std::string>(&m_recording_path)
+        );
+        po::positional_options_description positional_options_description;
+        positional_options_description.add("recording-path", 1);
+
+        po::options_description visible_options;
+        visible_options.add(options_general);
+        visible_options.add(options_load_generator);
+
+        po::options_description all_options;
+        all_options.add(visible_options);
+        all_options.add(options_positional);
+
+        po::variables_map parsed_command_line_options;
+        po::store(
+                po::command_line_parser(argc, argv)
+                        .options(all_options)
+                        .positional(positional_options_description)
+                        .run(),
+                parsed_command_line_options
+        );
+        po::notify(parsed_command_line_options);
+
+        if (parsed_command_line_options.count("help")) {
+            if (argc > 2) {
+                SPDLOG_WARN("Ignoring all options besides --help.");
+            }
+
+            print_basic_usage();
+            std::cerr << std::endl;
+            std::cerr << "The recording contains record groups in the format search workers send"
+                         " them to the reducer (i.e., each"
+                      << std::endl;
+            std::cerr << "serialized record group is prefixed by its size)." << std::endl;
+            std::cerr << std::endl;
+            std::cerr << visible_options << std::endl;
+            return ParsingResult::InfoCommand;
+        }
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("Failed to parse command line arguments - {}", e.what());
+        return ParsingResult::Failure;
+    }
+
+    // Validate arguments
+    try {
+        if (m_recording_path.empty()) {
+            throw std::invalid_argument("recording-path not specified or empty.");
+        }
+
+        if (0 == m_num_groups_to_generate) {
+            if (m_reducer_host.empty()) {
+                throw std::invalid_argument("reducer-host cannot be empty.");
+            }
+
+            if (m_reducer_port <= 0) {
+                throw std::invalid_argument("reducer-port cannot be <= 0.");
+            }
+
+            if (m_job_id < 0) {
+                throw std::invalid_argument("job-id not specified or < 0.");
+            }
+
+            if (0 == m_num_connections) {
+                throw std::invalid_argument("num-connections cannot be 0.");
+            }
+
+            if (0 == m_num_repetitions) {
+                throw std::invalid_argument("num-repetitions cannot be 0.");
+            }
+        }
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("Failed to validate command line arguments - {}", e.what());
+        print_basic_usage();
+        std::cerr << "Try " << get_program_name() << " --help for detailed usage instructions"
+                  << std::endl;
+        return ParsingResult::Failure;
+    }
+
+    return ParsingResult::Success;
+}
+
+void CommandLineArguments::print_basic_usage() const {
+    std::cerr << "Usage: " << get_program_name() << " [OPTIONS] RECORDING_PATH" << std::endl;
+}
+}  // namespace reducer::load_generator
@@ -0,0 +1,56 @@
+#ifndef REDUCER_LOAD_GENERATOR_COMMANDLINEARGUMENTS_HPP
+#define REDUCER_LOAD_GENERATOR_COMMANDLINEARGUMENTS_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "../../clp/CommandLineArgumentsBase.hpp"
+#include "../types.hpp"
+
+namespace reducer::load_generator {
+/**
+ * Class which parses and validates command line arguments for the reducer load generator.
+ */
+class CommandLineArguments : public clp::CommandLineArgumentsBase {
+public:
+    // Constructors
+    explicit CommandLineArguments(std::string const& program_name)
+            : clp::CommandLineArgumentsBase{program_name} {}
+
+    // Methods
+    ParsingResult parse_arguments(int argc, char const* argv[]) override;
+
+    [[nodiscard]] std::string const& get_recording_path() const { return m_recording_path; }
+
+    [[nodiscard]] std::string const& get_reducer_host() const { return m_reducer_host; }
+
+    [[nodiscard]] int get_reducer_port() const { return m_reducer_port; }
+
+    [[nodiscard]] job_id_t get_job_id() const { return m_job_id; }
+
+    [[nodiscard]] size_t get_num_connections() const { return m_num_connections; }
+
+    [[nodiscard]] size_t get_num_repetitions() const { return m_num_repetitions; }
+
+    /**
+     * @return The number of record groups to generate into a synthetic recording, or 0 if an
+     * existing recording should be replayed instead.
+     */
+    [[nodiscard]] size_t get_num_groups_to_generate() const { return m_num_groups_to_generate; }
+
+private:
+    // Methods
+    void print_basic_usage() const override;
+
+    // Variables
+    std::string m_recording_path;
+    std::string m_reducer_host{"127.0.0.1"};
+    int m_reducer_port{14'009};
+    job_id_t m_job_id{-1};
+    size_t m_num_connections{64};
+    size_t m_num_repetitions{1};
+    size_t m_num_groups_to_generate{0};
+};
+}  // namespace reducer::load_generator
+
+#endif  // REDUCER_LOAD_GENERATOR_COMMANDLINEARGUMENTS_HPP
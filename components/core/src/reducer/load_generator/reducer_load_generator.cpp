@@ -0,0 +1,246 @@
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+#include <spdlog/sinks/stdout_sinks.h>
+
+#include "../../clp/ErrorCode.hpp"
+#include "../../clp/networking/socket_utils.hpp"
+#include "../../clp/spdlog_with_specializations.hpp"
+#include "../CountOperator.hpp"
+#include "../DeserializedRecordGroup.hpp"
+#include "../GroupTags.hpp"
+#include "../network_utils.hpp"
+#include "../RecordGroupIterator.hpp"
+#include "CommandLineArguments.hpp"
+
+namespace reducer::load_generator { namespace {
+/**
+ * Reads a recording of serialized record groups and validates that each record group can be
+ * deserialized.
+ * @param path
+ * @param recording Returns the recording's content.
+ * @param num_record_groups Returns the number of record groups in the recording.
+ * @return Whether the recording was read and validated successfully.
+ */
+bool
+read_recording(std::string const& path, std::vector<char>& recording, size_t& num_record_groups);
+
+/**
+ * Writes a synthetic recording of count results for the given number of distinct groups, each
+ * tagged with its index, so that it can be used for both regular and timeline aggregations.
+ * @param path
+ * @param num_record_groups
+ * @return Whether the recording was written successfully.
+ */
+bool write_synthetic_recording(std::string const& path, size_t num_record_groups);
+
+/**
+ * Replays the recording over the given number of concurrent connections to the reducer, each acting
+ * as a search worker that sends the entire recording the given number of times.
+ * @param args
+ * @param recording
+ * @return The number of connections that failed.
+ */
+size_t replay_recording(CommandLineArguments const& args, std::vector<char> const& recording);
+
+bool
+read_recording(std::string const& path, std::vector<char>& recording, size_t& num_record_groups) {
+    std::ifstream file{path, std::ios::binary};
+    if (false == file.is_open()) {
+        SPDLOG_ERROR("Failed to open {}", path);
+        return false;
+    }
+    recording.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+
+    num_record_groups = 0;
+    size_t pos{0};
+    while (pos < recording.size()) {
+        size_t record_group_size{0};
+        if (recording.size() - pos < sizeof(record_group_size)) {
+            SPDLOG_ERROR("Truncated record group size at offset {}", pos);
+            return false;
+        }
+        std::memcpy(&record_group_size, &recording[pos], sizeof(record_group_size));
+        pos += sizeof(record_group_size);
+        if (recording.size() - pos < record_group_size) {
+            SPDLOG_ERROR("Truncated record group at offset {}", pos);
+            return false;
+        }
+        try {
+            DeserializedRecordGroup const record_group{&recording[pos], record_group_size};
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to deserialize record group at offset {} - {}", pos, e.what());
+            return false;
+        }
+        pos += record_group_size;
+        ++num_record_groups;
+    }
+    return true;
+}
+
+bool write_synthetic_recording(std::string const& path, size_t num_record_groups) {
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (false == file.is_open()) {
+        SPDLOG_ERROR("Failed to open {}", path);
+        return false;
+    }
+
+    absl::flat_hash_map<GroupTags, int64_t> group_counts;
+    for (size_t i = 0; i < num_record_groups; ++i) {
+        group_counts[GroupTags{std::to_string(i)}] = 1;
+    }
+    Int64MapRecordGroupIterator group_it{
+            group_counts,
+            static_cast<char const*>(CountOperator::cRecordElementKey)
+    };
+    for (; false == group_it.done(); group_it.next()) {
+        auto& group = group_it.get();
+        auto serialized_group = serialize(group.get_tags(), group.record_iter());
+        auto serialized_group_size = serialized_group.size();
+        file.write(
+                reinterpret_cast<char const*>(&serialized_group_size),
+                sizeof(serialized_group_size)
+        );
+        file.write(
+                reinterpret_cast<char const*>(serialized_group.data()),
+                static_cast<std::streamsize>(serialized_group.size())
+        );
+    }
+
+    file.close();
+    if (file.fail()) {
+        SPDLOG_ERROR("Failed to write {}", path);
+        return false;
+    }
+    return true;
+}
+
+size_t replay_recording(CommandLineArguments const& args, std::vector<char> const& recording) {
+    std::atomic_size_t num_failed_connections{0};
+    std::vector<std::thread> connection_threads;
+    connection_threads.reserve(args.get_num_connections());
+    for (size_t i = 0; i < args.get_num_connections(); ++i) {
+        connection_threads.emplace_back([&]() {
+            auto reducer_socket_fd = connect_to_reducer(
+                    args.get_reducer_host(),
+                    args.get_reducer_port(),
+                    args.get_job_id()
+            );
+            if (-1 == reducer_socket_fd) {
+                ++num_failed_connections;
+                return;
+            }
+            for (size_t j = 0; j < args.get_num_repetitions(); ++j) {
+                if (clp::ErrorCode_Success
+                    != clp::networking::try_send(
+                            reducer_socket_fd,
+                            recording.data(),
+                            recording.size()
+                    ))
+                {
+                    ++num_failed_connections;
+                    break;
+                }
+            }
+            close(reducer_socket_fd);
+        });
+    }
+    for (auto& thread : connection_threads) {
+        thread.join();
+    }
+    return num_failed_connections.load();
+}
+}}  // namespace reducer::load_generator
+
+int main(int argc, char const* argv[]) {
+    // Program-wide initialization
+    try {
+        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        spdlog::set_default_logger(stderr_logger);
+        spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
+    } catch (std::exception& e) {
+        // NOTE: We can't log an exception if the logger couldn't be constructed
+        return 1;
+    }
+
+    reducer::load_generator::CommandLineArguments args{"reducer-load-generator"};
+    auto parsing_result = args.parse_arguments(argc, argv);
+    if (clp::CommandLineArgumentsBase::ParsingResult::Failure == parsing_result) {
+        return 1;
+    } else if (clp::CommandLineArgumentsBase::ParsingResult::InfoCommand == parsing_result) {
+        return 0;
+    }
+
+    if (args.get_num_groups_to_generate() > 0) {
+        if (false
+            == reducer::load_generator::write_synthetic_recording(
+                    args.get_recording_path(),
+                    args.get_num_groups_to_generate()
+            ))
+        {
+            return 1;
+        }
+        SPDLOG_INFO(
+                "Wrote {} record groups to {}",
+                args.get_num_groups_to_generate(),
+                args.get_recording_path()
+        );
+        return 0;
+    }
+
+    std::vector<char> recording;
+    size_t num_record_groups{0};
+    if (false
+        == reducer::load_generator::read_recording(
+                args.get_recording_path(),
+                recording,
+                num_record_groups
+        ))
+    {
+        return 1;
+    }
+
+    SPDLOG_INFO(
+            "Replaying {} record groups ({}B) over {} connections, {} time(s) each",
+            num_record_groups,
+            recording.size(),
+            args.get_num_connections(),
+            args.get_num_repetitions()
+    );
+    auto const start_time = std::chrono::steady_clock::now();
+    auto const num_failed_connections
+            = reducer::load_generator::replay_recording(args, recording);
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start_time;
+
+    auto const num_successful_connections = args.get_num_connections() - num_failed_connections;
+    auto const num_record_groups_sent
+            = num_successful_connections * args.get_num_repetitions() * num_record_groups;
+    auto const num_bytes_sent
+            = num_successful_connections * args.get_num_repetitions() * recording.size();
+    SPDLOG_INFO(
+            "Sent {} record groups ({}B) in {:.3f}s: {:.0f} record groups/s, {:.2f} MiB/s",
+            num_record_groups_sent,
+            num_bytes_sent,
+            elapsed.count(),
+            static_cast<double>(num_record_groups_sent) / elapsed.count(),
+            static_cast<double>(num_bytes_sent) / elapsed.count() / (1024 * 1024)
+    );
+
+    if (num_failed_connections > 0) {
+        SPDLOG_ERROR("{} connection(s) failed", num_failed_connections);
+        return 1;
+    }
+    return 0;
+}
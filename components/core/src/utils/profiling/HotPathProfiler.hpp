@@ -0,0 +1,341 @@
+#ifndef UTILS_PROFILING_HOTPATHPROFILER_HPP
+#define UTILS_PROFILING_HOTPATHPROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(CLP_ENABLE_PROFILING) && CLP_ENABLE_PROFILING > 0
+    #include <algorithm>
+    #include <array>
+    #include <atomic>
+    #include <chrono>
+    #include <deque>
+    #include <limits>
+    #include <mutex>
+    #include <string>
+    #include <vector>
+
+    #if defined(__x86_64__) || defined(_M_X64)
+        #include <x86intrin.h>
+    #endif
+
+    #include <spdlog/spdlog.h>
+    #include <utils/profiling/Stopwatch.hpp>
+#endif
+
+namespace utils::profiling {
+/**
+ * The maximum number of distinct scopes that can be registered with `HotPathProfiler`.
+ */
+constexpr size_t cMaxHotPathScopes{256};
+
+#if defined(CLP_ENABLE_PROFILING) && CLP_ENABLE_PROFILING > 0
+/**
+ * Low-overhead profiler for scopes and counters on hot paths (e.g., per-record or per-table loops).
+ *
+ * Unlike `Profiler`, which builds a hierarchical name and looks up a string-keyed map on every
+ * measurement, each `PROFILE_HOT_*` call site registers its name once, the first time it runs, and
+ * afterwards only uses the resulting integer ID. Measurements are accumulated into a fixed array of
+ * thread-local slots indexed by that ID, so the hot path never allocates, hashes, or takes a lock.
+ * Timing uses the CPU's timestamp counter on x86-64 and `std::chrono::steady_clock` otherwise.
+ *
+ * All threads' slots are merged when measurements are reported via `for_each_measurement`. Each
+ * slot only ever has a single writer (its thread), so reporting never contends with measuring.
+ *
+ * NOTE: Scope names are flat (no scope path is prepended) and nested invocations of the same call
+ * site are each counted, so hot-path scopes shouldn't be used in recursive functions.
+ */
+class HotPathProfiler {
+public:
+    // Constants
+    // ID used for call sites that couldn't be registered since all scope IDs are in use. Their
+    // measurements are discarded.
+    static constexpr size_t cOverflowScopeId{cMaxHotPathScopes};
+
+    // Static methods
+    /**
+     * Registers a scope name. Registering the same name more than once returns the same ID.
+     *
+     * @param name
+     * @return The scope's ID, or `cOverflowScopeId` if all scope IDs are already in use.
+     */
+    [[nodiscard]] static auto register_scope(std::string_view name) -> size_t {
+        auto& state{get_state()};
+        std::lock_guard const lock{state.mutex};
+        auto const it{std::find(state.scope_names.cbegin(), state.scope_names.cend(), name)};
+        if (it != state.scope_names.cend()) {
+            return static_cast<size_t>(it - state.scope_names.cbegin());
+        }
+        if (state.scope_names.size() >= cMaxHotPathScopes) {
+            SPDLOG_ERROR("Too many hot-path profiler scopes; discarding measurements of {}", name);
+            return cOverflowScopeId;
+        }
+        state.scope_names.emplace_back(name);
+        return state.scope_names.size() - 1;
+    }
+
+    /**
+     * @return The current value of the tick counter used to time scopes.
+     */
+    [[nodiscard]] static auto read_ticks() -> uint64_t {
+    #if defined(__x86_64__) || defined(_M_X64)
+        return __rdtsc();
+    #else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    #endif
+    }
+
+    /**
+     * Adds to the current thread's measurement for the given scope.
+     *
+     * @param scope_id
+     * @param call_count
+     * @param ticks
+     */
+    static auto add(size_t scope_id, uint64_t call_count, uint64_t ticks) -> void {
+        auto& slot{get_thread_slots().slots[scope_id]};
+        // Only the current thread writes to its slots, so there's no need for an atomic
+        // read-modify-write; the atomics only ensure concurrent reporting reads whole values.
+        slot.call_count.store(
+                slot.call_count.load(std::memory_order_relaxed) + call_count,
+                std::memory_order_relaxed
+        );
+        slot.ticks.store(
+                slot.ticks.load(std::memory_order_relaxed) + ticks,
+                std::memory_order_relaxed
+        );
+    }
+
+    /**
+     * Merges the measurements of all threads and calls `callback` for each scope that has been
+     * invoked since the previous call to this method.
+     *
+     * @param callback A callable taking `(std::string_view name, Measurement)`.
+     */
+    template <typename Callback>
+    static auto for_each_measurement(Callback callback) -> void {
+        auto& state{get_state()};
+        std::lock_guard const lock{state.mutex};
+
+        auto totals{state.retired_totals};
+        for (auto const* thread_slots : state.live_thread_slots) {
+            for (size_t i = 0; i < state.scope_names.size(); ++i) {
+                auto const& slot{thread_slots->slots[i]};
+                totals[i].call_count += slot.call_count.load(std::memory_order_relaxed);
+                totals[i].ticks += slot.ticks.load(std::memory_order_relaxed);
+            }
+        }
+
+        auto const ns_per_tick{state.get_ns_per_tick()};
+        for (size_t i = 0; i < state.scope_names.size(); ++i) {
+            auto const call_count{totals[i].call_count - state.reported_totals[i].call_count};
+            if (0 == call_count) {
+                continue;
+            }
+            auto const ticks{totals[i].ticks - state.reported_totals[i].ticks};
+            Measurement const measurement{
+                    .call_count = static_cast<uint32_t>(
+                            std::min<uint64_t>(call_count, std::numeric_limits<uint32_t>::max())
+                    ),
+                    .duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::nanoseconds{
+                                    static_cast<int64_t>(static_cast<double>(ticks) * ns_per_tick)
+                            }
+                    )
+            };
+            callback(std::string_view{state.scope_names[i]}, measurement);
+        }
+        state.reported_totals = totals;
+    }
+
+private:
+    // Types
+    struct Slot {
+        std::atomic<uint64_t> call_count{0};
+        std::atomic<uint64_t> ticks{0};
+    };
+
+    struct Total {
+        uint64_t call_count{0};
+        uint64_t ticks{0};
+    };
+
+    struct ThreadSlots;
+
+    // The extra slot holds the measurements of overflowing scopes.
+    using Totals = std::array<Total, cMaxHotPathScopes + 1>;
+
+    /**
+     * Process-wide registry of scope names and threads' slots.
+     */
+    struct State {
+        /**
+         * @return The number of nanoseconds per tick, calibrated against the steady clock over the
+         * lifetime of the process.
+         */
+        [[nodiscard]] auto get_ns_per_tick() const -> double {
+    #if defined(__x86_64__) || defined(_M_X64)
+            auto const elapsed_ticks{read_ticks() - creation_ticks};
+            auto const elapsed_time{std::chrono::steady_clock::now() - creation_time};
+            auto const elapsed_ns{
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed_time).count()
+            };
+            if (0 == elapsed_ticks || elapsed_ns <= 0) {
+                return 1.0;
+            }
+            return static_cast<double>(elapsed_ns) / static_cast<double>(elapsed_ticks);
+    #else
+            return static_cast<double>(std::chrono::steady_clock::period::num) * 1e9
+                   / static_cast<double>(std::chrono::steady_clock::period::den);
+    #endif
+        }
+
+        std::mutex mutex;
+        // A deque so that the names' storage is stable while they're reported
+        std::deque<std::string> scope_names;
+        std::vector<ThreadSlots const*> live_thread_slots;
+        // Measurements from threads that have exited
+        Totals retired_totals{};
+        // Measurements that have already been reported
+        Totals reported_totals{};
+        uint64_t creation_ticks{read_ticks()};
+        std::chrono::steady_clock::time_point creation_time{std::chrono::steady_clock::now()};
+    };
+
+    /**
+     * A thread's slots, which register themselves with the process-wide state on construction and
+     * fold their measurements into the state's retired totals on destruction.
+     */
+    struct ThreadSlots {
+        // Constructors
+        ThreadSlots() {
+            auto& state{get_state()};
+            std::lock_guard const lock{state.mutex};
+            state.live_thread_slots.push_back(this);
+        }
+
+        // Delete copy constructor and assignment operator
+        ThreadSlots(ThreadSlots const&) = delete;
+        auto operator=(ThreadSlots const&) -> ThreadSlots& = delete;
+
+        // Delete move constructor and assignment operator
+        ThreadSlots(ThreadSlots&&) = delete;
+        auto operator=(ThreadSlots&&) -> ThreadSlots& = delete;
+
+        // Destructor
+        ~ThreadSlots() {
+            auto& state{get_state()};
+            std::lock_guard const lock{state.mutex};
+            for (size_t i = 0; i < slots.size(); ++i) {
+                state.retired_totals[i].call_count
+                        += slots[i].call_count.load(std::memory_order_relaxed);
+                state.retired_totals[i].ticks += slots[i].ticks.load(std::memory_order_relaxed);
+            }
+            std::erase(state.live_thread_slots, this);
+        }
+
+        // Data members
+        std::array<Slot, cMaxHotPathScopes + 1> slots;
+    };
+
+    // Static methods
+    [[nodiscard]] static auto get_state() -> State& {
+        // Intentionally leaked so that it outlives any thread-local slots destroyed during exit.
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        static auto* const state{new State{}};
+        return *state;
+    }
+
+    [[nodiscard]] static auto get_thread_slots() -> ThreadSlots& {
+        static thread_local ThreadSlots thread_slots;
+        return thread_slots;
+    }
+};
+
+/**
+ * RAII wrapper that times a hot-path scope from construction to destruction.
+ *
+ * Should only be used through the `PROFILE_HOT_SCOPE` macro.
+ */
+class HotPathScope {
+public:
+    // Constructors
+    explicit HotPathScope(size_t scope_id)
+            : m_scope_id{scope_id},
+              m_begin_ticks{HotPathProfiler::read_ticks()} {}
+
+    // Delete copy constructor and assignment operator
+    HotPathScope(HotPathScope const&) = delete;
+    auto operator=(HotPathScope const&) -> HotPathScope& = delete;
+
+    // Delete move constructor and assignment operator
+    HotPathScope(HotPathScope&&) = delete;
+    auto operator=(HotPathScope&&) -> HotPathScope& = delete;
+
+    // Destructor
+    ~HotPathScope() {
+        HotPathProfiler::add(m_scope_id, 1, HotPathProfiler::read_ticks() - m_begin_ticks);
+    }
+
+private:
+    // Data members
+    size_t m_scope_id;
+    uint64_t m_begin_ticks;
+};
+#else
+/**
+ * Stub used when profiling is disabled (`CLP_ENABLE_PROFILING == 0`).
+ */
+class HotPathProfiler {
+public:
+    // Static methods
+    [[nodiscard]] static auto register_scope(std::string_view name) -> size_t { return 0; }
+
+    [[nodiscard]] static auto read_ticks() -> uint64_t { return 0; }
+
+    static auto add(size_t scope_id, uint64_t call_count, uint64_t ticks) -> void {}
+
+    template <typename Callback>
+    static auto for_each_measurement(Callback callback) -> void {}
+};
+#endif  // defined(CLP_ENABLE_PROFILING) && CLP_ENABLE_PROFILING > 0
+}  // namespace utils::profiling
+
+/**
+ * `PROFILE_HOT_SCOPE` times the current scope and `PROFILE_HOT_COUNT` adds to a counter, both
+ * through `HotPathProfiler`. Each call site's name is registered once, in a function-local static,
+ * so `name` must be the same every time a call site runs.
+ *
+ * Set `CLP_ENABLE_PROFILING=1` to enable both macros. When profiling is disabled, both macros
+ * expand to no-ops.
+ */
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#if defined(CLP_ENABLE_PROFILING) && CLP_ENABLE_PROFILING > 0
+    #define PROFILE_HOT_SCOPE_IMPL(counter, name) \
+        static ::std::size_t const _prof_hot_scope_id_##counter{ \
+                ::utils::profiling::HotPathProfiler::register_scope(name) \
+        }; \
+        ::utils::profiling::HotPathScope const _prof_hot_scope_##counter { \
+            _prof_hot_scope_id_##counter \
+        }
+
+    #define PROFILE_HOT_COUNT_IMPL(counter, name, count) \
+        static ::std::size_t const _prof_hot_count_id_##counter{ \
+                ::utils::profiling::HotPathProfiler::register_scope(name) \
+        }; \
+        ::utils::profiling::HotPathProfiler::add(_prof_hot_count_id_##counter, count, 0)
+
+    #define PROFILE_HOT_SCOPE_EXPAND(counter, name) PROFILE_HOT_SCOPE_IMPL(counter, name)
+    #define PROFILE_HOT_COUNT_EXPAND(counter, name, count) \
+        PROFILE_HOT_COUNT_IMPL(counter, name, count)
+
+    #define PROFILE_HOT_SCOPE(name) PROFILE_HOT_SCOPE_EXPAND(__COUNTER__, name)
+    #define PROFILE_HOT_COUNT(name, count) PROFILE_HOT_COUNT_EXPAND(__COUNTER__, name, count)
+#else
+    #define PROFILE_HOT_SCOPE(name) (void)0
+    #define PROFILE_HOT_COUNT(name, count) (void)0
+#endif
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#endif  // UTILS_PROFILING_HOTPATHPROFILER_HPP
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#undef CLP_ENABLE_PROFILING
+// NOLINTNEXTLINE
+#define CLP_ENABLE_PROFILING 1
+
+#include <utils/profiling/HotPathProfiler.hpp>
+#include <utils/profiling/Stopwatch.hpp>
+#include <utils/profiling/test/emitters.hpp>
+
+namespace utils::profiling::test {
+namespace {
+/**
+ * @return The measurements reported by `HotPathProfiler` since the last report, keyed by name.
+ */
+auto collect_measurements() -> std::map<std::string, Measurement>;
+
+auto collect_measurements() -> std::map<std::string, Measurement> {
+    std::map<std::string, Measurement> measurements;
+    HotPathProfiler::for_each_measurement(
+            [&](std::string_view name, Measurement measurement) -> void {
+                measurements.emplace(std::string{name}, measurement);
+            }
+    );
+    return measurements;
+}
+}  // namespace
+
+TEST_CASE("hot_path_scope_accumulates_calls", "[HotPathProfiler]") {
+    std::ignore = collect_measurements();
+    for (size_t i = 0; i < 2; ++i) {
+        PROFILE_HOT_SCOPE("test.hot_scope");
+        std::this_thread::sleep_for(cSleep);
+    }
+
+    auto const measurements{collect_measurements()};
+    REQUIRE(1 == measurements.size());
+    auto const& measurement{measurements.at("test.hot_scope")};
+    REQUIRE(2U == measurement.call_count);
+    // Allow for some error in calibrating the tick rate
+    REQUIRE(measurement.duration >= std::chrono::milliseconds(cSleep));
+
+    // Measurements should only be reported once
+    REQUIRE(collect_measurements().empty());
+}
+
+TEST_CASE("hot_path_counters_merge_across_threads", "[HotPathProfiler]") {
+    constexpr size_t cNumThreads{4};
+    constexpr uint64_t cNumIncrementsPerThread{1000};
+
+    std::ignore = collect_measurements();
+    std::vector<std::thread> threads;
+    threads.reserve(cNumThreads);
+    for (size_t i = 0; i < cNumThreads; ++i) {
+        threads.emplace_back([]() -> void {
+            for (uint64_t j = 0; j < cNumIncrementsPerThread; ++j) {
+                PROFILE_HOT_COUNT("test.hot_counter", 1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    PROFILE_HOT_COUNT("test.hot_counter", 5);
+
+    auto const measurements{collect_measurements()};
+    REQUIRE(1 == measurements.size());
+    auto const& measurement{measurements.at("test.hot_counter")};
+    REQUIRE(cNumThreads * cNumIncrementsPerThread + 5 == measurement.call_count);
+    REQUIRE(measurement.duration.count() == 0);
+}
+
+TEST_CASE("hot_path_registration_is_idempotent", "[HotPathProfiler]") {
+    auto const scope_id{HotPathProfiler::register_scope("test.registered")};
+    REQUIRE(HotPathProfiler::cOverflowScopeId != scope_id);
+    REQUIRE(scope_id == HotPathProfiler::register_scope("test.registered"));
+    REQUIRE(scope_id != HotPathProfiler::register_scope("test.other_registered"));
+}
+}  // namespace utils::profiling::test
@@ -0,0 +1,176 @@
+#include "LocalHttpServer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+LocalHttpServer::LocalHttpServer(std::vector<char> data, Options options)
+        : m_data{std::move(data)},
+          m_options{options} {
+    m_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(m_listen_fd >= 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    REQUIRE(0 == bind(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+    REQUIRE(0 == listen(m_listen_fd, SOMAXCONN));
+
+    socklen_t addr_len{sizeof(addr)};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    REQUIRE(0 == getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len));
+    m_port = ntohs(addr.sin_port);
+
+    m_server_thread = std::thread{[this]() { serve(); }};
+}
+
+LocalHttpServer::~LocalHttpServer() {
+    m_stopped.store(true);
+    // Unblock `accept`
+    shutdown(m_listen_fd, SHUT_RDWR);
+    m_server_thread.join();
+    close(m_listen_fd);
+    std::lock_guard<std::mutex> const lock{m_connection_threads_mutex};
+    for (auto& thread : m_connection_threads) {
+        thread.join();
+    }
+}
+
+auto LocalHttpServer::get_url() const -> std::string {
+    return fmt::format("http://127.0.0.1:{}/data", m_port);
+}
+
+auto LocalHttpServer::parse_range_header(std::string_view request)
+        -> std::optional<std::pair<size_t, size_t>> {
+    std::string lower_request{request};
+    std::transform(
+            lower_request.begin(),
+            lower_request.end(),
+            lower_request.begin(),
+            [](unsigned char c) -> char { return static_cast<char>(std::tolower(c)); }
+    );
+    constexpr std::string_view cRangeHeaderPrefix{"\r\nrange: bytes="};
+    auto const header_pos{lower_request.find(cRangeHeaderPrefix)};
+    if (std::string::npos == header_pos) {
+        return std::nullopt;
+    }
+    auto const value_pos{header_pos + cRangeHeaderPrefix.size()};
+    auto const value_end_pos{lower_request.find("\r\n", value_pos)};
+    auto const value{lower_request.substr(value_pos, value_end_pos - value_pos)};
+    auto const dash_pos{value.find('-')};
+    auto const begin{std::stoull(value.substr(0, dash_pos))};
+    auto const end_str{value.substr(dash_pos + 1)};
+    size_t const end{end_str.empty() ? SIZE_MAX : std::stoull(end_str)};
+    return std::make_pair(begin, end);
+}
+
+auto LocalHttpServer::serve() -> void {
+    while (false == m_stopped.load()) {
+        auto const connection_fd{accept(m_listen_fd, nullptr, nullptr)};
+        if (connection_fd < 0) {
+            continue;
+        }
+        std::lock_guard<std::mutex> const lock{m_connection_threads_mutex};
+        m_connection_threads.emplace_back([this, connection_fd]() {
+            handle_connection(connection_fd);
+        });
+    }
+}
+
+auto LocalHttpServer::handle_connection(int connection_fd) -> void {
+    std::string request;
+    std::vector<char> buf(4096);
+    while (std::string::npos == request.find("\r\n\r\n")) {
+        auto const num_bytes_received{recv(connection_fd, buf.data(), buf.size(), 0)};
+        if (num_bytes_received <= 0) {
+            close(connection_fd);
+            return;
+        }
+        request.append(buf.data(), static_cast<size_t>(num_bytes_received));
+    }
+    ++m_num_requests;
+    auto const num_concurrent_requests{++m_num_concurrent_requests};
+    auto max_num_concurrent_requests{m_max_num_concurrent_requests.load()};
+    while (num_concurrent_requests > max_num_concurrent_requests
+           && false
+                      == m_max_num_concurrent_requests.compare_exchange_weak(
+                              max_num_concurrent_requests,
+                              num_concurrent_requests
+                      ))
+    {}
+
+    std::string header;
+    std::string_view body{m_data.data(), m_data.size()};
+    auto const range{m_options.support_ranges ? parse_range_header(request) : std::nullopt};
+    if (range.has_value() && range->first < m_data.size()) {
+        auto const last{std::min(range->second, m_data.size() - 1)};
+        body = body.substr(range->first, last - range->first + 1);
+        header = fmt::format(
+                "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes {}-{}/{}\r\n",
+                range->first,
+                last,
+                m_data.size()
+        );
+    } else if (range.has_value()) {
+        body = {};
+        header = fmt::format(
+                "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */{}\r\n",
+                m_data.size()
+        );
+    } else {
+        header = "HTTP/1.1 200 OK\r\n";
+    }
+    header += fmt::format("Content-Length: {}\r\nConnection: close\r\n\r\n", body.size());
+
+    send_data(connection_fd, header);
+    send_data(connection_fd, body);
+    --m_num_concurrent_requests;
+    close(connection_fd);
+}
+
+auto LocalHttpServer::send_data(int connection_fd, std::string_view data) const -> void {
+    constexpr size_t cNumSlicesPerSec{100};
+    auto const max_bytes_per_sec{m_options.max_bytes_per_sec_per_connection};
+    auto const max_slice_size{
+            0 == max_bytes_per_sec ? data.size()
+                                   : std::max(size_t{1}, max_bytes_per_sec / cNumSlicesPerSec)
+    };
+    while (false == data.empty()) {
+        auto const slice{data.substr(0, max_slice_size)};
+        for (size_t num_bytes_sent{0}; num_bytes_sent < slice.size();) {
+            auto const ret{send(
+                    connection_fd,
+                    slice.data() + num_bytes_sent,
+                    slice.size() - num_bytes_sent,
+                    MSG_NOSIGNAL
+            )};
+            if (ret <= 0) {
+                return;
+            }
+            num_bytes_sent += static_cast<size_t>(ret);
+        }
+        data.remove_prefix(slice.size());
+        if (0 != max_bytes_per_sec && false == data.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1000 / cNumSlicesPerSec});
+        }
+    }
+}
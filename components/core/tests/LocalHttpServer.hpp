@@ -0,0 +1,96 @@
+#ifndef TESTS_LOCALHTTPSERVER_HPP
+#define TESTS_LOCALHTTPSERVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * A minimal HTTP server on the loopback interface that serves the given data for any GET request.
+ * Each connection serves one request.
+ *
+ * The server honours single `Range: bytes=<begin>-[<end>]` headers with `206 Partial Content`
+ * responses unless range support is disabled, and can throttle each connection's bandwidth to
+ * emulate remote storage where a single connection's throughput is the bottleneck.
+ */
+class LocalHttpServer {
+public:
+    // Types
+    struct Options {
+        bool support_ranges{true};
+        // The maximum number of bytes sent per second on each connection, or 0 for no limit.
+        size_t max_bytes_per_sec_per_connection{0};
+    };
+
+    // Constructors
+    LocalHttpServer(std::vector<char> data, Options options);
+
+    // Destructor
+    ~LocalHttpServer();
+
+    // Delete copy & move constructors and assignment operators
+    LocalHttpServer(LocalHttpServer const&) = delete;
+    LocalHttpServer(LocalHttpServer&&) = delete;
+    auto operator=(LocalHttpServer const&) -> LocalHttpServer& = delete;
+    auto operator=(LocalHttpServer&&) -> LocalHttpServer& = delete;
+
+    // Methods
+    [[nodiscard]] auto get_url() const -> std::string;
+
+    [[nodiscard]] auto get_num_requests() const -> size_t { return m_num_requests.load(); }
+
+    /**
+     * @return The maximum number of requests that were served concurrently.
+     */
+    [[nodiscard]] auto get_max_num_concurrent_requests() const -> size_t {
+        return m_max_num_concurrent_requests.load();
+    }
+
+    /**
+     * Parses the value of a `Range: bytes=<begin>-[<end>]` header in the given request.
+     * @param request
+     * @return The inclusive range, where an open-ended range ends at SIZE_MAX, or std::nullopt if
+     * the request has no such header.
+     */
+    [[nodiscard]] static auto parse_range_header(std::string_view request)
+            -> std::optional<std::pair<size_t, size_t>>;
+
+private:
+    // Methods
+    auto serve() -> void;
+
+    /**
+     * Reads a request from the given connection and sends the response.
+     * @param connection_fd
+     */
+    auto handle_connection(int connection_fd) -> void;
+
+    /**
+     * Sends the given data over the connection, throttling it if necessary.
+     * @param connection_fd
+     * @param data
+     */
+    auto send_data(int connection_fd, std::string_view data) const -> void;
+
+    // Variables
+    std::vector<char> m_data;
+    Options m_options;
+    int m_listen_fd{-1};
+    uint16_t m_port{0};
+    std::atomic_bool m_stopped{false};
+    std::atomic_size_t m_num_requests{0};
+    std::atomic_size_t m_num_concurrent_requests{0};
+    std::atomic_size_t m_max_num_concurrent_requests{0};
+    std::mutex m_connection_threads_mutex;
+    std::vector<std::thread> m_connection_threads;
+    std::thread m_server_thread;
+};
+
+#endif  // TESTS_LOCALHTTPSERVER_HPP
@@ -1,5 +1,6 @@
 #include <unistd.h>
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -8,6 +9,7 @@
 #include <catch2/generators/catch_generators.hpp>
 
 #include "../src/clp/EncodedVariableInterpreter.hpp"
+#include "../src/clp/ffi/ir_stream/encoding_methods.hpp"
 #include "../src/clp/ir/types.hpp"
 #include "../src/clp/LogTypeDictionaryEntry.hpp"
 #include "../src/clp/streaming_archive/Constants.hpp"
@@ -668,6 +670,26 @@ TEST_CASE("EncodedVariableInterpreter", "[EncodedVariableInterpreter]") {
         ));
         REQUIRE(msg == decompressed_msg);
 
+        // Test transcoding into IR, which should be identical to serializing the decoded message
+        string transcoded_logtype;
+        vector<int8_t> transcoded_ir_buf;
+        REQUIRE(EncodedVariableInterpreter::transcode_message_to_four_byte_ir(
+                logtype_dict_entry,
+                var_dict_reader,
+                encoded_vars,
+                transcoded_logtype,
+                transcoded_ir_buf
+        ));
+        string serialized_logtype;
+        vector<int8_t> serialized_ir_buf;
+        REQUIRE(clp::ffi::ir_stream::four_byte_encoding::serialize_message(
+                msg,
+                serialized_logtype,
+                serialized_ir_buf
+        ));
+        REQUIRE(serialized_logtype == transcoded_logtype);
+        REQUIRE(serialized_ir_buf == transcoded_ir_buf);
+
         var_dict_reader.close();
 
         // Clean-up
@@ -0,0 +1,191 @@
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/CurlGlobalInstance.hpp"
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/FileReader.hpp"
+#include "../src/clp/NetworkRangeReader.hpp"
+#include "../src/clp/ReaderInterface.hpp"
+#include "LocalHttpServer.hpp"
+
+namespace {
+constexpr size_t cBlockSize{clp::NetworkRangeReader::cMinBlockSize};
+
+[[nodiscard]] auto get_test_input_local_path() -> std::string;
+
+/**
+ * @return The content of the test input.
+ */
+[[nodiscard]] auto get_test_input_content() -> std::vector<char>;
+
+/**
+ * Reads the given byte range from the reader.
+ * @param reader
+ * @param begin
+ * @param length
+ * @return The data read.
+ */
+[[nodiscard]] auto read_range(clp::NetworkRangeReader& reader, size_t begin, size_t length)
+        -> std::vector<char>;
+
+auto get_test_input_local_path() -> std::string {
+    std::filesystem::path const current_file_path{__FILE__};
+    auto const tests_dir{current_file_path.parent_path()};
+    return (tests_dir / "test_network_reader_src" / "random.log").string();
+}
+
+auto get_test_input_content() -> std::vector<char> {
+    clp::FileReader reader{get_test_input_local_path()};
+    std::vector<char> content;
+    std::vector<char> buf(4096);
+    for (bool has_more_content{true}; has_more_content;) {
+        size_t num_bytes_read{};
+        has_more_content = reader.read(buf.data(), buf.size(), num_bytes_read);
+        content.insert(content.cend(), buf.cbegin(), buf.cbegin() + num_bytes_read);
+    }
+    return content;
+}
+
+auto read_range(clp::NetworkRangeReader& reader, size_t begin, size_t length) -> std::vector<char> {
+    REQUIRE(clp::ErrorCode_Success == reader.try_seek_from_begin(begin));
+    std::vector<char> buf(length);
+    size_t num_bytes_read{};
+    REQUIRE(clp::ErrorCode_Success == reader.try_read(buf.data(), length, num_bytes_read));
+    buf.resize(num_bytes_read);
+    return buf;
+}
+}  // namespace
+
+TEST_CASE("network_range_reader_random_access", "[NetworkRangeReader]") {
+    auto const expected{get_test_input_content()};
+    LocalHttpServer const server{expected, {}};
+
+    clp::CurlGlobalInstance const curl_global_instance;
+    constexpr size_t cMaxNumCachedBlocks{16};
+    constexpr size_t cMaxNumParallelRequests{4};
+    clp::NetworkRangeReader reader{
+            server.get_url(),
+            clp::CurlDownloadHandler::cDefaultOverallTimeout,
+            clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+            cBlockSize,
+            cMaxNumCachedBlocks,
+            cMaxNumParallelRequests
+    };
+    REQUIRE((expected.size() == reader.get_size()));
+
+    // Read the whole input sequentially with reads that straddle block boundaries.
+    constexpr size_t cReadSize{300};
+    std::vector<char> actual;
+    std::vector<char> buf(cReadSize);
+    size_t num_bytes_read{};
+    while (clp::ErrorCode_Success == reader.try_read(buf.data(), buf.size(), num_bytes_read)) {
+        actual.insert(actual.cend(), buf.cbegin(), buf.cbegin() + num_bytes_read);
+    }
+    REQUIRE((actual == expected));
+    REQUIRE((expected.size() == reader.get_num_bytes_downloaded()));
+    // The readahead window should make sequential reads use far fewer requests than blocks.
+    auto const num_blocks{(expected.size() + cBlockSize - 1) / cBlockSize};
+    REQUIRE((reader.get_num_requests() < num_blocks / 2));
+
+    // Seek backwards and forwards, including reads larger than the cache.
+    std::vector<std::pair<size_t, size_t>> const ranges{
+            {0, 1},
+            {expected.size() - 10, 10},
+            {1000, 5000},
+            {123, 1},
+            {expected.size() / 2, cBlockSize * cMaxNumCachedBlocks * 2},
+            {511, 2},
+            {expected.size() - 1, 1},
+            {0, expected.size()},
+    };
+    for (auto const& [begin, length] : ranges) {
+        auto const range{read_range(reader, begin, length)};
+        auto const begin_it{expected.cbegin() + static_cast<std::ptrdiff_t>(begin)};
+        REQUIRE((std::vector<char>(begin_it, begin_it + static_cast<std::ptrdiff_t>(length))
+                 == range));
+        REQUIRE(server.get_num_requests() == reader.get_num_requests());
+    }
+
+    size_t pos{};
+    REQUIRE(clp::ErrorCode_Success == reader.try_seek_from_begin(expected.size()));
+    REQUIRE(clp::ErrorCode_Success == reader.try_get_pos(pos));
+    REQUIRE((expected.size() == pos));
+    REQUIRE(clp::ErrorCode_EndOfFile == reader.try_read(buf.data(), buf.size(), num_bytes_read));
+    REQUIRE(clp::ErrorCode_OutOfBounds == reader.try_seek_from_begin(expected.size() + 1));
+}
+
+TEST_CASE("network_range_reader_prefetch", "[NetworkRangeReader]") {
+    auto const expected{get_test_input_content()};
+    LocalHttpServer const server{expected, {}};
+
+    clp::CurlGlobalInstance const curl_global_instance;
+    constexpr size_t cMaxNumCachedBlocks{64};
+    auto const create_reader = [&](size_t max_num_parallel_requests) {
+        return std::make_unique<clp::NetworkRangeReader>(
+                server.get_url(),
+                clp::CurlDownloadHandler::cDefaultOverallTimeout,
+                clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+                cBlockSize,
+                cMaxNumCachedBlocks,
+                max_num_parallel_requests
+        );
+    };
+
+    SECTION("Nearby ranges are coalesced") {
+        auto reader{create_reader(1)};
+        REQUIRE((1 == reader->get_num_requests()));
+        // Blocks 2 and 4 are separated by a one-block gap, so they should be fetched together.
+        REQUIRE(clp::ErrorCode_Success
+                == reader->prefetch(
+                        {{2 * cBlockSize, 3 * cBlockSize}, {4 * cBlockSize + 1, 4 * cBlockSize + 2}}
+                ));
+        REQUIRE((2 == reader->get_num_requests()));
+
+        // Reading the prefetched ranges shouldn't issue any requests.
+        auto const begin_it{expected.cbegin() + static_cast<std::ptrdiff_t>(2 * cBlockSize)};
+        REQUIRE((std::vector<char>(begin_it, begin_it + cBlockSize)
+                 == read_range(*reader, 2 * cBlockSize, cBlockSize)));
+        REQUIRE((2 == reader->get_num_requests()));
+    }
+
+    SECTION("Distant ranges are fetched in parallel") {
+        auto reader{create_reader(clp::NetworkRangeReader::cDefaultMaxNumParallelRequests)};
+        REQUIRE(clp::ErrorCode_Success
+                == reader->prefetch(
+                        {{10 * cBlockSize, 12 * cBlockSize},
+                         {20 * cBlockSize, 21 * cBlockSize},
+                         {30 * cBlockSize, 31 * cBlockSize},
+                         {expected.size() - 1, expected.size() + cBlockSize}}
+                ));
+        // Each of the five blocks should be fetched by its own request (on top of the first block's
+        // request).
+        auto const num_requests{reader->get_num_requests()};
+        REQUIRE((6 == num_requests));
+
+        for (size_t const begin : {10 * cBlockSize, 20 * cBlockSize, 30 * cBlockSize}) {
+            auto const begin_it{expected.cbegin() + static_cast<std::ptrdiff_t>(begin)};
+            REQUIRE((std::vector<char>(begin_it, begin_it + cBlockSize)
+                     == read_range(*reader, begin, cBlockSize)));
+        }
+        REQUIRE((expected.back() == read_range(*reader, expected.size() - 1, 1).back()));
+        REQUIRE((num_requests == reader->get_num_requests()));
+    }
+}
+
+TEST_CASE("network_range_reader_unsupported_server", "[NetworkRangeReader]") {
+    LocalHttpServer const server{get_test_input_content(), {.support_ranges = false}};
+
+    clp::CurlGlobalInstance const curl_global_instance;
+    try {
+        clp::NetworkRangeReader const reader{server.get_url()};
+        FAIL("Constructing a reader for a server without range support should fail.");
+    } catch (clp::NetworkRangeReader::OperationFailed const& ex) {
+        REQUIRE((clp::ErrorCode_Unsupported == ex.get_error_code()));
+    }
+}
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -24,6 +25,7 @@
 #include "../src/clp/Platform.hpp"
 #include "../src/clp/ReaderInterface.hpp"
 #include "../src/clp/string_utils/string_utils.hpp"
+#include "LocalHttpServer.hpp"
 
 namespace {
 constexpr size_t cDefaultReaderBufferSize{1024};
@@ -35,6 +37,17 @@ constexpr std::string_view cHttpHeadersEchoServerUrl{"https://mockhttp.org/heade
 
 [[nodiscard]] auto get_test_input_path_relative_to_tests_dir() -> std::filesystem::path;
 
+/**
+ * @param url
+ * @param offset
+ * @param num_connections
+ * @return A reader that downloads the data at the given URL in small chunks over the given number
+ * of connections.
+ */
+[[nodiscard]] auto
+create_chunked_reader(std::string_view url, size_t offset, size_t num_connections)
+        -> std::unique_ptr<clp::NetworkReader>;
+
 /**
  * @param reader
  * @param read_buf_size The size of the buffer to use for individual reads from the reader.
@@ -70,6 +83,23 @@ auto get_test_input_path_relative_to_tests_dir() -> std::filesystem::path {
     return std::filesystem::path{"test_network_reader_src"} / "random.log";
 }
 
+auto create_chunked_reader(std::string_view url, size_t offset, size_t num_connections)
+        -> std::unique_ptr<clp::NetworkReader> {
+    constexpr size_t cChunkSize{16UL * 1024};
+    return std::make_unique<clp::NetworkReader>(
+            url,
+            offset,
+            false,
+            clp::CurlDownloadHandler::cDefaultOverallTimeout,
+            clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+            clp::NetworkReader::cDefaultBufferPoolSize,
+            clp::NetworkReader::cDefaultBufferSize,
+            std::nullopt,
+            num_connections,
+            cChunkSize
+    );
+}
+
 auto get_content(clp::ReaderInterface& reader, size_t read_buf_size) -> std::vector<char> {
     std::vector<char> buf;
     ystdlib::containers::Array<char> read_buf(read_buf_size);
@@ -195,6 +225,70 @@ TEST_CASE("network_reader_illegal_offset", "[NetworkReader]") {
     REQUIRE((clp::ErrorCode_Failure == reader.try_get_pos(pos)));
 }
 
+TEST_CASE("network_reader_multiple_connections", "[NetworkReader]") {
+    constexpr size_t cNumConnections{4};
+    // Throttle each connection so that downloading the input over a single connection would be
+    // slow enough for the chunk downloads to overlap.
+    constexpr size_t cMaxBytesPerSecPerConnection{256UL * 1024};
+
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    auto const expected{get_content(ref_reader)};
+    clp::CurlGlobalInstance const curl_global_instance;
+
+    SECTION("Chunks are downloaded in parallel") {
+        LocalHttpServer const server{
+                expected,
+                {.max_bytes_per_sec_per_connection = cMaxBytesPerSecPerConnection}
+        };
+        auto reader{create_chunked_reader(server.get_url(), 0, cNumConnections)};
+        auto const actual{get_content(*reader)};
+        REQUIRE(assert_curl_error_code(CURLE_OK, *reader));
+        REQUIRE((actual == expected));
+        REQUIRE((server.get_num_requests() > 1));
+        REQUIRE((server.get_max_num_concurrent_requests() > 1));
+    }
+
+    SECTION("Chunks are downloaded from an offset") {
+        constexpr size_t cOffset{20UL * 1024 + 319};
+        LocalHttpServer const server{expected, {}};
+        auto reader{create_chunked_reader(server.get_url(), cOffset, cNumConnections)};
+        auto const actual{get_content(*reader)};
+        REQUIRE(assert_curl_error_code(CURLE_OK, *reader));
+        REQUIRE((reader->get_pos() == expected.size()));
+        REQUIRE((actual
+                 == std::vector<char>(
+                         expected.cbegin() + static_cast<std::ptrdiff_t>(cOffset),
+                         expected.cend()
+                 )));
+    }
+
+    SECTION("Servers without range support fall back to a single download") {
+        LocalHttpServer const server{
+                expected,
+                {.support_ranges = false,
+                 .max_bytes_per_sec_per_connection = cMaxBytesPerSecPerConnection}
+        };
+        auto reader{create_chunked_reader(server.get_url(), 0, cNumConnections)};
+        auto const actual{get_content(*reader)};
+        REQUIRE(assert_curl_error_code(CURLE_OK, *reader));
+        REQUIRE((actual == expected));
+    }
+
+    SECTION("Destructing the reader aborts the chunk downloads") {
+        LocalHttpServer const server{
+                expected,
+                {.max_bytes_per_sec_per_connection = cMaxBytesPerSecPerConnection / 16}
+        };
+        auto reader{create_chunked_reader(server.get_url(), 0, cNumConnections)};
+        std::vector<char> buf(cDefaultReaderBufferSize);
+        size_t num_bytes_read{};
+        REQUIRE((clp::ErrorCode_Success
+                 == reader->try_read(buf.data(), buf.size(), num_bytes_read)));
+        REQUIRE(reader->is_download_in_progress());
+        reader.reset(nullptr);
+    }
+}
+
 /**
  * Sends some headers to an HTTP header echo server and validates that they're returned correctly in
  * a JSON object under the "headers" key.
@@ -0,0 +1,70 @@
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/Query.hpp"
+
+using clp::logtype_dictionary_id_t;
+using clp::Query;
+using clp::segment_id_t;
+using clp::SubQuery;
+using clp::variable_dictionary_id_t;
+using std::set;
+using std::unordered_set;
+using std::vector;
+
+TEST_CASE("SubQuery::matches_logtype", "[Query]") {
+    SubQuery sub_query;
+    REQUIRE_FALSE(sub_query.matches_logtype(0));
+
+    // IDs on either side of bitmap-word boundaries
+    unordered_set<logtype_dictionary_id_t> const logtype_ids{0, 63, 64, 200};
+    sub_query.set_possible_logtypes(logtype_ids);
+    for (logtype_dictionary_id_t logtype_id{0}; logtype_id < 300; ++logtype_id) {
+        REQUIRE((logtype_ids.contains(logtype_id) == sub_query.matches_logtype(logtype_id)));
+    }
+
+    sub_query.clear();
+    REQUIRE_FALSE(sub_query.matches_logtype(63));
+}
+
+TEST_CASE("Query::logtype_matches_relevant_sub_queries", "[Query]") {
+    constexpr segment_id_t cSegment0{0};
+    constexpr segment_id_t cSegment1{1};
+
+    vector<SubQuery> sub_queries(2);
+    sub_queries[0].set_possible_logtypes({1});
+    sub_queries[1].set_possible_logtypes({2, 130});
+    Query query{0, 100, false, "*test*", std::move(sub_queries)};
+
+    // Logtype 1 is only in segment 0, while logtypes 2 and 130 are in both segments
+    set<segment_id_t> const segment_0_only{cSegment0};
+    set<segment_id_t> const both_segments{cSegment0, cSegment1};
+    set<segment_id_t> const no_segments;
+    query.calculate_ids_of_matching_segments(
+            [&](logtype_dictionary_id_t logtype_id) -> set<segment_id_t> const& {
+                return 1 == logtype_id ? segment_0_only : both_segments;
+            },
+            [&]([[maybe_unused]] variable_dictionary_id_t var_id) -> set<segment_id_t> const& {
+                return no_segments;
+            }
+    );
+
+    query.make_sub_queries_relevant_to_segment(cSegment0);
+    REQUIRE((2 == query.get_relevant_sub_queries().size()));
+    for (logtype_dictionary_id_t logtype_id{0}; logtype_id < 200; ++logtype_id) {
+        auto const expected{1 == logtype_id || 2 == logtype_id || 130 == logtype_id};
+        REQUIRE((expected == query.logtype_matches_relevant_sub_queries(logtype_id)));
+    }
+
+    // Only sub-query 1 is relevant to segment 1
+    query.make_sub_queries_relevant_to_segment(cSegment1);
+    REQUIRE((1 == query.get_relevant_sub_queries().size()));
+    REQUIRE_FALSE(query.logtype_matches_relevant_sub_queries(1));
+    REQUIRE(query.logtype_matches_relevant_sub_queries(2));
+    REQUIRE(query.logtype_matches_relevant_sub_queries(130));
+}
@@ -415,3 +415,113 @@ TEST_CASE("sqlite_db_basic", "[SQLiteDB]") {
     // Cleanup
     REQUIRE(std::filesystem::remove(test_db_path));
 }
+
+TEST_CASE("sqlite_db_multi_row_insert", "[SQLiteDB]") {
+    REQUIRE(("(?,?),(?,?),(?,?)" == clp::get_multi_row_placeholders_sql(2, 3)));
+    REQUIRE(("a = VALUES(a),b = VALUES(b)"
+             == clp::get_set_field_to_inserted_values_sql({"id", "a", "b"}, 1, 3)));
+    REQUIRE((clp::get_multi_row_batch_sizes(0, 2).empty()));
+    REQUIRE((vector<size_t>{2, 2} == clp::get_multi_row_batch_sizes(4, 2)));
+    REQUIRE((vector<size_t>{2, 2, 1} == clp::get_multi_row_batch_sizes(5, 2)));
+    REQUIRE((vector<size_t>{5} == clp::get_multi_row_batch_sizes(5, 512)));
+    REQUIRE((0 == clp::get_multi_row_placeholder_ix(0, 0, 3)));
+    REQUIRE((5 == clp::get_multi_row_placeholder_ix(2, 1, 3)));
+
+    vector<Row> const ref_rows{
+            // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+            {"0.log", 1000, 2000, 0, 0},
+            {"1.log", 1200, 1800, 0, 30},
+            {"2.log", 800, 3800, 1, 0}
+            // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    };
+    TestTableSchema const table_schema;
+
+    auto const test_db_path{get_test_db_abs_path()};
+    if (std::filesystem::exists(test_db_path)) {
+        REQUIRE((std::filesystem::remove(test_db_path)));
+    }
+    SQLiteDB sqlite_db;
+    sqlite_db.open(test_db_path.string());
+    create_table(sqlite_db, table_schema);
+
+    // Insert the rows in batches, each with a single statement
+    constexpr size_t cMaxRowsPerBatch{2};
+    auto const& table_columns{table_schema.get_column_names()};
+    fmt::memory_buffer stmt_buf;
+    auto stmt_buf_it{std::back_inserter(stmt_buf)};
+    size_t batch_begin_ix{0};
+    for (auto const batch_size : clp::get_multi_row_batch_sizes(ref_rows.size(), cMaxRowsPerBatch))
+    {
+        fmt::format_to(
+                stmt_buf_it,
+                "INSERT INTO {} ({}) VALUES {}",
+                table_schema.get_name(),
+                clp::get_field_names_sql(table_columns),
+                clp::get_multi_row_placeholders_sql(table_columns.size(), batch_size)
+        );
+        auto insert_stmt{sqlite_db.prepare_statement(stmt_buf.data(), stmt_buf.size())};
+        stmt_buf.clear();
+
+        for (size_t i{0}; i < batch_size; ++i) {
+            auto const& row{ref_rows[batch_begin_ix + i]};
+            // SQLite parameters are numbered from 1
+            auto const get_param_id = [&](size_t field_ix) -> int {
+                return static_cast<int>(
+                        clp::get_multi_row_placeholder_ix(field_ix, i, table_columns.size()) + 1
+                );
+            };
+            int field_ix{0};
+            insert_stmt.bind_text(get_param_id(field_ix++), row.get_path(), false);
+            insert_stmt.bind_int64(get_param_id(field_ix++), row.get_begin_ts());
+            insert_stmt.bind_int64(get_param_id(field_ix++), row.get_end_ts());
+            insert_stmt.bind_int64(
+                    get_param_id(field_ix++),
+                    static_cast<int64_t>(row.get_segment_id())
+            );
+            insert_stmt.bind_int64(
+                    get_param_id(field_ix++),
+                    static_cast<int64_t>(row.get_segment_ts_pos())
+            );
+            insert_stmt.bind_int64(
+                    get_param_id(field_ix++),
+                    static_cast<int64_t>(row.get_segment_var_pos())
+            );
+        }
+        insert_stmt.step();
+        batch_begin_ix += batch_size;
+    }
+
+    fmt::format_to(
+            stmt_buf_it,
+            "SELECT {} FROM {} ORDER BY {} ASC",
+            clp::get_field_names_sql(table_columns),
+            table_schema.get_name(),
+            TestTableSchema::cPath
+    );
+    auto select_stmt{sqlite_db.prepare_statement(stmt_buf.data(), stmt_buf.size())};
+    stmt_buf.clear();
+
+    vector<Row> rows;
+    while (true) {
+        select_stmt.step();
+        if (false == select_stmt.is_row_ready()) {
+            break;
+        }
+
+        int column_idx{0};
+        string path;
+        select_stmt.column_string(column_idx++, path);
+        epochtime_t const begin_ts{select_stmt.column_int64(column_idx++)};
+        epochtime_t const end_ts{select_stmt.column_int64(column_idx++)};
+        auto const seg_id{static_cast<size_t>(select_stmt.column_int64(column_idx++))};
+        auto const seg_ts_pos{static_cast<size_t>(select_stmt.column_int64(column_idx++))};
+        auto const seg_var_pos{static_cast<size_t>(select_stmt.column_int64(column_idx++))};
+        rows.emplace_back(path, begin_ts, end_ts, seg_id, seg_ts_pos, seg_var_pos);
+    }
+    REQUIRE((ref_rows == rows));
+
+    sqlite_db.close();
+
+    // Cleanup
+    REQUIRE(std::filesystem::remove(test_db_path));
+}
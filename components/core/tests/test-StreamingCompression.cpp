@@ -127,6 +127,20 @@ TEST_CASE("StreamingCompression", "[StreamingCompression]") {
         decompress_and_compare(std::move(decompressor), uncompressed_buffer, decompressed_buffer);
     }
 
+    SECTION("ZStd multi-threaded compression") {
+        auto const num_workers_bounds{ZSTD_cParam_getBounds(ZSTD_c_nbWorkers)};
+        if (0 != ZSTD_isError(num_workers_bounds.error) || 0 == num_workers_bounds.upperBound) {
+            SKIP("libzstd was built without multi-threading support");
+        }
+        auto zstd_compressor{std::make_unique<clp::streaming_compression::zstd::Compressor>()};
+        zstd_compressor->set_worker_options(
+                {.num_workers = 2, .job_size = 1024L * 1024, .enable_long_distance_matching = true}
+        );
+        compress(std::move(zstd_compressor), uncompressed_buffer.data());
+        decompressor = std::make_unique<clp::streaming_compression::zstd::Decompressor>();
+        decompress_and_compare(std::move(decompressor), uncompressed_buffer, decompressed_buffer);
+    }
+
     SECTION("Passthrough compression") {
         compressor = std::make_unique<clp::streaming_compression::passthrough::Compressor>();
         compress(std::move(compressor), uncompressed_buffer.data());
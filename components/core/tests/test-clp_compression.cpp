@@ -0,0 +1,209 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <clp/clp/run.hpp>
+#include <clp/streaming_archive/reader/Archive.hpp>
+
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cTestInputDirectory{"test-clp-compression-input"};
+constexpr std::string_view cTestArchiveDirectory{"test-clp-compression-archives"};
+constexpr std::string_view cTestExtractionDirectory{"test-clp-compression-extracted"};
+constexpr size_t cNumInputFiles{8};
+constexpr size_t cNumLinesPerFile{200};
+constexpr std::string_view cNumThreads{"3"};
+
+/**
+ * Runs `clp::clp::run` with the given arguments.
+ * @param args Arguments following the program name.
+ * @return The value returned by `clp::clp::run`.
+ */
+auto run_clp(std::vector<std::string> const& args) -> int;
+
+/**
+ * Writes `cNumInputFiles` distinct log files into `cTestInputDirectory`.
+ * @return The paths of the written files.
+ */
+[[nodiscard]] auto write_test_input_files() -> std::vector<std::filesystem::path>;
+
+/**
+ * @param path
+ * @return The content of the file at `path`.
+ */
+[[nodiscard]] auto read_file(std::filesystem::path const& path) -> std::string;
+
+/**
+ * @param archives_dir
+ * @return A map from each original file path to the number of archives in `archives_dir` that
+ * contain it.
+ */
+[[nodiscard]] auto get_num_archives_per_file(std::filesystem::path const& archives_dir)
+        -> std::map<std::string, size_t>;
+
+auto run_clp(std::vector<std::string> const& args) -> int {
+    std::vector<char const*> argv{"clp"};
+    for (auto const& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+    argv.push_back(nullptr);
+    // `clp::clp::run` registers a logger for `spdlog` that persists across runs. `spdlog` will
+    // error if a logger with the same name already exists. `spdlog::drop_all` clears all loggers,
+    // ensuring `clp::clp::run` can safely create a fresh logger for each new call.
+    spdlog::drop_all();
+    return clp::clp::run(static_cast<int>(argv.size() - 1), argv.data());
+}
+
+auto write_test_input_files() -> std::vector<std::filesystem::path> {
+    std::filesystem::path const input_dir{cTestInputDirectory};
+    std::filesystem::create_directory(input_dir);
+
+    std::vector<std::filesystem::path> paths;
+    for (size_t file_ix = 0; file_ix < cNumInputFiles; ++file_ix) {
+        auto const& path = paths.emplace_back(input_dir / fmt::format("log-{}.txt", file_ix));
+        std::ofstream file{path};
+        for (size_t line_ix = 0; line_ix < cNumLinesPerFile; ++line_ix) {
+            file << fmt::format(
+                    "2024-01-01 00:{:02}:{:02}.{:03} INFO Worker {} processed {} records in {}.{} "
+                    "ms\n",
+                    line_ix / 60,
+                    line_ix % 60,
+                    file_ix,
+                    file_ix,
+                    line_ix * (file_ix + 1),
+                    line_ix,
+                    file_ix
+            );
+        }
+    }
+    return paths;
+}
+
+auto read_file(std::filesystem::path const& path) -> std::string {
+    std::ifstream file{path, std::ios::binary};
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+auto get_num_archives_per_file(std::filesystem::path const& archives_dir)
+        -> std::map<std::string, size_t> {
+    std::map<std::string, size_t> num_archives_per_file;
+    for (auto const& entry : std::filesystem::directory_iterator{archives_dir}) {
+        if (false == entry.is_directory()) {
+            continue;
+        }
+        clp::streaming_archive::reader::Archive archive_reader;
+        archive_reader.open(entry.path().string());
+
+        std::map<std::string, size_t> num_splits_per_file;
+        auto file_it = archive_reader.get_file_iterator();
+        for (; file_it->has_next(); file_it->next()) {
+            std::string path;
+            file_it->get_path(path);
+            ++num_splits_per_file[path];
+        }
+        file_it.reset();
+        archive_reader.close();
+
+        // A file may be split within an archive, so count each archive only once
+        for (auto const& [path, num_splits] : num_splits_per_file) {
+            ++num_archives_per_file[path];
+        }
+    }
+    return num_archives_per_file;
+}
+}  // namespace
+
+TEST_CASE("clp_compress_multiple_threads", "[clp][Compression]") {
+    TestOutputCleaner const cleaner{
+            {std::string{cTestInputDirectory},
+             std::string{cTestArchiveDirectory},
+             std::string{cTestExtractionDirectory}}
+    };
+    auto const input_paths{write_test_input_files()};
+    auto const input_dir{std::filesystem::canonical(cTestInputDirectory)};
+
+    SECTION("Every file is compressed into exactly one archive and decompresses losslessly") {
+        REQUIRE(
+                (0
+                 == run_clp(
+                         {"c",
+                          "--num-threads",
+                          std::string{cNumThreads},
+                          "--remove-path-prefix",
+                          input_dir.string(),
+                          std::string{cTestArchiveDirectory},
+                          input_dir.string()}
+                 ))
+        );
+
+        auto const num_archives_per_file{get_num_archives_per_file(cTestArchiveDirectory)};
+        REQUIRE((input_paths.size() == num_archives_per_file.size()));
+        for (auto const& input_path : input_paths) {
+            auto const orig_path{"/" + input_path.filename().string()};
+            REQUIRE(num_archives_per_file.contains(orig_path));
+            REQUIRE((1 == num_archives_per_file.at(orig_path)));
+        }
+
+        REQUIRE(
+                (0
+                 == run_clp(
+                         {"x",
+                          std::string{cTestArchiveDirectory},
+                          std::string{cTestExtractionDirectory}}
+                 ))
+        );
+        for (auto const& input_path : input_paths) {
+            auto const extracted_path{
+                    std::filesystem::path{cTestExtractionDirectory} / input_path.filename()
+            };
+            REQUIRE(std::filesystem::exists(extracted_path));
+            REQUIRE((read_file(input_path) == read_file(extracted_path)));
+        }
+    }
+
+    SECTION("A failure in any worker fails the run") {
+        // A file that's neither UTF-8 nor an IR stream can't be compressed
+        std::ofstream binary_file{
+                std::filesystem::path{cTestInputDirectory} / "binary.bin",
+                std::ios::binary
+        };
+        constexpr std::string_view cInvalidUtf8{"\xff\xfe\xfd\xfc\x00\x01\x02\x03", 8};
+        for (size_t i = 0; i < cNumLinesPerFile; ++i) {
+            binary_file << cInvalidUtf8;
+        }
+        binary_file.close();
+
+        REQUIRE(
+                (0
+                 != run_clp(
+                         {"c",
+                          "--num-threads",
+                          std::string{cNumThreads},
+                          "--remove-path-prefix",
+                          input_dir.string(),
+                          std::string{cTestArchiveDirectory},
+                          input_dir.string()}
+                 ))
+        );
+
+        // The remaining files should still have been compressed
+        auto const num_archives_per_file{get_num_archives_per_file(cTestArchiveDirectory)};
+        for (auto const& input_path : input_paths) {
+            auto const orig_path{"/" + input_path.filename().string()};
+            REQUIRE(num_archives_per_file.contains(orig_path));
+            REQUIRE((1 == num_archives_per_file.at(orig_path)));
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -250,6 +251,56 @@ TEST_CASE("ffi_Value_basic", "[ffi][Value]") {
     );
 }
 
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEST_CASE("ffi_KeyValuePairLogEvent_NodeIdValuePairs", "[ffi]") {
+    KeyValuePairLogEvent::NodeIdValuePairs node_id_value_pairs{
+            {3, Value{static_cast<value_int_t>(1)}},
+            {1, std::nullopt}
+    };
+    REQUIRE((2 == node_id_value_pairs.size()));
+    REQUIRE(node_id_value_pairs.contains(1));
+    REQUIRE(node_id_value_pairs.contains(3));
+    REQUIRE_FALSE(node_id_value_pairs.contains(2));
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    REQUIRE_FALSE(node_id_value_pairs.contains(100));
+    REQUIRE((node_id_value_pairs.end() == node_id_value_pairs.find(2)));
+    REQUIRE_FALSE(node_id_value_pairs.at(1).has_value());
+    REQUIRE_THROWS_AS(node_id_value_pairs.at(2), std::out_of_range);
+
+    // Inserting an existing node ID doesn't overwrite its value.
+    REQUIRE_FALSE(node_id_value_pairs.emplace(3, Value{static_cast<value_int_t>(2)}));
+    REQUIRE((1 == node_id_value_pairs.at(3).value().get_immutable_view<value_int_t>()));
+
+    // Pairs are iterated in insertion order.
+    REQUIRE(node_id_value_pairs.emplace(2, Value{}));
+    vector<SchemaTree::Node::id_t> node_ids;
+    for (auto const& [node_id, optional_value] : node_id_value_pairs) {
+        node_ids.push_back(node_id);
+    }
+    REQUIRE((vector<SchemaTree::Node::id_t>{3, 1, 2} == node_ids));
+
+    node_id_value_pairs.clear();
+    REQUIRE(node_id_value_pairs.empty());
+    REQUIRE_FALSE(node_id_value_pairs.contains(3));
+    REQUIRE(node_id_value_pairs.emplace(3, std::nullopt));
+    REQUIRE((1 == node_id_value_pairs.size()));
+
+    // Node IDs far larger than the number of pairs, sharing a common stride, are still found.
+    constexpr SchemaTree::Node::id_t cNumSparseNodeIds{1000};
+    constexpr SchemaTree::Node::id_t cSparseNodeIdStride{1024};
+    for (SchemaTree::Node::id_t i{0}; i < cNumSparseNodeIds; ++i) {
+        REQUIRE(node_id_value_pairs.emplace(i * cSparseNodeIdStride + 1, std::nullopt));
+    }
+    REQUIRE((cNumSparseNodeIds + 1 == node_id_value_pairs.size()));
+    REQUIRE(node_id_value_pairs.contains(3));
+    REQUIRE_FALSE(node_id_value_pairs.contains(cSparseNodeIdStride));
+    for (SchemaTree::Node::id_t i{0}; i < cNumSparseNodeIds; ++i) {
+        auto const it{node_id_value_pairs.find(i * cSparseNodeIdStride + 1)};
+        REQUIRE((node_id_value_pairs.end() != it));
+        REQUIRE((i * cSparseNodeIdStride + 1 == it->first));
+    }
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 TEST_CASE("ffi_KeyValuePairLogEvent_create", "[ffi]") {
     /*
@@ -461,6 +512,27 @@ TEST_CASE("ffi_KeyValuePairLogEvent_create", "[ffi]") {
             };
             REQUIRE((serialized_auto_gen_kv_pairs == expected));
             REQUIRE((serialized_user_gen_kv_pairs == expected));
+
+            // The direct-to-string serialization must produce the same JSON objects.
+            string serialized_auto_gen_json_str{"prefix:"};
+            REQUIRE_FALSE(
+                    kv_pair_log_event
+                            .serialize_auto_gen_kv_pairs_to_json_str(serialized_auto_gen_json_str)
+                            .has_error()
+            );
+            REQUIRE(serialized_auto_gen_json_str.starts_with("prefix:"));
+            REQUIRE((nlohmann::json::parse(serialized_auto_gen_json_str.substr(
+                             std::string_view{"prefix:"}.size()
+                     ))
+                     == expected));
+
+            string serialized_user_gen_json_str;
+            REQUIRE_FALSE(
+                    kv_pair_log_event
+                            .serialize_user_gen_kv_pairs_to_json_str(serialized_user_gen_json_str)
+                            .has_error()
+            );
+            REQUIRE((nlohmann::json::parse(serialized_user_gen_json_str) == expected));
         }
 
         SECTION("Test duplicated key conflict under node #3") {
@@ -1,5 +1,8 @@
+#include <cstddef>
+#include <string>
 #include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <msgpack.hpp>
 
@@ -8,6 +11,21 @@
 using clp::ffi::SchemaTree;
 
 namespace {
+/**
+ * Creates locators for a wide object: one key under the root for each of the given key names, each
+ * appearing with both an `Int` and a `Str` type.
+ * @param key_names The key names, which must outlive the returned locators.
+ * @return The locators, in the order they should be inserted.
+ */
+[[nodiscard]] auto create_wide_object_locators(std::vector<std::string> const& key_names)
+        -> std::vector<SchemaTree::NodeLocator>;
+
+/**
+ * @param num_keys
+ * @return `num_keys` distinct key names.
+ */
+[[nodiscard]] auto create_key_names(size_t num_keys) -> std::vector<std::string>;
+
 /**
  * @param schema_tree
  * @param locator
@@ -33,6 +51,26 @@ namespace {
         SchemaTree::Node::id_t expected_id
 ) -> bool;
 
+auto create_wide_object_locators(std::vector<std::string> const& key_names)
+        -> std::vector<SchemaTree::NodeLocator> {
+    std::vector<SchemaTree::NodeLocator> locators;
+    locators.reserve(key_names.size() * 2);
+    for (auto const& key_name : key_names) {
+        locators.emplace_back(SchemaTree::cRootId, key_name, SchemaTree::Node::Type::Int);
+        locators.emplace_back(SchemaTree::cRootId, key_name, SchemaTree::Node::Type::Str);
+    }
+    return locators;
+}
+
+auto create_key_names(size_t num_keys) -> std::vector<std::string> {
+    std::vector<std::string> key_names;
+    key_names.reserve(num_keys);
+    for (size_t i{0}; i < num_keys; ++i) {
+        key_names.emplace_back("key_" + std::to_string(i));
+    }
+    return key_names;
+}
+
 auto insert_node(
         SchemaTree& schema_tree,
         SchemaTree::NodeLocator const& locator,
@@ -131,3 +169,66 @@ TEST_CASE("ffi_schema_tree", "[ffi]") {
         REQUIRE(check_non_root_node(schema_tree, locators[id_to_check - 1], id_to_check));
     }
 }
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEST_CASE("ffi_schema_tree_wide_object", "[ffi]") {
+    constexpr size_t cNumKeys{10'000};
+    auto const key_names{create_key_names(cNumKeys)};
+    auto const locators{create_wide_object_locators(key_names)};
+
+    SchemaTree schema_tree;
+    auto const snapshot_size{locators.size() / 2};
+    for (size_t i{0}; i < locators.size(); ++i) {
+        if (snapshot_size == i) {
+            schema_tree.take_snapshot();
+        }
+        REQUIRE(insert_node(schema_tree, locators[i], static_cast<SchemaTree::Node::id_t>(i + 1)));
+    }
+    REQUIRE((locators.size() == schema_tree.get_root().get_children_ids().size()));
+    for (size_t i{0}; i < locators.size(); ++i) {
+        REQUIRE(check_non_root_node(
+                schema_tree,
+                locators[i],
+                static_cast<SchemaTree::Node::id_t>(i + 1)
+        ));
+    }
+    REQUIRE_FALSE(schema_tree.has_node({SchemaTree::cRootId, "key_0", SchemaTree::Node::Type::Bool}
+    ));
+    REQUIRE_FALSE(schema_tree.has_node({1, "key_0", SchemaTree::Node::Type::Int}));
+
+    // Reverting must also remove the reverted nodes from the lookup index.
+    schema_tree.revert();
+    REQUIRE((snapshot_size + 1 == schema_tree.get_size()));
+    for (size_t i{0}; i < locators.size(); ++i) {
+        REQUIRE((i < snapshot_size) == schema_tree.has_node(locators[i]));
+    }
+    for (size_t i{snapshot_size}; i < locators.size(); ++i) {
+        REQUIRE(insert_node(schema_tree, locators[i], static_cast<SchemaTree::Node::id_t>(i + 1)));
+    }
+}
+
+TEST_CASE("ffi_schema_tree_wide_object_benchmark", "[ffi][.benchmark]") {
+    constexpr size_t cNumKeys{10'000};
+    auto const key_names{create_key_names(cNumKeys)};
+    auto const locators{create_wide_object_locators(key_names)};
+
+    BENCHMARK("insert") {
+        SchemaTree schema_tree;
+        for (auto const& locator : locators) {
+            schema_tree.insert_node(locator);
+        }
+        return schema_tree.get_size();
+    };
+
+    SchemaTree schema_tree;
+    for (auto const& locator : locators) {
+        schema_tree.insert_node(locator);
+    }
+    BENCHMARK("lookup") {
+        size_t num_found{0};
+        for (auto const& locator : locators) {
+            num_found += schema_tree.try_get_node_id(locator).has_value() ? 1 : 0;
+        }
+        return num_found;
+    };
+}
@@ -15,6 +15,7 @@
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <fmt/format.h>
 #include <msgpack.hpp>
 #include <nlohmann/json.hpp>
 
@@ -1579,6 +1580,115 @@ TEMPLATE_TEST_CASE(
     REQUIRE(assert_invalid_serialization(array_with_invalid_submap));
 }
 
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_Serializer_schema_tree_node_locator_cache",
+        "[clp][ffi][ir_stream][Serializer]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    constexpr size_t cNumKeys{256};
+
+    // Creates a wide object whose keys, and so the serializer's schema-tree lookups, are the same
+    // for the same `key_prefix` and `num_keys`.
+    auto const create_wide_obj
+            = [](string_view key_prefix, size_t num_keys, size_t value_offset) -> nlohmann::json {
+        auto obj = nlohmann::json::object();
+        for (size_t i{0}; i < num_keys; ++i) {
+            obj[fmt::format("{}_{}", key_prefix, i)] = i + value_offset;
+        }
+        obj["nested"] = {{"str", fmt::format("{}_{}", key_prefix, value_offset)}, {"bool", true}};
+        return obj;
+    };
+
+    auto result{Serializer<TestType>::create()};
+    REQUIRE((false == result.has_error()));
+    auto& serializer{result.value()};
+    vector<int8_t> ir_buf;
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+
+    vector<std::pair<nlohmann::json, nlohmann::json>> expected_auto_gen_and_user_gen_object_pairs;
+    auto const serialize = [&](nlohmann::json const& auto_gen_obj,
+                               nlohmann::json const& user_gen_obj) -> void {
+        REQUIRE_FALSE(unpack_and_serialize_msgpack_bytes(
+                              nlohmann::json::to_msgpack(auto_gen_obj),
+                              nlohmann::json::to_msgpack(user_gen_obj),
+                              serializer
+        )
+                              .has_error());
+        expected_auto_gen_and_user_gen_object_pairs.emplace_back(auto_gen_obj, user_gen_obj);
+    };
+
+    // Every lookup misses
+    serialize(create_wide_obj("auto", cNumKeys, 0), create_wide_obj("user", cNumKeys, 0));
+    // Every lookup hits
+    serialize(create_wide_obj("auto", cNumKeys, 1), create_wide_obj("user", cNumKeys, 1));
+    // The lookups hit until the user-generated keys change
+    serialize(create_wide_obj("auto", cNumKeys, 2), create_wide_obj("other", cNumKeys, 2));
+    // The lookups hit until the shorter key sequences end
+    serialize(
+            create_wide_obj("auto", cNumKeys / 2, 3),
+            create_wide_obj("other", cNumKeys / 2, 3)
+    );
+    // The same keys with a different value type miss
+    auto auto_gen_obj_with_retyped_values{create_wide_obj("auto", cNumKeys, 4)};
+    for (auto& [key, value] : auto_gen_obj_with_retyped_values.items()) {
+        if (value.is_number()) {
+            value = std::to_string(value.template get<size_t>());
+        }
+    }
+    serialize(auto_gen_obj_with_retyped_values, create_wide_obj("user", cNumKeys, 4));
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+
+    // A failure after inserting new nodes into both schema trees must revert them, along with the
+    // cached lookups that refer to them. "zzz" sorts the invalid value after every new key.
+    auto user_gen_obj_with_invalid_value{create_wide_obj("new_user", cNumKeys, 5)};
+    user_gen_obj_with_invalid_value["zzz"] = nlohmann::json::binary({0x00, 0x01, 0x02});
+    REQUIRE(unpack_and_serialize_msgpack_bytes(
+                    nlohmann::json::to_msgpack(create_wide_obj("new_auto", cNumKeys, 5)),
+                    nlohmann::json::to_msgpack(user_gen_obj_with_invalid_value),
+                    serializer
+    )
+                    .has_error());
+    REQUIRE(serializer.get_ir_buf_view().empty());
+
+    // The reverted keys must be inserted again, and the previous keys must still resolve to their
+    // original nodes.
+    serialize(create_wide_obj("new_auto", cNumKeys, 6), create_wide_obj("new_user", cNumKeys, 6));
+    serialize(create_wide_obj("auto", cNumKeys, 7), create_wide_obj("user", cNumKeys, 7));
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+    ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+
+    BufferReader reader{size_checked_pointer_cast<char>(ir_buf.data()), ir_buf.size()};
+    auto deserializer_result{Deserializer<IrUnitHandler>::create(reader, IrUnitHandler{})};
+    REQUIRE_FALSE(deserializer_result.has_error());
+    auto& deserializer = deserializer_result.value();
+    while (true) {
+        auto const ir_unit_type_result{deserializer.deserialize_next_ir_unit(reader)};
+        REQUIRE_FALSE(ir_unit_type_result.has_error());
+        if (clp::ffi::ir_stream::IrUnitType::EndOfStream == ir_unit_type_result.value()) {
+            break;
+        }
+    }
+
+    auto const& deserialized_log_events{
+            deserializer.get_ir_unit_handler().get_deserialized_log_events()
+    };
+    REQUIRE((expected_auto_gen_and_user_gen_object_pairs.size() == deserialized_log_events.size()));
+    for (size_t idx{0}; idx < deserialized_log_events.size(); ++idx) {
+        auto const& [expected_auto_gen_json_obj, expected_user_gen_json_obj]{
+                expected_auto_gen_and_user_gen_object_pairs.at(idx)
+        };
+        auto const serialized_json_result{deserialized_log_events.at(idx).serialize_to_json()};
+        REQUIRE_FALSE(serialized_json_result.has_error());
+        auto const& [actual_auto_gen_json_obj, actual_user_gen_json_obj]{
+                serialized_json_result.value()
+        };
+        REQUIRE((expected_auto_gen_json_obj == actual_auto_gen_json_obj));
+        REQUIRE((expected_user_gen_json_obj == actual_user_gen_json_obj));
+    }
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 TEMPLATE_TEST_CASE(
         "ffi_ir_stream_Serializer_serialize_invalid_user_defined_metadata",
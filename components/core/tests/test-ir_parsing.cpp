@@ -1,14 +1,110 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "../src/clp/ir/parsing.hpp"
 #include "../src/clp/ir/types.hpp"
+#include "../src/clp/string_utils/string_utils.hpp"
 #include "../src/clp/type_utils.hpp"
 
 using clp::ir::get_bounds_of_next_var;
+using clp::ir::is_delim;
+using clp::ir::VariableBoundsFinder;
 using std::string;
 using std::string_view;
 using std::vector;
 
+namespace {
+/**
+ * A character-at-a-time implementation of `get_bounds_of_next_var`, used as a reference to
+ * validate (and benchmark) the block-based implementation.
+ * @param str
+ * @param begin_pos
+ * @param end_pos
+ * @return Same as `get_bounds_of_next_var`.
+ */
+auto reference_get_bounds_of_next_var(string_view str, size_t& begin_pos, size_t& end_pos)
+        -> bool;
+
+/**
+ * @param str
+ * @return The bounds of all variables in `str` found using `VariableBoundsFinder`.
+ */
+auto get_all_var_bounds(string_view str) -> vector<std::pair<size_t, size_t>>;
+
+/**
+ * @return Lines resembling those in typical unstructured logs.
+ */
+auto get_representative_log_lines() -> vector<string>;
+
+auto reference_get_bounds_of_next_var(string_view str, size_t& begin_pos, size_t& end_pos)
+        -> bool {
+    auto const msg_length = str.length();
+    if (msg_length <= end_pos) {
+        return false;
+    }
+    while (true) {
+        begin_pos = end_pos;
+        for (; begin_pos < msg_length; ++begin_pos) {
+            if (false == is_delim(str[begin_pos])) {
+                break;
+            }
+        }
+        if (msg_length == begin_pos) {
+            return false;
+        }
+
+        bool contains_decimal_digit = false;
+        bool contains_alphabet = false;
+        end_pos = begin_pos;
+        for (; end_pos < msg_length; ++end_pos) {
+            auto const c = str[end_pos];
+            if (clp::string_utils::is_decimal_digit(c)) {
+                contains_decimal_digit = true;
+            } else if (clp::string_utils::is_alphabet(c)) {
+                contains_alphabet = true;
+            } else if (is_delim(c)) {
+                break;
+            }
+        }
+
+        auto const variable = str.substr(begin_pos, end_pos - begin_pos);
+        if (contains_decimal_digit
+            || (0 < begin_pos && '=' == str[begin_pos - 1] && contains_alphabet)
+            || clp::ir::could_be_multi_digit_hex_value(variable))
+        {
+            break;
+        }
+    }
+    return msg_length != begin_pos;
+}
+
+auto get_all_var_bounds(string_view str) -> vector<std::pair<size_t, size_t>> {
+    vector<std::pair<size_t, size_t>> bounds;
+    VariableBoundsFinder finder{str};
+    size_t begin_pos{0};
+    size_t end_pos{0};
+    while (finder.get_bounds_of_next_var(begin_pos, end_pos)) {
+        bounds.emplace_back(begin_pos, end_pos);
+    }
+    return bounds;
+}
+
+auto get_representative_log_lines() -> vector<string> {
+    return {"2024-05-01T12:34:56.789Z INFO [worker-17] org.apache.hadoop.mapred.TaskTracker: Task "
+            "attempt_201405011234_0001_m_000042_0 done, took 1234 ms",
+            "user=alice bytes=0xdeadbeef status=SUCCEEDED path=/var/log/app/server.log",
+            "Connection from 10.0.0.12:54321 closed after 3.25 seconds",
+            "GET /api/v1/users/8f14e45f-ceea-467f-a0e6-123456789abc HTTP/1.1 200 512"};
+}
+}  // namespace
+
 TEST_CASE("ir::get_bounds_of_next_var", "[ir][get_bounds_of_next_var]") {
     string str;
     size_t begin_pos;
@@ -100,3 +196,56 @@ TEST_CASE("ir::get_bounds_of_next_var", "[ir][get_bounds_of_next_var]") {
     REQUIRE(get_bounds_of_next_var(str, begin_pos, end_pos) == true);
     REQUIRE("var123" == str.substr(begin_pos, end_pos - begin_pos));
 }
+
+TEST_CASE("ir::VariableBoundsFinder", "[ir][get_bounds_of_next_var]") {
+    // Strings longer than a classification block, with tokens spanning block boundaries and
+    // non-ASCII characters
+    constexpr size_t cNumStrings{5000};
+    constexpr size_t cMaxStringLength{300};
+    constexpr string_view cCharset{"aZfF09+-./\\_ =:[]\t\x80\xff"};
+    std::mt19937 rng{1};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    for (size_t i{0}; i < cNumStrings; ++i) {
+        string str;
+        auto const length{rng() % cMaxStringLength};
+        for (size_t j{0}; j < length; ++j) {
+            str += cCharset[rng() % cCharset.length()];
+        }
+
+        vector<std::pair<size_t, size_t>> expected_bounds;
+        size_t begin_pos{0};
+        size_t end_pos{0};
+        while (reference_get_bounds_of_next_var(str, begin_pos, end_pos)) {
+            expected_bounds.emplace_back(begin_pos, end_pos);
+        }
+        REQUIRE((expected_bounds == get_all_var_bounds(str)));
+    }
+
+    // Tokens that end exactly at, or extend past, a block's end
+    for (size_t length{1}; length <= 2 * cMaxStringLength; ++length) {
+        string const str{" " + string(length, '7')};
+        REQUIRE((vector<std::pair<size_t, size_t>>{{1, length + 1}} == get_all_var_bounds(str)));
+    }
+}
+
+TEST_CASE("ir::get_bounds_of_next_var_benchmark", "[ir][get_bounds_of_next_var][.benchmark]") {
+    string messages;
+    for (auto const& line : get_representative_log_lines()) {
+        messages += line;
+        messages += '\n';
+    }
+    auto const num_bytes{messages.length()};
+
+    BENCHMARK("reference (" + std::to_string(num_bytes) + " bytes)") {
+        size_t num_vars{0};
+        size_t begin_pos{0};
+        size_t end_pos{0};
+        while (reference_get_bounds_of_next_var(messages, begin_pos, end_pos)) {
+            ++num_vars;
+        }
+        return num_vars;
+    };
+
+    BENCHMARK("VariableBoundsFinder (" + std::to_string(num_bytes) + " bytes)") {
+        return get_all_var_bounds(messages).size();
+    };
+}
@@ -0,0 +1,150 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/DeserializedRecordGroup.hpp"
+#include "../src/reducer/DistinctCountOperator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/HyperLogLog.hpp"
+#include "../src/reducer/Record.hpp"
+
+using reducer::DeserializedRecordGroup;
+using reducer::DistinctCountOperator;
+using reducer::GroupTags;
+using reducer::HyperLogLog;
+using reducer::SingleBinaryRecordAdapter;
+using reducer::SingleRecordIterator;
+
+namespace {
+/**
+ * @param begin
+ * @param end
+ * @return A sketch containing the strings "value-<i>" for every i in [begin, end).
+ */
+auto create_sketch(size_t begin, size_t end) -> HyperLogLog;
+
+/**
+ * @param estimate
+ * @param expected
+ * @param relative_error
+ * @return Whether `estimate` is within the given relative error of `expected`.
+ */
+auto is_close(uint64_t estimate, size_t expected, double relative_error) -> bool;
+
+auto create_sketch(size_t begin, size_t end) -> HyperLogLog {
+    HyperLogLog sketch;
+    for (auto i = begin; i < end; ++i) {
+        sketch.add_string("value-" + std::to_string(i));
+    }
+    return sketch;
+}
+
+auto is_close(uint64_t estimate, size_t expected, double relative_error) -> bool {
+    return std::abs(static_cast<double>(estimate) - static_cast<double>(expected))
+           <= relative_error * static_cast<double>(expected);
+}
+}  // namespace
+
+TEST_CASE("HyperLogLog", "[reducer][HyperLogLog]") {
+    // The default precision has a standard error of ~1.6%, so 5% is over three standard errors.
+    constexpr double cRelativeError{0.05};
+    constexpr size_t cNumValues{100'000};
+
+    SECTION("Estimates") {
+        REQUIRE(0 == HyperLogLog{}.estimate());
+        REQUIRE(10 == create_sketch(0, 10).estimate());
+
+        auto sketch = create_sketch(0, cNumValues);
+        REQUIRE(is_close(sketch.estimate(), cNumValues, cRelativeError));
+
+        // Adding duplicates shouldn't change the estimate
+        auto const estimate = sketch.estimate();
+        for (size_t i = 0; i < cNumValues; ++i) {
+            sketch.add_string("value-" + std::to_string(i));
+        }
+        REQUIRE(estimate == sketch.estimate());
+
+        // Values of different types are distinct
+        HyperLogLog typed_sketch;
+        typed_sketch.add_string("1");
+        typed_sketch.add_int64(1);
+        typed_sketch.add_double(1.0);
+        typed_sketch.add_bool(true);
+        REQUIRE(4 == typed_sketch.estimate());
+    }
+
+    SECTION("Merge") {
+        // Overlapping halves
+        auto sketch = create_sketch(0, cNumValues / 2 + cNumValues / 10);
+        REQUIRE(sketch.merge(create_sketch(cNumValues / 2, cNumValues)));
+        REQUIRE(is_close(sketch.estimate(), cNumValues, cRelativeError));
+
+        REQUIRE_FALSE(sketch.merge(HyperLogLog{HyperLogLog::cMinPrecision}));
+    }
+
+    SECTION("Serialization") {
+        for (auto const num_values : {size_t{0}, size_t{10}, cNumValues}) {
+            auto const sketch = create_sketch(0, num_values);
+            auto const serialized_sketch = sketch.serialize();
+            auto const deserialized_sketch = HyperLogLog::deserialize(serialized_sketch);
+            REQUIRE(deserialized_sketch.has_value());
+            REQUIRE(deserialized_sketch->get_precision() == sketch.get_precision());
+            REQUIRE(deserialized_sketch->estimate() == sketch.estimate());
+            REQUIRE(deserialized_sketch->serialize() == serialized_sketch);
+
+            // Truncated sketches should be rejected
+            std::vector<uint8_t> const truncated_sketch{
+                    serialized_sketch.cbegin(),
+                    serialized_sketch.cend() - 1
+            };
+            REQUIRE_FALSE(HyperLogLog::deserialize(truncated_sketch).has_value());
+        }
+
+        // Sparse sketches should be much smaller than the dense register array
+        REQUIRE(create_sketch(0, 10).serialize().size() < 64);
+    }
+
+    SECTION("DistinctCountOperator") {
+        // Send two overlapping partial sketches through the reducer's wire format and merge them.
+        DistinctCountOperator op;
+        GroupTags const tags{"group"};
+        for (auto const& partial_sketch :
+             {create_sketch(0, cNumValues / 2 + cNumValues / 10),
+              create_sketch(cNumValues / 2, cNumValues)})
+        {
+            auto const serialized_sketch = partial_sketch.serialize();
+            SingleBinaryRecordAdapter record{
+                    static_cast<char const*>(DistinctCountOperator::cSketchKey)
+            };
+            record.set_record_value(serialized_sketch);
+            SingleRecordIterator record_it{record};
+            auto serialized_record_group = reducer::serialize(tags, record_it);
+
+            DeserializedRecordGroup record_group{serialized_record_group};
+            op.push_intra_stage_record_group(record_group.get_tags(), record_group.record_iter());
+        }
+
+        auto results = op.get_stored_result_iterator();
+        REQUIRE_FALSE(results->done());
+        auto& group = results->get();
+        REQUIRE(group.get_tags() == tags);
+        auto& result_it = group.record_iter();
+        REQUIRE_FALSE(result_it.done());
+        auto const count = result_it.get().get_int64_value(
+                static_cast<char const*>(DistinctCountOperator::cCountKey)
+        );
+        REQUIRE(is_close(static_cast<uint64_t>(count), cNumValues, cRelativeError));
+        auto const merged_sketch = HyperLogLog::deserialize(result_it.get().get_binary_value(
+                static_cast<char const*>(DistinctCountOperator::cSketchKey)
+        ));
+        REQUIRE(merged_sketch.has_value());
+        REQUIRE(static_cast<int64_t>(merged_sketch->estimate()) == count);
+        results->next();
+        REQUIRE(results->done());
+    }
+}
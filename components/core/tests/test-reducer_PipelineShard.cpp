@@ -0,0 +1,132 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/CountOperator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/Pipeline.hpp"
+#include "../src/reducer/PipelineShard.hpp"
+#include "../src/reducer/Record.hpp"
+
+using reducer::ConstRecordIterator;
+using reducer::CountOperator;
+using reducer::GroupTags;
+using reducer::Pipeline;
+using reducer::PipelineInputMode;
+using reducer::PipelineShard;
+using reducer::SingleInt64RecordAdapter;
+using reducer::SingleRecordIterator;
+
+namespace {
+/**
+ * @return A pipeline that sums the counts in the record groups pushed into it.
+ */
+auto create_count_pipeline() -> std::unique_ptr<Pipeline>;
+
+/**
+ * Pushes a record group containing a single count into the given shard.
+ * @param shard
+ * @param tags
+ * @param count
+ */
+auto push_count(PipelineShard& shard, GroupTags const& tags, int64_t count) -> void;
+
+/**
+ * @param pipeline
+ * @return The counts in the given pipeline's results, indexed by their tags.
+ */
+auto get_counts(Pipeline& pipeline) -> std::map<GroupTags, int64_t>;
+
+auto create_count_pipeline() -> std::unique_ptr<Pipeline> {
+    auto pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
+    pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+    return pipeline;
+}
+
+auto push_count(PipelineShard& shard, GroupTags const& tags, int64_t count) -> void {
+    SingleInt64RecordAdapter record{static_cast<char const*>(CountOperator::cRecordElementKey)};
+    record.set_record_value(count);
+    SingleRecordIterator record_it{record};
+    shard.push_record_group(tags, record_it);
+}
+
+auto get_counts(Pipeline& pipeline) -> std::map<GroupTags, int64_t> {
+    std::map<GroupTags, int64_t> counts;
+    for (auto group_it = pipeline.finish(); false == group_it->done(); group_it->next()) {
+        auto& group = group_it->get();
+        ConstRecordIterator& record_it = group.record_iter();
+        REQUIRE_FALSE(record_it.done());
+        counts.emplace(
+                group.get_tags(),
+                record_it.get().get_int64_value(
+                        static_cast<char const*>(CountOperator::cRecordElementKey)
+                )
+        );
+    }
+    return counts;
+}
+}  // namespace
+
+TEST_CASE("PipelineShard", "[reducer][PipelineShard]") {
+    constexpr size_t cNumShards{4};
+    constexpr size_t cNumGroups{16};
+
+    std::vector<std::unique_ptr<PipelineShard>> shards;
+    for (size_t i = 0; i < cNumShards; ++i) {
+        auto& shard = shards.emplace_back(std::make_unique<PipelineShard>());
+        shard->set_pipeline(create_count_pipeline(), true);
+    }
+
+    // Spread each group's count over every shard so that merging has to sum them
+    std::map<GroupTags, int64_t> expected_counts;
+    for (size_t i = 0; i < cNumGroups; ++i) {
+        GroupTags const tags{std::to_string(i)};
+        for (size_t j = 0; j < cNumShards; ++j) {
+            auto const count = static_cast<int64_t>(i + j);
+            push_count(*shards[j], tags, count);
+            expected_counts[tags] += count;
+        }
+    }
+
+    SECTION("Merge updated results") {
+        std::set<GroupTags> updated_tags;
+        for (auto& shard : shards) {
+            shard->take_updated_tags(updated_tags);
+        }
+        REQUIRE(updated_tags.size() == cNumGroups);
+
+        // Only the groups updated after the tags were taken should be reported next time
+        GroupTags const updated_group_tags{"0"};
+        push_count(*shards.front(), updated_group_tags, 1);
+        expected_counts[updated_group_tags] += 1;
+        updated_tags.clear();
+        for (auto& shard : shards) {
+            shard->take_updated_tags(updated_tags);
+        }
+        REQUIRE(updated_tags == std::set<GroupTags>{updated_group_tags});
+
+        auto merged_pipeline = create_count_pipeline();
+        for (auto& shard : shards) {
+            shard->merge_results_into(*merged_pipeline, updated_tags);
+        }
+        std::map<GroupTags, int64_t> const expected_updated_counts{
+                {updated_group_tags, expected_counts[updated_group_tags]}
+        };
+        REQUIRE(get_counts(*merged_pipeline) == expected_updated_counts);
+    }
+
+    SECTION("Merge final results") {
+        auto merged_pipeline = create_count_pipeline();
+        for (auto& shard : shards) {
+            shard->merge_results_into(*merged_pipeline);
+        }
+        REQUIRE(get_counts(*merged_pipeline) == expected_counts);
+    }
+}
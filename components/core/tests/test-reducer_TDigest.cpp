@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/DeserializedRecordGroup.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/QuantilesOperator.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/TDigest.hpp"
+
+using reducer::DeserializedRecordGroup;
+using reducer::GroupTags;
+using reducer::QuantilesOperator;
+using reducer::SingleBinaryRecordAdapter;
+using reducer::SingleRecordIterator;
+using reducer::TDigest;
+
+namespace {
+constexpr size_t cNumValues{100'000};
+// The tolerated error of an estimated quantile, as a fraction of the range of values
+constexpr double cRangeRelativeError{0.01};
+
+/**
+ * @return The integers in [1, cNumValues] in a random order.
+ */
+auto get_shuffled_values() -> std::vector<double>;
+
+/**
+ * @param digest
+ * @param q
+ * @return Whether the digest's estimate of the given quantile of [1, cNumValues] is close to the
+ * exact value.
+ */
+auto is_quantile_close(TDigest const& digest, double q) -> bool;
+
+auto get_shuffled_values() -> std::vector<double> {
+    std::vector<double> values(cNumValues);
+    std::iota(values.begin(), values.end(), 1.0);
+    std::mt19937_64 generator{0};
+    std::shuffle(values.begin(), values.end(), generator);
+    return values;
+}
+
+auto is_quantile_close(TDigest const& digest, double q) -> bool {
+    auto const expected = q * static_cast<double>(cNumValues);
+    return std::abs(digest.quantile(q) - expected)
+           <= cRangeRelativeError * static_cast<double>(cNumValues);
+}
+}  // namespace
+
+TEST_CASE("TDigest", "[reducer][TDigest]") {
+    auto const values = get_shuffled_values();
+
+    SECTION("Quantiles") {
+        TDigest digest;
+        REQUIRE(digest.empty());
+        REQUIRE(std::isnan(digest.quantile(0.5)));
+
+        digest.add(42.0);
+        REQUIRE(42.0 == digest.quantile(0.5));
+
+        digest = TDigest{};
+        for (auto const value : values) {
+            digest.add(value);
+        }
+        REQUIRE(cNumValues == digest.get_count());
+        REQUIRE(1.0 == digest.quantile(0.0));
+        REQUIRE(static_cast<double>(cNumValues) == digest.quantile(1.0));
+        for (auto const q : {0.01, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999}) {
+            REQUIRE(is_quantile_close(digest, q));
+        }
+
+        // The digest's size should be bounded by its compression rather than the number of values
+        REQUIRE(digest.serialize().size() < 4096);
+    }
+
+    SECTION("Merge") {
+        constexpr size_t cNumDigests{8};
+        std::vector<TDigest> digests(cNumDigests);
+        for (size_t i = 0; i < values.size(); ++i) {
+            digests[i % cNumDigests].add(values[i]);
+        }
+
+        TDigest merged_digest;
+        for (auto const& digest : digests) {
+            merged_digest.merge(digest);
+        }
+        REQUIRE(cNumValues == merged_digest.get_count());
+        for (auto const q : {0.5, 0.95, 0.99}) {
+            REQUIRE(is_quantile_close(merged_digest, q));
+        }
+    }
+
+    SECTION("Serialization") {
+        TDigest digest;
+        for (auto const value : values) {
+            digest.add(value);
+        }
+        auto const serialized_digest = digest.serialize();
+        auto const deserialized_digest = TDigest::deserialize(serialized_digest);
+        REQUIRE(deserialized_digest.has_value());
+        REQUIRE(deserialized_digest->get_count() == digest.get_count());
+        for (auto const q : {0.0, 0.5, 0.95, 0.99, 1.0}) {
+            REQUIRE(deserialized_digest->quantile(q) == digest.quantile(q));
+        }
+        REQUIRE(deserialized_digest->serialize() == serialized_digest);
+
+        // Truncated digests should be rejected
+        std::vector<uint8_t> const truncated_digest{
+                serialized_digest.cbegin(),
+                serialized_digest.cend() - 1
+        };
+        REQUIRE_FALSE(TDigest::deserialize(truncated_digest).has_value());
+        REQUIRE_FALSE(TDigest::deserialize({}).has_value());
+    }
+
+    SECTION("QuantilesOperator") {
+        // Send two partial digests through the reducer's wire format and merge them.
+        QuantilesOperator op;
+        GroupTags const tags{"group"};
+        std::vector<TDigest> partial_digests(2);
+        for (size_t i = 0; i < values.size(); ++i) {
+            partial_digests[i % partial_digests.size()].add(values[i]);
+        }
+        for (auto const& partial_digest : partial_digests) {
+            auto const serialized_digest = partial_digest.serialize();
+            SingleBinaryRecordAdapter record{
+                    static_cast<char const*>(QuantilesOperator::cSketchKey)
+            };
+            record.set_record_value(serialized_digest);
+            SingleRecordIterator record_it{record};
+            auto serialized_record_group = reducer::serialize(tags, record_it);
+
+            DeserializedRecordGroup record_group{serialized_record_group};
+            op.push_intra_stage_record_group(record_group.get_tags(), record_group.record_iter());
+        }
+
+        auto results = op.get_stored_result_iterator();
+        REQUIRE_FALSE(results->done());
+        auto& group = results->get();
+        REQUIRE(group.get_tags() == tags);
+        auto& result_it = group.record_iter();
+        REQUIRE_FALSE(result_it.done());
+        auto const merged_digest = TDigest::deserialize(result_it.get().get_binary_value(
+                static_cast<char const*>(QuantilesOperator::cSketchKey)
+        ));
+        REQUIRE(merged_digest.has_value());
+        REQUIRE(cNumValues == merged_digest->get_count());
+        for (auto const* key : {QuantilesOperator::cP50Key, QuantilesOperator::cP99Key}) {
+            REQUIRE(result_it.get().get_double_value(key)
+                    == merged_digest->quantile(key == QuantilesOperator::cP50Key ? 0.5 : 0.99));
+        }
+        REQUIRE(is_quantile_close(*merged_digest, 0.99));
+        results->next();
+        REQUIRE(results->done());
+    }
+}
@@ -200,6 +200,12 @@ def _make_command_and_env_vars(
         if aggregation_config.count_by_time_bucket_size is not None:
             command.append("--count-by-time")
             command.append(str(aggregation_config.count_by_time_bucket_size))
+        if aggregation_config.count_distinct_field is not None:
+            command.append("--count-distinct")
+            command.append(aggregation_config.count_distinct_field)
+        if aggregation_config.quantiles_field is not None:
+            command.append("--quantiles")
+            command.append(aggregation_config.quantiles_field)
     elif search_config.network_address is not None:
         # fmt: off
         command.extend((
@@ -82,6 +82,8 @@ class AggregationConfig(BaseModel):
     reducer_port: int | None = None
     do_count_aggregation: bool | None = None
     count_by_time_bucket_size: int | None = None  # Milliseconds
+    count_distinct_field: str | None = None
+    quantiles_field: str | None = None
 
 
 class QueryJobConfig(BaseModel):
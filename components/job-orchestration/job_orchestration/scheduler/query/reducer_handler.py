@@ -176,6 +176,8 @@ async def handle_reducer_connection(
                         {
                             "job_id": job_id,
                             "count_by_time_bucket_size": time_bucket_size,
+                            "count_distinct_field": aggregation_config.count_distinct_field,
+                            "quantiles_field": aggregation_config.quantiles_field,
                         }
                     ),
                     writer,